@@ -0,0 +1,71 @@
+#include "base/arena.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace base
+{
+Arena::Arena(size_t blockSize) : m_nextBlockSize(std::max<size_t>(blockSize, 64)) {}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+  // Blocks are allocated by new[], so they are aligned at least for max_align_t.
+  ASSERT_LESS_OR_EQUAL(alignment, alignof(std::max_align_t), ());
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, (alignment));
+
+  auto const align = [alignment](uint8_t * p) {
+    auto const address = reinterpret_cast<uintptr_t>(p);
+    return p + ((alignment - address % alignment) % alignment);
+  };
+
+  uint8_t * result = align(m_current);
+  if (m_current == nullptr || result > m_end || size > static_cast<size_t>(m_end - result))
+  {
+    AddBlock(size + alignment);
+    result = align(m_current);
+  }
+
+  m_current = result + size;
+  m_usedBytes += size;
+  return result;
+}
+
+void Arena::Release()
+{
+  m_usedBytes = 0;
+  if (m_blocks.empty())
+    return;
+
+  auto const biggest = std::max_element(
+      m_blocks.begin(), m_blocks.end(),
+      [](Block const & lhs, Block const & rhs) { return lhs.m_size < rhs.m_size; });
+  if (biggest != m_blocks.begin())
+    std::swap(*biggest, m_blocks.front());
+  m_blocks.resize(1);
+
+  m_current = m_blocks.front().m_data.get();
+  m_end = m_current + m_blocks.front().m_size;
+}
+
+size_t Arena::GetReservedBytes() const
+{
+  size_t bytes = 0;
+  for (auto const & block : m_blocks)
+    bytes += block.m_size;
+  return bytes;
+}
+
+void Arena::AddBlock(size_t minSize)
+{
+  Block block;
+  block.m_size = std::max(m_nextBlockSize, minSize);
+  block.m_data.reset(new uint8_t[block.m_size]);
+
+  m_current = block.m_data.get();
+  m_end = m_current + block.m_size;
+  m_blocks.push_back(std::move(block));
+
+  m_nextBlockSize = std::min(m_nextBlockSize * 2, kMaxBlockSize);
+}
+}  // namespace base
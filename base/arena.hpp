@@ -0,0 +1,96 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base
+{
+// Monotonic allocator: memory is cut from big blocks by bumping a pointer and is freed all at
+// once by Release() or by the destructor. Freeing a single allocation is a no-op, so the arena
+// suits transient containers which live for a search pass or a tile read.
+//
+// *NOTE* This class *IS NOT* thread safe.
+class Arena
+{
+public:
+  static size_t constexpr kDefaultBlockSize = 4 * 1024;
+  static size_t constexpr kMaxBlockSize = 1024 * 1024;
+
+  explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+  void * Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  T * Allocate(size_t count)
+  {
+    return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  // Frees all allocations at once. The biggest block is kept, so the arena doesn't go to the
+  // system allocator again when it's reused for a similar load.
+  void Release();
+
+  // Returns the number of bytes handed out since the last Release().
+  size_t GetUsedBytes() const { return m_usedBytes; }
+  // Returns the number of bytes held in blocks.
+  size_t GetReservedBytes() const;
+
+private:
+  struct Block
+  {
+    std::unique_ptr<uint8_t[]> m_data;
+    size_t m_size = 0;
+  };
+
+  void AddBlock(size_t minSize);
+
+  std::vector<Block> m_blocks;
+  uint8_t * m_current = nullptr;
+  uint8_t * m_end = nullptr;
+  size_t m_nextBlockSize;
+  size_t m_usedBytes = 0;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+};
+
+// Standard allocator adapter over Arena for std containers, e.g.
+// std::vector<uint32_t, base::ArenaAllocator<uint32_t>> v(base::ArenaAllocator<uint32_t>(arena));
+// The arena must outlive the containers which use it.
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena & arena) noexcept : m_arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const & rhs) noexcept : m_arena(rhs.GetArena())
+  {
+  }
+
+  T * allocate(size_t n) { return m_arena->Allocate<T>(n); }
+  void deallocate(T *, size_t) noexcept {}
+
+  Arena * GetArena() const noexcept { return m_arena; }
+
+  template <typename U>
+  bool operator==(ArenaAllocator<U> const & rhs) const noexcept
+  {
+    return m_arena == rhs.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(ArenaAllocator<U> const & rhs) const noexcept
+  {
+    return !(*this == rhs);
+  }
+
+private:
+  Arena * m_arena;
+};
+}  // namespace base
@@ -13,6 +13,8 @@ namespace base
 {
 bool OnAssertFailedDefault(SrcPoint const & srcPoint, std::string const & msg)
 {
+  FlushAsyncLog();
+
   auto & logger = LogHelper::Instance();
 
   std::cerr << "TID(" << logger.GetThreadID() << ") ASSERT FAILED" << std::endl
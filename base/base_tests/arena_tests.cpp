@@ -0,0 +1,67 @@
+#include "testing/testing.hpp"
+
+#include "base/arena.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+UNIT_TEST(Arena_Smoke)
+{
+  base::Arena arena(64 /* blockSize */);
+  TEST_EQUAL(arena.GetUsedBytes(), 0, ());
+  TEST_EQUAL(arena.GetReservedBytes(), 0, ());
+
+  auto * c = arena.Allocate<char>(1);
+  auto * d = arena.Allocate<double>(3);
+  auto * i = arena.Allocate<uint32_t>(1);
+  TEST_EQUAL(reinterpret_cast<uintptr_t>(d) % alignof(double), 0, ());
+  TEST_EQUAL(reinterpret_cast<uintptr_t>(i) % alignof(uint32_t), 0, ());
+  *c = 'a';
+  d[0] = d[1] = d[2] = 1.0;
+  *i = 42;
+  TEST_EQUAL(arena.GetUsedBytes(), 1 + 3 * sizeof(double) + sizeof(uint32_t), ());
+
+  // A request bigger than a block gets its own block.
+  auto * big = arena.Allocate<uint8_t>(1000);
+  std::fill(big, big + 1000, 0xFF);
+  TEST_EQUAL(*c, 'a', ());
+  TEST_EQUAL(*i, 42, ());
+  TEST_GREATER_OR_EQUAL(arena.GetReservedBytes(), 1000 + 64, ());
+
+  // The biggest block is kept.
+  arena.Release();
+  TEST_EQUAL(arena.GetUsedBytes(), 0, ());
+  auto const reserved = arena.GetReservedBytes();
+  TEST_GREATER_OR_EQUAL(reserved, 1000, ());
+  arena.Allocate<uint8_t>(1000);
+  TEST_EQUAL(arena.GetReservedBytes(), reserved, ());
+}
+
+UNIT_TEST(Arena_Containers)
+{
+  base::Arena arena;
+
+  std::vector<uint32_t, base::ArenaAllocator<uint32_t>> v{base::ArenaAllocator<uint32_t>(arena)};
+  for (uint32_t j = 0; j < 10000; ++j)
+    v.push_back(j);
+  TEST_EQUAL(std::accumulate(v.begin(), v.end(), uint64_t{0}), 9999 * 10000 / 2, ());
+
+  using Map = std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>,
+                                 base::ArenaAllocator<std::pair<uint32_t const, uint32_t>>>;
+  Map m(0 /* bucketCount */, std::hash<uint32_t>(), std::equal_to<uint32_t>(),
+        base::ArenaAllocator<std::pair<uint32_t const, uint32_t>>(arena));
+  for (uint32_t j = 0; j < 10000; ++j)
+    m[j] = 2 * j;
+  TEST_EQUAL(m.size(), 10000, ());
+  for (uint32_t j = 0; j < 10000; ++j)
+    TEST_EQUAL(m[j], 2 * j, ());
+
+  base::ArenaAllocator<uint32_t> a(arena);
+  base::ArenaAllocator<double> b(a);
+  TEST(a == b, ());
+  base::Arena other;
+  TEST(a != base::ArenaAllocator<uint32_t>(other), ());
+}
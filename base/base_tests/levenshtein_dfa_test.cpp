@@ -138,6 +138,25 @@ UNIT_TEST(LevenshteinDFA_Smoke)
   }
 }
 
+UNIT_TEST(LevenshteinDFA_MixedScripts)
+{
+  // Letters of the pattern are too far from each other for the table of letter indices.
+  LevenshteinDFA dfa("cafeкафе", 1 /* maxErrors */);
+  TEST(Accepts(dfa, "cafeкафе"), ());
+  TEST(Accepts(dfa, "cafeкаfе"), ());
+  TEST(Accepts(dfa, "cafкафе"), ());
+  TEST(Rejects(dfa, "кафеcafe"), ());
+  TEST(Intermediate(dfa, "cafeкауф"), ());
+  TEST(Rejects(dfa, "cafeкауфа"), ());
+
+  // Letters on the bounds of the table and out of it.
+  LevenshteinDFA dfa2("az", 0 /* maxErrors */);
+  TEST(Accepts(dfa2, "az"), ());
+  TEST(Rejects(dfa2, "`z"), ());
+  TEST(Rejects(dfa2, "a{"), ());
+  TEST(Rejects(dfa2, "ay"), ());
+}
+
 UNIT_TEST(LevenshteinDFA_Prefix)
 {
   {
@@ -2,6 +2,10 @@
 
 #include "base/logging.hpp"
 
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -60,3 +64,45 @@ UNIT_TEST(Logging_ConditionalLog)
   CLOG(LWARNING, BoolFunction(false, isCalled), ("This should be displayed"));
   TEST(isCalled, ());
 }
+
+UNIT_TEST(Logging_Async)
+{
+  size_t constexpr kThreads = 4;
+  size_t constexpr kMessages = 3000;
+
+  std::ostringstream out;
+  auto * cerrBuf = std::cerr.rdbuf(out.rdbuf());
+  base::LogMessageFn logMessageSaved = base::SetLogMessageFn(&base::LogMessageAsync);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([i]() {
+      for (size_t j = 0; j < kMessages; ++j)
+        LOG_FORCE(LINFO, ("Async", i, j));
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  base::FlushAsyncLog();
+  base::SetLogMessageFn(logMessageSaved);
+  std::cerr.rdbuf(cerrBuf);
+
+  // Messages of each thread are written in order.
+  std::vector<size_t> next(kThreads, 0);
+  std::istringstream in(out.str());
+  std::string line;
+  while (std::getline(in, line))
+  {
+    auto const pos = line.find("Async ");
+    TEST_NOT_EQUAL(pos, std::string::npos, (line));
+    std::istringstream message(line.substr(pos + 6));
+    size_t i, j;
+    message >> i >> j;
+    TEST_LESS(i, kThreads, (line));
+    TEST_EQUAL(j, next[i], (line));
+    ++next[i];
+  }
+  TEST_EQUAL(next, std::vector<size_t>(kThreads, kMessages), ());
+}
@@ -0,0 +1,97 @@
+#include "testing/testing.hpp"
+
+#include "base/mpmc_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+UNIT_TEST(MpmcQueue_TryPushTryPop)
+{
+  threads::MpmcQueue<size_t> queue(3);
+  TEST_EQUAL(queue.Capacity(), 4, ());
+  TEST(queue.Empty(), ());
+
+  for (size_t i = 0; i < queue.Capacity(); ++i)
+    TEST(queue.TryPush(i), ());
+  TEST(!queue.TryPush(42), ());
+  TEST_EQUAL(queue.Size(), 4, ());
+
+  size_t value;
+  for (size_t i = 0; i < queue.Capacity(); ++i)
+  {
+    TEST(queue.TryPop(value), ());
+    TEST_EQUAL(value, i, ());
+  }
+  TEST(!queue.TryPop(value), ());
+  TEST(queue.Empty(), ());
+
+  // The ring is passed several times.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    TEST(queue.TryPush(i), ());
+    TEST(queue.TryPop(value), ());
+    TEST_EQUAL(value, i, ());
+  }
+}
+
+UNIT_TEST(MpmcQueue_WaitAndPop)
+{
+  using namespace std::chrono_literals;
+  threads::MpmcQueue<size_t> queue(4);
+  size_t const value = 101;
+  auto thread = std::thread([&]() {
+    std::this_thread::sleep_for(10ms);
+    queue.Push(value);
+  });
+
+  size_t result;
+  queue.WaitAndPop(result);
+  TEST_EQUAL(result, value, ());
+
+  thread.join();
+}
+
+UNIT_TEST(MpmcQueue_ManyProducersAndConsumers)
+{
+  size_t const kThreads = 4;
+  size_t const kCount = 100000;
+  // The queue is small, so producers and consumers are parked too.
+  threads::MpmcQueue<size_t> queue(16);
+
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    producers.emplace_back([&queue, i]() {
+      for (size_t j = 0; j < kCount; ++j)
+        queue.Push(i * kCount + j + 1);
+    });
+  }
+
+  std::atomic<size_t> sum{0};
+  std::vector<std::thread> consumers;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    consumers.emplace_back([&queue, &sum]() {
+      size_t localSum = 0;
+      for (size_t j = 0; j < kCount; ++j)
+      {
+        size_t value;
+        queue.WaitAndPop(value);
+        localSum += value;
+      }
+      sum += localSum;
+    });
+  }
+
+  for (auto & thread : producers)
+    thread.join();
+  for (auto & thread : consumers)
+    thread.join();
+
+  size_t const n = kThreads * kCount;
+  TEST_EQUAL(sum, n * (n + 1) / 2, ());
+  TEST(queue.Empty(), ());
+}
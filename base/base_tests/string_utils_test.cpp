@@ -122,6 +122,7 @@ UNIT_TEST(MakeLowerCase)
 
   // es-cet
   TEST_EQUAL(MakeLowerCase("\xc3\x9f"), "ss", ());
+  TEST_EQUAL(MakeLowerCase("STRA\xc3\x9f" "E"), "strasse", ());
 
   UniChar const arr[] = {0x397, 0x10B4, 'Z'};
   UniChar const carr[] = {0x3b7, 0x2d14, 'z'};
@@ -188,6 +189,18 @@ UNIT_TEST(to_double)
   TEST(!strings::to_double("INF", d), (d));
   TEST(!strings::to_double("NAN", d), (d));
   TEST(!strings::to_double("1.18973e+4932", d), (d));
+
+  // Views into a bigger string.
+  std::string_view const coords = "27.5618,53.9023,231 27.56 ";
+  TEST(strings::to_double(coords.substr(0, 7), d), ());
+  TEST_ALMOST_EQUAL_ULPS(27.5618, d, ());
+  TEST(strings::to_double(coords.substr(8, 7), d), ());
+  TEST_ALMOST_EQUAL_ULPS(53.9023, d, ());
+  TEST(!strings::to_double(coords.substr(8, 8), d), ());
+
+  std::string const longNumber = "0." + std::string(100, '1');
+  TEST(strings::to_double(std::string_view(longNumber), d), ());
+  TEST_ALMOST_EQUAL_ULPS(0.11111111111111111, d, ());
 }
 
 UNIT_TEST(to_float)
@@ -855,6 +868,11 @@ UNIT_TEST(Normalize)
 
 UNIT_TEST(Normalize_Special)
 {
+  {
+    std::string const utf8 = "Cafe Caf\xc3\xa9";
+    TEST_EQUAL(strings::ToUtf8(strings::Normalize(strings::MakeUniString(utf8))), "Cafe Cafe", ());
+  }
+
   {
     std::string const utf8 = "ąĄćłŁÓŻźŃĘęĆ";
     TEST_EQUAL(strings::ToUtf8(strings::Normalize(strings::MakeUniString(utf8))), "aAclLOZzNEeC",
@@ -1021,6 +1039,9 @@ UNIT_TEST(IsUtf8Test)
 
   TEST(strings::IsASCIIString("YES"), ());
   TEST(strings::IsASCIIString("Nice places in Zhodino.kml"), ());
+  TEST(strings::IsASCIIString(""), ());
+  TEST(!strings::IsASCIIString("Nice places in Zhodin\xc3\xb3"), ());
+  TEST(!strings::IsASCIIString("Nice pl\xc3\xa1ces in Zhodino"), ());
 }
 
 UNIT_TEST(IsASCIINumericTest)
@@ -0,0 +1,139 @@
+#include "testing/testing.hpp"
+
+#include "base/thread_pool_work_stealing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+size_t const kTimes = 100;
+}  // namespace
+
+UNIT_TEST(ThreadPoolWorkStealing_SomeThreads)
+{
+  for (size_t t = 0; t < kTimes; ++t)
+  {
+    size_t const threadCount = 4;
+    std::atomic<size_t> counter{0};
+    {
+      base::thread_pool::work_stealing::ThreadPool threadPool(threadCount);
+      for (size_t i = 0; i < threadCount; ++i)
+      {
+        threadPool.Submit([&]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          ++counter;
+        });
+      }
+    }
+
+    TEST_EQUAL(threadCount, counter, ());
+  }
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_ReturnValue)
+{
+  for (size_t t = 0; t < kTimes; ++t)
+  {
+    size_t const threadCount = 4;
+    base::thread_pool::work_stealing::ThreadPool threadPool(threadCount);
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < threadCount; ++i)
+      futures.push_back(threadPool.Submit([=]() { return i; }));
+
+    for (size_t i = 0; i < threadCount; ++i)
+      TEST_EQUAL(futures[i].get(), i, ());
+  }
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_ManySmallTasks)
+{
+  size_t const taskCount = 100000;
+  std::atomic<size_t> counter{0};
+  {
+    base::thread_pool::work_stealing::ThreadPool threadPool(4);
+    for (size_t i = 0; i < taskCount; ++i)
+      threadPool.SubmitWork([&]() { ++counter; });
+  }
+
+  TEST_EQUAL(taskCount, counter, ());
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_NestedSubmit)
+{
+  size_t const taskCount = 100;
+  std::atomic<size_t> counter{0};
+  {
+    base::thread_pool::work_stealing::ThreadPool threadPool(2);
+    for (size_t i = 0; i < taskCount; ++i)
+    {
+      threadPool.SubmitWork([&]() {
+        ++counter;
+        threadPool.SubmitWork([&]() { ++counter; });
+      });
+    }
+    while (counter != 2 * taskCount)
+      std::this_thread::yield();
+  }
+
+  TEST_EQUAL(2 * taskCount, counter, ());
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_ParallelFor)
+{
+  base::thread_pool::work_stealing::ThreadPool threadPool(4);
+  for (size_t const size : {0, 1, 7, 1000, 100000})
+  {
+    std::vector<size_t> values(size, 0);
+    threadPool.ParallelFor(0, size, [&](size_t i) { values[i] = i; });
+
+    std::vector<size_t> expected(size);
+    std::iota(expected.begin(), expected.end(), 0);
+    TEST_EQUAL(values, expected, ());
+  }
+
+  std::atomic<size_t> counter{0};
+  threadPool.ParallelFor(10, 20, [&](size_t) { ++counter; }, 3 /* grainSize */);
+  TEST_EQUAL(counter, 10, ());
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_NestedParallelFor)
+{
+  size_t const size = 100;
+  std::atomic<size_t> counter{0};
+  base::thread_pool::work_stealing::ThreadPool threadPool(2);
+  threadPool.ParallelFor(0, size, [&](size_t) {
+    threadPool.ParallelFor(0, size, [&](size_t) { ++counter; });
+  });
+
+  TEST_EQUAL(counter, size * size, ());
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_ParallelForException)
+{
+  base::thread_pool::work_stealing::ThreadPool threadPool(4);
+  std::atomic<size_t> counter{0};
+  TEST_ANY_THROW(threadPool.ParallelFor(0, 1000, [&](size_t i) {
+    ++counter;
+    if (i == 500)
+      throw std::runtime_error("error");
+  }, 1 /* grainSize */), ());
+  TEST_EQUAL(counter, 1000, ());
+}
+
+UNIT_TEST(ThreadPoolWorkStealing_Stop)
+{
+  std::atomic<size_t> counter{0};
+  base::thread_pool::work_stealing::ThreadPool threadPool(2);
+  threadPool.SubmitWork([&]() { ++counter; });
+  threadPool.WaitingStop();
+  TEST_EQUAL(counter, 1, ());
+
+  auto f = threadPool.Submit([]() { return 1; });
+  TEST(!f.valid(), ());
+}
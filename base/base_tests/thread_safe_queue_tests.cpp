@@ -3,6 +3,7 @@
 #include "base/thread_pool_delayed.hpp"
 #include "base/thread_safe_queue.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <optional>
@@ -102,3 +103,32 @@ UNIT_TEST(ThreadSafeQueue_ExampleWithDataWrapper)
 
   thread.join();
 }
+
+UNIT_TEST(ThreadSafeQueue_Capacity)
+{
+  size_t const kSize = 10000;
+  size_t const kCapacity = 4;
+  threads::ThreadSafeQueue<size_t> queue(kCapacity);
+
+  std::atomic<size_t> maxSize{0};
+  auto thread = std::thread([&]() {
+    for (size_t i = 0; i < kSize; ++i)
+    {
+      queue.Push(i);
+      size_t const size = queue.Size();
+      if (size > maxSize)
+        maxSize = size;
+    }
+  });
+
+  for (size_t i = 0; i < kSize; ++i)
+  {
+    size_t value;
+    queue.WaitAndPop(value);
+    TEST_EQUAL(value, i, ());
+  }
+
+  thread.join();
+  TEST(queue.Empty(), ());
+  TEST_LESS_OR_EQUAL(maxSize, kCapacity, ());
+}
@@ -0,0 +1,73 @@
+#include "testing/testing.hpp"
+
+#include "base/trace.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+size_t CountOccurrences(std::string const & s, std::string const & what)
+{
+  size_t count = 0;
+  for (auto pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + what.size()))
+    ++count;
+  return count;
+}
+
+std::string Export()
+{
+  std::ostringstream os;
+  base::trace::WriteChromeTrace(os);
+  return os.str();
+}
+}  // namespace
+
+UNIT_TEST(Trace_Smoke)
+{
+  using namespace base::trace;
+
+  Clear();
+  SetEnabledCategories(0);
+  {
+    TRACE_SCOPE(Search, "Disabled");
+  }
+
+  SetEnabledCategories(GetMask(Category::Search) | GetMask(Category::Routing));
+  TEST(IsEnabled(Category::Search), ());
+  TEST(!IsEnabled(Category::Drape), ());
+  {
+    // Traces are constructed directly, so the test passes when TRACE_SCOPE is compiled out.
+    ScopedTrace const outer(Category::Search, "Outer");
+    ScopedTrace const skipped(Category::Drape, "Skipped");
+    std::thread([] { ScopedTrace const inner(Category::Routing, "Inner \"quoted\""); }).join();
+  }
+  SetEnabledCategories(0);
+
+  auto const json = Export();
+  TEST_EQUAL(json.find("Disabled"), std::string::npos, (json));
+  TEST_EQUAL(json.find("Skipped"), std::string::npos, (json));
+  TEST_EQUAL(CountOccurrences(json, "\"name\":\"Outer\",\"cat\":\"search\",\"ph\":\"X\""), 1, (json));
+  TEST_EQUAL(CountOccurrences(json, "\"name\":\"Inner \\\"quoted\\\"\",\"cat\":\"routing\""), 1,
+             (json));
+
+  Clear();
+  TEST_EQUAL(Export().find("\"name\""), std::string::npos, ());
+}
+
+UNIT_TEST(Trace_RingBuffer)
+{
+  using namespace base::trace;
+
+  Clear();
+  SetEnabledCategories(kAllCategories);
+  for (size_t i = 0; i < kThreadBufferSize + 10; ++i)
+    AddEvent(Category::Storage, i < 10 ? "Old" : "New", i, i + 1);
+  SetEnabledCategories(0);
+
+  auto const json = Export();
+  TEST_EQUAL(json.find("Old"), std::string::npos, ());
+  TEST_EQUAL(CountOccurrences(json, "\"name\":\"New\""), kThreadBufferSize, ());
+  Clear();
+}
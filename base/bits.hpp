@@ -5,6 +5,10 @@
 #include <limits>
 #include <type_traits>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace bits
 {
   // Count the number of 1 bits. Implementation: see Hacker's delight book.
@@ -157,10 +161,15 @@ namespace bits
 
   inline void BitwiseSplit(uint64_t v, uint32_t & x, uint32_t & y)
   {
+#if defined(__BMI2__)
+    x = static_cast<uint32_t>(_pext_u64(v, 0x5555555555555555ULL));
+    y = static_cast<uint32_t>(_pext_u64(v, 0xAAAAAAAAAAAAAAAAULL));
+#else
     uint32_t const hi = bits::PerfectUnshuffle(static_cast<uint32_t>(v >> 32));
     uint32_t const lo = bits::PerfectUnshuffle(static_cast<uint32_t>(v & 0xFFFFFFFFULL));
     x = ((hi & 0xFFFF) << 16) | (lo & 0xFFFF);
     y =     (hi & 0xFFFF0000) | (lo >> 16);
+#endif
   }
 
   // Returns 1 if bit is set and 0 otherwise.
@@ -199,6 +208,19 @@ namespace bits
     return result;
   }
   
+  // Compute number of zero bits from the least significant bits side.
+  inline uint32_t NumLoZeroBits64(uint64_t n)
+  {
+    if (n == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(n));
+#else
+    uint32_t result = 0;
+    while ((n & 1) == 0) { ++result; n >>= 1; }
+    return result;
+#endif
+  }
+
   // Computes number of bits needed to store the number, it is not equal to number of ones.
   // E.g. if we have a number (in bit representation) 00001000b then NumUsedBits is 4.
   inline uint32_t NumUsedBits(uint64_t n)
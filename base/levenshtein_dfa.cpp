@@ -217,20 +217,33 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
   }
   m_alphabet.push_back(missed);
 
+  // The last letter stands for all letters out of the pattern, so it is not in the table.
+  if (m_alphabet.size() > 1)
+  {
+    size_t const tableSize = m_alphabet[m_alphabet.size() - 2] - m_alphabet.front() + 1;
+    if (tableSize <= kMaxLetterIndexTableSize && m_alphabet.size() <= 255)
+    {
+      m_firstLetter = m_alphabet.front();
+      m_letterIndexTable.assign(tableSize, static_cast<uint8_t>(m_alphabet.size() - 1));
+      for (size_t i = 0; i + 1 < m_alphabet.size(); ++i)
+        m_letterIndexTable[m_alphabet[i] - m_firstLetter] = static_cast<uint8_t>(i);
+    }
+  }
+
   std::queue<State> states;
   std::map<State, size_t> visited;
 
   auto pushState = [&states, &visited, this](State const & state, size_t id)
   {
-    ASSERT_EQUAL(id, m_transitions.size(), ());
+    ASSERT_EQUAL(id, m_accepting.size(), ());
     ASSERT_EQUAL(visited.count(state), 0, (state, id));
 
-    ASSERT_EQUAL(m_transitions.size(), m_accepting.size(), ());
-    ASSERT_EQUAL(m_transitions.size(), m_errorsMade.size(), ());
+    ASSERT_EQUAL(m_transitions.size(), m_accepting.size() * m_alphabet.size(), ());
+    ASSERT_EQUAL(m_accepting.size(), m_errorsMade.size(), ());
 
     states.emplace(state);
     visited[state] = id;
-    m_transitions.emplace_back(m_alphabet.size());
+    m_transitions.resize(m_transitions.size() + m_alphabet.size());
     m_accepting.push_back(false);
     m_errorsMade.push_back(ErrorsMade(state));
     m_prefixErrorsMade.push_back(PrefixErrorsMade(state));
@@ -249,7 +262,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
 
     ASSERT_GREATER(visited.count(curr), 0, (curr));
     auto const id = visited[curr];
-    ASSERT_LESS(id, m_transitions.size(), ());
+    ASSERT_LESS(id, m_accepting.size(), ());
 
     if (IsAccepting(curr))
       m_accepting[id] = true;
@@ -272,7 +285,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
         nid = it->second;
       }
 
-      m_transitions[id][i] = nid;
+      m_transitions[id * m_alphabet.size() + i] = nid;
     }
   }
 }
@@ -359,16 +372,28 @@ size_t LevenshteinDFA::PrefixErrorsMade(State const & s) const
 size_t LevenshteinDFA::Move(size_t s, UniChar c) const
 {
   ASSERT_GREATER(m_alphabet.size(), 0, ());
-  ASSERT(is_sorted(m_alphabet.begin(), m_alphabet.end() - 1), ());
 
-  size_t i;
+  // All transitions of the rejecting state lead to itself.
+  if (s == kRejectingState)
+    return s;
+
+  return m_transitions[s * m_alphabet.size() + GetLetterIndex(c)];
+}
+
+size_t LevenshteinDFA::GetLetterIndex(UniChar c) const
+{
+  if (!m_letterIndexTable.empty())
+  {
+    if (c < m_firstLetter || c - m_firstLetter >= m_letterIndexTable.size())
+      return m_alphabet.size() - 1;
+    return m_letterIndexTable[c - m_firstLetter];
+  }
+
+  ASSERT(is_sorted(m_alphabet.begin(), m_alphabet.end() - 1), ());
   auto const it = lower_bound(m_alphabet.begin(), m_alphabet.end() - 1, c);
   if (it == m_alphabet.end() - 1 || *it != c)
-    i = m_alphabet.size() - 1;
-  else
-    i = distance(m_alphabet.begin(), it);
-
-  return m_transitions[s][i];
+    return m_alphabet.size() - 1;
+  return distance(m_alphabet.begin(), it);
 }
 
 std::string DebugPrint(LevenshteinDFA::Position const & p)
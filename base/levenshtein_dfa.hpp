@@ -3,6 +3,7 @@
 #include "base/string_utils.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -108,7 +109,7 @@ public:
 
   inline Iterator Begin() const { return Iterator(*this); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
+  size_t GetNumStates() const { return m_accepting.size(); }
   size_t GetAlphabetSize() const { return m_alphabet.size(); }
 
 private:
@@ -137,12 +138,22 @@ private:
 
   size_t Move(size_t s, UniChar c) const;
 
+  // Returns index of |c| in |m_alphabet|, the last index is for all letters out of the pattern.
+  size_t GetLetterIndex(UniChar c) const;
+
+  // Letters of a pattern usually are from one script, so indices of letters between
+  // the first and the last letter of the alphabet are kept in a table when it's not too large.
+  static size_t constexpr kMaxLetterIndexTableSize = 512;
+
   size_t m_size;
   size_t m_maxErrors;
 
   std::vector<UniChar> m_alphabet;
+  UniChar m_firstLetter = 0;
+  std::vector<uint8_t> m_letterIndexTable;
 
-  std::vector<std::vector<size_t>> m_transitions;
+  // Transitions of state |s| by letter |i| are kept in |m_transitions[s * m_alphabet.size() + i]|.
+  std::vector<size_t> m_transitions;
   std::vector<bool> m_accepting;
   std::vector<size_t> m_errorsMade;
   std::vector<size_t> m_prefixErrorsMade;
@@ -5,16 +5,154 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace
 {
 std::mutex g_logMutex;
+
+// Sink of LogMessageAsync. Every thread appends messages to its own buffer, so LOG calls on
+// different threads don't contend with each other and with the console. A background thread
+// periodically moves all buffers to stderr. Messages of a thread are written in their order,
+// messages of different threads are ordered by the moment they were logged.
+class AsyncLogger
+{
+public:
+  // The logger is never destroyed because LOG may be called from destructors of statics.
+  static AsyncLogger & Instance()
+  {
+    static auto * instance = new AsyncLogger();
+    return *instance;
+  }
+
+  // Returns false if the process is exiting and the message must be written synchronously.
+  bool Add(std::string && message)
+  {
+    if (m_exiting)
+      return false;
+
+    auto & buffer = GetThreadBuffer();
+    size_t size;
+    {
+      std::lock_guard<std::mutex> lock(buffer.m_mutex);
+      buffer.m_entries.push_back({m_nextSeq.fetch_add(1, std::memory_order_relaxed), std::move(message)});
+      size = buffer.m_entries.size();
+    }
+
+    if (size == kWakeUpSize)
+      m_cv.notify_one();
+    return true;
+  }
+
+  // Writes all messages which were added before the call.
+  void Flush()
+  {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    std::vector<Entry> entries;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      // Buffers of finished threads are referenced by the logger only. Such a buffer is checked
+      // before it's drained, so it can't get a message after that.
+      size_t alive = 0;
+      for (auto & buffer : m_buffers)
+      {
+        bool const finished = buffer.use_count() == 1;
+        {
+          std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+          std::move(buffer->m_entries.begin(), buffer->m_entries.end(), std::back_inserter(entries));
+          buffer->m_entries.clear();
+        }
+        if (!finished)
+          std::swap(m_buffers[alive++], buffer);
+      }
+      m_buffers.resize(alive);
+    }
+
+    if (entries.empty())
+      return;
+
+    std::sort(entries.begin(), entries.end(),
+              [](Entry const & lhs, Entry const & rhs) { return lhs.m_seq < rhs.m_seq; });
+
+    std::string out;
+    for (auto const & e : entries)
+      out += e.m_message;
+
+    std::lock_guard<std::mutex> logLock(g_logMutex);
+    std::cerr << out;
+    std::cerr.flush();
+  }
+
+private:
+  struct Entry
+  {
+    uint64_t m_seq;
+    std::string m_message;
+  };
+
+  struct ThreadBuffer
+  {
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+  };
+
+  // Number of pending messages of a thread which wakes up the flusher before its period.
+  static size_t constexpr kWakeUpSize = 1024;
+  static std::chrono::milliseconds constexpr kFlushPeriod{50};
+
+  AsyncLogger()
+  {
+    std::thread([this] {
+      while (true)
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_cv.wait_for(lock, kFlushPeriod);
+        }
+        Flush();
+      }
+    }).detach();
+
+    std::atexit([] {
+      auto & logger = AsyncLogger::Instance();
+      logger.m_exiting = true;
+      logger.Flush();
+    });
+  }
+
+  ThreadBuffer & GetThreadBuffer()
+  {
+    thread_local std::shared_ptr<ThreadBuffer> const buffer = [this] {
+      auto b = std::make_shared<ThreadBuffer>();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_buffers.push_back(b);
+      return b;
+    }();
+    return *buffer;
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+  // Serializes flushes of the background thread and callers of Flush().
+  std::mutex m_writeMutex;
+
+  std::atomic<uint64_t> m_nextSeq{0};
+  std::atomic<bool> m_exiting{false};
+};
 }  // namespace
 
 namespace base
@@ -71,10 +209,15 @@ int LogHelper::GetThreadID()
 }
 
 void LogHelper::WriteProlog(std::ostream & s, LogLevel level)
+{
+  WriteProlog(s, level, GetThreadID());
+}
+
+void LogHelper::WriteProlog(std::ostream & s, LogLevel level, int threadId)
 {
   s << "LOG";
 
-  s << " TID(" << GetThreadID() << ")";
+  s << " TID(" << threadId << ")";
   s << " " << m_names[level];
 
   double const sec = m_timer.ElapsedSeconds();
@@ -96,6 +239,37 @@ void LogMessageDefault(LogLevel level, SrcPoint const & srcPoint, std::string co
   CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
 }
 
+void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, std::string const & msg)
+{
+  thread_local int const threadId = [] {
+    std::lock_guard lock(g_logMutex);
+    return LogHelper::Instance().GetThreadID();
+  }();
+
+  std::ostringstream out;
+  LogHelper::Instance().WriteProlog(out, level, threadId);
+  out << DebugPrint(srcPoint) << msg << '\n';
+
+  auto & logger = AsyncLogger::Instance();
+  if (!logger.Add(out.str()))
+  {
+    std::lock_guard lock(g_logMutex);
+    std::cerr << out.str();
+  }
+
+  if (level >= g_LogAbortLevel)
+  {
+    logger.Flush();
+    CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
+  }
+}
+
+void FlushAsyncLog()
+{
+  if (LogMessage == &LogMessageAsync)
+    AsyncLogger::Instance().Flush();
+}
+
 void LogMessageTests(LogLevel level, SrcPoint const &, std::string const & msg)
 {
   std::lock_guard lock(g_logMutex);
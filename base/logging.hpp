@@ -33,6 +33,7 @@ public:
 
   int GetThreadID();
   void WriteProlog(std::ostream & s, LogLevel level);
+  void WriteProlog(std::ostream & s, LogLevel level, int threadId);
 
 private:
   int m_threadsCount;
@@ -64,6 +65,13 @@ LogMessageFn SetLogMessageFn(LogMessageFn fn);
 void LogMessageDefault(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
 void LogMessageTests(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
 
+// Formats messages like LogMessageDefault but writes them to stderr on a background thread, so
+// LOG in hot loops doesn't wait for the console and for other logging threads. Messages of each
+// thread keep their order. Pending messages are flushed before an abort and at exit.
+void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, std::string const & msg);
+// Synchronously writes all messages passed to LogMessageAsync before the call.
+void FlushAsyncLog();
+
 // Scope guard to temporarily suppress a specific log level and all lower ones.
 //
 // For example, in unit tests:
@@ -178,9 +178,23 @@ void MakeLowerCaseInplace(UniString & s)
 {
   size_t const size = s.size();
 
+  // Most of the chars are folded to a single char, so do it in place
+  // until the first one which expands.
+  size_t first = 0;
+  for (; first < size; ++first)
+  {
+    UniChar const c = LowerUniChar(s[first]);
+    if (c == 0)
+      break;
+    s[first] = c;
+  }
+  if (first == size)
+    return;
+
   UniString r;
-  r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.reserve(size + 2);
+  r.append(s.begin(), s.begin() + first);
+  for (size_t i = first; i < size; ++i)
   {
     UniChar const c = LowerUniChar(s[i]);
     if (c != 0)
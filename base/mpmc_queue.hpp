@@ -0,0 +1,202 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace threads
+{
+// Bounded lock-free multi-producer multi-consumer queue (the ring by D. Vyukov). Every cell
+// keeps a sequence number which tells if the cell is ready to be written or read on the
+// current lap over the ring, so producers and consumers only race on the positions.
+// Push() and WaitAndPop() have the same semantics as in ThreadSafeQueue with a capacity. They
+// park on a condition variable only when the queue is full or empty, and the waking side
+// takes the mutex only when someone is parked.
+template <typename T>
+class MpmcQueue
+{
+public:
+  // |capacity| is rounded up to a power of two.
+  explicit MpmcQueue(size_t capacity)
+  {
+    CHECK_GREATER(capacity, 0, ());
+    size_t size = 2;
+    while (size < capacity)
+      size *= 2;
+
+    m_cells = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; ++i)
+      m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+    m_mask = size - 1;
+  }
+
+  MpmcQueue(MpmcQueue const &) = delete;
+  MpmcQueue & operator=(MpmcQueue const &) = delete;
+
+  bool TryPush(T const & value) { return PushAndNotify(value); }
+  bool TryPush(T && value) { return PushAndNotify(std::move(value)); }
+
+  bool TryPop(T & value)
+  {
+    if (!TryPopImpl(value))
+      return false;
+
+    Notify(m_pushWaiters, m_notFull);
+    return true;
+  }
+
+  void Push(T const & value) { PushImpl(value); }
+  void Push(T && value) { PushImpl(std::move(value)); }
+
+  void WaitAndPop(T & value)
+  {
+    if (TryPop(value))
+      return;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_popWaiters.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_notEmpty.wait(lock, [&] { return TryPopImpl(value); });
+      m_popWaiters.fetch_sub(1);
+    }
+    Notify(m_pushWaiters, m_notFull);
+  }
+
+  // Size() and Empty() are exact only when there are no concurrent pushes and pops.
+  size_t Size() const
+  {
+    size_t const popPos = m_popPos.load(std::memory_order_relaxed);
+    size_t const pushPos = m_pushPos.load(std::memory_order_relaxed);
+    return pushPos > popPos ? pushPos - popPos : 0;
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+  size_t Capacity() const { return m_mask + 1; }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> m_sequence;
+    T m_value;
+  };
+
+  bool TryPopImpl(T & value)
+  {
+    size_t pos = m_popPos.load(std::memory_order_relaxed);
+    Cell * cell;
+    while (true)
+    {
+      cell = &m_cells[pos & m_mask];
+      size_t const sequence = cell->m_sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0)
+      {
+        if (m_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        return false;  // Empty.
+      }
+      else
+      {
+        pos = m_popPos.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(cell->m_value);
+    cell->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename U>
+  bool TryPushImpl(U && value)
+  {
+    size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    Cell * cell;
+    while (true)
+    {
+      cell = &m_cells[pos & m_mask];
+      size_t const sequence = cell->m_sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0)
+      {
+        if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        return false;  // Full.
+      }
+      else
+      {
+        pos = m_pushPos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->m_value = std::forward<U>(value);
+    cell->m_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename U>
+  bool PushAndNotify(U && value)
+  {
+    if (!TryPushImpl(std::forward<U>(value)))
+      return false;
+
+    Notify(m_popWaiters, m_notEmpty);
+    return true;
+  }
+
+  template <typename U>
+  void PushImpl(U && value)
+  {
+    // |value| is moved only by the successful try.
+    if (!TryPushImpl(std::forward<U>(value)))
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_pushWaiters.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_notFull.wait(lock, [&] { return TryPushImpl(std::forward<U>(value)); });
+      m_pushWaiters.fetch_sub(1);
+    }
+    Notify(m_popWaiters, m_notEmpty);
+  }
+
+  // A waiter increments its counter before the last check under the mutex, so either it sees
+  // the change or the counter is seen here and the mutex orders the notification after the
+  // waiter is parked.
+  void Notify(std::atomic<size_t> const & waiters, std::condition_variable & cond)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    cond.notify_all();
+  }
+
+  std::unique_ptr<Cell[]> m_cells;
+  size_t m_mask = 0;
+
+  // Positions are on separate cache lines, so producers and consumers don't share a line.
+  alignas(64) std::atomic<size_t> m_pushPos{0};
+  alignas(64) std::atomic<size_t> m_popPos{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  std::condition_variable m_notFull;
+  std::atomic<size_t> m_popWaiters{0};
+  std::atomic<size_t> m_pushWaiters{0};
+};
+}  // namespace threads
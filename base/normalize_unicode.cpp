@@ -19,9 +19,18 @@ void NormalizeInplace(strings::UniString & s)
 {
   size_t const size = s.size();
 
+  // Chars below 0xa0 are never decomposed, the string is left untouched
+  // until the first other char.
+  size_t first = 0;
+  while (first < size && s[first] < 0xa0)
+    ++first;
+  if (first == size)
+    return;
+
   strings::UniString r;
   r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.append(s.begin(), s.begin() + first);
+  for (size_t i = first; i < size; ++i)
   {
     strings::UniChar const c = s[i];
     // ASCII optimization
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iterator>
 
@@ -285,9 +286,20 @@ std::u16string ToUtf16(std::string_view utf8)
 
 bool IsASCIIString(std::string_view sv)
 {
-  for (auto c : sv)
+  // Check 8 bytes at once, most of the strings are short and pure ASCII.
+  uint64_t constexpr kHighBits = 0x8080808080808080ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= sv.size(); i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, sv.data() + i, sizeof(word));
+    if (word & kHighBits)
+      return false;
+  }
+
+  for (; i < sv.size(); ++i)
   {
-    if (c & 0x80)
+    if (sv[i] & 0x80)
       return false;
   }
   return true;
@@ -9,6 +9,7 @@
 #include <cerrno>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iterator>
 #include <limits>
@@ -529,7 +530,16 @@ template <class T> inline bool to_uint(std::string_view sv, T & i)
 
 inline bool to_double(std::string_view sv, double & d)
 {
-  /// @todo std::from_chars still not implemented?
+  /// @todo std::from_chars for floating point is still not implemented on all our platforms.
+  // The parser needs a null-terminated string, short numbers are copied on stack to avoid
+  // allocations when parsing of coordinates from text files.
+  char buffer[64];
+  if (sv.size() < std::size(buffer))
+  {
+    std::memcpy(buffer, sv.data(), sv.size());
+    buffer[sv.size()] = '\0';
+    return to_double(static_cast<char const *>(buffer), d);
+  }
   return to_double(std::string(sv), d);
 }
 //@}
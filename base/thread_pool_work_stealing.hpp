@@ -0,0 +1,316 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/thread_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace base
+{
+using namespace threads;
+namespace thread_pool
+{
+namespace work_stealing
+{
+// ThreadPool has the same interface as computational::ThreadPool but keeps a separate task deque
+// for every worker. A worker takes tasks from the back of its own deque and, when it runs out of
+// work, steals from the front of the other deques. So there is no single lock which all workers
+// and producers contend for, and the pool scales well with many small tasks.
+// Tasks which are submitted from a worker thread go to the worker's own deque.
+// When the destructor is called, all threads will join.
+// Warning: ThreadPool works with std::thread instead of SimpleThread and therefore
+// should not be used when the JVM is needed.
+class ThreadPool
+{
+public:
+  using FunctionType = FunctionWrapper;
+  using Threads = std::vector<std::thread>;
+
+  // Constructs a ThreadPool.
+  // threadCount - number of threads used by the thread pool.
+  // Warning: The constructor may throw exceptions.
+  explicit ThreadPool(size_t threadCount) : m_queues(threadCount), m_joiner(m_threads)
+  {
+    CHECK_GREATER(threadCount, 0, ());
+
+    m_threads.reserve(threadCount);
+    try
+    {
+      for (size_t i = 0; i < threadCount; i++)
+        m_threads.emplace_back(&ThreadPool::Worker, this, i);
+    }
+    catch (...)  // std::system_error etc.
+    {
+      Stop();
+      throw;
+    }
+  }
+
+  // Destroys the ThreadPool.
+  // This function will block until all runnables have been completed.
+  ~ThreadPool()
+  {
+    m_done = true;
+    WakeUp(true /* all */);
+  }
+
+  size_t GetThreadCount() const { return m_threads.size(); }
+
+  // Submit task for execution.
+  // func - task to be performed.
+  // args - arguments for func.
+  // The function will return the object future.
+  // Warning: If the thread pool is stopped then the call will be ignored.
+  template <typename F, typename... Args>
+  auto Submit(F && func, Args &&... args) -> std::future<decltype(func(args...))>
+  {
+    using ResultType = decltype(func(args...));
+    std::packaged_task<ResultType()> task(std::bind(std::forward<F>(func),
+                                                    std::forward<Args>(args)...));
+    std::future<ResultType> result(task.get_future());
+    if (!Push(std::move(task)))
+      return {};
+
+    return result;
+  }
+
+  // Submit work for execution.
+  // func - task to be performed.
+  // args - arguments for func
+  // Warning: If the thread pool is stopped then the call will be ignored.
+  template <typename F, typename... Args>
+  void SubmitWork(F && func, Args &&... args)
+  {
+    Push(std::bind(std::forward<F>(func), std::forward<Args>(args)...));
+  }
+
+  // Calls fn(i) for every i in [begin, end) and blocks until all calls are completed.
+  // The range is split into chunks of |grainSize| indices (chosen automatically when it's 0).
+  // The calling thread executes pool tasks while waiting, so ParallelFor may be
+  // called from a task which is run by the same pool.
+  // If some of the calls throw, the first exception is rethrown after all chunks are finished.
+  template <typename Fn>
+  void ParallelFor(size_t begin, size_t end, Fn && fn, size_t grainSize = 0)
+  {
+    if (begin >= end)
+      return;
+
+    size_t const count = end - begin;
+    if (grainSize == 0)
+      grainSize = std::max(count / (GetThreadCount() * kChunksPerThread), size_t{1});
+
+    size_t const chunksCount = (count + grainSize - 1) / grainSize;
+    std::atomic<size_t> remaining{chunksCount};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto const runChunk = [&](size_t chunk) {
+      size_t const from = begin + chunk * grainSize;
+      size_t const to = std::min(from + grainSize, end);
+      try
+      {
+        for (size_t i = from; i < to; ++i)
+          fn(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+      }
+      --remaining;
+    };
+
+    // The first chunk is left for the calling thread.
+    for (size_t chunk = 1; chunk < chunksCount; ++chunk)
+    {
+      if (!Push([&runChunk, chunk]() { runChunk(chunk); }))
+        runChunk(chunk);
+    }
+    runChunk(0);
+
+    while (remaining != 0)
+    {
+      if (!TryRunPendingTask())
+        std::this_thread::yield();
+    }
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  // Stop a ThreadPool.
+  // Removes the tasks that are not yet started from the queues.
+  // Unlike the destructor, this function does not wait for all runnables to complete:
+  // the tasks will stop as soon as possible.
+  void Stop()
+  {
+    m_done = true;
+    for (auto & queue : m_queues)
+    {
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      m_pending -= queue.m_tasks.size();
+      queue.m_tasks.clear();
+    }
+    WakeUp(true /* all */);
+  }
+
+  void WaitingStop()
+  {
+    m_done = true;
+    WakeUp(true /* all */);
+    m_joiner.Join();
+  }
+
+private:
+  static size_t constexpr kChunksPerThread = 4;
+
+  struct alignas(64) WorkQueue
+  {
+    std::mutex m_mutex;
+    std::deque<FunctionType> m_tasks;
+  };
+
+  struct WorkerInfo
+  {
+    ThreadPool const * m_pool = nullptr;
+    size_t m_index = 0;
+  };
+
+  static WorkerInfo & GetThisWorker()
+  {
+    static thread_local WorkerInfo info;
+    return info;
+  }
+
+  template <typename F>
+  bool Push(F && func)
+  {
+    if (m_done)
+      return false;
+
+    auto const & worker = GetThisWorker();
+    size_t const index =
+        worker.m_pool == this ? worker.m_index : m_nextQueue++ % m_queues.size();
+    {
+      auto & queue = m_queues[index];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      queue.m_tasks.emplace_back(std::forward<F>(func));
+      ++m_pending;
+    }
+    WakeUp(false /* all */);
+    return true;
+  }
+
+  void WakeUp(bool all)
+  {
+    // Workers increase |m_sleeping| under |m_mutex| before they check |m_pending| and fall asleep,
+    // so it's enough to take the lock only when somebody may be sleeping.
+    if (!all && m_sleeping == 0)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    if (all)
+      m_condition.notify_all();
+    else
+      m_condition.notify_one();
+  }
+
+  // Takes a task from the back of the deque |index| and then from the fronts of the other deques.
+  bool TryPop(size_t index, FunctionType & task)
+  {
+    {
+      auto & own = m_queues[index];
+      std::lock_guard<std::mutex> lock(own.m_mutex);
+      if (!own.m_tasks.empty())
+      {
+        task = std::move(own.m_tasks.back());
+        own.m_tasks.pop_back();
+        --m_pending;
+        return true;
+      }
+    }
+
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+      auto & victim = m_queues[(index + i) % m_queues.size()];
+      std::unique_lock<std::mutex> lock(victim.m_mutex, std::try_to_lock);
+      if (!lock.owns_lock() || victim.m_tasks.empty())
+        continue;
+
+      task = std::move(victim.m_tasks.front());
+      victim.m_tasks.pop_front();
+      --m_pending;
+      return true;
+    }
+    return false;
+  }
+
+  bool TryRunPendingTask()
+  {
+    if (m_pending == 0)
+      return false;
+
+    auto const & worker = GetThisWorker();
+    size_t const index = worker.m_pool == this ? worker.m_index : 0;
+    FunctionType task;
+    if (!TryPop(index, task))
+      return false;
+
+    task();
+    return true;
+  }
+
+  void Worker(size_t index)
+  {
+    auto & worker = GetThisWorker();
+    worker.m_pool = this;
+    worker.m_index = index;
+
+    while (true)
+    {
+      FunctionType task;
+      if (TryPop(index, task))
+      {
+        task();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      ++m_sleeping;
+      m_condition.wait(lock, [&] { return m_done || m_pending != 0; });
+      --m_sleeping;
+
+      if (m_done && m_pending == 0)
+        return;
+    }
+  }
+
+  std::vector<WorkQueue> m_queues;
+  std::atomic<size_t> m_nextQueue{0};
+  std::atomic<size_t> m_pending{0};
+  std::atomic<size_t> m_sleeping{0};
+  std::atomic<bool> m_done{false};
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  Threads m_threads;
+  ThreadsJoiner<> m_joiner;
+};
+}  // namespace work_stealing
+}  // namespace thread_pool
+}  // namespace base
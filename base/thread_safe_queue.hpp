@@ -1,6 +1,8 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstddef>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <utility>
@@ -12,16 +14,21 @@ class ThreadSafeQueue
 {
 public:
   ThreadSafeQueue() = default;
+  // Push() waits while the queue holds |capacity| elements, so a fast producer can't
+  // run too far ahead of consumers.
+  explicit ThreadSafeQueue(size_t capacity) : m_capacity(capacity) {}
   ThreadSafeQueue(ThreadSafeQueue const & other)
   {
     std::lock_guard<std::mutex> lk(other.m_mutex);
     m_queue = other.m_queue;
+    m_capacity = other.m_capacity;
   }
 
   void Push(T const & value)
   {
     {
-      std::lock_guard<std::mutex> lk(m_mutex);
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_notFull.wait(lk, [this]{ return m_queue.size() < m_capacity; });
       m_queue.push(value);
     }
     m_cond.notify_one();
@@ -30,7 +37,8 @@ public:
   void Push(T && value)
   {
     {
-      std::lock_guard<std::mutex> lk(m_mutex);
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_notFull.wait(lk, [this]{ return m_queue.size() < m_capacity; });
       m_queue.push(std::move(value));
     }
     m_cond.notify_one();
@@ -38,22 +46,27 @@ public:
 
   void WaitAndPop(T & value)
   {
-    std::unique_lock<std::mutex> lk(m_mutex);
-    m_cond.wait(lk, [this]{ return !m_queue.empty(); });
-    value = std::move(m_queue.front());
-    m_queue.pop();
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_cond.wait(lk, [this]{ return !m_queue.empty(); });
+      value = std::move(m_queue.front());
+      m_queue.pop();
+    }
+    m_notFull.notify_one();
   }
 
   bool TryPop(T & value)
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    if (m_queue.empty())
-      return false;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      if (m_queue.empty())
+        return false;
 
-    value = std::move(m_queue.front());
-    m_queue.pop();
+      value = std::move(m_queue.front());
+      m_queue.pop();
+    }
+    m_notFull.notify_one();
     return true;
-
   }
 
   bool Empty() const
@@ -72,5 +85,7 @@ private:
   mutable std::mutex m_mutex;
   std::queue<T> m_queue;
   std::condition_variable m_cond;
+  std::condition_variable m_notFull;
+  size_t m_capacity = std::numeric_limits<size_t>::max();
 };
 }  // namespace threads
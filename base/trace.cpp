@@ -0,0 +1,178 @@
+#include "base/trace.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace base
+{
+namespace trace
+{
+namespace impl
+{
+std::atomic<uint32_t> g_enabledCategories{0};
+}  // namespace impl
+
+namespace
+{
+struct Event
+{
+  char const * m_name = nullptr;
+  uint64_t m_beginNs = 0;
+  uint64_t m_durationNs = 0;
+  Category m_category = Category::Count;
+};
+
+// The buffer is written by its thread and read by exporters. The mutex is contended only during
+// an export, so it costs a couple of atomic operations per event.
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(uint32_t threadId) : m_events(kThreadBufferSize), m_threadId(threadId) {}
+
+  std::mutex m_mutex;
+  std::vector<Event> m_events;
+  size_t m_next = 0;
+  bool m_wrapped = false;
+  uint32_t m_threadId;
+};
+
+class Registry
+{
+public:
+  static Registry & Instance()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  std::shared_ptr<ThreadBuffer> Register()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(std::make_shared<ThreadBuffer>(m_nextThreadId++));
+    return m_buffers.back();
+  }
+
+  template <typename Fn>
+  void ForEachBuffer(Fn && fn)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const & buffer : m_buffers)
+      fn(*buffer);
+  }
+
+  // Buffers of finished threads are referenced by the registry only.
+  void RemoveFinished()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](auto const & buffer) { return buffer.use_count() == 1; }),
+                    m_buffers.end());
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  uint32_t m_nextThreadId = 1;
+};
+
+ThreadBuffer & GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> const buffer = Registry::Instance().Register();
+  return *buffer;
+}
+
+void WriteEscaped(std::ostream & os, char const * s)
+{
+  for (; *s; ++s)
+  {
+    if (*s == '"' || *s == '\\')
+      os << '\\';
+    os << *s;
+  }
+}
+}  // namespace
+
+std::string DebugPrint(Category category)
+{
+  switch (category)
+  {
+  case Category::Routing: return "routing";
+  case Category::Search: return "search";
+  case Category::Drape: return "drape";
+  case Category::Storage: return "storage";
+  case Category::Generator: return "generator";
+  case Category::Count: return "count";
+  }
+  UNREACHABLE();
+}
+
+void SetEnabledCategories(uint32_t mask)
+{
+  impl::g_enabledCategories.store(mask & kAllCategories, std::memory_order_relaxed);
+}
+
+void AddEvent(Category category, char const * name, uint64_t beginNs, uint64_t endNs)
+{
+  ASSERT(name, ());
+  auto & buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+
+  auto & event = buffer.m_events[buffer.m_next];
+  event.m_name = name;
+  event.m_beginNs = beginNs;
+  event.m_durationNs = endNs - beginNs;
+  event.m_category = category;
+
+  if (++buffer.m_next == buffer.m_events.size())
+  {
+    buffer.m_next = 0;
+    buffer.m_wrapped = true;
+  }
+}
+
+void WriteChromeTrace(std::ostream & os)
+{
+  auto const oldPrecision = os.precision(3);
+  auto const oldFlags = os.setf(std::ios::fixed, std::ios::floatfield);
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  Registry::Instance().ForEachBuffer([&](ThreadBuffer & buffer) {
+    std::lock_guard<std::mutex> lock(buffer.m_mutex);
+    size_t const size = buffer.m_wrapped ? buffer.m_events.size() : buffer.m_next;
+    size_t const begin = buffer.m_wrapped ? buffer.m_next : 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+      auto const & event = buffer.m_events[(begin + i) % buffer.m_events.size()];
+      if (!first)
+        os << ',';
+      first = false;
+
+      os << "\n{\"name\":\"";
+      WriteEscaped(os, event.m_name);
+      os << "\",\"cat\":\"" << DebugPrint(event.m_category) << "\",\"ph\":\"X\",\"ts\":"
+         << event.m_beginNs / 1000.0 << ",\"dur\":" << event.m_durationNs / 1000.0
+         << ",\"pid\":1,\"tid\":" << buffer.m_threadId << '}';
+    }
+  });
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  os.precision(oldPrecision);
+  os.flags(oldFlags);
+}
+
+void Clear()
+{
+  Registry::Instance().RemoveFinished();
+  Registry::Instance().ForEachBuffer([](ThreadBuffer & buffer) {
+    std::lock_guard<std::mutex> lock(buffer.m_mutex);
+    buffer.m_next = 0;
+    buffer.m_wrapped = false;
+  });
+}
+}  // namespace trace
+}  // namespace base
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Scoped traces of slow paths which can be turned on in release builds. Every thread records
+// events into its own ring buffer, the buffers are exported in Chrome trace event format which
+// is opened by chrome://tracing and ui.perfetto.dev. A disabled trace costs one relaxed load.
+//
+// Usage:
+//   TRACE_SCOPE(Search, "Processor::Search");
+// |name| must be a string literal or another string with static storage duration.
+//
+// Build with -DDISABLE_TRACING to compile the traces out.
+
+namespace base
+{
+namespace trace
+{
+enum class Category : uint8_t
+{
+  Routing,
+  Search,
+  Drape,
+  Storage,
+  Generator,
+
+  Count
+};
+
+std::string DebugPrint(Category category);
+
+uint32_t constexpr GetMask(Category category) { return 1u << static_cast<uint32_t>(category); }
+
+uint32_t constexpr kAllCategories = (1u << static_cast<uint32_t>(Category::Count)) - 1;
+
+// Number of the latest events kept per thread.
+size_t constexpr kThreadBufferSize = 16 * 1024;
+
+namespace impl
+{
+extern std::atomic<uint32_t> g_enabledCategories;
+}  // namespace impl
+
+// Sets the categories to record, recording is off for all categories by default.
+void SetEnabledCategories(uint32_t mask);
+
+inline bool IsEnabled(Category category)
+{
+  return (impl::g_enabledCategories.load(std::memory_order_relaxed) & GetMask(category)) != 0;
+}
+
+inline uint64_t NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Records a complete event into the ring buffer of the calling thread.
+void AddEvent(Category category, char const * name, uint64_t beginNs, uint64_t endNs);
+
+// Writes the events of all threads as a Chrome trace JSON object.
+void WriteChromeTrace(std::ostream & os);
+
+// Drops the recorded events and the buffers of finished threads.
+void Clear();
+
+class ScopedTrace
+{
+public:
+  ScopedTrace(Category category, char const * name)
+    : m_name(IsEnabled(category) ? name : nullptr), m_category(category)
+  {
+    if (m_name)
+      m_beginNs = NowNs();
+  }
+
+  ~ScopedTrace()
+  {
+    if (m_name)
+      AddEvent(m_category, m_name, m_beginNs, NowNs());
+  }
+
+private:
+  char const * m_name;
+  uint64_t m_beginNs = 0;
+  Category m_category;
+
+  DISALLOW_COPY_AND_MOVE(ScopedTrace);
+};
+}  // namespace trace
+}  // namespace base
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#ifdef DISABLE_TRACING
+#define TRACE_SCOPE(category, name) static_cast<void>(0)
+#else
+#define TRACE_SCOPE(category, name)                                     \
+  ::base::trace::ScopedTrace const TRACE_CONCAT(traceScope_, __LINE__)( \
+      ::base::trace::Category::category, name)
+#endif  // DISABLE_TRACING
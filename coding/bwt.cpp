@@ -12,124 +12,62 @@ namespace
 {
 size_t const kNumBytes = 256;
 
-// Fake trailing '$' for the BWT, used for original string
-// reconstruction.
-uint32_t const kEOS = 256;
-
-// FirstColumn represents the first column in the BWT matrix. As
-// during reverse BWT we need to reconstruct canonical first column,
-// with '$' as the first element, this wrapper is used. Also note that
-// other characters in the first column are sorted, so we actually
-// don't need to store them explicitly, it's enough to store start
-// positions of the corresponding groups of consecutive characters.
-class FirstColumn
+// Reverse BWT works on the canonical BWT matrix, which has a fake
+// trailing '$' as the least symbol. Its last column is
+// s[start] + s[0, start) + '$' + s[start, n), and its first column is
+// '$' followed by sorted symbols of |s|.
+//
+// NextRows builds the LF-mapping at once: for a row of the first
+// column it keeps the row of the last column with the same occurrence
+// of the symbol, so the original string is restored in O(n) without
+// rank and select queries.
+class NextRows
 {
 public:
-  FirstColumn(size_t n, uint8_t const * s) : m_n(n), m_starts({})
+  NextRows(size_t n, size_t start, uint8_t const * s) : m_first(n + 1), m_next(n + 1)
   {
-    m_starts.fill(0);
+    CHECK_LESS(n, std::numeric_limits<uint32_t>::max(), ());
+    ASSERT_LESS(start, n, ());
+
+    std::array<uint32_t, kNumBytes> rows = {};
     for (size_t i = 0; i < n; ++i)
-      ++m_starts[s[i]];
+      ++rows[s[i]];
 
-    size_t offset = 0;
-    for (size_t i = 0; i < m_starts.size(); ++i)
+    // Row 0 of the first column is '$'.
+    uint32_t row = 1;
+    for (size_t b = 0; b < kNumBytes; ++b)
     {
-      auto const count = m_starts[i];
-      m_starts[i] = offset;
-      offset += count;
+      auto const count = rows[b];
+      std::fill(m_first.begin() + row, m_first.begin() + row + count, static_cast<uint8_t>(b));
+      rows[b] = row;
+      row += count;
     }
-  }
-
-  size_t Size() const { return m_n + 1; }
-
-  uint32_t operator[](size_t i) const
-  {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return kEOS;
-
-    --i;
-    auto it = std::upper_bound(m_starts.begin(), m_starts.end(), i);
-    ASSERT(it != m_starts.begin(), ());
-    --it;
-    return static_cast<uint32_t>(std::distance(m_starts.begin(), it));
-  }
-
-  // Returns the rank of the i-th symbol among symbols with the same
-  // value.
-  size_t Rank(size_t i) const
-  {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return 0;
-
-    --i;
-    auto it = std::upper_bound(m_starts.begin(), m_starts.end(), i);
-    if (it == m_starts.begin())
-      return i;
-    --it;
-    return i - *it;
-  }
 
-private:
-  size_t const m_n;
-  std::array<size_t, kNumBytes> m_starts;
-};
-
-// LastColumn represents the last column in the BWT matrix. As during
-// reverse BWT we need to reconstruct canonical last column, |s| is
-// replaced by s[start] + s[0, start) + '$' + s[start, n).
-class LastColumn
-{
-public:
-  LastColumn(size_t n, size_t start, uint8_t const * s) : m_n(n), m_start(start), m_s(s)
-  {
-    for (size_t i = 0; i < Size(); ++i)
+    // Occurrences of a symbol go in the same order in both columns.
+    auto const add = [&](size_t lastRow, uint8_t b)
     {
-      auto const b = (*this)[i];
-      if (b == kEOS)
-        continue;
-      ASSERT_LESS(b, kNumBytes, ());
-      m_table[b].push_back(i);
-    }
-  }
-
-  size_t Size() const { return m_n + 1; }
-
-  uint32_t operator[](size_t i) const
-  {
-    if (i == 0)
+      m_next[rows[b]++] = static_cast<uint32_t>(lastRow);
+    };
+    add(0, s[start]);
+    for (size_t i = 1; i <= n; ++i)
     {
-      ASSERT_LESS(m_start, m_n, ());
-      return m_s[m_start];
+      if (i == start + 1)
+        continue;  // '$'
+      add(i, s[i - 1]);
     }
-
-    if (i == m_start + 1)
-      return kEOS;
-
-    ASSERT_LESS_OR_EQUAL(i, m_n, ());
-    return m_s[i - 1];
   }
 
-  // Returns the index of the |rank|-th |byte| in the canonical BWT
-  // last column.
-  size_t Select(uint32_t byte, size_t rank)
+  uint8_t First(size_t row) const
   {
-    if (byte == kEOS)
-    {
-      ASSERT_EQUAL(rank, 0, ());
-      return 0;
-    }
-
-    ASSERT_LESS(rank, m_table[byte].size(), (byte, rank));
-    return m_table[byte][rank];
+    ASSERT_NOT_EQUAL(row, 0, ());
+    return m_first[row];
   }
 
+  size_t Next(size_t row) const { return m_next[row]; }
+
 private:
-  size_t const m_n;
-  size_t const m_start;
-  uint8_t const * const m_s;
-  std::array<std::vector<size_t>, kNumBytes> m_table;
+  std::vector<uint8_t> m_first;
+  std::vector<uint32_t> m_next;
 };
 }  // namespace
 
@@ -168,20 +106,16 @@ void RevBWT(size_t n, size_t start, uint8_t const * s, uint8_t * r)
   if (n == 0)
     return;
 
-  FirstColumn first(n, s);
-  LastColumn last(n, start, s);
+  NextRows const rows(n, start, s);
 
-  auto curr = start + 1;
+  size_t curr = start + 1;
   for (size_t i = 0; i < n; ++i)
   {
-    ASSERT_LESS(curr, first.Size(), ());
-    ASSERT(first[curr] != kEOS, ());
-
-    r[i] = first[curr];
-    curr = last.Select(r[i], first.Rank(curr));
+    r[i] = rows.First(curr);
+    curr = rows.Next(curr);
   }
 
-  ASSERT_EQUAL(first[curr], kEOS, ());
+  ASSERT_EQUAL(curr, 0, ());
 }
 
 void RevBWT(size_t start, std::string const & s, std::string & r)
@@ -172,6 +172,27 @@ UNIT_TEST(CompressedBitVector_Intersect4)
   CheckIntersection(setBits1, setBits2, *cbv3);
 }
 
+UNIT_TEST(CompressedBitVector_IntersectGalloping)
+{
+  vector<uint64_t> setBits1 = {0, 299, 300, 3000, 9999, 20000};
+  vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < 10000; i += 3)
+    setBits2.push_back(i);
+  setBits2.push_back(30000);
+
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv2->GetStorageStrategy(), ());
+
+  auto cbv3 = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv3->GetStorageStrategy(), ());
+  CheckIntersection(setBits1, setBits2, *cbv3);
+
+  auto cbv4 = coding::CompressedBitVector::Intersect(*cbv2, *cbv1);
+  CheckIntersection(setBits1, setBits2, *cbv4);
+}
+
 UNIT_TEST(CompressedBitVector_Subtract1)
 {
   vector<uint64_t> setBits1 = {0, 1, 2, 3, 4, 5, 6};
@@ -190,6 +211,23 @@ UNIT_TEST(CompressedBitVector_Subtract1)
   CheckSubtraction(setBits1, setBits2, *cbv3);
 }
 
+UNIT_TEST(CompressedBitVector_SubtractDenseLonger)
+{
+  vector<uint64_t> setBits1;
+  for (uint64_t i = 0; i < 200; ++i)
+    setBits1.push_back(i);
+  vector<uint64_t> setBits2 = {0, 1, 2, 3, 4, 5, 6, 7};
+
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv2->GetStorageStrategy(), ());
+
+  auto cbv3 = coding::CompressedBitVector::Subtract(*cbv1, *cbv2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv3->GetStorageStrategy(), ());
+  CheckSubtraction(setBits1, setBits2, *cbv3);
+}
+
 UNIT_TEST(CompressedBitVector_Subtract2)
 {
   vector<uint64_t> setBits1;
@@ -14,14 +14,15 @@ using namespace std;
 
 namespace
 {
-  void TestFileSorter(vector<uint32_t> & data, char const * tmpFileName, size_t bufferSize)
+  template <typename T, template <typename LessT1> class SorterT = Sorter>
+  void TestFileSorter(vector<T> & data, char const * tmpFileName, size_t bufferSize)
   {
     vector<char> serial;
     typedef MemWriter<vector<char> > MemWriterType;
     MemWriterType writer(serial);
     typedef WriterFunctor<MemWriterType> OutT;
     OutT out(writer);
-    FileSorter<uint32_t, OutT> sorter(bufferSize, tmpFileName, out);
+    FileSorter<T, OutT, less<T>, SorterT> sorter(bufferSize, tmpFileName, out);
     for (size_t i = 0; i < data.size(); ++i)
       sorter.Add(data[i]);
     sorter.SortAndFinish();
@@ -30,7 +31,7 @@ namespace
     sort(data.begin(), data.end());
     MemReader reader(&serial[0], serial.size());
     TEST_EQUAL(reader.Size(), data.size() * sizeof(data[0]), ());
-    vector<uint32_t> result(data.size());
+    vector<T> result(data.size());
     reader.Read(0, &result[0], reader.Size());
     TEST_EQUAL(result, data, ());
   }
@@ -55,3 +56,29 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(FileSorter_ManyRuns)
+{
+  mt19937 rng(0);
+  vector<uint64_t> data(100000);
+  for (auto & d : data)
+    d = rng() % 1000;
+
+  // 16-item runs, so thousands of runs are merged.
+  TestFileSorter(data, "file_sorter_test_many_runs.tmp", 0 /* bufferSize */);
+  TestFileSorter(data, "file_sorter_test_many_runs.tmp", 8 * 1024 /* bufferSize */);
+}
+
+UNIT_TEST(FileSorter_Radix)
+{
+  mt19937_64 rng(0);
+  vector<uint64_t> data(10000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = rng() >> (i % 64);
+  TestFileSorter<uint64_t, RadixSorter>(data, "file_sorter_test_radix.tmp", 1000);
+
+  vector<uint8_t> bytes = {5, 3, 5, 0, 255, 1};
+  RadixSorter<less<uint8_t>> sorter((less<uint8_t>()));
+  sorter(bytes.begin(), bytes.end());
+  TEST_EQUAL(bytes, vector<uint8_t>({0, 1, 3, 5, 5, 255}), ());
+}
@@ -13,6 +13,7 @@
 #include "geometry/simplification.hpp"
 
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -190,3 +191,62 @@ UNIT_TEST(DecodeEncodePolyline_DataSet1)
 
   TestPolylineEncode("DataSet1", points, GetMaxPoint(), &EncodePolyline, &DecodePolyline);
 }
+
+UNIT_TEST(ReadPolylineDeltas_Benchmark)
+{
+  size_t const count = ARRAY_SIZE(LargePolygon::kLargePolygon);
+  vector<m2::PointU> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(D2U(LargePolygon::kLargePolygon[i]));
+
+  vector<uint64_t> deltas(count);
+  OutDeltasT deltasA(deltas);
+  EncodePolyline(make_read_adapter(points), m2::PointU::Zero(), GetMaxPoint(), deltasA);
+
+  vector<char> data;
+  {
+    MemWriter<vector<char>> writer(data);
+    WriteVarUintArray(deltas, writer);
+  }
+
+  size_t constexpr kIterations = 1000;
+  char const * const pBeg = data.data();
+  char const * const pEnd = data.data() + data.size();
+
+  // Byte-by-byte decoding, the number of varints is given.
+  serial::DeltasT scalar;
+  base::HighResTimer timer;
+  for (size_t i = 0; i < kIterations; ++i)
+  {
+    scalar.clear();
+    ReadVarUint64Array(pBeg, count, base::MakeBackInsertFunctor(scalar));
+  }
+  auto const scalarTime = timer.ElapsedMilliseconds();
+
+  // Batch decoding until the end of the buffer.
+  serial::DeltasT batch;
+  timer.Reset();
+  for (size_t i = 0; i < kIterations; ++i)
+  {
+    batch.clear();
+    ReadVarUint64Array(pBeg, pEnd, base::MakeBackInsertFunctor(batch));
+  }
+  auto const batchTime = timer.ElapsedMilliseconds();
+
+  TEST_EQUAL(vector<uint64_t>(scalar.begin(), scalar.end()), deltas, ());
+  TEST_EQUAL(vector<uint64_t>(batch.begin(), batch.end()), deltas, ());
+
+  vector<m2::PointU> decoded(count);
+  timer.Reset();
+  for (size_t i = 0; i < kIterations; ++i)
+  {
+    OutPointsT decodedA(decoded);
+    DecodePolyline(make_read_adapter(deltas), m2::PointU::Zero(), GetMaxPoint(), decodedA);
+  }
+  auto const predictionTime = timer.ElapsedMilliseconds();
+  TEST_EQUAL(decoded, points, ());
+
+  LOG(LINFO, ("Points:", count, "bytes:", data.size(), "scalar varints, ms:", scalarTime,
+              "batch varints, ms:", batchTime, "points prediction, ms:", predictionTime));
+}
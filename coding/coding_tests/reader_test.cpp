@@ -5,6 +5,7 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/buffer_reader.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader_streambuf.hpp"
 
 #include <cstring>
@@ -39,6 +40,37 @@ UNIT_TEST(FileReaderSmokeTest)
   FileWriter::DeleteFileX("reader_test_tmp.dat");
 }
 
+UNIT_TEST(ReaderPrefetchTest)
+{
+  {
+    FileWriter writer("reader_test_tmp.dat");
+    writer.Write(&kData[0], kData.size());
+  }
+
+  {
+    // Prefetch is only a hint: ranges out of the reader bounds are ignored or cut.
+    FileReader fileReader("reader_test_tmp.dat");
+    fileReader.Prefetch(0, kData.size());
+    fileReader.Prefetch(5, 1000);
+    fileReader.Prefetch(kData.size() + 10, 10);
+    TestReader(fileReader);
+
+    MmapReader mmapReader("reader_test_tmp.dat", MmapReader::Advice::Random);
+    mmapReader.Prefetch(0, kData.size());
+    mmapReader.Prefetch(5, 1000);
+    mmapReader.Prefetch(kData.size() + 10, 10);
+    string text;
+    mmapReader.ReadAsString(text);
+    TEST_EQUAL(text, kData, ());
+
+    auto const subReader = mmapReader.CreateSubReader(3, 10);
+    subReader->Prefetch(2, 100);
+    subReader->ReadAsString(text);
+    TEST_EQUAL(text, kData.substr(3, 10), ());
+  }
+  FileWriter::DeleteFileX("reader_test_tmp.dat");
+}
+
 UNIT_TEST(BufferReaderSmokeTest)
 {
   BufferReader r1(&kData[0], kData.size());
@@ -0,0 +1,35 @@
+#include "testing/testing.hpp"
+
+#include "coding/sha1.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace sha1_test
+{
+using coding::SHA1;
+
+UNIT_TEST(SHA1_Calculator)
+{
+  std::string data;
+  for (size_t i = 0; i < 1000; ++i)
+    data += std::to_string(i);
+
+  auto const expected = SHA1::CalculateForString(data);
+
+  // Parts of different sizes, including empty ones and ones crossing 64-byte blocks.
+  SHA1::Calculator calculator;
+  size_t pos = 0;
+  for (size_t part = 0; pos < data.size(); part = (part * 7 + 3) % 150)
+  {
+    part = std::min(part, data.size() - pos);
+    calculator.Update(data.data() + pos, part);
+    pos += part;
+  }
+  auto const hash = calculator.Final();
+  TEST(hash == expected, ());
+  TEST_EQUAL(SHA1::ToBase64(hash), SHA1::CalculateBase64ForString(data), ());
+
+  TEST(SHA1::Calculator().Final() == SHA1::CalculateForString(""), ());
+}
+}  // namespace sha1_test
@@ -129,4 +129,38 @@ UNIT_TEST(TextStorage_Random)
   for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
 }
+
+UNIT_TEST(TextStorage_ExtractStrings)
+{
+  int const kSeed = 42;
+  int const kNumStrings = 1000;
+  int const kBlockSize = 1000;
+  mt19937 engine(kSeed);
+
+  vector<string> strings;
+  for (int i = 0; i < kNumStrings; ++i)
+    strings.push_back(GenerateRandomString(engine));
+
+  vector<uint8_t> buffer;
+  DumpStrings(strings, kBlockSize, buffer);
+
+  MemReader reader(buffer.data(), buffer.size());
+  BlockedTextStorage<decltype(reader)> ts(reader);
+
+  TEST(ts.ExtractStrings({}).empty(), ());
+
+  uniform_int_distribution<size_t> index(0, strings.size() - 1);
+  for (size_t n : {1, 2, 10, 100})
+  {
+    // Indices are unsorted and may repeat.
+    vector<size_t> ixs(n);
+    for (auto & ix : ixs)
+      ix = index(engine);
+
+    auto const extracted = ts.ExtractStrings(ixs);
+    TEST_EQUAL(extracted.size(), ixs.size(), ());
+    for (size_t i = 0; i < ixs.size(); ++i)
+      TEST_EQUAL(extracted[i], strings[ixs[i]], ());
+  }
+}
 }  // namespace
@@ -143,6 +143,24 @@ UNIT_TEST(Traffic_Serialization_Circle20KmRadius)
   Test(path);
 }
 
+UNIT_TEST(Traffic_Serialization_RegularTrack)
+{
+  // A point each second at a constant speed about 10 m/s.
+  vector<TrafficGPSEncoder::DataPoint> path;
+  for (size_t i = 0; i < 100; ++i)
+    path.emplace_back(1600000000 + i, ms::LatLon(55.0 + i * 1e-4, 37.0 + i * 1e-4), 1);
+  Test(path);
+
+  auto const getSize = [&path](uint32_t version) {
+    vector<uint8_t> buf;
+    MemWriter<decltype(buf)> memWriter(buf);
+    return TrafficGPSEncoder::SerializeDataPoints(version, memWriter, path);
+  };
+  // Deltas of deltas are zero or a unit of rounding, so a point takes a byte for each field.
+  TEST_LESS_OR_EQUAL(getSize(2 /* version */), 4 * path.size() + 32, ());
+  TEST_LESS(2 * getSize(2 /* version */), getSize(1 /* version */), ());
+}
+
 UNIT_TEST(Traffic_Serialization_ExtremeLatLon)
 {
   vector<TrafficGPSEncoder::DataPoint> path = {
@@ -6,6 +6,7 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <limits>
 #include <vector>
 
 using namespace std;
@@ -181,3 +182,35 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+
+UNIT_TEST(ReadVarUint64Array_Batch)
+{
+  // Mix of one-byte runs, which go through the fastest path, medium values and values
+  // which are longer than 8 bytes, with all possible tails after the last full 8-byte word.
+  vector<uint64_t> values;
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    values.push_back(i % 128);
+    if (i % 3 == 0)
+      values.push_back((i + 1) << (i % 64));
+    if (i % 7 == 0)
+      values.push_back(numeric_limits<uint64_t>::max() - i);
+  }
+
+  for (size_t count = 0; count <= values.size(); ++count)
+  {
+    vector<unsigned char> data;
+    {
+      PushBackByteSink<vector<unsigned char>> dst(data);
+      for (size_t i = 0; i < count; ++i)
+        WriteVarUint(dst, values[i]);
+    }
+
+    void const * pDataEnd = data.data() + data.size();
+    vector<uint64_t> result;
+    void const * pEnd = ReadVarUint64Array(data.data(), pDataEnd, base::MakeBackInsertFunctor(result));
+
+    TEST_EQUAL(pEnd, pDataEnd, (count));
+    TEST_EQUAL(result, vector<uint64_t>(values.begin(), values.begin() + count), ());
+  }
+}
@@ -13,6 +13,50 @@ using std::make_unique, std::max, std::min, std::unique_ptr, std::vector;
 
 namespace
 {
+// When one of the sorted lists is so many times longer than the other, the elements of the
+// shorter list are looked up in the longer one by galloping instead of the linear merge.
+size_t constexpr kGallopingRatio = 32;
+
+// Returns the first position in [it, end) which is not less than |value|. The range is
+// probed at exponentially growing distances and then the found interval is searched binary,
+// so close elements are found in a few steps.
+template <typename It>
+It Gallop(It it, It end, uint64_t value)
+{
+  size_t step = 1;
+  auto lo = it;
+  while (it < end && *it < value)
+  {
+    lo = it + 1;
+    it = static_cast<size_t>(end - it) > step ? it + step : end;
+    step *= 2;
+  }
+  return std::lower_bound(lo, it, value);
+}
+
+template <typename It, typename Out>
+void GallopingIntersection(It shortBegin, It shortEnd, It longBegin, It longEnd, Out out)
+{
+  for (; shortBegin != shortEnd && longBegin != longEnd; ++shortBegin)
+  {
+    longBegin = Gallop(longBegin, longEnd, *shortBegin);
+    if (longBegin != longEnd && *longBegin == *shortBegin)
+    {
+      *out++ = *shortBegin;
+      ++longBegin;
+    }
+  }
+}
+
+// Group-wise binary operation over the first |size| groups of |a| and |b|. The loop works
+// with plain arrays, so the compiler vectorizes it.
+template <typename Op>
+void ApplyToGroups(uint64_t const * a, uint64_t const * b, size_t size, uint64_t * res, Op op)
+{
+  for (size_t i = 0; i < size; ++i)
+    res[i] = op(a[i], b[i]);
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -23,8 +67,8 @@ struct IntersectOp
     size_t const sizeA = a.NumBitGroups();
     size_t const sizeB = b.NumBitGroups();
     vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    ApplyToGroups(a.GetBitGroups().data(), b.GetBitGroups().data(), resGroups.size(),
+                  resGroups.data(), [](uint64_t x, uint64_t y) { return x & y; });
     return coding::CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -33,12 +77,7 @@ struct IntersectOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
-    {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
-        resPos.push_back(pos);
-    }
+    copy_if(b.Begin(), b.End(), back_inserter(resPos), [&a](uint64_t pos) { return a.GetBit(pos); });
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
 
@@ -52,7 +91,14 @@ struct IntersectOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    auto const sizeA = a.PopCount();
+    auto const sizeB = b.PopCount();
+    if (sizeA * kGallopingRatio < sizeB)
+      GallopingIntersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    else if (sizeB * kGallopingRatio < sizeA)
+      GallopingIntersection(b.Begin(), b.End(), a.Begin(), a.End(), back_inserter(resPos));
+    else
+      set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
 };
@@ -66,9 +112,12 @@ struct SubtractOp
   {
     size_t const sizeA = a.NumBitGroups();
     size_t const sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    vector<uint64_t> resGroups(sizeA);
+    size_t const commonSize = min(sizeA, sizeB);
+    ApplyToGroups(a.GetBitGroups().data(), b.GetBitGroups().data(), commonSize, resGroups.data(),
+                  [](uint64_t x, uint64_t y) { return x & ~y; });
+    copy(a.GetBitGroups().begin() + commonSize, a.GetBitGroups().end(),
+         resGroups.begin() + commonSize);
     return CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -133,8 +182,8 @@ struct UnionOp
     size_t commonSize = min(sizeA, sizeB);
     size_t resultSize = max(sizeA, sizeB);
     vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
+    ApplyToGroups(a.GetBitGroups().data(), b.GetBitGroups().data(), commonSize, resGroups.data(),
+                  [](uint64_t x, uint64_t y) { return x | y; });
     if (a.NumBitGroups() == resultSize)
     {
       for (size_t i = commonSize; i < resultSize; ++i)
@@ -451,15 +500,13 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     return DenseCBV::BuildFromBitGroups(std::move(bitGroups));
 
   vector<uint64_t> setBits;
+  setBits.reserve(static_cast<size_t>(popCount));
   for (size_t i = 0; i < bitGroups.size(); ++i)
   {
-    for (size_t j = 0; j < kBlockSize; ++j)
-    {
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
-    }
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + bits::NumLoZeroBits64(group));
   }
-  return make_unique<SparseCBV>(setBits);
+  return make_unique<SparseCBV>(std::move(setBits));
 }
 
 std::string DebugPrint(CompressedBitVector::StorageStrategy strat)
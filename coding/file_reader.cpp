@@ -5,6 +5,8 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -50,6 +52,8 @@ public:
     return m_readerCache.Read(m_fileData, pos, p, size);
   }
 
+  void Prefetch(uint64_t pos, uint64_t size) const { m_fileData.Prefetch(pos, size); }
+
 private:
   class FileDataWithCachedSize : public base::FileData
   {
@@ -105,6 +109,13 @@ void FileReader::Read(uint64_t pos, void * p, size_t size) const
   m_fileData->Read(m_offset + pos, p, size);
 }
 
+void FileReader::Prefetch(uint64_t pos, uint64_t size) const
+{
+  if (pos >= Size())
+    return;
+  m_fileData->Prefetch(m_offset + pos, std::min(size, Size() - pos));
+}
+
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
 {
   CheckPosAndSize(pos, size);
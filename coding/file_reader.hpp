@@ -25,6 +25,7 @@ public:
   uint64_t Size() const override { return m_size; }
   void Read(uint64_t pos, void * p, size_t size) const override;
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  void Prefetch(uint64_t pos, uint64_t size) const override;
 
   FileReader SubReader(uint64_t pos, uint64_t size) const;
   uint64_t GetOffset() const { return m_offset; }
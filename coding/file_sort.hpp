@@ -8,12 +8,17 @@
 #include "base/exception.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
-#include <queue>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -28,6 +33,60 @@ struct Sorter
   }
 };
 
+// LSD radix sort by bytes for unsigned integer items ordered by std::less. It's linear in the
+// number of items, so buffers of integer keys are sorted several times faster than by std::sort.
+template <typename LessT>
+struct RadixSorter
+{
+  RadixSorter(LessT) {}
+  template <typename IterT> void operator() (IterT beg, IterT end) const
+  {
+    using T = typename std::iterator_traits<IterT>::value_type;
+    static_assert(std::is_unsigned<T>::value, "Radix sort is implemented for unsigned integers.");
+    static_assert(std::is_same<LessT, std::less<T>>::value, "Radix sort orders by std::less only.");
+
+    size_t const n = std::distance(beg, end);
+    if (n < 2)
+      return;
+
+    size_t constexpr kDigits = sizeof(T);
+    std::vector<std::array<size_t, 256>> offsets(kDigits);
+    for (auto it = beg; it != end; ++it)
+    {
+      for (size_t d = 0; d < kDigits; ++d)
+        ++offsets[d][(*it >> (8 * d)) & 0xFF];
+    }
+
+    std::vector<T> src(beg, end);
+    std::vector<T> dst(n);
+    for (size_t d = 0; d < kDigits; ++d)
+    {
+      auto & digitOffsets = offsets[d];
+      size_t const shift = 8 * d;
+
+      // All items have the same digit.
+      if (digitOffsets[(src.front() >> shift) & 0xFF] == n)
+        continue;
+
+      size_t sum = 0;
+      for (auto & offset : digitOffsets)
+      {
+        size_t const count = offset;
+        offset = sum;
+        sum += count;
+      }
+
+      for (T const & item : src)
+        dst[digitOffsets[(item >> shift) & 0xFF]++] = item;
+      src.swap(dst);
+    }
+    std::copy(src.begin(), src.end(), beg);
+  }
+};
+
+// External merge sort. Items are collected into a buffer which is sorted and appended to
+// a temporary file as a run in the background while the next buffer is filled. Runs are
+// merged by a loser tree, each run is read by big chunks.
 template <typename T,                                        // Item type.
           class OutputSinkT = FileWriter,                    // Sink to output into result file.
           typename LessT = std::less<T>,                     // Item comparator.
@@ -36,12 +95,12 @@ template <typename T,                                        // Item type.
 class FileSorter
 {
 public:
+  // |bufferBytes| is split between the buffer being filled and the buffer being sorted.
   FileSorter(size_t bufferBytes, std::string const & tmpFileName, OutputSinkT & outputSink,
              LessT fLess = LessT())
     : m_TmpFileName(tmpFileName)
-    , m_BufferCapacity(std::max(size_t(16), bufferBytes / sizeof(T)))
+    , m_BufferCapacity(std::max(size_t(16), bufferBytes / sizeof(T) / 2))
     , m_OutputSink(outputSink)
-    , m_ItemCount(0)
     , m_Less(fLess)
   {
     m_Buffer.reserve(m_BufferCapacity);
@@ -53,31 +112,19 @@ public:
     if (m_Buffer.size() == m_BufferCapacity)
       FlushToTmpFile();
     m_Buffer.push_back(item);
-    ++m_ItemCount;
   }
 
   void SortAndFinish()
   {
     ASSERT(m_pTmpWriter.get(), ());
     FlushToTmpFile();
+    WaitForFlush();
 
     // Write output.
     {
       m_pTmpWriter.reset();
       FileReader reader(m_TmpFileName);
-      ItemIndexPairGreater fGreater(m_Less);
-      PriorityQueue q(fGreater);
-      for (uint32_t i = 0; i < m_ItemCount; i += m_BufferCapacity)
-        Push(q, i, reader);
-
-      while (!q.empty())
-      {
-        m_OutputSink(q.top().first);
-        uint32_t const i = q.top().second + 1;
-        q.pop();
-        if (i % m_BufferCapacity != 0 && i < m_ItemCount)
-          Push(q, i, reader);
-      }
+      Merge(reader);
     }
     FileWriter::DeleteFileX(m_TmpFileName);
   }
@@ -102,35 +149,123 @@ public:
   }
 
 private:
-  struct ItemIndexPairGreater
+  // A run of the temporary file with a chunk of it in memory.
+  struct Run
   {
-    explicit ItemIndexPairGreater(LessT fLess) : m_Less(fLess) {}
-    inline bool operator()(std::pair<T, uint32_t> const & a, std::pair<T, uint32_t> const & b) const
+    bool IsEmpty() const { return m_Current == m_Items.size(); }
+    T const & Top() const { return m_Items[m_Current]; }
+
+    void ReadChunk(FileReader const & reader, size_t chunkSize)
     {
-      return m_Less(b.first, a.first);
+      auto const count = static_cast<size_t>(std::min<uint64_t>(chunkSize, m_End - m_Pos));
+      m_Items.resize(count);
+      m_Current = 0;
+      if (count != 0)
+        reader.Read(m_Pos * sizeof(T), m_Items.data(), count * sizeof(T));
+      m_Pos += count;
     }
-    LessT m_Less;
-  };
 
-  using PriorityQueue =
-      std::priority_queue<std::pair<T, uint32_t>, std::vector<std::pair<T, uint32_t>>,
-                          ItemIndexPairGreater>;
+    void Pop(FileReader const & reader, size_t chunkSize)
+    {
+      if (++m_Current == m_Items.size())
+        ReadChunk(reader, chunkSize);
+    }
+
+    // Positions in items.
+    uint64_t m_Pos = 0;
+    uint64_t m_End = 0;
+    std::vector<T> m_Items;
+    size_t m_Current = 0;
+  };
 
   void FlushToTmpFile()
   {
     if (m_Buffer.empty())
       return;
-    SorterT<LessT> sorter(m_Less);
-    sorter(m_Buffer.begin(), m_Buffer.end());
-    m_pTmpWriter->Write(&m_Buffer[0], m_Buffer.size() * sizeof(T));
-    m_Buffer.clear();
+
+    WaitForFlush();
+    m_RunSizes.push_back(m_Buffer.size());
+    m_FlushBuffer.swap(m_Buffer);
+    m_Buffer.reserve(m_BufferCapacity);
+
+    m_Flush = std::async(std::launch::async, [this]() {
+      SorterT<LessT> sorter(m_Less);
+      sorter(m_FlushBuffer.begin(), m_FlushBuffer.end());
+      m_pTmpWriter->Write(m_FlushBuffer.data(), m_FlushBuffer.size() * sizeof(T));
+      m_FlushBuffer.clear();
+    });
+  }
+
+  // Rethrows an exception of the background flush.
+  void WaitForFlush()
+  {
+    if (m_Flush.valid())
+      m_Flush.get();
+  }
+
+  template <typename Less>
+  static size_t BuildLoserTree(size_t node, std::vector<size_t> & tree, Less const & less)
+  {
+    size_t const k = tree.size();
+    if (node >= k)
+      return node - k;
+
+    size_t const left = BuildLoserTree(2 * node, tree, less);
+    size_t const right = BuildLoserTree(2 * node + 1, tree, less);
+    if (less(right, left))
+    {
+      tree[node] = left;
+      return right;
+    }
+    tree[node] = right;
+    return left;
   }
 
-  void Push(PriorityQueue & q, uint32_t i, FileReader const & reader)
+  void Merge(FileReader const & reader)
   {
-    T item;
-    reader.Read(static_cast<uint64_t>(i) * sizeof(T), &item, sizeof(T));
-    q.push(std::pair<T, uint32_t>(item, i));
+    size_t const k = m_RunSizes.size();
+    if (k == 0)
+      return;
+
+    // Both buffers are given to the chunks of runs.
+    size_t const chunkSize = std::max(size_t(1), 2 * m_BufferCapacity / k);
+    std::vector<Run> runs(k);
+    uint64_t pos = 0;
+    for (size_t i = 0; i < k; ++i)
+    {
+      runs[i].m_Pos = pos;
+      pos += m_RunSizes[i];
+      runs[i].m_End = pos;
+      runs[i].ReadChunk(reader, chunkSize);
+    }
+
+    // Empty runs lose to all others.
+    auto const less = [&runs, this](size_t lhs, size_t rhs) {
+      if (runs[lhs].IsEmpty())
+        return false;
+      if (runs[rhs].IsEmpty())
+        return true;
+      return m_Less(runs[lhs].Top(), runs[rhs].Top());
+    };
+
+    // Leaves are k, ..., 2k - 1, internal nodes 1, ..., k - 1 keep the losers of their matches
+    // and tree[0] keeps the winner.
+    std::vector<size_t> tree(k);
+    tree[0] = BuildLoserTree(1, tree, less);
+
+    while (!runs[tree[0]].IsEmpty())
+    {
+      size_t winner = tree[0];
+      m_OutputSink(runs[winner].Top());
+      runs[winner].Pop(reader, chunkSize);
+
+      for (size_t node = (winner + k) / 2; node > 0; node /= 2)
+      {
+        if (less(tree[node], winner))
+          std::swap(tree[node], winner);
+      }
+      tree[0] = winner;
+    }
   }
 
   std::string const m_TmpFileName;
@@ -138,6 +273,9 @@ private:
   OutputSinkT & m_OutputSink;
   std::unique_ptr<FileWriter> m_pTmpWriter;
   std::vector<T> m_Buffer;
-  uint32_t m_ItemCount;
+  // The buffer which is sorted and written by |m_Flush|.
+  std::vector<T> m_FlushBuffer;
+  std::future<void> m_Flush;
+  std::vector<uint64_t> m_RunSizes;
   LessT m_Less;
 };
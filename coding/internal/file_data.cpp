@@ -21,6 +21,7 @@
 #ifdef OMIM_OS_WINDOWS
 #include <io.h>
 #else
+#include <fcntl.h>   // posix_fadvise
 #include <unistd.h>  // ftruncate
 #endif
 
@@ -114,6 +115,19 @@ void FileData::Read(uint64_t pos, void * p, size_t size)
     MYTHROW(Reader::ReadException, (GetErrorProlog(), bytesRead, pos, size));
 }
 
+void FileData::Prefetch(uint64_t pos, uint64_t size) const
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  int const err = posix_fadvise(fileno(m_File), static_cast<off_t>(pos), static_cast<off_t>(size),
+                                POSIX_FADV_WILLNEED);
+  if (err != 0)
+    LOG(LWARNING, ("posix_fadvise error:", strerror(err), m_FileName));
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 uint64_t FileData::Pos() const
 {
   int64_t const pos = ftell64(m_File);
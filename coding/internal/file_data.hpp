@@ -29,6 +29,8 @@ public:
   void Seek(uint64_t pos);
 
   void Read(uint64_t pos, void * p, size_t size);
+  // Asks OS to read [pos, pos + size) to the page cache in background, where it's supported.
+  void Prefetch(uint64_t pos, uint64_t size) const;
   void Write(void const * p, size_t size);
 
   void Flush();
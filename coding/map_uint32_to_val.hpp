@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -140,6 +141,31 @@ public:
   }
   /// @}
 
+  /// Calls |fn(id, value)| for the |ids| which have values, |ids| must be sorted.
+  /// Every needed block is decoded once and the cache of Get() isn't touched.
+  template <typename Fn>
+  void ForEachOf(std::vector<uint32_t> const & ids, Fn && fn) const
+  {
+    ASSERT(std::is_sorted(ids.begin(), ids.end()), ());
+
+    std::vector<Value> block;
+    uint32_t blockBase = std::numeric_limits<uint32_t>::max();
+    for (auto const id : ids)
+    {
+      if (id >= m_ids.size() || !m_ids[id])
+        continue;
+
+      uint32_t const rank = static_cast<uint32_t>(m_ids.rank(id));
+      uint32_t const base = rank / m_header.m_blockSize;
+      if (base != blockBase)
+      {
+        block = GetImpl(rank, m_header.m_blockSize);
+        blockBase = base;
+      }
+      fn(id, block[rank % m_header.m_blockSize]);
+    }
+  }
+
   // Loads MapUint32ToValue instance. Note that |reader| must be alive
   // until the destruction of loaded table. Returns nullptr if
   // MapUint32ToValue can't be loaded.
@@ -176,7 +202,13 @@ private:
     auto const start = m_offsets.select(base);
     auto const end = base + 1 < m_offsets.num_ones() ? m_offsets.select(base + 1) + m_header.m_variablesOffset
                                                      : m_header.m_endOffset;
-    NonOwningReaderSource src(m_reader, m_header.m_variablesOffset + start, end);
+
+    // Blocks are small, so the whole block is read at once and the values are decoded from memory
+    // instead of reading |m_reader| byte by byte, which is costly for file readers.
+    std::vector<uint8_t> data(end - m_header.m_variablesOffset - start);
+    m_reader.Read(m_header.m_variablesOffset + start, data.data(), data.size());
+    MemReader memReader(data.data(), data.size());
+    NonOwningReaderSource src(memReader);
 
     // Important! Client should read while src.Size() > 0 and max |upperSize| number of elements.
     std::vector<Value> values;
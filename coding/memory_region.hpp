@@ -1,6 +1,7 @@
 #pragma once
 
 #include "coding/files_container.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/macros.hpp"
 
@@ -50,3 +51,23 @@ private:
 
   DISALLOW_COPY(CopiedMemoryRegion);
 };
+
+// Memory of a memory mapped reader (see MmapReader). The region keeps the mapping alive.
+class MmapReaderMemoryRegion : public MemoryRegion
+{
+public:
+  explicit MmapReaderMemoryRegion(ModelReaderPtr const & reader)
+    : m_reader(reader), m_data(dynamic_cast<MmapReader const &>(*m_reader.GetPtr()).Data())
+  {
+  }
+
+  // MemoryRegion overrides:
+  uint64_t Size() const override { return m_reader.Size(); }
+  uint8_t const * ImmutableData() const override { return m_data; }
+
+private:
+  ModelReaderPtr m_reader;
+  uint8_t const * m_data;
+
+  DISALLOW_COPY(MmapReaderMemoryRegion);
+};
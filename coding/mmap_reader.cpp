@@ -4,6 +4,7 @@
 
 #include "std/target_os.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 #ifdef OMIM_OS_WINDOWS
@@ -136,9 +137,31 @@ std::unique_ptr<Reader> MmapReader::CreateSubReader(uint64_t pos, uint64_t size)
   return std::unique_ptr<Reader>(new MmapReader(*this, m_offset + pos, size));
 }
 
+void MmapReader::Prefetch(uint64_t pos, uint64_t size) const
+{
+#ifndef OMIM_OS_WINDOWS
+  if (pos >= Size())
+    return;
+  size = std::min(size, Size() - pos);
+
+  // madvise needs a page-aligned address.
+  static uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t const beg = m_offset + pos;
+  uint64_t const alignedBeg = beg - beg % pageSize;
+  if (madvise(m_data->m_memory + alignedBeg, static_cast<size_t>(beg + size - alignedBeg),
+              MADV_WILLNEED) != 0)
+  {
+    LOG(LWARNING, ("madvise error:", strerror(errno)));
+  }
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 uint8_t * MmapReader::Data() const
 {
-  return m_data->m_memory;
+  return m_data->m_memory + m_offset;
 }
 
 void MmapReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
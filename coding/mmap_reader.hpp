@@ -23,8 +23,11 @@ public:
   uint64_t Size() const override;
   void Read(uint64_t pos, void * p, size_t size) const override;
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  // Asks OS to read the pages in advance (MADV_WILLNEED), it's useful with Advice::Random
+  // which turns off the read-ahead of OS.
+  void Prefetch(uint64_t pos, uint64_t size) const override;
 
-  /// Direct file/memory access
+  /// Direct file/memory access, points to the beginning of this (sub)reader.
   uint8_t * Data() const;
 
 protected:
@@ -28,6 +28,10 @@ public:
   virtual void Read(uint64_t pos, void * p, size_t size) const = 0;
   virtual std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const = 0;
 
+  // Hints that [pos, pos + size) will be read soon. Readers of files start reading it
+  // in background, the call doesn't block. Does nothing by default.
+  virtual void Prefetch(uint64_t /* pos */, uint64_t /* size */) const {}
+
   void ReadAsString(std::string & s) const;
 };
 
@@ -121,6 +125,8 @@ public:
 
   void ReadAsString(std::string & s) const { m_p->ReadAsString(s); }
 
+  void Prefetch(uint64_t pos, uint64_t size) const { m_p->Prefetch(pos, size); }
+
   ReaderPtr<Reader> SubReader(uint64_t pos, uint64_t size) const
   {
     return {m_p->CreateSubReader(pos, size)};
@@ -15,6 +15,39 @@
 
 namespace coding
 {
+namespace
+{
+SHA1::Hash ExtractHash(CSHA1 const & sha1)
+{
+  SHA1::Hash result;
+  ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
+  std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
+  return result;
+}
+}  // namespace
+
+SHA1::Calculator::Calculator() : m_sha1(std::make_unique<CSHA1>()) {}
+
+SHA1::Calculator::~Calculator() = default;
+
+void SHA1::Calculator::Update(void const * data, size_t size)
+{
+  auto bytes = static_cast<unsigned char *>(const_cast<void *>(data));
+  while (size > 0)
+  {
+    auto const part = static_cast<uint32_t>(std::min<size_t>(size, UINT32_MAX));
+    m_sha1->Update(bytes, part);
+    bytes += part;
+    size -= part;
+  }
+}
+
+SHA1::Hash SHA1::Calculator::Final()
+{
+  m_sha1->Final();
+  return ExtractHash(*m_sha1);
+}
+
 // static
 SHA1::Hash SHA1::Calculate(std::string const & filePath)
 {
@@ -35,11 +68,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
       currSize += toRead;
     }
     sha1.Final();
-
-    Hash result;
-    ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-    std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-    return result;
+    return ExtractHash(sha1);
   }
   catch (Reader::Exception const & ex)
   {
@@ -51,8 +80,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
 // static
 std::string SHA1::CalculateBase64(std::string const & filePath)
 {
-  auto const sha1 = Calculate(filePath);
-  return base64_encode(sha1.data(), sha1.size());
+  return ToBase64(Calculate(filePath));
 }
 
 // static
@@ -62,11 +90,7 @@ SHA1::Hash SHA1::CalculateForString(std::string const & str)
   std::vector<unsigned char> dat(str.begin(), str.end());
   sha1.Update(dat.data(), static_cast<uint32_t>(dat.size()));
   sha1.Final();
-
-  Hash result;
-  ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-  std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-  return result;
+  return ExtractHash(sha1);
 }
 
 // static
@@ -84,7 +108,12 @@ std::string SHA1::CalculateForStringFormatted(std::string const & str)
 // static
 std::string SHA1::CalculateBase64ForString(std::string const & str)
 {
-  auto const sha1 = CalculateForString(str);
-  return base64_encode(sha1.data(), sha1.size());
+  return ToBase64(CalculateForString(str));
+}
+
+// static
+std::string SHA1::ToBase64(Hash const & hash)
+{
+  return base64_encode(hash.data(), hash.size());
 }
 }  // coding
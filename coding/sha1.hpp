@@ -2,8 +2,11 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
 
+class CSHA1;
+
 namespace coding
 {
 class SHA1
@@ -12,6 +15,21 @@ public:
   static size_t constexpr kHashSizeInBytes = 20;
   using Hash = std::array<uint8_t, kHashSizeInBytes>;
 
+  // Calculates the hash of data which comes by parts.
+  class Calculator
+  {
+  public:
+    Calculator();
+    ~Calculator();
+
+    void Update(void const * data, size_t size);
+    // The calculator can't be updated after this call.
+    Hash Final();
+
+  private:
+    std::unique_ptr<CSHA1> m_sha1;
+  };
+
   static Hash Calculate(std::string const & filePath);
   static std::string CalculateBase64(std::string const & filePath);
 
@@ -19,5 +37,7 @@ public:
   // String representation of 40-number hex digit.
   static std::string CalculateForStringFormatted(std::string const & str);
   static std::string CalculateBase64ForString(std::string const & str);
+
+  static std::string ToBase64(Hash const & hash);
 };
 }  // coding
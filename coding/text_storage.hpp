@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -240,7 +241,59 @@ public:
 
     auto const blockIx = m_index.GetBlockIx(stringIx);
     CHECK_LESS(blockIx, m_index.GetNumBlockInfos(), ());
+    return GetString(GetBlock(reader, blockIx), m_index.GetBlockInfo(blockIx), stringIx);
+  }
+
+  // Returns strings with |stringIxs| in the same order. Strings are extracted in the order of
+  // blocks, so each block is looked up in the cache and decoded at most once.
+  template <typename Reader>
+  std::vector<std::string> ExtractStrings(Reader & reader, std::vector<size_t> const & stringIxs)
+  {
+    InitializeIfNeeded(reader);
+
+    std::vector<size_t> order(stringIxs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&stringIxs](size_t lhs, size_t rhs) { return stringIxs[lhs] < stringIxs[rhs]; });
+
+    std::vector<std::string> result(stringIxs.size());
+    BlockedTextStorageIndex::BlockInfo const * bi = nullptr;
+    CacheEntry const * entry = nullptr;
+    for (auto const i : order)
+    {
+      auto const stringIx = stringIxs[i];
+      if (bi == nullptr || stringIx >= bi->To())
+      {
+        auto const blockIx = m_index.GetBlockIx(stringIx);
+        CHECK_LESS(blockIx, m_index.GetNumBlockInfos(), ());
+        bi = &m_index.GetBlockInfo(blockIx);
+        entry = &GetBlock(reader, blockIx);
+      }
+      result[i] = GetString(*entry, *bi, stringIx);
+    }
+    return result;
+  }
+
+private:
+  struct StringInfo
+  {
+    StringInfo() = default;
+    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
+
+    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
+    uint64_t m_length = 0;  // length of the string
+  };
+
+  struct CacheEntry
+  {
+    BWTCoder::BufferT m_value;        // concatenation of the strings
+    std::vector<StringInfo> m_subs;   // indices of individual strings
+  };
 
+  // Returns the decoded block. The reference is valid until the next call.
+  template <typename Reader>
+  CacheEntry & GetBlock(Reader & reader, size_t blockIx)
+  {
     auto const & bi = m_index.GetBlockInfo(blockIx);
 
     bool found;
@@ -264,7 +317,12 @@ public:
       }
       entry.m_value = BWTCoder::ReadAndDecodeBlock(source);
     }
+    return entry;
+  }
 
+  static std::string GetString(CacheEntry const & entry,
+                               BlockedTextStorageIndex::BlockInfo const & bi, size_t stringIx)
+  {
     ASSERT_GREATER_OR_EQUAL(stringIx, bi.From(), ());
     ASSERT_LESS(stringIx, bi.To(), ());
 
@@ -278,22 +336,6 @@ public:
     return std::string(beg, beg + si.m_length);
   }
 
-private:
-  struct StringInfo
-  {
-    StringInfo() = default;
-    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
-
-    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
-    uint64_t m_length = 0;  // length of the string
-  };
-
-  struct CacheEntry
-  {
-    BWTCoder::BufferT m_value;        // concatenation of the strings
-    std::vector<StringInfo> m_subs;   // indices of individual strings
-  };
-
   BlockedTextStorageIndex m_index;
   LruCache<size_t, CacheEntry> m_cache;
   bool m_initialized = false;
@@ -310,6 +352,10 @@ public:
 
   size_t GetNumStrings() const { return m_storage.GetNumStrings(); }
   std::string ExtractString(size_t stringIx) { return m_storage.ExtractString(m_reader, stringIx); }
+  std::vector<std::string> ExtractStrings(std::vector<size_t> const & stringIxs)
+  {
+    return m_storage.ExtractStrings(m_reader, stringIxs);
+  }
 
 private:
   BlockedTextStorageReader m_storage;
@@ -5,7 +5,7 @@
 namespace coding
 {
 // static
-uint32_t const TrafficGPSEncoder::kLatestVersion = 1;
+uint32_t const TrafficGPSEncoder::kLatestVersion = 2;
 uint32_t const TrafficGPSEncoder::kCoordBits = 30;
 double const TrafficGPSEncoder::kMinDeltaLat = ms::LatLon::kMinLat - ms::LatLon::kMaxLat;
 double const TrafficGPSEncoder::kMaxDeltaLat = ms::LatLon::kMaxLat - ms::LatLon::kMinLat;
@@ -7,8 +7,11 @@
 
 #include "geometry/latlon.hpp"
 
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <string>
 
@@ -53,6 +56,12 @@ public:
   // Version 0:
   //   Coordinates are truncated and stored as integers. All integers
   //   are written as varints.
+  // Version 1:
+  //   Same as version 0 with the traffic speed group of each point.
+  // Version 2:
+  //   Timestamps and truncated coordinates are stored as deltas of deltas, so points which
+  //   are recorded with a constant period and speed take a few bytes. Signed integers
+  //   are written as zigzag varints.
   template <typename Writer, typename Collection>
   static size_t SerializeDataPoints(uint32_t version, Writer & writer, Collection const & points)
   {
@@ -60,6 +69,7 @@ public:
     {
     case 0: return SerializeDataPointsV0(writer, points);
     case 1: return SerializeDataPointsV1(writer, points);
+    case 2: return SerializeDataPointsV2(writer, points);
 
     default: ASSERT(false, ("Unexpected serializer version:", version)); break;
     }
@@ -74,6 +84,7 @@ public:
     {
     case 0: return DeserializeDataPointsV0(src, result);
     case 1: return DeserializeDataPointsV1(src, result);
+    case 2: return DeserializeDataPointsV2(src, result);
 
     default: ASSERT(false, ("Unexpected serializer version:", version)); break;
     }
@@ -158,6 +169,58 @@ private:
     return static_cast<size_t>(writer.Pos() - startPos);
   }
 
+  template <typename Writer, typename Collection>
+  static size_t SerializeDataPointsV2(Writer & writer, Collection const & points)
+  {
+    auto const startPos = writer.Pos();
+
+    int64_t prevTimestamp = 0;
+    int64_t prevLat = 0;
+    int64_t prevLon = 0;
+    int64_t prevDeltaTimestamp = 0;
+    int64_t prevDeltaLat = 0;
+    int64_t prevDeltaLon = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      auto const timestamp = base::asserted_cast<int64_t>(points[i].m_timestamp);
+      int64_t const lat = DoubleToUint32(points[i].m_latLon.m_lat, ms::LatLon::kMinLat,
+                                         ms::LatLon::kMaxLat, kCoordBits);
+      int64_t const lon = DoubleToUint32(points[i].m_latLon.m_lon, ms::LatLon::kMinLon,
+                                         ms::LatLon::kMaxLon, kCoordBits);
+      uint32_t const traffic = points[i].m_traffic;
+
+      if (i == 0)
+      {
+        WriteVarUint(writer, points[i].m_timestamp);
+        WriteVarUint(writer, static_cast<uint32_t>(lat));
+        WriteVarUint(writer, static_cast<uint32_t>(lon));
+      }
+      else
+      {
+        ASSERT_LESS_OR_EQUAL(prevTimestamp, timestamp, ());
+
+        int64_t const deltaTimestamp = timestamp - prevTimestamp;
+        int64_t const deltaLat = lat - prevLat;
+        int64_t const deltaLon = lon - prevLon;
+        WriteVarInt(writer, deltaTimestamp - prevDeltaTimestamp);
+        WriteVarInt(writer, deltaLat - prevDeltaLat);
+        WriteVarInt(writer, deltaLon - prevDeltaLon);
+        prevDeltaTimestamp = deltaTimestamp;
+        prevDeltaLat = deltaLat;
+        prevDeltaLon = deltaLon;
+      }
+      WriteVarUint(writer, traffic);
+
+      prevTimestamp = timestamp;
+      prevLat = lat;
+      prevLon = lon;
+    }
+
+    ASSERT_LESS_OR_EQUAL(writer.Pos() - startPos, std::numeric_limits<size_t>::max(),
+                         ("Too much data."));
+    return static_cast<size_t>(writer.Pos() - startPos);
+  }
+
   template <typename Source, typename Collection>
   static void DeserializeDataPointsV0(Source & src, Collection & result)
   {
@@ -225,5 +288,50 @@ private:
       }
     }
   }
+  template <typename Source, typename Collection>
+  static void DeserializeDataPointsV2(Source & src, Collection & result)
+  {
+    // Unsigned integers are used to accumulate the deltas, so they wrap around on the data of
+    // a corrupted packet instead of overflowing.
+    bool first = true;
+    uint64_t timestamp = 0;
+    uint64_t lat = 0;
+    uint64_t lon = 0;
+    uint64_t deltaTimestamp = 0;
+    uint64_t deltaLat = 0;
+    uint64_t deltaLon = 0;
+
+    // Coordinates of a corrupted packet may be out of range, they're clamped then.
+    auto const toCoord = [](uint64_t value, double min, double max) {
+      auto const maxValue = static_cast<int64_t>(bits::GetFullMask(kCoordBits));
+      auto const clamped = std::clamp(static_cast<int64_t>(value), int64_t{0}, maxValue);
+      return Uint32ToDouble(static_cast<uint32_t>(clamped), min, max, kCoordBits);
+    };
+
+    while (src.Size() > 0)
+    {
+      if (first)
+      {
+        timestamp = ReadVarUint<uint64_t>(src);
+        lat = ReadVarUint<uint32_t>(src);
+        lon = ReadVarUint<uint32_t>(src);
+        first = false;
+      }
+      else
+      {
+        deltaTimestamp += static_cast<uint64_t>(ReadVarInt<int64_t>(src));
+        deltaLat += static_cast<uint64_t>(ReadVarInt<int64_t>(src));
+        deltaLon += static_cast<uint64_t>(ReadVarInt<int64_t>(src));
+        timestamp += deltaTimestamp;
+        lat += deltaLat;
+        lon += deltaLon;
+      }
+      auto const traffic = base::asserted_cast<uint8_t>(ReadVarUint<uint32_t>(src));
+      result.emplace_back(timestamp,
+                          ms::LatLon(toCoord(lat, ms::LatLon::kMinLat, ms::LatLon::kMaxLat),
+                                     toCoord(lon, ms::LatLon::kMinLon, ms::LatLon::kMaxLon)),
+                          traffic);
+    }
+  }
 };
 }  // namespace coding
@@ -37,6 +37,11 @@ public:
     }
   }
 
+  ReaderT const & GetReader() const { return m_reader; }
+
+  // Hints the reader that the records in [pos, pos + size) will be read soon.
+  void Prefetch(uint64_t pos, uint64_t size) const { m_reader.Prefetch(pos, size); }
+
 private:
   ReaderT m_reader;
 };
@@ -29,7 +29,8 @@ bool BindingDecl::operator==(BindingDecl const & other) const
          m_componentCount == other.m_componentCount &&
          m_componentType == other.m_componentType &&
          m_stride == other.m_stride &&
-         m_offset == other.m_offset;
+         m_offset == other.m_offset &&
+         m_normalized == other.m_normalized;
 }
 
 bool BindingDecl::operator!=(BindingDecl const & other) const
@@ -47,7 +48,9 @@ bool BindingDecl::operator<(BindingDecl const & other) const
     return m_componentType < other.m_componentType;
   if (m_stride != other.m_stride)
     return m_stride < other.m_stride;
-  return m_offset < other.m_offset;
+  if (m_offset != other.m_offset)
+    return m_offset < other.m_offset;
+  return m_normalized < other.m_normalized;
 }
 
 BindingInfo::BindingInfo()
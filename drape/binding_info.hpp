@@ -20,6 +20,8 @@ struct BindingDecl
   glConst m_componentType;
   uint8_t m_stride;
   uint8_t m_offset;
+  // Integer components are read by shaders as floats in [-1, 1] (or [0, 1] for unsigned types).
+  bool m_normalized = false;
 
   bool operator==(BindingDecl const & other) const;
   bool operator!=(BindingDecl const & other) const;
@@ -57,6 +59,7 @@ uint8_t FillDecl(size_t index, std::string const & attrName, dp::BindingInfo & i
   decl.m_componentType = gl_const::GLFloatType;
   decl.m_offset = offset;
   decl.m_stride = sizeof(TVertexType);
+  decl.m_normalized = false;
 
   return sizeof(TFieldType);
 }
@@ -76,6 +79,24 @@ public:
     ++m_index;
   }
 
+  // Declares a field of |componentCount| integers of |componentType| which shaders read as
+  // normalized floats.
+  template <typename TFieldType>
+  void FillNormalizedDecl(std::string const & attrName, uint8_t componentCount,
+                          glConst componentType)
+  {
+    dp::BindingDecl & decl = m_info.GetBindingDecl(static_cast<uint16_t>(m_index));
+    decl.m_attributeName = attrName;
+    decl.m_componentCount = componentCount;
+    decl.m_componentType = componentType;
+    decl.m_offset = m_offset;
+    decl.m_stride = sizeof(TVertex);
+    decl.m_normalized = true;
+
+    m_offset += sizeof(TFieldType);
+    ++m_index;
+  }
+
   dp::BindingInfo m_info;
 
 private:
@@ -10,8 +10,10 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <vector>
 
 namespace dp
 {
@@ -241,23 +243,74 @@ void GlyphIndex::UploadResources(ref_ptr<dp::GraphicsContext> context, ref_ptr<T
   if (pendingNodes.empty())
     return;
 
-  for (size_t i = 0; i < pendingNodes.size(); ++i)
+  for (auto it = pendingNodes.begin(); it != pendingNodes.end();)
   {
-    GlyphManager::Glyph & glyph = pendingNodes[i].second;
-    m2::RectU const rect = pendingNodes[i].first;
-    m2::PointU const zeroPoint = rect.LeftBottom();
+    GlyphManager::Glyph & glyph = it->second;
+    m2::RectU const & rect = it->first;
     if (glyph.m_image.m_width == 0 || glyph.m_image.m_height == 0 || rect.SizeX() == 0 || rect.SizeY() == 0)
     {
       LOG(LWARNING, ("Glyph skipped", glyph.m_code));
+      glyph.m_image.Destroy();
+      it = pendingNodes.erase(it);
       continue;
     }
     ASSERT_EQUAL(glyph.m_image.m_width, rect.SizeX(), ());
     ASSERT_EQUAL(glyph.m_image.m_height, rect.SizeY(), ());
+    ++it;
+  }
+
+  // Glyphs are packed in rows, so glyphs which are adjacent in a row are uploaded by a single
+  // call. The packer never uses the space above glyphs which are lower than others in the row,
+  // so it's filled with zeros.
+  std::sort(pendingNodes.begin(), pendingNodes.end(), [](PendingNode const & l, PendingNode const & r)
+  {
+    if (l.first.minY() != r.first.minY())
+      return l.first.minY() < r.first.minY();
+    return l.first.minX() < r.first.minX();
+  });
+
+  uint32_t const bytesPerPixel = GetBytesPerPixel(texture->GetFormat());
+  std::vector<uint8_t> rowData;
+  for (size_t i = 0; i < pendingNodes.size();)
+  {
+    m2::RectU const & firstRect = pendingNodes[i].first;
+    uint32_t height = firstRect.SizeY();
+    size_t j = i + 1;
+    for (; j < pendingNodes.size(); ++j)
+    {
+      m2::RectU const & rect = pendingNodes[j].first;
+      if (rect.minY() != firstRect.minY() || rect.minX() != pendingNodes[j - 1].first.maxX())
+        break;
+      height = std::max(height, rect.SizeY());
+    }
 
-    uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
-    texture->UploadData(context, zeroPoint.x, zeroPoint.y, rect.SizeX(), rect.SizeY(), make_ref(srcMemory));
+    if (j == i + 1)
+    {
+      uint8_t * srcMemory = SharedBufferManager::GetRawPointer(pendingNodes[i].second.m_image.m_data);
+      texture->UploadData(context, firstRect.minX(), firstRect.minY(), firstRect.SizeX(),
+                          firstRect.SizeY(), make_ref(srcMemory));
+    }
+    else
+    {
+      uint32_t const width = pendingNodes[j - 1].first.maxX() - firstRect.minX();
+      uint32_t const rowPitch = width * bytesPerPixel;
+      rowData.assign(static_cast<size_t>(rowPitch) * height, 0);
+      for (size_t k = i; k < j; ++k)
+      {
+        m2::RectU const & rect = pendingNodes[k].first;
+        uint32_t const glyphPitch = rect.SizeX() * bytesPerPixel;
+        uint8_t const * srcMemory = SharedBufferManager::GetRawPointer(pendingNodes[k].second.m_image.m_data);
+        uint8_t * dstMemory = rowData.data() + (rect.minX() - firstRect.minX()) * bytesPerPixel;
+        for (uint32_t y = 0; y < rect.SizeY(); ++y)
+          memcpy(dstMemory + y * rowPitch, srcMemory + y * glyphPitch, glyphPitch);
+      }
+      texture->UploadData(context, firstRect.minX(), firstRect.minY(), width, height,
+                          make_ref(rowData.data()));
+    }
 
-    glyph.m_image.Destroy();
+    for (size_t k = i; k < j; ++k)
+      pendingNodes[k].second.m_image.Destroy();
+    i = j;
   }
 }
 
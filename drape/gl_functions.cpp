@@ -132,6 +132,12 @@ typedef GLenum(DP_APIENTRY * TglCheckFramebufferStatusFn)(GLenum target);
 
 typedef GLubyte const * (DP_APIENTRY * TglGetStringiFn) (GLenum name, GLuint index);
 
+typedef void(DP_APIENTRY * TglGetProgramBinaryFn)(GLuint programID, GLsizei bufSize,
+                                                  GLsizei * length, GLenum * binaryFormat,
+                                                  void * binary);
+typedef void(DP_APIENTRY * TglProgramBinaryFn)(GLuint programID, GLenum binaryFormat,
+                                               void const * binary, GLsizei length);
+
 TglClearColorFn glClearColorFn = nullptr;
 TglClearFn glClearFn = nullptr;
 TglViewportFn glViewportFn = nullptr;
@@ -206,10 +212,21 @@ TglCheckFramebufferStatusFn glCheckFramebufferStatusFn = nullptr;
 
 TglGetStringiFn glGetStringiFn = nullptr;
 
+TglGetProgramBinaryFn glGetProgramBinaryFn = nullptr;
+TglProgramBinaryFn glProgramBinaryFn = nullptr;
+
 #if !defined(GL_NUM_EXTENSIONS)
   #define GL_NUM_EXTENSIONS 0x821D
 #endif
 
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+  #define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#if !defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+  #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 std::mutex s_mutex;
 bool s_inited = false;
 }  // namespace
@@ -299,6 +316,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = ::glMapBufferRange;
     glFlushMappedBufferRangeFn = ::glFlushMappedBufferRange;
     glGetStringiFn = ::glGetStringi;
+    glGetProgramBinaryFn = ::glGetProgramBinary;
+    glProgramBinaryFn = ::glProgramBinary;
   }
   else
   {
@@ -815,6 +834,56 @@ bool GLFunctions::glLinkProgram(uint32_t programID, std::string & errorLog)
   return false;
 }
 
+bool GLFunctions::glHasProgramBinary()
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  if (glGetProgramBinaryFn == nullptr || glProgramBinaryFn == nullptr)
+    return false;
+
+  return glGetInteger(GL_NUM_PROGRAM_BINARY_FORMATS) > 0;
+}
+
+bool GLFunctions::glGetProgramBinary(uint32_t programID, glConst & binaryFormat,
+                                     std::vector<uint8_t> & binary)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  ASSERT(glGetProgramBinaryFn != nullptr, ());
+  ASSERT(glGetProgramivFn != nullptr, ());
+
+  GLint length = 0;
+  GLCHECK(glGetProgramivFn(programID, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (length <= 0)
+    return false;
+
+  binary.resize(static_cast<size_t>(length));
+  GLsizei writtenLength = 0;
+  GLenum format = 0;
+  GLCHECK(glGetProgramBinaryFn(programID, length, &writtenLength, &format, binary.data()));
+  if (writtenLength <= 0)
+    return false;
+
+  binary.resize(static_cast<size_t>(writtenLength));
+  binaryFormat = format;
+  return true;
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst binaryFormat,
+                                  std::vector<uint8_t> const & binary)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  ASSERT(glProgramBinaryFn != nullptr, ());
+  ASSERT(glGetProgramivFn != nullptr, ());
+
+  // GL_INVALID_ENUM is expected here if the format isn't supported anymore, so the error
+  // is reset instead of GLCHECK.
+  glProgramBinaryFn(programID, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+  ::glGetError();
+
+  GLint result = GL_FALSE;
+  GLCHECK(glGetProgramivFn(programID, GL_LINK_STATUS, &result));
+  return result == GL_TRUE;
+}
+
 void GLFunctions::glDeleteProgram(uint32_t programID)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
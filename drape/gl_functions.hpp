@@ -6,8 +6,10 @@
 
 #include "base/src_point.hpp"
 
+#include <cstdint>
 #include <string>
 #include <thread>
+#include <vector>
 
 class GLFunctions
 {
@@ -93,6 +95,14 @@ public:
   static bool glLinkProgram(uint32_t programID, std::string & errorLog);
   static void glDeleteProgram(uint32_t programID);
 
+  // Program binaries are supported only for OpenGL ES3 (and desktop OpenGL 4.1+).
+  static bool glHasProgramBinary();
+  static bool glGetProgramBinary(uint32_t programID, glConst & binaryFormat,
+                                 std::vector<uint8_t> & binary);
+  // Returns false if the binary is rejected by the driver, e.g. it has been updated.
+  static bool glProgramBinary(uint32_t programID, glConst binaryFormat,
+                              std::vector<uint8_t> const & binary);
+
   static void glUseProgram(uint32_t programID);
   static int8_t glGetAttribLocation(uint32_t programID, std::string const & name);
   static void glBindAttribLocation(uint32_t programID, uint8_t index, std::string const & name);
@@ -35,9 +35,16 @@ GLGpuProgram::GLGpuProgram(std::string const & programName,
   }
 }
 
+GLGpuProgram::GLGpuProgram(std::string const & programName, uint32_t linkedProgramID)
+  : GpuProgram(programName)
+  , m_programID(linkedProgramID)
+{
+  LoadUniformLocations();
+}
+
 GLGpuProgram::~GLGpuProgram()
 {
-  if (SupportManager::Instance().IsTegraDevice())
+  if (m_vertexShader != nullptr && SupportManager::Instance().IsTegraDevice())
   {
     GLFunctions::glDetachShader(m_programID, m_vertexShader->GetID());
     GLFunctions::glDetachShader(m_programID, m_fragmentShader->GetID());
@@ -16,8 +16,12 @@ class GLGpuProgram : public GpuProgram
 public:
   GLGpuProgram(std::string const & programName,
                ref_ptr<Shader> vertexShader, ref_ptr<Shader> fragmentShader);
+  // Takes ownership of a program which has been already linked, e.g. loaded from a binary.
+  GLGpuProgram(std::string const & programName, uint32_t linkedProgramID);
   ~GLGpuProgram() override;
 
+  uint32_t GetID() const { return m_programID; }
+
   void Bind() override;
   void Unbind() override;
 
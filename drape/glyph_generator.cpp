@@ -1,5 +1,6 @@
 #include "drape/glyph_generator.hpp"
 
+#include <algorithm>
 #include <iterator>
 
 namespace dp
@@ -31,9 +32,6 @@ void GlyphGenerator::FinishGeneration()
   m_activeTasks.FinishAll();
 
   std::lock_guard<std::mutex> lock(m_mutex);
-  for (auto & data : m_queue)
-    data.DestroyGlyph();
-
   m_glyphsCounter = 0;
 }
 
@@ -71,13 +69,25 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
     return;
   }
 
-  GlyphGenerationDataArray queue;
-  std::move(generationData.begin(), generationData.end(), std::back_inserter(m_queue));
-  std::swap(m_queue, queue);
-  m_glyphsCounter += queue.size();
+  // Big batches come when a new script appears on the map, so they are split to generate
+  // glyphs on several threads.
+  for (size_t begin = 0; begin < generationData.size(); begin += kMaxGlyphsPerTask)
+  {
+    auto const end = std::min(begin + kMaxGlyphsPerTask, generationData.size());
+    GlyphGenerationDataArray glyphs(std::make_move_iterator(generationData.begin() + begin),
+                                    std::make_move_iterator(generationData.begin() + end));
+    RunGenerationTask(listener, std::move(glyphs));
+  }
+}
+
+void GlyphGenerator::RunGenerationTask(ref_ptr<Listener> listener,
+                                       GlyphGenerationDataArray && glyphs)
+{
+  auto const glyphsCount = glyphs.size();
+  m_glyphsCounter += glyphsCount;
 
   // Generate glyphs on the separate thread.
-  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue));
+  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(glyphs));
   auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
   {
     generateTask->Run(m_sdfScale);
@@ -85,9 +95,14 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   });
 
   if (result)
+  {
     m_activeTasks.Add(std::move(generateTask), std::move(result));
+  }
   else
+  {
     generateTask->DestroyAllGlyphs();
+    m_glyphsCounter -= glyphsCount;
+  }
 }
 
 void GlyphGenerator::OnTaskFinished(ref_ptr<Listener> listener,
@@ -18,6 +18,8 @@ namespace dp
 class GlyphGenerator
 {
 public:
+  static size_t constexpr kMaxGlyphsPerTask = 16;
+
   struct GlyphGenerationData
   {
     m2::RectU m_rect;
@@ -77,13 +79,14 @@ public:
   void FinishGeneration();
 
 private:
+  // Must be called under the mutex.
+  void RunGenerationTask(ref_ptr<Listener> listener, GlyphGenerationDataArray && glyphs);
   void OnTaskFinished(ref_ptr<Listener> listener, std::shared_ptr<GenerateGlyphTask> const & task);
 
   uint32_t m_sdfScale;
   std::set<ref_ptr<Listener>> m_listeners;
   ActiveTasks<GenerateGlyphTask> m_activeTasks;
 
-  GlyphGenerationDataArray m_queue;
   size_t m_glyphsCounter = 0;
   mutable std::mutex m_mutex;
 };
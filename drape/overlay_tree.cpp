@@ -89,11 +89,13 @@ void OverlayTree::SetVisualScale(double visualScale)
 {
   m_traits.SetVisualScale(visualScale);
   InvalidateOnNextFrame();
+  ResetPlacement();
 }
 
 void OverlayTree::Clear()
 {
   InvalidateOnNextFrame();
+  ResetPlacement();
   TBase::Clear();
   m_handlesCache.clear();
   m_overlayIdCache.clear();
@@ -335,24 +337,39 @@ void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
-  m_displacers.clear();
-
 #ifdef DEBUG_OVERLAYS_OUTPUT
   LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
 #endif
 
   HandleComparator comparator(false /* enableMask */);
+  for (auto & handles : m_handles)
+    std::sort(handles.begin(), handles.end(), comparator);
 
-  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  m_isPlacementReused = CanReusePlacement();
+  if (m_isPlacementReused)
   {
-    std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
+    for (auto const & [handle, pixelRect] : m_lastPlacedHandles)
+    {
+      m_handlesCache.insert(handle);
+      m_overlayIdCache[handle->GetOverlayID()].push_back(handle);
+      TBase::Add(handle, pixelRect);
+    }
+  }
+  else
+  {
+    m_displacers.clear();
 
-    for (auto const & handle : m_handles[rank])
+    for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
     {
-      ref_ptr<OverlayHandle> parentOverlay;
-      if (CheckHandle(handle, rank, parentOverlay))
-        InsertHandle(handle, rank, parentOverlay);
+      for (auto const & handle : m_handles[rank])
+      {
+        ref_ptr<OverlayHandle> parentOverlay;
+        if (CheckHandle(handle, rank, parentOverlay))
+          InsertHandle(handle, rank, parentOverlay);
+      }
     }
+
+    StorePlacement();
   }
 
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
@@ -376,6 +393,67 @@ void OverlayTree::EndOverlayPlacing()
 #endif
 }
 
+bool OverlayTree::CanReusePlacement() const
+{
+  // Displacement info must be collected on every placement.
+  if (!m_hasLastPlacement || (m_debugRectRenderer && m_debugRectRenderer->IsEnabled()))
+    return false;
+
+  ScreenBase const & modelView = GetModelView();
+  if (modelView != m_lastPlacementScreen ||
+      modelView.isPerspective() != m_lastPlacementScreen.isPerspective() ||
+      !(modelView.Pto3dMatrix() == m_lastPlacementScreen.Pto3dMatrix()))
+  {
+    return false;
+  }
+
+  // Candidates are sorted, so the same set of handles gives the same sequence.
+  size_t index = 0;
+  for (auto const & handles : m_handles)
+  {
+    for (auto const & handle : handles)
+    {
+      if (index >= m_lastCandidates.size())
+        return false;
+
+      auto const & candidate = m_lastCandidates[index++];
+      if (candidate.m_handle != handle || candidate.m_priority != handle->GetPriority() ||
+          candidate.m_pixelRect != handle->GetExtendedPixelRect(modelView))
+      {
+        return false;
+      }
+    }
+  }
+  return index == m_lastCandidates.size();
+}
+
+void OverlayTree::StorePlacement()
+{
+  ScreenBase const & modelView = GetModelView();
+
+  m_lastCandidates.clear();
+  for (auto const & handles : m_handles)
+  {
+    for (auto const & handle : handles)
+      m_lastCandidates.push_back({handle, handle->GetExtendedPixelRect(modelView), handle->GetPriority()});
+  }
+
+  m_lastPlacedHandles.clear();
+  m_lastPlacedHandles.reserve(m_handlesCache.size());
+  for (auto const & handle : m_handlesCache)
+    m_lastPlacedHandles.emplace_back(handle, handle->GetExtendedPixelRect(modelView));
+
+  m_lastPlacementScreen = modelView;
+  m_hasLastPlacement = true;
+}
+
+void OverlayTree::ResetPlacement()
+{
+  m_lastCandidates.clear();
+  m_lastPlacedHandles.clear();
+  m_hasLastPlacement = false;
+}
+
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                               ref_ptr<OverlayHandle> & parentOverlay) const
 {
@@ -517,10 +595,13 @@ void OverlayTree::SetDisplacementEnabled(bool enabled)
     return;
   m_isDisplacementEnabled = enabled;
   InvalidateOnNextFrame();
+  ResetPlacement();
 }
 
 void OverlayTree::SetSelectedFeature(FeatureID const & featureID)
 {
+  if (m_selectedFeatureID != featureID)
+    ResetPlacement();
   m_selectedFeatureID = featureID;
 }
 
@@ -11,6 +11,7 @@
 #include <array>
 #include <memory>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace dp
@@ -74,6 +75,9 @@ public:
   //! \return true if tree completely invalidated and next call has no sense
   bool Remove(ref_ptr<OverlayHandle> handle);
   void EndOverlayPlacing();
+  // Returns true if the last EndOverlayPlacing restored the previous placement
+  // instead of resolving collisions again.
+  bool IsPlacementReused() const { return m_isPlacementReused; }
 
   HandlesCache const & GetHandlesCache() const { return m_handlesCache; }
 
@@ -117,6 +121,10 @@ private:
 
   bool IsInCache(ref_ptr<OverlayHandle> const & handle) const;
 
+  bool CanReusePlacement() const;
+  void StorePlacement();
+  void ResetPlacement();
+
   int m_frameCounter;
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
 
@@ -139,5 +147,20 @@ private:
   HandlesCache m_displacers;
   uint32_t m_frameUpdatePeriod;
   uint8_t m_zoomLevel = 1;
+
+  // The result of the last placement. If the screen and all the candidates are the same
+  // on the next placement, collisions are not resolved again, placed handles are just
+  // inserted back to the tree.
+  struct PlacementCandidate
+  {
+    ref_ptr<OverlayHandle> m_handle;
+    m2::RectD m_pixelRect;
+    uint64_t m_priority;
+  };
+  std::vector<PlacementCandidate> m_lastCandidates;
+  std::vector<std::pair<ref_ptr<OverlayHandle>, m2::RectD>> m_lastPlacedHandles;
+  ScreenBase m_lastPlacementScreen;
+  bool m_hasLastPlacement = false;
+  bool m_isPlacementReused = false;
 };
 }  // namespace dp
@@ -1,5 +1,9 @@
 #include "drape/utils/vertex_decl.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
 namespace gpu
 {
 namespace
@@ -8,6 +12,7 @@ enum VertexType
 {
   Area,
   Area3d,
+  Area3dCompact,
   HatchingArea,
   SolidTexturing,
   MaskedTexturing,
@@ -56,6 +61,22 @@ dp::BindingInfo Area3dBindingInit()
   return filler.m_info;
 }
 
+dp::BindingInfo Area3dCompactBindingInit()
+{
+  static_assert(sizeof(Area3dCompactVertex) == (sizeof(Area3dCompactVertex::TPosition) +
+                                                sizeof(Area3dCompactVertex::TPackedNormal) +
+                                                sizeof(Area3dCompactVertex::TTexCoord)), "");
+
+  dp::BindingFiller<Area3dCompactVertex> filler(3);
+  filler.FillDecl<Area3dCompactVertex::TPosition>("a_position");
+  filler.FillNormalizedDecl<Area3dCompactVertex::TPackedNormal>(
+      "a_normal", std::tuple_size<Area3dCompactVertex::TPackedNormal>::value,
+      gl_const::GLByteType);
+  filler.FillDecl<Area3dCompactVertex::TTexCoord>("a_colorTexCoords");
+
+  return filler.m_info;
+}
+
 dp::BindingInfo HatchingAreaBindingInit()
 {
   static_assert(sizeof(HatchingAreaVertex) == (sizeof(HatchingAreaVertex::TPosition) +
@@ -212,6 +233,7 @@ TInitFunction g_initFunctions[TypeCount] =
 {
   &AreaBindingInit,
   &Area3dBindingInit,
+  &Area3dCompactBindingInit,
   &HatchingAreaBindingInit,
   &SolidTexturingBindingInit,
   &MaskedTexturingBindingInit,
@@ -260,6 +282,28 @@ dp::BindingInfo const & Area3dVertex::GetBindingInfo()
   return GetBinding(Area3d);
 }
 
+Area3dCompactVertex::Area3dCompactVertex(TPosition const & position, TPackedNormal const & normal,
+                                         TTexCoord const & colorTexCoord)
+  : m_position(position)
+  , m_normal(normal)
+  , m_colorTexCoord(colorTexCoord)
+{}
+
+// static
+Area3dCompactVertex::TPackedNormal Area3dCompactVertex::PackNormal(glsl::vec3 const & normal)
+{
+  auto const pack = [](float v)
+  {
+    return static_cast<int8_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 127.0f));
+  };
+  return {pack(normal.x), pack(normal.y), pack(normal.z), 0};
+}
+
+dp::BindingInfo const & Area3dCompactVertex::GetBindingInfo()
+{
+  return GetBinding(Area3dCompact);
+}
+
 HatchingAreaVertex::HatchingAreaVertex(TPosition const & position, TTexCoord const & colorTexCoord,
                                        TMaskTexCoord const & maskTexCoord)
   : m_position(position)
@@ -5,6 +5,9 @@
 
 #include "base/buffer_vector.hpp"
 
+#include <array>
+#include <cstdint>
+
 namespace gpu
 {
 
@@ -43,6 +46,26 @@ struct Area3dVertex : BaseVertex
   static dp::BindingInfo const & GetBindingInfo();
 };
 
+// Area3dVertex with the normal packed into normalized bytes, 24 bytes instead of 32.
+// The same shaders are used, but the format needs the normalized attributes of OpenGL or Vulkan.
+struct Area3dCompactVertex : BaseVertex
+{
+  using TPackedNormal = std::array<int8_t, 4>;
+
+  Area3dCompactVertex() = default;
+  Area3dCompactVertex(TPosition const & position, TPackedNormal const & normal,
+                      TTexCoord const & colorTexCoord);
+
+  // Packs a unit vector, the 4th component is padding.
+  static TPackedNormal PackNormal(glsl::vec3 const & normal);
+
+  TPosition m_position;
+  TPackedNormal m_normal;
+  TTexCoord m_colorTexCoord;
+
+  static dp::BindingInfo const & GetBindingInfo();
+};
+
 struct HatchingAreaVertex : BaseVertex
 {
   using TMaskTexCoord = glsl::vec2;
@@ -98,7 +98,7 @@ public:
         assert(attributeLocation != -1);
         GLFunctions::glEnableVertexAttribute(attributeLocation);
         GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
-                                              decl.m_componentType, false, decl.m_stride,
+                                              decl.m_componentType, decl.m_normalized, decl.m_stride,
                                               decl.m_offset);
       }
     }
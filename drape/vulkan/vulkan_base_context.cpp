@@ -251,6 +251,7 @@ bool VulkanBaseContext::BeginRendering()
                                      &commandBufferBeginInfo));
   CHECK_VK_CALL(vkBeginCommandBuffer(m_renderingCommandBuffers[m_inflightFrameIndex],
                                      &commandBufferBeginInfo));
+  ResetBoundState();
 
   return true;
 }
@@ -473,6 +474,7 @@ void VulkanBaseContext::ApplyFramebuffer(std::string const & framebufferLabel)
   m_isActiveRenderPass = true;
   vkCmdBeginRenderPass(m_renderingCommandBuffers[m_inflightFrameIndex], &renderPassBeginInfo,
                        VK_SUBPASS_CONTENTS_INLINE);
+  ResetBoundState();
 }
 
 void VulkanBaseContext::Present()
@@ -534,6 +536,7 @@ void VulkanBaseContext::ResetPipelineCache()
 {
   if (m_pipeline)
     m_pipeline->ResetCache(m_device);
+  ResetBoundState();
 }
 
 void VulkanBaseContext::SetClearColor(Color const & color)
@@ -729,7 +732,72 @@ void VulkanBaseContext::ClearParamDescriptors()
 
 VkPipeline VulkanBaseContext::GetCurrentPipeline()
 {
-  return m_pipeline->GetPipeline(m_device, m_pipelineKey);
+  if (m_lastPipeline == VK_NULL_HANDLE || !(m_lastPipelineKey == m_pipelineKey))
+  {
+    m_lastPipeline = m_pipeline->GetPipeline(m_device, m_pipelineKey);
+    m_lastPipelineKey = m_pipelineKey;
+  }
+  return m_lastPipeline;
+}
+
+void VulkanBaseContext::BindCurrentPipeline(VkCommandBuffer commandBuffer)
+{
+  VkPipeline const pipeline = GetCurrentPipeline();
+  if (pipeline == m_boundState.m_pipeline)
+    return;
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+  m_boundState.m_pipeline = pipeline;
+}
+
+void VulkanBaseContext::BindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t buffersCount,
+                                          VkBuffer const * buffers)
+{
+  CHECK_LESS_OR_EQUAL(buffersCount, kMaxVertexBuffersCount, ());
+  if (buffersCount == m_boundState.m_vertexBuffersCount &&
+      std::equal(buffers, buffers + buffersCount, m_boundState.m_vertexBuffers.begin()))
+  {
+    return;
+  }
+
+  std::array<VkDeviceSize, kMaxVertexBuffersCount> const offsets = {};
+  vkCmdBindVertexBuffers(commandBuffer, 0, buffersCount, buffers, offsets.data());
+  std::copy(buffers, buffers + buffersCount, m_boundState.m_vertexBuffers.begin());
+  m_boundState.m_vertexBuffersCount = buffersCount;
+}
+
+void VulkanBaseContext::BindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                        VkIndexType indexType)
+{
+  if (buffer == m_boundState.m_indexBuffer && indexType == m_boundState.m_indexType)
+    return;
+
+  vkCmdBindIndexBuffer(commandBuffer, buffer, 0, indexType);
+  m_boundState.m_indexBuffer = buffer;
+  m_boundState.m_indexType = indexType;
+}
+
+void VulkanBaseContext::BindDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet)
+{
+  VkPipelineLayout const layout = GetCurrentPipelineLayout();
+  uint32_t const dynamicOffset = GetCurrentDynamicBufferOffset();
+  if (layout == m_boundState.m_pipelineLayout && descriptorSet == m_boundState.m_descriptorSet &&
+      dynamicOffset == m_boundState.m_dynamicOffset)
+  {
+    return;
+  }
+
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1,
+                          &descriptorSet, 1, &dynamicOffset);
+  m_boundState.m_pipelineLayout = layout;
+  m_boundState.m_descriptorSet = descriptorSet;
+  m_boundState.m_dynamicOffset = dynamicOffset;
+}
+
+void VulkanBaseContext::ResetBoundState()
+{
+  m_boundState = {};
+  m_lastPipeline = VK_NULL_HANDLE;
 }
 
 std::vector<ParamDescriptor> const & VulkanBaseContext::GetCurrentParamDescriptors() const
@@ -874,7 +942,10 @@ void VulkanBaseContext::DestroyRenderPassAndFramebuffer(ref_ptr<BaseFramebuffer>
 {
   auto const & fbData = m_framebuffersData[framebuffer];
   if (m_pipeline && fbData.m_renderPass != VK_NULL_HANDLE)
+  {
     m_pipeline->ResetCache(m_device, fbData.m_renderPass);
+    ResetBoundState();
+  }
 
   for (auto & fb : fbData.m_framebuffers)
     vkDestroyFramebuffer(m_device, fb, nullptr);
@@ -96,6 +96,13 @@ public:
   uint32_t GetCurrentInflightFrameIndex() const { return m_inflightFrameIndex; }
 
   VkPipeline GetCurrentPipeline();
+  // The following methods skip commands which bind the same state as the previous
+  // draw call in the current render pass.
+  void BindCurrentPipeline(VkCommandBuffer commandBuffer);
+  void BindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t buffersCount,
+                         VkBuffer const * buffers);
+  void BindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkIndexType indexType);
+  void BindDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet);
   VkPipelineLayout GetCurrentPipelineLayout() const;
   uint32_t GetCurrentDynamicBufferOffset() const;
   std::vector<ParamDescriptor> const & GetCurrentParamDescriptors() const;
@@ -215,6 +222,26 @@ protected:
   VulkanPipeline::PipelineKey m_pipelineKey;
   std::vector<ParamDescriptor> m_paramDescriptors;
 
+  void ResetBoundState();
+
+  // Consecutive draw calls mostly use the same pipeline, so the last lookup is cached.
+  VulkanPipeline::PipelineKey m_lastPipelineKey;
+  VkPipeline m_lastPipeline = {};
+
+  static uint32_t constexpr kMaxVertexBuffersCount = 8;
+  struct BoundState
+  {
+    VkPipeline m_pipeline = {};
+    std::array<VkBuffer, kMaxVertexBuffersCount> m_vertexBuffers = {};
+    uint32_t m_vertexBuffersCount = 0;
+    VkBuffer m_indexBuffer = {};
+    VkIndexType m_indexType = VK_INDEX_TYPE_UINT16;
+    VkPipelineLayout m_pipelineLayout = {};
+    VkDescriptorSet m_descriptorSet = {};
+    uint32_t m_dynamicOffset = 0;
+  };
+  BoundState m_boundState;
+
   std::array<drape_ptr<VulkanStagingBuffer>, kMaxInflightFrames> m_defaultStagingBuffers = {};
   std::atomic<bool> m_presentAvailable;
   uint32_t m_frameCounter = 0;
@@ -6,6 +6,7 @@
 #include "drape/vulkan/vulkan_utils.hpp"
 
 #include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
 
 #include <cstdint>
 #include <vector>
@@ -148,19 +149,15 @@ public:
     vulkanContext->SetBindingInfo(m_bindingInfo, m_bindingInfoCount);
 
     m_descriptorUpdater.Update(context);
-    auto descriptorSet = m_descriptorUpdater.GetDescriptorSet();
+    vulkanContext->BindDescriptorSet(commandBuffer, m_descriptorUpdater.GetDescriptorSet());
 
-    uint32_t dynamicOffset = vulkanContext->GetCurrentDynamicBufferOffset();
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            vulkanContext->GetCurrentPipelineLayout(), 0, 1,
-                            &descriptorSet, 1, &dynamicOffset);
+    vulkanContext->BindCurrentPipeline(commandBuffer);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      vulkanContext->GetCurrentPipeline());
-
-    VkDeviceSize offsets[1] = {0};
-    for (uint32_t i = 0; i < static_cast<uint32_t>(m_geometryBuffers.size()); ++i)
-      vkCmdBindVertexBuffers(commandBuffer, i, 1, &m_geometryBuffers[i].m_buffer, offsets);
+    buffer_vector<VkBuffer, 8> buffers;
+    for (auto const & b : m_geometryBuffers)
+      buffers.push_back(b.m_buffer);
+    vulkanContext->BindVertexBuffers(commandBuffer, static_cast<uint32_t>(buffers.size()),
+                                     buffers.data());
 
     vkCmdDraw(commandBuffer, verticesCount, 1, 0, 0);
   }
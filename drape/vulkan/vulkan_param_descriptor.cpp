@@ -9,15 +9,27 @@ namespace dp
 {
 namespace vulkan
 {
-void DescriptorSetGroup::Update(VkDevice device, std::vector<ParamDescriptor> const & descriptors)
+namespace
 {
-  size_t const writeDescriptorsCount = descriptors.size();
-  CHECK_LESS_OR_EQUAL(writeDescriptorsCount, kMaxDescriptorSets, ());
-
+std::array<uint32_t, kMaxDescriptorSets> GetIds(std::vector<ParamDescriptor> const & descriptors)
+{
+  CHECK_LESS_OR_EQUAL(descriptors.size(), kMaxDescriptorSets, ());
   std::array<uint32_t, kMaxDescriptorSets> ids = {};
-  for (size_t i = 0; i < writeDescriptorsCount; ++i)
+  for (size_t i = 0; i < descriptors.size(); ++i)
     ids[i] = descriptors[i].m_id;
+  return ids;
+}
+}  // namespace
+
+bool DescriptorSetGroup::IsUpdatedWith(std::vector<ParamDescriptor> const & descriptors) const
+{
+  return m_updated && GetIds(descriptors) == m_ids;
+}
 
+void DescriptorSetGroup::Update(VkDevice device, std::vector<ParamDescriptor> const & descriptors)
+{
+  size_t const writeDescriptorsCount = descriptors.size();
+  auto const ids = GetIds(descriptors);
   if (m_updated && ids == m_ids)
     return;
 
@@ -63,6 +75,7 @@ void ParamDescriptorUpdater::Reset(uint32_t inflightFrameIndex)
     m_objectManager->DestroyDescriptorSetGroup(g);
   ud.m_descriptorSetGroups.clear();
   ud.m_descriptorSetIndex = 0;
+  ud.m_usedGroupsCount = 0;
   ud.m_updateDescriptorFrame = 0;
 }
 
@@ -89,19 +102,29 @@ void ParamDescriptorUpdater::Update(ref_ptr<dp::GraphicsContext> context)
   if (ud.m_updateDescriptorFrame != vulkanContext->GetCurrentFrameIndex())
   {
     ud.m_updateDescriptorFrame = vulkanContext->GetCurrentFrameIndex();
-    ud.m_descriptorSetIndex = 0;
+    ud.m_usedGroupsCount = 0;
   }
-  else
+
+  // Object is often rendered several times per frame with the same textures and uniform buffer
+  // (e.g. range by range), only the dynamic offset differs. Descriptor sets which are already
+  // used in this frame are reused then.
+  auto const & descriptors = vulkanContext->GetCurrentParamDescriptors();
+  for (uint32_t i = 0; i < ud.m_usedGroupsCount; ++i)
   {
-    ud.m_descriptorSetIndex++;
+    if (ud.m_descriptorSetGroups[i].IsUpdatedWith(descriptors))
+    {
+      ud.m_descriptorSetIndex = i;
+      return;
+    }
   }
 
+  ud.m_descriptorSetIndex = ud.m_usedGroupsCount++;
+
   CHECK_LESS_OR_EQUAL(ud.m_descriptorSetIndex, ud.m_descriptorSetGroups.size(), ());
   if (ud.m_descriptorSetIndex == ud.m_descriptorSetGroups.size())
     ud.m_descriptorSetGroups.emplace_back(m_objectManager->CreateDescriptorSetGroup(ud.m_program));
 
-  ud.m_descriptorSetGroups[ud.m_descriptorSetIndex].Update(vulkanContext->GetDevice(),
-                                                           vulkanContext->GetCurrentParamDescriptors());
+  ud.m_descriptorSetGroups[ud.m_descriptorSetIndex].Update(vulkanContext->GetDevice(), descriptors);
 }
 
 VkDescriptorSet ParamDescriptorUpdater::GetDescriptorSet() const
@@ -48,6 +48,8 @@ struct DescriptorSetGroup
            m_descriptorPool != VK_NULL_HANDLE;
   }
 
+  // Returns true if the set is filled with |descriptors|, dynamic offsets are not taken into account.
+  bool IsUpdatedWith(std::vector<ParamDescriptor> const & descriptors) const;
   void Update(VkDevice device, std::vector<ParamDescriptor> const & descriptors);
 };
 
@@ -72,6 +74,8 @@ private:
     ref_ptr<VulkanGpuProgram> m_program;
     uint32_t m_updateDescriptorFrame = 0;
     uint32_t m_descriptorSetIndex = 0;
+    // Number of descriptor set groups which are used in the current frame.
+    uint32_t m_usedGroupsCount = 0;
   };
   std::array<UpdateData, kMaxInflightFrames> m_updateData;
   uint32_t m_currentInflightFrameIndex = 0;
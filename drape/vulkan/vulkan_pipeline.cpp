@@ -67,8 +67,30 @@ VkStencilOp DecodeStencilAction(uint8_t stencilActionByte)
   UNREACHABLE();
 }
 
-VkFormat GetAttributeFormat(uint8_t componentCount, glConst componentType)
+VkFormat GetAttributeFormat(uint8_t componentCount, glConst componentType, bool normalized)
 {
+  if (normalized && componentType == gl_const::GLByteType)
+  {
+    switch (componentCount)
+    {
+    case 1: return VK_FORMAT_R8_SNORM;
+    case 2: return VK_FORMAT_R8G8_SNORM;
+    case 3: return VK_FORMAT_R8G8B8_SNORM;
+    case 4: return VK_FORMAT_R8G8B8A8_SNORM;
+    }
+  }
+  else if (normalized && componentType == gl_const::GLShortType)
+  {
+    switch (componentCount)
+    {
+    case 1: return VK_FORMAT_R16_SNORM;
+    case 2: return VK_FORMAT_R16G16_SNORM;
+    case 3: return VK_FORMAT_R16G16B16_SNORM;
+    case 4: return VK_FORMAT_R16G16B16A16_SNORM;
+    }
+  }
+  CHECK(!normalized, ("Unsupported normalized attribute type", componentType));
+
   if (componentType == gl_const::GLFloatType)
   {
     switch (componentCount)
@@ -356,7 +378,8 @@ VkPipeline VulkanPipeline::GetPipeline(VkDevice device, PipelineKey const & key)
       attributeDescriptions[bindingCounter].location = bindingCounter;
       attributeDescriptions[bindingCounter].binding = static_cast<uint32_t>(i);
       attributeDescriptions[bindingCounter].format = GetAttributeFormat(bindingDecl.m_componentCount,
-                                                                        bindingDecl.m_componentType);
+                                                                        bindingDecl.m_componentType,
+                                                                        bindingDecl.m_normalized);
       attributeDescriptions[bindingCounter].offset = bindingDecl.m_offset;
 
       bindingCounter++;
@@ -565,5 +588,22 @@ bool VulkanPipeline::PipelineKey::operator<(PipelineKey const & rhs) const
 
   return m_blendingEnabled < rhs.m_blendingEnabled;
 }
+
+bool VulkanPipeline::PipelineKey::operator==(PipelineKey const & rhs) const
+{
+  if (m_renderPass != rhs.m_renderPass || m_program != rhs.m_program ||
+      m_depthStencil != rhs.m_depthStencil || m_bindingInfoCount != rhs.m_bindingInfoCount ||
+      m_primitiveTopology != rhs.m_primitiveTopology || m_blendingEnabled != rhs.m_blendingEnabled)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < m_bindingInfoCount; ++i)
+  {
+    if (m_bindingInfo[i] != rhs.m_bindingInfo[i])
+      return false;
+  }
+  return true;
+}
 }  // namespace vulkan
 }  // namespace dp
@@ -36,6 +36,7 @@ public:
   struct PipelineKey
   {
     bool operator<(PipelineKey const & rhs) const;
+    bool operator==(PipelineKey const & rhs) const;
 
     VkRenderPass m_renderPass = {};
     ref_ptr<VulkanGpuProgram> m_program;
@@ -61,19 +61,12 @@ public:
     vulkanContext->SetBindingInfo(m_bindingInfo, m_bindingInfoCount);
 
     m_descriptorUpdater.Update(context);
-    auto descriptorSet = m_descriptorUpdater.GetDescriptorSet();
+    vulkanContext->BindDescriptorSet(commandBuffer, m_descriptorUpdater.GetDescriptorSet());
 
-    uint32_t dynamicOffset = vulkanContext->GetCurrentDynamicBufferOffset();
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            vulkanContext->GetCurrentPipelineLayout(), 0, 1,
-                            &descriptorSet, 1, &dynamicOffset);
-
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      vulkanContext->GetCurrentPipeline());
+    vulkanContext->BindCurrentPipeline(commandBuffer);
 
     size_t constexpr kMaxBuffersCount = 4;
     std::array<VkBuffer, kMaxBuffersCount> buffers = {};
-    std::array<VkDeviceSize, kMaxBuffersCount> offsets = {};
 
     uint32_t bufferIndex = 0;
     for (auto & buffer : m_vertexArrayBuffer->m_staticBuffers)
@@ -88,12 +81,12 @@ public:
       CHECK_LESS(bufferIndex, kMaxBuffersCount, ());
       buffers[bufferIndex++] = b->GetVulkanBuffer();
     }
-    vkCmdBindVertexBuffers(commandBuffer, 0, bufferIndex, buffers.data(), offsets.data());
+    vulkanContext->BindVertexBuffers(commandBuffer, bufferIndex, buffers.data());
 
     ref_ptr<VulkanGpuBufferImpl> ib = m_vertexArrayBuffer->m_indexBuffer->GetBuffer();
     VkBuffer vulkanIndexBuffer = ib->GetVulkanBuffer();
     auto const indexType = dp::IndexStorage::IsSupported32bit() ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
-    vkCmdBindIndexBuffer(commandBuffer, vulkanIndexBuffer, 0, indexType);
+    vulkanContext->BindIndexBuffer(commandBuffer, vulkanIndexBuffer, indexType);
 
     CHECK_LESS_OR_EQUAL(range.m_idxStart + range.m_idxCount,
                         m_objectManager->GetMemoryManager().GetDeviceLimits().maxDrawIndexedIndexValue, ());
@@ -4,8 +4,6 @@
 
 #include <vector>
 
-using namespace std::placeholders;
-
 namespace df
 {
 namespace
@@ -72,35 +70,36 @@ void AnimationSystem::UpdateLastScreen(ScreenBase const & currentScreen)
 
 bool AnimationSystem::GetScreen(ScreenBase const & currentScreen, ScreenBase & screen)
 {
-  return GetScreen(currentScreen, std::bind(&AnimationSystem::GetProperty, this, _1, _2, _3),
-                   screen);
+  return GetScreen(currentScreen, false /* target */, screen);
 }
 
 void AnimationSystem::GetTargetScreen(ScreenBase const & currentScreen, ScreenBase & screen)
 {
-  GetScreen(currentScreen, std::bind(&AnimationSystem::GetTargetProperty, this, _1, _2, _3),
-            screen);
+  GetScreen(currentScreen, true /* target */, screen);
 }
 
-bool AnimationSystem::GetScreen(ScreenBase const & currentScreen, TGetPropertyFn const & getPropertyFn,  ScreenBase & screen)
+bool AnimationSystem::GetScreen(ScreenBase const & currentScreen, bool target, ScreenBase & screen)
 {
-  ASSERT(getPropertyFn != nullptr, ());
-
   m_lastScreen = currentScreen;
 
   double scale = currentScreen.GetScale();
   double angle = currentScreen.GetAngle();
   m2::PointD pos = currentScreen.GlobalRect().GlobalZero();
 
-  Animation::PropertyValue value;
-  if (getPropertyFn(Animation::Object::MapPlane, Animation::ObjectProperty::Scale, value))
-    scale = value.m_valueD;
+  TPropertyValues values;
+  GetProperties(Animation::Object::MapPlane,
+                {Animation::ObjectProperty::Scale, Animation::ObjectProperty::Angle,
+                 Animation::ObjectProperty::Position},
+                target, values);
 
-  if (getPropertyFn(Animation::Object::MapPlane, Animation::ObjectProperty::Angle, value))
-    angle = value.m_valueD;
+  if (auto const & value = values[static_cast<size_t>(Animation::ObjectProperty::Scale)])
+    scale = value->m_valueD;
+
+  if (auto const & value = values[static_cast<size_t>(Animation::ObjectProperty::Angle)])
+    angle = value->m_valueD;
 
-  if (getPropertyFn(Animation::Object::MapPlane, Animation::ObjectProperty::Position, value))
-    pos = value.m_valuePointD;
+  if (auto const & value = values[static_cast<size_t>(Animation::ObjectProperty::Position)])
+    pos = value->m_valuePointD;
 
   screen = currentScreen;
   screen.SetFromParams(pos, angle, scale);
@@ -406,64 +405,62 @@ void AnimationSystem::Print()
 bool AnimationSystem::GetProperty(Animation::Object object, Animation::ObjectProperty property,
                                   Animation::PropertyValue & value) const
 {
-  if (!m_animationChain.empty())
-  {
-    PropertyBlender blender;
-    for (auto const & anim : *(m_animationChain.front()))
-    {
-      if (anim->HasProperty(object, property))
-      {
-        Animation::PropertyValue val;
-        if (anim->GetProperty(object, property, val))
-          blender.Blend(val);
-      }
-    }
-    if (!blender.IsEmpty())
-    {
-      value = blender.Finish();
-      return true;
-    }
-  }
+  TPropertyValues values;
+  GetProperties(object, {property}, false /* target */, values);
 
-  auto it = m_propertyCache.find(std::make_pair(object, property));
-  if (it != m_propertyCache.end())
-  {
-    value = it->second;
-    m_propertyCache.erase(it);
-    return true;
-  }
-  return false;
+  auto const & result = values[static_cast<size_t>(property)];
+  if (!result)
+    return false;
+  value = *result;
+  return true;
 }
 
-bool AnimationSystem::GetTargetProperty(Animation::Object object, Animation::ObjectProperty property,
-                                        Animation::PropertyValue & value) const
+void AnimationSystem::GetProperties(Animation::Object object,
+                                    std::initializer_list<Animation::ObjectProperty> properties,
+                                    bool target, TPropertyValues & values) const
 {
+  std::array<PropertyBlender, kPropertiesCount> blenders;
   if (!m_animationChain.empty())
   {
-    PropertyBlender blender;
     for (auto const & anim : *(m_animationChain.front()))
     {
-      if (anim->HasTargetProperty(object, property))
+      for (auto const property : properties)
       {
+        if (target ? !anim->HasTargetProperty(object, property)
+                   : !anim->HasProperty(object, property))
+        {
+          continue;
+        }
+
         Animation::PropertyValue val;
-        if (anim->GetTargetProperty(object, property, val))
-          blender.Blend(val);
+        if (target ? anim->GetTargetProperty(object, property, val)
+                   : anim->GetProperty(object, property, val))
+        {
+          blenders[static_cast<size_t>(property)].Blend(val);
+        }
       }
     }
-    if (!blender.IsEmpty())
-    {
-      value = blender.Finish();
-      return true;
-    }
   }
 
-  auto it = m_propertyCache.find(std::make_pair(object, property));
-  if (it != m_propertyCache.end())
+  for (auto const property : properties)
   {
-    value = it->second;
-    return true;
+    auto const index = static_cast<size_t>(property);
+    if (!blenders[index].IsEmpty())
+    {
+      values[index] = blenders[index].Finish();
+      continue;
+    }
+
+    // Results of finished animations are applied once, target values are kept until the next
+    // animation.
+    auto it = m_propertyCache.find(std::make_pair(object, property));
+    if (it != m_propertyCache.end())
+    {
+      values[index] = it->second;
+      if (!target)
+        m_propertyCache.erase(it);
+    }
   }
-  return false;
 }
 
 void AnimationSystem::SaveAnimationResult(Animation const & animation)
@@ -8,11 +8,14 @@
 
 #include "base/macros.hpp"
 
+#include <array>
 #include <cstring>
 #include <deque>
 #include <functional>
+#include <initializer_list>
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -68,14 +71,19 @@ public:
 private:  
   AnimationSystem() = default;
 
-  using TGetPropertyFn = std::function<bool(Animation::Object object, Animation::ObjectProperty property,
-                                                                      Animation::PropertyValue & value)>;
-  bool GetScreen(ScreenBase const & currentScreen, TGetPropertyFn const & getPropertyFn,  ScreenBase & screen);
+  // Animation::ObjectProperty values are used as indices.
+  static size_t constexpr kPropertiesCount = 3;
+  using TPropertyValues = std::array<std::optional<Animation::PropertyValue>, kPropertiesCount>;
+
+  bool GetScreen(ScreenBase const & currentScreen, bool target, ScreenBase & screen);
 
   bool GetProperty(Animation::Object object, Animation::ObjectProperty property,
                    Animation::PropertyValue & value) const;
-  bool GetTargetProperty(Animation::Object object, Animation::ObjectProperty property,
-                   Animation::PropertyValue & value) const;
+  // Blends current or target values of |properties| of |object| over the running animations in
+  // a single pass. Properties which aren't animated are taken from results of finished animations.
+  void GetProperties(Animation::Object object,
+                     std::initializer_list<Animation::ObjectProperty> properties, bool target,
+                     TPropertyValues & values) const;
   void StartNextAnimations();
   void FinishAnimations(std::function<bool(std::shared_ptr<Animation> const &)> const & predicate,
                         bool rewind, bool finishAll);
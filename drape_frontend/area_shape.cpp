@@ -127,58 +127,81 @@ void AreaShape::DrawArea3D(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Bat
 
   glsl::vec2 const uv = glsl::ToVec2(colorUv);
 
-  gpu::VBReservedSizeT<gpu::Area3dVertex> vertexes;
-  vertexes.reserve(m_vertexes.size() + m_buildingOutline.m_normals.size() * 6);
-
-  for (size_t i = 0; i < m_buildingOutline.m_normals.size(); i++)
-  {
-    int const startIndex = m_buildingOutline.m_indices[i * 2];
-    int const endIndex = m_buildingOutline.m_indices[i * 2 + 1];
-
-    glsl::vec2 const startPt = ToShapeVertex2(m_buildingOutline.m_vertices[startIndex]);
-    glsl::vec2 const endPt = ToShapeVertex2(m_buildingOutline.m_vertices[endIndex]);
-
-    glsl::vec3 normal(glsl::ToVec2(m_buildingOutline.m_normals[i]), 0.0f);
-    vertexes.emplace_back(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv);
-    vertexes.emplace_back(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv);
-    vertexes.emplace_back(glsl::vec3(startPt, -m_params.m_posZ), normal, uv);
-
-    vertexes.emplace_back(glsl::vec3(startPt, -m_params.m_posZ), normal, uv);
-    vertexes.emplace_back(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv);
-    vertexes.emplace_back(glsl::vec3(endPt, -m_params.m_posZ), normal, uv);
-  }
-
-  glsl::vec3 const normal(0.0f, 0.0f, -1.0f);
-  for (m2::PointD const & vertex : m_vertexes)
-    vertexes.emplace_back(glsl::vec3(ToShapeVertex2(vertex), -m_params.m_posZ), normal, uv);
-
   auto state = CreateRenderState(gpu::Program::Area3d, DepthLayer::Geometry3dLayer);
   state.SetDepthTestEnabled(m_params.m_depthTestEnabled);
   state.SetColorTexture(texture);
   state.SetBlending(dp::Blending(false /* isEnabled */));
 
-  dp::AttributeProvider provider(1, static_cast<uint32_t>(vertexes.size()));
-  provider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(vertexes.data()));
-  batcher->InsertTriangleList(context, state, make_ref(&provider));
+  // Every wall is a quad of 4 vertices which share the indices of its triangles, roofs are
+  // triangle lists. Both are inserted into the same bucket of the tile.
+  auto const drawVertexes = [&](auto && walls, auto && roof, auto const & convertNormal)
+  {
+    using TVertex = typename std::decay_t<decltype(walls)>::value_type;
+    walls.reserve(m_buildingOutline.m_normals.size() * dp::Batcher::VertexPerQuad);
+
+    for (size_t i = 0; i < m_buildingOutline.m_normals.size(); i++)
+    {
+      int const startIndex = m_buildingOutline.m_indices[i * 2];
+      int const endIndex = m_buildingOutline.m_indices[i * 2 + 1];
+
+      glsl::vec2 const startPt = ToShapeVertex2(m_buildingOutline.m_vertices[startIndex]);
+      glsl::vec2 const endPt = ToShapeVertex2(m_buildingOutline.m_vertices[endIndex]);
+
+      glsl::vec3 const wallNormal(glsl::ToVec2(m_buildingOutline.m_normals[i]), 0.0f);
+      auto const normal = convertNormal(wallNormal);
+      walls.emplace_back(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv);
+      walls.emplace_back(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv);
+      walls.emplace_back(glsl::vec3(startPt, -m_params.m_posZ), normal, uv);
+      walls.emplace_back(glsl::vec3(endPt, -m_params.m_posZ), normal, uv);
+    }
+
+    dp::AttributeProvider wallsProvider(1, static_cast<uint32_t>(walls.size()));
+    wallsProvider.InitStream(0, TVertex::GetBindingInfo(), make_ref(walls.data()));
+    batcher->InsertListOfStrip(context, state, make_ref(&wallsProvider), dp::Batcher::VertexPerQuad);
+
+    if (m_vertexes.empty())
+      return;
+
+    roof.reserve(m_vertexes.size());
+    auto const normal = convertNormal(glsl::vec3(0.0f, 0.0f, -1.0f));
+    for (m2::PointD const & vertex : m_vertexes)
+      roof.emplace_back(glsl::vec3(ToShapeVertex2(vertex), -m_params.m_posZ), normal, uv);
+
+    dp::AttributeProvider roofProvider(1, static_cast<uint32_t>(roof.size()));
+    roofProvider.InitStream(0, TVertex::GetBindingInfo(), make_ref(roof.data()));
+    batcher->InsertTriangleList(context, state, make_ref(&roofProvider));
+  };
+
+  // Metal takes vertex formats from the shaders, so the packed normals are used with OpenGL and
+  // Vulkan only.
+  if (context->GetApiVersion() == dp::ApiVersion::Metal)
+  {
+    drawVertexes(gpu::VBReservedSizeT<gpu::Area3dVertex>(), gpu::VBReservedSizeT<gpu::Area3dVertex>(),
+                 [](glsl::vec3 const & normal) { return normal; });
+  }
+  else
+  {
+    drawVertexes(gpu::VBReservedSizeT<gpu::Area3dCompactVertex>(),
+                 gpu::VBReservedSizeT<gpu::Area3dCompactVertex>(), &gpu::Area3dCompactVertex::PackNormal);
+  }
 
   // Generate outline.
-  if (m_buildingOutline.m_generateOutline)
+  if (m_buildingOutline.m_generateOutline && !m_buildingOutline.m_indices.empty())
   {
     glsl::vec2 const ouv = glsl::ToVec2(outlineUv);
 
-    auto outlineState = CreateRenderState(gpu::Program::Area3dOutline, DepthLayer::Geometry3dLayer);
+    gpu::VBReservedSizeT<gpu::AreaVertex> vertices;
+    vertices.reserve(m_buildingOutline.m_vertices.size());
+    for (m2::PointD const & vertex : m_buildingOutline.m_vertices)
+      vertices.emplace_back(ToShapeVertex3(vertex), ouv);
+
+    auto outlineState = CreateRenderState(gpu::Program::AreaOutline, DepthLayer::GeometryLayer);
     outlineState.SetDepthTestEnabled(m_params.m_depthTestEnabled);
     outlineState.SetColorTexture(texture);
-    outlineState.SetBlending(dp::Blending(false /* isEnabled */));
     outlineState.SetDrawAsLine(true);
 
-    gpu::VBReservedSizeT<gpu::AreaVertex> olVertexes;
-    olVertexes.reserve(m_buildingOutline.m_vertices.size());
-    for (m2::PointD const & vertex : m_buildingOutline.m_vertices)
-      olVertexes.emplace_back(glsl::vec3(ToShapeVertex2(vertex), -m_params.m_posZ), ouv);
-
-    dp::AttributeProvider outlineProvider(1, static_cast<uint32_t>(olVertexes.size()));
-    outlineProvider.InitStream(0, gpu::AreaVertex::GetBindingInfo(), make_ref(olVertexes.data()));
+    dp::AttributeProvider outlineProvider(1, static_cast<uint32_t>(vertices.size()));
+    outlineProvider.InitStream(0, gpu::AreaVertex::GetBindingInfo(), make_ref(vertices.data()));
     batcher->InsertLineRaw(context, outlineState, make_ref(&outlineProvider), m_buildingOutline.m_indices);
   }
 }
@@ -35,9 +35,11 @@ BackendRenderer::BackendRenderer(Params && params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model,
                                               params.m_allow3dBuildings, params.m_trafficEnabled,
-                                              params.m_isolinesEnabled))
+                                              params.m_isolinesEnabled,
+                                              params.m_tileShapesCacheSize))
   , m_transitBuilder(make_unique_dp<TransitSchemeBuilder>(
-        std::bind(&BackendRenderer::FlushTransitRenderData, this, _1)))
+        std::bind(&BackendRenderer::FlushTransitRenderData, this, _1),
+        std::bind(&BackendRenderer::ApplyPreparedTransitScheme, this, _1)))
   , m_trafficGenerator(make_unique_dp<TrafficGenerator>(
         std::bind(&BackendRenderer::FlushTrafficRenderData, this, _1)))
   , m_userMarkGenerator(make_unique_dp<UserMarkGenerator>(
@@ -188,6 +190,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       ref_ptr<TileReadEndMessage> msg = message;
       CHECK(m_context != nullptr, ());
       m_batchersPool->ReleaseBatcher(m_context, msg->GetKey());
+      FlushTileBuckets(msg->GetKey());
       break;
     }
 
@@ -445,10 +448,13 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::UpdateTraffic:
     {
       ref_ptr<UpdateTrafficMessage> msg = message;
-      m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring());
-      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<RegenerateTrafficMessage>(),
-                                MessagePriority::Normal);
+      // Regeneration rereads the whole scene, so it's skipped if the traffic hasn't changed.
+      if (m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring()))
+      {
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<RegenerateTrafficMessage>(),
+                                  MessagePriority::Normal);
+      }
       break;
     }
 
@@ -480,8 +486,15 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::UpdateTransitScheme:
     {
       ref_ptr<UpdateTransitSchemeMessage> msg = message;
+      m_transitBuilder->PrepareSchemes(msg->AcceptTransitDisplayInfos());
+      break;
+    }
+
+  case Message::Type::ApplyTransitScheme:
+    {
+      ref_ptr<ApplyTransitSchemeMessage> msg = message;
       CHECK(m_context != nullptr, ());
-      m_transitBuilder->UpdateSchemes(m_context, msg->GetTransitDisplayInfos(), m_texMng);
+      m_transitBuilder->ApplyScheme(m_context, msg->AcceptPreparedScheme(), m_texMng);
       break;
     }
 
@@ -675,6 +688,7 @@ void BackendRenderer::ReleaseResources()
   m_readManager.reset();
   m_metalineManager.reset();
   m_batchersPool.reset();
+  m_tileBuckets.clear();
   m_routeBuilder.reset();
   m_overlays.clear();
   m_trafficGenerator.reset();
@@ -705,6 +719,7 @@ void BackendRenderer::OnContextDestroy()
   LOG(LINFO, ("On context destroy."));
   m_readManager->Stop();
   m_batchersPool.reset();
+  m_tileBuckets.clear();
   m_metalineManager->Stop();
   m_texMng->Release();
   m_overlays.clear();
@@ -743,7 +758,7 @@ void BackendRenderer::InitContextDependentResources()
   // Increase this value for big features.
   uint32_t constexpr kBatchSize = 5000;
 
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
+  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(GetReadingThreadsCount(),
                                                std::bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
                                                kBatchSize, kBatchSize);
   m_trafficGenerator->Init();
@@ -803,10 +818,22 @@ void BackendRenderer::RecacheMapShapes()
 void BackendRenderer::FlushGeometry(TileKey const & key, dp::RenderState const & state,
                                     drape_ptr<dp::RenderBucket> && buffer)
 {
+  m_tileBuckets[key].emplace_back(state, std::move(buffer));
+}
+
+void BackendRenderer::FlushTileBuckets(TileKey const & key)
+{
+  auto const it = m_tileBuckets.find(key);
+  if (it == m_tileBuckets.end())
+    return;
+
+  auto buckets = std::move(it->second);
+  m_tileBuckets.erase(it);
+
   CHECK(m_context != nullptr, ());
   m_context->Flush();
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                            make_unique_dp<FlushRenderBucketMessage>(key, state, std::move(buffer)),
+                            make_unique_dp<FlushRenderBucketMessage>(key, std::move(buckets)),
                             MessagePriority::Normal);
 }
 
@@ -817,6 +844,14 @@ void BackendRenderer::FlushTransitRenderData(TransitRenderData && renderData)
                             MessagePriority::Normal);
 }
 
+void BackendRenderer::ApplyPreparedTransitScheme(TransitSchemeBuilder::PreparedScheme && preparedScheme)
+{
+  // Called from the transit worker thread, geometry is generated on the backend thread.
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                            make_unique_dp<ApplyTransitSchemeMessage>(std::move(preparedScheme)),
+                            MessagePriority::Normal);
+}
+
 void BackendRenderer::FlushTrafficRenderData(TrafficRenderData && renderData)
 {
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
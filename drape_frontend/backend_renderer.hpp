@@ -17,7 +17,10 @@
 #include "drape/viewport.hpp"
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace dp
 {
@@ -43,7 +46,7 @@ public:
            ref_ptr<dp::GraphicsContextFactory> factory, ref_ptr<dp::TextureManager> texMng,
            MapDataProvider const & model, TUpdateCurrentCountryFn const & updateCurrentCountryFn,
            ref_ptr<RequestedTiles> requestedTiles, bool allow3dBuildings, bool trafficEnabled,
-           bool isolinesEnabled, bool simplifiedTrafficColors,
+           bool isolinesEnabled, bool simplifiedTrafficColors, size_t tileShapesCacheSize,
            std::optional<Arrow3dCustomDecl> arrow3dCustomDecl,
            OnGraphicsContextInitialized const & onGraphicsContextInitialized)
       : BaseRenderer::Params(apiVersion, commutator, factory, texMng, onGraphicsContextInitialized)
@@ -54,6 +57,7 @@ public:
       , m_trafficEnabled(trafficEnabled)
       , m_isolinesEnabled(isolinesEnabled)
       , m_simplifiedTrafficColors(simplifiedTrafficColors)
+      , m_tileShapesCacheSize(tileShapesCacheSize)
       , m_arrow3dCustomDecl(std::move(arrow3dCustomDecl))
     {}
 
@@ -64,6 +68,7 @@ public:
     bool m_trafficEnabled;
     bool m_isolinesEnabled;
     bool m_simplifiedTrafficColors;
+    size_t m_tileShapesCacheSize;
     std::optional<Arrow3dCustomDecl> m_arrow3dCustomDecl;
   };
 
@@ -106,8 +111,10 @@ private:
 
   void InitContextDependentResources();
   void FlushGeometry(TileKey const & key, dp::RenderState const & state, drape_ptr<dp::RenderBucket> && buffer);
+  void FlushTileBuckets(TileKey const & key);
 
   void FlushTransitRenderData(TransitRenderData && renderData);
+  void ApplyPreparedTransitScheme(TransitSchemeBuilder::PreparedScheme && preparedScheme);
   void FlushTrafficRenderData(TrafficRenderData && renderData);
   void FlushUserMarksRenderData(TUserMarksRenderData && renderData);
 
@@ -127,6 +134,11 @@ private:
 
   TOverlaysRenderData m_overlays;
 
+  // Buckets are sent to the frontend once per tile reading instead of one by one, so the context
+  // is flushed and a message is posted once.
+  using TileBuckets = std::vector<std::pair<dp::RenderState, drape_ptr<dp::RenderBucket>>>;
+  std::map<TileKey, TileBuckets, TileKeyStrictComparator> m_tileBuckets;
+
   TUpdateCurrentCountryFn m_updateCurrentCountryFn;
 
   drape_ptr<MetalineManager> m_metalineManager;
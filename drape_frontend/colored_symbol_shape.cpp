@@ -112,6 +112,9 @@ void ColoredSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::
   glsl::vec3 const position = glsl::vec3(pt, m_params.m_depth);
 
   buffer_vector<V, 48> buffer;
+  // Rectangles consist of quads only, so they are inserted as a list of strips,
+  // which takes 4 vertices per quad instead of 6.
+  bool isListOfQuads = false;
 
   auto norm = [this](float x, float y)
   {
@@ -150,21 +153,18 @@ void ColoredSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::
     float const v = halfWidth * halfWidth + halfHeight * halfHeight;
     float const halfWidthInside = halfWidth - m_params.m_outlineWidth;
     float const halfHeightInside = halfHeight - m_params.m_outlineWidth;
+    isListOfQuads = true;
 
-    buffer.push_back(V(position, V::TNormal(norm(-halfWidthInside, halfHeightInside), v, 0.0f), uv));
-    buffer.push_back(V(position, V::TNormal(norm(halfWidthInside, -halfHeightInside), v, 0.0f), uv));
-    buffer.push_back(V(position, V::TNormal(norm(halfWidthInside, halfHeightInside), v, 0.0f), uv));
     buffer.push_back(V(position, V::TNormal(norm(-halfWidthInside, halfHeightInside), v, 0.0f), uv));
     buffer.push_back(V(position, V::TNormal(norm(-halfWidthInside, -halfHeightInside), v, 0.0f), uv));
+    buffer.push_back(V(position, V::TNormal(norm(halfWidthInside, halfHeightInside), v, 0.0f), uv));
     buffer.push_back(V(position, V::TNormal(norm(halfWidthInside, -halfHeightInside), v, 0.0f), uv));
 
     if (m_params.m_outlineWidth >= 1e-5)
     {
-      buffer.push_back(V(position, V::TNormal(norm(-halfWidth, halfHeight), v, 0.0f), uvOutline));
-      buffer.push_back(V(position, V::TNormal(norm(halfWidth, -halfHeight), v, 0.0f), uvOutline));
-      buffer.push_back(V(position, V::TNormal(norm(halfWidth, halfHeight), v, 0.0f), uvOutline));
       buffer.push_back(V(position, V::TNormal(norm(-halfWidth, halfHeight), v, 0.0f), uvOutline));
       buffer.push_back(V(position, V::TNormal(norm(-halfWidth, -halfHeight), v, 0.0f), uvOutline));
+      buffer.push_back(V(position, V::TNormal(norm(halfWidth, halfHeight), v, 0.0f), uvOutline));
       buffer.push_back(V(position, V::TNormal(norm(halfWidth, -halfHeight), v, 0.0f), uvOutline));
     }
   }
@@ -306,7 +306,15 @@ void ColoredSymbolShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::
 
   dp::AttributeProvider provider(1, static_cast<uint32_t>(buffer.size()));
   provider.InitStream(0, gpu::ColoredSymbolVertex::GetBindingInfo(), make_ref(buffer.data()));
-  batcher->InsertTriangleList(context, state, make_ref(&provider), std::move(handle));
+  if (isListOfQuads)
+  {
+    batcher->InsertListOfStrip(context, state, make_ref(&provider), std::move(handle),
+                               dp::Batcher::VertexPerQuad);
+  }
+  else
+  {
+    batcher->InsertTriangleList(context, state, make_ref(&provider), std::move(handle));
+  }
 }
 
 uint64_t ColoredSymbolShape::GetOverlayPriority() const
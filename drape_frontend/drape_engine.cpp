@@ -95,7 +95,8 @@ DrapeEngine::DrapeEngine(Params && params)
       params.m_apiVersion, frParams.m_commutator, frParams.m_oglContextFactory, frParams.m_texMng,
       params.m_model, params.m_model.UpdateCurrentCountryFn(), make_ref(m_requestedTiles),
       params.m_allow3dBuildings, params.m_trafficEnabled, params.m_isolinesEnabled,
-      params.m_simplifiedTrafficColors, std::move(params.m_arrow3dCustomDecl),
+      params.m_simplifiedTrafficColors, params.m_hints.m_tileShapesCacheSize,
+      std::move(params.m_arrow3dCustomDecl),
       params.m_onGraphicsContextInitialized);
 
   m_backend = make_unique_dp<BackendRenderer>(std::move(brParams));
@@ -640,6 +641,13 @@ void DrapeEngine::AllowAutoZoom(bool allowAutoZoom)
                                   MessagePriority::Normal);
 }
 
+void DrapeEngine::SetPowerSavingMode(bool enabled)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<SetPowerSavingModeMessage>(enabled),
+                                  MessagePriority::Normal);
+}
+
 void DrapeEngine::Allow3dMode(bool allowPerspectiveInNavigation, bool allow3dBuildings)
 {
   m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
@@ -760,16 +768,11 @@ void DrapeEngine::EnableTraffic(bool trafficEnabled)
 
 void DrapeEngine::UpdateTraffic(traffic::TrafficInfo const & info)
 {
-  if (info.GetColoring().empty())
+  if (info.GetColoring().IsEmpty())
     return;
 
-#ifdef DEBUG
-  for (auto const & segmentPair : info.GetColoring())
-    ASSERT_NOT_EQUAL(segmentPair.second, traffic::SpeedGroup::Unknown, ());
-#endif
-
   df::TrafficSegmentsColoring segmentsColoring;
-  segmentsColoring.emplace(info.GetMwmId(), info.GetColoring());
+  segmentsColoring.emplace(info.GetMwmId(), info.GetSharedColoring());
 
   m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                                   make_unique_dp<UpdateTrafficMessage>(std::move(segmentsColoring)),
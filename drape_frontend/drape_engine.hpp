@@ -183,6 +183,8 @@ public:
   void SetWidgetLayout(gui::TWidgetsLayoutInfo && info);
 
   void AllowAutoZoom(bool allowAutoZoom);
+  // In power saving mode frame rate of the render loop is limited.
+  void SetPowerSavingMode(bool enabled);
 
   void Allow3dMode(bool allowPerspectiveInNavigation, bool allow3dBuildings);
   void EnablePerspective();
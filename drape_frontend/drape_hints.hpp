@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace df
 {
 struct Hints
@@ -7,5 +9,8 @@ struct Hints
   bool m_isFirstLaunch = false;
   bool m_isLaunchByDeepLink = false;
   bool m_screenshotMode = false;
+  // The number of tiles the shapes of which are kept in memory to be drawn again without
+  // reading of features. Zero disables the cache.
+  uint32_t m_tileShapesCacheSize = 0;
 };
 }  // namespace df
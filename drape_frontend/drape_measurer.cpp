@@ -4,11 +4,61 @@
 
 #include "geometry/mercator.hpp"
 
+#include "base/assert.hpp"
 
+#include <algorithm>
 #include <iomanip>
 
 namespace df
 {
+void DrapeMeasurer::DurationHistogram::Add(std::chrono::nanoseconds duration)
+{
+  using namespace std::chrono;
+  if (m_counts.empty())
+    m_counts.resize(kMaxDurationInMs + 1, 0);
+
+  auto const ms = static_cast<uint64_t>(duration_cast<milliseconds>(duration).count());
+  ++m_counts[std::min(ms, static_cast<uint64_t>(kMaxDurationInMs))];
+  ++m_totalCount;
+}
+
+void DrapeMeasurer::DurationHistogram::Add(DurationHistogram const & histogram)
+{
+  if (histogram.m_totalCount == 0)
+    return;
+
+  if (m_counts.empty())
+    m_counts.resize(kMaxDurationInMs + 1, 0);
+
+  for (size_t i = 0; i < m_counts.size(); ++i)
+    m_counts[i] += histogram.m_counts[i];
+  m_totalCount += histogram.m_totalCount;
+}
+
+void DrapeMeasurer::DurationHistogram::Clear()
+{
+  m_counts.clear();
+  m_totalCount = 0;
+}
+
+uint32_t DrapeMeasurer::DurationHistogram::GetPercentileInMs(uint32_t percentile) const
+{
+  ASSERT_LESS_OR_EQUAL(percentile, 100, ());
+  if (m_totalCount == 0)
+    return 0;
+
+  // The smallest duration which is not less than |percentile| percents of durations.
+  auto const rank = std::max(static_cast<uint64_t>(1), (m_totalCount * percentile + 99) / 100);
+  uint64_t count = 0;
+  for (size_t i = 0; i < m_counts.size(); ++i)
+  {
+    count += m_counts[i];
+    if (count >= rank)
+      return static_cast<uint32_t>(i);
+  }
+  return kMaxDurationInMs;
+}
+
 DrapeMeasurer & DrapeMeasurer::Instance()
 {
   static DrapeMeasurer s_inst;
@@ -45,6 +95,15 @@ void DrapeMeasurer::Start()
   }
 #endif
 
+#ifdef RENDER_STATISTIC
+  m_activeFrameRenderTimes.Clear();
+
+  m_startOverlayPlacingTime = currentTime;
+  m_totalOverlayPlacingTime = steady_clock::duration::zero();
+  m_overlayPlacingCount = 0;
+  m_reusedOverlayPlacingCount = 0;
+#endif
+
 #if defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM)
   m_totalTPF = steady_clock::duration::zero();
   m_totalTPFCount = 0;
@@ -199,6 +258,11 @@ std::string DrapeMeasurer::RenderStatistic::ToString() const
   ss << " Immediate rendering FPS = " << m_immediateRenderingFPS << "\n";
   ss << " Immediate rendering min FPS = " << m_immediateRenderingMinFPS << "\n";
   ss << " Frame render time, ms = " << m_frameRenderTimeInMs << "\n";
+  ss << " Active frame render time (p50/p90/p99), ms = " << m_frameRenderTimeP50InMs << "/"
+     << m_frameRenderTimeP90InMs << "/" << m_frameRenderTimeP99InMs << "\n";
+  ss << " Overlay placings count = " << m_overlayPlacingCount << "\n";
+  ss << " Reused overlay placings count = " << m_reusedOverlayPlacingCount << "\n";
+  ss << " Overlay placing time, mcs = " << m_overlayPlacingTimeInMcs << "\n";
   if (!m_fpsDistribution.empty())
   {
     ss << " FPS Distribution:\n";
@@ -222,6 +286,9 @@ DrapeMeasurer::RenderStatistic DrapeMeasurer::GetRenderStatistic()
   statistic.m_minFPS = m_minFPS;
   statistic.m_frameRenderTimeInMs =
       static_cast<uint32_t>(duration_cast<milliseconds>(m_totalTPF).count()) / m_totalTPFCount;
+  statistic.m_frameRenderTimeP50InMs = m_activeFrameRenderTimes.GetPercentileInMs(50);
+  statistic.m_frameRenderTimeP90InMs = m_activeFrameRenderTimes.GetPercentileInMs(90);
+  statistic.m_frameRenderTimeP99InMs = m_activeFrameRenderTimes.GetPercentileInMs(99);
 
   uint32_t totalCount = 0;
   for (auto const & fps : m_fpsDistribution)
@@ -241,8 +308,35 @@ DrapeMeasurer::RenderStatistic DrapeMeasurer::GetRenderStatistic()
     statistic.m_immediateRenderingFPS = static_cast<uint32_t>(1000.0 / avgFrameTimeMs);
   }
 
+  statistic.m_overlayPlacingCount = m_overlayPlacingCount;
+  statistic.m_reusedOverlayPlacingCount = m_reusedOverlayPlacingCount;
+  if (m_overlayPlacingCount > 0)
+  {
+    statistic.m_overlayPlacingTimeInMcs = static_cast<uint32_t>(
+        duration_cast<microseconds>(m_totalOverlayPlacingTime).count() / m_overlayPlacingCount);
+  }
+
   return statistic;
 }
+
+void DrapeMeasurer::StartOverlayPlacing()
+{
+  if (!m_isEnabled)
+    return;
+
+  m_startOverlayPlacingTime = std::chrono::steady_clock::now();
+}
+
+void DrapeMeasurer::EndOverlayPlacing(bool isPlacementReused)
+{
+  if (!m_isEnabled)
+    return;
+
+  m_totalOverlayPlacingTime += std::chrono::steady_clock::now() - m_startOverlayPlacingTime;
+  ++m_overlayPlacingCount;
+  if (isPlacementReused)
+    ++m_reusedOverlayPlacingCount;
+}
 #endif
 
 void DrapeMeasurer::BeforeRenderFrame()
@@ -274,6 +368,10 @@ void DrapeMeasurer::AfterRenderFrame(bool isActiveFrame, m2::PointD const & view
       ++m_realtimeSlowFramesCount;
 
     ++m_realtimeTotalFramesCount;
+
+#ifdef RENDER_STATISTIC
+    m_activeFrameRenderTimes.Add(frameTime);
+#endif
   }
 
 #if defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM)
@@ -340,6 +438,8 @@ std::string DrapeMeasurer::TileStatistic::ToString() const
   std::ostringstream ss;
   ss << " ----- Tiles read statistic report ----- \n";
   ss << " Tile read time, ms = " << m_tileReadTimeInMs << "\n";
+  ss << " Tile read time (p50/p90/p99), ms = " << m_tileReadTimeP50InMs << "/"
+     << m_tileReadTimeP90InMs << "/" << m_tileReadTimeP99InMs << "\n";
   ss << " Tiles count = " << m_totalTilesCount << "\n";
   ss << " ----- Tiles read statistic report ----- \n";
 
@@ -392,12 +492,14 @@ void DrapeMeasurer::EndTileReading()
   auto passedTime = currentTime - tileInfo->m_startTileReadTime;
   tileInfo->m_totalTileReadTime += passedTime;
   ++tileInfo->m_totalTilesCount;
+  tileInfo->m_tileReadTimes.Add(passedTime);
 }
 
 DrapeMeasurer::TileStatistic DrapeMeasurer::GetTileStatistic()
 {
   using namespace std::chrono;
   TileStatistic statistic;
+  DurationHistogram tileReadTimes;
   {
     std::lock_guard<std::mutex> lock(m_tilesMutex);
     for (auto const & it : m_tilesReadInfo)
@@ -405,11 +507,16 @@ DrapeMeasurer::TileStatistic DrapeMeasurer::GetTileStatistic()
       statistic.m_tileReadTimeInMs +=
           static_cast<uint32_t>(duration_cast<milliseconds>(it.second->m_totalTileReadTime).count());
       statistic.m_totalTilesCount += it.second->m_totalTilesCount;
+      tileReadTimes.Add(it.second->m_tileReadTimes);
     }
   }
   if (statistic.m_totalTilesCount > 0)
     statistic.m_tileReadTimeInMs /= statistic.m_totalTilesCount;
 
+  statistic.m_tileReadTimeP50InMs = tileReadTimes.GetPercentileInMs(50);
+  statistic.m_tileReadTimeP90InMs = tileReadTimes.GetPercentileInMs(90);
+  statistic.m_tileReadTimeP99InMs = tileReadTimes.GetPercentileInMs(99);
+
   return statistic;
 }
 #endif
@@ -40,11 +40,22 @@ public:
     uint32_t m_FPS = 0;
     uint32_t m_minFPS = 0;
     uint32_t m_frameRenderTimeInMs = 0;
+    // Percentiles of render time of active frames.
+    uint32_t m_frameRenderTimeP50InMs = 0;
+    uint32_t m_frameRenderTimeP90InMs = 0;
+    uint32_t m_frameRenderTimeP99InMs = 0;
     std::map<uint32_t, float> m_fpsDistribution;
     uint32_t m_immediateRenderingFPS = 0;
     uint32_t m_immediateRenderingMinFPS = 0;
+
+    uint32_t m_overlayPlacingCount = 0;
+    uint32_t m_reusedOverlayPlacingCount = 0;
+    uint32_t m_overlayPlacingTimeInMcs = 0;
   };
 
+  void StartOverlayPlacing();
+  void EndOverlayPlacing(bool isPlacementReused);
+
   RenderStatistic GetRenderStatistic();
 #endif
 
@@ -55,6 +66,9 @@ public:
 
     uint32_t m_totalTilesCount = 0;
     uint32_t m_tileReadTimeInMs = 0;
+    uint32_t m_tileReadTimeP50InMs = 0;
+    uint32_t m_tileReadTimeP90InMs = 0;
+    uint32_t m_tileReadTimeP99InMs = 0;
   };
 
   void StartTileReading();
@@ -135,6 +149,24 @@ public:
 private:
   DrapeMeasurer() = default;
 
+  // Histogram of durations with 1 ms buckets. Durations longer than the last bucket
+  // are counted in it.
+  class DurationHistogram
+  {
+  public:
+    void Add(std::chrono::nanoseconds duration);
+    void Add(DurationHistogram const & histogram);
+    void Clear();
+    // |percentile| is in range [0, 100].
+    uint32_t GetPercentileInMs(uint32_t percentile) const;
+
+  private:
+    static uint32_t constexpr kMaxDurationInMs = 1000;
+
+    std::vector<uint32_t> m_counts;
+    uint64_t m_totalCount = 0;
+  };
+
   dp::ApiVersion m_apiVersion = dp::ApiVersion::Invalid;
   m2::PointU m_resolution;
   std::string m_gpuName;
@@ -159,6 +191,7 @@ private:
     std::chrono::time_point<std::chrono::steady_clock> m_startTileReadTime;
     std::chrono::nanoseconds m_totalTileReadTime;
     uint32_t m_totalTilesCount = 0;
+    DurationHistogram m_tileReadTimes;
   };
   std::map<threads::ThreadID, std::shared_ptr<TileReadInfo>> m_tilesReadInfo;
   std::mutex m_tilesMutex;
@@ -173,6 +206,15 @@ private:
   uint64_t m_realtimeSlowFramesCount = 0;
   m2::RectD m_realtimeRenderingBox;
 
+#ifdef RENDER_STATISTIC
+  DurationHistogram m_activeFrameRenderTimes;
+
+  std::chrono::time_point<std::chrono::steady_clock> m_startOverlayPlacingTime;
+  std::chrono::nanoseconds m_totalOverlayPlacingTime;
+  uint32_t m_overlayPlacingCount = 0;
+  uint32_t m_reusedOverlayPlacingCount = 0;
+#endif
+
 #if defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM)
   std::chrono::nanoseconds m_totalFrameRenderTime;
   uint32_t m_totalFramesCount = 0;
@@ -42,12 +42,29 @@ void EngineContext::BeginReadTile()
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto ptr = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_isShapesRecording)
+    m_recordedShapes.push_back({false /* isOverlay */, ptr});
+  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(ptr)));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto ptr = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_isShapesRecording)
+    m_recordedShapes.push_back({true /* isOverlay */, ptr});
+  PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(ptr)));
+}
+
+void EngineContext::FlushCachedShapes(ShapesPortions const & portions)
+{
+  for (auto const & portion : portions)
+  {
+    if (portion.m_isOverlay)
+      PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, portion.m_shapes));
+    else
+      PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, portion.m_shapes));
+  }
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
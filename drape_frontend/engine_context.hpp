@@ -2,6 +2,7 @@
 
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/threads_commutator.hpp"
 #include "drape_frontend/traffic_generator.hpp"
@@ -45,8 +46,14 @@ public:
   void Flush(TMapShapes && shapes);
   void FlushOverlays(TMapShapes && shapes);
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
+  // Posts shapes of a tile taken from TileShapesCache.
+  void FlushCachedShapes(ShapesPortions const & portions);
   void EndReadTile();
 
+  // When recording is on, flushed shapes are kept to be put into TileShapesCache.
+  void SetShapesRecording(bool enabled) { m_isShapesRecording = enabled; }
+  ShapesPortions TakeRecordedShapes() { return std::move(m_recordedShapes); }
+
 private:
   void PostMessage(drape_ptr<Message> && message);
 
@@ -58,5 +65,7 @@ private:
   bool m_3dBuildingsEnabled;
   bool m_trafficEnabled;
   bool m_isolinesEnabled;
+  bool m_isShapesRecording = false;
+  ShapesPortions m_recordedShapes;
 };
 }  // namespace df
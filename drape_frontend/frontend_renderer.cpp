@@ -57,6 +57,11 @@ double constexpr kVSyncInterval = 0.06;
 // Metal/Vulkan rendering is fast, so we can decrease sync inverval.
 double constexpr kVSyncIntervalMetalVulkan = 0.03;
 
+// Minimal frame times of the render loop.
+double constexpr kFollowingFrameTime = 1.0 / 30.0;
+double constexpr kPowerSavingFrameTime = 1.0 / 30.0;
+double constexpr kPowerSavingFollowingFrameTime = 1.0 / 20.0;
+
 std::string const kTransitBackgroundColor = "TransitBackground";
 
 template <typename ToDo>
@@ -266,13 +271,15 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::FlushTile:
     {
       ref_ptr<FlushRenderBucketMessage> msg = message;
-      dp::RenderState const & state = msg->GetState();
       TileKey const & key = msg->GetKey();
-      drape_ptr<dp::RenderBucket> bucket = msg->AcceptBuffer();
+      auto buckets = msg->AcceptBuckets();
       if (key.m_zoomLevel == GetCurrentZoom() && CheckTileGenerations(key))
       {
-        PrepareBucket(state, bucket);
-        AddToRenderGroup<RenderGroup>(state, std::move(bucket), key);
+        for (auto & [state, bucket] : buckets)
+        {
+          PrepareBucket(state, bucket);
+          AddToRenderGroup<RenderGroup>(state, std::move(bucket), key);
+        }
       }
       break;
     }
@@ -725,6 +732,13 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::Type::SetPowerSavingMode:
+    {
+      ref_ptr<SetPowerSavingModeMessage> const msg = message;
+      m_isPowerSavingMode = msg->IsEnabled();
+      break;
+    }
+
   case Message::Type::EnablePerspective:
     {
       AddUserEvent(make_unique_dp<SetAutoPerspectiveEvent>(true /* isAutoPerspective */));
@@ -1383,7 +1397,13 @@ void FrontendRenderer::EndUpdateOverlayTree()
 {
   if (m_overlayTree->IsNeedUpdate())
   {
+#ifdef RENDER_STATISTIC
+    DrapeMeasurer::Instance().StartOverlayPlacing();
+#endif
     m_overlayTree->EndOverlayPlacing();
+#ifdef RENDER_STATISTIC
+    DrapeMeasurer::Instance().EndOverlayPlacing(m_overlayTree->IsPlacementReused());
+#endif
 
     // Track overlays.
     if (m_overlaysTracker->StartTracking(GetCurrentZoom(),
@@ -1829,12 +1849,17 @@ void FrontendRenderer::RenderFrame()
   m_context->Present();
 #endif
 
-  // Limit fps in following mode.
-  double constexpr kFrameTime = 1.0 / 30.0;
+  // Limit fps in following mode and in power saving mode.
+  double minFrameTime = 0.0;
+  if (m_myPositionController->IsRouteFollowingActive())
+    minFrameTime = m_isPowerSavingMode ? kPowerSavingFollowingFrameTime : kFollowingFrameTime;
+  else if (m_isPowerSavingMode)
+    minFrameTime = kPowerSavingFrameTime;
+
   auto const ft = m_frameData.m_timer.ElapsedSeconds();
-  if (!canSuspend && ft < kFrameTime && m_myPositionController->IsRouteFollowingActive())
+  if (!canSuspend && ft < minFrameTime)
   {
-    auto const ms = static_cast<uint32_t>((kFrameTime - ft) * 1000);
+    auto const ms = static_cast<uint32_t>((minFrameTime - ft) * 1000);
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
   }
 
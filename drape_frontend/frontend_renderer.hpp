@@ -402,6 +402,7 @@ private:
   std::vector<PostprocessRenderer::Effect> m_enabledOnStartEffects;
 
   bool m_isDebugRectRenderingEnabled = false;
+  bool m_isPowerSavingMode = false;
   drape_ptr<DebugRectRenderer> m_debugRectRenderer;
 
   drape_ptr<ScenarioManager> m_scenarioManager;
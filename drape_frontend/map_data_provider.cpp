@@ -9,13 +9,16 @@ namespace df
 MapDataProvider::MapDataProvider(TReadIDsFn && idsReader,
                                  TReadFeaturesFn && featureReader,
                                  TIsCountryLoadedByNameFn && isCountryLoadedByNameFn,
-                                 TUpdateCurrentCountryFn && updateCurrentCountryFn)
+                                 TUpdateCurrentCountryFn && updateCurrentCountryFn,
+                                 TGetIsolinesMinAltClassFn && getIsolinesMinAltClassFn)
   : m_isCountryLoadedByName(std::move(isCountryLoadedByNameFn))
+  , m_getIsolinesMinAltClass(std::move(getIsolinesMinAltClassFn))
   , m_featureReader(std::move(featureReader))
   , m_idsReader(std::move(idsReader))
   , m_updateCurrentCountry(std::move(updateCurrentCountryFn))
 {
   CHECK(m_isCountryLoadedByName != nullptr, ());
+  CHECK(m_getIsolinesMinAltClass != nullptr, ());
   CHECK(m_featureReader != nullptr, ());
   CHECK(m_idsReader != nullptr, ());
   CHECK(m_updateCurrentCountry != nullptr, ());
@@ -3,8 +3,11 @@
 #include "storage/storage_defines.hpp"
 
 #include "indexer/feature.hpp"
+#include "indexer/mwm_set.hpp"
+
 #include "geometry/rect2d.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -22,11 +25,14 @@ public:
   using TIsCountryLoadedFn = std::function<bool(m2::PointD const &)>;
   using TIsCountryLoadedByNameFn = std::function<bool(std::string_view)>;
   using TUpdateCurrentCountryFn = std::function<void(m2::PointD const &, int)>;
+  // Returns the minimal altitude class of the isolines of the mwm which are drawn on the zoom.
+  using TGetIsolinesMinAltClassFn = std::function<int16_t(MwmSet::MwmId const &, int)>;
 
   MapDataProvider(TReadIDsFn && idsReader,
                   TReadFeaturesFn && featureReader,
                   TIsCountryLoadedByNameFn && isCountryLoadedByNameFn,
-                  TUpdateCurrentCountryFn && updateCurrentCountryFn);
+                  TUpdateCurrentCountryFn && updateCurrentCountryFn,
+                  TGetIsolinesMinAltClassFn && getIsolinesMinAltClassFn);
 
   void ReadFeaturesID(TReadCallback<FeatureID const> const & fn, m2::RectD const & r,
                       int scale) const;
@@ -35,6 +41,7 @@ public:
   TUpdateCurrentCountryFn const & UpdateCurrentCountryFn() const;
 
   TIsCountryLoadedByNameFn m_isCountryLoadedByName;
+  TGetIsolinesMinAltClassFn m_getIsolinesMinAltClass;
 
 private:
   TReadFeaturesFn m_featureReader;
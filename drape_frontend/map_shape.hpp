@@ -8,6 +8,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace dp
@@ -81,22 +82,23 @@ public:
 class MapShapeReadedMessage : public MapShapeMessage
 {
 public:
-  MapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
+  // Shapes are shared, because they may be kept in TileShapesCache after batching.
+  MapShapeReadedMessage(TileKey const & key, std::shared_ptr<TMapShapes const> shapes)
     : MapShapeMessage(key), m_shapes(std::move(shapes))
   {}
 
   Type GetType() const override { return Type::MapShapeReaded; }
   bool IsGraphicsContextDependent() const override { return true; }
-  TMapShapes const & GetShapes() { return m_shapes; }
+  TMapShapes const & GetShapes() { return *m_shapes; }
 
 private:
-  TMapShapes m_shapes;
+  std::shared_ptr<TMapShapes const> m_shapes;
 };
 
 class OverlayMapShapeReadedMessage : public MapShapeReadedMessage
 {
 public:
-  OverlayMapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
+  OverlayMapShapeReadedMessage(TileKey const & key, std::shared_ptr<TMapShapes const> shapes)
     : MapShapeReadedMessage(key, std::move(shapes))
   {}
 
@@ -92,6 +92,7 @@ std::string DebugPrint(Message::Type msgType)
   case Message::Type::EnableDebugRectRendering: return "EnableDebugRectRendering";
   case Message::Type::EnableTransitScheme: return "EnableTransitScheme";
   case Message::Type::UpdateTransitScheme: return "UpdateTransitScheme";
+  case Message::Type::ApplyTransitScheme: return "ApplyTransitScheme";
   case Message::Type::ClearTransitSchemeData: return "ClearTransitSchemeData";
   case Message::Type::ClearAllTransitSchemeData: return "ClearAllTransitSchemeData";
   case Message::Type::RegenerateTransitScheme: return "RegenerateTransitScheme";
@@ -102,6 +103,7 @@ std::string DebugPrint(Message::Type msgType)
   case Message::Type::EnableIsolines: return "EnableIsolines";
   case Message::Type::OnEnterBackground: return "OnEnterBackground";
   case Message::Type::Arrow3dRecache: return "Arrow3dRecache";
+  case Message::Type::SetPowerSavingMode: return "SetPowerSavingMode";
   }
   ASSERT(false, ("Unknown message type."));
   return "Unknown type";
@@ -93,6 +93,7 @@ public:
     EnableDebugRectRendering,
     EnableTransitScheme,
     UpdateTransitScheme,
+    ApplyTransitScheme,
     ClearTransitSchemeData,
     ClearAllTransitSchemeData,
     RegenerateTransitScheme,
@@ -102,7 +103,8 @@ public:
     NotifyGraphicsReady,
     EnableIsolines,
     OnEnterBackground,
-    Arrow3dRecache
+    Arrow3dRecache,
+    SetPowerSavingMode
   };
 
   virtual ~Message() = default;
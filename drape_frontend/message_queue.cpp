@@ -5,8 +5,14 @@
 
 namespace df
 {
+namespace
+{
+size_t constexpr kInboxCapacity = 1024;
+}  // namespace
+
 MessageQueue::MessageQueue()
   : m_isWaiting(false)
+  , m_inbox(kInboxCapacity)
 {}
 
 MessageQueue::~MessageQueue()
@@ -18,11 +24,18 @@ MessageQueue::~MessageQueue()
 drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
+  DrainInboxImpl();
   if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
   {
     m_isWaiting = true;
-    m_condition.wait(lock, [this]() { return !m_isWaiting; });
+    // A message which is pushed before |m_isWaiting| is set doesn't wake us, so the inbox is
+    // checked again.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    DrainInboxImpl();
+    if (m_messages.empty() && m_lowPriorityMessages.empty())
+      m_condition.wait(lock, [this]() { return !m_isWaiting; });
     m_isWaiting = false;
+    DrainInboxImpl();
   }
 
   drape_ptr<Message> msg;
@@ -41,11 +54,38 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
+  TMessageNode node(std::move(message), priority);
+  if (m_inbox.TryPush(std::move(node)))
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_isWaiting)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      CancelWaitImpl();
+    }
+    return;
+  }
+
+  // The inbox is full. It's drained first to keep the order of messages.
   std::lock_guard<std::mutex> lock(m_mutex);
+  DrainInboxImpl();
+  if (m_filter == nullptr || !m_filter(make_ref(node.first)))
+    PushMessageImpl(std::move(node.first), node.second);
+  CancelWaitImpl();
+}
 
-  if (m_filter != nullptr && m_filter(make_ref(message)))
-    return;
+void MessageQueue::DrainInboxImpl()
+{
+  TMessageNode node;
+  while (m_inbox.TryPop(node))
+  {
+    if (m_filter == nullptr || !m_filter(make_ref(node.first)))
+      PushMessageImpl(std::move(node.first), node.second);
+  }
+}
 
+void MessageQueue::PushMessageImpl(drape_ptr<Message> && message, MessagePriority priority)
+{
   switch (priority)
   {
   case MessagePriority::Normal:
@@ -86,8 +126,6 @@ void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority pr
   default:
     ASSERT(false, ("Unknown message priority type"));
   }
-
-  CancelWaitImpl();
 }
 
 void MessageQueue::FilterMessagesImpl()
@@ -114,6 +152,7 @@ void MessageQueue::FilterMessagesImpl()
 void MessageQueue::EnableMessageFiltering(FilterMessageFn && filter)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
+  DrainInboxImpl();
   m_filter = std::move(filter);
   FilterMessagesImpl();
 }
@@ -121,6 +160,8 @@ void MessageQueue::EnableMessageFiltering(FilterMessageFn && filter)
 void MessageQueue::DisableMessageFiltering()
 {
   std::lock_guard<std::mutex> lock(m_mutex);
+  // Messages which are pushed while the filter is enabled are filtered.
+  DrainInboxImpl();
   m_filter = nullptr;
 }
 
@@ -128,6 +169,7 @@ void MessageQueue::InstantFilter(FilterMessageFn && filter)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
   CHECK(m_filter == nullptr, ());
+  DrainInboxImpl();
   m_filter = std::move(filter);
   FilterMessagesImpl();
   m_filter = nullptr;
@@ -137,13 +179,13 @@ void MessageQueue::InstantFilter(FilterMessageFn && filter)
 bool MessageQueue::IsEmpty() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.empty() && m_lowPriorityMessages.empty();
+  return m_messages.empty() && m_lowPriorityMessages.empty() && m_inbox.Empty();
 }
 
 size_t MessageQueue::GetSize() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.size() + m_lowPriorityMessages.size();
+  return m_messages.size() + m_lowPriorityMessages.size() + m_inbox.Size();
 }
 #endif
 
@@ -164,6 +206,9 @@ void MessageQueue::CancelWaitImpl()
 
 void MessageQueue::ClearQuery()
 {
+  TMessageNode node;
+  while (m_inbox.TryPop(node))
+    node.first.reset();
   m_messages.clear();
   m_lowPriorityMessages.clear();
 }
@@ -5,6 +5,9 @@
 #include "drape/drape_diagnostics.hpp"
 #include "drape/pointers.hpp"
 
+#include "base/mpmc_queue.hpp"
+
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -35,13 +38,21 @@ public:
 #endif
 
 private:
+  using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
+
+  void PushMessageImpl(drape_ptr<Message> && message, MessagePriority priority);
+  void DrainInboxImpl();
   void FilterMessagesImpl();
   void CancelWaitImpl();
 
   mutable std::mutex m_mutex;
   std::condition_variable m_condition;
-  bool m_isWaiting;
-  using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
+  std::atomic<bool> m_isWaiting;
+  // Messages are pushed to the lock-free inbox, so posting threads don't contend for |m_mutex|
+  // with each other and with the renderer. The renderer moves them to the priority queues
+  // below. The mutex is taken by a posting thread only when the renderer waits or the inbox is
+  // full.
+  threads::MpmcQueue<TMessageNode> m_inbox;
   std::deque<TMessageNode> m_messages;
   std::deque<drape_ptr<Message>> m_lowPriorityMessages;
   FilterMessageFn m_filter;
@@ -122,26 +122,25 @@ private:
   bool m_forceUpdateUserMarks;
 };
 
+// Buckets of a tile which are flushed by its batchers since the last message.
 class FlushRenderBucketMessage : public BaseTileMessage
 {
 public:
-  FlushRenderBucketMessage(TileKey const & key, dp::RenderState const & state,
-                           drape_ptr<dp::RenderBucket> && buffer)
+  using Buckets = std::vector<std::pair<dp::RenderState, drape_ptr<dp::RenderBucket>>>;
+
+  FlushRenderBucketMessage(TileKey const & key, Buckets && buckets)
     : BaseTileMessage(key)
-    , m_state(state)
-    , m_buffer(std::move(buffer))
+    , m_buckets(std::move(buckets))
   {}
 
   Type GetType() const override { return Type::FlushTile; }
   bool IsGraphicsContextDependent() const override { return true; }
   bool ContainsRenderState() const override { return true; }
 
-  dp::RenderState const & GetState() const { return m_state; }
-  drape_ptr<dp::RenderBucket> && AcceptBuffer() { return std::move(m_buffer); }
+  Buckets && AcceptBuckets() { return std::move(m_buckets); }
 
 private:
-  dp::RenderState m_state;
-  drape_ptr<dp::RenderBucket> m_buffer;
+  Buckets m_buckets;
 };
 
 template <typename RenderDataType, Message::Type MessageType>
@@ -880,6 +879,21 @@ private:
   bool const m_allowAutoZoom;
 };
 
+class SetPowerSavingModeMessage : public Message
+{
+public:
+  explicit SetPowerSavingModeMessage(bool enabled)
+    : m_enabled(enabled)
+  {}
+
+  Type GetType() const override { return Type::SetPowerSavingMode; }
+
+  bool IsEnabled() const { return m_enabled; }
+
+private:
+  bool const m_enabled;
+};
+
 class Allow3dBuildingsMessage : public Message
 {
 public:
@@ -1182,12 +1196,30 @@ public:
 
   Type GetType() const override { return Type::UpdateTransitScheme; }
 
-  TransitDisplayInfos const & GetTransitDisplayInfos() const { return m_transitInfos; }
+  TransitDisplayInfos && AcceptTransitDisplayInfos() { return std::move(m_transitInfos); }
 
 private:
   TransitDisplayInfos m_transitInfos;
 };
 
+class ApplyTransitSchemeMessage : public Message
+{
+public:
+  explicit ApplyTransitSchemeMessage(TransitSchemeBuilder::PreparedScheme && preparedScheme)
+    : m_preparedScheme(std::move(preparedScheme))
+  {}
+
+  Type GetType() const override { return Type::ApplyTransitScheme; }
+
+  TransitSchemeBuilder::PreparedScheme && AcceptPreparedScheme()
+  {
+    return std::move(m_preparedScheme);
+  }
+
+private:
+  TransitSchemeBuilder::PreparedScheme m_preparedScheme;
+};
+
 class RegenerateTransitMessage : public Message
 {
 public:
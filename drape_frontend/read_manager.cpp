@@ -3,6 +3,8 @@
 #include "drape_frontend/metaline_manager.hpp"
 #include "drape_frontend/visual_params.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/buffer_vector.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -13,6 +15,10 @@ namespace df
 {
 namespace
 {
+uint8_t constexpr kMinReadingThreadsCount = 2;
+uint8_t constexpr kMaxReadingThreadsCount = 4;
+uint8_t constexpr kLowBatteryLevel = 20;
+
 struct LessCoverageCell
 {
   bool operator()(std::shared_ptr<TileInfo> const & l,
@@ -35,6 +41,21 @@ struct LessCoverageCell
 };
 }  // namespace
 
+uint8_t GetReadingThreadsCount()
+{
+  // Leave a half of the cores for the render threads and the UI.
+  auto const count = std::clamp(GetPlatform().CpuCores() / 2,
+                                static_cast<unsigned>(kMinReadingThreadsCount),
+                                static_cast<unsigned>(kMaxReadingThreadsCount));
+  if (count > kMinReadingThreadsCount &&
+      Platform::GetChargingStatus() == Platform::ChargingStatus::Unplugged &&
+      Platform::GetBatteryLevel() <= kLowBatteryLevel)
+  {
+    return kMinReadingThreadsCount;
+  }
+  return static_cast<uint8_t>(count);
+}
+
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
                                              std::shared_ptr<TileInfo> const & r) const
 {
@@ -42,7 +63,8 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 }
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-                         bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled)
+                         bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled,
+                         size_t shapesCacheSize)
   : m_commutator(commutator)
   , m_model(model)
   , m_have3dBuildings(false)
@@ -55,6 +77,8 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_generationCounter(0)
   , m_userMarksGenerationCounter(0)
 {
+  if (shapesCacheSize != 0)
+    m_shapesCache = make_unique_dp<TileShapesCache>(shapesCacheSize);
   Start();
 }
 
@@ -65,7 +89,7 @@ void ReadManager::Start()
 
   ASSERT_EQUAL(m_counter, 0, ());
 
-  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(kReadingThreadsCount,
+  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(GetReadingThreadsCount(),
                               std::bind(&ReadManager::OnTaskFinished, this, std::placeholders::_1));
 }
 
@@ -135,6 +159,10 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
+    // Tiles are styled differently after the mode change. Forced updates come when
+    // the style, metalines or custom features are changed.
+    if (m_modeChanged || forceUpdate)
+      ClearShapesCache();
     m_modeChanged = false;
 
     for (auto const & info : m_tileInfos)
@@ -145,8 +173,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasksForTileKeys(screen, tiles, texMng, metalineMng);
   }
   else
   {
@@ -177,8 +204,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
 
-    for (auto const & tileKey : newTiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasksForTileKeys(screen, newTiles, texMng, metalineMng);
   }
 
   m_currentViewport = screen;
@@ -198,6 +224,12 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
     CancelTileInfo(info);
     m_tileInfos.erase(info);
   }
+
+  if (m_shapesCache != nullptr)
+  {
+    for (auto const & key : keyStorage)
+      m_shapesCache->Erase(key);
+  }
 }
 
 void ReadManager::InvalidateAll()
@@ -205,6 +237,7 @@ void ReadManager::InvalidateAll()
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
+  ClearShapesCache();
 
   m_modeChanged = true;
 }
@@ -226,6 +259,26 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
   return (oldScale != newScale) || !m_currentViewport.GlobalRect().IsIntersect(screen.GlobalRect());
 }
 
+template <typename Tiles>
+void ReadManager::PushTasksForTileKeys(ScreenBase const & screen, Tiles const & tiles,
+                                       ref_ptr<dp::TextureManager> texMng,
+                                       ref_ptr<MetalineManager> metalineMng)
+{
+  // Tasks are read in FIFO order, cancelled tasks of the previous coverage are skipped
+  // by the pool. So the center of the screen is filled first while the user scrolls.
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  buffer_vector<std::pair<double, TileKey>, 8> orderedTiles;
+  orderedTiles.reserve(tiles.size());
+  for (auto const & tileKey : tiles)
+    orderedTiles.emplace_back(tileKey.GetGlobalRect().Center().SquaredLength(center), tileKey);
+
+  std::sort(orderedTiles.begin(), orderedTiles.end(),
+            [](auto const & l, auto const & r) { return l.first < r.first; });
+
+  for (auto const & tile : orderedTiles)
+    PushTaskBackForTileKey(tile.second, texMng, metalineMng);
+}
+
 void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<dp::TextureManager> texMng,
                                          ref_ptr<MetalineManager> metalineMng)
@@ -237,7 +290,8 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                                m_customFeaturesContext,
                                                m_have3dBuildings && m_allow3dBuildings,
                                                m_trafficEnabled, m_isolinesEnabled);
-  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
+  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context),
+                                                                 make_ref(m_shapesCache));
   m_tileInfos.insert(tileInfo);
 
   /// @todo Do we really need ReadMWMTask pool? Avoid "new" with hand-written bicycle? ;)
@@ -302,6 +356,12 @@ void ReadManager::ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear)
   m_tileInfos.erase(tileToClear);
 }
 
+void ReadManager::ClearShapesCache()
+{
+  if (m_shapesCache != nullptr)
+    m_shapesCache->Clear();
+}
+
 void ReadManager::IncreaseCounter(size_t value)
 {
   if (value == 0)
@@ -343,6 +403,7 @@ void ReadManager::SetIsolinesEnabled(bool isolinesEnabled)
 void ReadManager::SetCustomFeatures(CustomFeatures && ids)
 {
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
+  ClearShapesCache();
 }
 
 std::vector<FeatureID> ReadManager::GetCustomFeaturesArray() const
@@ -371,6 +432,7 @@ bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(features));
+  ClearShapesCache();
   return true;
 }
 
@@ -380,6 +442,7 @@ bool ReadManager::RemoveAllCustomFeatures()
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(CustomFeatures());
+  ClearShapesCache();
   return true;
 }
 
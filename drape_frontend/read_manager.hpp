@@ -3,6 +3,7 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -27,13 +28,17 @@ namespace df
 class MapDataProvider;
 class MetalineManager;
 
-uint8_t constexpr kReadingThreadsCount = 2;
+// Returns the number of threads which read tiles. It depends on the number of cores and
+// is minimal when the device runs on a low battery.
+uint8_t GetReadingThreadsCount();
 
 class ReadManager
 {
 public:
+  // Shapes of at most |shapesCacheSize| tiles are cached, the cache is disabled if it's 0.
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-              bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled);
+              bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled,
+              size_t shapesCacheSize = 0);
 
   void Start();
   void Stop();
@@ -67,6 +72,12 @@ private:
   void OnTaskFinished(threads::IRoutine * task);
   bool MustDropAllTiles(ScreenBase const & screen) const;
 
+  // Pushes tasks for |tiles| so that tiles which are closer to the center of |screen|
+  // are read first.
+  template <typename Tiles>
+  void PushTasksForTileKeys(ScreenBase const & screen, Tiles const & tiles,
+                            ref_ptr<dp::TextureManager> texMng,
+                            ref_ptr<MetalineManager> metalineMng);
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
 
@@ -74,6 +85,9 @@ private:
 
   MapDataProvider & m_model;
 
+  // Declared before the pool to outlive reading tasks.
+  drape_ptr<TileShapesCache> m_shapesCache;
+
   drape_ptr<base::thread_pool::routine::ThreadPool> m_pool;
 
   ScreenBase m_currentViewport;
@@ -104,6 +118,7 @@ private:
 
   CustomFeaturesContextPtr m_customFeaturesContext;
 
+  void ClearShapesCache();
   void CancelTileInfo(std::shared_ptr<TileInfo> const & tileToCancel);
   void ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear);
   void IncreaseCounter(size_t value);
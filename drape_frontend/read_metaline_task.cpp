@@ -9,6 +9,8 @@
 #include "coding/reader_wrapper.hpp"
 #include "coding/varint.hpp"
 
+#include "base/stl_helpers.hpp"
+
 #include "defines.hpp"
 
 #include <algorithm>
@@ -58,14 +60,17 @@ std::vector<MetalineData> ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
   }
 }
 
+// Reads the points of the features of all |metalines| at once.
 std::map<FeatureID, std::vector<m2::PointD>> ReadPoints(df::MapDataProvider & model,
-                                                        MetalineData const & metaline)
+                                                        std::vector<MetalineData> const & metalines)
 {
-  auto features = metaline.m_features;
-  std::sort(features.begin(), features.end());
+  std::vector<FeatureID> features;
+  for (auto const & metaline : metalines)
+    features.insert(features.end(), metaline.m_features.cbegin(), metaline.m_features.cend());
+  base::SortUnique(features);
 
   std::map<FeatureID, std::vector<m2::PointD>> result;
-  model.ReadFeatures([&metaline, &result](FeatureType & ft)
+  model.ReadFeatures([&result](FeatureType & ft)
   {
     ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
     size_t const count = ft.GetPointsCount();
@@ -81,41 +86,44 @@ std::map<FeatureID, std::vector<m2::PointD>> ReadPoints(df::MapDataProvider & mo
         featurePoints.push_back(pt);
     }
 
-    if (metaline.m_reversed.find(ft.GetID()) != metaline.m_reversed.cend())
-      std::reverse(featurePoints.begin(), featurePoints.end());
-
     result.emplace(ft.GetID(), std::move(featurePoints));
   }, features);
 
   return result;
 }
 
-std::vector<m2::PointD> MergePoints(std::map<FeatureID, std::vector<m2::PointD>> && points,
-                                    std::vector<FeatureID> const & featuresOrder)
+std::vector<m2::PointD> MergePoints(std::map<FeatureID, std::vector<m2::PointD>> const & points,
+                                    MetalineData const & metaline)
 {
-  if (points.size() == 1)
-    return std::move(points.begin()->second);
-
   size_t sz = 0;
-  for (auto const & p : points)
-    sz += p.second.size();
+  for (auto const & f : metaline.m_features)
+  {
+    auto const it = points.find(f);
+    if (it == points.cend())
+    {
+      ASSERT(false, (f));
+      return {};
+    }
+    sz += it->second.size();
+  }
 
   std::vector<m2::PointD> result;
   result.reserve(sz);
-  for (auto const & f : featuresOrder)
+  for (auto const & f : metaline.m_features)
   {
-    auto const it = points.find(f);
-    ASSERT(it != points.cend(), ());
-
-    if (!result.empty())
+    auto const & featurePoints = points.find(f)->second;
+    bool const reversed = metaline.m_reversed.find(f) != metaline.m_reversed.cend();
+    auto const append = [&result](auto begin, auto end)
     {
-      auto iBeg = it->second.begin();
-      if (result.back().EqualDxDy(*iBeg, kMwmPointAccuracy))
-        ++iBeg;
-      result.insert(result.end(), iBeg, it->second.end());
-    }
+      if (!result.empty() && begin != end && result.back().EqualDxDy(*begin, kMwmPointAccuracy))
+        ++begin;
+      result.insert(result.end(), begin, end);
+    };
+
+    if (reversed)
+      append(featurePoints.crbegin(), featurePoints.crend());
     else
-      result = std::move(it->second);
+      append(featurePoints.cbegin(), featurePoints.cend());
   }
 
   return result;
@@ -133,6 +141,10 @@ ReadMetalineTask::ReadMetalineTask(MapDataProvider & model, MwmSet::MwmId const
 void ReadMetalineTask::Run()
 {
   auto metalines = ReadMetalinesFromFile(m_mwmId);
+  if (metalines.empty())
+    return;
+
+  auto const points = ReadPoints(m_model, metalines);
   for (auto & metaline : metalines)
   {
     if (m_isCancelled)
@@ -150,7 +162,7 @@ void ReadMetalineTask::Run()
     if (failed)
       continue;
 
-    auto mergedPoints = MergePoints(ReadPoints(m_model, metaline), metaline.m_features);
+    auto mergedPoints = MergePoints(points, metaline);
     if (mergedPoints.size() < 2)
       continue;
 
@@ -448,7 +448,15 @@ void RouteRenderer::RenderSubroute(ref_ptr<dp::GraphicsContext> context, ref_ptr
     dist = static_cast<float>(m_distanceFromBegin - distanceOffset);
   }
 
-  dp::RenderState const & state = subrouteData->m_renderProperty.m_state;
+  // Simplified geometry is not used in following mode, since its lengths along the route differ
+  // slightly from the distance used to hide the passed part of the route.
+  bool const useSimplifiedGeometry = !m_followingEnabled &&
+                                     !subrouteData->m_simplifiedRenderProperty.m_buckets.empty() &&
+                                     GetZoomLevel(screen.GetScale()) < kSimplifiedRouteMaxZoomLevel;
+  auto const & renderProperty = useSimplifiedGeometry ? subrouteData->m_simplifiedRenderProperty
+                                                      : subrouteData->m_renderProperty;
+
+  dp::RenderState const & state = renderProperty.m_state;
   size_t const styleIndex = subrouteData->m_styleIndex;
   ASSERT_LESS(styleIndex, subrouteInfo.m_subroute->m_style.size(), ());
   auto const & style = subrouteInfo.m_subroute->m_style[styleIndex];
@@ -487,12 +495,11 @@ void RouteRenderer::RenderSubroute(ref_ptr<dp::GraphicsContext> context, ref_ptr
 
   // Render buckets.
   auto const & clipRect = screen.ClipRect();
-  CHECK_EQUAL(subrouteData->m_renderProperty.m_buckets.size(),
-              subrouteData->m_renderProperty.m_boundingBoxes.size(), ());
-  for (size_t i = 0; i < subrouteData->m_renderProperty.m_buckets.size(); ++i)
+  CHECK_EQUAL(renderProperty.m_buckets.size(), renderProperty.m_boundingBoxes.size(), ());
+  for (size_t i = 0; i < renderProperty.m_buckets.size(); ++i)
   {
-    if (subrouteData->m_renderProperty.m_boundingBoxes[i].IsIntersect(clipRect))
-      subrouteData->m_renderProperty.m_buckets[i]->Render(context, state.GetDrawAsLine());
+    if (renderProperty.m_boundingBoxes[i].IsIntersect(clipRect))
+      renderProperty.m_buckets[i]->Render(context, state.GetDrawAsLine());
   }
 }
 
@@ -654,6 +661,7 @@ void RouteRenderer::AddSubrouteData(ref_ptr<dp::GraphicsContext> context,
 
     it->m_subrouteData.push_back(std::move(subrouteData));
     BuildBuckets(context, it->m_subrouteData.back()->m_renderProperty, mng);
+    BuildBuckets(context, it->m_subrouteData.back()->m_simplifiedRenderProperty, mng);
   }
   else
   {
@@ -664,6 +672,7 @@ void RouteRenderer::AddSubrouteData(ref_ptr<dp::GraphicsContext> context,
     info.m_length = subrouteData->m_subroute->m_polyline.GetLength();
     info.m_subrouteData.push_back(std::move(subrouteData));
     BuildBuckets(context, info.m_subrouteData.back()->m_renderProperty, mng);
+    BuildBuckets(context, info.m_subrouteData.back()->m_simplifiedRenderProperty, mng);
     m_subroutes.push_back(std::move(info));
 
     std::sort(m_subroutes.begin(), m_subroutes.end(),
@@ -15,10 +15,14 @@
 #include "drape/texture_manager.hpp"
 
 #include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/simplification.hpp"
 
 #include "base/logging.hpp"
 #include "base/math.hpp"
 
+#include <numeric>
+
 namespace df
 {
 std::array<float, 20> const kRouteHalfWidthInPixelCar =
@@ -56,6 +60,9 @@ float const kMarkersDepth = 100.0f;
 float const kArrowsDepth = 200.0f;
 float const kDepthPerSubroute = 200.0f;
 
+size_t const kMinPointsCountToSimplify = 500;
+double const kSimplificationEpsilonInPixels = 0.5;
+
 void GetArrowTextureRegion(ref_ptr<dp::TextureManager> textures,
                            dp::TextureManager::SymbolRegion & region)
 {
@@ -111,6 +118,56 @@ std::vector<m2::PointD> CalculatePoints(m2::PolylineD const & polyline,
   return result;
 }
 
+// Simplifies |path| by Douglas-Peucker algorithm. Every run of segments of the same color is
+// simplified separately, so borders between colors are preserved.
+void SimplifyPath(std::vector<m2::PointD> const & path, std::vector<glsl::vec4> const & segmentsColors,
+                  double epsilon, std::vector<m2::PointD> & simplifiedPath,
+                  std::vector<glsl::vec4> & simplifiedColors)
+{
+  simplifiedPath.clear();
+  simplifiedColors.clear();
+  if (path.size() < 2)
+    return;
+
+  std::vector<size_t> indices(path.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  m2::SquaredDistanceFromSegmentToPoint const squaredDistance;
+  auto const distFn = [&path, &squaredDistance](size_t a, size_t b, size_t x)
+  {
+    return squaredDistance(path[a], path[b], path[x]);
+  };
+
+  std::vector<size_t> result;
+  auto const outFn = [&result](size_t index)
+  {
+    if (result.empty() || result.back() != index)
+      result.push_back(index);
+  };
+
+  size_t runStart = 0;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    bool const isLastPoint = i + 1 == path.size();
+    if (!isLastPoint && (segmentsColors.empty() || segmentsColors[i] == segmentsColors[i - 1]))
+      continue;
+
+    SimplifyDP(indices.begin() + runStart, indices.begin() + i + 1, epsilon * epsilon, distFn, outFn);
+    runStart = i;
+  }
+
+  simplifiedPath.reserve(result.size());
+  for (auto const index : result)
+    simplifiedPath.push_back(path[index]);
+
+  if (!segmentsColors.empty())
+  {
+    simplifiedColors.reserve(result.size() - 1);
+    for (size_t i = 0; i + 1 < result.size(); ++i)
+      simplifiedColors.push_back(segmentsColors[result[i]]);
+  }
+}
+
 float SideByNormal(glsl::vec2 const & normal, bool isLeft)
 {
   float const kEps = 1e-5;
@@ -587,26 +644,43 @@ drape_ptr<df::SubrouteData> RouteShape::CacheRoute(ref_ptr<dp::GraphicsContext>
   subrouteData->m_recacheId = recacheId;
   subrouteData->m_distanceOffset = subroute->m_polyline.GetLength(startIndex);
 
-  std::vector<GeometryBufferData<GeometryBuffer>> geometryBufferData;
-  PrepareGeometry(points, subrouteData->m_pivot, segmentsColors,
-                  static_cast<float>(subroute->m_baseDepthIndex * rs::kDepthPerSubroute),
-                  geometryBufferData);
-
   auto state = CreateRenderState(subroute->m_style[styleIndex].m_pattern.m_isDashed ?
                                  gpu::Program::RouteDash : gpu::Program::Route, DepthLayer::GeometryLayer);
   state.SetColorTexture(textures->GetSymbolsTexture());
 
-  for (auto & data : geometryBufferData)
+  auto const baseDepth = static_cast<float>(subroute->m_baseDepthIndex * rs::kDepthPerSubroute);
+  auto const cacheGeometry = [&](std::vector<m2::PointD> const & path,
+                                 std::vector<glsl::vec4> const & colors,
+                                 RouteRenderProperty & property)
   {
-    data.m_boundingBox.Scale(kBoundingBoxScale);
-    BatchGeometry(context, state, make_ref(data.m_geometry.data()),
-                  static_cast<uint32_t>(data.m_geometry.size()),
-                  make_ref(data.m_joinsGeometry.data()),
-                  static_cast<uint32_t>(data.m_joinsGeometry.size()),
-                  data.m_boundingBox, RV::GetBindingInfo(),
-                  subrouteData->m_renderProperty);
-  }
+    std::vector<GeometryBufferData<GeometryBuffer>> geometryBufferData;
+    PrepareGeometry(path, subrouteData->m_pivot, colors, baseDepth, geometryBufferData);
 
+    for (auto & data : geometryBufferData)
+    {
+      data.m_boundingBox.Scale(kBoundingBoxScale);
+      BatchGeometry(context, state, make_ref(data.m_geometry.data()),
+                    static_cast<uint32_t>(data.m_geometry.size()),
+                    make_ref(data.m_joinsGeometry.data()),
+                    static_cast<uint32_t>(data.m_joinsGeometry.size()),
+                    data.m_boundingBox, RV::GetBindingInfo(), property);
+    }
+  };
+
+  cacheGeometry(points, segmentsColors, subrouteData->m_renderProperty);
+
+  // Long routes are also cached in a simplified form to be rendered on small scales, where
+  // most of the route points are closer to each other than a pixel.
+  if (points.size() >= rs::kMinPointsCountToSimplify)
+  {
+    double const epsilon = rs::kSimplificationEpsilonInPixels *
+                           GetScreenScale(kSimplifiedRouteMaxZoomLevel);
+    std::vector<m2::PointD> simplifiedPoints;
+    std::vector<glsl::vec4> simplifiedColors;
+    rs::SimplifyPath(points, segmentsColors, epsilon, simplifiedPoints, simplifiedColors);
+    if (simplifiedPoints.size() * 2 <= points.size())
+      cacheGeometry(simplifiedPoints, simplifiedColors, subrouteData->m_simplifiedRenderProperty);
+  }
 
   return subrouteData;
 }
@@ -40,6 +40,9 @@ extern std::array<float, 20> const kRouteHalfWidthInPixelCar;
 extern std::array<float, 20> const kRouteHalfWidthInPixelTransit;
 extern std::array<float, 20> const kRouteHalfWidthInPixelOthers;
 
+// Simplified geometry of a long route is rendered on zoom levels less than this one.
+int const kSimplifiedRouteMaxZoomLevel = 13;
+
 enum class RouteType : uint8_t
 {
   Car,
@@ -183,6 +186,8 @@ struct SubrouteData : public BaseSubrouteData
   size_t m_endPointIndex = 0;
   size_t m_styleIndex = 0;
   double m_distanceOffset = 0.0;
+  // It's empty if the route is too short to be simplified.
+  RouteRenderProperty m_simplifiedRenderProperty;
 };
 
 struct SubrouteArrowsData : public BaseSubrouteData {};
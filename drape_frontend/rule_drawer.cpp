@@ -11,6 +11,7 @@
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/ftypes_matcher.hpp"
+#include "indexer/isolines_info.hpp"
 #include "indexer/scales.hpp"
 
 #include "geometry/clipping.hpp"
@@ -158,14 +159,17 @@ void ExtractTrafficGeometry(FeatureType const & f, df::RoadClass const & roadCla
 
 RuleDrawer::RuleDrawer(TCheckCancelledCallback const & checkCancelled,
                        TIsCountryLoadedByNameFn const & isLoadedFn,
+                       TGetIsolinesMinAltClassFn const & getIsolinesMinAltClassFn,
                        ref_ptr<EngineContext> engineContext, int8_t deviceLang)
   : m_checkCancelled(checkCancelled)
   , m_isLoadedFn(isLoadedFn)
+  , m_getIsolinesMinAltClassFn(getIsolinesMinAltClassFn)
   , m_context(engineContext)
   , m_customFeaturesContext(engineContext->GetCustomFeaturesContext().lock())
   , m_deviceLang(deviceLang)
 {
   ASSERT(m_checkCancelled != nullptr, ());
+  ASSERT(m_getIsolinesMinAltClassFn != nullptr, ());
 
   auto const & tileKey = m_context->GetTileKey();
   m_globalRect = tileKey.GetGlobalRect();
@@ -388,6 +392,25 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s, TInsertSha
   }
 }
 
+bool RuleDrawer::IsIsolineFiltered(FeatureType & f, feature::TypesHolder const & types)
+{
+  if (!m_context->IsolinesEnabled())
+    return true;
+
+  // Dense isolines are skipped on the zooms where their lines would merge, so their
+  // geometry is not read at all.
+  auto const & mwmId = f.GetID().m_mwmId;
+  auto it = m_isolinesMinAltClasses.find(mwmId);
+  if (it == m_isolinesMinAltClasses.end())
+  {
+    auto const minAltClass = m_getIsolinesMinAltClassFn(mwmId, m_zoomLevel);
+    it = m_isolinesMinAltClasses.emplace(mwmId, minAltClass).first;
+  }
+
+  auto const altClass = isolines::GetAltClass(types);
+  return altClass != 0 && altClass < it->second;
+}
+
 void RuleDrawer::ProcessPointStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape)
 {
   if (IsDiscardCustomFeature(f.GetID()))
@@ -403,15 +426,21 @@ void RuleDrawer::operator()(FeatureType & f)
   if (CheckCancelled())
     return;
 
+  // Cheap checks which reject the feature must not decode its geometry or metadata.
+  f.SetAllowedParts(FeatureType::PART_COMMON);
+
   feature::TypesHolder const types(f);
-  if ((!m_context->IsolinesEnabled() && ftypes::IsIsolineChecker::Instance()(types)) ||
-      (!m_context->Is3dBuildingsEnabled() && ftypes::IsBuildingPartChecker::Instance()(types) &&
-       !ftypes::IsBuildingChecker::Instance()(types)))
+  if (!m_context->Is3dBuildingsEnabled() && ftypes::IsBuildingPartChecker::Instance()(types) &&
+      !ftypes::IsBuildingChecker::Instance()(types))
+    return;
+
+  if (ftypes::IsIsolineChecker::Instance()(types) && IsIsolineFiltered(f, types))
     return;
 
   if (ftypes::IsCoastlineChecker::Instance()(types) && !CheckCoastlines(f))
     return;
 
+  f.SetAllowedParts(FeatureType::PARTS_ALL);
   Stylist const s(f, m_zoomLevel, m_deviceLang);
 
   // No drawing rules.
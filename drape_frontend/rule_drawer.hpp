@@ -8,6 +8,7 @@
 
 #include "drape/pointers.hpp"
 
+#include "indexer/mwm_set.hpp"
 #include "indexer/road_shields_parser.hpp"
 
 #include "geometry/rect2d.hpp"
@@ -21,6 +22,11 @@
 
 class FeatureType;
 
+namespace feature
+{
+class TypesHolder;
+}  // namespace feature
+
 namespace df
 {
 class EngineContext;
@@ -40,9 +46,11 @@ public:
   using TCheckCancelledCallback = std::function<bool()>;
   using TIsCountryLoadedByNameFn = std::function<bool(std::string_view)>;
   using TInsertShapeFn = std::function<void(drape_ptr<MapShape> && shape)>;
+  using TGetIsolinesMinAltClassFn = std::function<int16_t(MwmSet::MwmId const &, int)>;
 
   RuleDrawer(TCheckCancelledCallback const & checkCancelled,
              TIsCountryLoadedByNameFn const & isLoadedFn,
+             TGetIsolinesMinAltClassFn const & getIsolinesMinAltClassFn,
              ref_ptr<EngineContext> engineContext, int8_t deviceLang);
   ~RuleDrawer();
 
@@ -58,6 +66,7 @@ private:
   void ProcessPointStyle(FeatureType & f, Stylist const & s, TInsertShapeFn const & insertShape);
 
   bool CheckCoastlines(FeatureType & f);
+  bool IsIsolineFiltered(FeatureType & f, feature::TypesHolder const & types);
 
   bool CheckCancelled();
 
@@ -65,6 +74,9 @@ private:
 
   TCheckCancelledCallback m_checkCancelled;
   TIsCountryLoadedByNameFn m_isLoadedFn;
+  TGetIsolinesMinAltClassFn m_getIsolinesMinAltClassFn;
+  // Minimal altitude classes of the drawn isolines of the tile mwms.
+  std::map<MwmSet::MwmId, int16_t> m_isolinesMinAltClasses;
 
   ref_ptr<EngineContext> m_context;
   CustomFeaturesContextPtr m_customFeaturesContext;
@@ -7,10 +7,166 @@
 #include "indexer/scales.hpp"
 
 #include <algorithm>
+#include <array>
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace df
 {
+namespace
+{
+// Drawing rules of a feature before the runtime selectors are applied.
+struct FeatureRules
+{
+  drule::KeysT m_keys;
+  uint32_t m_mainOverlayType = 0;
+  // When false |m_keys| are final, otherwise they are filtered by selectors for each feature.
+  bool m_hasSelectors = false;
+};
+
+// Drawing rules depend on the feature's types, the zoom level and the geometry type only, except
+// the rules with runtime selectors. Features share a few thousand combinations of types, so the
+// rules are resolved once for each combination.
+class FeatureRulesCache
+{
+public:
+  static FeatureRulesCache & Instance()
+  {
+    static FeatureRulesCache instance;
+    return instance;
+  }
+
+  bool Find(feature::TypesHolder const & types, uint8_t zoomLevel, FeatureRules & rules) const
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto const it = m_rules.find(MakeKey(types, zoomLevel));
+    if (it == m_rules.cend())
+      return false;
+    rules = it->second;
+    return true;
+  }
+
+  void Add(feature::TypesHolder const & types, uint8_t zoomLevel, FeatureRules const & rules)
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    // Entries of reloaded styles are never hit again, so the cache is just dropped when it's full.
+    if (m_rules.size() >= kMaxSize)
+      m_rules.clear();
+    m_rules.emplace(MakeKey(types, zoomLevel), rules);
+  }
+
+private:
+  static size_t constexpr kMaxSize = 1 << 16;
+
+  struct Key
+  {
+    bool operator==(Key const & rhs) const
+    {
+      return m_version == rhs.m_version && m_zoomLevel == rhs.m_zoomLevel &&
+             m_geomType == rhs.m_geomType && m_size == rhs.m_size &&
+             std::equal(m_types.begin(), m_types.begin() + m_size, rhs.m_types.begin());
+    }
+
+    // Order of types matters for the choice of the main overlay type.
+    feature::TypesHolder::Types m_types;
+    uint8_t m_size = 0;
+    uint8_t m_zoomLevel = 0;
+    feature::GeomType m_geomType = feature::GeomType::Undefined;
+    uint64_t m_version = 0;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const
+    {
+      uint64_t hash = key.m_version;
+      hash = hash * 31 + key.m_zoomLevel;
+      hash = hash * 31 + static_cast<uint64_t>(key.m_geomType);
+      for (uint8_t i = 0; i < key.m_size; ++i)
+        hash = hash * 1000003 + key.m_types[i];
+      return std::hash<uint64_t>()(hash);
+    }
+  };
+
+  static Key MakeKey(feature::TypesHolder const & types, uint8_t zoomLevel)
+  {
+    Key key;
+    key.m_size = static_cast<uint8_t>(types.Size());
+    std::copy(types.begin(), types.end(), key.m_types.begin());
+    key.m_zoomLevel = zoomLevel;
+    key.m_geomType = types.GetGeomType();
+    key.m_version = drule::rules().GetVersion();
+    return key;
+  }
+
+  std::unordered_map<Key, FeatureRules, KeyHash> m_rules;
+  mutable std::shared_mutex m_mutex;
+};
+
+FeatureRules ResolveFeatureRules(feature::TypesHolder const & types, uint8_t zoomLevel)
+{
+  Classificator const & cl = classif();
+
+  FeatureRules rules;
+  if (types.Size() == 1)
+    rules.m_mainOverlayType = types.front();
+  else
+  {
+    // Determine main overlays type by priority. Priorities might be different across zoom levels
+    // so a max value across all zooms is used to make sure main type doesn't change.
+    int overlaysMaxPriority = std::numeric_limits<int>::min();
+    for (uint32_t t : types)
+    {
+      int const priority = cl.GetObject(t)->GetMaxOverlaysPriority();
+      if (priority > overlaysMaxPriority)
+      {
+        overlaysMaxPriority = priority;
+        rules.m_mainOverlayType = t;
+      }
+    }
+  }
+
+  auto const & hatchingChecker = IsHatchingTerritoryChecker::Instance();
+  auto const geomType = types.GetGeomType();
+
+  auto & keys = rules.m_keys;
+  for (uint32_t t : types)
+  {
+    drule::KeysT typeKeys;
+    cl.GetObject(t)->GetSuitable(zoomLevel, geomType, typeKeys);
+    bool const hasHatching = hatchingChecker(t);
+
+    for (auto & k : typeKeys)
+    {
+      // Take overlay drules from the main type only.
+      if (t == rules.m_mainOverlayType ||
+          (k.m_type != drule::caption && k.m_type != drule::symbol &&
+           k.m_type != drule::shield && k.m_type != drule::pathtext))
+      {
+        if (hasHatching && k.m_type == drule::area)
+          k.m_hatching = true;
+        keys.push_back(k);
+      }
+    }
+  }
+
+  for (auto const & key : keys)
+  {
+    if (drule::rules().Find(key)->HasSelector())
+    {
+      rules.m_hasSelectors = true;
+      return rules;
+    }
+  }
+
+  // Leave only one area drule and an optional hatching drule.
+  drule::MakeUnique(keys);
+  return rules;
+}
+}  // namespace
+
 IsHatchingTerritoryChecker::IsHatchingTerritoryChecker()
 {
   Classificator const & c = classif();
@@ -152,58 +308,29 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang)
 {
   feature::TypesHolder const types(f);
   Classificator const & cl = classif();
+  auto const geomType = types.GetGeomType();
 
-  uint32_t mainOverlayType = 0;
-  if (types.Size() == 1)
-    mainOverlayType = types.front();
-  else
+  auto & cache = FeatureRulesCache::Instance();
+  FeatureRules rules;
+  if (!cache.Find(types, zoomLevel, rules))
   {
-    // Determine main overlays type by priority. Priorities might be different across zoom levels
-    // so a max value across all zooms is used to make sure main type doesn't change.
-    int overlaysMaxPriority = std::numeric_limits<int>::min();
-    for (uint32_t t : types)
-    {
-      int const priority = cl.GetObject(t)->GetMaxOverlaysPriority();
-      if (priority > overlaysMaxPriority)
-      {
-        overlaysMaxPriority = priority;
-        mainOverlayType = t;
-      }
-    }
+    rules = ResolveFeatureRules(types, zoomLevel);
+    cache.Add(types, zoomLevel, rules);
   }
 
-  auto const & hatchingChecker = IsHatchingTerritoryChecker::Instance();
-  auto const geomType = types.GetGeomType();
-
-  drule::KeysT keys;
-  for (uint32_t t : types)
+  uint32_t const mainOverlayType = rules.m_mainOverlayType;
+  drule::KeysT & keys = rules.m_keys;
+  if (rules.m_hasSelectors)
   {
-    drule::KeysT typeKeys;
-    cl.GetObject(t)->GetSuitable(zoomLevel, geomType, typeKeys);
-    bool const hasHatching = hatchingChecker(t);
+    feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
 
-    for (auto & k : typeKeys)
-    {
-      // Take overlay drules from the main type only.
-      if (t == mainOverlayType ||
-          (k.m_type != drule::caption && k.m_type != drule::symbol &&
-           k.m_type != drule::shield && k.m_type != drule::pathtext))
-      {
-        if (hasHatching && k.m_type == drule::area)
-          k.m_hatching = true;
-        keys.push_back(k);
-      }
-    }
+    // Leave only one area drule and an optional hatching drule.
+    drule::MakeUnique(keys);
   }
 
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
-
   if (keys.empty())
     return;
 
-  // Leave only one area drule and an optional hatching drule.
-  drule::MakeUnique(keys);
-
   for (auto const & key : keys)
     ProcessKey(f, key);
 
@@ -4,9 +4,14 @@
 
 #include "drape/bidi.hpp"
 
+#include "base/lru_cache.hpp"
+
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 #include <numeric>
+#include <optional>
+#include <string>
 
 namespace df
 {
@@ -14,6 +19,35 @@ namespace
 {
 float constexpr kValidSplineTurn = 0.96f;
 
+// Bidi reordering of non-ASCII texts goes through ICU and it's the most expensive step of
+// a layout, while the same names are laid out in many tiles and on every zoom level.
+strings::UniString Log2Vis(strings::UniString const & text)
+{
+  if (std::all_of(text.begin(), text.end(), [](strings::UniChar c) { return c < 0x80; }))
+    return text;
+
+  size_t constexpr kCacheSize = 4096;
+  static std::mutex mutex;
+  // An entry is inserted empty on a miss and filled when the text is reordered.
+  static LruCache<std::u32string, std::optional<strings::UniString>> cache(kCacheSize);
+
+  std::u32string const key(text.begin(), text.end());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool found = false;
+    auto const & visibleText = cache.Find(key, found);
+    if (visibleText)
+      return *visibleText;
+  }
+
+  auto visibleText = bidi::log2vis(text);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  bool found = false;
+  cache.Find(key, found) = visibleText;
+  return visibleText;
+}
+
 class TextGeometryGenerator
 {
 public:
@@ -344,7 +378,7 @@ StraightTextLayout::StraightTextLayout(strings::UniString const & text, float fo
                                        ref_ptr<dp::TextureManager> textures, dp::Anchor anchor,
                                        bool forceNoWrap)
 {
-  strings::UniString visibleText = bidi::log2vis(text);
+  strings::UniString visibleText = Log2Vis(text);
   // Possible if name has strange symbols only.
   if (visibleText.empty())
     return;
@@ -428,7 +462,7 @@ PathTextLayout::PathTextLayout(m2::PointD const & tileCenter, strings::UniString
                                float fontSize, bool isSdf, ref_ptr<dp::TextureManager> textures)
   : m_tileCenter(tileCenter)
 {
-  Init(bidi::log2vis(text), fontSize, isSdf, textures);
+  Init(Log2Vis(text), fontSize, isSdf, textures);
 }
 
 void PathTextLayout::CacheStaticGeometry(dp::TextureManager::ColorRegion const & colorRegion,
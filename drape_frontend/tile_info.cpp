@@ -12,6 +12,7 @@
 
 #include "base/scope_guard.hpp"
 #include "base/logging.hpp"
+#include "base/trace.hpp"
 
 #include <algorithm>
 #include <functional>
@@ -20,8 +21,10 @@ using namespace std::placeholders;
 
 namespace df
 {
-TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
+TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext,
+                   ref_ptr<TileShapesCache> shapesCache)
   : m_context(std::move(engineContext))
+  , m_shapesCache(shapesCache)
   , m_isCanceled(false)
 {}
 
@@ -55,6 +58,8 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 
 void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
+  TRACE_SCOPE(Drape, "TileInfo::ReadFeatures");
+
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().StartTileReading();
 #endif
@@ -68,22 +73,41 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
 
   m_context->GetMetalineManager()->Update(m_mwms);
 
-  if (!m_featureInfo.empty())
+  // Traffic geometry is flushed apart from shapes, so tiles with traffic are not cached.
+  bool const useCache = m_shapesCache != nullptr && !m_context->IsTrafficEnabled();
+  ShapesPortions portions;
+  if (useCache && m_shapesCache->Get(GetTileKey(), m_mwms, portions))
   {
-    std::sort(m_featureInfo.begin(), m_featureInfo.end());
-    auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
-    RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
-                      make_ref(m_context), deviceLang);
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
-#ifdef DRAW_TILE_NET
-    drawer.DrawTileNet();
-#endif
+    m_context->FlushCachedShapes(portions);
+  }
+  else
+  {
+    m_context->SetShapesRecording(useCache);
+    ReadAndStyleFeatures(model);
+    if (useCache && !IsCancelled())
+      m_shapesCache->Put(GetTileKey(), m_mwms, m_context->TakeRecordedShapes());
   }
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().EndTileReading();
 #endif
 }
 
+void TileInfo::ReadAndStyleFeatures(MapDataProvider const & model)
+{
+  if (m_featureInfo.empty())
+    return;
+
+  std::sort(m_featureInfo.begin(), m_featureInfo.end());
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  // Overlays are flushed by the destructor of the drawer.
+  RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                    model.m_getIsolinesMinAltClass, make_ref(m_context), deviceLang);
+  model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+#ifdef DRAW_TILE_NET
+  drawer.DrawTileNet();
+#endif
+}
+
 void TileInfo::Cancel()
 {
   m_isCanceled = true;
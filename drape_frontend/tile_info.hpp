@@ -3,6 +3,7 @@
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 
 #include "indexer/feature_decl.hpp"
 
@@ -25,7 +26,8 @@ class TileInfo
 public:
   DECLARE_EXCEPTION(ReadCanceledException, RootException);
 
-  TileInfo(drape_ptr<EngineContext> && engineContext);
+  // |shapesCache| may be nullptr if tiles must not be cached.
+  TileInfo(drape_ptr<EngineContext> && engineContext, ref_ptr<TileShapesCache> shapesCache);
 
   void ReadFeatures(MapDataProvider const & model);
   void Cancel();
@@ -37,6 +39,7 @@ public:
 
 private:
   void ReadFeatureIndex(MapDataProvider const & model);
+  void ReadAndStyleFeatures(MapDataProvider const & model);
   void ThrowIfCancelled() const;
   bool DoNeedReadIndex() const;
 
@@ -44,6 +47,7 @@ private:
 
 private:
   drape_ptr<EngineContext> m_context;
+  ref_ptr<TileShapesCache> m_shapesCache;
   std::vector<FeatureID> m_featureInfo;
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
@@ -0,0 +1,76 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace df
+{
+TileShapesCache::TileShapesCache(size_t maxTilesCount)
+  : m_maxTilesCount(maxTilesCount)
+{
+  ASSERT_GREATER(m_maxTilesCount, 0, ());
+}
+
+bool TileShapesCache::Get(TileKey const & key, std::set<MwmSet::MwmId> const & mwms,
+                          ShapesPortions & portions)
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+    return false;
+
+  if (it->second.m_mwms != mwms)
+  {
+    m_lru.erase(it->second.m_lruIt);
+    m_entries.erase(it);
+    return false;
+  }
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  portions = it->second.m_portions;
+  return true;
+}
+
+void TileShapesCache::Put(TileKey const & key, std::set<MwmSet::MwmId> const & mwms,
+                          ShapesPortions && portions)
+{
+  std::lock_guard lock(m_mutex);
+  auto [it, inserted] = m_entries.emplace(key, Entry());
+  if (inserted)
+  {
+    m_lru.push_front(key);
+    it->second.m_lruIt = m_lru.begin();
+  }
+  else
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  }
+  it->second.m_mwms = mwms;
+  it->second.m_portions = std::move(portions);
+
+  while (m_entries.size() > m_maxTilesCount)
+  {
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+void TileShapesCache::Erase(TileKey const & key)
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+    return;
+
+  m_lru.erase(it->second.m_lruIt);
+  m_entries.erase(it);
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard lock(m_mutex);
+  m_entries.clear();
+  m_lru.clear();
+}
+}  // namespace df
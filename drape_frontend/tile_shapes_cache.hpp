@@ -0,0 +1,63 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace df
+{
+// A portion of shapes which has been flushed by EngineContext while a tile was read.
+struct ShapesPortion
+{
+  bool m_isOverlay = false;
+  std::shared_ptr<TMapShapes const> m_shapes;
+};
+
+using ShapesPortions = std::vector<ShapesPortion>;
+
+// LRU cache of the shapes generated for tiles. A tile which is read again (after the user
+// pans or zooms back) takes its shapes from the cache instead of decoding and styling features.
+// Shapes are bound to the set of mwms the tile has been read from, so an entry becomes stale
+// when an mwm is updated, downloaded or deleted. The cache is thread-safe.
+class TileShapesCache
+{
+public:
+  explicit TileShapesCache(size_t maxTilesCount);
+
+  // Returns false if there are no shapes for |key| read from exactly |mwms|.
+  bool Get(TileKey const & key, std::set<MwmSet::MwmId> const & mwms, ShapesPortions & portions);
+  void Put(TileKey const & key, std::set<MwmSet::MwmId> const & mwms, ShapesPortions && portions);
+
+  void Erase(TileKey const & key);
+  void Clear();
+
+private:
+  struct Entry
+  {
+    std::set<MwmSet::MwmId> m_mwms;
+    ShapesPortions m_portions;
+    std::list<TileKey>::iterator m_lruIt;
+  };
+
+  size_t const m_maxTilesCount;
+
+  std::mutex m_mutex;
+  // Operator < of TileKey does not consider generations, so a tile matches its copy
+  // from any generation.
+  std::map<TileKey, Entry> m_entries;
+  std::list<TileKey> m_lru;
+
+  DISALLOW_COPY_AND_MOVE(TileShapesCache);
+};
+}  // namespace df
@@ -19,6 +19,7 @@
 #include <array>
 #include <functional>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -80,7 +81,9 @@ struct TrafficSegmentGeometry
 using TrafficSegmentsGeometryValue = std::vector<std::pair<traffic::TrafficInfo::RoadSegmentId,
                                                            TrafficSegmentGeometry>>;
 using TrafficSegmentsGeometry = std::map<MwmSet::MwmId, TrafficSegmentsGeometryValue>;
-using TrafficSegmentsColoring = std::map<MwmSet::MwmId, traffic::TrafficInfo::Coloring>;
+// The colorings are shared with the other users of the traffic (see TrafficInfo::GetSharedColoring).
+using TrafficSegmentsColoring =
+    std::map<MwmSet::MwmId, std::shared_ptr<traffic::TrafficInfo::PackedColoring const>>;
 
 struct TrafficRenderData
 {
@@ -172,7 +175,9 @@ public:
 
   void FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
                              TrafficSegmentsGeometry const & geom, ref_ptr<dp::TextureManager> textures);
-  void UpdateColoring(TrafficSegmentsColoring const & coloring);
+  // Returns false if the colorings are the same as the current ones, so the traffic needn't be
+  // regenerated.
+  bool UpdateColoring(TrafficSegmentsColoring const & coloring);
 
   void ClearCache();
   void ClearCache(MwmSet::MwmId const & mwmId);
@@ -226,7 +231,7 @@ private:
   void GenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
                                 TileKey const & tileKey,
                                 TrafficSegmentsGeometryValue const & geometry,
-                                traffic::TrafficInfo::Coloring const & coloring,
+                                traffic::TrafficInfo::PackedColoring const & coloring,
                                 ref_ptr<dp::TextureManager> texturesMgr);
 
   TrafficSegmentsColoring m_coloring;
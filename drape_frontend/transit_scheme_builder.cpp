@@ -351,55 +351,82 @@ bool FindLongerPath(routing::transit::StopId stop1Id, routing::transit::StopId s
 }
 }  // namespace
 
-void TransitSchemeBuilder::UpdateSchemes(ref_ptr<dp::GraphicsContext> context,
-                                         TransitDisplayInfos const & transitDisplayInfos,
-                                         ref_ptr<dp::TextureManager> textures)
+void TransitSchemeBuilder::PrepareSchemes(TransitDisplayInfos && transitDisplayInfos)
 {
-  for (auto const & [mwmId, transitDisplayInfoPtr] : transitDisplayInfos)
+  for (auto & [mwmId, transitDisplayInfoPtr] : transitDisplayInfos)
   {
     if (!transitDisplayInfoPtr)
       continue;
 
-    auto const & transitDisplayInfo = *transitDisplayInfoPtr.get();
-
-    MwmSchemeData & scheme = m_schemes[mwmId];
-    scheme.m_transitVersion = transitDisplayInfo.m_transitVersion;
+    uint64_t const requestId = ++m_lastRequestId;
+    m_requestIds[mwmId] = requestId;
 
-    if (scheme.m_transitVersion == ::transit::TransitVersion::OnlySubway)
+    // Tasks of the pool must be copyable.
+    std::shared_ptr<TransitDisplayInfo> info(std::move(transitDisplayInfoPtr));
+    m_workerThread.Push([this, mwmId = mwmId, requestId, info = std::move(info)]()
     {
-      CollectStopsSubway(transitDisplayInfo, mwmId, scheme);
-      CollectLinesSubway(transitDisplayInfo, scheme);
-      CollectShapesSubway(transitDisplayInfo, scheme);
+      PreparedScheme preparedScheme;
+      preparedScheme.m_mwmId = mwmId;
+      preparedScheme.m_requestId = requestId;
+      PrepareScheme(*info, mwmId, preparedScheme.m_scheme);
+      m_preparedSchemeFn(std::move(preparedScheme));
+    });
+  }
+}
 
-      PrepareSchemeSubway(scheme);
-      BuildScheme(context, mwmId, textures);
-    }
-    else if (scheme.m_transitVersion == ::transit::TransitVersion::AllPublicTransport)
-    {
-      LinesDataPT const & linesData = CollectLinesPT(transitDisplayInfo, scheme);
+void TransitSchemeBuilder::ApplyScheme(ref_ptr<dp::GraphicsContext> context,
+                                       PreparedScheme && preparedScheme,
+                                       ref_ptr<dp::TextureManager> textures)
+{
+  auto const it = m_requestIds.find(preparedScheme.m_mwmId);
+  if (it == m_requestIds.end() || it->second != preparedScheme.m_requestId)
+    return;
+  m_requestIds.erase(it);
 
-      CollectStopsPT(transitDisplayInfo, linesData, mwmId, scheme);
-      CollectShapesPT(transitDisplayInfo, scheme);
+  m_schemes[preparedScheme.m_mwmId] = std::move(preparedScheme.m_scheme);
+  BuildScheme(context, preparedScheme.m_mwmId, textures);
+}
 
-      PrepareSchemePT(transitDisplayInfo, linesData, scheme);
-      BuildScheme(context, mwmId, textures);
-    }
-    else
-    {
-      LOG(LERROR, (scheme.m_transitVersion));
-      UNREACHABLE();
-    }
+// static
+void TransitSchemeBuilder::PrepareScheme(TransitDisplayInfo const & transitDisplayInfo,
+                                         MwmSet::MwmId const & mwmId, MwmSchemeData & scheme)
+{
+  scheme.m_transitVersion = transitDisplayInfo.m_transitVersion;
+
+  if (scheme.m_transitVersion == ::transit::TransitVersion::OnlySubway)
+  {
+    CollectStopsSubway(transitDisplayInfo, mwmId, scheme);
+    CollectLinesSubway(transitDisplayInfo, scheme);
+    CollectShapesSubway(transitDisplayInfo, scheme);
+
+    PrepareSchemeSubway(scheme);
+  }
+  else if (scheme.m_transitVersion == ::transit::TransitVersion::AllPublicTransport)
+  {
+    LinesDataPT const & linesData = CollectLinesPT(transitDisplayInfo, scheme);
+
+    CollectStopsPT(transitDisplayInfo, linesData, mwmId, scheme);
+    CollectShapesPT(transitDisplayInfo, scheme);
+
+    PrepareSchemePT(transitDisplayInfo, linesData, scheme);
+  }
+  else
+  {
+    LOG(LERROR, (scheme.m_transitVersion));
+    UNREACHABLE();
   }
 }
 
 void TransitSchemeBuilder::Clear()
 {
   m_schemes.clear();
+  m_requestIds.clear();
 }
 
 void TransitSchemeBuilder::Clear(MwmSet::MwmId const & mwmId)
 {
   m_schemes.erase(mwmId);
+  m_requestIds.erase(mwmId);
 }
 
 void TransitSchemeBuilder::RebuildSchemes(ref_ptr<dp::GraphicsContext> context,
@@ -481,6 +508,7 @@ void TransitSchemeBuilder::GenerateLinesPT(MwmSchemeData const & scheme, dp::Bat
   }
 }
 
+// static
 void TransitSchemeBuilder::CollectStopsSubway(TransitDisplayInfo const & transitDisplayInfo,
                                               MwmSet::MwmId const & mwmId, MwmSchemeData & scheme)
 {
@@ -515,6 +543,7 @@ void TransitSchemeBuilder::CollectStopsSubway(TransitDisplayInfo const & transit
   }
 }
 
+// static
 void TransitSchemeBuilder::CollectStopsPT(TransitDisplayInfo const & transitDisplayInfo,
                                           LinesDataPT const & linesData,
                                           MwmSet::MwmId const & mwmId, MwmSchemeData & scheme)
@@ -563,6 +592,7 @@ void TransitSchemeBuilder::CollectStopsPT(TransitDisplayInfo const & transitDisp
   }
 }
 
+// static
 void TransitSchemeBuilder::CollectLinesSubway(TransitDisplayInfo const & transitDisplayInfo,
                                               MwmSchemeData & scheme)
 {
@@ -590,6 +620,7 @@ void TransitSchemeBuilder::CollectLinesSubway(TransitDisplayInfo const & transit
   }
 }
 
+// static
 LinesDataPT TransitSchemeBuilder::CollectLinesPT(TransitDisplayInfo const & transitDisplayInfo,
                                                  MwmSchemeData & scheme)
 {
@@ -634,6 +665,7 @@ LinesDataPT TransitSchemeBuilder::CollectLinesPT(TransitDisplayInfo const & tran
   return linesData;
 }
 
+// static
 void TransitSchemeBuilder::CollectShapesSubway(TransitDisplayInfo const & transitDisplayInfo,
                                                MwmSchemeData & scheme)
 {
@@ -662,6 +694,7 @@ void TransitSchemeBuilder::CollectShapesSubway(TransitDisplayInfo const & transi
   }
 }
 
+// static
 void TransitSchemeBuilder::CollectShapesPT(TransitDisplayInfo const & transitDisplayInfo,
                                            MwmSchemeData & scheme)
 {
@@ -709,6 +742,7 @@ void TransitSchemeBuilder::CollectShapesPT(TransitDisplayInfo const & transitDis
   }
 }
 
+// static
 void TransitSchemeBuilder::FindShapes(routing::transit::StopId stop1Id,
                                       routing::transit::StopId stop2Id,
                                       routing::transit::LineId lineId,
@@ -747,6 +781,7 @@ void TransitSchemeBuilder::FindShapes(routing::transit::StopId stop1Id,
     AddShape(transitDisplayInfo, stop1Id, stop2Id, lineId, scheme);
 }
 
+// static
 void TransitSchemeBuilder::AddShape(TransitDisplayInfo const & transitDisplayInfo,
                                     routing::transit::StopId stop1Id,
                                     routing::transit::StopId stop2Id,
@@ -808,6 +843,7 @@ void TransitSchemeBuilder::AddShape(TransitDisplayInfo const & transitDisplayInf
   }
 }
 
+// static
 void TransitSchemeBuilder::PrepareSchemeSubway(MwmSchemeData & scheme)
 {
   m2::RectD boundingRect;
@@ -870,6 +906,7 @@ void UpdateShapeInfos(std::vector<ShapeInfoPT> & shapeInfos, m2::PointD const &
   UpdateShapeInfos(shapeInfos, newDir, std::set<std::string>{color});
 }
 
+// static
 StopNodeParamsPT & TransitSchemeBuilder::GetStopOrTransfer(MwmSchemeData & scheme,
                                                            ::transit::TransitId id)
 {
@@ -880,6 +917,7 @@ StopNodeParamsPT & TransitSchemeBuilder::GetStopOrTransfer(MwmSchemeData & schem
   return scheme.m_transfersPT[id];
 }
 
+// static
 void TransitSchemeBuilder::PrepareSchemePT(TransitDisplayInfo const & transitDisplayInfo,
                                            LinesDataPT const & lineData, MwmSchemeData & scheme)
 {
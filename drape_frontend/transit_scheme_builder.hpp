@@ -8,9 +8,13 @@
 #include "transit/transit_display_info.hpp"
 #include "transit/transit_version.hpp"
 
+#include "base/thread_pool_delayed.hpp"
+
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -155,23 +159,6 @@ public:
     TransferMax = 60
   };
 
-  using TFlushRenderDataFn = std::function<void(TransitRenderData && renderData)>;
-
-  explicit TransitSchemeBuilder(TFlushRenderDataFn const & flushFn)
-    : m_flushRenderDataFn(flushFn)
-  {}
-
-  void UpdateSchemes(ref_ptr<dp::GraphicsContext> context,
-                     TransitDisplayInfos const & transitDisplayInfos,
-                     ref_ptr<dp::TextureManager> textures);
-
-  void RebuildSchemes(ref_ptr<dp::GraphicsContext> context,
-                      ref_ptr<dp::TextureManager> textures);
-
-  void Clear();
-  void Clear(MwmSet::MwmId const & mwmId);
-
-private:
   struct MwmSchemeData
   {
     m2::PointD m_pivot;
@@ -189,6 +176,42 @@ private:
     std::map<::transit::TransitId, StopNodeParamsPT> m_transfersPT;
   };
 
+  // Scheme of a mwm which is collected and laid out off the backend thread. It's applied only
+  // if |m_requestId| is still the last request for the mwm.
+  struct PreparedScheme
+  {
+    MwmSet::MwmId m_mwmId;
+    uint64_t m_requestId = 0;
+    MwmSchemeData m_scheme;
+  };
+
+  using TFlushRenderDataFn = std::function<void(TransitRenderData && renderData)>;
+  using TPreparedSchemeFn = std::function<void(PreparedScheme && preparedScheme)>;
+
+  TransitSchemeBuilder(TFlushRenderDataFn const & flushFn, TPreparedSchemeFn const & preparedFn)
+    : m_flushRenderDataFn(flushFn)
+    , m_preparedSchemeFn(preparedFn)
+  {}
+
+  // Collects the schemes of |transitDisplayInfos| on the worker thread, each mwm in a separate
+  // task. |m_preparedSchemeFn| is called from the worker thread for each prepared mwm.
+  void PrepareSchemes(TransitDisplayInfos && transitDisplayInfos);
+
+  // Generates geometry of the prepared scheme. Results of stale requests are dropped, so mwms
+  // which were cleared or updated again in the meantime aren't rebuilt.
+  void ApplyScheme(ref_ptr<dp::GraphicsContext> context, PreparedScheme && preparedScheme,
+                   ref_ptr<dp::TextureManager> textures);
+
+  void RebuildSchemes(ref_ptr<dp::GraphicsContext> context,
+                      ref_ptr<dp::TextureManager> textures);
+
+  void Clear();
+  void Clear(MwmSet::MwmId const & mwmId);
+
+private:
+  static void PrepareScheme(TransitDisplayInfo const & transitDisplayInfo,
+                            MwmSet::MwmId const & mwmId, MwmSchemeData & scheme);
+
   void BuildScheme(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
                    ref_ptr<dp::TextureManager> textures);
 
@@ -204,27 +227,33 @@ private:
                                    F && flusher, MwmSchemeData const & scheme, S const & stops,
                                    T const & transfers, L const & lines);
 
-  void CollectStopsSubway(TransitDisplayInfo const & transitDisplayInfo,
-                          MwmSet::MwmId const & mwmId, MwmSchemeData & scheme);
-  void CollectStopsPT(TransitDisplayInfo const & transitDisplayInfo, LinesDataPT const & linesData,
-                      MwmSet::MwmId const & mwmId, MwmSchemeData & scheme);
-
-  void CollectLinesSubway(TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
-  LinesDataPT CollectLinesPT(TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
-
-  void CollectShapesSubway(TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
-  void CollectShapesPT(TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
-
-  void FindShapes(routing::transit::StopId stop1Id, routing::transit::StopId stop2Id,
-                  routing::transit::LineId lineId,
-                  std::vector<routing::transit::LineId> const & sameLines,
-                  TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
-  void AddShape(TransitDisplayInfo const & transitDisplayInfo, routing::transit::StopId stop1Id,
-                routing::transit::StopId stop2Id, routing::transit::LineId lineId, MwmSchemeData & scheme);
-
-  void PrepareSchemeSubway(MwmSchemeData & scheme);
-  void PrepareSchemePT(TransitDisplayInfo const & transitDisplayInfo, LinesDataPT const & lineData,
-                       MwmSchemeData & scheme);
+  static void CollectStopsSubway(TransitDisplayInfo const & transitDisplayInfo,
+                                 MwmSet::MwmId const & mwmId, MwmSchemeData & scheme);
+  static void CollectStopsPT(TransitDisplayInfo const & transitDisplayInfo,
+                             LinesDataPT const & linesData, MwmSet::MwmId const & mwmId,
+                             MwmSchemeData & scheme);
+
+  static void CollectLinesSubway(TransitDisplayInfo const & transitDisplayInfo,
+                                 MwmSchemeData & scheme);
+  static LinesDataPT CollectLinesPT(TransitDisplayInfo const & transitDisplayInfo,
+                                    MwmSchemeData & scheme);
+
+  static void CollectShapesSubway(TransitDisplayInfo const & transitDisplayInfo,
+                                  MwmSchemeData & scheme);
+  static void CollectShapesPT(TransitDisplayInfo const & transitDisplayInfo,
+                              MwmSchemeData & scheme);
+
+  static void FindShapes(routing::transit::StopId stop1Id, routing::transit::StopId stop2Id,
+                         routing::transit::LineId lineId,
+                         std::vector<routing::transit::LineId> const & sameLines,
+                         TransitDisplayInfo const & transitDisplayInfo, MwmSchemeData & scheme);
+  static void AddShape(TransitDisplayInfo const & transitDisplayInfo,
+                       routing::transit::StopId stop1Id, routing::transit::StopId stop2Id,
+                       routing::transit::LineId lineId, MwmSchemeData & scheme);
+
+  static void PrepareSchemeSubway(MwmSchemeData & scheme);
+  static void PrepareSchemePT(TransitDisplayInfo const & transitDisplayInfo,
+                              LinesDataPT const & lineData, MwmSchemeData & scheme);
 
   void GenerateShapes(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId);
 
@@ -265,13 +294,21 @@ private:
                     m2::PointD const & pivot, dp::Color const & colorConst, float lineOffset,
                     float halfWidth, float depth, dp::Batcher & batcher);
 
-  StopNodeParamsPT & GetStopOrTransfer(MwmSchemeData & scheme, ::transit::TransitId id);
+  static StopNodeParamsPT & GetStopOrTransfer(MwmSchemeData & scheme, ::transit::TransitId id);
 
   using TransitSchemes = std::map<MwmSet::MwmId, MwmSchemeData>;
   TransitSchemes m_schemes;
 
   TFlushRenderDataFn m_flushRenderDataFn;
+  TPreparedSchemeFn m_preparedSchemeFn;
 
   uint32_t m_recacheId = 0;
+
+  // Last request id for each mwm which is being prepared, accessed on the backend thread only.
+  std::map<MwmSet::MwmId, uint64_t> m_requestIds;
+  uint64_t m_lastRequestId = 0;
+
+  // Must be the last member, so pending tasks are finished before other members are destroyed.
+  base::thread_pool::delayed::ThreadPool m_workerThread;
 };
 }  // namespace df
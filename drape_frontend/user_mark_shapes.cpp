@@ -346,6 +346,48 @@ m2::SharedSpline SimplifySpline(m2::SharedSpline const & in, double minSqrLength
   return spline;
 }
 
+// Splines are simplified on zoom levels up to this one only.
+int constexpr kMaxSimplifiedZoom = 15;
+
+double GetMinSegmentSqrLength(int zoomLevel, double vs)
+{
+  return base::Pow2(4.0 * vs * GetScreenScale(zoomLevel));
+}
+
+std::vector<m2::SharedSpline> const & GetSimplifiedSplines(UserLineRenderParams const & renderInfo,
+                                                          int zoomLevel, double vs)
+{
+  auto & levels = renderInfo.m_simplifiedSplines;
+  if (renderInfo.m_simplifiedVisualScale != vs || levels.empty())
+  {
+    levels.clear();
+    levels.resize(kMaxSimplifiedZoom);
+    renderInfo.m_simplifiedVisualScale = vs;
+  }
+
+  auto & splines = levels[zoomLevel - 1];
+  if (!splines.empty() || renderInfo.m_splines.empty())
+    return splines;
+
+  // A coarser level is simplified from the nearest finer one which is already built,
+  // so long lines are not traversed in full for every zoom level.
+  auto const * source = &renderInfo.m_splines;
+  for (int z = zoomLevel + 1; z <= kMaxSimplifiedZoom; ++z)
+  {
+    if (!levels[z - 1].empty())
+    {
+      source = &levels[z - 1];
+      break;
+    }
+  }
+
+  double const minSegmentSqrLength = GetMinSegmentSqrLength(zoomLevel, vs);
+  splines.reserve(source->size());
+  for (auto const & spline : *source)
+    splines.push_back(SimplifySpline(spline, minSegmentSqrLength));
+  return splines;
+}
+
 std::string GetBackgroundSymbolName(std::string const & symbolName)
 {
   char const * kDelimiter = "-";
@@ -559,12 +601,7 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
   CHECK_LESS(tileKey.m_zoomLevel - 1, static_cast<int>(kLineWidthZoomFactor.size()), ());
 
   double const vs = df::VisualParams::Instance().GetVisualScale();
-  bool const simplify = tileKey.m_zoomLevel <= 15;
-
-  // This var is used only if simplify == true.
-  double minSegmentSqrLength = 1.0;
-  if (simplify)
-    minSegmentSqrLength = base::Pow2(4.0 * vs * GetScreenScale(tileKey.m_zoomLevel));
+  bool const simplify = tileKey.m_zoomLevel <= kMaxSimplifiedZoom;
 
   m2::RectD const tileRect = tileKey.GetGlobalRect();
 
@@ -579,8 +616,9 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
 
     UserLineRenderParams const & renderInfo = *it->second;
 
-    // Spline is a shared_ptr here, can reassign later.
-    for (auto spline : renderInfo.m_splines)
+    auto const & splines = simplify ? GetSimplifiedSplines(renderInfo, tileKey.m_zoomLevel, vs)
+                                    : renderInfo.m_splines;
+    for (auto const & spline : splines)
     {
       // This check is redundant, because we already made rough check while covering tracks by tiles
       // (see UserMarkGenerator::UpdateIndex).
@@ -599,9 +637,6 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
         continue;
       */
 
-      if (simplify)
-        spline = SimplifySpline(spline, minSegmentSqrLength);
-
       if (spline->GetSize() < 2)
         continue;
 
@@ -67,6 +67,11 @@ struct UserLineRenderParams
   DepthLayer m_depthLayer = DepthLayer::UserLineLayer;
   std::vector<LineLayer> m_layers;
   std::vector<m2::SharedSpline> m_splines;
+
+  // Simplified m_splines per zoom level (index is zoom level - 1). Levels are built on demand
+  // by CacheUserLines on the backend renderer thread and dropped when the visual scale changes.
+  mutable std::vector<std::vector<m2::SharedSpline>> m_simplifiedSplines;
+  mutable double m_simplifiedVisualScale = 0.0;
 };
 
 using UserMarksRenderCollection = std::unordered_map<kml::MarkId, drape_ptr<UserMarkRenderParams>>;
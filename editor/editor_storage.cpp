@@ -6,6 +6,7 @@
 
 #include "base/logging.hpp"
 
+#include <fstream>
 #include <string>
 
 using namespace pugi;
@@ -13,8 +14,20 @@ using namespace pugi;
 namespace
 {
 char const * kEditorXMLFileName = "edits.xml";
+char const * kEditorJournalFileName = "edits_journal.xml";
 
 std::string GetEditorFilePath() { return GetPlatform().WritablePathForFile(kEditorXMLFileName); }
+
+std::string GetJournalFilePath()
+{
+  return GetPlatform().WritablePathForFile(kEditorJournalFileName);
+}
+
+void AppendChildren(xml_document const & from, xml_document & to)
+{
+  for (auto const & child : from.children())
+    to.append_copy(child);
+}
 }  // namespace
 
 namespace editor
@@ -26,9 +39,19 @@ bool LocalStorage::Save(xml_document const & doc)
 
   std::lock_guard<std::mutex> guard(m_mutex);
 
-  return base::WriteToTempAndRenameToFile(editorFilePath, [&doc](std::string const & fileName) {
-    return doc.save_file(fileName.data(), "  " /* indent */);
-  });
+  if (!base::WriteToTempAndRenameToFile(editorFilePath, [&doc](std::string const & fileName) {
+        return doc.save_file(fileName.data(), "  " /* indent */);
+      }))
+  {
+    return false;
+  }
+
+  // Records of the journal are written for the saved document, they are skipped if the file
+  // isn't deleted.
+  auto const journalFilePath = GetJournalFilePath();
+  if (Platform::IsFileExistsByFullPath(journalFilePath) && !base::DeleteFileX(journalFilePath))
+    LOG(LWARNING, ("Can't delete map edits journal:", journalFilePath));
+  return true;
 }
 
 bool LocalStorage::Load(xml_document & doc)
@@ -48,10 +71,48 @@ bool LocalStorage::Load(xml_document & doc)
   return true;
 }
 
+bool LocalStorage::Append(xml_document const & records)
+{
+  auto const journalFilePath = GetJournalFilePath();
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  std::ofstream out(journalFilePath, std::ios::app | std::ios::binary);
+  if (!out)
+    return false;
+
+  for (auto const & record : records.children())
+  {
+    record.print(out, "" /* indent */, format_raw);
+    out << '\n';
+  }
+  out.flush();
+  return static_cast<bool>(out);
+}
+
+bool LocalStorage::LoadJournal(xml_document & journal)
+{
+  auto const journalFilePath = GetJournalFilePath();
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  // The journal is a sequence of records without a root node. A record which is cut by a crash
+  // breaks parsing, the records before it are loaded anyway.
+  auto const result = journal.load_file(journalFilePath.c_str(), parse_default | parse_fragment);
+  if (result != status_ok && result != status_file_not_found)
+    LOG(LWARNING, ("Map edits journal is damaged:", journalFilePath, result.description()));
+
+  return true;
+}
+
 bool LocalStorage::Reset()
 {
   std::lock_guard<std::mutex> guard(m_mutex);
 
+  auto const journalFilePath = GetJournalFilePath();
+  if (Platform::IsFileExistsByFullPath(journalFilePath))
+    base::DeleteFileX(journalFilePath);
+
   return base::DeleteFileX(GetEditorFilePath());
 }
 
@@ -59,6 +120,7 @@ bool LocalStorage::Reset()
 bool InMemoryStorage::Save(xml_document const & doc)
 {
   m_doc.reset(doc);
+  m_journal.reset();
   return true;
 }
 
@@ -68,9 +130,22 @@ bool InMemoryStorage::Load(xml_document & doc)
   return true;
 }
 
+bool InMemoryStorage::Append(xml_document const & records)
+{
+  AppendChildren(records, m_journal);
+  return true;
+}
+
+bool InMemoryStorage::LoadJournal(xml_document & journal)
+{
+  journal.reset(m_journal);
+  return true;
+}
+
 bool InMemoryStorage::Reset()
 {
   m_doc.reset();
+  m_journal.reset();
   return true;
 }
 }  // namespace editor
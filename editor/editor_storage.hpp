@@ -7,13 +7,20 @@
 namespace editor
 {
 // Editor storage interface.
+// Edits are kept as a document with all edits and a journal of the changes made after the
+// document had been saved, so a single change is saved without rewriting all edits.
 class StorageBase
 {
 public:
   virtual ~StorageBase() = default;
 
+  // Saves all edits, the journal is cleared.
   virtual bool Save(pugi::xml_document const & doc) = 0;
   virtual bool Load(pugi::xml_document & doc) = 0;
+  // Appends the children of |records| to the journal.
+  virtual bool Append(pugi::xml_document const & records) = 0;
+  // Loads the journal records appended after the last Save() as the children of |journal|.
+  virtual bool LoadJournal(pugi::xml_document & journal) = 0;
   virtual bool Reset() = 0;
 };
 
@@ -25,6 +32,8 @@ public:
   // StorageBase overrides:
   bool Save(pugi::xml_document const & doc) override;
   bool Load(pugi::xml_document & doc) override;
+  bool Append(pugi::xml_document const & records) override;
+  bool LoadJournal(pugi::xml_document & journal) override;
   bool Reset() override;
 
 private:
@@ -39,9 +48,12 @@ public:
   // StorageBase overrides:
   bool Save(pugi::xml_document const & doc) override;
   bool Load(pugi::xml_document & doc) override;
+  bool Append(pugi::xml_document const & records) override;
+  bool LoadJournal(pugi::xml_document & journal) override;
   bool Reset() override;
 
 private:
   pugi::xml_document m_doc;
+  pugi::xml_document m_journal;
 };
 }  // namespace editor
@@ -77,6 +77,14 @@ public:
     return InMemoryStorage::Save(doc);
   }
 
+  bool Append(pugi::xml_document const & records) override
+  {
+    if (!m_allowSave)
+      return false;
+
+    return InMemoryStorage::Append(records);
+  }
+
   bool Reset() override
   {
     if (!m_allowSave)
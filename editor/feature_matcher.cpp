@@ -2,6 +2,7 @@
 
 #include "geometry/intersection_score.hpp"
 #include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
 
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
@@ -10,6 +11,7 @@
 #include <algorithm>
 #include <functional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 using editor::XMLFeature;
@@ -26,31 +28,67 @@ using Linestring = bg::model::linestring<PointXY>;
 using MultiLinestring = bg::model::multi_linestring<Linestring>;
 using AreaType = bg::default_area_result<Polygon>::type;
 
-using ForEachRefFn = std::function<void(XMLFeature const & xmlFt)>;
+using ForEachRefFn = std::function<void(m2::PointD const & point)>;
 using ForEachWayFn = std::function<void(pugi::xml_node const & way, std::string const & role)>;
 
 double const kPointDiffEps = 1e-5;
 
-void AddInnerIfNeeded(pugi::xml_document const & osmResponse, pugi::xml_node const & way,
-                      Polygon & dest)
+/// Nodes and ways of an OSM response by their ids. Refs of ways and relations are resolved
+/// with it instead of an xpath query over the whole response for each ref.
+class OsmResponse
+{
+public:
+  explicit OsmResponse(pugi::xml_document const & osmResponse)
+  {
+    for (auto const & node : osmResponse.child("osm").children("node"))
+      m_nodes.emplace(node.attribute("id").as_ullong(), node);
+    for (auto const & way : osmResponse.child("osm").children("way"))
+      m_ways.emplace(way.attribute("id").as_ullong(), way);
+  }
+
+  /// Throws editor::InvalidXML or editor::NoLatLon when there is no valid node with |ref|.
+  m2::PointD const & GetNodePoint(uint64_t ref) const
+  {
+    auto const pointIt = m_points.find(ref);
+    if (pointIt != m_points.cend())
+      return pointIt->second;
+
+    auto const nodeIt = m_nodes.find(ref);
+    ASSERT(nodeIt != m_nodes.cend(),
+           ("OSM response have ref", ref, "but have no node with such id."));
+    XMLFeature const xmlFt(nodeIt != m_nodes.cend() ? nodeIt->second : pugi::xml_node());
+    return m_points.emplace(ref, xmlFt.GetMercatorCenter()).first->second;
+  }
+
+  pugi::xml_node GetWay(uint64_t ref) const
+  {
+    auto const it = m_ways.find(ref);
+    return it != m_ways.cend() ? it->second : pugi::xml_node();
+  }
+
+private:
+  std::unordered_map<uint64_t, pugi::xml_node> m_nodes;
+  std::unordered_map<uint64_t, pugi::xml_node> m_ways;
+  mutable std::unordered_map<uint64_t, m2::PointD> m_points;
+};
+
+void AddInnerIfNeeded(OsmResponse const & osmResponse, pugi::xml_node const & way, Polygon & dest)
 {
   if (dest.inners().empty() || dest.inners().back().empty())
     return;
 
-  auto const refs = way.select_nodes("nd/@ref");
-  if (refs.empty())
+  auto const nd = way.child("nd");
+  if (!nd)
     return;
 
-  std::string const nodeRef = refs[0].attribute().value();
-  auto const node = osmResponse.select_node(("osm/node[@id='" + nodeRef + "']").data()).node();
-  ASSERT(node, ("OSM response have ref", nodeRef, "but have no node with such id.", osmResponse));
-  XMLFeature xmlFt(node);
-
   auto const & pt = dest.inners().back().back();
   m2::PointD lastPoint(pt.x(), pt.y());
 
-  if (lastPoint.EqualDxDy(xmlFt.GetMercatorCenter(), kPointDiffEps))
+  if (lastPoint.EqualDxDy(osmResponse.GetNodePoint(nd.attribute("ref").as_ullong()),
+                          kPointDiffEps))
+  {
     return;
+  }
 
   dest.inners().emplace_back();
 }
@@ -77,31 +115,22 @@ double ScoreLatLon(XMLFeature const & xmlFt, ms::LatLon const & latLon)
   return 1.0 - (a.Length(b) / kPointDiffEps);
 }
 
-void ForEachRefInWay(pugi::xml_document const & osmResponse, pugi::xml_node const & way,
+void ForEachRefInWay(OsmResponse const & osmResponse, pugi::xml_node const & way,
                      ForEachRefFn const & fn)
 {
-  for (auto const & xNodeRef : way.select_nodes("nd/@ref"))
-  {
-    std::string const nodeRef = xNodeRef.attribute().value();
-    auto const node = osmResponse.select_node(("osm/node[@id='" + nodeRef + "']").data()).node();
-    ASSERT(node, ("OSM response have ref", nodeRef, "but have no node with such id.", osmResponse));
-    XMLFeature xmlFt(node);
-    fn(xmlFt);
-  }
+  for (auto const & nd : way.children("nd"))
+    fn(osmResponse.GetNodePoint(nd.attribute("ref").as_ullong()));
 }
 
-void ForEachWayInRelation(pugi::xml_document const & osmResponse, pugi::xml_node const & relation,
+void ForEachWayInRelation(OsmResponse const & osmResponse, pugi::xml_node const & relation,
                           ForEachWayFn const & fn)
 {
-  auto const nodesSet = relation.select_nodes("member[@type='way']/@ref");
-  for (auto const & xNodeRef : nodesSet)
+  auto const members = relation.select_nodes("member[@type='way']");
+  for (auto const & xMember : members)
   {
-    std::string const wayRef = xNodeRef.attribute().value();
-    auto const xpath = "osm/way[@id='" + wayRef + "']";
-    auto const way = osmResponse.select_node(xpath.c_str()).node();
-
-    auto const rolePath = "member[@ref='" + wayRef + "']/@role";
-    pugi::xpath_node roleNode = relation.select_node(rolePath.c_str());
+    auto const member = xMember.node();
+    auto const way = osmResponse.GetWay(member.attribute("ref").as_ullong());
+    auto const roleAttr = member.attribute("role");
 
     // It is possible to have a wayRef that refers to a way not included in a given relation.
     // We can skip such ways.
@@ -110,25 +139,43 @@ void ForEachWayInRelation(pugi::xml_document const & osmResponse, pugi::xml_node
 
     // If more than one way is given and there is one with no role specified,
     // it's an error. We skip this particular way but try to use others anyway.
-    if (!roleNode && nodesSet.size() != 1)
+    if (!roleAttr && members.size() != 1)
       continue;
 
-    std::string const role = roleNode ? roleNode.attribute().value() : "outer";
+    std::string const role = roleAttr ? roleAttr.value() : "outer";
     fn(way, role);
   }
 }
 
 template <typename Geometry>
-void AppendWay(pugi::xml_document const & osmResponse, pugi::xml_node const & way, Geometry & dest)
+void AppendWay(OsmResponse const & osmResponse, pugi::xml_node const & way, Geometry & dest)
 {
-  ForEachRefInWay(osmResponse, way, [&dest](XMLFeature const & xmlFt)
+  ForEachRefInWay(osmResponse, way, [&dest](m2::PointD const & p)
   {
-    auto const & p = xmlFt.GetMercatorCenter();
     bg::append(dest, boost::make_tuple(p.x, p.y));
   });
 }
 
-Polygon GetWaysGeometry(pugi::xml_document const & osmResponse, pugi::xml_node const & way)
+/// Returns the bounding rect of the nodes of |wayOrRelation|. It's much cheaper than building
+/// the polygon, so candidates which are far from our geometry are skipped with it.
+m2::RectD GetWaysOrRelationsRect(OsmResponse const & osmResponse,
+                                 pugi::xml_node const & wayOrRelation)
+{
+  m2::RectD rect;
+  auto const addWay = [&osmResponse, &rect](pugi::xml_node const & way)
+  {
+    ForEachRefInWay(osmResponse, way, [&rect](m2::PointD const & p) { rect.Add(p); });
+  };
+
+  if (strcmp(wayOrRelation.name(), "way") == 0)
+    addWay(wayOrRelation);
+  else
+    ForEachWayInRelation(osmResponse, wayOrRelation,
+                         [&addWay](pugi::xml_node const & way, std::string const &) { addWay(way); });
+  return rect;
+}
+
+Polygon GetWaysGeometry(OsmResponse const & osmResponse, pugi::xml_node const & way)
 {
   Polygon result;
   AppendWay(osmResponse, way, result);
@@ -138,8 +185,7 @@ Polygon GetWaysGeometry(pugi::xml_document const & osmResponse, pugi::xml_node c
   return result;
 }
 
-Polygon GetRelationsGeometry(pugi::xml_document const & osmResponse,
-                             pugi::xml_node const & relation)
+Polygon GetRelationsGeometry(OsmResponse const & osmResponse, pugi::xml_node const & relation)
 {
   Polygon result;
   MultiLinestring outerLines;
@@ -171,7 +217,7 @@ Polygon GetRelationsGeometry(pugi::xml_document const & osmResponse,
   return result;
 }
 
-Polygon GetWaysOrRelationsGeometry(pugi::xml_document const & osmResponse,
+Polygon GetWaysOrRelationsGeometry(OsmResponse const & osmResponse,
                                    pugi::xml_node const & wayOrRelation)
 {
   if (strcmp(wayOrRelation.name(), "way") == 0)
@@ -182,22 +228,19 @@ Polygon GetWaysOrRelationsGeometry(pugi::xml_document const & osmResponse,
 /// Returns value form [-1, 1]. Negative values are used as penalty, positive as score.
 /// |osmResponse| - nodes, ways and relations from osm;
 /// |wayOrRelation| - either way or relation to be compared agains ourGeometry;
-/// |ourGeometry| - geometry of a FeatureType;
-double ScoreGeometry(pugi::xml_document const & osmResponse, pugi::xml_node const & wayOrRelation,
-                     std::vector<m2::PointD> const & ourGeometry)
+/// |our| - united triangles of a FeatureType and |ourRect| is their bounding rect.
+double ScoreGeometry(OsmResponse const & osmResponse, pugi::xml_node const & wayOrRelation,
+                     MultiPolygon const & our, m2::RectD const & ourRect)
 {
-  ASSERT(!ourGeometry.empty(), ("Our geometry cannot be empty"));
+  // Geometries without common points have zero score.
+  if (!ourRect.IsIntersect(GetWaysOrRelationsRect(osmResponse, wayOrRelation)))
+    return geometry::kPenaltyScore;
 
   auto const their = GetWaysOrRelationsGeometry(osmResponse, wayOrRelation);
 
   if (bg::is_empty(their))
     return geometry::kPenaltyScore;
 
-  auto const our = geometry::TrianglesToPolygon(ourGeometry);
-
-  if (bg::is_empty(our))
-    return geometry::kPenaltyScore;
-
   auto const score = geometry::GetIntersectionScore(our, their);
 
   // If area of the intersection is a half of the object area, penalty score will be returned.
@@ -248,13 +291,29 @@ pugi::xml_node GetBestOsmNode(pugi::xml_document const & osmResponse, ms::LatLon
 pugi::xml_node GetBestOsmWayOrRelation(pugi::xml_document const & osmResponse,
                                        std::vector<m2::PointD> const & geometry)
 {
+  ASSERT(!geometry.empty(), ("Our geometry cannot be empty"));
+
   double bestScore = geometry::kPenaltyScore;
   pugi::xml_node bestMatchWay;
 
-  auto const xpath = "osm/way|osm/relation[tag[@k='type' and @v='multipolygon']]";
-  for (auto const & xWayOrRelation : osmResponse.select_nodes(xpath))
+  auto const candidates =
+      osmResponse.select_nodes("osm/way|osm/relation[tag[@k='type' and @v='multipolygon']]");
+  if (candidates.empty())
+    return bestMatchWay;
+
+  // Our geometry is the same for all the candidates, so it's united and validated once.
+  auto const our = geometry::TrianglesToPolygon(geometry);
+  if (bg::is_empty(our))
+    return bestMatchWay;
+
+  m2::RectD ourRect;
+  for (auto const & p : geometry)
+    ourRect.Add(p);
+
+  OsmResponse const response(osmResponse);
+  for (auto const & xWayOrRelation : candidates)
   {
-    double const nodeScore = ScoreGeometry(osmResponse, xWayOrRelation.node(), geometry);
+    double const nodeScore = ScoreGeometry(response, xWayOrRelation.node(), our, ourRect);
 
     if (nodeScore < 0)
       continue;
@@ -17,11 +17,13 @@
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/string_utils.hpp"
 #include "base/thread_checker.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 #include <sstream>
 
 #include "3party/opening_hours/opening_hours.hpp"
@@ -44,6 +46,13 @@ constexpr char const * kDeleteSection = "delete";
 constexpr char const * kModifySection = "modify";
 constexpr char const * kCreateSection = "create";
 constexpr char const * kObsoleteSection = "obsolete";
+constexpr char const * kJournalRecordNode = "record";
+constexpr char const * kJournalIdAttr = "journal_id";
+/// Records which remove a feature from the edits have no section.
+constexpr char const * kRemovedSection = "";
+constexpr char const * kMwmIndexAttr = "mwm_file_index";
+/// Edits are saved in full when the journal becomes that long.
+size_t constexpr kMaxJournalRecords = 256;
 /// We store edited streets in OSM-compatible way.
 constexpr char const * kAddrStreetTag = "addr:street";
 
@@ -70,6 +79,27 @@ std::array<XmlSection, 4> constexpr kXmlSections = {
     {FeatureStatus::Created, kCreateSection}}
 };
 
+char const * GetSectionName(FeatureStatus status)
+{
+  for (auto const & section : kXmlSections)
+  {
+    if (section.m_status == status)
+      return section.m_sectionName;
+  }
+  CHECK(false, ("Not edited features shouldn't be here."));
+  return kRemovedSection;
+}
+
+xml_node AppendMwmNode(xml_node root, std::string const & name, int64_t version)
+{
+  xml_node mwmNode = root.append_child(kXmlMwmNode);
+  mwmNode.append_attribute("name") = name.c_str();
+  mwmNode.append_attribute("version") = static_cast<long long>(version);
+  for (auto const * section : {kDeleteSection, kModifySection, kCreateSection, kObsoleteSection})
+    mwmNode.append_child(section);
+  return mwmNode;
+}
+
 struct LogHelper
 {
   explicit LogHelper(MwmSet::MwmId const & mwmId) : m_mwmId(mwmId) {}
@@ -159,12 +189,15 @@ void Editor::LoadEdits()
   }
 
   xml_document doc;
+  xml_document journal;
   bool needRewriteEdits = false;
 
-  if (!m_storage->Load(doc))
+  if (!m_storage->Load(doc) || !m_storage->LoadJournal(journal))
     return;
 
-  m_features.Set(make_shared<FeaturesContainer>());
+  ApplyJournal(journal, doc);
+
+  SetFeatures(make_shared<FeaturesContainer>());
   auto loadedFeatures = make_shared<FeaturesContainer>();
 
   auto rootNode = doc.child(kXmlRootNode);
@@ -196,62 +229,48 @@ void Editor::LoadEdits()
   if (needRewriteEdits)
     SaveTransaction(loadedFeatures);
   else
-    m_features.Set(loadedFeatures);
+    SetFeatures(loadedFeatures);
 }
 
-bool Editor::Save(FeaturesContainer const & features) const
+bool Editor::Save(FeaturesContainer const & features)
 {
+  // There is no document without edits, the journal of the default id starts from scratch.
   if (features.empty())
+  {
+    m_journalId = 0;
+    m_journalRecordsCount = 0;
     return m_storage->Reset();
+  }
+
+  // Records of the previous journal are outdated when the edits are saved in full.
+  uint64_t const journalId = m_journalId + 1;
 
   xml_document doc;
   xml_node root = doc.append_child(kXmlRootNode);
   // Use format_version for possible future format changes.
   root.append_attribute("format_version") = 1;
+  root.append_attribute(kJournalIdAttr) = static_cast<unsigned long long>(journalId);
   for (auto const & mwm : features)
   {
     if (!mwm.first.IsAlive())
       continue;
 
-    xml_node mwmNode = root.append_child(kXmlMwmNode);
-    mwmNode.append_attribute("name") = mwm.first.GetInfo()->GetCountryName().c_str();
-    mwmNode.append_attribute("version") = static_cast<long long>(mwm.first.GetInfo()->GetVersion());
-    xml_node const deleted = mwmNode.append_child(kDeleteSection);
-    xml_node const modified = mwmNode.append_child(kModifySection);
-    xml_node const created = mwmNode.append_child(kCreateSection);
-    xml_node const obsolete = mwmNode.append_child(kObsoleteSection);
+    xml_node mwmNode = AppendMwmNode(root, mwm.first.GetInfo()->GetCountryName(),
+                                     mwm.first.GetInfo()->GetVersion());
     for (auto & index : mwm.second)
     {
       FeatureTypeInfo const & fti = index.second;
-      // TODO: Do we really need to serialize deleted features in full details? Looks like mwm ID
-      // and meta fields are enough.
-      XMLFeature xf =
-          editor::ToXML(fti.m_object, true /* type serializing helps during migration */);
-      xf.SetMWMFeatureIndex(index.first);
-      if (!fti.m_street.empty())
-        xf.SetTagValue(kAddrStreetTag, fti.m_street);
-      ASSERT_NOT_EQUAL(0, fti.m_modificationTimestamp, ());
-      xf.SetModificationTime(fti.m_modificationTimestamp);
-      if (fti.m_uploadAttemptTimestamp != base::INVALID_TIME_STAMP)
-      {
-        xf.SetUploadTime(fti.m_uploadAttemptTimestamp);
-        ASSERT(!fti.m_uploadStatus.empty(), ("Upload status updates with upload timestamp."));
-        xf.SetUploadStatus(fti.m_uploadStatus);
-        if (!fti.m_uploadError.empty())
-          xf.SetUploadError(fti.m_uploadError);
-      }
-      switch (fti.m_status)
-      {
-      case FeatureStatus::Deleted: VERIFY(xf.AttachToParentNode(deleted), ()); break;
-      case FeatureStatus::Modified: VERIFY(xf.AttachToParentNode(modified), ()); break;
-      case FeatureStatus::Created: VERIFY(xf.AttachToParentNode(created), ()); break;
-      case FeatureStatus::Obsolete: VERIFY(xf.AttachToParentNode(obsolete), ()); break;
-      case FeatureStatus::Untouched: CHECK(false, ("Not edited features shouldn't be here."));
-      }
+      VERIFY(ToXML(index.first, fti).AttachToParentNode(mwmNode.child(GetSectionName(fti.m_status))),
+             ());
     }
   }
 
-  return m_storage->Save(doc);
+  if (!m_storage->Save(doc))
+    return false;
+
+  m_journalId = journalId;
+  m_journalRecordsCount = 0;
+  return true;
 }
 
 bool Editor::SaveTransaction(std::shared_ptr<FeaturesContainer> const & features)
@@ -259,10 +278,134 @@ bool Editor::SaveTransaction(std::shared_ptr<FeaturesContainer> const & features
   if (!Save(*features))
     return false;
 
-  m_features.Set(features);
+  SetFeatures(features);
   return true;
 }
 
+bool Editor::SaveTransaction(std::shared_ptr<FeaturesContainer> const & features,
+                             FeatureID const & fid)
+{
+  if (!fid.m_mwmId.IsAlive())
+    return SaveTransaction(features);
+
+  xml_document records;
+  xml_node record = records.append_child(kJournalRecordNode);
+  record.append_attribute(kJournalIdAttr) = static_cast<unsigned long long>(m_journalId);
+  record.append_attribute("name") = fid.m_mwmId.GetInfo()->GetCountryName().c_str();
+  record.append_attribute("version") = static_cast<long long>(fid.m_mwmId.GetInfo()->GetVersion());
+  record.append_attribute(kMwmIndexAttr) = fid.m_index;
+
+  auto const * fti = GetFeatureTypeInfo(*features, fid.m_mwmId, fid.m_index);
+  record.append_attribute("section") = fti ? GetSectionName(fti->m_status) : kRemovedSection;
+  if (fti)
+    VERIFY(ToXML(fid.m_index, *fti).AttachToParentNode(record), ());
+
+  if (!m_storage->Append(records))
+    return false;
+
+  SetFeatures(features);
+
+  // The change is in the journal already, so the edits are consistent if saving fails.
+  if (++m_journalRecordsCount >= kMaxJournalRecords)
+    Save(*features);
+  return true;
+}
+
+void Editor::SetFeatures(std::shared_ptr<FeaturesContainer> const & features)
+{
+  auto createdFeatures = make_shared<CreatedFeaturesIndex>();
+  auto editedFeatures = make_shared<EditedFeaturesIndex>();
+  for (auto const & [mwmId, mwmFeatures] : *features)
+  {
+    // Indices are sorted, so the created features go after the edited mwm features.
+    auto const createdBegin =
+        mwmFeatures.lower_bound(feature::FakeFeatureIds::kEditorCreatedFeaturesStart);
+    std::vector<bool> edited(
+        createdBegin == mwmFeatures.cbegin() ? 0 : std::prev(createdBegin)->first + 1);
+    for (auto it = mwmFeatures.cbegin(); it != createdBegin; ++it)
+      edited[it->first] = true;
+    editedFeatures->emplace(mwmId, std::move(edited));
+
+    std::vector<std::pair<m2::PointD, uint32_t>> created;
+    for (auto const & [index, fti] : mwmFeatures)
+    {
+      if (fti.m_status == FeatureStatus::Created)
+        created.emplace_back(fti.m_object.GetMercator(), index);
+    }
+
+    if (created.empty())
+      continue;
+
+    std::sort(created.begin(), created.end(),
+              [](auto const & lhs, auto const & rhs) { return lhs.first.x < rhs.first.x; });
+    createdFeatures->emplace(mwmId, std::move(created));
+  }
+
+  m_features.Set(features);
+  m_createdFeatures.Set(createdFeatures);
+  m_editedFeatures.Set(editedFeatures);
+  m_hasEdits = !features->empty();
+}
+
+bool Editor::MayBeEdited(MwmId const & mwmId, uint32_t index) const
+{
+  if (!m_hasEdits)
+    return false;
+
+  if (feature::FakeFeatureIds::IsEditorCreatedFeature(index))
+    return true;
+
+  auto const editedFeatures = m_editedFeatures.Get();
+  auto const it = editedFeatures->find(mwmId);
+  return it != editedFeatures->cend() && index < it->second.size() && it->second[index];
+}
+
+void Editor::ApplyJournal(xml_document const & journal, xml_document & doc)
+{
+  auto rootNode = doc.child(kXmlRootNode);
+  // Migrate clients with an old root node.
+  if (!rootNode)
+    rootNode = doc.child("mapsme");
+
+  m_journalId = rootNode.attribute(kJournalIdAttr).as_ullong(0);
+  m_journalRecordsCount = 0;
+
+  for (auto const & record : journal.children(kJournalRecordNode))
+  {
+    if (record.attribute(kJournalIdAttr).as_ullong(0) != m_journalId)
+      continue;
+
+    if (!rootNode)
+      rootNode = doc.append_child(kXmlRootNode);
+
+    string const mapName = record.attribute("name").as_string("");
+    int64_t const mapVersion = record.attribute("version").as_llong(0);
+    auto const index = record.attribute(kMwmIndexAttr).as_uint(0);
+
+    auto mwmNode = rootNode.find_child_by_attribute(kXmlMwmNode, "name", mapName.c_str());
+    if (!mwmNode)
+      mwmNode = AppendMwmNode(rootNode, mapName, mapVersion);
+    else if (mwmNode.attribute("version").as_llong(0) != mapVersion)
+      continue;
+
+    for (auto const & section : kXmlSections)
+    {
+      auto sectionNode = mwmNode.child(section.m_sectionName);
+      if (auto const node = sectionNode.find_child_by_attribute(kMwmIndexAttr,
+                                                                 strings::to_string(index).c_str()))
+      {
+        sectionNode.remove_child(node);
+      }
+    }
+
+    string const sectionName = record.attribute("section").as_string(kRemovedSection);
+    if (sectionName != kRemovedSection)
+      mwmNode.child(sectionName.c_str()).append_copy(record.first_child());
+
+    ++m_journalRecordsCount;
+  }
+}
+
 void Editor::ClearAllLocalEdits()
 {
   CHECK_THREAD_CHECKER(MainThreadChecker, (""));
@@ -279,18 +422,27 @@ void Editor::OnMapRegistered(platform::LocalCountryFile const &)
 
 FeatureStatus Editor::GetFeatureStatus(MwmId const & mwmId, uint32_t index) const
 {
+  if (!MayBeEdited(mwmId, index))
+    return FeatureStatus::Untouched;
+
   auto const features = m_features.Get();
   return GetFeatureStatusImpl(*features, mwmId, index);
 }
 
 FeatureStatus Editor::GetFeatureStatus(FeatureID const & fid) const
 {
+  if (!MayBeEdited(fid.m_mwmId, fid.m_index))
+    return FeatureStatus::Untouched;
+
   auto const features = m_features.Get();
   return GetFeatureStatusImpl(*features, fid.m_mwmId, fid.m_index);
 }
 
 bool Editor::IsFeatureUploaded(MwmId const & mwmId, uint32_t index) const
 {
+  if (!MayBeEdited(mwmId, index))
+    return false;
+
   auto const features = m_features.Get();
   return IsFeatureUploadedImpl(*features, mwmId, index);
 }
@@ -311,13 +463,13 @@ void Editor::DeleteFeature(FeatureID const & fid)
     if (f != mwm->second.end() && f->second.m_status == FeatureStatus::Created)
     {
       mwm->second.erase(f);
-      SaveTransaction(editableFeatures);
+      SaveTransaction(editableFeatures, fid);
       return;
     }
   }
 
   MarkFeatureWithStatus(*editableFeatures, fid, FeatureStatus::Deleted);
-  SaveTransaction(editableFeatures);
+  SaveTransaction(editableFeatures, fid);
   Invalidate();
 }
 
@@ -426,7 +578,7 @@ Editor::SaveResult Editor::SaveEditedFeature(EditableMapObject const & emo)
   auto editableFeatures = make_shared<FeaturesContainer>(*features);
   (*editableFeatures)[fid.m_mwmId][fid.m_index] = std::move(fti);
 
-  bool const savedSuccessfully = SaveTransaction(editableFeatures);
+  bool const savedSuccessfully = SaveTransaction(editableFeatures, fid);
 
   Invalidate();
   return savedSuccessfully ? SaveResult::SavedSuccessfully : SaveResult::NoFreeSpaceError;
@@ -445,26 +597,30 @@ bool Editor::RollBackChanges(FeatureID const & fid)
 void Editor::ForEachCreatedFeature(MwmId const & id, FeatureIndexFunctor const & f,
                                    m2::RectD const & rect, int /*scale*/) const
 {
-  auto const features = m_features.Get();
+  if (!m_hasEdits)
+    return;
+
+  auto const createdFeatures = m_createdFeatures.Get();
 
-  auto const mwmFound = features->find(id);
-  if (mwmFound == features->cend())
+  auto const mwmFound = createdFeatures->find(id);
+  if (mwmFound == createdFeatures->cend())
     return;
 
-  // Process only new (created) features.
-  for (auto const & index : mwmFound->second)
+  auto const & created = mwmFound->second;
+  auto it = std::lower_bound(created.cbegin(), created.cend(), rect.minX(),
+                             [](auto const & item, double x) { return item.first.x < x; });
+  for (; it != created.cend() && it->first.x <= rect.maxX(); ++it)
   {
-    FeatureTypeInfo const & ftInfo = index.second;
-    if (ftInfo.m_status == FeatureStatus::Created)
-    {
-      if (rect.IsPointInside(ftInfo.m_object.GetMercator()))
-        f(index.first);
-    }
+    if (rect.IsPointInside(it->first))
+      f(it->second);
   }
 }
 
 std::optional<osm::EditableMapObject> Editor::GetEditedFeature(FeatureID const & fid) const
 {
+  if (!MayBeEdited(fid.m_mwmId, fid.m_index))
+    return {};
+
   auto const features = m_features.Get();
   auto const * featureInfo = GetFeatureTypeInfo(*features, fid.m_mwmId, fid.m_index);
   if (featureInfo == nullptr)
@@ -475,6 +631,9 @@ std::optional<osm::EditableMapObject> Editor::GetEditedFeature(FeatureID const &
 
 bool Editor::GetEditedFeatureStreet(FeatureID const & fid, string & outFeatureStreet) const
 {
+  if (!MayBeEdited(fid.m_mwmId, fid.m_index))
+    return false;
+
   auto const features = m_features.Get();
   auto const * featureInfo = GetFeatureTypeInfo(*features, fid.m_mwmId, fid.m_index);
   if (featureInfo == nullptr)
@@ -803,7 +962,29 @@ void Editor::SaveUploadedInformation(FeatureID const & fid, UploadInfo const & u
   fti.m_uploadStatus = uploadInfo.m_uploadStatus;
   fti.m_uploadError = uploadInfo.m_uploadError;
 
-  SaveTransaction(editableFeatures);
+  SaveTransaction(editableFeatures, fid);
+}
+
+// static
+XMLFeature Editor::ToXML(uint32_t index, FeatureTypeInfo const & fti)
+{
+  // TODO: Do we really need to serialize deleted features in full details? Looks like mwm ID
+  // and meta fields are enough.
+  XMLFeature xf = editor::ToXML(fti.m_object, true /* type serializing helps during migration */);
+  xf.SetMWMFeatureIndex(index);
+  if (!fti.m_street.empty())
+    xf.SetTagValue(kAddrStreetTag, fti.m_street);
+  ASSERT_NOT_EQUAL(0, fti.m_modificationTimestamp, ());
+  xf.SetModificationTime(fti.m_modificationTimestamp);
+  if (fti.m_uploadAttemptTimestamp != base::INVALID_TIME_STAMP)
+  {
+    xf.SetUploadTime(fti.m_uploadAttemptTimestamp);
+    ASSERT(!fti.m_uploadStatus.empty(), ("Upload status updates with upload timestamp."));
+    xf.SetUploadStatus(fti.m_uploadStatus);
+    if (!fti.m_uploadError.empty())
+      xf.SetUploadError(fti.m_uploadError);
+  }
+  return xf;
 }
 
 bool Editor::FillFeatureInfo(FeatureStatus status, XMLFeature const & xml, FeatureID const & fid,
@@ -873,7 +1054,7 @@ bool Editor::RemoveFeatureIfExists(FeatureID const & fid)
   if (matchedMwm->second.empty())
     editableFeatures->erase(matchedMwm);
 
-  return SaveTransaction(editableFeatures);
+  return SaveTransaction(editableFeatures, fid);
 }
 
 void Editor::Invalidate()
@@ -897,7 +1078,7 @@ bool Editor::MarkFeatureAsObsolete(FeatureID const & fid)
   }
 
   MarkFeatureWithStatus(*editableFeatures, fid, FeatureStatus::Obsolete);
-  auto const result = SaveTransaction(editableFeatures);
+  auto const result = SaveTransaction(editableFeatures, fid);
   Invalidate();
 
   return result;
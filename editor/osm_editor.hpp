@@ -12,6 +12,7 @@
 #include "indexer/feature_source.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
 #include "base/atomic_shared_ptr.hpp"
@@ -194,11 +195,25 @@ private:
   };
 
   using FeaturesContainer = std::map<MwmId, std::map<uint32_t, FeatureTypeInfo>>;
+  /// Centers and indices of the created features sorted by x for rect queries.
+  using CreatedFeaturesIndex = std::map<MwmId, std::vector<std::pair<m2::PointD, uint32_t>>>;
+  /// Bits of the indices of the mwm features which have edits. Indices of the created features
+  /// are too large for a bitset, such features are looked up in the edits.
+  using EditedFeaturesIndex = std::map<MwmId, std::vector<bool>>;
 
+  /// Saves all edits and starts a new journal.
   /// @returns false if fails.
-  bool Save(FeaturesContainer const & features) const;
+  bool Save(FeaturesContainer const & features);
   bool SaveTransaction(std::shared_ptr<FeaturesContainer> const & features);
+  /// Saves the change of |fid| only, it's appended to the journal.
+  bool SaveTransaction(std::shared_ptr<FeaturesContainer> const & features, FeatureID const & fid);
+  void SetFeatures(std::shared_ptr<FeaturesContainer> const & features);
+  /// Applies the journal records of the current journal to the edits document.
+  void ApplyJournal(pugi::xml_document const & journal, pugi::xml_document & doc);
   bool RemoveFeatureIfExists(FeatureID const & fid);
+  /// @returns false if the feature has no edits for sure. It's much cheaper than a lookup in
+  /// m_features, most of the features aren't edited.
+  bool MayBeEdited(MwmId const & mwmId, uint32_t index) const;
   /// Notify framework that something has changed and should be redisplayed.
   void Invalidate();
 
@@ -211,6 +226,7 @@ private:
 
   bool FillFeatureInfo(FeatureStatus status, editor::XMLFeature const & xml, FeatureID const & fid,
                        FeatureTypeInfo & fti) const;
+  static editor::XMLFeature ToXML(uint32_t index, FeatureTypeInfo const & fti);
   /// @returns pointer to m_features[id][index] if exists, nullptr otherwise.
   static FeatureTypeInfo const * GetFeatureTypeInfo(FeaturesContainer const & features, MwmId const & mwmId,
                                                     uint32_t index);
@@ -236,6 +252,14 @@ private:
 
   /// Deleted, edited and created features.
   base::AtomicSharedPtr<FeaturesContainer> m_features;
+  base::AtomicSharedPtr<CreatedFeaturesIndex> m_createdFeatures;
+  base::AtomicSharedPtr<EditedFeaturesIndex> m_editedFeatures;
+  /// Lets the queries skip taking the snapshots when there are no edits at all.
+  std::atomic<bool> m_hasEdits{false};
+
+  /// Id of the journal of the saved edits, journal records of other ids are outdated.
+  uint64_t m_journalId = 0;
+  size_t m_journalRecordsCount = 0;
 
   std::unique_ptr<Delegate> m_delegate;
 
@@ -21,7 +21,6 @@
 #include "base/checked_cast.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
-#include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
@@ -42,10 +41,18 @@ namespace
 {
 using namespace routing;
 
+// Road points are looked up in batches of this size to group them by SRTM tiles.
+size_t constexpr kAltitudesBatchSize = 1 << 21;
+// Each tile takes ~25Mb in memory.
+size_t constexpr kMaxSrtmTilesCount = 64;
+
 class SrtmGetter : public AltitudeGetter
 {
 public:
-  explicit SrtmGetter(std::string const & srtmDir) : m_srtmManager(srtmDir) {}
+  SrtmGetter(std::string const & srtmDir, size_t threadsCount)
+    : m_srtmManager(srtmDir, std::max(kMaxSrtmTilesCount, threadsCount)), m_threadsCount(threadsCount)
+  {
+  }
 
   // AltitudeGetter overrides:
   geometry::Altitude GetAltitude(m2::PointD const & p) override
@@ -53,8 +60,18 @@ public:
     return m_srtmManager.GetHeight(mercator::ToLatLon(p));
   }
 
+  void GetAltitudes(std::vector<m2::PointD> const & points, geometry::Altitudes & altitudes) override
+  {
+    std::vector<ms::LatLon> coords;
+    coords.reserve(points.size());
+    for (auto const & p : points)
+      coords.push_back(mercator::ToLatLon(p));
+    m_srtmManager.GetHeights(coords, altitudes, m_threadsCount);
+  }
+
 private:
   generator::SrtmTileManager m_srtmManager;
+  size_t m_threadsCount;
 };
 
 class Processor
@@ -96,9 +113,8 @@ public:
       return;
     }
 
-    bool hasAltitude = false;
-    SCOPE_GUARD(altitudeAvailabilityBuilding,
-                [&]() { m_altitudeAvailabilityBuilder.push_back(hasAltitude); });
+    // Availability is set when the feature's altitudes are known, see Flush().
+    m_altitudeAvailabilityBuilder.push_back(false);
 
     if (!routing::IsRoad(feature::TypesHolder(f)))
       return;
@@ -108,32 +124,46 @@ public:
     if (pointsCount == 0)
       return;
 
-    geometry::Altitudes altitudes;
-    geometry::Altitude minFeatureAltitude = geometry::kInvalidAltitude;
+    m_pendingFeatures.emplace_back(id, m_pendingPoints.size());
     for (size_t i = 0; i < pointsCount; ++i)
+      m_pendingPoints.push_back(f.GetPoint(i));
+
+    if (m_pendingPoints.size() >= kAltitudesBatchSize)
+      Flush();
+  }
+
+  // Gets altitudes of the collected road features. Must be called after the last feature.
+  void Flush()
+  {
+    geometry::Altitudes pointAltitudes;
+    m_altitudeGetter.GetAltitudes(m_pendingPoints, pointAltitudes);
+    CHECK_EQUAL(pointAltitudes.size(), m_pendingPoints.size(), ());
+
+    for (size_t i = 0; i < m_pendingFeatures.size(); ++i)
     {
-      geometry::Altitude const a = m_altitudeGetter.GetAltitude(f.GetPoint(i));
-      if (a == geometry::kInvalidAltitude)
-      {
-        // One invalid point invalidates the whole feature.
-        return;
-      }
+      auto const [id, begin] = m_pendingFeatures[i];
+      auto const end =
+          i + 1 < m_pendingFeatures.size() ? m_pendingFeatures[i + 1].second : pointAltitudes.size();
 
-      if (minFeatureAltitude == geometry::kInvalidAltitude)
-        minFeatureAltitude = a;
-      else
-        minFeatureAltitude = std::min(minFeatureAltitude, a);
+      auto const first = pointAltitudes.begin() + begin;
+      auto const last = pointAltitudes.begin() + end;
+      // One invalid point invalidates the whole feature.
+      if (std::find(first, last, geometry::kInvalidAltitude) != last)
+        continue;
 
-      altitudes.push_back(a);
-    }
+      geometry::Altitude const minFeatureAltitude = *std::min_element(first, last);
 
-    hasAltitude = true;
-    m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
+      m_altitudeAvailabilityBuilder.set(id, true);
+      m_featureAltitudes.emplace_back(id, Altitudes(geometry::Altitudes(first, last)));
 
-    if (m_minAltitude == geometry::kInvalidAltitude)
-      m_minAltitude = minFeatureAltitude;
-    else
-      m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+      if (m_minAltitude == geometry::kInvalidAltitude)
+        m_minAltitude = minFeatureAltitude;
+      else
+        m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+    }
+
+    m_pendingFeatures.clear();
+    m_pendingPoints.clear();
   }
 
   bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
@@ -149,6 +179,11 @@ private:
   TFeatureAltitudes m_featureAltitudes;
   succinct::bit_vector_builder m_altitudeAvailabilityBuilder;
   geometry::Altitude m_minAltitude;
+
+  // Road features and their points which are waiting for altitudes. Every feature is stored
+  // with the index of its first point.
+  std::vector<std::pair<uint32_t, size_t>> m_pendingFeatures;
+  std::vector<m2::PointD> m_pendingPoints;
 };
 }  // namespace
 
@@ -161,6 +196,7 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
     // Preparing altitude information.
     Processor processor(altitudeGetter);
     feature::ForEachFeature(mwmPath, processor);
+    processor.Flush();
 
     if (!processor.HasAltitudeInfo())
     {
@@ -233,10 +269,11 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
   }
 }
 
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir)
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        size_t threadsCount)
 {
   LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir));
-  SrtmGetter srtmGetter(srtmDir);
+  SrtmGetter srtmGetter(srtmDir, threadsCount);
   BuildRoadAltitudes(mwmPath, srtmGetter);
 }
 }  // namespace routing
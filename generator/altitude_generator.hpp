@@ -5,7 +5,9 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace routing
 {
@@ -13,6 +15,16 @@ class AltitudeGetter
 {
 public:
   virtual geometry::Altitude GetAltitude(m2::PointD const & p) = 0;
+
+  // Fills |altitudes| with altitudes of |points|. Override it when a batch of points
+  // can be processed faster than the points one by one.
+  virtual void GetAltitudes(std::vector<m2::PointD> const & points, geometry::Altitudes & altitudes)
+  {
+    altitudes.clear();
+    altitudes.reserve(points.size());
+    for (auto const & p : points)
+      altitudes.push_back(GetAltitude(p));
+  }
 };
 
 /// \brief Adds altitude section to mwm. It has the following format:
@@ -26,5 +38,6 @@ public:
 /// feat. table offset  feature table         alt. info offset - feat. table offset
 /// alt. info offset    altitude info         end of section - alt. info offset
 void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter);
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir);
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        size_t threadsCount = 1);
 }  // namespace routing
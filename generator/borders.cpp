@@ -22,6 +22,7 @@
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <functional>
@@ -38,6 +39,10 @@ namespace borders
 {
 namespace
 {
+// Bounds of the number of cells along a side of a country's cells index.
+size_t constexpr kMinCellsGridSide = 8;
+size_t constexpr kMaxCellsGridSide = 128;
+
 template <class ToDo>
 void ForEachCountry(std::string const & baseDir, ToDo && toDo)
 {
@@ -139,6 +144,18 @@ bool ReadPolygon(std::istream & stream, m2::RegionD & region, std::string const
 }  // namespace
 
 bool CountryPolygons::Contains(m2::PointD const & point) const
+{
+  switch (GetCellState(point))
+  {
+  case CellState::Outside: return false;
+  case CellState::Inside: return true;
+  case CellState::Unknown:
+  case CellState::Border: break;
+  }
+  return ContainsExactly(point);
+}
+
+bool CountryPolygons::ContainsExactly(m2::PointD const & point) const
 {
   return m_polygons.ForAnyInRect(m2::RectD(point, point), [&](auto const & rgn)
   {
@@ -146,6 +163,128 @@ bool CountryPolygons::Contains(m2::PointD const & point) const
   });
 }
 
+void CountryPolygons::BuildCellsIndex()
+{
+  m_cells.clear();
+
+  m2::RectD rect;
+  size_t pointsCount = 0;
+  m_polygons.ForEach([&](Polygon const & polygon)
+  {
+    rect.Add(polygon.GetRect());
+    pointsCount += polygon.Size();
+  });
+  if (rect.IsEmptyInterior())
+    return;
+
+  // Points which are closer than the contains epsilon to the border are tested exactly.
+  double const eps = 2 * GetContainsEpsilon();
+  rect.Inflate(eps, eps);
+
+  m_cellsRect = rect;
+  m_cellsSide = std::clamp(static_cast<size_t>(2 * std::sqrt(static_cast<double>(pointsCount))),
+                           kMinCellsGridSide, kMaxCellsGridSide);
+  m_cells.assign(m_cellsSide * m_cellsSide, CellState::Unknown);
+
+  double const cellSizeX = rect.SizeX() / m_cellsSide;
+  double const cellSizeY = rect.SizeY() / m_cellsSide;
+
+  auto const markBorderCells = [&](m2::PointD const & p1, m2::PointD const & p2)
+  {
+    m2::RectD segmentRect(p1, p2);
+    segmentRect.Inflate(eps, eps);
+    size_t const minX = GetCellIndex(segmentRect.LeftBottom()) % m_cellsSide;
+    size_t const minY = GetCellIndex(segmentRect.LeftBottom()) / m_cellsSide;
+    size_t const maxX = GetCellIndex(segmentRect.RightTop()) % m_cellsSide;
+    size_t const maxY = GetCellIndex(segmentRect.RightTop()) / m_cellsSide;
+    for (size_t y = minY; y <= maxY; ++y)
+    {
+      for (size_t x = minX; x <= maxX; ++x)
+        m_cells[y * m_cellsSide + x] = CellState::Border;
+    }
+  };
+
+  m_polygons.ForEach([&](Polygon const & polygon)
+  {
+    auto const & points = polygon.Data();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      auto const & p1 = points[i];
+      auto const & p2 = points[(i + 1) % points.size()];
+      // Long edges are split to pieces not longer than a cell, so that a diagonal edge
+      // doesn't mark all the cells of its rect.
+      auto const piecesCount = static_cast<size_t>(
+          std::max(std::abs(p2.x - p1.x) / cellSizeX, std::abs(p2.y - p1.y) / cellSizeY)) + 1;
+      for (size_t j = 0; j < piecesCount; ++j)
+      {
+        markBorderCells(p1 + (p2 - p1) * (static_cast<double>(j) / piecesCount),
+                        p1 + (p2 - p1) * (static_cast<double>(j + 1) / piecesCount));
+      }
+    }
+  });
+
+  // All the cells of a connected area without border cells are either inside or outside,
+  // so it's enough to test one point of the area.
+  std::vector<size_t> queue;
+  for (size_t start = 0; start < m_cells.size(); ++start)
+  {
+    if (m_cells[start] != CellState::Unknown)
+      continue;
+
+    m2::PointD const center(rect.minX() + (start % m_cellsSide + 0.5) * cellSizeX,
+                            rect.minY() + (start / m_cellsSide + 0.5) * cellSizeY);
+    auto const state = ContainsExactly(center) ? CellState::Inside : CellState::Outside;
+
+    m_cells[start] = state;
+    queue.assign(1, start);
+    while (!queue.empty())
+    {
+      size_t const cell = queue.back();
+      queue.pop_back();
+
+      size_t const x = cell % m_cellsSide;
+      size_t const y = cell / m_cellsSide;
+      auto const visit = [&](size_t neighbour)
+      {
+        if (m_cells[neighbour] != CellState::Unknown)
+          return;
+        m_cells[neighbour] = state;
+        queue.push_back(neighbour);
+      };
+
+      if (x > 0)
+        visit(cell - 1);
+      if (x + 1 < m_cellsSide)
+        visit(cell + 1);
+      if (y > 0)
+        visit(cell - m_cellsSide);
+      if (y + 1 < m_cellsSide)
+        visit(cell + m_cellsSide);
+    }
+  }
+}
+
+CountryPolygons::CellState CountryPolygons::GetCellState(m2::PointD const & point) const
+{
+  if (m_cells.empty())
+    return CellState::Unknown;
+  if (!m_cellsRect.IsPointInside(point))
+    return CellState::Outside;
+  return m_cells[GetCellIndex(point)];
+}
+
+size_t CountryPolygons::GetCellIndex(m2::PointD const & point) const
+{
+  auto const toCell = [this](double value, double min, double size)
+  {
+    auto const cell = static_cast<int64_t>((value - min) / size * m_cellsSide);
+    return static_cast<size_t>(std::clamp(cell, int64_t{0}, static_cast<int64_t>(m_cellsSide) - 1));
+  };
+
+  return toCell(point.y, m_cellsRect.minY(), m_cellsRect.SizeY()) * m_cellsSide +
+         toCell(point.x, m_cellsRect.minX(), m_cellsRect.SizeX());
+}
+
 bool LoadBorders(std::string const & borderFile, std::vector<m2::RegionD> & outBorders)
 {
   std::ifstream stream(borderFile);
@@ -11,6 +11,8 @@
 #include "geometry/region2d.hpp"
 #include "geometry/tree4d.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -52,6 +54,7 @@ public:
     : m_name(name)
     , m_polygons(regions)
   {
+    BuildCellsIndex();
   }
 
   std::string const & GetName() const { return m_name; }
@@ -60,6 +63,7 @@ public:
   {
     m_polygons.Clear();
     m_name.clear();
+    m_cells.clear();
   }
 
   class ContainsCompareFn
@@ -82,6 +86,8 @@ public:
   static double GetContainsEpsilon() { return 1.0E-4; }
 
   bool Contains(m2::PointD const & point) const;
+  // The same as Contains() but always tests the polygons.
+  bool ContainsExactly(m2::PointD const & point) const;
 
   template <typename Do>
   void ForEachPolygon(Do && fn) const
@@ -96,8 +102,26 @@ public:
   }
 
 private:
+  // Cells of a uniform grid over the polygons' rect. Only points in the Border cells need
+  // the exact test, all the points of the other cells are either inside or outside.
+  enum class CellState : uint8_t
+  {
+    Unknown,
+    Outside,
+    Inside,
+    Border
+  };
+
+  void BuildCellsIndex();
+  CellState GetCellState(m2::PointD const & point) const;
+  size_t GetCellIndex(m2::PointD const & point) const;
+
   std::string m_name;
   PolygonsTree m_polygons;
+
+  m2::RectD m_cellsRect;
+  size_t m_cellsSide = 0;
+  std::vector<CellState> m_cells;
 };
 
 class CountryPolygonsCollection
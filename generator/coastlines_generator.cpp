@@ -109,7 +109,7 @@ public:
     if (m_src.IsRectInside(r.GetRect()))
       m_res.push_back(r);
     else
-      m2::IntersectRegions(m_res.front(), r, m_res);
+      m2::IntersectRegionWithRect(r, m_src, m_res);
   }
 
   size_t GetPointsCount() const
@@ -247,11 +247,27 @@ public:
     PointT arr[] = {D2I(m2::PointD(minX, minY)), D2I(m2::PointD(minX, maxY)),
                     D2I(m2::PointD(maxX, maxY)), D2I(m2::PointD(maxX, minY))};
     RegionT rectR(arr, arr + ARRAY_SIZE(arr));
+    m2::RectD const limitRect = GetLimitRect(rectR);
+
+    // Regions which are fully inside the cell are taken as is, so if they already have too many
+    // points, the cell is split without clipping the crossing regions, which is the costly part.
+    if (cell.Level() < kHighLevel)
+    {
+      RectT const cellRect = rectR.GetRect();
+      size_t pointsCount = rectR.GetPointsCount();
+      m_index.ForEachInRect(limitRect, [&](RegionT const & r)
+      {
+        if (cellRect.IsRectInside(r.GetRect()))
+          pointsCount += r.GetPointsCount();
+      });
+      if (pointsCount >= kMaxPoints)
+        return false;
+    }
 
     // Do 'and' with all regions and accumulate the result, including bound region.
     // In 'odd' parts we will have an ocean.
     DoDifference doDiff(rectR);
-    m_index.ForEachInRect(GetLimitRect(rectR), std::bind<void>(std::ref(doDiff), std::placeholders::_1));
+    m_index.ForEachInRect(limitRect, std::bind<void>(std::ref(doDiff), std::placeholders::_1));
 
     // Check if too many points for feature.
     if (cell.Level() < kHighLevel && doDiff.GetPointsCount() >= kMaxPoints)
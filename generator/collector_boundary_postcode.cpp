@@ -3,6 +3,8 @@
 #include "generator/feature_builder.hpp"
 #include "generator/intermediate_data.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/string_utf8_multilang.hpp"
 
@@ -14,6 +16,7 @@ BoundaryPostcodeCollector::BoundaryPostcodeCollector(std::string const & filenam
   : CollectorInterface(filename)
   , m_cache(cache)
   , m_featureMakerSimple(cache)
+  , m_writer(std::make_unique<FileWriter>(GetTmpFilename()))
 {
 }
 
@@ -47,16 +50,37 @@ void BoundaryPostcodeCollector::Collect(OsmElement const & el)
   {
     /// @todo Make move geometry?
     if (feature.IsGeometryClosed())
-      m_data.emplace_back(postcode, feature.GetOuterGeometry());
+    {
+      utils::WriteString(*m_writer, postcode);
+      rw::WriteVectorOfPOD(*m_writer, feature.GetOuterGeometry());
+    }
   }
 }
 
+void BoundaryPostcodeCollector::Finish() { m_writer.reset(); }
+
 void BoundaryPostcodeCollector::Save()
 {
-  std::sort(m_data.begin(), m_data.end());
+  CHECK(!m_writer, ("Finish() has not been called."));
+
+  // Boundaries are kept in the tmp files while features are generated and are loaded only
+  // here, once for all the threads.
+  std::vector<std::pair<std::string, feature::FeatureBuilder::PointSeq>> data;
+  {
+    FileReader reader(GetTmpFilename());
+    ReaderSource<FileReader> src(reader);
+    while (src.Size() > 0)
+    {
+      auto & p = data.emplace_back();
+      utils::ReadString(src, p.first);
+      rw::ReadVectorOfPOD(src, p.second);
+    }
+  }
+
+  std::sort(data.begin(), data.end());
 
   FileWriter writer(GetFilename());
-  for (auto const & p : m_data)
+  for (auto const & p : data)
   {
     utils::WriteString(writer, p.first);
     rw::WriteVectorOfPOD(writer, p.second);
@@ -65,6 +89,7 @@ void BoundaryPostcodeCollector::Save()
 
 void BoundaryPostcodeCollector::MergeInto(BoundaryPostcodeCollector & collector) const
 {
-  collector.m_data.insert(collector.m_data.end(), m_data.begin(), m_data.end());
+  CHECK(!m_writer && !collector.m_writer, ("Finish() has not been called."));
+  base::AppendFileToFile(GetTmpFilename(), collector.GetTmpFilename());
 }
 }  // namespace generator
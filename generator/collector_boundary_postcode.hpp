@@ -4,6 +4,8 @@
 #include "generator/feature_maker.hpp"
 #include "generator/osm_element.hpp"
 
+#include "coding/file_writer.hpp"
+
 #include <memory>
 #include <string>
 
@@ -21,6 +23,7 @@ public:
   std::shared_ptr<CollectorInterface> Clone(IDRInterfacePtr const & = {}) const override;
 
   void Collect(OsmElement const & el) override;
+  void Finish() override;
 
   IMPLEMENT_COLLECTOR_IFACE(BoundaryPostcodeCollector);
   void MergeInto(BoundaryPostcodeCollector & collector) const;
@@ -29,8 +32,9 @@ protected:
   void Save() override;
 
 private:
-  std::vector<std::pair<std::string, feature::FeatureBuilder::PointSeq>> m_data;
   std::shared_ptr<cache::IntermediateDataReaderInterface> m_cache;
   FeatureMakerSimple m_featureMakerSimple;
+  // Pairs are written to the tmp file as they are collected.
+  std::unique_ptr<FileWriter> m_writer;
 };
 }  // namespace generator
@@ -8,6 +8,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/files_container.hpp"
+#include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/string_utf8_multilang.hpp"
 
@@ -160,10 +161,10 @@ std::string DescriptionsCollector::MakePathForWikidata(std::string const & wikip
 // static
 std::string DescriptionsCollector::FillStringFromFile(std::string const & fullPath)
 {
-  std::ifstream stream;
-  stream.exceptions(std::fstream::failbit | std::fstream::badbit);
-  stream.open(fullPath);
-  return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  // The page is read at once, which is much faster than by characters via a stream iterator.
+  std::string str;
+  FileReader(fullPath).ReadAsString(str);
+  return str;
 }
 
 int DescriptionsCollector::FindPageAndFill(std::string const & path, descriptions::LangMeta & meta)
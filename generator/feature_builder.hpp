@@ -4,13 +4,17 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/geo_object_id.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <list>
 #include <string>
@@ -314,6 +318,76 @@ void ForEachFeatureRawFormat(std::string const & filename, ToDo && toDo)
   }
 }
 
+// Random access to features of a features file. The file is memory mapped and the offsets of
+// features are collected by skipping over their sizes, without deserialization of features.
+template <class SerializationPolicy = serialization_policy::MaxAccuracy>
+class FeatureBuilderFileReader
+{
+public:
+  explicit FeatureBuilderFileReader(std::string const & filename)
+    : m_reader(filename, MmapReader::Advice::Sequential)
+  {
+    auto const * data = m_reader.Data();
+    uint64_t const fileSize = m_reader.Size();
+    uint64_t pos = 0;
+    while (pos < fileSize)
+    {
+      m_offsets.push_back(pos);
+      ArrayByteSource src(data + pos);
+      uint32_t const sz = ReadVarUint<uint32_t>(src);
+      pos = static_cast<uint64_t>(src.PtrUint8() - data) + sz;
+    }
+    CHECK_EQUAL(pos, fileSize, (filename));
+  }
+
+  size_t GetFeaturesCount() const { return m_offsets.size(); }
+
+  // Returns the position of the |index|-th feature in the file, the same as ForEachFeatureRawFormat passes.
+  uint64_t GetPos(size_t index) const { return m_offsets[index]; }
+
+  void Read(size_t index, FeatureBuilder & fb) const
+  {
+    ArrayByteSource src(m_reader.Data() + m_offsets[index]);
+    uint32_t const sz = ReadVarUint<uint32_t>(src);
+    auto const * begin = reinterpret_cast<char const *>(src.PtrUint8());
+    typename FeatureBuilder::Buffer buffer(begin, begin + sz);
+    SerializationPolicy::Deserialize(fb, buffer);
+  }
+
+  // Calls |toDo| for all features on |threadsCount| threads, so |toDo| must be thread-safe.
+  // Every thread processes a chunk of consecutive features.
+  template <class ToDo>
+  void ForEachParallel(size_t threadsCount, ToDo && toDo) const
+  {
+    size_t const count = GetFeaturesCount();
+    threadsCount = std::max(std::min(threadsCount, count), size_t{1});
+    auto const processChunk = [&](size_t chunk)
+    {
+      for (size_t i = count * chunk / threadsCount; i < count * (chunk + 1) / threadsCount; ++i)
+      {
+        FeatureBuilder fb;
+        Read(i, fb);
+        toDo(std::move(fb), i);
+      }
+    };
+
+    if (threadsCount == 1)
+    {
+      processChunk(0);
+      return;
+    }
+
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    for (size_t chunk = 0; chunk < threadsCount; ++chunk)
+      pool.SubmitWork(processChunk, chunk);
+    pool.WaitingStop();
+  }
+
+private:
+  MmapReader m_reader;
+  std::vector<uint64_t> m_offsets;
+};
+
 template <class SerializationPolicy = serialization_policy::MaxAccuracy>
 std::vector<FeatureBuilder> ReadAllDatRawFormat(std::string const & fileName)
 {
@@ -329,6 +403,25 @@ std::vector<FeatureBuilder> ReadAllDatRawFormat(std::string const & fileName)
   return fbs;
 }
 
+// The same as ReadAllDatRawFormat, but features are deserialized on |threadsCount| threads.
+template <class SerializationPolicy = serialization_policy::MaxAccuracy>
+std::vector<FeatureBuilder> ReadAllDatRawFormat(std::string const & fileName, size_t threadsCount)
+{
+  std::vector<FeatureBuilder> fbs;
+  // Empty files can't be memory mapped.
+  uint64_t fileSize = 0;
+  if (Platform::GetFileSizeByFullPath(fileName, fileSize) && fileSize != 0)
+  {
+    FeatureBuilderFileReader<SerializationPolicy> reader(fileName);
+    fbs.resize(reader.GetFeaturesCount());
+    reader.ForEachParallel(threadsCount, [&](FeatureBuilder && fb, size_t index)
+    {
+      fbs[index] = std::move(fb);
+    });
+  }
+  return fbs;
+}
+
 template <class SerializationPolicy = serialization_policy::MaxAccuracy, class Writer = FileWriter>
 class FeatureBuilderWriter
 {
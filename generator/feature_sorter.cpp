@@ -22,11 +22,13 @@
 #include "coding/files_container.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/succinct_mapper.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_work_stealing.hpp"
 
 #include "defines.hpp"
 
@@ -143,10 +145,68 @@ public:
 
   void SetBounds(m2::RectD const & bounds) { m_bounds = bounds; }
 
-  void operator()(FeatureBuilder & fb)
+  // Builds geometry of |fbs| on |pool| and writes the features in their order, so the
+  // result doesn't depend on the number of threads.
+  void operator()(std::vector<FeatureBuilder> & fbs, base::thread_pool::work_stealing::ThreadPool * pool)
   {
-    GeometryHolder holder([this](int i) -> FileWriter & { return *m_geoFile[i]; },
-                          [this](int i) -> FileWriter & { return *m_trgFile[i]; }, fb, m_header);
+    std::vector<FeatureGeometry> geometries(fbs.size());
+    auto const build = [&](size_t i) { BuildGeometry(fbs[i], geometries[i]); };
+    if (pool != nullptr)
+    {
+      pool->ParallelFor(0, fbs.size(), build);
+    }
+    else
+    {
+      for (size_t i = 0; i < fbs.size(); ++i)
+        build(i);
+    }
+
+    for (size_t i = 0; i < fbs.size(); ++i)
+      WriteFeature(fbs[i], geometries[i]);
+  }
+
+private:
+  using Points = std::vector<m2::PointD>;
+  using Polygons = std::list<Points>;
+
+  class TmpFile : public FileWriter
+  {
+  public:
+    explicit TmpFile(std::string const & filePath) : FileWriter(filePath) {}
+    ~TmpFile() override { DeleteFileX(GetName()); }
+  };
+
+  using TmpFiles = std::vector<std::unique_ptr<TmpFile>>;
+
+  // Geometry of a feature which is serialized to memory. Offsets in |m_buffer| are
+  // relative to the beginning of the feature's chunks in |m_geo| and |m_trg|.
+  struct FeatureGeometry
+  {
+    FeatureBuilder::SupportingData m_buffer;
+    std::vector<std::vector<uint8_t>> m_geo;
+    std::vector<std::vector<uint8_t>> m_trg;
+  };
+
+  // Simplifies, tesselates and encodes the geometry of |fb| for all scales.
+  // It's called concurrently for different features, so it must not change the collector.
+  void BuildGeometry(FeatureBuilder & fb, FeatureGeometry & geometry) const
+  {
+    using Chunk = std::vector<uint8_t>;
+
+    size_t const scalesCount = m_header.GetScalesCount();
+    geometry.m_geo.resize(scalesCount);
+    geometry.m_trg.resize(scalesCount);
+
+    std::vector<std::unique_ptr<MemWriter<Chunk>>> geoWriters;
+    std::vector<std::unique_ptr<MemWriter<Chunk>>> trgWriters;
+    for (size_t i = 0; i < scalesCount; ++i)
+    {
+      geoWriters.push_back(std::make_unique<MemWriter<Chunk>>(geometry.m_geo[i]));
+      trgWriters.push_back(std::make_unique<MemWriter<Chunk>>(geometry.m_trg[i]));
+    }
+
+    GeometryHolder holder([&geoWriters](int i) -> Writer & { return *geoWriters[i]; },
+                          [&trgWriters](int i) -> Writer & { return *trgWriters[i]; }, fb, m_header);
 
     if (!fb.IsPoint())
     {
@@ -250,6 +310,42 @@ public:
       }
     }
 
+    geometry.m_buffer = std::move(holder.GetBuffer());
+  }
+
+  // Appends |chunks| to |files| and makes |offsets| absolute.
+  // Offsets are stored in order of descending scale indices, one for each bit of |mask|.
+  void WriteChunks(uint8_t mask, FeatureBuilder::Offsets & offsets,
+                   std::vector<std::vector<uint8_t>> const & chunks, TmpFiles & files)
+  {
+    size_t j = 0;
+    for (int i = static_cast<int>(m_header.GetScalesCount()) - 1; i >= 0; --i)
+    {
+      if ((mask & (1 << i)) == 0)
+        continue;
+
+      CHECK_LESS(j, offsets.size(), ());
+      if (offsets[j] != feature::kGeomOffsetFallback)
+      {
+        uint64_t const pos = static_cast<uint64_t>(CheckedFilePosCast(*files[i])) + offsets[j];
+        CHECK_LESS_OR_EQUAL(pos, std::numeric_limits<uint32_t>::max(),
+                            ("Feature offset is out of 32bit boundary!"));
+        offsets[j] = static_cast<uint32_t>(pos);
+        CHECK(offsets[j] != feature::kGeomOffsetFallback, ());
+      }
+      ++j;
+    }
+    CHECK_EQUAL(j, offsets.size(), ());
+
+    for (size_t i = 0; i < chunks.size(); ++i)
+      files[i]->Write(chunks[i].data(), chunks[i].size());
+  }
+
+  void WriteFeature(FeatureBuilder & fb, FeatureGeometry & geometry)
+  {
+    WriteChunks(geometry.m_buffer.m_ptsMask, geometry.m_buffer.m_ptsOffset, geometry.m_geo, m_geoFile);
+    WriteChunks(geometry.m_buffer.m_trgMask, geometry.m_buffer.m_trgOffset, geometry.m_trg, m_trgFile);
+
     // Override "alt_name" with synonym for Country or State for better search matching.
     /// @todo Probably, we should store and index OSM's short_name tag.
     if (indexer::SynonymsHolder::CanApply(fb.GetTypes()))
@@ -282,7 +378,7 @@ public:
       }
     }
 
-    auto & buffer = holder.GetBuffer();
+    auto & buffer = geometry.m_buffer;
     if (fb.PreSerializeAndRemoveUselessNamesForMwm(buffer))
     {
       fb.SerializeForMwm(buffer, m_header.GetDefGeometryCodingParams());
@@ -306,19 +402,6 @@ public:
     }
   }
 
-private:
-  using Points = std::vector<m2::PointD>;
-  using Polygons = std::list<Points>;
-
-  class TmpFile : public FileWriter
-  {
-  public:
-    explicit TmpFile(std::string const & filePath) : FileWriter(filePath) {}
-    ~TmpFile() override { DeleteFileX(GetName()); }
-  };
-
-  using TmpFiles = std::vector<std::unique_ptr<TmpFile>>;
-
   bool IsCountry() const { return m_header.GetType() == feature::DataHeader::MapType::Country; }
 
   static void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in, Points & out)
@@ -354,6 +437,9 @@ private:
 bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const & name,
                            feature::DataHeader::MapType mapType)
 {
+  // Features are read and their geometry is built by batches to limit memory usage.
+  size_t constexpr kFeaturesBatchSize = 10000;
+
   std::string const srcFilePath = info.GetTmpFileName(name);
   std::string const dataFilePath = info.GetTargetFileName(name);
 
@@ -398,15 +484,26 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const
       SCOPE_GUARD(_, [&]() { Platform::RemoveFileIfExists(info.GetTargetFileName(name, FEATURES_FILE_TAG)); });
       LOG(LINFO, ("Simplifying and filtering geometry for all geom levels"));
 
+      std::unique_ptr<base::thread_pool::work_stealing::ThreadPool> pool;
+      if (info.m_threadsCount > 1)
+        pool = std::make_unique<base::thread_pool::work_stealing::ThreadPool>(info.m_threadsCount);
+
       FeaturesCollector2 collector(name, info, header, regionData, info.m_versionDate);
-      for (auto const & point : midPoints.GetVector())
+      std::vector<FeatureBuilder> fbs;
+      fbs.reserve(kFeaturesBatchSize);
+      auto const & points = midPoints.GetVector();
+      for (size_t i = 0; i < points.size(); ++i)
       {
         ReaderSource<FileReader> src(reader);
-        src.Skip(point.second);
+        src.Skip(points[i].second);
 
-        FeatureBuilder fb;
-        ReadFromSourceRawFormat(src, fb);
-        collector(fb);
+        fbs.emplace_back();
+        ReadFromSourceRawFormat(src, fbs.back());
+        if (fbs.size() == kFeaturesBatchSize || i + 1 == points.size())
+        {
+          collector(fbs, pool.get());
+          fbs.clear();
+        }
       }
 
       LOG(LINFO, ("Writing features' data to", dataFilePath));
@@ -11,18 +11,20 @@ namespace generator
 using namespace feature;
 
 WorldFinalProcessor::WorldFinalProcessor(std::string const & temporaryMwmPath,
-                                         std::string const & coastlineGeomFilename)
+                                         std::string const & coastlineGeomFilename,
+                                         size_t threadsCount)
   : FinalProcessorIntermediateMwmInterface(FinalProcessorPriority::CountriesOrWorld)
   , m_temporaryMwmPath(temporaryMwmPath)
   , m_worldTmpFilename(base::JoinPath(m_temporaryMwmPath, WORLD_FILE_NAME) +
                        DATA_FILE_EXTENSION_TMP)
   , m_coastlineGeomFilename(coastlineGeomFilename)
+  , m_threadsCount(threadsCount)
 {
 }
 
 void WorldFinalProcessor::Process()
 {
-  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(m_worldTmpFilename);
+  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(m_worldTmpFilename, m_threadsCount);
   Order(fbs);
   WorldGenerator generator(m_worldTmpFilename, m_coastlineGeomFilename, m_popularPlacesFilename);
   LOG(LINFO, ("Process World features"));
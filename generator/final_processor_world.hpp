@@ -4,6 +4,7 @@
 #include "generator/final_processor_interface.hpp"
 #include "generator/world_map_generator.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace generator
@@ -14,7 +15,8 @@ public:
   using WorldGenerator = WorldMapGenerator<feature::FeaturesCollector>;
 
   /// @param[in]  coastGeomFilename   Can be empty if you don't care about cutting borders by water.
-  WorldFinalProcessor(std::string const & temporaryMwmPath, std::string const & coastGeomFilename);
+  WorldFinalProcessor(std::string const & temporaryMwmPath, std::string const & coastGeomFilename,
+                      size_t threadsCount = 1);
 
   void SetPopularPlaces(std::string const & filename)
   {
@@ -29,5 +31,6 @@ private:
   std::string m_worldTmpFilename;
   std::string m_coastlineGeomFilename;
   std::string m_popularPlacesFilename;
+  size_t m_threadsCount;
 };
 }  // namespace generator
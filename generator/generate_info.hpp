@@ -19,13 +19,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Packed
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -62,6 +64,9 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Number of threads which may be used to build a single mwm.
+  size_t m_threadsCount = 1;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -80,6 +85,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -92,6 +99,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::Packed;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
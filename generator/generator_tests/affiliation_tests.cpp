@@ -13,7 +13,9 @@
 
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
+#include "base/math.hpp"
 
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -228,3 +230,41 @@ UNIT_TEST(Lithuania_Belarus_Border)
     TEST(found, (country));
   }
 }
+
+UNIT_TEST(CountryPolygons_CellsIndex)
+{
+  using namespace borders;
+
+  // A wavy polygon with many border cells and a separate thin triangle.
+  std::vector<m2::PointD> wavy;
+  size_t constexpr kPointsCount = 2000;
+  for (size_t i = 0; i < kPointsCount; ++i)
+  {
+    double const a = 2 * math::pi * i / kPointsCount;
+    double const r = 10.0 + 3.0 * std::sin(37 * a);
+    wavy.emplace_back(r * std::cos(a), r * std::sin(a));
+  }
+
+  std::vector<m2::PointD> const triangle = {{30, 30}, {30, 35}, {30.5, 35}};
+
+  PolygonsTree polygons;
+  for (auto const & points : {wavy, triangle})
+  {
+    m2::RegionD const region(points);
+    polygons.Add(region, region.GetRect());
+  }
+
+  CountryPolygons const country("Country", polygons);
+  TEST(country.Contains({0.0, 0.0}), ());
+  TEST(!country.Contains({20.0, 20.0}), ());
+  TEST(country.Contains({30.2, 34.0}), ());
+
+  for (double x = -15; x < 35; x += 0.173)
+  {
+    for (double y = -15; y < 36; y += 0.131)
+    {
+      m2::PointD const p(x, y);
+      TEST_EQUAL(country.Contains(p), country.ContainsExactly(p), (p));
+    }
+  }
+}
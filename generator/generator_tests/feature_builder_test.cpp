@@ -10,14 +10,18 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
 #include "base/geo_object_id.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace feature_builder_test
 {
 using namespace feature;
 using namespace generator::tests_support;
+using namespace platform::tests_support;
 using namespace tests;
 
 UNIT_CLASS_TEST(TestWithClassificator, FBuilder_ManyTypes)
@@ -397,4 +401,51 @@ UNIT_CLASS_TEST(TestWithClassificator, FBuilder_RemoveInconsistentTypes)
   TEST(!params.IsTypeExist(classif().GetTypeByPath({"hwtag", "nobicycle"})), ());
 }
 
+UNIT_CLASS_TEST(TestWithClassificator, FBuilder_FileReader)
+{
+  ScopedFile const file("fbuilder_file_reader.mwm.tmp", ScopedFile::Mode::DoNotCreate);
+
+  std::vector<FeatureBuilder> fbs;
+  {
+    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(file.GetFullPath());
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+      FeatureBuilder fb;
+      FeatureBuilderParams params;
+      base::StringIL arr[] = {{"building"}};
+      AddTypes(params, arr);
+      params.FinishAddingTypes();
+      fb.SetParams(params);
+      fb.SetOsmId(base::MakeOsmWay(i + 1));
+      if (i % 2 == 0)
+      {
+        fb.SetCenter(m2::PointD(i, i));
+      }
+      else
+      {
+        fb.AssignArea({{0, 0}, {0, 1}, {1, static_cast<double>(i)}, {0, 0}}, {});
+      }
+
+      writer.Write(fb);
+      fbs.push_back(std::move(fb));
+    }
+  }
+
+  FeatureBuilderFileReader<serialization_policy::MaxAccuracy> reader(file.GetFullPath());
+  TEST_EQUAL(reader.GetFeaturesCount(), fbs.size(), ());
+
+  size_t index = 0;
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(file.GetFullPath(), [&](FeatureBuilder && fb, uint64_t pos)
+  {
+    TEST_EQUAL(reader.GetPos(index), pos, ());
+    FeatureBuilder read;
+    reader.Read(index, read);
+    TEST_EQUAL(read, fb, ());
+    ++index;
+  });
+
+  for (size_t threadsCount : {1, 3, 8})
+    TEST_EQUAL(ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(file.GetFullPath(), threadsCount), fbs, ());
+}
+
 }  // namespace feature_builder_test
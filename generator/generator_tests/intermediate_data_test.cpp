@@ -8,13 +8,20 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "base/math.hpp"
+
 #include <cstdint>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace intermediate_data_test
@@ -109,4 +116,46 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.m_tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.m_tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_packed_point_storage_test)
+{
+  using feature::GenerateInfo;
+  platform::tests_support::ScopedFile const file("packed_nodes.dat",
+                                                 platform::tests_support::ScopedFile::Mode::DoNotCreate);
+
+  auto const getLat = [](uint64_t id) { return 55.0 + static_cast<double>(id % 1000) * 1e-4; };
+  auto const getLon = [](uint64_t id) { return -37.0 - static_cast<double>(id % 777) * 1e-4; };
+  // Sparse ids in several blocks with gaps, some ids in a block go unsorted.
+  std::vector<uint64_t> const ids = {1, 3, 2, 1023, 1024, 5000, 5001, 100000, 100500, 100400};
+  {
+    auto writer = generator::cache::CreatePointStorageWriter(GenerateInfo::NodeStorageType::Packed,
+                                                             file.GetFullPath());
+    for (auto const id : ids)
+      writer->AddPoint(id, getLat(id), getLon(id));
+    TEST_EQUAL(writer->GetNumProcessedPoints(), ids.size(), ());
+  }
+
+  auto const reader = generator::cache::CreatePointStorageReader(
+      GenerateInfo::NodeStorageType::Packed, file.GetFullPath());
+
+  auto const check = [&]() {
+    for (auto const id : ids)
+    {
+      double lat = 0.0;
+      double lon = 0.0;
+      TEST(reader->GetPoint(id, lat, lon), (id));
+      TEST(base::AlmostEqualAbs(lat, getLat(id), 1e-7), (id, lat));
+      TEST(base::AlmostEqualAbs(lon, getLon(id), 1e-7), (id, lon));
+    }
+
+    double lat = 0.0;
+    double lon = 0.0;
+    for (uint64_t const id : {0, 4, 1025, 2048, 100001, 1000000})
+      TEST(!reader->GetPoint(id, lat, lon), (id));
+  };
+
+  check();
+  std::thread thread(check);
+  thread.join();
+}
 }  // namespace intermediate_data_test
@@ -0,0 +1,138 @@
+#include "testing/testing.hpp"
+
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_changes.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace osm_changes_test
+{
+using namespace generator;
+using std::string, std::vector;
+
+// Points with negative longitude are in "West", others are in "East".
+class TestAffiliation : public feature::AffiliationInterface
+{
+public:
+  // AffiliationInterface overrides:
+  vector<string> GetAffiliations(feature::FeatureBuilder const &) const override { return {}; }
+  vector<string> GetAffiliations(m2::PointD const & point) const override
+  {
+    return {point.x < 0.0 ? "West" : "East"};
+  }
+
+  bool HasCountryByName(string const &) const override { return true; }
+};
+
+class TestCache : public cache::IntermediateDataReaderInterface
+{
+public:
+  void AddNode(uint64_t id, double lat, double lon) { m_nodes[id] = mercator::FromLatLon(lat, lon); }
+  void AddWay(uint64_t id, vector<uint64_t> const & nodes) { m_ways[id] = nodes; }
+
+  // IntermediateDataReaderInterface overrides:
+  bool GetNode(cache::Key id, double & y, double & x) const override
+  {
+    auto const it = m_nodes.find(id);
+    if (it == m_nodes.cend())
+      return false;
+    x = it->second.x;
+    y = it->second.y;
+    return true;
+  }
+
+  bool GetWay(cache::Key id, WayElement & e) override
+  {
+    auto const it = m_ways.find(id);
+    if (it == m_ways.cend())
+      return false;
+    e.m_nodes = it->second;
+    return true;
+  }
+
+  bool GetRelation(cache::Key, RelationElement &) override { return false; }
+
+private:
+  std::map<uint64_t, m2::PointD> m_nodes;
+  std::map<uint64_t, vector<uint64_t>> m_ways;
+};
+
+vector<OsmChange> ReadChanges(string const & osc)
+{
+  std::istringstream stream(osc);
+  SourceReader reader(stream);
+  return ReadOsmChanges(reader);
+}
+
+UNIT_TEST(OsmChanges_Read)
+{
+  auto const changes = ReadChanges(R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6">
+  <create>
+    <node id="10" lat="1.5" lon="2.5"><tag k="amenity" v="cafe"/></node>
+  </create>
+  <modify>
+    <way id="20"><nd ref="1"/><nd ref="10"/><tag k="highway" v="service"/></way>
+  </modify>
+  <delete>
+    <relation id="30"/>
+  </delete>
+</osmChange>)");
+
+  TEST_EQUAL(changes.size(), 3, ());
+
+  TEST_EQUAL(changes[0].m_action, OsmChange::Action::Create, ());
+  TEST(changes[0].m_element.IsNode(), ());
+  TEST_EQUAL(changes[0].m_element.m_id, 10, ());
+  TEST_EQUAL(changes[0].m_element.GetTag("amenity"), "cafe", ());
+
+  TEST_EQUAL(changes[1].m_action, OsmChange::Action::Modify, ());
+  TEST(changes[1].m_element.IsWay(), ());
+  TEST_EQUAL(changes[1].m_element.Nodes(), vector<uint64_t>({1, 10}), ());
+
+  TEST_EQUAL(changes[2].m_action, OsmChange::Action::Delete, ());
+  TEST(changes[2].m_element.IsRelation(), ());
+  TEST_EQUAL(changes[2].m_element.m_id, 30, ());
+}
+
+UNIT_TEST(OsmChanges_AffectedCountries)
+{
+  TestCache cache;
+  TestAffiliation const affiliation;
+  cache.AddNode(1, 10.0 /* lat */, -10.0 /* lon */);
+  cache.AddNode(2, 10.0 /* lat */, 10.0 /* lon */);
+  cache.AddNode(3, 10.0 /* lat */, -20.0 /* lon */);
+  cache.AddWay(100, {1, 3});
+
+  // A node moves from the west to the east.
+  auto changes = ReadChanges(R"(<osmChange><modify>)"
+                             R"(<node id="1" lat="10" lon="5"/>)"
+                             R"(</modify></osmChange>)");
+  TEST_EQUAL(GetAffectedCountries(changes, cache, affiliation), vector<string>({"East", "West"}), ());
+
+  // A new way uses a node from the cache.
+  changes = ReadChanges(R"(<osmChange><create>)"
+                        R"(<way id="200"><nd ref="2"/></way>)"
+                        R"(</create></osmChange>)");
+  TEST_EQUAL(GetAffectedCountries(changes, cache, affiliation), vector<string>({"East"}), ());
+
+  // Old nodes of a deleted way.
+  changes = ReadChanges(R"(<osmChange><delete><way id="100"/></delete></osmChange>)");
+  TEST_EQUAL(GetAffectedCountries(changes, cache, affiliation), vector<string>({"West"}), ());
+
+  // A relation refers to a way which is modified in the same change file.
+  changes = ReadChanges(R"(<osmChange><modify>)"
+                        R"(<way id="100"><nd ref="2"/></way>)"
+                        R"(</modify><create>)"
+                        R"(<relation id="300"><member type="way" ref="100" role="outer"/></relation>)"
+                        R"(</create></osmChange>)");
+  TEST_EQUAL(GetAffectedCountries(changes, cache, affiliation), vector<string>({"East", "West"}), ());
+
+  TEST(GetAffectedCountries({}, cache, affiliation).empty(), ());
+}
+}  // namespace osm_changes_test
@@ -0,0 +1,230 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_pbf_source.hpp"
+#include "generator/osm_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace osm_pbf_source_test
+{
+using std::string, std::vector;
+
+// Minimal protobuf writer to build PBF files in memory.
+class ProtoWriter
+{
+public:
+  ProtoWriter & Varint(uint32_t field, uint64_t value)
+  {
+    Key(field, 0 /* wireType */);
+    WriteVarint(value);
+    return *this;
+  }
+
+  ProtoWriter & Bytes(uint32_t field, string const & value)
+  {
+    Key(field, 2 /* wireType */);
+    WriteVarint(value.size());
+    m_data += value;
+    return *this;
+  }
+
+  ProtoWriter & PackedSVarints(uint32_t field, vector<int64_t> const & values)
+  {
+    ProtoWriter packed;
+    for (auto const v : values)
+      packed.WriteVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    return Bytes(field, packed.m_data);
+  }
+
+  ProtoWriter & PackedVarints(uint32_t field, vector<uint64_t> const & values)
+  {
+    ProtoWriter packed;
+    for (auto const v : values)
+      packed.WriteVarint(v);
+    return Bytes(field, packed.m_data);
+  }
+
+  string const & Data() const { return m_data; }
+
+private:
+  void Key(uint32_t field, uint32_t wireType) { WriteVarint((field << 3) | wireType); }
+
+  void WriteVarint(uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      m_data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    m_data.push_back(static_cast<char>(value));
+  }
+
+  string m_data;
+};
+
+void AppendBlob(string const & type, string const & block, bool compress, string & file)
+{
+  ProtoWriter blob;
+  if (compress)
+  {
+    string zlib;
+    coding::ZLib::Deflate deflate(coding::ZLib::Deflate::Format::ZLib,
+                                  coding::ZLib::Deflate::Level::BestCompression);
+    TEST(deflate(block, std::back_inserter(zlib)), ());
+    blob.Varint(2 /* raw_size */, block.size()).Bytes(3 /* zlib_data */, zlib);
+  }
+  else
+  {
+    blob.Bytes(1 /* raw */, block);
+  }
+
+  ProtoWriter header;
+  header.Bytes(1 /* type */, type).Varint(3 /* datasize */, blob.Data().size());
+
+  uint32_t const size = static_cast<uint32_t>(header.Data().size());
+  for (int shift = 24; shift >= 0; shift -= 8)
+    file.push_back(static_cast<char>((size >> shift) & 0xFF));
+  file += header.Data();
+  file += blob.Data();
+}
+
+string MakeStringTable(vector<string> const & strings)
+{
+  ProtoWriter table;
+  for (auto const & s : strings)
+    table.Bytes(1 /* s */, s);
+  return table.Data();
+}
+
+// Returns a file with a header block and |blocksCount| data blocks. Ids of elements of
+// the i-th block start with 10 * i.
+string MakePbf(size_t blocksCount)
+{
+  string file;
+  ProtoWriter headerBlock;
+  headerBlock.Bytes(4 /* required_features */, "OsmSchema-V0.6")
+      .Bytes(4 /* required_features */, "DenseNodes");
+  AppendBlob("OSMHeader", headerBlock.Data(), false /* compress */, file);
+
+  for (size_t i = 0; i < blocksCount; ++i)
+  {
+    int64_t const base = static_cast<int64_t>(10 * i);
+
+    ProtoWriter dense;
+    dense.PackedSVarints(1 /* id */, {base + 1, 1})
+        .PackedSVarints(8 /* lat */, {555000000, 1000})
+        .PackedSVarints(9 /* lon */, {376000000, -1000})
+        .PackedVarints(10 /* keys_vals */, {1, 2, 0, 0});
+
+    ProtoWriter way;
+    way.Varint(1 /* id */, base + 3)
+        .PackedVarints(2 /* keys */, {3})
+        .PackedVarints(3 /* vals */, {4})
+        .PackedSVarints(8 /* refs */, {base + 1, 1});
+
+    ProtoWriter relation;
+    relation.Varint(1 /* id */, base + 4)
+        .PackedVarints(2 /* keys */, {5})
+        .PackedVarints(3 /* vals */, {6})
+        .PackedVarints(8 /* roles_sid */, {7, 8})
+        .PackedSVarints(9 /* memids */, {base + 3, -2})
+        .PackedVarints(10 /* types */, {1, 0});
+
+    ProtoWriter nodesGroup;
+    nodesGroup.Bytes(2 /* dense */, dense.Data());
+    ProtoWriter elementsGroup;
+    elementsGroup.Bytes(3 /* ways */, way.Data()).Bytes(4 /* relations */, relation.Data());
+
+    // Granularity is stored after the groups to check that it's applied to all of them.
+    ProtoWriter block;
+    block.Bytes(1 /* stringtable */,
+                MakeStringTable({"", "amenity", "cafe", "highway", "service", "type",
+                                 "multipolygon", "outer", "inner"}))
+        .Bytes(2 /* primitivegroup */, nodesGroup.Data())
+        .Bytes(2 /* primitivegroup */, elementsGroup.Data())
+        .Varint(17 /* granularity */, 100);
+
+    AppendBlob("OSMData", block.Data(), i % 2 == 0 /* compress */, file);
+  }
+
+  return file;
+}
+
+vector<OsmElement> ReadAll(string const & data, size_t threadsCount)
+{
+  std::istringstream stream(data);
+  generator::SourceReader reader(stream);
+  vector<OsmElement> elements;
+  generator::ProcessOsmElementsFromPbf(reader, threadsCount, [&](OsmElement && e) {
+    elements.push_back(std::move(e));
+  });
+  return elements;
+}
+
+void TestBlock(vector<OsmElement> const & elements, size_t blockIndex)
+{
+  uint64_t const base = 10 * blockIndex;
+  TEST_GREATER_OR_EQUAL(elements.size(), 4 * (blockIndex + 1), ());
+  auto const * e = &elements[4 * blockIndex];
+
+  TEST(e[0].IsNode(), ());
+  TEST_EQUAL(e[0].m_id, base + 1, ());
+  TEST(base::AlmostEqualAbs(e[0].m_lat, 55.5, 1e-7), (e[0].m_lat));
+  TEST(base::AlmostEqualAbs(e[0].m_lon, 37.6, 1e-7), (e[0].m_lon));
+  TEST_EQUAL(e[0].GetTag("amenity"), "cafe", ());
+
+  TEST(e[1].IsNode(), ());
+  TEST_EQUAL(e[1].m_id, base + 2, ());
+  TEST(base::AlmostEqualAbs(e[1].m_lat, 55.5001, 1e-7), (e[1].m_lat));
+  TEST(base::AlmostEqualAbs(e[1].m_lon, 37.5999, 1e-7), (e[1].m_lon));
+  TEST(e[1].Tags().empty(), ());
+
+  TEST(e[2].IsWay(), ());
+  TEST_EQUAL(e[2].m_id, base + 3, ());
+  TEST_EQUAL(e[2].Nodes(), vector<uint64_t>({base + 1, base + 2}), ());
+  TEST_EQUAL(e[2].GetTag("highway"), "service", ());
+
+  TEST(e[3].IsRelation(), ());
+  TEST_EQUAL(e[3].m_id, base + 4, ());
+  TEST_EQUAL(e[3].GetTag("type"), "multipolygon", ());
+  auto const & members = e[3].Members();
+  TEST_EQUAL(members.size(), 2, ());
+  TEST(members[0] == OsmElement::Member(base + 3, OsmElement::EntityType::Way, "outer"), ());
+  TEST(members[1] == OsmElement::Member(base + 1, OsmElement::EntityType::Node, "inner"), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_Read)
+{
+  auto const elements = ReadAll(MakePbf(2 /* blocksCount */), 1 /* threadsCount */);
+  TEST_EQUAL(elements.size(), 8, ());
+  TestBlock(elements, 0);
+  TestBlock(elements, 1);
+}
+
+UNIT_TEST(OSM_PBF_Source_ReadParallel)
+{
+  size_t const blocksCount = 20;
+  auto const data = MakePbf(blocksCount);
+  auto const elements = ReadAll(data, 4 /* threadsCount */);
+  TEST_EQUAL(elements.size(), 4 * blocksCount, ());
+  for (size_t i = 0; i < blocksCount; ++i)
+    TestBlock(elements, i);
+
+  TEST_EQUAL(elements, ReadAll(data, 1 /* threadsCount */), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_Empty)
+{
+  TEST(ReadAll(string(), 2 /* threadsCount */).empty(), ());
+  TEST(ReadAll(MakePbf(0 /* blocksCount */), 2 /* threadsCount */).empty(), ());
+}
+}  // namespace osm_pbf_source_test
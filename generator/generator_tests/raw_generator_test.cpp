@@ -9,7 +9,10 @@
 #include "routing/index_graph_loader.hpp"
 #include "routing/maxspeeds.hpp"
 
+#include "coding/files_container.hpp"
+
 #include "indexer/classificator.hpp"
+#include "indexer/feature_impl.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
@@ -173,6 +176,43 @@ UNIT_CLASS_TEST(TestRawGenerator, HighwayLinks)
   TEST_EQUAL(noSpeed, osmNoSpeed.size(), ());
 }
 
+UNIT_CLASS_TEST(TestRawGenerator, ParallelFinalFeatures)
+{
+  std::string const mwmName = "Highways";
+  BuildFB("./data/osm_test_data/highway_links.osm", mwmName);
+
+  auto const readSections = [&]()
+  {
+    std::vector<std::string> tags = {FEATURES_FILE_TAG};
+    for (size_t i = 0; i < 4; ++i)
+    {
+      tags.push_back(feature::GetTagForIndex(GEOMETRY_FILE_TAG, i));
+      tags.push_back(feature::GetTagForIndex(TRIANGLE_FILE_TAG, i));
+    }
+
+    FilesContainerR cont(GetMwmPath(mwmName));
+    std::vector<std::string> sections;
+    for (auto const & tag : tags)
+    {
+      std::string section;
+      if (cont.IsExist(tag))
+        cont.GetReader(tag).ReadAsString(section);
+      sections.push_back(std::move(section));
+    }
+    return sections;
+  };
+
+  // Geometry is built by batches on several threads, but the mwm must be the same.
+  SetThreadsCount(1);
+  BuildFeatures(mwmName);
+  auto const expected = readSections();
+  TEST(!expected[0].empty(), ());
+
+  SetThreadsCount(4);
+  BuildFeatures(mwmName);
+  TEST_EQUAL(readSections(), expected, ());
+}
+
 UNIT_CLASS_TEST(TestRawGenerator, Building3D)
 {
   auto const & buildingChecker = ftypes::IsBuildingChecker::Instance();
@@ -45,6 +45,25 @@ UNIT_TEST(Source_To_Element_create_from_o5m_test)
   std::cout << DebugPrint(elements);
 }
 
+UNIT_TEST(Source_To_Element_o5m_threads_test)
+{
+  std::string src(std::begin(relation_o5m_data), std::end(relation_o5m_data));
+  std::vector<OsmElement> elements[2];
+  size_t const threadsCounts[] = {1, 4};
+  for (size_t i = 0; i < 2; ++i)
+  {
+    std::istringstream ss(src);
+    SourceReader reader(ss);
+    ProcessOsmElementsFromO5M(reader, threadsCounts[i], [&elements, i](OsmElement && e)
+    {
+      elements[i].push_back(std::move(e));
+    });
+  }
+
+  TEST_EQUAL(elements[0].size(), 11, ());
+  TEST_EQUAL(elements[0], elements[1], ());
+}
+
 UNIT_TEST(Source_To_Element_check_equivalence)
 {
   std::istringstream ss1(relation_xml_data);
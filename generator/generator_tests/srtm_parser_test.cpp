@@ -2,6 +2,14 @@
 
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "base/file_name_utils.hpp"
+
+#include <string>
+#include <vector>
+
 using namespace generator;
 
 namespace
@@ -25,4 +33,38 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+UNIT_TEST(SrtmTileManager_GetHeights)
+{
+  using namespace platform::tests_support;
+
+  size_t constexpr kTileSide = 3601;
+  ScopedDir const dir("srtm_tiles_test");
+
+  // Uncompressed tiles with big-endian heights: 100 for N00E000 and 200 for N00E001.
+  std::string tile(kTileSide * kTileSide * 2, '\0');
+  for (size_t i = 1; i < tile.size(); i += 2)
+    tile[i] = 100;
+  ScopedFile const tile1(base::JoinPath(dir.GetRelativePath(), "N00E000.hgt"), tile);
+  for (size_t i = 1; i < tile.size(); i += 2)
+    tile[i] = static_cast<char>(200);
+  ScopedFile const tile2(base::JoinPath(dir.GetRelativePath(), "N00E001.hgt"), tile);
+
+  // Only one tile is kept in memory at once.
+  SrtmTileManager manager(dir.GetFullPath(), 1 /* maxTilesCount */);
+
+  std::vector<ms::LatLon> const coords = {
+      {0.5, 0.5}, {0.5, 1.5}, {0.1, 0.9}, {5.5, 5.5}, {0.9, 1.1}, {0.2, 0.2}};
+  geometry::Altitudes const expected = {100, 200, 100, geometry::kInvalidAltitude, 200, 100};
+
+  for (size_t threadsCount : {1, 4})
+  {
+    geometry::Altitudes heights;
+    manager.GetHeights(coords, heights, threadsCount);
+    TEST_EQUAL(heights, expected, (threadsCount));
+  }
+
+  for (size_t i = 0; i < coords.size(); ++i)
+    TEST_EQUAL(manager.GetHeight(coords[i]), expected[i], (coords[i]));
+}
 }  // namespace
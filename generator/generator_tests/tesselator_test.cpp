@@ -3,6 +3,12 @@
 #include "generator/tesselator.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
+#include <cmath>
+#include <list>
+#include <vector>
 
 namespace tesselator_test
 {
@@ -70,4 +76,52 @@ UNIT_TEST(Tesselator_Odd)
 
   TEST_EQUAL(2, RunTest(l), ());
 }
+
+UNIT_TEST(Tesselator_ManyContours)
+{
+  // Many separate contours give many triangles chains, and a large wavy one gives long chains.
+  std::list<std::vector<P>> l;
+  for (int i = 0; i < 30; ++i)
+  {
+    for (int j = 0; j < 30; ++j)
+    {
+      double const x = i * 3;
+      double const y = j * 3;
+      l.push_back({P(x, y), P(x, y + 1), P(x + 1, y + 1), P(x + 1.5, y + 0.5), P(x + 1, y)});
+    }
+  }
+
+  std::vector<P> wavy;
+  size_t constexpr kPointsCount = 10000;
+  for (size_t i = 0; i < kPointsCount; ++i)
+  {
+    double const a = 2 * math::pi * i / kPointsCount;
+    double const r = 50 + 5 * std::sin(a * 97);
+    wavy.emplace_back(300 + r * std::cos(a), 300 + r * std::sin(a));
+  }
+  l.push_back(std::move(wavy));
+
+  base::Timer timer;
+  tesselator::TrianglesInfo info;
+  int const trianglesCount = tesselator::TesselateInterior(l, info);
+  TEST_GREATER(trianglesCount, 0, ());
+
+  tesselator::PointsInfo points;
+  info.GetPointsInfo(m2::PointU(0, 0), m2::PointU(1 << 30, 1 << 30),
+                     [](m2::PointD const & p) { return m2::PointU(p.x * 1000, p.y * 1000); }, points);
+
+  size_t chainsCount = 0;
+  size_t chainedTrianglesCount = 0;
+  auto emitter = [&](m2::PointU const *, std::vector<tesselator::Edge> && chain)
+  {
+    ++chainsCount;
+    chainedTrianglesCount += chain.size();
+  };
+  info.ProcessPortions(points, emitter);
+
+  TEST_EQUAL(chainedTrianglesCount, static_cast<size_t>(trianglesCount), ());
+  TEST_GREATER_OR_EQUAL(chainsCount, 30 * 30 + 1, ());
+  LOG(LINFO, ("Triangles:", trianglesCount, "chains:", chainsCount,
+              "triangles per second:", trianglesCount / timer.ElapsedSeconds()));
+}
 }  // namespace tesselator_test
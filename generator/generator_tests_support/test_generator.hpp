@@ -56,6 +56,7 @@ public:
   std::string GetCitiesBoundariesPath() const;
 
   feature::GenerateInfo const & GetGenInfo() const { return m_genInfo; }
+  void SetThreadsCount(size_t threadsCount) { m_genInfo.m_threadsCount = threadsCount; }
   bool IsWorld(std::string const & mwmName) const;
 
   static char const * kWikidataFilename;
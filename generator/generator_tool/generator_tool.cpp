@@ -14,6 +14,7 @@
 #include "generator/isolines_section_builder.hpp"
 #include "generator/maxspeeds_builder.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_changes.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/platform_helpers.hpp"
 #include "generator/popular_places_section_builder.hpp"
@@ -25,6 +26,7 @@
 #include "generator/routing_index_generator.hpp"
 #include "generator/routing_world_roads_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/stages_profiler.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -51,15 +53,20 @@
 #include "coding/endianness.hpp"
 
 #include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdlib>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <gflags/gflags.h>
 
@@ -85,7 +92,11 @@ DEFINE_bool(emit_coasts, false,
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
+DEFINE_string(osm_changes, "",
+              "Input osmChange (.osc) file with the changes since the previous generation. "
+              "Countries affected by the changes are found with the previous intermediate data, "
+              "only they are processed by the per-country passes.");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored intermediate data.");
@@ -95,7 +106,7 @@ DEFINE_string(cache_path, "",
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, packed.");
 DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
@@ -198,6 +209,8 @@ DEFINE_bool(dump_mwm_tmp, false, "Prints feature builder objects from .mwm.tmp")
 DEFINE_uint64(threads_count, 0, "Desired count of threads. If count equals zero, count of "
                                 "threads is set automatically.");
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_string(stages_report, "",
+              "Path to a json report of wall and cpu time, peak rss and io of generator stages.");
 
 MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 {
@@ -213,6 +226,9 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   gflags::SetVersionString(pl.Version());
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+  // Generator threads log a lot, so messages are written to the console by a background thread.
+  base::SetLogMessageFn(&base::LogMessageAsync);
+
   unsigned threadsCount = FLAGS_threads_count != 0 ? static_cast<unsigned>(FLAGS_threads_count)
                                                    : pl.CpuCores();
 
@@ -229,6 +245,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   feature::GenerateInfo genInfo;
   genInfo.m_verbose = FLAGS_verbose;
+  genInfo.m_threadsCount = threadsCount;
   genInfo.m_intermediateDir = FLAGS_intermediate_data_path.empty()
                                   ? path
                                   : base::AddSlashIfNeeded(FLAGS_intermediate_data_path);
@@ -270,10 +287,21 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   classificator::Load();
 
+  StagesProfiler profiler;
+
+  // Should be done before the intermediate data is overwritten by the new planet.
+  std::optional<std::vector<std::string>> affectedCountries;
+  if (!FLAGS_osm_changes.empty())
+  {
+    affectedCountries = GetAffectedCountries(genInfo, FLAGS_osm_changes);
+    LOG(LINFO, ("Countries affected by", FLAGS_osm_changes, ":", *affectedCountries));
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
+    auto const stage = profiler.Start("" /* country */, "intermediate_data");
     if (!GenerateIntermediateData(genInfo))
       return EXIT_FAILURE;
   }
@@ -281,6 +309,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   // Generate .mwm.tmp files.
   if (FLAGS_generate_features || FLAGS_generate_world || FLAGS_make_coasts)
   {
+    auto const stage = profiler.Start("" /* country */, "raw_features");
     RawGenerator rawGenerator(genInfo, threadsCount);
     if (FLAGS_generate_features)
       rawGenerator.GenerateCountries();
@@ -298,6 +327,17 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (genInfo.m_bucketNames.empty() && !FLAGS_output.empty())
     genInfo.m_bucketNames.push_back(FLAGS_output);
 
+  if (affectedCountries)
+  {
+    // World files are made of features of all countries, so they are kept on any change.
+    base::EraseIf(genInfo.m_bucketNames, [&](std::string const & name) {
+      if (name == WORLD_FILE_NAME || name == WORLD_COASTS_FILE_NAME)
+        return affectedCountries->empty();
+      return !std::binary_search(affectedCountries->cbegin(), affectedCountries->cend(), name);
+    });
+    LOG(LINFO, ("Countries to process:", genInfo.m_bucketNames));
+  }
+
   if (FLAGS_dump_mwm_tmp)
   {
     for (auto const & fb : feature::ReadAllDatRawFormat(genInfo.GetTmpFileName(FLAGS_output)))
@@ -328,6 +368,9 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     }
   }
 
+  // Boundaries of cities are the same for all the buckets, so they are loaded once.
+  std::optional<generator::OsmIdToBoundariesTable> citiesBoundaries;
+
   // Enumerate over all features files that were created.
   size_t const count = genInfo.m_bucketNames.size();
   for (size_t i = 0; i < count; ++i)
@@ -338,6 +381,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_geometry)
     {
+      auto const stage = profiler.Start(country, "features");
       using MapType = feature::DataHeader::MapType;
 
       MapType mapType = MapType::Country;
@@ -368,6 +412,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_index)
     {
+      auto const stage = profiler.Start(country, "index");
       LOG(LINFO, ("Generating index for", dataFile));
 
       if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country))
@@ -376,6 +421,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_search_index)
     {
+      auto const stage = profiler.Start(country, "search_index");
       LOG(LINFO, ("Generating search index for", dataFile));
 
       /// @todo Make threads count according to environment (single mwm build or planet build).
@@ -425,23 +471,31 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_cities_boundaries)
     {
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
+      auto const stage = profiler.Start(country, "cities_boundaries");
       LOG(LINFO, ("Generating cities boundaries for", dataFile));
-      generator::OsmIdToBoundariesTable table;
-      if (!generator::DeserializeBoundariesTable(FLAGS_cities_boundaries_data, table))
-        LOG(LCRITICAL, ("Error deserializing boundaries table"));
-      if (!generator::BuildCitiesBoundaries(dataFile, table))
+      if (!citiesBoundaries)
+      {
+        citiesBoundaries.emplace();
+        if (!generator::DeserializeBoundariesTable(FLAGS_cities_boundaries_data, *citiesBoundaries))
+          LOG(LCRITICAL, ("Error deserializing boundaries table"));
+      }
+      if (!generator::BuildCitiesBoundaries(dataFile, *citiesBoundaries))
         LOG(LCRITICAL, ("Error generating cities boundaries."));
     }
 
     if (FLAGS_generate_cities_ids)
     {
+      auto const stage = profiler.Start(country, "cities_ids");
       LOG(LINFO, ("Generating cities ids for", dataFile));
       if (!generator::BuildCitiesIds(dataFile, osmToFeatureFilename))
         LOG(LCRITICAL, ("Error generating cities ids."));
     }
 
     if (!FLAGS_srtm_path.empty())
-      routing::BuildRoadAltitudes(dataFile, FLAGS_srtm_path);
+    {
+      auto const stage = profiler.Start(country, "altitudes");
+      routing::BuildRoadAltitudes(dataFile, FLAGS_srtm_path, threadsCount);
+    }
 
     transit::experimental::EdgeIdToFeatureId transitEdgeFeatureIds;
 
@@ -484,6 +538,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_make_routing_index)
     {
+      auto const stage = profiler.Start(country, "routing");
       if (!countryParentGetter)
       {
         // All the mwms should use proper VehicleModels.
@@ -528,6 +583,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm || FLAGS_make_transit_cross_mwm_experimental)
     {
+      auto const stage = profiler.Start(country, "cross_mwm");
       if (!countryParentGetter)
       {
         // All the mwms should use proper VehicleModels.
@@ -581,6 +637,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_traffic_keys)
     {
+      auto const stage = profiler.Start(country, "traffic_keys");
       if (!traffic::GenerateTrafficKeysFromDataFile(dataFile))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
@@ -642,5 +699,8 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (FLAGS_check_mwm)
     check_model::ReadFeatures(dataFile);
 
+  if (!FLAGS_stages_report.empty())
+    profiler.Save(FLAGS_stages_report);
+
   return EXIT_SUCCESS;
 })
@@ -103,47 +103,64 @@ HierarchyLinker::Tree4d HierarchyLinker::MakeTree4d(Node::Ptrs const & nodes)
 
 HierarchyLinker::Node::Ptr HierarchyLinker::FindPlaceParent(HierarchyPlace const & place)
 {
-  Node::Ptr parent = nullptr;
-  auto minArea = std::numeric_limits<double>::max();
+  // https://wiki.openstreetmap.org/wiki/Simple_3D_buildings
+  // An object with tag 'building:part' is a part of a relation with outline 'building' or
+  // is contained in a object with tag 'building'. This case is second. We suppose a building part is
+  // only inside a building.
+  static auto const & buildingChecker = ftypes::IsBuildingChecker::Instance();
+  static auto const & buildingPartChecker = ftypes::IsBuildingPartChecker::Instance();
+  bool const isBuildingPart = buildingPartChecker(place.GetTypes());
+
+  Node::Ptrs candidates;
   auto const point = place.GetCenter();
   m_tree.ForEachInRect({point, point}, [&](auto const & candidateNode) {
-    // https://wiki.openstreetmap.org/wiki/Simple_3D_buildings
-    // An object with tag 'building:part' is a part of a relation with outline 'building' or
-    // is contained in a object with tag 'building'. This case is second. We suppose a building part is
-    // only inside a building.
-    static auto const & buildingChecker = ftypes::IsBuildingChecker::Instance();
-    static auto const & buildingPartChecker = ftypes::IsBuildingPartChecker::Instance();
     auto const & candidate = candidateNode->GetData();
-    if (buildingPartChecker(place.GetTypes()) &&
+    if (isBuildingPart &&
         !(buildingChecker(candidate.GetTypes()) || buildingPartChecker(candidate.GetTypes())))
     {
       return;
     }
 
     // A building part must have children only with 'building:part' type.
-    if (!buildingPartChecker(place.GetTypes()) && buildingPartChecker(candidate.GetTypes()))
+    if (!isBuildingPart && buildingPartChecker(candidate.GetTypes()))
       return;
 
     if (place.GetCompositeId() == candidate.GetCompositeId())
       return;
 
-    if (candidate.GetArea() < minArea && candidate.Contains(place))
+    candidates.push_back(candidateNode);
+  });
+
+  // The parent is the smallest candidate which contains the place, so the costly containment
+  // tests are done in the order of areas until the first success. The sort is stable to keep
+  // the first one of the candidates with equal areas.
+  std::stable_sort(candidates.begin(), candidates.end(), [](auto const & lhs, auto const & rhs) {
+    return lhs->GetData().GetArea() < rhs->GetData().GetArea();
+  });
+
+  for (auto const & candidateNode : candidates)
+  {
+    if (!candidateNode->GetData().Contains(place))
+      continue;
+
+    // Sometimes there can be two places with the same geometry. We must check place node and
+    // its parents to avoid cyclic connections.
+    bool isCyclic = false;
+    auto node = candidateNode;
+    while (node->HasParent())
     {
-      // Sometimes there can be two places with the same geometry. We must check place node and
-      // its parents to avoid cyclic connections.
-      auto node = candidateNode;
-      while (node->HasParent())
+      node = node->GetParent();
+      if (node->GetData().GetCompositeId() == place.GetCompositeId())
       {
-        node = node->GetParent();
-        if (node->GetData().GetCompositeId() == place.GetCompositeId())
-          return;
+        isCyclic = true;
+        break;
       }
-
-      parent = candidateNode;
-      minArea = candidate.GetArea();
     }
-  });
-  return parent;
+
+    if (!isCyclic)
+      return candidateNode;
+  }
+  return nullptr;
 }
 
 HierarchyLinker::Node::Ptrs HierarchyLinker::Link()
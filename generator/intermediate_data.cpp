@@ -1,9 +1,14 @@
 #include "generator/intermediate_data.hpp"
 
+#include <array>
+#include <atomic>
 #include <new>
 #include <set>
 #include <string>
 
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
+
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
@@ -65,8 +70,8 @@ public:
   // PointStorageWriterInterface overrides:
   uint64_t GetNumProcessedPoints() const override { return m_numProcessedPoints; }
 
-private:
-  uint64_t m_numProcessedPoints{0};
+protected:
+  uint64_t m_numProcessedPoints = 0;
 };
 
 // RawFilePointStorageMmapReader -------------------------------------------------------------------
@@ -115,7 +120,6 @@ public:
 
 private:
   FileWriter m_fileWriter;
-  uint64_t m_numProcessedPoints = 0;
 };
 
 // RawMemPointStorageReader ------------------------------------------------------------------------
@@ -175,7 +179,6 @@ public:
 private:
   FileWriter m_fileWriter;
   std::vector<LatLon> m_data;
-  uint64_t m_numProcessedPoints = 0;
 };
 
 // MapFilePointStorageReader -----------------------------------------------------------------------
@@ -252,7 +255,179 @@ public:
 
 private:
   FileWriter m_fileWriter;
-  uint64_t m_numProcessedPoints = 0;
+};
+
+// Nodes of the packed storage are split by id to blocks of |kPackedBlockSize| ids. Points of
+// a block are delta coded in the id order: the id offset in the block, latitude and longitude
+// deltas are stored as varints. Nodes which are close by id are usually close geographically,
+// so a node takes about 5 bytes instead of 8 bytes per every id in the raw storages.
+// File layout: blocks, offsets of blocks and the end of the last block (uint64 each),
+// the number of the offsets (uint64).
+uint32_t constexpr kPackedBlockSize = 1024;
+
+// PackedPointStorageReader ------------------------------------------------------------------------
+class PackedPointStorageReader : public PointStorageReaderInterface
+{
+public:
+  explicit PackedPointStorageReader(string const & name) : m_instanceId(++s_instancesCount)
+  {
+    FileReader reader(name);
+    uint64_t const size = reader.Size();
+    CHECK_GREATER_OR_EQUAL(size, sizeof(uint64_t), ("Broken packed nodes storage", name));
+
+    uint64_t offsetsCount = 0;
+    reader.Read(size - sizeof(offsetsCount), &offsetsCount, sizeof(offsetsCount));
+    CHECK_GREATER_OR_EQUAL(offsetsCount, 1, ("Broken packed nodes storage", name));
+    uint64_t const offsetsPos = size - sizeof(offsetsCount) - offsetsCount * sizeof(uint64_t);
+
+    m_offsets.resize(offsetsCount);
+    reader.Read(offsetsPos, m_offsets.data(), offsetsCount * sizeof(uint64_t));
+    CHECK_EQUAL(m_offsets.back(), offsetsPos, ("Broken packed nodes storage", name));
+
+    // Padding allows to decode the last varint of the last block without bounds checks.
+    m_data.resize(offsetsPos + sizeof(uint64_t));
+    reader.Read(0, m_data.data(), offsetsPos);
+    LOG(LINFO, ("Packed nodes storage:", m_offsets.size() - 1, "blocks,", offsetsPos, "bytes"));
+  }
+
+  // PointStorageReaderInterface overrides:
+  bool GetPoint(uint64_t id, double & lat, double & lon) const override
+  {
+    uint64_t const blockId = id / kPackedBlockSize;
+    if (blockId + 1 >= m_offsets.size())
+      return false;
+
+    // Blocks are decoded by every thread independently, so the cache doesn't need locks.
+    // A small direct-mapped cache is enough: ways and relations mostly refer to nodes with
+    // close ids.
+    thread_local std::array<DecodedBlock, kCacheSize> cache;
+    auto & block = cache[blockId % kCacheSize];
+    if (block.m_instanceId != m_instanceId || block.m_blockId != blockId)
+      Decode(blockId, block);
+
+    return FromLatLon(block.m_points[id % kPackedBlockSize], lat, lon);
+  }
+
+private:
+  static size_t constexpr kCacheSize = 16;
+
+  struct DecodedBlock
+  {
+    uint64_t m_instanceId = 0;
+    uint64_t m_blockId = 0;
+    std::array<LatLon, kPackedBlockSize> m_points;
+  };
+
+  void Decode(uint64_t blockId, DecodedBlock & block) const
+  {
+    block.m_instanceId = m_instanceId;
+    block.m_blockId = blockId;
+    block.m_points.fill(LatLon());
+
+    if (m_offsets[blockId] == m_offsets[blockId + 1])
+      return;
+
+    ArrayByteSource src(m_data.data() + m_offsets[blockId]);
+    auto const count = ReadVarUint<uint32_t>(src);
+    uint32_t offset = 0;
+    LatLon ll;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      offset += ReadVarUint<uint32_t>(src);
+      ll.m_lat += ReadVarInt<int32_t>(src);
+      ll.m_lon += ReadVarInt<int32_t>(src);
+      CHECK_LESS(offset, kPackedBlockSize, ("Broken packed nodes block", blockId));
+      block.m_points[offset] = ll;
+    }
+  }
+
+  // Distinguishes blocks of different storages in the thread local caches.
+  static std::atomic<uint64_t> s_instancesCount;
+
+  uint64_t const m_instanceId;
+  std::vector<uint8_t> m_data;
+  std::vector<uint64_t> m_offsets;
+};
+
+std::atomic<uint64_t> PackedPointStorageReader::s_instancesCount{0};
+
+// PackedPointStorageWriter ------------------------------------------------------------------------
+class PackedPointStorageWriter : public PointStorageWriterBase
+{
+public:
+  explicit PackedPointStorageWriter(string const & name) : m_fileWriter(name) {}
+
+  ~PackedPointStorageWriter() noexcept(false) override
+  {
+    FlushBlock();
+    m_offsets.push_back(m_fileWriter.Pos());
+    m_fileWriter.Write(m_offsets.data(), m_offsets.size() * sizeof(uint64_t));
+    uint64_t const offsetsCount = m_offsets.size();
+    m_fileWriter.Write(&offsetsCount, sizeof(offsetsCount));
+  }
+
+  // PointStorageWriterInterface overrides:
+  void AddPoint(uint64_t id, double lat, double lon) override
+  {
+    uint64_t const blockId = id / kPackedBlockSize;
+    if (blockId != m_blockId)
+    {
+      // OSM files are sorted by id, so a block is written once all its nodes are received.
+      CHECK_GREATER(blockId, m_blockId, ("Packed nodes storage requires nodes sorted by id. Node",
+                                         id, "goes after", m_lastId, ". Use another node_storage."));
+      FlushBlock();
+      m_blockId = blockId;
+    }
+
+    LatLon ll;
+    ToLatLon(lat, lon, ll);
+    m_points.emplace_back(static_cast<uint32_t>(id % kPackedBlockSize), ll);
+    m_lastId = id;
+
+    ++m_numProcessedPoints;
+  }
+
+private:
+  void FlushBlock()
+  {
+    // Empty blocks have equal offsets.
+    while (m_offsets.size() <= m_blockId)
+      m_offsets.push_back(m_fileWriter.Pos());
+
+    if (m_points.empty())
+      return;
+
+    // Ids in a block may go in any order, the last point of a duplicated id wins.
+    std::stable_sort(m_points.begin(), m_points.end(),
+                     [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+    auto const last = std::unique(m_points.rbegin(), m_points.rend(), [](auto const & lhs, auto const & rhs) {
+      return lhs.first == rhs.first;
+    });
+    m_points.erase(m_points.begin(), last.base());
+
+    m_buffer.clear();
+    PushBackByteSink<std::vector<uint8_t>> sink(m_buffer);
+    WriteVarUint(sink, static_cast<uint32_t>(m_points.size()));
+    uint32_t offset = 0;
+    LatLon prev;
+    for (auto const & [pointOffset, ll] : m_points)
+    {
+      WriteVarUint(sink, pointOffset - offset);
+      WriteVarInt(sink, ll.m_lat - prev.m_lat);
+      WriteVarInt(sink, ll.m_lon - prev.m_lon);
+      offset = pointOffset;
+      prev = ll;
+    }
+    m_fileWriter.Write(m_buffer.data(), m_buffer.size());
+    m_points.clear();
+  }
+
+  FileWriter m_fileWriter;
+  std::vector<uint64_t> m_offsets;
+  uint64_t m_blockId = 0;
+  uint64_t m_lastId = 0;
+  std::vector<std::pair<uint32_t, LatLon>> m_points;
+  std::vector<uint8_t> m_buffer;
 };
 }  // namespace
 
@@ -333,6 +508,14 @@ OSMElementCacheReader::OSMElementCacheReader(IntermediateDataObjectsCache::Alloc
   m_fileReader.Read(0, m_data.data(), sz);
 }
 
+OSMElementCacheReader::~OSMElementCacheReader()
+{
+  if (m_hits + m_misses != 0)
+  {
+    LOG_SHORT(LDEBUG, ("Elements cache of", m_name, "hits:", m_hits, "misses:", m_misses));
+  }
+}
+
 // OSMElementCacheWriter ---------------------------------------------------------------------------
 OSMElementCacheWriter::OSMElementCacheWriter(string const & name)
   : m_fileWriter(name), m_offsets(name + OFFSET_EXT), m_name(name)
@@ -431,6 +614,8 @@ CreatePointStorageReader(feature::GenerateInfo::NodeStorageType type, string con
     return std::make_unique<MapFilePointStorageReader>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return std::make_unique<RawMemPointStorageReader>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return std::make_unique<PackedPointStorageReader>(name);
   }
   UNREACHABLE();
 }
@@ -446,6 +631,8 @@ CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType type, string con
     return std::make_unique<MapFilePointStorageWriter>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return std::make_unique<RawMemPointStorageWriter>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return std::make_unique<PackedPointStorageWriter>(name);
   }
   UNREACHABLE();
 }
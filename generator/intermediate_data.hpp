@@ -11,6 +11,7 @@
 #include "base/control_flow.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/lru_cache.hpp"
 
 #include <algorithm>
 #include <cstddef>
@@ -18,6 +19,7 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -165,17 +167,50 @@ private:
   std::unordered_map<std::string, AllocatedObjects> m_objects;
 };
 
+// When the elements are not preloaded, recently read ways and relations are kept decoded, since
+// the same elements are read many times, e.g. the ways of multipolygons and the relations of ways.
 class OSMElementCacheReader : public OSMElementCacheReaderInterface
 {
 public:
   explicit OSMElementCacheReader(IntermediateDataObjectsCache::AllocatedObjects & allocatedObjects,
                                  std::string const & name, bool preload = false);
+  ~OSMElementCacheReader() override;
 
   // OSMElementCacheReaderInterface overrides:
-  bool Read(Key id, WayElement & value) override { return Read<>(id, value); }
-  bool Read(Key id, RelationElement & value) override { return Read<>(id, value); }
+  bool Read(Key id, WayElement & value) override { return ReadCached(id, value, m_ways); }
+  bool Read(Key id, RelationElement & value) override { return ReadCached(id, value, m_relations); }
 
 private:
+  // Maximum number of decoded elements of each type.
+  static size_t constexpr kMaxCachedElements = 4096;
+
+  template <class Value>
+  using Cache = LruCache<Key, std::optional<Value>>;
+
+  template <class Value>
+  bool ReadCached(Key id, Value & value, Cache<Value> & cache)
+  {
+    if (m_preload)
+      return Read(id, value);
+
+    bool found = false;
+    auto & cached = cache.Find(id, found);
+    if (!found)
+    {
+      ++m_misses;
+      if (!Read(id, value))
+        return false;
+      cached = value;
+      return true;
+    }
+
+    ++m_hits;
+    if (!cached)
+      return false;
+    value = *cached;
+    return true;
+  }
+
   template <class Value>
   bool Read(Key id, Value & value)
   {
@@ -208,6 +243,11 @@ private:
   std::string m_name;
   std::vector<uint8_t> m_data;
   bool m_preload = false;
+
+  Cache<WayElement> m_ways{kMaxCachedElements};
+  Cache<RelationElement> m_relations{kMaxCachedElements};
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
 };
 
 class OSMElementCacheWriter
@@ -2,14 +2,112 @@
 
 #include "indexer/isolines_info.hpp"
 
+#include "indexer/scales.hpp"
+
 #include "topography_generator/isolines_utils.hpp"
 #include "topography_generator/utils/contours.hpp"
 #include "topography_generator/utils/contours_serdes.hpp"
 
+#include "geometry/mercator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace generator
 {
 using namespace topography_generator;
 
+namespace
+{
+// Isolines of a tile are limited to the length of kMaxTileSidesPerTile tile sides, it's about
+// one line per 8 pixels on average.
+double constexpr kMaxTileSidesPerTile = 32.0;
+// The densest tiles are ignored so a few cliffs don't thin out isolines of the whole map.
+double constexpr kIgnoredDenseTilesShare = 0.1;
+// Isolines aren't drawn on the lower zooms.
+int constexpr kFirstLimitedZoom = 10;
+
+// Returns the index of the altitude class in isolines::GetAltClasses(), the number of
+// classes for the zero isoline which is always drawn.
+size_t GetAltClassIndex(Altitude altitude)
+{
+  auto const & classes = isolines::GetAltClasses();
+  if (altitude == 0)
+    return classes.size();
+
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    if (altitude % classes[i] == 0)
+      return i;
+  }
+  return classes.size() - 1;
+}
+
+// Finds for each zoom level the minimal altitude class that keeps the isolines length in most
+// of tiles under the limit. Lengths are counted by the tiles of segment centers, it's precise
+// enough for the dense areas.
+std::vector<int16_t> CalcMinAltClassByZoom(Contours<Altitude> const & isolines)
+{
+  auto const & classes = isolines::GetAltClasses();
+  // Lengths of the isolines of each class (and the zero isoline last) in a tile.
+  using ClassLengths = std::vector<double>;
+  using Tile = std::pair<int64_t, int64_t>;
+
+  std::vector<int16_t> result(scales::GetUpperStyleScale() + 1, 0);
+  for (int zoom = kFirstLimitedZoom; zoom <= scales::GetUpperStyleScale(); ++zoom)
+  {
+    double const tileSize = mercator::Bounds::kRangeX / (1 << zoom);
+    std::map<Tile, ClassLengths> tiles;
+    for (auto const & [altitude, contours] : isolines.m_contours)
+    {
+      size_t const classIndex = GetAltClassIndex(altitude);
+      for (auto const & contour : contours)
+      {
+        for (size_t i = 1; i < contour.size(); ++i)
+        {
+          auto const center = (contour[i - 1] + contour[i]) / 2.0;
+          Tile const tile(static_cast<int64_t>(std::floor(center.x / tileSize)),
+                          static_cast<int64_t>(std::floor(center.y / tileSize)));
+          auto & lengths = tiles[tile];
+          lengths.resize(classes.size() + 1, 0.0);
+          lengths[classIndex] += contour[i - 1].Length(contour[i]);
+        }
+      }
+    }
+
+    // The number of the biggest classes which fit the limit in a tile, at least one.
+    std::vector<size_t> fitClassesCounts;
+    fitClassesCounts.reserve(tiles.size());
+    double const maxLength = kMaxTileSidesPerTile * tileSize;
+    for (auto const & [tile, lengths] : tiles)
+    {
+      double length = lengths.back();
+      size_t count = 0;
+      while (count < classes.size() && length + lengths[count] <= maxLength)
+        length += lengths[count++];
+      fitClassesCounts.push_back(std::max<size_t>(count, 1));
+    }
+
+    if (fitClassesCounts.empty())
+      continue;
+
+    auto const nth = fitClassesCounts.begin() +
+        static_cast<size_t>(kIgnoredDenseTilesShare * fitClassesCounts.size());
+    std::nth_element(fitClassesCounts.begin(), nth, fitClassesCounts.end());
+    if (*nth < classes.size())
+      result[zoom] = classes[*nth - 1];
+  }
+
+  // The limits of the zooms with no limits are dropped.
+  while (!result.empty() && result.back() == 0)
+    result.pop_back();
+  return result;
+}
+}  // namespace
+
 void BuildIsolinesInfoSection(std::string const & isolinesPath, std::string const & country,
                               std::string const & mwmFile)
 {
@@ -22,6 +120,8 @@ void BuildIsolinesInfoSection(std::string const & isolinesPath, std::string cons
   }
 
   isolines::IsolinesInfo info(isolines.m_minValue, isolines.m_maxValue, isolines.m_valueStep);
+  info.m_minAltClassByZoom = CalcMinAltClassByZoom(isolines);
+  LOG(LINFO, ("Isolines minimal altitude classes by zooms:", info.m_minAltClassByZoom));
 
   FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
   auto writer = cont.GetWriter(ISOLINES_INFO_FILE_TAG);
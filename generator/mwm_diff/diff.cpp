@@ -3,7 +3,10 @@
 #include "coding/buffered_file_writer.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
+#include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
+#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
@@ -13,8 +16,12 @@
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -25,9 +32,59 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: the new mwm is split into segments by its sections, each segment is
+  // copied from the old mwm, patched from the same section of the old mwm with bsdiff+gzip
+  // or stored with gzip. The segments are applied one by one, so memory is bounded by
+  // the biggest section instead of the whole mwm.
+  // Layout: header size, gzipped header (segments count and segments), payloads of segments.
+  VERSION_V1 = 1,
+  VERSION_LATEST = VERSION_V1
 };
 
+enum class SegmentType : uint8_t
+{
+  Raw = 0,
+  Copy = 1,
+  Patch = 2,
+};
+
+struct Segment
+{
+  SegmentType m_type = SegmentType::Raw;
+  uint64_t m_newSize = 0;
+  // Range of the old mwm for Copy and Patch segments.
+  uint64_t m_oldOffset = 0;
+  uint64_t m_oldSize = 0;
+  // Gzipped data for Raw segments and gzipped patch for Patch segments.
+  std::vector<uint8_t> m_payload;
+};
+
+std::vector<uint8_t> ReadAll(FileReader const & reader)
+{
+  std::vector<uint8_t> buf(base::checked_cast<size_t>(reader.Size()));
+  reader.Read(0, buf.data(), buf.size());
+  return buf;
+}
+
+std::vector<uint8_t> Compress(std::vector<uint8_t> const & data)
+{
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  std::vector<uint8_t> result;
+  deflate(data.data(), data.size(), back_inserter(result));
+  return result;
+}
+
+bool Decompress(std::vector<uint8_t> const & data, std::vector<uint8_t> & result)
+{
+  using Inflate = coding::ZLib::Inflate;
+  Inflate inflate(Inflate::Format::ZLib);
+
+  result.clear();
+  return inflate(data.data(), data.size(), back_inserter(result));
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   std::vector<uint8_t> diffBuf;
@@ -54,6 +111,124 @@ bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter
   return true;
 }
 
+Segment MakeRawSegment(FileReader const & newReader, uint64_t offset, uint64_t size)
+{
+  Segment segment;
+  segment.m_type = SegmentType::Raw;
+  segment.m_newSize = size;
+  segment.m_payload = Compress(ReadAll(newReader.SubReader(offset, size)));
+  return segment;
+}
+
+// Returns false when the mwms can't be split into sections, Version0 should be used then.
+bool MakeDiffVersion1(std::string const & oldMwmPath, std::string const & newMwmPath,
+                      FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
+{
+  std::map<std::string, std::pair<uint64_t, uint64_t>> oldSections;
+  std::vector<FilesContainerBase::TagInfo> newSections;
+  try
+  {
+    FilesContainerR(oldMwmPath).ForEachTagInfo([&](FilesContainerBase::TagInfo const & info)
+    {
+      oldSections[info.m_tag] = {info.m_offset, info.m_size};
+    });
+    FilesContainerR(newMwmPath).ForEachTagInfo([&](FilesContainerBase::TagInfo const & info)
+    {
+      if (info.m_size != 0)
+        newSections.push_back(info);
+    });
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LINFO, ("Can't read sections of mwms, whole files are diffed.", e.Msg()));
+    return false;
+  }
+
+  std::sort(newSections.begin(), newSections.end(),
+            [](auto const & lhs, auto const & rhs) { return lhs.m_offset < rhs.m_offset; });
+
+  std::vector<Segment> segments;
+  uint64_t pos = 0;
+  for (auto const & info : newSections)
+  {
+    if (info.m_offset < pos || info.m_offset + info.m_size > newReader.Size())
+    {
+      LOG(LINFO, ("Unexpected layout of section", info, "whole files are diffed."));
+      return false;
+    }
+
+    // Header of the container and alignment.
+    if (info.m_offset > pos)
+      segments.push_back(MakeRawSegment(newReader, pos, info.m_offset - pos));
+    pos = info.m_offset + info.m_size;
+
+    auto const it = oldSections.find(info.m_tag);
+    if (it == oldSections.end() || it->second.second == 0)
+    {
+      segments.push_back(MakeRawSegment(newReader, info.m_offset, info.m_size));
+      continue;
+    }
+
+    auto const [oldOffset, oldSize] = it->second;
+    auto oldSection = oldReader.SubReader(oldOffset, oldSize);
+    auto newSection = newReader.SubReader(info.m_offset, info.m_size);
+
+    Segment segment;
+    segment.m_newSize = info.m_size;
+    segment.m_oldOffset = oldOffset;
+    if (oldSize == info.m_size && ReadAll(oldSection) == ReadAll(newSection))
+    {
+      segment.m_type = SegmentType::Copy;
+      segments.push_back(std::move(segment));
+      continue;
+    }
+
+    std::vector<uint8_t> patch;
+    MemWriter<std::vector<uint8_t>> patchWriter(patch);
+    auto const status = bsdiff::CreateBinaryPatch(oldSection, newSection, patchWriter);
+    if (status != bsdiff::BSDiffStatus::OK)
+    {
+      LOG(LERROR, ("Could not create patch with bsdiff:", status));
+      return false;
+    }
+
+    segment.m_type = SegmentType::Patch;
+    segment.m_oldSize = oldSize;
+    segment.m_payload = Compress(patch);
+    segments.push_back(std::move(segment));
+  }
+
+  // Table of contents of the container.
+  if (pos < newReader.Size())
+    segments.push_back(MakeRawSegment(newReader, pos, newReader.Size() - pos));
+
+  std::vector<uint8_t> header;
+  {
+    MemWriter<std::vector<uint8_t>> headerWriter(header);
+    WriteVarUint(headerWriter, static_cast<uint64_t>(segments.size()));
+    for (auto const & segment : segments)
+    {
+      WriteToSink(headerWriter, static_cast<uint8_t>(segment.m_type));
+      WriteVarUint(headerWriter, segment.m_newSize);
+      if (segment.m_type != SegmentType::Raw)
+        WriteVarUint(headerWriter, segment.m_oldOffset);
+      if (segment.m_type == SegmentType::Patch)
+        WriteVarUint(headerWriter, segment.m_oldSize);
+      if (segment.m_type != SegmentType::Copy)
+        WriteVarUint(headerWriter, static_cast<uint64_t>(segment.m_payload.size()));
+    }
+  }
+  header = Compress(header);
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteVarUint(diffFileWriter, static_cast<uint64_t>(header.size()));
+  diffFileWriter.Write(header.data(), header.size());
+  for (auto const & segment : segments)
+    diffFileWriter.Write(segment.m_payload.data(), segment.m_payload.size());
+
+  return true;
+}
+
 generator::mwm_diff::DiffApplicationResult ApplyDiffVersion0(
     FileReader & oldReader, FileWriter & newWriter, ReaderSource<FileReader> & diffFileSource,
     base::Cancellable const & cancellable)
@@ -91,6 +266,113 @@ generator::mwm_diff::DiffApplicationResult ApplyDiffVersion0(
   LOG(LERROR, ("Could not apply patch with bsdiff:", status));
   return DiffApplicationResult::Failed;
 }
+
+generator::mwm_diff::DiffApplicationResult ApplyDiffVersion1(
+    FileReader & oldReader, Writer & newWriter, ReaderSource<FileReader> & diffFileSource,
+    base::Cancellable const & cancellable)
+{
+  using generator::mwm_diff::DiffApplicationResult;
+
+  // The sizes are checked before allocations and reads because the diff may be corrupted.
+  auto const readPayload = [&diffFileSource](uint64_t size, std::vector<uint8_t> & result)
+  {
+    if (size > diffFileSource.Size())
+      return false;
+
+    std::vector<uint8_t> compressed(base::checked_cast<size_t>(size));
+    diffFileSource.Read(compressed.data(), compressed.size());
+    return Decompress(compressed, result);
+  };
+
+  std::vector<uint8_t> header;
+  if (!readPayload(ReadVarUint<uint64_t>(diffFileSource), header))
+  {
+    LOG(LERROR, ("Corrupted header of mwm diff"));
+    return DiffApplicationResult::Failed;
+  }
+
+  MemReaderWithExceptions headerReader(header.data(), header.size());
+  ReaderSource<MemReaderWithExceptions> headerSource(headerReader);
+  auto const count = ReadVarUint<uint64_t>(headerSource);
+
+  std::vector<uint8_t> payload;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    if (cancellable.IsCancelled())
+    {
+      LOG(LDEBUG, ("Diff application has been cancelled"));
+      return DiffApplicationResult::Cancelled;
+    }
+
+    auto const type = ReadPrimitiveFromSource<uint8_t>(headerSource);
+    if (type > static_cast<uint8_t>(SegmentType::Patch))
+    {
+      LOG(LERROR, ("Unknown segment type of mwm diff:", type));
+      return DiffApplicationResult::Failed;
+    }
+
+    auto const segmentType = static_cast<SegmentType>(type);
+    auto const newSize = ReadVarUint<uint64_t>(headerSource);
+    uint64_t oldOffset = 0;
+    uint64_t oldSize = 0;
+    if (segmentType != SegmentType::Raw)
+    {
+      oldOffset = ReadVarUint<uint64_t>(headerSource);
+      oldSize = segmentType == SegmentType::Patch ? ReadVarUint<uint64_t>(headerSource) : newSize;
+      if (oldOffset > oldReader.Size() || oldSize > oldReader.Size() - oldOffset)
+      {
+        LOG(LERROR, ("Wrong range of the old mwm in mwm diff"));
+        return DiffApplicationResult::Failed;
+      }
+    }
+
+    if (segmentType != SegmentType::Copy &&
+        !readPayload(ReadVarUint<uint64_t>(headerSource), payload))
+    {
+      LOG(LERROR, ("Corrupted segment of mwm diff"));
+      return DiffApplicationResult::Failed;
+    }
+
+    auto const startPos = newWriter.Pos();
+    switch (segmentType)
+    {
+    case SegmentType::Raw:
+      newWriter.Write(payload.data(), payload.size());
+      break;
+    case SegmentType::Copy:
+    {
+      ReaderSource<FileReader> oldSource(oldReader.SubReader(oldOffset, oldSize));
+      rw::ReadAndWrite(oldSource, newWriter, 64 * 1024);
+      break;
+    }
+    case SegmentType::Patch:
+    {
+      auto oldSection = oldReader.SubReader(oldOffset, oldSize);
+      MemReaderWithExceptions patchReader(payload.data(), payload.size());
+      auto const status = bsdiff::ApplyBinaryPatch(oldSection, newWriter, patchReader, cancellable);
+      if (status == bsdiff::BSDiffStatus::CANCELLED)
+      {
+        LOG(LDEBUG, ("Diff application has been cancelled"));
+        return DiffApplicationResult::Cancelled;
+      }
+      if (status != bsdiff::BSDiffStatus::OK)
+      {
+        LOG(LERROR, ("Could not apply patch with bsdiff:", status));
+        return DiffApplicationResult::Failed;
+      }
+      break;
+    }
+    }
+
+    if (newWriter.Pos() - startPos != newSize)
+    {
+      LOG(LERROR, ("Wrong size of segment", i, "of mwm diff"));
+      return DiffApplicationResult::Failed;
+    }
+  }
+
+  return DiffApplicationResult::Ok;
+}
 }  // namespace
 
 namespace generator
@@ -107,6 +389,10 @@ bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, st
 
     switch (VERSION_LATEST)
     {
+    case VERSION_V1:
+      if (MakeDiffVersion1(oldMwmPath, newMwmPath, oldReader, newReader, diffFileWriter))
+        return true;
+      return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
     case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
     default:
       LOG(LERROR,
@@ -143,6 +429,8 @@ DiffApplicationResult ApplyDiff(std::string const & oldMwmPath, std::string cons
     {
     case VERSION_V0:
       return ApplyDiffVersion0(oldReader, newWriter, diffFileSource, cancellable);
+    case VERSION_V1:
+      return ApplyDiffVersion1(oldReader, newWriter, diffFileSource, cancellable);
     default:
       LOG(LERROR, ("Unknown version format of mwm diff:", version));
       return DiffApplicationResult::Failed;
@@ -88,4 +88,27 @@ UNIT_TEST(IncrementalUpdates_Smoke)
   TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath2, diffPath, cancellable),
              DiffApplicationResult::Failed, ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  string const oldMwmPath = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass.mwm");
+  string const newMwmPath = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass-new.mwm");
+  string const diffPath = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass.mwmdiff");
+
+  SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(newMwmPath);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  // Unchanged sections are copied from the old mwm, so the diff is tiny.
+  base::Cancellable cancellable;
+  TEST(MakeDiff(oldMwmPath, oldMwmPath, diffPath), ());
+  uint64_t oldSize, diffSize;
+  TEST(base::GetFileSize(oldMwmPath, oldSize), ());
+  TEST(base::GetFileSize(diffPath, diffSize), ());
+  TEST_LESS(diffSize * 100, oldSize, ());
+
+  TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath, diffPath, cancellable), DiffApplicationResult::Ok, ());
+  TEST(base::IsEqualFiles(oldMwmPath, newMwmPath), ());
+}
 }  // namespace generator::diff_tests
@@ -27,6 +27,7 @@
 #include <initializer_list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ftype
@@ -393,17 +394,62 @@ void LeaveLongestTypes(std::vector<generator::TypeStrings> & matchedTypes)
   base::SortUnique(matchedTypes, isBetter, isEqual);
 }
 
-void MatchTypes(OsmElement * p, FeatureBuilderParams & params, TypesFilterFnT const & filterType)
+// Rules of the classificator indexed by the keys which must be present in the tags of a matched
+// element, so only the rules which can match are checked for an element.
+class MapcssRulesIndex
 {
-  auto static const rules = generator::ParseMapCSS(GetPlatform().GetReader(MAPCSS_MAPPING_FILE));
+public:
+  explicit MapcssRulesIndex(generator::MapcssRules && rules) : m_rules(std::move(rules))
+  {
+    for (uint32_t i = 0; i < m_rules.size(); ++i)
+    {
+      auto const & rule = m_rules[i].second;
+      if (!rule.m_tags.empty())
+        m_keyToRules[rule.m_tags.front().m_key].push_back(i);
+      else if (!rule.m_mandatoryKeys.empty())
+        m_keyToRules[rule.m_mandatoryKeys.front()].push_back(i);
+      else
+        m_anyKeyRules.push_back(i);
+    }
+  }
 
-  std::vector<generator::TypeStrings> matchedTypes;
-  for (auto const & [typeString, rule] : rules)
+  // Calls |fn| for the types of the matched rules in the order of the rules.
+  template <typename Fn>
+  void ForEachMatchedType(std::vector<OsmElement::Tag> const & tags, Fn && fn) const
   {
-    if (rule.Matches(p->m_tags))
-      matchedTypes.push_back(typeString);
+    std::vector<uint32_t> candidates = m_anyKeyRules;
+    for (auto const & tag : tags)
+    {
+      auto const it = m_keyToRules.find(tag.m_key);
+      if (it != m_keyToRules.end())
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+    // Tags may have duplicating keys.
+    base::SortUnique(candidates);
+
+    for (uint32_t const i : candidates)
+    {
+      if (m_rules[i].second.Matches(tags))
+        fn(m_rules[i].first);
+    }
   }
 
+private:
+  generator::MapcssRules m_rules;
+  std::unordered_map<string, std::vector<uint32_t>> m_keyToRules;
+  std::vector<uint32_t> m_anyKeyRules;
+};
+
+void MatchTypes(OsmElement * p, FeatureBuilderParams & params, TypesFilterFnT const & filterType)
+{
+  auto static const rules =
+      MapcssRulesIndex(generator::ParseMapCSS(GetPlatform().GetReader(MAPCSS_MAPPING_FILE)));
+
+  std::vector<generator::TypeStrings> matchedTypes;
+  rules.ForEachMatchedType(p->m_tags, [&matchedTypes](generator::TypeStrings const & typeString) {
+    matchedTypes.push_back(typeString);
+  });
+
   LeaveLongestTypes(matchedTypes);
 
   auto const & cl = classif();
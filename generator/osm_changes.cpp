@@ -0,0 +1,253 @@
+#include "generator/osm_changes.hpp"
+
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_xml_source.hpp"
+
+#include "coding/parse_xml.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace generator
+{
+namespace
+{
+// Sections of an osmChange file wrap ordinary OSM elements:
+// <osmChange><create><node .../></create><modify>...</modify><delete>...</delete></osmChange>.
+// The root tag is skipped, so XMLSource sees every section as an ordinary osm file.
+class OsmChangeSource
+{
+public:
+  explicit OsmChangeSource(std::vector<OsmChange> & changes)
+    : m_source([this, &changes](OsmElement && element) {
+        changes.push_back({m_action, std::move(element)});
+      })
+  {
+  }
+
+  void CharData(std::string const & data) { m_source.CharData(data); }
+
+  void AddAttr(char const * key, char const * value)
+  {
+    if (m_depth > 1)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(char const * tagName)
+  {
+    if (++m_depth == 1)
+      return true;
+
+    if (m_depth == 2)
+    {
+      if (std::strcmp(tagName, "create") == 0)
+        m_action = OsmChange::Action::Create;
+      else if (std::strcmp(tagName, "modify") == 0)
+        m_action = OsmChange::Action::Modify;
+      else if (std::strcmp(tagName, "delete") == 0)
+        m_action = OsmChange::Action::Delete;
+      else
+        LOG(LWARNING, ("Unknown osmChange section:", tagName));
+    }
+
+    return m_source.Push(tagName);
+  }
+
+  void Pop(char const * tagName)
+  {
+    if (m_depth-- > 1)
+      m_source.Pop(tagName);
+  }
+
+private:
+  XMLSource m_source;
+  OsmChange::Action m_action = OsmChange::Action::Modify;
+  size_t m_depth = 0;
+};
+
+class AffectedPointsCollector
+{
+public:
+  AffectedPointsCollector(std::vector<OsmChange> const & changes,
+                          cache::IntermediateDataReaderInterface & cache)
+    : m_cache(cache)
+  {
+    for (auto const & change : changes)
+    {
+      auto const & e = change.m_element;
+      bool const deleted = change.m_action == OsmChange::Action::Delete;
+      if (e.IsNode())
+        m_nodes[e.m_id] = deleted ? std::nullopt : std::make_optional(mercator::FromLatLon(e.m_lat, e.m_lon));
+      else if (e.IsWay())
+        m_ways[e.m_id] = deleted ? std::vector<uint64_t>() : e.Nodes();
+    }
+
+    for (auto const & change : changes)
+      Collect(change);
+  }
+
+  std::vector<m2::PointD> const & GetPoints() const { return m_points; }
+
+private:
+  void Collect(OsmChange const & change)
+  {
+    auto const & e = change.m_element;
+    bool const isNew = change.m_action == OsmChange::Action::Create;
+    switch (e.m_type)
+    {
+    case OsmElement::EntityType::Node:
+      AddNode(e.m_id);
+      if (!isNew)
+        AddCachedNode(e.m_id);
+      break;
+    case OsmElement::EntityType::Way:
+      for (auto const nodeId : e.Nodes())
+        AddNode(nodeId);
+      if (!isNew)
+        AddCachedWay(e.m_id);
+      break;
+    case OsmElement::EntityType::Relation:
+      for (auto const & member : e.Members())
+        AddMember(member.m_ref, member.m_type);
+      if (!isNew)
+      {
+        RelationElement relation;
+        if (m_cache.GetRelation(e.m_id, relation))
+        {
+          for (auto const & member : relation.m_nodes)
+            AddNode(member.first);
+          for (auto const & member : relation.m_ways)
+            AddWay(member.first);
+        }
+      }
+      break;
+    default: break;
+    }
+  }
+
+  void AddMember(uint64_t id, OsmElement::EntityType type)
+  {
+    if (type == OsmElement::EntityType::Node)
+      AddNode(id);
+    else if (type == OsmElement::EntityType::Way)
+      AddWay(id);
+  }
+
+  // Adds the current position of the node: the changed one or the cached one.
+  void AddNode(uint64_t id)
+  {
+    auto const it = m_nodes.find(id);
+    if (it == m_nodes.cend())
+      AddCachedNode(id);
+    else if (it->second)
+      m_points.push_back(*it->second);
+  }
+
+  void AddCachedNode(uint64_t id)
+  {
+    double y = 0.0;
+    double x = 0.0;
+    if (m_cache.GetNode(id, y, x))
+      m_points.emplace_back(x, y);
+  }
+
+  void AddWay(uint64_t id)
+  {
+    if (!m_visitedWays.insert(id).second)
+      return;
+
+    auto const it = m_ways.find(id);
+    if (it == m_ways.cend())
+    {
+      AddCachedWay(id);
+      return;
+    }
+
+    for (auto const nodeId : it->second)
+      AddNode(nodeId);
+  }
+
+  void AddCachedWay(uint64_t id)
+  {
+    WayElement way(id);
+    if (!m_cache.GetWay(id, way))
+      return;
+
+    for (auto const nodeId : way.m_nodes)
+      AddNode(nodeId);
+  }
+
+  cache::IntermediateDataReaderInterface & m_cache;
+  // Changed nodes, deleted ones have no position.
+  std::unordered_map<uint64_t, std::optional<m2::PointD>> m_nodes;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> m_ways;
+  std::unordered_set<uint64_t> m_visitedWays;
+  std::vector<m2::PointD> m_points;
+};
+}  // namespace
+
+std::vector<OsmChange> ReadOsmChanges(SourceReader & stream)
+{
+  std::vector<OsmChange> changes;
+  OsmChangeSource source(changes);
+  XMLSequenceParser<SourceReader, OsmChangeSource> parser(stream, source);
+  while (parser.Read())
+    ;
+
+  for (auto & change : changes)
+    change.m_element.Validate();
+  return changes;
+}
+
+std::vector<std::string> GetAffectedCountries(std::vector<OsmChange> const & changes,
+                                              cache::IntermediateDataReaderInterface & cache,
+                                              feature::AffiliationInterface const & affiliation)
+{
+  AffectedPointsCollector const collector(changes, cache);
+
+  std::vector<std::string> countries;
+  for (auto const & point : collector.GetPoints())
+  {
+    auto affiliations = affiliation.GetAffiliations(point);
+    std::move(affiliations.begin(), affiliations.end(), std::back_inserter(countries));
+  }
+
+  base::SortUnique(countries);
+  return countries;
+}
+
+std::vector<std::string> GetAffectedCountries(feature::GenerateInfo const & info,
+                                              std::string const & oscFilename)
+{
+  SourceReader reader(oscFilename);
+  auto const changes = ReadOsmChanges(reader);
+  LOG(LINFO, ("Read", changes.size(), "changes from", oscFilename));
+
+  cache::IntermediateDataObjectsCache objectsCache;
+  cache::IntermediateData intermediateData(objectsCache, info);
+  feature::CountriesFilesIndexAffiliation const affiliation(info.m_targetDir,
+                                                            info.m_haveBordersForWholeWorld);
+  return GetAffectedCountries(changes, *intermediateData.GetCache(), affiliation);
+}
+
+std::string DebugPrint(OsmChange::Action action)
+{
+  switch (action)
+  {
+  case OsmChange::Action::Create: return "Create";
+  case OsmChange::Action::Modify: return "Modify";
+  case OsmChange::Action::Delete: return "Delete";
+  }
+  UNREACHABLE();
+}
+}  // namespace generator
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "generator/affiliation.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// A change of an OSM element from an osmChange file (.osc), see
+// https://wiki.openstreetmap.org/wiki/OsmChange.
+struct OsmChange
+{
+  enum class Action
+  {
+    Create,
+    Modify,
+    Delete
+  };
+
+  Action m_action = Action::Modify;
+  // The new version of the element. Deleted elements may have no tags and geometry.
+  OsmElement m_element;
+};
+
+std::vector<OsmChange> ReadOsmChanges(SourceReader & stream);
+
+// Returns the sorted names of the countries which may contain features made of the changed
+// elements. Both the old versions of the elements from |cache| and the new versions are taken
+// into account, so the country which an element moves from is affected too.
+// Members of relations are followed one level deep.
+std::vector<std::string> GetAffectedCountries(std::vector<OsmChange> const & changes,
+                                              cache::IntermediateDataReaderInterface & cache,
+                                              feature::AffiliationInterface const & affiliation);
+
+// Reads |oscFilename| and finds the affected countries with the intermediate data and
+// the borders of |info|.
+std::vector<std::string> GetAffectedCountries(feature::GenerateInfo const & info,
+                                              std::string const & oscFilename);
+
+std::string DebugPrint(OsmChange::Action action);
+}  // namespace generator
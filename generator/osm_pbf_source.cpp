@@ -0,0 +1,510 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <iterator>
+#include <string_view>
+
+namespace osm
+{
+namespace
+{
+// Blobs are limited by the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Reader of the protobuf wire format. Fields are visited in the order they are stored.
+class ProtoReader
+{
+public:
+  enum WireType : uint32_t
+  {
+    kVarint = 0,
+    kFixed64 = 1,
+    kLengthDelimited = 2,
+    kFixed32 = 5
+  };
+
+  explicit ProtoReader(std::string_view data)
+    : m_it(reinterpret_cast<uint8_t const *>(data.data())), m_end(m_it + data.size())
+  {
+  }
+
+  // Reads the key of the next field. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_it == m_end)
+      return false;
+
+    uint64_t const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint32_t>(key & 0x7);
+    return true;
+  }
+
+  uint32_t Field() const { return m_field; }
+
+  uint64_t Varint()
+  {
+    CHECK_EQUAL(m_wireType, kVarint, ("PBF: varint is expected for field", m_field));
+    return ReadVarint();
+  }
+
+  int64_t SVarint() { return DecodeZigZag(Varint()); }
+
+  std::string_view Bytes()
+  {
+    CHECK_EQUAL(m_wireType, kLengthDelimited, ("PBF: bytes are expected for field", m_field));
+    uint64_t const size = ReadVarint();
+    CHECK_LESS_OR_EQUAL(size, static_cast<uint64_t>(m_end - m_it), ("PBF: truncated field", m_field));
+    std::string_view const result(reinterpret_cast<char const *>(m_it), static_cast<size_t>(size));
+    m_it += size;
+    return result;
+  }
+
+  // Calls |fn| for every value of a packed (or not packed) repeated varint field.
+  template <typename Fn>
+  void ForEachVarint(Fn && fn)
+  {
+    if (m_wireType == kVarint)
+    {
+      fn(ReadVarint());
+      return;
+    }
+
+    ProtoReader packed(Bytes());
+    while (packed.m_it != packed.m_end)
+      fn(packed.ReadVarint());
+  }
+
+  template <typename Fn>
+  void ForEachSVarint(Fn && fn)
+  {
+    ForEachVarint([&fn](uint64_t v) { fn(DecodeZigZag(v)); });
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case kVarint: ReadVarint(); return;
+    case kFixed64: Advance(8); return;
+    case kLengthDelimited: Bytes(); return;
+    case kFixed32: Advance(4); return;
+    }
+    CHECK(false, ("PBF: unsupported wire type", m_wireType, "of field", m_field));
+  }
+
+private:
+  static int64_t DecodeZigZag(uint64_t v)
+  {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      CHECK(m_it != m_end, ("PBF: truncated varint"));
+      uint8_t const byte = *m_it++;
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return result;
+    }
+    CHECK(false, ("PBF: too long varint"));
+    return result;
+  }
+
+  void Advance(size_t size)
+  {
+    CHECK_LESS_OR_EQUAL(size, static_cast<size_t>(m_end - m_it), ("PBF: truncated field", m_field));
+    m_it += size;
+  }
+
+  uint8_t const * m_it;
+  uint8_t const * m_end;
+  uint32_t m_field = 0;
+  uint32_t m_wireType = 0;
+};
+
+std::string DecompressBlob(std::string const & blob)
+{
+  ProtoReader reader(blob);
+  std::string result;
+  uint64_t rawSize = 0;
+  bool hasData = false;
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+    case 1:  // raw
+    {
+      auto const raw = reader.Bytes();
+      result.assign(raw.begin(), raw.end());
+      hasData = true;
+      break;
+    }
+    case 2: rawSize = reader.Varint(); break;
+    case 3:  // zlib_data
+    {
+      auto const data = reader.Bytes();
+      coding::ZLib::Inflate inflate(coding::ZLib::Inflate::Format::ZLib);
+      CHECK(inflate(data.data(), data.size(), std::back_inserter(result)), ("PBF: broken zlib data"));
+      hasData = true;
+      break;
+    }
+    case 4:
+    case 5:
+    case 6:
+    case 7: CHECK(false, ("PBF: unsupported blob compression", reader.Field())); break;
+    default: reader.Skip(); break;
+    }
+  }
+
+  CHECK(hasData, ("PBF: empty blob"));
+  CHECK(rawSize == 0 || rawSize == result.size(), ("PBF: wrong raw size", rawSize, result.size()));
+  return result;
+}
+
+void CheckHeaderBlock(std::string_view data)
+{
+  ProtoReader reader(data);
+  while (reader.Next())
+  {
+    if (reader.Field() != 4)  // required_features
+    {
+      reader.Skip();
+      continue;
+    }
+
+    auto const feature = reader.Bytes();
+    CHECK(feature == "OsmSchema-V0.6" || feature == "DenseNodes",
+          ("PBF: unsupported required feature", std::string(feature)));
+  }
+}
+
+class PrimitiveBlockDecoder
+{
+public:
+  PrimitiveBlockDecoder(std::string_view data, std::vector<OsmElement> & elements)
+    : m_elements(elements)
+  {
+    // Groups are decoded when all the block fields are known: the protobuf message is not
+    // guaranteed to store the string table and the granularity before the groups.
+    std::vector<std::string_view> groups;
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: ReadStringTable(reader.Bytes()); break;
+      case 2: groups.push_back(reader.Bytes()); break;
+      case 17: m_granularity = static_cast<int64_t>(reader.Varint()); break;
+      case 19: m_latOffset = static_cast<int64_t>(reader.Varint()); break;
+      case 20: m_lonOffset = static_cast<int64_t>(reader.Varint()); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    for (auto const & group : groups)
+      DecodeGroup(group);
+  }
+
+private:
+  void ReadStringTable(std::string_view data)
+  {
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      if (reader.Field() == 1)
+        m_strings.push_back(reader.Bytes());
+      else
+        reader.Skip();
+    }
+  }
+
+  std::string GetString(uint64_t index) const
+  {
+    CHECK_LESS(index, m_strings.size(), ("PBF: wrong string index"));
+    return std::string(m_strings[index]);
+  }
+
+  double ToDegrees(int64_t offset, int64_t value) const
+  {
+    return 1e-9 * static_cast<double>(offset + m_granularity * value);
+  }
+
+  void DecodeGroup(std::string_view data)
+  {
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: DecodeNode(reader.Bytes()); break;
+      case 2: DecodeDenseNodes(reader.Bytes()); break;
+      case 3: DecodeWay(reader.Bytes()); break;
+      case 4: DecodeRelation(reader.Bytes()); break;
+      default: reader.Skip(); break;
+      }
+    }
+  }
+
+  void AddTags(std::vector<uint64_t> const & keys, std::vector<uint64_t> const & values,
+               OsmElement & element) const
+  {
+    CHECK_EQUAL(keys.size(), values.size(), ("PBF: keys and values mismatch"));
+    for (size_t i = 0; i < keys.size(); ++i)
+      element.AddTag(GetString(keys[i]), GetString(values[i]));
+  }
+
+  void DecodeNode(std::string_view data)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Node;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> values;
+    int64_t lat = 0;
+    int64_t lon = 0;
+
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = static_cast<uint64_t>(reader.SVarint()); break;
+      case 2: reader.ForEachVarint([&keys](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachVarint([&values](uint64_t v) { values.push_back(v); }); break;
+      case 8: lat = reader.SVarint(); break;
+      case 9: lon = reader.SVarint(); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    element.m_lat = ToDegrees(m_latOffset, lat);
+    element.m_lon = ToDegrees(m_lonOffset, lon);
+    AddTags(keys, values, element);
+    m_elements.push_back(std::move(element));
+  }
+
+  void DecodeDenseNodes(std::string_view data)
+  {
+    std::vector<int64_t> ids;
+    std::vector<int64_t> lats;
+    std::vector<int64_t> lons;
+    std::vector<uint64_t> keysValues;
+
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: reader.ForEachSVarint([&ids](int64_t v) { ids.push_back(v); }); break;
+      case 8: reader.ForEachSVarint([&lats](int64_t v) { lats.push_back(v); }); break;
+      case 9: reader.ForEachSVarint([&lons](int64_t v) { lons.push_back(v); }); break;
+      case 10: reader.ForEachVarint([&keysValues](uint64_t v) { keysValues.push_back(v); }); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    CHECK_EQUAL(ids.size(), lats.size(), ("PBF: wrong dense nodes"));
+    CHECK_EQUAL(ids.size(), lons.size(), ("PBF: wrong dense nodes"));
+
+    // Ids and coordinates are delta coded, tags of all nodes are stored in a single array
+    // as key-value pairs of string indices, tags of a node are terminated by zero.
+    int64_t id = 0;
+    int64_t lat = 0;
+    int64_t lon = 0;
+    size_t kv = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      id += ids[i];
+      lat += lats[i];
+      lon += lons[i];
+
+      OsmElement element;
+      element.m_type = OsmElement::EntityType::Node;
+      element.m_id = static_cast<uint64_t>(id);
+      element.m_lat = ToDegrees(m_latOffset, lat);
+      element.m_lon = ToDegrees(m_lonOffset, lon);
+
+      if (!keysValues.empty())
+      {
+        while (kv < keysValues.size() && keysValues[kv] != 0)
+        {
+          CHECK_LESS(kv + 1, keysValues.size(), ("PBF: wrong dense nodes tags"));
+          element.AddTag(GetString(keysValues[kv]), GetString(keysValues[kv + 1]));
+          kv += 2;
+        }
+        ++kv;
+      }
+
+      m_elements.push_back(std::move(element));
+    }
+  }
+
+  void DecodeWay(std::string_view data)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Way;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> values;
+
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = reader.Varint(); break;
+      case 2: reader.ForEachVarint([&keys](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachVarint([&values](uint64_t v) { values.push_back(v); }); break;
+      case 8:
+      {
+        int64_t ref = 0;
+        reader.ForEachSVarint([&](int64_t delta)
+        {
+          ref += delta;
+          element.AddNd(static_cast<uint64_t>(ref));
+        });
+        break;
+      }
+      default: reader.Skip(); break;
+      }
+    }
+
+    AddTags(keys, values, element);
+    m_elements.push_back(std::move(element));
+  }
+
+  void DecodeRelation(std::string_view data)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Relation;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> values;
+    std::vector<uint64_t> roles;
+    std::vector<int64_t> refs;
+    std::vector<uint64_t> types;
+
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = reader.Varint(); break;
+      case 2: reader.ForEachVarint([&keys](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachVarint([&values](uint64_t v) { values.push_back(v); }); break;
+      case 8: reader.ForEachVarint([&roles](uint64_t v) { roles.push_back(v); }); break;
+      case 9: reader.ForEachSVarint([&refs](int64_t v) { refs.push_back(v); }); break;
+      case 10: reader.ForEachVarint([&types](uint64_t v) { types.push_back(v); }); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    CHECK_EQUAL(refs.size(), roles.size(), ("PBF: wrong relation", element.m_id));
+    CHECK_EQUAL(refs.size(), types.size(), ("PBF: wrong relation", element.m_id));
+
+    int64_t ref = 0;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      ref += refs[i];
+      OsmElement::EntityType type = OsmElement::EntityType::Unknown;
+      switch (types[i])
+      {
+      case 0: type = OsmElement::EntityType::Node; break;
+      case 1: type = OsmElement::EntityType::Way; break;
+      case 2: type = OsmElement::EntityType::Relation; break;
+      default: LOG(LWARNING, ("PBF: unknown member type", types[i], "in relation", element.m_id));
+      }
+      element.AddMember(static_cast<uint64_t>(ref), type, GetString(roles[i]));
+    }
+
+    AddTags(keys, values, element);
+    m_elements.push_back(std::move(element));
+  }
+
+  std::vector<OsmElement> & m_elements;
+  std::vector<std::string_view> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+}  // namespace
+
+bool PbfBlobReader::Read(PbfBlob & blob)
+{
+  uint32_t headerSize = 0;
+  if (!ReadExactly(reinterpret_cast<char *>(&headerSize), sizeof(headerSize)))
+    return false;
+
+  // Sizes of blob headers are stored in network byte order.
+  if (IsLittleEndian())
+    headerSize = ReverseByteOrder(headerSize);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("PBF: too big blob header"));
+
+  std::string header(headerSize, '\0');
+  CHECK(ReadExactly(header.data(), header.size()), ("PBF: unexpected end of file"));
+
+  std::string_view type;
+  uint64_t dataSize = 0;
+  ProtoReader reader(header);
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+    case 1: type = reader.Bytes(); break;
+    case 3: dataSize = reader.Varint(); break;
+    default: reader.Skip(); break;
+    }
+  }
+  CHECK_LESS_OR_EQUAL(dataSize, kMaxBlobSize, ("PBF: too big blob"));
+
+  if (type == "OSMHeader")
+    blob.m_type = PbfBlob::Type::Header;
+  else if (type == "OSMData")
+    blob.m_type = PbfBlob::Type::Data;
+  else
+    blob.m_type = PbfBlob::Type::Unknown;
+
+  blob.m_data.resize(static_cast<size_t>(dataSize));
+  CHECK(dataSize == 0 || ReadExactly(blob.m_data.data(), blob.m_data.size()),
+        ("PBF: unexpected end of file"));
+  return true;
+}
+
+bool PbfBlobReader::ReadExactly(char * buffer, size_t size)
+{
+  size_t read = 0;
+  while (read < size)
+  {
+    size_t const n = m_reader(reinterpret_cast<uint8_t *>(buffer) + read, size - read);
+    if (n == 0)
+    {
+      CHECK_EQUAL(read, 0, ("PBF: unexpected end of file"));
+      return false;
+    }
+    read += n;
+  }
+  return true;
+}
+
+void DecodePbfBlob(PbfBlob const & blob, std::vector<OsmElement> & elements)
+{
+  switch (blob.m_type)
+  {
+  case PbfBlob::Type::Header: CheckHeaderBlock(DecompressBlob(blob.m_data)); return;
+  case PbfBlob::Type::Data:
+  {
+    auto const data = DecompressBlob(blob.m_data);
+    PrimitiveBlockDecoder decoder(data, elements);
+    return;
+  }
+  case PbfBlob::Type::Unknown: return;
+  }
+}
+}  // namespace osm
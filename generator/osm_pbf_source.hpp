@@ -0,0 +1,53 @@
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osm
+{
+// The OSM PBF format, see https://wiki.openstreetmap.org/wiki/PBF_Format.
+// A file is a sequence of independent compressed blobs. PbfBlobReader reads raw blobs
+// sequentially, then they may be decompressed and decoded on different threads by
+// DecodePbfBlob. Only raw and zlib compressed blobs are supported.
+struct PbfBlob
+{
+  enum class Type
+  {
+    Header,
+    Data,
+    Unknown
+  };
+
+  Type m_type = Type::Unknown;
+  // Serialized Blob message.
+  std::string m_data;
+};
+
+class PbfBlobReader
+{
+public:
+  // Reads at most |size| bytes to |buffer| and returns the number of read bytes.
+  using Reader = std::function<size_t(uint8_t * buffer, size_t size)>;
+
+  explicit PbfBlobReader(Reader && reader) : m_reader(std::move(reader)) {}
+
+  // Returns false when there are no more blobs.
+  bool Read(PbfBlob & blob);
+
+private:
+  // Returns false when the input is over before the first byte.
+  bool ReadExactly(char * buffer, size_t size);
+
+  Reader m_reader;
+};
+
+// Appends elements of the data blob to |elements| in their order in the blob.
+// Header blobs are checked for the features which are required to read the file.
+void DecodePbfBlob(PbfBlob const & blob, std::vector<OsmElement> & elements);
+}  // namespace osm
@@ -10,6 +10,7 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -114,7 +115,13 @@ void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElem
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement &&)> const & processor)
 {
-  ProcessorOsmElementsFromO5M processorOsmElementsFromO5M(stream);
+  ProcessOsmElementsFromO5M(stream, 1 /* threadsCount */, processor);
+}
+
+void ProcessOsmElementsFromO5M(SourceReader & stream, size_t threadsCount,
+                               std::function<void(OsmElement &&)> const & processor)
+{
+  ProcessorOsmElementsFromO5M processorOsmElementsFromO5M(stream, threadsCount);
   OsmElement element;
   while (processorOsmElementsFromO5M.TryRead(element))
   {
@@ -124,16 +131,63 @@ void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElem
   }
 }
 
-ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream)
+ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream, size_t threadsCount)
   : m_stream(stream)
   , m_dataset([&](uint8_t * buffer, size_t size) {
       return m_stream.Read(reinterpret_cast<char *>(buffer), size);
   })
   , m_pos(m_dataset.begin())
 {
+  if (threadsCount > 1)
+    m_pool = std::make_unique<base::thread_pool::computational::ThreadPool>(1 /* threadsCount */);
 }
 
 bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
+{
+  if (!m_pool)
+    return ReadElement(element);
+
+  while (m_elementIndex == m_elements.size())
+  {
+    SubmitBatches();
+    if (m_pendingBatches.empty())
+      return false;
+
+    m_elements = m_pendingBatches.front().get();
+    m_pendingBatches.pop_front();
+    m_elementIndex = 0;
+    if (m_elements.empty())
+      m_eof = true;
+  }
+
+  element = std::move(m_elements[m_elementIndex++]);
+  return true;
+}
+
+std::vector<OsmElement> ProcessorOsmElementsFromO5M::ReadBatch()
+{
+  size_t constexpr kBatchSize = 16 * 1024;
+
+  std::vector<OsmElement> elements;
+  elements.reserve(kBatchSize);
+  OsmElement element;
+  while (elements.size() < kBatchSize && ReadElement(element))
+  {
+    elements.push_back(std::move(element));
+    element.Clear();
+  }
+  return elements;
+}
+
+void ProcessorOsmElementsFromO5M::SubmitBatches()
+{
+  size_t constexpr kMaxPendingBatches = 2;
+
+  while (!m_eof && m_pendingBatches.size() < kMaxPendingBatches)
+    m_pendingBatches.emplace_back(m_pool->Submit([this]() { return ReadBatch(); }));
+}
+
+bool ProcessorOsmElementsFromO5M::ReadElement(OsmElement & element)
 {
   if (m_pos == m_dataset.end())
     return false;
@@ -190,6 +244,70 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
   return true;
 }
 
+void ProcessOsmElementsFromPbf(SourceReader & stream, size_t threadsCount,
+                               std::function<void(OsmElement &&)> const & processor)
+{
+  ProcessorOsmElementsFromPbf processorOsmElementsFromPbf(stream, threadsCount);
+  OsmElement element;
+  while (processorOsmElementsFromPbf.TryRead(element))
+  {
+    processor(std::move(element));
+    element.Clear();
+  }
+}
+
+ProcessorOsmElementsFromPbf::ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount)
+  : m_reader([&stream](uint8_t * buffer, size_t size) {
+      return static_cast<size_t>(stream.Read(reinterpret_cast<char *>(buffer), size));
+  })
+  , m_maxPendingBlobs(2 * std::max(threadsCount, size_t(1)))
+{
+  if (threadsCount > 1)
+    m_pool = std::make_unique<base::thread_pool::computational::ThreadPool>(threadsCount);
+}
+
+bool ProcessorOsmElementsFromPbf::TryRead(OsmElement & element)
+{
+  while (m_elementIndex == m_elements.size())
+  {
+    SubmitBlobs();
+    if (m_pendingBlobs.empty())
+      return false;
+
+    m_elements = m_pendingBlobs.front().get();
+    m_pendingBlobs.pop_front();
+    m_elementIndex = 0;
+  }
+
+  element = std::move(m_elements[m_elementIndex++]);
+  element.Validate();
+  return true;
+}
+
+void ProcessorOsmElementsFromPbf::SubmitBlobs()
+{
+  while (!m_eof && m_pendingBlobs.size() < m_maxPendingBlobs)
+  {
+    osm::PbfBlob blob;
+    if (!m_reader.Read(blob))
+    {
+      m_eof = true;
+      break;
+    }
+
+    auto decode = [blob = std::move(blob)]() {
+      std::vector<OsmElement> elements;
+      osm::DecodePbfBlob(blob, elements);
+      return elements;
+    };
+
+    if (m_pool)
+      m_pendingBlobs.emplace_back(m_pool->Submit(std::move(decode)));
+    else
+      m_pendingBlobs.emplace_back(std::async(std::launch::deferred, std::move(decode)));
+  }
+}
+
 ProcessorOsmElementsFromXml::ProcessorOsmElementsFromXml(SourceReader & stream)
   : m_xmlSource([&, this](OsmElement && e)
     {
@@ -248,7 +366,10 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
     ProcessOsmElementsFromXML(reader, processor);
     break;
   case feature::GenerateInfo::OsmSourceType::O5M:
-    ProcessOsmElementsFromO5M(reader, processor);
+    ProcessOsmElementsFromO5M(reader, info.m_threadsCount, processor);
+    break;
+  case feature::GenerateInfo::OsmSourceType::PBF:
+    ProcessOsmElementsFromPbf(reader, info.m_threadsCount, processor);
     break;
   }
 
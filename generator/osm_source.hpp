@@ -3,17 +3,23 @@
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_data.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/translator_interface.hpp"
 
 #include "coding/parse_xml.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
+#include <deque>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <vector>
 
 struct OsmElement;
 class FeatureParams;
@@ -48,7 +54,11 @@ public:
 bool GenerateIntermediateData(feature::GenerateInfo & info);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void (OsmElement &&)> const & processor);
+void ProcessOsmElementsFromO5M(SourceReader & stream, size_t threadsCount,
+                               std::function<void (OsmElement &&)> const & processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void (OsmElement &&)> const & processor);
+void ProcessOsmElementsFromPbf(SourceReader & stream, size_t threadsCount,
+                               std::function<void (OsmElement &&)> const & processor);
 
 class ProcessorOsmElementsInterface
 {
@@ -58,18 +68,53 @@ public:
   virtual bool TryRead(OsmElement & element) = 0;
 };
 
+// Elements of an O5M file are decoded strictly in order because of the string table and the
+// delta coding, but when |threadsCount| > 1 they are decoded in batches on a separate thread,
+// in parallel with the processing of the previous batches. At most 2 batches are decoded ahead.
 class ProcessorOsmElementsFromO5M : public ProcessorOsmElementsInterface
 {
 public:
-  explicit ProcessorOsmElementsFromO5M(SourceReader & stream);
+  explicit ProcessorOsmElementsFromO5M(SourceReader & stream, size_t threadsCount = 1);
 
   // ProcessorOsmElementsInterface overrides:
   bool TryRead(OsmElement & element) override;
 
 private:
+  bool ReadElement(OsmElement & element);
+  std::vector<OsmElement> ReadBatch();
+  void SubmitBatches();
+
   SourceReader & m_stream;
   osm::O5MSource m_dataset;
   osm::O5MSource::Iterator m_pos;
+  // A single decoding thread, so the batches are decoded in order.
+  std::unique_ptr<base::thread_pool::computational::ThreadPool> m_pool;
+  std::deque<std::future<std::vector<OsmElement>>> m_pendingBatches;
+  std::vector<OsmElement> m_elements;
+  size_t m_elementIndex = 0;
+  bool m_eof = false;
+};
+
+// Blobs of a PBF file are read sequentially and decoded on |threadsCount| threads.
+// Elements are returned in the file order. At most 2 * |threadsCount| blobs are kept in memory.
+class ProcessorOsmElementsFromPbf : public ProcessorOsmElementsInterface
+{
+public:
+  ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount);
+
+  // ProcessorOsmElementsInterface overrides:
+  bool TryRead(OsmElement & element) override;
+
+private:
+  void SubmitBlobs();
+
+  osm::PbfBlobReader m_reader;
+  std::unique_ptr<base::thread_pool::computational::ThreadPool> m_pool;
+  size_t m_maxPendingBlobs;
+  std::deque<std::future<std::vector<OsmElement>>> m_pendingBlobs;
+  std::vector<OsmElement> m_elements;
+  size_t m_elementIndex = 0;
+  bool m_eof = false;
 };
 
 class ProcessorOsmElementsFromXml : public ProcessorOsmElementsInterface
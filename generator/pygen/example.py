@@ -113,12 +113,25 @@ def example__working_with_mwm(path):
     print("sections_info:", map.sections_info())
 
 
+def example__columnar_processing(path):
+    import array
+
+    map = mwm.Mwm(path, False)
+    # Features are decoded in batches, numeric columns are bytes for numpy.frombuffer.
+    batch_size = 100000
+    for begin in range(0, len(map), batch_size):
+        columns = map.columns(begin, begin + batch_size)
+        centers = array.array("d", columns["center"])
+        print("features:", len(columns["readable_name"]), "first center:", centers[:2])
+
+
 def main(path):
     example__storing_features_in_a_collection(path)
     example__features_generator(path)
     example__sequential_processing(path)
     example__working_with_features(path)
     example__working_with_mwm(path)
+    example__columnar_processing(path)
 
 
 if __name__ == "__main__":
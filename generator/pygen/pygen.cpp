@@ -24,10 +24,12 @@
 
 #include "pyhelpers/module_version.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 #include <boost/python.hpp>
@@ -69,8 +71,7 @@ public:
   {
     bp::dict mmetadata;
     auto const & metadata = m_feature->GetMetadata();
-    for (auto k : metadata.GetKeys())
-      mmetadata[k] = metadata.Get(k);
+    metadata.ForEach([&](auto k, auto const & value) { mmetadata[k] = value; });
 
     return mmetadata;
   }
@@ -86,18 +87,13 @@ public:
     return mnames;
   }
 
-  std::string GetReadableName()
-  {
-    std::string name;
-    m_feature->GetReadableName(name);
-    return name;
-  }
+  std::string GetReadableName() { return std::string(m_feature->GetReadableName()); }
 
   uint8_t GetRank() { return m_feature->GetRank(); }
 
   uint64_t GetPopulation() { return m_feature->GetPopulation(); }
 
-  std::string GetRoadNumber() { return m_feature->GetRoadNumber(); }
+  std::string GetRoadNumber() { return m_feature->GetRef(); }
 
   std::string GetHouseNumber() { return m_feature->GetHouseNumber(); }
 
@@ -192,6 +188,58 @@ public:
     return ftw;
   }
 
+  // Decodes features with indices in [begin, end) at once. Returns a dict of columns, numeric ones
+  // are bytes to be read with numpy.frombuffer:
+  // "index" - uint32, "geom_type" - uint8, "center" - float64 x, y pairs,
+  // "types" - uint32 classificator indices of all features, "types_offsets" - uint32 offsets of
+  // features types in "types" with the trailing end offset,
+  // "readable_name" - list of str.
+  bp::dict GetColumns(uint32_t begin, uint32_t end)
+  {
+    end = std::min(end, static_cast<uint32_t>(Size()));
+    begin = std::min(begin, end);
+
+    std::vector<uint32_t> indices;
+    std::vector<uint8_t> geomTypes;
+    std::vector<double> centers;
+    std::vector<uint32_t> types;
+    std::vector<uint32_t> typesOffsets;
+    bp::list names;
+
+    size_t const count = end - begin;
+    indices.reserve(count);
+    geomTypes.reserve(count);
+    centers.reserve(count * 2);
+    typesOffsets.reserve(count + 1);
+    for (uint32_t i = begin; i < end; ++i)
+    {
+      auto ft = m_guard->GetFeatureByIndex(i);
+      indices.push_back(i);
+      geomTypes.push_back(static_cast<uint8_t>(ft->GetGeomType()));
+
+      auto const center = feature::GetCenter(*ft);
+      centers.push_back(center.x);
+      centers.push_back(center.y);
+
+      typesOffsets.push_back(static_cast<uint32_t>(types.size()));
+      ft->ForEachType([&](auto t) {
+        types.push_back(classif().IsTypeValid(t) ? classif().GetIndexForType(t) : kInvalidIndex);
+      });
+
+      names.append(std::string(ft->GetReadableName()));
+    }
+    typesOffsets.push_back(static_cast<uint32_t>(types.size()));
+
+    bp::dict columns;
+    columns["index"] = ToBytes(indices);
+    columns["geom_type"] = ToBytes(geomTypes);
+    columns["center"] = ToBytes(centers);
+    columns["types"] = ToBytes(types);
+    columns["types_offsets"] = ToBytes(typesOffsets);
+    columns["readable_name"] = names;
+    return columns;
+  }
+
   bp::dict GetSectionsInfo() const
   {
     bp::dict sectionsInfo;
@@ -212,6 +260,13 @@ private:
 
   void SetSelfPtr(boost::weak_ptr<Mwm> const & self) { m_self = self; }
 
+  template <typename T>
+  static bp::object ToBytes(std::vector<T> const & values)
+  {
+    return bp::object(bp::handle<>(PyBytes_FromStringAndSize(
+        reinterpret_cast<char const *>(values.data()), values.size() * sizeof(T))));
+  }
+
   generator::SingleMwmDataSource m_ds;
   MwmValue m_mwmValue;
   std::unique_ptr<FeaturesLoaderGuard> m_guard;
@@ -374,6 +429,7 @@ BOOST_PYTHON_MODULE(pygen)
         .def("type", &Mwm::GetType)
         .def("bounds", &Mwm::GetBounds)
         .def("sections_info", &Mwm::GetSectionsInfo)
+        .def("columns", &Mwm::GetColumns)
         .def("__iter__", &Mwm::MakeMwmIter)
         .def("__len__", &Mwm::Size);
 
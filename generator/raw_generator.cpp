@@ -28,7 +28,8 @@ public:
   {
   }
 
-  void Log(std::vector<OsmElement> const & elements, uint64_t pos, bool forcePrint = false)
+  // Returns true when the stats were printed.
+  bool Log(std::vector<OsmElement> const & elements, uint64_t pos, bool forcePrint = false)
   {
     for (auto const & e : elements)
     {
@@ -44,7 +45,7 @@ public:
     if (!forcePrint && m_callCount != m_logCallCountThreshold)
     {
       ++m_callCount;
-      return;
+      return false;
     }
 
     auto static constexpr kBytesInMiB = 1024.0 * 1024.0;
@@ -64,6 +65,7 @@ public:
     m_wayCounter = 0;
     m_relationCounter = 0;
     m_callCount = 0;
+    return true;
   }
 
 private:
@@ -84,7 +86,8 @@ RawGenerator::RawGenerator(feature::GenerateInfo & genInfo, size_t threadsCount,
   , m_threadsCount(threadsCount)
   , m_chunkSize(chunkSize)
   , m_cache(std::make_shared<generator::cache::IntermediateData>(m_intermediateDataObjectsCache, genInfo))
-  , m_queue(std::make_shared<FeatureProcessorQueue>())
+  // Translators wait for the writer when it's behind, so serialized features don't pile up.
+  , m_queue(std::make_shared<FeatureProcessorQueue>(4 * threadsCount /* capacity */))
   , m_translators(std::make_shared<TranslatorCollection>())
 {
 }
@@ -212,7 +215,8 @@ RawGenerator::FinalProcessorPtr RawGenerator::CreateWorldFinalProcessor(bool cut
     // This file should exist or read exception will be thrown otherwise.
     coastlineGeom  = m_genInfo.GetIntermediateFileName(WORLD_COASTS_FILE_NAME, RAW_GEOM_FILE_EXTENSION);
   }
-  auto finalProcessor = std::make_shared<WorldFinalProcessor>(m_genInfo.m_tmpDir, coastlineGeom);
+  auto finalProcessor = std::make_shared<WorldFinalProcessor>(m_genInfo.m_tmpDir, coastlineGeom,
+                                                              m_threadsCount);
 
   finalProcessor->SetPopularPlaces(m_genInfo.m_popularPlacesFilename);
   return finalProcessor;
@@ -235,11 +239,14 @@ bool RawGenerator::GenerateFilteredFeatures()
   switch (m_genInfo.m_osmFileType)
   {
   case feature::GenerateInfo::OsmSourceType::O5M:
-    sourceProcessor = std::make_unique<ProcessorOsmElementsFromO5M>(reader);
+    sourceProcessor = std::make_unique<ProcessorOsmElementsFromO5M>(reader, m_threadsCount);
     break;
   case feature::GenerateInfo::OsmSourceType::XML:
     sourceProcessor = std::make_unique<ProcessorOsmElementsFromXml>(reader);
     break;
+  case feature::GenerateInfo::OsmSourceType::PBF:
+    sourceProcessor = std::make_unique<ProcessorOsmElementsFromPbf>(reader, m_threadsCount);
+    break;
   }
   CHECK(sourceProcessor, ());
 
@@ -258,7 +265,12 @@ bool RawGenerator::GenerateFilteredFeatures()
       ++idx;
 
     isEnd = idx < m_chunkSize;
-    stats.Log(elements, reader.Pos(), isEnd/* forcePrint */);
+    if (stats.Log(elements, reader.Pos(), isEnd/* forcePrint */))
+    {
+      // Full queues show the next stage is the bottleneck, empty ones show the previous one is.
+      LOG(LINFO, ("Translated", translators.GetTranslatedElementsCount(), "elements [elements queue:",
+                  translators.GetQueueSize(), "batches, features queue:", m_queue->Size(), "chunks]"));
+    }
 
     if (isEnd)
       elements.resize(idx);
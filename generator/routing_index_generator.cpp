@@ -44,6 +44,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace routing_builder
@@ -527,6 +528,15 @@ void FillWeights(string const & path, string const & mwmFile, string const & cou
 
   auto const & connector = builder.PrepareConnector(vhType);
   uint32_t const numEnters = connector.GetNumEnters();
+
+  // Only the visited vertexes of the exit features are needed to find the weights, so the others,
+  // which are most of the graph, are not kept.
+  std::unordered_set<uint32_t> exitFeatures;
+  connector.ForEachExit([&](uint32_t, Segment const & exit)
+  {
+    exitFeatures.insert(exit.GetFeatureId());
+  });
+
   uint32_t i = 0;
   connector.ForEachEnter([&](uint32_t, Segment const & enter)
   {
@@ -554,9 +564,10 @@ void FillWeights(string const & path, string const & mwmFile, string const & cou
             if (start.IsForward() != end.IsForward())
               return true;
 
-            visitedVertexes[end.GetFeatureId()].emplace_back(start, end);
+            if (exitFeatures.count(end.GetFeatureId()) != 0)
+              visitedVertexes[end.GetFeatureId()].emplace_back(start, end);
           }
-          else
+          else if (exitFeatures.count(vertex.GetFeatureId()) != 0)
           {
             visitedVertexes[vertex.GetFeatureId()].emplace_back(vertex);
           }
@@ -16,16 +16,21 @@
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/louds_trie.hpp"
 #include "indexer/postcodes_matcher.hpp"
 #include "indexer/road_shields_parser.hpp"
 #include "indexer/scales_patch.hpp"
 #include "indexer/search_string_utils.hpp"
 #include "indexer/trie_builder.hpp"
+#include "indexer/trie_reader.hpp"
 
 #include "platform/platform.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/reader_writer_ops.hpp"
 #include "coding/succinct_mapper.hpp"
+#include "coding/varint.hpp"
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
@@ -42,6 +47,8 @@
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <queue>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -379,18 +386,206 @@ private:
   FeatureNameInserter<ContT> m_inserter;
 };
 
-template <class ContT>
-void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
-                              CategoriesHolder const & categoriesHolder,
-                              ContT & keyValuePairs)
+using SearchIndexKey = strings::UniString;
+using SearchIndexValue = Uint64IndexValue;
+using SearchIndexPair = std::pair<SearchIndexKey, SearchIndexValue>;
+
+// Maximum number of key/value pairs which are kept in memory by all threads together.
+size_t constexpr kMaxSearchIndexPairsInMemory = 1 << 21;
+
+// Collects key/value pairs of one thread. When the buffer is full, it is sorted and spilled
+// to a temporary file, so the memory usage doesn't depend on the mwm size. The last run is
+// kept in memory.
+class SearchIndexPairsRuns
+{
+public:
+  SearchIndexPairsRuns(std::string const & filePrefix, size_t maxBufferSize)
+    : m_filePrefix(filePrefix), m_maxBufferSize(std::max(maxBufferSize, size_t{1}))
+  {
+    m_buffer.reserve(m_maxBufferSize);
+  }
+
+  SearchIndexPairsRuns(SearchIndexPairsRuns &&) = default;
+
+  ~SearchIndexPairsRuns()
+  {
+    for (auto const & fileName : m_runFiles)
+      FileWriter::DeleteFileX(fileName);
+  }
+
+  void emplace_back(SearchIndexKey const & key, uint32_t featureId)
+  {
+    m_buffer.emplace_back(key, SearchIndexValue(featureId));
+    if (m_buffer.size() >= m_maxBufferSize)
+      Spill();
+  }
+
+  // Sorts the last run.
+  void Finish() { std::sort(m_buffer.begin(), m_buffer.end()); }
+
+  std::vector<std::string> const & GetRunFiles() const { return m_runFiles; }
+  std::vector<SearchIndexPair> const & GetBuffer() const { return m_buffer; }
+
+private:
+  void Spill()
+  {
+    std::sort(m_buffer.begin(), m_buffer.end());
+
+    auto const fileName = m_filePrefix + std::to_string(m_runFiles.size()) + EXTENSION_TMP;
+    m_runFiles.push_back(fileName);
+
+    FileWriter writer(fileName);
+    for (auto const & [key, value] : m_buffer)
+    {
+      WriteVarUint(writer, static_cast<uint32_t>(key.size()));
+      for (auto const c : key)
+        WriteVarUint(writer, c);
+      WriteVarUint(writer, value.m_featureId);
+    }
+    m_buffer.clear();
+  }
+
+  std::string m_filePrefix;
+  size_t m_maxBufferSize;
+  std::vector<SearchIndexPair> m_buffer;
+  std::vector<std::string> m_runFiles;
+};
+
+// Sequentially reads a sorted run, either spilled to a file or kept in memory.
+class SearchIndexPairsCursor
+{
+public:
+  explicit SearchIndexPairsCursor(std::string const & fileName)
+    : m_source(std::make_unique<ReaderSource<FileReader>>(FileReader(fileName)))
+  {
+  }
+
+  explicit SearchIndexPairsCursor(std::vector<SearchIndexPair> const & pairs) : m_pairs(&pairs) {}
+
+  // Returns false when the run is over.
+  bool Next(SearchIndexPair & pair)
+  {
+    if (m_source)
+    {
+      if (m_source->Size() == 0)
+        return false;
+
+      auto & [key, value] = pair;
+      key.resize(ReadVarUint<uint32_t>(*m_source));
+      for (auto & c : key)
+        c = ReadVarUint<uint32_t>(*m_source);
+      value.m_featureId = ReadVarUint<uint64_t>(*m_source);
+      return true;
+    }
+
+    if (m_index == m_pairs->size())
+      return false;
+    pair = (*m_pairs)[m_index++];
+    return true;
+  }
+
+private:
+  std::unique_ptr<ReaderSource<FileReader>> m_source;
+  std::vector<SearchIndexPair> const * m_pairs = nullptr;
+  size_t m_index = 0;
+};
+
+// Calls |fn| for all pairs of all |runs| in the sorted order.
+template <class FnT>
+void MergeSearchIndexPairs(std::vector<SearchIndexPairsRuns> const & runs, FnT && fn)
+{
+  std::vector<SearchIndexPairsCursor> cursors;
+  for (auto const & r : runs)
+  {
+    for (auto const & fileName : r.GetRunFiles())
+      cursors.emplace_back(fileName);
+    cursors.emplace_back(r.GetBuffer());
+  }
+
+  using Item = std::pair<SearchIndexPair, size_t>;
+  auto const greater = [](Item const & lhs, Item const & rhs) { return rhs.first < lhs.first; };
+  std::priority_queue<Item, std::vector<Item>, decltype(greater)> queue(greater);
+
+  for (size_t i = 0; i < cursors.size(); ++i)
+  {
+    Item item;
+    if (cursors[i].Next(item.first))
+    {
+      item.second = i;
+      queue.push(std::move(item));
+    }
+  }
+
+  while (!queue.empty())
+  {
+    Item item = queue.top();
+    queue.pop();
+    fn(item.first);
+    if (cursors[item.second].Next(item.first))
+      queue.push(std::move(item));
+  }
+}
+
+// Features are split between |threadsCount| threads by index ranges, each thread reads
+// the mwm on its own and collects pairs to its own |runs| entry.
+void AddFeatureNameIndexPairs(std::string const & fileName,
+                              CategoriesHolder const & categoriesHolder, uint32_t threadsCount,
+                              std::vector<SearchIndexPairsRuns> & runs)
 {
+  FeaturesVectorTest features(fileName);
   feature::DataHeader const & header = features.GetHeader();
 
   std::unique_ptr<SynonymsHolder> synonyms;
   if (header.GetType() == feature::DataHeader::MapType::World)
     synonyms = std::make_unique<SynonymsHolder>();
 
-  features.GetVector().ForEach(FeatureInserter(synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange()));
+  auto const featuresCount = base::checked_cast<uint32_t>(features.GetVector().GetNumFeatures());
+  // Features can't be read by index without the offsets table.
+  if (featuresCount == 0)
+    threadsCount = 1;
+
+  runs.clear();
+  runs.reserve(threadsCount);
+  for (uint32_t i = 0; i < threadsCount; ++i)
+  {
+    runs.emplace_back(fileName + "." + SEARCH_INDEX_FILE_TAG "." + std::to_string(i) + ".",
+                      kMaxSearchIndexPairsInMemory / threadsCount);
+  }
+
+  if (threadsCount == 1)
+  {
+    features.GetVector().ForEach(
+        FeatureInserter(synonyms.get(), runs[0], categoriesHolder, header.GetScaleRange()));
+    runs[0].Finish();
+    return;
+  }
+
+  // Thread working function.
+  auto const fn = [&](uint32_t threadIdx)
+  {
+    auto const fc = static_cast<uint64_t>(featuresCount);
+    auto const beg = static_cast<uint32_t>(fc * threadIdx / threadsCount);
+    auto const end = static_cast<uint32_t>(fc * (threadIdx + 1) / threadsCount);
+
+    FeaturesVectorTest threadFeatures(fileName);
+    FeatureInserter inserter(synonyms.get(), runs[threadIdx], categoriesHolder, header.GetScaleRange());
+    for (uint32_t i = beg; i < end; ++i)
+    {
+      auto ft = threadFeatures.GetVector().GetByIndex(i);
+      CHECK(ft, ());
+      ft->SetID(FeatureID(MwmSet::MwmId(), i));
+      inserter(*ft, i);
+    }
+    runs[threadIdx].Finish();
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(fn, i);
+
+  // Wait for thread's finish.
+  for (auto & t : threads)
+    t.join();
 }
 
 void ReadAddressData(std::string const & filename, std::vector<feature::AddressData> & addrs)
@@ -589,7 +784,7 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
 }  // namespace
 
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount);
 
 bool BuildSearchIndexFromDataFile(std::string const & country, feature::GenerateInfo const & info,
                                   bool forceRebuild, uint32_t threadsCount)
@@ -602,9 +797,11 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
     return true;
 
   auto const indexFilePath = filename + "." + SEARCH_INDEX_FILE_TAG EXTENSION_TMP;
+  auto const trieFilePath = filename + "." + SEARCH_INDEX_FILE_TAG ".trie" EXTENSION_TMP;
   auto const streetsFilePath = filename + "." + FEATURE2STREET_FILE_TAG EXTENSION_TMP;
   auto const placesFilePath = filename + "." + FEATURE2PLACE_FILE_TAG EXTENSION_TMP;
   SCOPE_GUARD(indexFileGuard, std::bind(&FileWriter::DeleteFileX, indexFilePath));
+  SCOPE_GUARD(trieFileGuard, std::bind(&FileWriter::DeleteFileX, trieFilePath));
   SCOPE_GUARD(streetsFileGuard, std::bind(&FileWriter::DeleteFileX, streetsFilePath));
   SCOPE_GUARD(placesFileGuard, std::bind(&FileWriter::DeleteFileX, placesFilePath));
 
@@ -612,10 +809,16 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      BuildSearchIndex(readContainer, writer, threadsCount);
       LOG(LINFO, ("Search index size =", writer.Size()));
     }
 
+    // The trie is written reversed (see trie_builder.hpp).
+    {
+      FileWriter writer(trieFilePath);
+      rw_ops::Reverse(FileReader(indexFilePath), writer);
+    }
+
     if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
     {
       FileWriter streetsWriter(streetsFilePath);
@@ -639,8 +842,16 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
       coding::WritePadding(*writer, bytesWritten);
 
       header.m_indexOffset = base::asserted_cast<uint32_t>(writer->Pos() - startOffset);
-      rw_ops::Reverse(FileReader(indexFilePath), *writer);
+      {
+        // The trie is converted to the LOUDS format, which is read from the mapped mwm in place.
+        using Serializer = SingleValueSerializer<SearchIndexValue>;
+        Serializer serializer;
+        auto const root = trie::ReadTrie<FileReader, ValueList<SearchIndexValue>>(
+            FileReader(trieFilePath), serializer);
+        trie::BuildLoudsTrie(*writer, serializer, *root);
+      }
       header.m_indexSize = base::asserted_cast<uint32_t>(writer->Pos() - header.m_indexOffset - startOffset);
+      LOG(LINFO, ("LOUDS search index size =", header.m_indexSize));
 
       auto const endOffset = writer->Pos();
       writer->Seek(startOffset);
@@ -668,27 +879,25 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount)
 {
-  using Key = strings::UniString;
-  using Value = Uint64IndexValue;
-
   LOG(LINFO, ("Start building search index for", container.GetFileName()));
   base::Timer timer;
 
   auto const & categoriesHolder = GetDefaultCategories();
 
-  FeaturesVectorTest features(container);
-  SingleValueSerializer<Value> serializer;
-
-  std::vector<std::pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
-
-  std::sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  std::vector<SearchIndexPairsRuns> runs;
+  AddFeatureNameIndexPairs(container.GetFileName(), categoriesHolder, std::max(threadsCount, 1u),
+                           runs);
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
-  trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
-      indexWriter, serializer, searchIndexKeyValuePairs);
+  // Sorted runs are merged straight into the trie, so only the current key path is in memory.
+  using Serializer = SingleValueSerializer<SearchIndexValue>;
+  Serializer serializer;
+  trie::Builder<Writer, SearchIndexKey, ValueList<SearchIndexValue>, Serializer> builder(
+      indexWriter, serializer);
+  MergeSearchIndexPairs(runs, [&builder](SearchIndexPair const & pair) { builder.Add(pair); });
+  builder.Finish();
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
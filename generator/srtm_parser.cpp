@@ -8,9 +8,13 @@
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
+#include <numeric>
 #include <sstream>
+#include <thread>
 
 namespace generator
 {
@@ -50,7 +54,8 @@ SrtmTile::SrtmTile()
   Invalidate();
 }
 
-SrtmTile::SrtmTile(SrtmTile && rhs) : m_data(std::move(rhs.m_data)), m_valid(rhs.m_valid)
+SrtmTile::SrtmTile(SrtmTile && rhs)
+  : m_data(std::move(rhs.m_data)), m_mappedFile(std::move(rhs.m_mappedFile)), m_valid(rhs.m_valid)
 {
   rhs.Invalidate();
 }
@@ -90,12 +95,15 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   }
   else
   {
-    GetPlatform().GetReader(file)->ReadAsString(m_data);
+    auto path = base::JoinPath(dir, file);
+    if (!Platform::IsFileExistsByFullPath(path))
+      path = GetPlatform().ReadPathForFile(file);
+    m_mappedFile = std::make_unique<MmapReader>(path, MmapReader::Advice::Random);
   }
 
-  if (m_data.size() != kSrtmTileSize)
+  if (Size() * sizeof(geometry::Altitude) != kSrtmTileSize)
   {
-    LOG(LWARNING, ("Bad decompressed SRTM file size:", cont, m_data.size()));
+    LOG(LWARNING, ("Bad decompressed SRTM file size:", cont, Size() * sizeof(geometry::Altitude)));
     Invalidate();
     return;
   }
@@ -172,35 +180,72 @@ void SrtmTile::Invalidate()
 {
   m_data.clear();
   m_data.shrink_to_fit();
+  m_mappedFile.reset();
   m_valid = false;
 }
 
 // SrtmTileManager ---------------------------------------------------------------------------------
-SrtmTileManager::SrtmTileManager(std::string const & dir) : m_dir(dir) {}
+SrtmTileManager::SrtmTileManager(std::string const & dir, size_t maxTilesCount)
+  : m_dir(dir), m_maxTilesCount(maxTilesCount)
+{
+}
+
 geometry::Altitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
 {
-  auto const key = GetKey(coord);
+  return GetTilePtr(coord)->GetHeight(coord);
+}
 
-  auto it = m_tiles.find(key);
-  if (it == m_tiles.end())
+void SrtmTileManager::GetHeights(std::vector<ms::LatLon> const & coords,
+                                 geometry::Altitudes & heights, size_t threadsCount)
+{
+  heights.assign(coords.size(), geometry::kInvalidAltitude);
+
+  std::vector<LatLonKey> keys;
+  keys.reserve(coords.size());
+  for (auto const & coord : coords)
+    keys.push_back(GetKey(coord));
+
+  // Group points by tiles.
+  std::vector<size_t> order(coords.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs)
   {
-    SrtmTile tile;
-    try
-    {
-      tile.Init(m_dir, coord);
-    }
-    catch (RootException const & e)
+    return keys[lhs] < keys[rhs];
+  });
+
+  std::vector<size_t> groupStarts;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (i == 0 || keys[order[i]] != keys[order[i - 1]])
+      groupStarts.push_back(i);
+  }
+  groupStarts.push_back(order.size());
+
+  size_t const groupsCount = groupStarts.size() - 1;
+  std::atomic<size_t> nextGroup = 0;
+  auto const fn = [&]()
+  {
+    for (size_t group = nextGroup++; group < groupsCount; group = nextGroup++)
     {
-      std::string const base = SrtmTile::GetBase(coord);
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+      auto const tile = GetTilePtr(coords[order[groupStarts[group]]]);
+      for (size_t i = groupStarts[group]; i < groupStarts[group + 1]; ++i)
+        heights[order[i]] = tile->GetHeight(coords[order[i]]);
     }
+  };
 
-    // It's OK to store even invalid tiles and return invalid height
-    // for them later.
-    it = m_tiles.emplace(key, std::move(tile)).first;
+  threadsCount = std::min(std::max(threadsCount, size_t{1}), groupsCount);
+  if (threadsCount <= 1)
+  {
+    fn();
+    return;
   }
 
-  return it->second.GetHeight(coord);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(fn);
+
+  for (auto & t : threads)
+    t.join();
 }
 
 // static
@@ -212,11 +257,54 @@ SrtmTileManager::LatLonKey SrtmTileManager::GetKey(ms::LatLon const & coord)
 
 SrtmTile const & SrtmTileManager::GetTile(ms::LatLon const & coord)
 {
-  // Touch the tile to force its loading.
-  GetHeight(coord);
+  return *GetTilePtr(coord);
+}
+
+std::shared_ptr<SrtmTile const> SrtmTileManager::GetTilePtr(ms::LatLon const & coord)
+{
   auto const key = GetKey(coord);
-  auto const it = m_tiles.find(key);
-  CHECK(it != m_tiles.end(), (coord));
-  return it->second;
+  {
+    std::lock_guard guard(m_mutex);
+    auto const it = m_tiles.find(key);
+    if (it != m_tiles.end())
+    {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+      return it->second.m_tile;
+    }
+  }
+
+  // Tiles are loaded without the lock, so different tiles may be loaded in parallel.
+  auto tile = std::make_shared<SrtmTile>();
+  try
+  {
+    tile->Init(m_dir, coord);
+  }
+  catch (RootException const & e)
+  {
+    std::string const base = SrtmTile::GetBase(coord);
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+  }
+
+  std::lock_guard guard(m_mutex);
+  auto const [it, inserted] = m_tiles.emplace(key, Entry());
+  if (!inserted)
+  {
+    // The tile has been loaded by another thread.
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+    return it->second.m_tile;
+  }
+
+  // It's OK to store even invalid tiles and return invalid height
+  // for them later.
+  m_lru.push_front(key);
+  it->second.m_tile = tile;
+  it->second.m_lruIt = m_lru.begin();
+
+  while (m_maxTilesCount != 0 && m_tiles.size() > m_maxTilesCount)
+  {
+    m_tiles.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+  return tile;
 }
 }  // namespace generator
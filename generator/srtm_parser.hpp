@@ -4,13 +4,19 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include "coding/mmap_reader.hpp"
+
 #include "geometry/point_with_altitude.hpp"
 
 #include "base/macros.hpp"
 
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace generator
 {
@@ -33,32 +39,54 @@ public:
 private:
   inline geometry::Altitude const * Data() const
   {
+    if (m_mappedFile)
+      return reinterpret_cast<geometry::Altitude const *>(m_mappedFile->Data());
     return reinterpret_cast<geometry::Altitude const *>(m_data.data());
   };
 
-  inline size_t Size() const { return m_data.size() / sizeof(geometry::Altitude); }
+  inline size_t Size() const
+  {
+    auto const size = m_mappedFile ? m_mappedFile->Size() : m_data.size();
+    return size / sizeof(geometry::Altitude);
+  }
   void Invalidate();
 
+  // Unzipped tile data.
   std::string m_data;
+  // Uncompressed .hgt files are memory mapped instead of being read.
+  std::unique_ptr<MmapReader> m_mappedFile;
   bool m_valid;
 
   DISALLOW_COPY(SrtmTile);
 };
 
+// Loads tiles lazily. When |maxTilesCount| is not zero, the least recently used tiles are
+// evicted to keep at most |maxTilesCount| tiles in memory (every tile takes ~25Mb).
+// All methods are thread-safe.
 class SrtmTileManager
 {
 public:
-  explicit SrtmTileManager(std::string const & dir);
+  explicit SrtmTileManager(std::string const & dir, size_t maxTilesCount = 0);
 
   geometry::Altitude GetHeight(ms::LatLon const & coord);
 
+  // Fills |heights| with heights at |coords|. Points are grouped by tiles, and the tiles
+  // are processed on |threadsCount| threads.
+  void GetHeights(std::vector<ms::LatLon> const & coords, geometry::Altitudes & heights,
+                  size_t threadsCount);
+
+  // The returned reference is valid until the tile is evicted, so it's always valid
+  // when there's no tiles count limit.
   SrtmTile const & GetTile(ms::LatLon const & coord);
+  // The returned tile stays valid while it's owned, even if it's evicted from the cache.
+  std::shared_ptr<SrtmTile const> GetTilePtr(ms::LatLon const & coord);
 
 private:
   using LatLonKey = std::pair<int32_t, int32_t>;
   static LatLonKey GetKey(ms::LatLon const & coord);
 
   std::string m_dir;
+  size_t m_maxTilesCount;
 
   struct Hash
   {
@@ -68,7 +96,16 @@ private:
     }
   };
 
-  std::unordered_map<LatLonKey, SrtmTile, Hash> m_tiles;
+  struct Entry
+  {
+    std::shared_ptr<SrtmTile const> m_tile;
+    std::list<LatLonKey>::iterator m_lruIt;
+  };
+
+  std::mutex m_mutex;
+  std::unordered_map<LatLonKey, Entry, Hash> m_tiles;
+  // Keys of the loaded tiles, the most recently used first.
+  std::list<LatLonKey> m_lru;
 
   DISALLOW_COPY(SrtmTileManager);
 };
@@ -0,0 +1,130 @@
+#include "generator/stages_profiler.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if !defined(OMIM_OS_WINDOWS)
+#include <sys/resource.h>
+#endif
+
+#include "cppjansson/cppjansson.hpp"
+
+namespace generator
+{
+namespace
+{
+double GetCpuSeconds()
+{
+#if defined(OMIM_OS_WINDOWS)
+  return 0.0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+
+  auto const toSeconds = [](timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; };
+  return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#endif
+}
+
+uint64_t GetPeakRssBytes()
+{
+#if defined(OMIM_OS_WINDOWS)
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // Linux reports kilobytes.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Reads bytes passed through read and write calls by the process so far.
+void GetIoBytes(uint64_t & readBytes, uint64_t & writtenBytes)
+{
+  readBytes = 0;
+  writtenBytes = 0;
+#if defined(OMIM_OS_LINUX)
+  std::ifstream stream("/proc/self/io");
+  std::string key;
+  uint64_t value;
+  while (stream >> key >> value)
+  {
+    if (key == "rchar:")
+      readBytes = value;
+    else if (key == "wchar:")
+      writtenBytes = value;
+  }
+#endif
+}
+}  // namespace
+
+StagesProfiler::Stage::Stage(StagesProfiler & profiler, std::string const & country,
+                             std::string const & name)
+  : m_profiler(profiler), m_startCpuSeconds(GetCpuSeconds())
+{
+  m_sample.m_country = country;
+  m_sample.m_stage = name;
+  GetIoBytes(m_startReadBytes, m_startWrittenBytes);
+}
+
+StagesProfiler::Stage::~Stage()
+{
+  m_sample.m_wallSeconds = m_timer.ElapsedSeconds();
+  m_sample.m_cpuSeconds = GetCpuSeconds() - m_startCpuSeconds;
+  m_sample.m_peakRssBytes = GetPeakRssBytes();
+
+  uint64_t readBytes;
+  uint64_t writtenBytes;
+  GetIoBytes(readBytes, writtenBytes);
+  m_sample.m_readBytes = readBytes - m_startReadBytes;
+  m_sample.m_writtenBytes = writtenBytes - m_startWrittenBytes;
+
+  LOG(LINFO, (DebugPrint(m_sample)));
+  m_profiler.m_samples.emplace_back(std::move(m_sample));
+}
+
+void StagesProfiler::Save(std::string const & path) const
+{
+  auto array = base::NewJSONArray();
+  for (auto const & sample : m_samples)
+  {
+    auto node = base::NewJSONObject();
+    ToJSONObject(*node, "country", sample.m_country);
+    ToJSONObject(*node, "stage", sample.m_stage);
+    ToJSONObject(*node, "wall_seconds", sample.m_wallSeconds);
+    ToJSONObject(*node, "cpu_seconds", sample.m_cpuSeconds);
+    ToJSONObject(*node, "peak_rss_bytes", sample.m_peakRssBytes);
+    ToJSONObject(*node, "read_bytes", sample.m_readBytes);
+    ToJSONObject(*node, "written_bytes", sample.m_writtenBytes);
+    json_array_append_new(array.get(), node.release());
+  }
+
+  auto const str = base::DumpToString(array, JSON_INDENT(2));
+  FileWriter writer(path);
+  writer.Write(str.data(), str.size());
+}
+
+std::string DebugPrint(StagesProfiler::Sample const & sample)
+{
+  std::ostringstream out;
+  out << "Stage " << sample.m_stage << " for " << sample.m_country
+      << ": wall " << sample.m_wallSeconds << "s, cpu " << sample.m_cpuSeconds
+      << "s, peak rss " << sample.m_peakRssBytes / (1024 * 1024) << "MB, read "
+      << sample.m_readBytes / (1024 * 1024) << "MB, written "
+      << sample.m_writtenBytes / (1024 * 1024) << "MB";
+  return out.str();
+}
+}  // namespace generator
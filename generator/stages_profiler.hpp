@@ -0,0 +1,67 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Collects resources spent by generator stages per country to compare runs of different
+// generator versions. Usage:
+//   {
+//     auto const stage = profiler.Start(country, "search_index");
+//     ...
+//   }
+class StagesProfiler
+{
+public:
+  struct Sample
+  {
+    std::string m_country;
+    std::string m_stage;
+    double m_wallSeconds = 0.0;
+    double m_cpuSeconds = 0.0;
+    // Peak rss of the process at the end of the stage. It never decreases, so the stage which
+    // has grown it the last is the one to blame.
+    uint64_t m_peakRssBytes = 0;
+    // Bytes passed through read and write calls, mmapped files are not counted.
+    // Available on Linux only.
+    uint64_t m_readBytes = 0;
+    uint64_t m_writtenBytes = 0;
+  };
+
+  class Stage
+  {
+  public:
+    Stage(StagesProfiler & profiler, std::string const & country, std::string const & name);
+    Stage(Stage const &) = delete;
+    Stage & operator=(Stage const &) = delete;
+    ~Stage();
+
+  private:
+    StagesProfiler & m_profiler;
+    Sample m_sample;
+    base::Timer m_timer;
+    double m_startCpuSeconds;
+    uint64_t m_startReadBytes = 0;
+    uint64_t m_startWrittenBytes = 0;
+  };
+
+  Stage Start(std::string const & country, std::string const & name)
+  {
+    return Stage(*this, country, name);
+  }
+
+  std::vector<Sample> const & GetSamples() const { return m_samples; }
+
+  // Writes samples as a json array of objects, one per stage run.
+  void Save(std::string const & path) const;
+
+private:
+  std::vector<Sample> m_samples;
+};
+
+std::string DebugPrint(StagesProfiler::Sample const & sample);
+}  // namespace generator
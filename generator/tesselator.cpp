@@ -87,34 +87,50 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
     return buffer.size();
   }
 
+  void TrianglesInfo::ListInfo::Start(PointsInfo const & points) const
+  {
+    m_visited.assign(m_triangles.size(), false);
+    m_visitedCount = 0;
+
+    m_borderEdges.clear();
+    for (TIterator i = m_neighbors.begin(); i != m_neighbors.end(); ++i)
+    {
+      if (m_neighbors.find(std::make_pair(i->first.second, i->first.first)) != m_neighbors.end())
+        continue;
+
+      uint64_t deltas[3];
+      deltas[0] = coding::EncodePointDeltaAsUint(points.m_points[i->first.first], points.m_base);
+      deltas[1] = coding::EncodePointDeltaAsUint(points.m_points[i->first.second],
+                                                 points.m_points[i->first.first]);
+      deltas[2] = coding::EncodePointDeltaAsUint(
+          points.m_points[m_triangles[i->second].GetPoint3(i->first)],
+          points.m_points[i->first.second]);
+
+      m_borderEdges.emplace_back(i, GetBufferSize(deltas, deltas + 3));
+    }
+  }
+
   /// Find best (cheap in serialization) start edge for processing.
-  TrianglesInfo::ListInfo::TIterator
-  TrianglesInfo::ListInfo::FindStartTriangle(PointsInfo const & points) const
+  TrianglesInfo::ListInfo::TIterator TrianglesInfo::ListInfo::FindStartTriangle() const
   {
     TIterator ret = m_neighbors.end();
     size_t cr = std::numeric_limits<size_t>::max();
 
-    for (TIterator i = m_neighbors.begin(); i != m_neighbors.end(); ++i)
+    // Triangles never become unvisited, so edges of visited triangles are dropped.
+    size_t count = 0;
+    for (auto const & edge : m_borderEdges)
     {
-      if (!m_visited[i->second] &&
-          m_neighbors.find(std::make_pair(i->first.second, i->first.first)) == m_neighbors.end())
+      if (m_visited[edge.first->second])
+        continue;
+
+      if (edge.second < cr)
       {
-        uint64_t deltas[3];
-        deltas[0] = coding::EncodePointDeltaAsUint(points.m_points[i->first.first], points.m_base);
-        deltas[1] = coding::EncodePointDeltaAsUint(points.m_points[i->first.second],
-                                                   points.m_points[i->first.first]);
-        deltas[2] = coding::EncodePointDeltaAsUint(
-            points.m_points[m_triangles[i->second].GetPoint3(i->first)],
-            points.m_points[i->first.second]);
-
-        size_t const sz = GetBufferSize(deltas, deltas + 3);
-        if (sz < cr)
-        {
-          ret = i;
-          cr = sz;
-        }
+        ret = edge.first;
+        cr = edge.second;
       }
+      m_borderEdges[count++] = edge;
     }
+    m_borderEdges.resize(count);
 
     ASSERT ( ret != m_neighbors.end(), ("?WTF? There is no border triangles!") );
     return ret;
@@ -192,6 +208,7 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
       if (m_visited[e.m_p[1]])
         continue;
       m_visited[e.m_p[1]] = true;
+      ++m_visitedCount;
 
       // push to chain
       chain.push_back(e);
@@ -76,6 +76,8 @@ namespace tesselator
       using TNeighbours = std::unordered_map<std::pair<int, int>, int, HashPair<int, int>>;
       TNeighbours m_neighbors;
 
+      mutable size_t m_visitedCount = 0;
+
       void AddNeighbour(int p1, int p2, int trg);
 
       void GetNeighbors(
@@ -94,19 +96,16 @@ namespace tesselator
 
       void Add(int p0, int p1, int p2);
 
-      void Start() const
-      {
-        m_visited.resize(m_triangles.size());
-      }
+      void Start(PointsInfo const & points) const;
 
-      bool HasUnvisited() const
-      {
-        std::vector<bool> test;
-        test.assign(m_triangles.size(), true);
-        return (m_visited != test);
-      }
+      bool HasUnvisited() const { return m_visitedCount < m_triangles.size(); }
+
+      TIterator FindStartTriangle() const;
 
-      TIterator FindStartTriangle(PointsInfo const & points) const;
+    private:
+      // Border edges (without an opposite edge) with the sizes of their start deltas, in the
+      // order of m_neighbors. Edges of visited triangles are removed by FindStartTriangle.
+      mutable std::vector<std::pair<TIterator, size_t>> m_borderEdges;
 
     private:
       template <class TPopOrder>
@@ -163,11 +162,11 @@ namespace tesselator
       // process portions and push out result chains
       for (auto const & trg : m_triangles)
       {
-        trg.Start();
+        trg.Start(points);
 
         do
         {
-          auto start = trg.FindStartTriangle(points);
+          auto start = trg.FindStartTriangle();
 
           std::vector<Edge> chain;
           trg.MakeTrianglesChain(points, start, chain, goodOrder);
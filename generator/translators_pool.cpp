@@ -6,41 +6,70 @@ namespace generator
 {
 TranslatorsPool::TranslatorsPool(std::shared_ptr<TranslatorInterface> const & original,
                                  size_t threadCount)
-  : m_threadPool(threadCount)
+  : m_batches(2 * threadCount /* capacity */)
+  , m_threadPool(threadCount)
 {
   CHECK_GREATER_OR_EQUAL(threadCount, 1, ());
 
-  m_translators.Push(original);
+  m_translators.push_back(original);
   for (size_t i = 1; i < threadCount; ++i)
-    m_translators.Push(original->Clone());
+    m_translators.push_back(original->Clone());
+
+  for (auto const & translator : m_translators)
+  {
+    m_threadPool.SubmitWork([this, translator]()
+    {
+      while (true)
+      {
+        Batch batch;
+        m_batches.WaitAndPop(batch);
+        // An empty batch is a sign of the end of the input, every worker gets its own one.
+        if (!batch.has_value())
+          return;
+
+        for (auto const & element : *batch)
+          translator->Emit(element);
+
+        m_translatedElementsCount += batch->size();
+      }
+    });
+  }
+}
+
+TranslatorsPool::~TranslatorsPool()
+{
+  StopWorkers();
 }
 
 void TranslatorsPool::Emit(std::vector<OsmElement> && elements)
 {
-  std::shared_ptr<TranslatorInterface> translator;
-  m_translators.WaitAndPop(translator);
-  m_threadPool.SubmitWork([&, translator, elements = std::move(elements)]() mutable
-  {
-    for (auto const & element : elements)
-      translator->Emit(element);
+  CHECK(!m_stopped, ());
+  m_batches.Push(std::move(elements));
+}
 
-    m_translators.Push(translator);
-  });
+void TranslatorsPool::StopWorkers()
+{
+  if (m_stopped)
+    return;
+
+  m_stopped = true;
+  for (size_t i = 0; i < m_translators.size(); ++i)
+    m_batches.Push(Batch());
+  m_threadPool.WaitingStop();
 }
 
 bool TranslatorsPool::Finish()
 {
-  m_threadPool.WaitingStop();
+  StopWorkers();
   using TranslatorPtr = std::shared_ptr<TranslatorInterface>;
   threads::ThreadSafeQueue<std::future<TranslatorPtr>> queue;
-  while (!m_translators.Empty())
+  for (auto const & translator : m_translators)
   {
     std::promise<TranslatorPtr> p;
-    std::shared_ptr<TranslatorInterface> translator;
-    m_translators.TryPop(translator);
     p.set_value(translator);
     queue.Push(p.get_future());
   }
+  m_translators.clear();
 
   base::thread_pool::computational::ThreadPool pool(queue.Size() / 2 + 1);
   CHECK_GREATER_OR_EQUAL(queue.Size(), 1, ());
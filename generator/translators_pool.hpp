@@ -7,22 +7,39 @@
 #include "base/thread_pool_computational.hpp"
 #include "base/thread_safe_queue.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace generator
 {
+// Every translator is owned by its own worker thread which takes batches of elements from
+// a bounded queue. So the reader fills the queue while the translators work, and waits only
+// when the translators are behind.
 class TranslatorsPool
 {
 public:
   explicit TranslatorsPool(std::shared_ptr<TranslatorInterface> const & original,
                            size_t threadCount);
+  ~TranslatorsPool();
 
   void Emit(std::vector<OsmElement> && elements);
   bool Finish();
 
+  size_t GetQueueSize() const { return m_batches.Size(); }
+  uint64_t GetTranslatedElementsCount() const { return m_translatedElementsCount; }
+
 private:
+  using Batch = std::optional<std::vector<OsmElement>>;
+
+  void StopWorkers();
+
+  std::vector<std::shared_ptr<TranslatorInterface>> m_translators;
+  threads::ThreadSafeQueue<Batch> m_batches;
+  std::atomic<uint64_t> m_translatedElementsCount{0};
+  bool m_stopped = false;
   base::thread_pool::computational::ThreadPool m_threadPool;
-  threads::ThreadSafeQueue<std::shared_ptr<TranslatorInterface>> m_translators;
 };
 }  // namespace generator
@@ -6,6 +6,9 @@
 #include "base/macros.hpp"
 #include "base/math.hpp"
 
+#include <algorithm>
+#include <limits>
+
 template <typename Point>
 void FloatingPointsTest()
 {
@@ -74,3 +77,28 @@ UNIT_TEST(ParametrizedSegment2D_ClosestPoint)
     TEST(m2::AlmostEqualULPs(segment.ClosestPointTo(arr[i][0]), arr[i][3]), (i));
   }
 }
+
+UNIT_TEST(ParametrizedSegment2D_SquaredDistanceToSegments)
+{
+  using P = m2::PointD;
+
+  P const points[] = {P(0, 0), P(10, 0), P(10, 10), P(10, 10), P(0, 10)};
+  P const queries[] = {P(5, 5), P(-1, -1), P(12, 5), P(5, 11), P(10, 10), P(20, 20), P(-3, 10)};
+
+  for (auto const & q : queries)
+  {
+    double expected = std::numeric_limits<double>::max();
+    for (size_t i = 1; i < ARRAY_SIZE(points); ++i)
+    {
+      m2::ParametrizedSegment<P> const segment(points[i - 1], points[i]);
+      expected = std::min(expected, segment.SquaredDistanceToPoint(q));
+    }
+
+    TEST(base::AlmostEqualAbs(m2::SquaredDistanceToSegments(points, ARRAY_SIZE(points), q),
+                              expected, 1e-9),
+         (q));
+  }
+
+  TEST_EQUAL(m2::SquaredDistanceToSegments(points, 1 /* count */, P(0, 0)),
+             std::numeric_limits<double>::max(), ());
+}
@@ -1,10 +1,14 @@
 #include "testing/testing.hpp"
 
+#include "geometry/geometry_tests/large_polygon.hpp"
 #include "geometry/geometry_tests/test_regions.hpp"
 #include "geometry/region2d/binary_operators.hpp"
 
+#include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/timer.hpp"
 
+#include <cmath>
 #include <vector>
 
 namespace region2d_binary_op_test
@@ -169,6 +173,92 @@ UNIT_TEST(RegionArea_2Directions)
   TEST_EQUAL(r.CalculateArea(), 0, ());
 }
 
+R MakeRectRegion(m2::RectI const & rect)
+{
+  P const arr[] = {P(rect.minX(), rect.minY()), P(rect.minX(), rect.maxY()),
+                   P(rect.maxX(), rect.maxY()), P(rect.maxX(), rect.minY())};
+  return R(arr, arr + ARRAY_SIZE(arr));
+}
+
+UNIT_TEST(RegionIntersectWithRect_Smoke)
+{
+  // U-shaped region, the rect cuts both prongs.
+  P const arr[] = {P(0, 0), P(0, 10), P(2, 10), P(2, 2), P(8, 2), P(8, 10), P(10, 10), P(10, 0)};
+  R const r(arr, arr + ARRAY_SIZE(arr));
+
+  m2::RectI const rect(-5, 5, 15, 15);
+  m2::MultiRegionI res;
+  m2::IntersectRegionWithRect(r, rect, res);
+  TEST_EQUAL(res.size(), 2, ());
+  TEST_EQUAL(m2::Area(res), 20, ());
+
+  res.clear();
+  m2::IntersectRegionWithRect(r, m2::RectI(3, 3, 7, 7), res);
+  TEST(res.empty(), ());
+
+  m2::IntersectRegionWithRect(r, m2::RectI(-1, -1, 11, 11), res);
+  TEST_EQUAL(res.size(), 1, ());
+  TEST_EQUAL(m2::Area(res), r.CalculateArea(), ());
+}
+
+UNIT_TEST(RegionIntersectWithRect_LargePolygon)
+{
+  vector<P> points;
+  for (auto const & p : LargePolygon::kLargePolygon)
+    points.emplace_back(static_cast<int32_t>(p.x * 1e5), static_cast<int32_t>(p.y * 1e5));
+  R const r(points.begin(), points.end());
+  auto const & bounds = r.GetRect();
+
+  double generalTime = 0.0;
+  double rectTime = 0.0;
+  int32_t const kSteps = 8;
+  int32_t const dx = bounds.SizeX() / kSteps;
+  int32_t const dy = bounds.SizeY() / kSteps;
+  for (int32_t i = 0; i < kSteps; ++i)
+  {
+    for (int32_t j = 0; j < kSteps; ++j)
+    {
+      m2::RectI const rect(bounds.minX() + i * dx, bounds.minY() + j * dy,
+                           bounds.minX() + (i + 1) * dx, bounds.minY() + (j + 1) * dy);
+
+      base::Timer timer;
+      m2::MultiRegionI expected;
+      m2::IntersectRegions(MakeRectRegion(rect), r, expected);
+      generalTime += timer.ElapsedSeconds();
+
+      timer.Reset();
+      m2::MultiRegionI res;
+      m2::IntersectRegionWithRect(r, rect, res);
+      rectTime += timer.ElapsedSeconds();
+
+      TEST_EQUAL(res.size(), expected.size(), (rect));
+      // Intersection points are rounded to the grid in different ways.
+      auto const area = static_cast<double>(m2::Area(res));
+      auto const expectedArea = static_cast<double>(m2::Area(expected));
+      TEST_LESS_OR_EQUAL(fabs(area - expectedArea), 1e-6 * rect.SizeX() * rect.SizeY(), (rect));
+    }
+  }
+  LOG(LINFO, ("IntersectRegions:", generalTime, "seconds, IntersectRegionWithRect:", rectTime,
+              "seconds"));
+}
+
+UNIT_TEST(AddRegions_Smoke)
+{
+  vector<R> rgns;
+  for (int32_t i = 0; i < 10; ++i)
+    rgns.push_back(MakeRectRegion(m2::RectI(i, 0, i + 2, 2)));
+
+  m2::MultiRegionI expected;
+  for (auto const & r : rgns)
+    m2::AddRegion(r, expected);
+
+  m2::MultiRegionI res;
+  m2::AddRegions(rgns, res);
+  TEST_EQUAL(res.size(), 1, ());
+  TEST_EQUAL(m2::Area(res), m2::Area(expected), ());
+  TEST_EQUAL(m2::Area(res), 22, ());
+}
+
 /*
 UNIT_TEST(RegionDifference_Data1)
 {
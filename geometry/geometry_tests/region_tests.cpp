@@ -1,11 +1,16 @@
 #include "testing/testing.hpp"
 
+#include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/timer.hpp"
 
 #include "geometry/convex_hull.hpp"
+#include "geometry/geometry_tests/large_polygon.hpp"
+#include "geometry/parametrized_segment.hpp"
 #include "geometry/point2d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -363,4 +368,62 @@ UNIT_TEST(Region_GetRandomPoint)
     testConvexRegion(region);
   }
 }
+
+UNIT_TEST(Region_ContainsBatch)
+{
+  m2::RegionD const region(begin(LargePolygon::kLargePolygon), end(LargePolygon::kLargePolygon));
+  auto const & rect = region.GetRect();
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> xs(rect.minX() - 0.1, rect.maxX() + 0.1);
+  uniform_real_distribution<double> ys(rect.minY() - 0.1, rect.maxY() + 0.1);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < 10000; ++i)
+    points.emplace_back(xs(rng), ys(rng));
+  // Vertices and middles of edges are at the border.
+  auto const & data = region.Data();
+  for (size_t i = 0; i + 1 < data.size(); i += 50)
+  {
+    points.push_back(data[i]);
+    points.push_back((data[i] + data[i + 1]) / 2);
+  }
+
+  base::Timer timer;
+  vector<bool> expected;
+  for (auto const & pt : points)
+    expected.push_back(region.Contains(pt));
+  LOG(LINFO, ("Contains of", points.size(), "points:", timer.ElapsedSeconds(), "seconds"));
+
+  timer.Reset();
+  vector<bool> result;
+  region.Contains(points, result);
+  LOG(LINFO, ("Batch Contains of", points.size(), "points:", timer.ElapsedSeconds(), "seconds"));
+
+  TEST_EQUAL(result, expected, ());
+  TEST(find(result.begin(), result.end(), true) != result.end(), ());
+  TEST(find(result.begin(), result.end(), false) != result.end(), ());
+}
+
+UNIT_TEST(Region_AtBorderLargePolygon)
+{
+  m2::RegionD const region(begin(LargePolygon::kLargePolygon), end(LargePolygon::kLargePolygon));
+  auto const & data = region.Data();
+  double const delta = 1e-3;
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> shift(-2 * delta, 2 * delta);
+  for (size_t i = 0; i < data.size(); i += 10)
+  {
+    m2::PointD const pt(data[i].x + shift(rng), data[i].y + shift(rng));
+
+    bool expected = false;
+    for (size_t j = 0; j < data.size(); ++j)
+    {
+      m2::ParametrizedSegment<m2::PointD> const segment(data[j == 0 ? data.size() - 1 : j - 1],
+                                                        data[j]);
+      expected = expected || segment.SquaredDistanceToPoint(pt) < delta * delta;
+    }
+    TEST_EQUAL(region.AtBorder(pt, delta), expected, (pt));
+  }
+}
 } // namespace region_tests
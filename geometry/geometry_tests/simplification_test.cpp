@@ -8,6 +8,7 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 
 #include <cstdint>
 #include <limits>
@@ -79,6 +80,12 @@ void SimplifyNearOptimal20(m2::PointD const * f, m2::PointD const * l, double e,
   SimplifyNearOptimal(20, f, l, e, distFn, out);
 }
 
+void SimplifyVisvalingamFn(m2::PointD const * f, m2::PointD const * l, double e, DistanceFn,
+                           PointOutput out)
+{
+  SimplifyVisvalingam(f, l, e, out);
+}
+
 void CheckDPStrict(P const * arr, size_t n, double eps, size_t expectedCount)
 {
   vector<P> vec;
@@ -142,4 +149,53 @@ UNIT_TEST(Simpfication_DP_DegenerateTrg)
               P(100.1, 450), P(100, 500),   P(0, 600)};
   CheckDPStrict(arr2, ARRAY_SIZE(arr2), 1.0, 4);
 }
+
+UNIT_TEST(Simplification_Visvalingam_Smoke) { TestSimplificationSmoke(&SimplifyVisvalingamFn); }
+
+UNIT_TEST(Simplification_Visvalingam_Line) { TestSimplificationOfLine(&SimplifyVisvalingamFn); }
+
+UNIT_TEST(Simplification_Visvalingam_Polyline)
+{
+  TestSimplificationOfPoly(LargePolylineTestData::m_Data, LargePolylineTestData::m_Size,
+                           &SimplifyVisvalingamFn);
+}
+
+UNIT_TEST(Simplification_Visvalingam_Collinear)
+{
+  P const arr[] = {P(0, 0), P(1, 0), P(2, 0), P(3, 1), P(4, 2), P(5, 2)};
+  vector<P> result;
+  SimplifyVisvalingam(arr, arr + ARRAY_SIZE(arr), 0.1, base::MakeBackInsertFunctor(result));
+  TEST_EQUAL(result, vector<P>({P(0, 0), P(2, 0), P(4, 2), P(5, 2)}), ());
+}
+
+UNIT_TEST(Simplification_DPForEachEpsilon)
+{
+  auto const * points = LargePolylineTestData::m_Data;
+  auto const count = LargePolylineTestData::m_Size;
+  vector<double> const epsilons = {1e-2, 1e-8, 1e-6, 1e-4, 1e-3};
+
+  base::Timer timer;
+  vector<vector<P>> expected(epsilons.size());
+  for (size_t i = 0; i < epsilons.size(); ++i)
+  {
+    SimplifyDP(points, points + count, epsilons[i], DistanceFn(),
+               base::MakeBackInsertFunctor(expected[i]));
+  }
+  LOG(LINFO, ("SimplifyDP for", epsilons.size(), "epsilons:", timer.ElapsedSeconds(), "seconds"));
+
+  timer.Reset();
+  vector<vector<P>> results(epsilons.size());
+  vector<PointOutput> outs;
+  for (auto & result : results)
+    outs.push_back(base::MakeBackInsertFunctor(result));
+  SimplifyDPForEachEpsilon(points, points + count, epsilons, DistanceFn(), outs);
+  LOG(LINFO, ("SimplifyDPForEachEpsilon:", timer.ElapsedSeconds(), "seconds"));
+
+  for (size_t i = 0; i < epsilons.size(); ++i)
+  {
+    TEST_EQUAL(results[i], expected[i], (epsilons[i]));
+    TEST_GREATER(results[i].size(), 1, ());
+  }
+  TEST_LESS(results[0].size(), results[3].size(), ());
+}
 }  // namespace simplification_test
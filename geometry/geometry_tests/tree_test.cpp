@@ -2,7 +2,13 @@
 
 #include "geometry/tree4d.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
 #include <functional>
+#include <random>
+#include <vector>
 
 namespace tree_test
 {
@@ -184,4 +190,70 @@ UNIT_TEST(Tree4D_ReplaceEqual)
   i = find(test.begin(), test.end(), T(1, 1, 2, 2, 2));
   TEST_EQUAL(R(*i), R(0, 0, 3, 3), ());
 }
+UNIT_TEST(Tree4D_RandomRects)
+{
+  // Compares queries with a linear scan while rects are added and erased. Timings of the tree
+  // operations are logged for the comparison of implementations.
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(0.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.0, 10.0);
+  auto const makeRect = [&]() {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    return R(x, y, x + size(rng), y + size(rng));
+  };
+
+  size_t const kCount = 20000;
+  Tree theTree;
+  vector<R> rects;
+  base::Timer timer;
+  for (size_t i = 0; i < kCount; ++i)
+  {
+    rects.push_back(makeRect());
+    theTree.Add(rects.back());
+  }
+  LOG(LINFO, ("Adding of", kCount, "rects:", timer.ElapsedSeconds(), "seconds"));
+
+  timer.Reset();
+  for (size_t i = 0; i < kCount / 2; ++i)
+    theTree.Erase(rects[i]);
+  rects.erase(rects.begin(), rects.begin() + kCount / 2);
+  LOG(LINFO, ("Erasing of", kCount / 2, "rects:", timer.ElapsedSeconds(), "seconds"));
+  TEST_EQUAL(theTree.GetSize(), rects.size(), ());
+
+  vector<R> queries;
+  for (size_t i = 0; i < 1000; ++i)
+    queries.push_back(m2::Inflate(makeRect(), 20.0, 20.0));
+
+  vector<vector<R>> found(queries.size());
+  timer.Reset();
+  for (size_t i = 0; i < queries.size(); ++i)
+    theTree.ForEachInRect(queries[i], base::MakeBackInsertFunctor(found[i]));
+  LOG(LINFO, ("Queries of", queries.size(), "rects:", timer.ElapsedSeconds(), "seconds"));
+
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    vector<R> expected;
+    for (auto const & r : rects)
+    {
+      if (r.minX() < queries[i].maxX() && queries[i].minX() < r.maxX() &&
+          r.minY() < queries[i].maxY() && queries[i].minY() < r.maxY())
+      {
+        expected.push_back(r);
+      }
+    }
+
+    auto const less = [](R const & lhs, R const & rhs) {
+      return std::make_pair(lhs.LeftBottom(), lhs.RightTop()) <
+             std::make_pair(rhs.LeftBottom(), rhs.RightTop());
+    };
+    sort(expected.begin(), expected.end(), less);
+    sort(found[i].begin(), found[i].end(), less);
+    TEST_EQUAL(found[i], expected, ());
+  }
+
+  vector<R> all;
+  theTree.ForEach(base::MakeBackInsertFunctor(all));
+  TEST_EQUAL(all, rects, ());
+}
 }  // namespace tree_test
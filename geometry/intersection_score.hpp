@@ -6,6 +6,7 @@
 #include "base/exception.hpp"
 #include "base/math.hpp"
 
+#include <utility>
 #include <vector>
 
 #include "std/boost_geometry.hpp"
@@ -137,13 +138,17 @@ impl::MultiPolygon TrianglesToPolygon(Container const & points)
   if (polygons.empty())
     return {};
 
-  auto & result = polygons[0];
-  for (size_t i = 1; i < polygons.size(); ++i)
+  // Triangles are united pairwise, so each union is of the parts of similar size and the
+  // total work is much less than when triangles are added to the result one by one.
+  for (size_t step = 1; step < polygons.size(); step *= 2)
   {
-    impl::MultiPolygon u;
-    boost::geometry::union_(result, polygons[i], u);
-    u.swap(result);
+    for (size_t i = 0; i + step < polygons.size(); i += 2 * step)
+    {
+      impl::MultiPolygon u;
+      boost::geometry::union_(polygons[i], polygons[i + step], u);
+      u.swap(polygons[i]);
+    }
   }
-  return result;
+  return std::move(polygons[0]);
 }
 }  // namespace geometry
@@ -5,6 +5,7 @@
 #include "base/math.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <limits>
 
 namespace m2
@@ -78,6 +79,38 @@ private:
   double m_length;
 };
 
+/// Returns the squared distance from |p| to the closest of the segments
+/// [points[i - 1], points[i]] for i in [1, count), or the max double value when there are no
+/// segments. Unlike ParametrizedSegment it doesn't take a square root for a segment and has no
+/// branches, so the loop over the segments is vectorized by the compiler.
+template <typename Point>
+double SquaredDistanceToSegments(Point const * points, size_t count, m2::PointD const & p)
+{
+  double result = std::numeric_limits<double>::max();
+  for (size_t i = 1; i < count; ++i)
+  {
+    double const ax = points[i - 1].x;
+    double const ay = points[i - 1].y;
+    double const dx = static_cast<double>(points[i].x) - ax;
+    double const dy = static_cast<double>(points[i].y) - ay;
+    double const px = p.x - ax;
+    double const py = p.y - ay;
+
+    // |t| is the projection of |p| to the segment multiplied by the segment length.
+    double const t = dx * px + dy * py;
+    double const squaredLength = dx * dx + dy * dy;
+    double const toP0 = px * px + py * py;
+    double const toP1 = base::Pow2(px - dx) + base::Pow2(py - dy);
+    double const cross = px * dy - py * dx;
+    // The perpendicular is used only when t is in (0, squaredLength), so the length isn't zero.
+    double const toLine = cross * cross / (squaredLength > 0 ? squaredLength : 1.0);
+
+    double const d = t <= 0 ? toP0 : (t >= squaredLength ? toP1 : toLine);
+    result = d < result ? d : result;
+  }
+  return result;
+}
+
 // This functor is here only for backward compatibility. It is not obvious
 // when looking at a call site whether x should be the first or the last parameter to the fuction.
 // For readability, consider creating a parametrized segment and using its methods instead
@@ -8,6 +8,7 @@
 #include "base/math.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <random>
 #include <type_traits>
 #include <utility>
@@ -253,6 +254,103 @@ public:
 
   bool Contains(Point const & pt) const { return Contains(pt, typename Traits::EqualType()); }
 
+  /// Batch version of Contains: |result[i]| is the same as Contains(pts[i], equalF). The points
+  /// are sorted by y, so an edge is checked only against the points between its ends by y
+  /// instead of all the points. The loops over these points have no branches and are
+  /// vectorized by the compiler.
+  template <typename EqualFn>
+  void Contains(std::vector<Point> const & pts, std::vector<bool> & result, EqualFn equalF) const
+  {
+    using BigCoord = typename Traits::BigType;
+
+    result.assign(pts.size(), false);
+
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < pts.size(); ++i)
+    {
+      if (m_rect.IsPointInside(pts[i]))
+        indexes.push_back(i);
+    }
+
+    size_t const count = indexes.size();
+    if (count == 0)
+      return;
+
+    std::sort(indexes.begin(), indexes.end(),
+              [&pts](size_t lhs, size_t rhs) { return pts[lhs].y < pts[rhs].y; });
+
+    std::vector<Point> sorted(count);
+    std::vector<BigCoord> xs(count);
+    std::vector<BigCoord> ys(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+      sorted[k] = pts[indexes[k]];
+      xs[k] = sorted[k].x;
+      ys[k] = sorted[k].y;
+    }
+
+    std::vector<uint32_t> rCross(count, 0);
+    std::vector<uint32_t> lCross(count, 0);
+    std::vector<uint8_t> atVertex(count, 0);
+
+    // Checks if |k|-th point has the same y as |p| up to |equalF| precision.
+    auto const equalY = [&](size_t k, Point const & p) {
+      return equalF.EqualPoints(Point(sorted[k].x, p.y), sorted[k]);
+    };
+
+    Point prev = m_points.back();
+    for (Point const & curr : m_points)
+    {
+      Point const & low = prev.y < curr.y ? prev : curr;
+      Point const & high = prev.y < curr.y ? curr : prev;
+
+      // Other points don't cross the edge and aren't equal to its ends.
+      size_t begin = std::lower_bound(ys.begin(), ys.end(), BigCoord(low.y)) - ys.begin();
+      while (begin > 0 && equalY(begin - 1, low))
+        --begin;
+      size_t end = std::upper_bound(ys.begin(), ys.end(), BigCoord(high.y)) - ys.begin();
+      while (end < count && equalY(end, high))
+        ++end;
+
+      for (size_t k = begin; k < end; ++k)
+        atVertex[k] |= static_cast<uint8_t>(equalF.EqualPoints(curr, sorted[k]));
+
+      BigCoord const currX = curr.x;
+      BigCoord const currY = curr.y;
+      BigCoord const prevX = prev.x;
+      BigCoord const prevY = prev.y;
+      for (size_t k = begin; k < end; ++k)
+      {
+        BigCoord const cx = currX - xs[k];
+        BigCoord const cy = currY - ys[k];
+        BigCoord const px = prevX - xs[k];
+        BigCoord const py = prevY - ys[k];
+
+        // See Contains(pt, equalF) for the details.
+        bool const rCheck = (cy > 0) != (py > 0);
+        bool const lCheck = (cy < 0) != (py < 0);
+        BigCoord const cp = cx * py - cy * px;
+        bool const isCounted = !equalF.EqualZeroSquarePrecision(cp);
+        bool const prevGreaterCurr = py - cy > 0;
+
+        rCross[k] += static_cast<uint32_t>(rCheck & isCounted & ((cp > 0) == prevGreaterCurr));
+        lCross[k] += static_cast<uint32_t>(lCheck & isCounted & ((cp > 0) != prevGreaterCurr));
+      }
+
+      prev = curr;
+    }
+
+    // A point is on the edge if left and right crossings are not the same parity and inside if
+    // an odd number of crossings.
+    for (size_t k = 0; k < count; ++k)
+      result[indexes[k]] = atVertex[k] != 0 || ((rCross[k] | lCross[k]) & 1) != 0;
+  }
+
+  void Contains(std::vector<Point> const & pts, std::vector<bool> & result) const
+  {
+    Contains(pts, result, typename Traits::EqualType());
+  }
+
   /// Finds point of intersection with the section.
   bool FindIntersection(Point const & point1, Point const & point2, Point & result) const
   {
@@ -276,27 +374,22 @@ public:
     if (!Inflate(m_rect, rectDelta, rectDelta).IsPointInside(pt))
       return false;
 
-    const double squaredDelta = delta * delta;
-    size_t const numPoints = m_points.size();
-
-    Point prev = m_points[numPoints - 1];
-
-    for (size_t i = 0; i < numPoints; ++i)
+    // Borders often have same points with ways
+    for (Point const & curr : m_points)
     {
-      Point const curr = m_points[i];
-
-      // Borders often have same points with ways
-      if (equalF.EqualPoints(m_points[i], pt))
-        return true;
-
-      ParametrizedSegment<Point> segment(prev, curr);
-      if (segment.SquaredDistanceToPoint(pt) < squaredDelta)
+      if (equalF.EqualPoints(curr, pt))
         return true;
-
-      prev = curr;
     }
 
-    return false;  // Point lies outside the border.
+    double const squaredDelta = delta * delta;
+    ParametrizedSegment<Point> const closing(m_points.back(), m_points.front());
+    if (closing.SquaredDistanceToPoint(pt) < squaredDelta)
+      return true;
+
+    // The distances to all the segments are computed without early exit as the loop is
+    // vectorized.
+    return SquaredDistanceToSegments(m_points.data(), m_points.size(), m2::PointD(pt)) <
+           squaredDelta;
   }
 
   bool AtBorder(Point const & pt, double const delta) const
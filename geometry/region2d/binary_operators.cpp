@@ -1,8 +1,59 @@
 #include "geometry/region2d/binary_operators.hpp"
 #include "geometry/region2d/boost_concept.hpp"
 
+#include <cmath>
+
 namespace m2
 {
+namespace
+{
+// Sutherland-Hodgman clipping of the polygon |src| by the half-plane |isInside|. The points of
+// intersection of the edges with the half-plane border are computed by |intersect|.
+template <typename IsInside, typename Intersect>
+void ClipByHalfPlane(std::vector<PointI> const & src, IsInside && isInside, Intersect && intersect,
+                     std::vector<PointI> & dst)
+{
+  dst.clear();
+  if (src.empty())
+    return;
+
+  auto const add = [&dst](PointI const & p) {
+    if (dst.empty() || dst.back() != p)
+      dst.push_back(p);
+  };
+
+  PointI prev = src.back();
+  bool prevInside = isInside(prev);
+  for (auto const & curr : src)
+  {
+    bool const currInside = isInside(curr);
+    if (currInside != prevInside)
+      add(intersect(prev, curr));
+    if (currInside)
+      add(curr);
+
+    prev = curr;
+    prevInside = currInside;
+  }
+}
+
+// The intersection is rounded to the grid. It depends on the edge only, so the neighbour rects
+// have the same points on the common side.
+PointI IntersectWithVertical(PointI const & p1, PointI const & p2, int32_t x)
+{
+  double const y = p1.y + (static_cast<double>(x) - p1.x) *
+                             (static_cast<double>(p2.y) - p1.y) / (static_cast<double>(p2.x) - p1.x);
+  return PointI(x, static_cast<int32_t>(std::lround(y)));
+}
+
+PointI IntersectWithHorizontal(PointI const & p1, PointI const & p2, int32_t y)
+{
+  double const x = p1.x + (static_cast<double>(y) - p1.y) *
+                             (static_cast<double>(p2.x) - p1.x) / (static_cast<double>(p2.y) - p1.y);
+  return PointI(static_cast<int32_t>(std::lround(x)), y);
+}
+}  // namespace
+
 void SpliceRegions(std::vector<RegionI> & src, std::vector<RegionI> & res)
 {
   for (size_t i = 0; i < src.size(); ++i)
@@ -36,12 +87,52 @@ void DiffRegions(RegionI const & r1, RegionI const & r2, MultiRegionI & res)
   SpliceRegions(local, res);
 }
 
+void IntersectRegionWithRect(RegionI const & r, RectI const & rect, MultiRegionI & res)
+{
+  std::vector<PointI> clipped(r.Data().begin(), r.Data().end());
+  std::vector<PointI> buffer;
+  buffer.reserve(clipped.size());
+
+  ClipByHalfPlane(clipped, [&](PointI const & p) { return p.x >= rect.minX(); },
+                  [&](PointI const & p1, PointI const & p2) {
+                    return IntersectWithVertical(p1, p2, rect.minX());
+                  }, buffer);
+  ClipByHalfPlane(buffer, [&](PointI const & p) { return p.x <= rect.maxX(); },
+                  [&](PointI const & p1, PointI const & p2) {
+                    return IntersectWithVertical(p1, p2, rect.maxX());
+                  }, clipped);
+  ClipByHalfPlane(clipped, [&](PointI const & p) { return p.y >= rect.minY(); },
+                  [&](PointI const & p1, PointI const & p2) {
+                    return IntersectWithHorizontal(p1, p2, rect.minY());
+                  }, buffer);
+  ClipByHalfPlane(buffer, [&](PointI const & p) { return p.y <= rect.maxY(); },
+                  [&](PointI const & p1, PointI const & p2) {
+                    return IntersectWithHorizontal(p1, p2, rect.maxY());
+                  }, clipped);
+
+  if (clipped.size() < 3)
+    return;
+
+  // Clipping leaves zero-width bridges along the rect sides between the parts of the result.
+  // They are removed by the boolean operation which is cheap now as all the points are in |rect|.
+  PointI const corners[] = {PointI(rect.minX(), rect.minY()), PointI(rect.minX(), rect.maxY()),
+                            PointI(rect.maxX(), rect.maxY()), PointI(rect.maxX(), rect.minY())};
+  RegionI const rectRegion(std::begin(corners), std::end(corners));
+  IntersectRegions(rectRegion, RegionI(clipped.begin(), clipped.end()), res);
+}
+
 void AddRegion(RegionI const & r, MultiRegionI & res)
 {
   using namespace boost::polygon::operators;
   res += r;
 }
 
+void AddRegions(MultiRegionI const & rgns, MultiRegionI & res)
+{
+  using namespace boost::polygon::operators;
+  res += rgns;
+}
+
 uint64_t Area(MultiRegionI const & rgn)
 {
   uint64_t area = 0;
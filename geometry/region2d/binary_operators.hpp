@@ -1,5 +1,6 @@
 #pragma once
 
+#include "geometry/rect2d.hpp"
 #include "geometry/region2d.hpp"
 
 #include <vector>
@@ -12,12 +13,18 @@ using MultiRegionI = std::vector<RegionI>;
 /// @{
 void IntersectRegions(RegionI const & r1, RegionI const & r2, MultiRegionI & res);
 void DiffRegions(RegionI const & r1, RegionI const & r2, MultiRegionI & res);
+
+/// Same as IntersectRegions with the region of \a rect, but the edges of \a r are clipped by
+/// \a rect before the boolean operation, so it's much faster for big regions and small rects.
+void IntersectRegionWithRect(RegionI const & r, RectI const & rect, MultiRegionI & res);
 /// @}
 
 MultiRegionI IntersectRegions(RegionI const & r1, MultiRegionI const & r2);
 
 /// Union \a r with \a res and save to \a res.
 void AddRegion(RegionI const & r, MultiRegionI & res);
+/// Union all \a rgns with \a res by one operation and save to \a res.
+void AddRegions(MultiRegionI const & rgns, MultiRegionI & res);
 
 uint64_t Area(MultiRegionI const & rgn);
 }  // namespace m2
@@ -1,10 +1,18 @@
 #pragma once
 
 #include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <queue>
+#include <utility>
 #include <vector>
 
 // Polyline simplification algorithms.
@@ -31,21 +39,51 @@ std::pair<double, Iter> MaxDistance(Iter first, Iter last, DistanceFn & distFn)
   return res;
 }
 
-// Actual SimplifyDP implementation.
+// The segment is the same for all the points, so it's parametrized once instead of for
+// each point.
+template <typename Iter>
+std::pair<double, Iter> MaxDistance(Iter first, Iter last, m2::SquaredDistanceFromSegmentToPoint &)
+{
+  std::pair<double, Iter> res(0.0, last);
+
+  m2::ParametrizedSegment<m2::PointD> const segment((m2::PointD(*first)), m2::PointD(*last));
+  for (Iter i = first + 1; i != last; ++i)
+  {
+    double const d = segment.SquaredDistanceToPoint(m2::PointD(*i));
+    if (res.first < d)
+    {
+      res.first = d;
+      res.second = i;
+    }
+  }
+
+  return res;
+}
+
+// Actual SimplifyDP implementation. Ranges are processed with an explicit stack in the same
+// order as by recursion, so long lines don't overflow the call stack.
 template <typename DistanceFn, typename Iter, typename Out>
 void SimplifyDP(Iter first, Iter last, double epsilon, DistanceFn & distFn, Out & out)
 {
-  if (first != last)
+  std::vector<std::pair<Iter, Iter>> ranges;
+  ranges.emplace_back(first, last);
+  while (!ranges.empty())
   {
-    auto const maxDist = MaxDistance(first, last, distFn);
-    if (maxDist.first >= epsilon)
+    auto const [f, l] = ranges.back();
+    ranges.pop_back();
+
+    if (f != l)
     {
-      simpl::SimplifyDP(first, maxDist.second, epsilon, distFn, out);
-      simpl::SimplifyDP(maxDist.second, last, epsilon, distFn, out);
-      return;
+      auto const maxDist = MaxDistance(f, l, distFn);
+      if (maxDist.first >= epsilon)
+      {
+        ranges.emplace_back(maxDist.second, l);
+        ranges.emplace_back(f, maxDist.second);
+        continue;
+      }
     }
+    out(*l);
   }
-  out(*last);
 }
 //@}
 
@@ -73,6 +111,130 @@ void SimplifyDP(Iter beg, Iter end, double epsilon, DistanceFn distFn, Out out)
   }
 }
 
+// Douglas-Peucker simplification of STL-like range [beg, end) of at least two points for all
+// |epsilons| in one pass. The result for |epsilons[i]| is the same as the result of SimplifyDP with this epsilon and
+// is passed to |outs[i]|. The split points don't depend on epsilon, so the line is split once
+// for the smallest epsilon and a point is passed for the epsilons which are not greater than
+// the distances of all the splits on the way to the point.
+template <typename DistanceFn, typename Iter, typename Out>
+void SimplifyDPForEachEpsilon(Iter beg, Iter end, std::vector<double> const & epsilons,
+                              DistanceFn distFn, std::vector<Out> & outs)
+{
+  CHECK_EQUAL(epsilons.size(), outs.size(), ());
+  if (beg == end || epsilons.empty())
+    return;
+
+  double const minEpsilon = *std::min_element(epsilons.begin(), epsilons.end());
+  size_t const n = static_cast<size_t>(end - beg);
+
+  // The max epsilon for which a point is passed to the output.
+  std::vector<double> maxEpsilons(n, -1.0);
+  maxEpsilons.front() = maxEpsilons.back() = std::numeric_limits<double>::max();
+
+  struct Range
+  {
+    Iter m_first;
+    Iter m_last;
+    double m_maxEpsilon;
+  };
+  std::vector<Range> ranges;
+  ranges.push_back({beg, end - 1, std::numeric_limits<double>::max()});
+  while (!ranges.empty())
+  {
+    Range const range = ranges.back();
+    ranges.pop_back();
+
+    if (range.m_first == range.m_last)
+      continue;
+
+    auto const maxDist = simpl::MaxDistance(range.m_first, range.m_last, distFn);
+    if (maxDist.first < minEpsilon || maxDist.second == range.m_last)
+      continue;
+
+    double const maxEpsilon = std::min(range.m_maxEpsilon, maxDist.first);
+    maxEpsilons[maxDist.second - beg] = maxEpsilon;
+    ranges.push_back({range.m_first, maxDist.second, maxEpsilon});
+    ranges.push_back({maxDist.second, range.m_last, maxEpsilon});
+  }
+
+  for (size_t i = 0; i < epsilons.size(); ++i)
+  {
+    for (size_t j = 0; j < n; ++j)
+    {
+      if (maxEpsilons[j] >= epsilons[i])
+        outs[i](*(beg + j));
+    }
+  }
+}
+
+// Visvalingam-Whyatt simplification of STL-like range [beg, end). Iteratively removes the point
+// which makes the triangle of the smallest area with its neighbours while the area is less than
+// |areaEpsilon|. The first and the last points are kept. O(n log n) with a heap of the areas.
+template <typename Iter, typename Out>
+void SimplifyVisvalingam(Iter beg, Iter end, double areaEpsilon, Out out)
+{
+  size_t const n = static_cast<size_t>(end - beg);
+  if (n <= 2)
+  {
+    for (Iter it = beg; it != end; ++it)
+      out(*it);
+    return;
+  }
+
+  // Neighbours of the points which are not removed yet.
+  std::vector<size_t> prev(n);
+  std::vector<size_t> next(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    prev[i] = i - 1;
+    next[i] = i + 1;
+  }
+
+  auto const getArea = [&](size_t i) {
+    m2::PointD const p(*(beg + i));
+    return std::fabs(m2::CrossProduct(m2::PointD(*(beg + prev[i])) - p,
+                                      m2::PointD(*(beg + next[i])) - p)) / 2.0;
+  };
+
+  // A point is removed with the area which is not less than the areas of the removed points, so
+  // the result doesn't depend on the order of removal of points with small areas.
+  std::vector<double> areas(n, std::numeric_limits<double>::max());
+  using AreaAndIndex = std::pair<double, size_t>;
+  std::priority_queue<AreaAndIndex, std::vector<AreaAndIndex>, std::greater<AreaAndIndex>> heap;
+  for (size_t i = 1; i + 1 < n; ++i)
+  {
+    areas[i] = getArea(i);
+    heap.emplace(areas[i], i);
+  }
+
+  std::vector<bool> removed(n, false);
+  while (!heap.empty())
+  {
+    auto const [area, i] = heap.top();
+    heap.pop();
+
+    // Skips the areas of the removed points and the old areas of the points with new neighbours.
+    if (removed[i] || area != areas[i])
+      continue;
+    if (area >= areaEpsilon)
+      break;
+
+    removed[i] = true;
+    next[prev[i]] = next[i];
+    prev[next[i]] = prev[i];
+    for (size_t const j : {prev[i], next[i]})
+    {
+      if (j == 0 || j + 1 == n)
+        continue;
+      areas[j] = std::max(area, getArea(j));
+      heap.emplace(areas[j], j);
+    }
+  }
+
+  for (size_t i = 0; i < n; i = next[i])
+    out(*(beg + i));
+}
+
 // Dynamic programming near-optimal simplification.
 // Uses O(n) additional memory.
 // Worst case O(n^3) performance, average O(n*k^2), where k is maxFalseLookAhead - parameter,
@@ -3,127 +3,201 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "3party/kdtree++/kdtree.hpp"
-
 namespace m4
 {
+namespace impl
+{
+template <typename T>
+std::string DebugPrintValue(T const & t)
+{
+  return DebugPrint(t);
+}
+}  // namespace impl
+
 template <typename T>
 struct TraitsDef
 {
   m2::RectD const LimitRect(T const & t) const { return t.GetLimitRect(); }
 };
 
+/// \brief Set of objects with rects which supports queries of the objects intersecting a rect.
+/// Objects are kept in packed R-trees: the rects of a tree and the rects of its nodes are flat
+/// arrays sorted with the Sort-Tile-Recursive algorithm, so a query reads the memory
+/// sequentially. A tree is bulk-loaded and isn't changed then, new objects come to a small
+/// buffer which is scanned linearly. The full buffer is merged with the trees of the same or
+/// a smaller size (the logarithmic method), so an object takes part in O(log n) bulk-loads.
+/// Erased objects are marked and skipped until there are more of them than of the alive ones.
+/// \note ForEach iterates the objects in the order of adding.
 template <typename T, typename Traits = TraitsDef<T>>
 class Tree
 {
-  class Value
+  struct Box
   {
-  public:
-    using value_type = double;
-
-    template <typename U>
-    Value(U && u, m2::RectD const & r) : m_val(std::forward<U>(u))
+    Box() = default;
+    explicit Box(m2::RectD const & r)
+      : m_minX(r.minX()), m_minY(r.minY()), m_maxX(r.maxX()), m_maxY(r.maxY())
     {
-      SetRect(r);
     }
 
-    bool IsIntersect(m2::RectD const & r) const
+    // Rects which touch each other don't intersect.
+    bool IsIntersect(Box const & b) const
     {
-      return !((m_pts[2] <= r.minX()) || (m_pts[0] >= r.maxX()) || (m_pts[3] <= r.minY()) ||
-               (m_pts[1] >= r.maxY()));
+      return !(m_maxX <= b.m_minX || m_minX >= b.m_maxX || m_maxY <= b.m_minY ||
+               m_minY >= b.m_maxY);
     }
 
-    bool operator==(Value const & r) const { return (m_val == r.m_val); }
-
-    std::string DebugPrint() const
+    bool IsBoxInside(Box const & b) const
     {
-      std::ostringstream out;
-
-      out << DebugPrint(m_val) << ", (" << m_pts[0] << ", " << m_pts[1] << ", " << m_pts[2] << ", "
-          << m_pts[3] << ")";
-
-      return out.str();
+      return m_minX <= b.m_minX && m_minY <= b.m_minY && b.m_maxX <= m_maxX &&
+             b.m_maxY <= m_maxY;
     }
 
-    double operator[](size_t i) const { return m_pts[i]; }
-
-    m2::RectD GetRect() const { return m2::RectD(m_pts[0], m_pts[1], m_pts[2], m_pts[3]); }
-
-    T m_val;
-    double m_pts[4];
+    bool operator==(Box const & b) const
+    {
+      return m_minX == b.m_minX && m_minY == b.m_minY && m_maxX == b.m_maxX && m_maxY == b.m_maxY;
+    }
 
-  private:
-    void SetRect(m2::RectD const & r)
+    void Add(Box const & b)
     {
-      m_pts[0] = r.minX();
-      m_pts[1] = r.minY();
-      m_pts[2] = r.maxX();
-      m_pts[3] = r.maxY();
+      m_minX = std::min(m_minX, b.m_minX);
+      m_minY = std::min(m_minY, b.m_minY);
+      m_maxX = std::max(m_maxX, b.m_maxX);
+      m_maxY = std::max(m_maxY, b.m_maxY);
     }
-  };
 
-  KDTree::KDTree<4, Value> m_tree;
+    double GetCenterX() const { return m_minX + (m_maxX - m_minX) / 2; }
+    double GetCenterY() const { return m_minY + (m_maxY - m_minY) / 2; }
+    m2::RectD GetRect() const { return m2::RectD(m_minX, m_minY, m_maxX, m_maxY); }
 
-  // Do-class for rect-iteration in tree.
-  template <typename ToDo>
-  class for_each_helper
+    double m_minX = 0.0;
+    double m_minY = 0.0;
+    double m_maxX = 0.0;
+    double m_maxY = 0.0;
+  };
+
+  // Packed R-tree over the objects with the indexes |m_items|. The node |j| of level 0 covers
+  // the items [j * kNodeSize, (j + 1) * kNodeSize), the node |j| of level |l| covers the nodes
+  // [j * kNodeSize, (j + 1) * kNodeSize) of level |l - 1|. The last level has a single node.
+  class PackedTree
   {
   public:
-    for_each_helper(m2::RectD const & r, ToDo && toDo) : m_rect(r), m_toDo(std::forward<ToDo>(toDo))
-    {
-    }
+    static size_t constexpr kNodeSize = 16;
 
-    bool ScanLeft(size_t plane, Value const & v) const
+    PackedTree(std::vector<uint32_t> && items, std::vector<Box> const & boxes)
+      : m_items(std::move(items))
     {
-      switch (plane & 3)  // % 4
+      SortTileRecursive(boxes);
+
+      m_boxes.reserve(m_items.size());
+      for (auto const item : m_items)
+        m_boxes.push_back(boxes[item]);
+
+      m_levelBegin.push_back(0);
+      size_t count = m_boxes.size();
+      std::vector<Box> const * children = &m_boxes;
+      size_t childrenBegin = 0;
+      do
       {
-      case 2: return m_rect.minX() < v[2];
-      case 3: return m_rect.minY() < v[3];
-      default: return true;
-      }
+        for (size_t i = 0; i < count; i += kNodeSize)
+        {
+          Box box = (*children)[childrenBegin + i];
+          for (size_t j = i + 1; j < std::min(i + kNodeSize, count); ++j)
+            box.Add((*children)[childrenBegin + j]);
+          m_nodes.push_back(box);
+        }
+
+        childrenBegin = m_levelBegin.back();
+        children = &m_nodes;
+        m_levelBegin.push_back(m_nodes.size());
+        count = m_levelBegin.back() - childrenBegin;
+      } while (count > 1);
     }
 
-    bool ScanRight(size_t plane, Value const & v) const
+    size_t GetSize() const { return m_items.size(); }
+    std::vector<uint32_t> const & GetItems() const { return m_items; }
+
+    /// Calls |fn| for the items with boxes which satisfy |pred|. Boxes of the nodes are checked
+    /// with |nodePred| which must be true for a node if it's true for an item of the node.
+    /// Stops and returns true when |fn| returns true.
+    template <typename NodePred, typename Pred, typename Fn>
+    bool ForAny(NodePred && nodePred, Pred && pred, Fn && fn) const
     {
-      switch (plane & 3)  // % 4
+      size_t const levels = m_levelBegin.size() - 1;
+      // Pairs of a level and a node.
+      buffer_vector<std::pair<size_t, size_t>, 64> stack;
+      stack.emplace_back(levels - 1, m_levelBegin[levels - 1]);
+      while (!stack.empty())
       {
-      case 0: return m_rect.maxX() > v[0];
-      case 1: return m_rect.maxY() > v[1];
-      default: return true;
+        auto const [level, node] = stack.back();
+        stack.pop_back();
+        if (!nodePred(m_nodes[node]))
+          continue;
+
+        size_t const first = (node - m_levelBegin[level]) * kNodeSize;
+        if (level == 0)
+        {
+          size_t const last = std::min(first + kNodeSize, m_boxes.size());
+          for (size_t i = first; i < last; ++i)
+          {
+            if (pred(m_boxes[i]) && fn(m_items[i]))
+              return true;
+          }
+          continue;
+        }
+
+        size_t const begin = m_levelBegin[level - 1];
+        size_t const last = std::min(begin + first + kNodeSize, m_levelBegin[level]);
+        for (size_t i = begin + first; i < last; ++i)
+          stack.emplace_back(level - 1, i);
       }
+      return false;
     }
 
-    void operator()(Value const & v) const
-    {
-      if (v.IsIntersect(m_rect))
-        m_toDo(v);
-    }
-
-    bool DoIfIntersects(Value const & v) const
+  private:
+    // Sorts the items by the x of the centers, splits them to vertical slices and sorts each
+    // slice by the y of the centers. So the consecutive items of a node are close to each other.
+    void SortTileRecursive(std::vector<Box> const & boxes)
     {
-      if (v.IsIntersect(m_rect))
-        return m_toDo(v);
-      return false;
+      auto const byX = [&boxes](uint32_t lhs, uint32_t rhs) {
+        return boxes[lhs].GetCenterX() < boxes[rhs].GetCenterX();
+      };
+      auto const byY = [&boxes](uint32_t lhs, uint32_t rhs) {
+        return boxes[lhs].GetCenterY() < boxes[rhs].GetCenterY();
+      };
+
+      size_t const leaves = (m_items.size() + kNodeSize - 1) / kNodeSize;
+      auto const slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+      size_t const sliceSize = slices * kNodeSize;
+
+      std::sort(m_items.begin(), m_items.end(), byX);
+      for (size_t i = 0; i < m_items.size(); i += sliceSize)
+      {
+        auto const end = m_items.begin() + std::min(i + sliceSize, m_items.size());
+        std::sort(m_items.begin() + i, end, byY);
+      }
     }
 
-  private:
-    m2::RectD const & m_rect;
-    ToDo m_toDo;
+    std::vector<uint32_t> m_items;
+    std::vector<Box> m_boxes;
+    std::vector<Box> m_nodes;
+    std::vector<size_t> m_levelBegin;
   };
 
-  template <typename ToDo>
-  for_each_helper<ToDo> GetFunctor(m2::RectD const & rect, ToDo && toDo) const
-  {
-    return for_each_helper<ToDo>(rect, std::forward<ToDo>(toDo));
-  }
+  // Size of the buffer of the objects which are not in the packed trees.
+  static size_t constexpr kBufferSize = 32;
 
 protected:
   Traits m_traits;
@@ -143,7 +217,14 @@ public:
   template <typename U>
   void Add(U && obj, m2::RectD const & rect)
   {
-    m_tree.insert(Value(std::forward<U>(obj), rect));
+    m_values.emplace_back(std::forward<U>(obj));
+    m_boxes.emplace_back(rect);
+    m_isErased.push_back(false);
+    ++m_size;
+
+    m_buffer.push_back(static_cast<uint32_t>(m_values.size() - 1));
+    if (m_buffer.size() >= kBufferSize)
+      FlushBuffer();
   }
 
 private:
@@ -151,24 +232,23 @@ private:
   void ReplaceImpl(T const & obj, m2::RectD const & rect, Compare comp)
   {
     bool skip = false;
-    std::vector<Value const *> isect;
-
-    m_tree.for_each(GetFunctor(rect, [&](Value const & v) {
-      if (skip)
-        return;
+    std::vector<uint32_t> isect;
 
-      switch (comp(obj, v.m_val))
+    ForAnyIndexInRect(Box(rect), [&](uint32_t index) {
+      switch (comp(obj, m_values[index]))
       {
-      case 1: isect.push_back(&v); break;
-      case -1: skip = true; break;
+      case 1: isect.push_back(index); break;
+      case -1: skip = true; return true;
       }
-    }));
+      return false;
+    });
 
     if (skip)
       return;
 
-    for (Value const * v : isect)
-      m_tree.erase(*v);
+    for (auto const index : isect)
+      MarkErased(index);
+    CompactIfNeeded();
 
     Add(obj, rect);
   }
@@ -192,31 +272,44 @@ public:
     });
   }
 
+  /// Erases an object which is equal to |obj| and has the same rect.
   void Erase(T const & obj, m2::RectD const & r)
   {
-    Value val(obj, r);
-    m_tree.erase_exact(val);
-  }
+    Box const box(r);
+    uint32_t found = 0;
+    bool const isFound = ForAnyIndex(
+        [&box](Box const & b) { return b.IsBoxInside(box); },
+        [&box](Box const & b) { return b == box; },
+        [&](uint32_t index) {
+          found = index;
+          return m_values[index] == obj;
+        });
+
+    if (!isFound)
+      return;
 
-  void Erase(T const & obj)
-  {
-    Value val(obj, m_traits.LimitRect(obj));
-    m_tree.erase_exact(val);
+    MarkErased(found);
+    CompactIfNeeded();
   }
 
+  void Erase(T const & obj) { Erase(obj, GetLimitRect(obj)); }
+
   template <typename ToDo>
   void ForEach(ToDo && toDo) const
   {
-    for (Value const & v : m_tree)
-      toDo(v.m_val);
+    for (size_t i = 0; i < m_values.size(); ++i)
+    {
+      if (!m_isErased[i])
+        toDo(m_values[i]);
+    }
   }
 
   template <typename ToDo>
   bool ForAny(ToDo && toDo) const
   {
-    for (Value const & v : m_tree)
+    for (size_t i = 0; i < m_values.size(); ++i)
     {
-      if (toDo(v.m_val))
+      if (!m_isErased[i] && toDo(m_values[i]))
         return true;
     }
 
@@ -226,53 +319,161 @@ public:
   template <typename ToDo>
   void ForEachEx(ToDo && toDo) const
   {
-    for (Value const & v : m_tree)
-      toDo(v.GetRect(), v.m_val);
+    for (size_t i = 0; i < m_values.size(); ++i)
+    {
+      if (!m_isErased[i])
+        toDo(m_boxes[i].GetRect(), m_values[i]);
+    }
   }
 
   template <typename ToDo>
   bool FindNode(ToDo && toDo) const
   {
-    for (Value const & v : m_tree)
-    {
-      if (toDo(v.m_val))
-        return true;
-    }
-
-    return false;
+    return ForAny(std::forward<ToDo>(toDo));
   }
 
   template <typename ToDo>
   bool ForAnyInRect(m2::RectD const & rect, ToDo && toDo) const
   {
-    return m_tree.for_any(GetFunctor(rect, [&toDo](Value const & v) { return toDo(v.m_val); }));
+    return ForAnyIndexInRect(Box(rect),
+                             [&](uint32_t index) { return toDo(m_values[index]); });
   }
 
   template <typename ToDo>
   void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
   {
-    m_tree.for_each(GetFunctor(rect, [&toDo](Value const & v) { toDo(v.m_val); }));
+    ForAnyIndexInRect(Box(rect), [&](uint32_t index) {
+      toDo(m_values[index]);
+      return false;
+    });
   }
 
   template <typename ToDo>
   void ForEachInRectEx(m2::RectD const & rect, ToDo && toDo) const
   {
-    m_tree.for_each(GetFunctor(rect, [&toDo](Value const & v) { toDo(v.GetRect(), v.m_val); }));
+    ForAnyIndexInRect(Box(rect), [&](uint32_t index) {
+      toDo(m_boxes[index].GetRect(), m_values[index]);
+      return false;
+    });
   }
 
-  bool IsEmpty() const { return m_tree.empty(); }
+  bool IsEmpty() const { return m_size == 0; }
 
-  size_t GetSize() const { return m_tree.size(); }
+  size_t GetSize() const { return m_size; }
 
-  void Clear() { m_tree.clear(); }
+  void Clear()
+  {
+    m_values.clear();
+    m_boxes.clear();
+    m_isErased.clear();
+    m_trees.clear();
+    m_buffer.clear();
+    m_size = 0;
+  }
 
   std::string DebugPrint() const
   {
     std::ostringstream out;
-    for (Value const & v : m_tree.begin())
-      out << v.DebugPrint() << ", ";
+    ForEachEx([&out](m2::RectD const & rect, T const & value) {
+      out << impl::DebugPrintValue(value) << ", " << impl::DebugPrintValue(rect) << ", ";
+    });
     return out.str();
   }
+
+private:
+  template <typename Fn>
+  bool ForAnyIndexInRect(Box const & box, Fn && fn) const
+  {
+    auto const isIntersect = [&box](Box const & b) { return b.IsIntersect(box); };
+    return ForAnyIndex(isIntersect, isIntersect, std::forward<Fn>(fn));
+  }
+
+  template <typename NodePred, typename Pred, typename Fn>
+  bool ForAnyIndex(NodePred && nodePred, Pred && pred, Fn && fn) const
+  {
+    auto const fnIfAlive = [&](uint32_t index) { return !m_isErased[index] && fn(index); };
+    for (auto const & tree : m_trees)
+    {
+      if (tree.ForAny(nodePred, pred, fnIfAlive))
+        return true;
+    }
+
+    for (auto const index : m_buffer)
+    {
+      if (pred(m_boxes[index]) && fnIfAlive(index))
+        return true;
+    }
+    return false;
+  }
+
+  // Packs the buffer together with the trees which are not larger than it.
+  void FlushBuffer()
+  {
+    std::vector<uint32_t> items = std::move(m_buffer);
+    m_buffer.clear();
+    while (!m_trees.empty() && m_trees.back().GetSize() <= items.size())
+    {
+      auto const & treeItems = m_trees.back().GetItems();
+      items.insert(items.end(), treeItems.begin(), treeItems.end());
+      m_trees.pop_back();
+    }
+    m_trees.emplace_back(std::move(items), m_boxes);
+  }
+
+  void MarkErased(uint32_t index)
+  {
+    ASSERT(!m_isErased[index], ());
+    m_isErased[index] = true;
+    --m_size;
+  }
+
+  // Removes the erased objects and packs the alive ones in a single tree when most of the
+  // objects are erased. Indexes of the objects are changed then.
+  void CompactIfNeeded()
+  {
+    if (m_values.size() <= kBufferSize || m_values.size() <= 2 * m_size)
+      return;
+
+    size_t alive = 0;
+    for (size_t i = 0; i < m_values.size(); ++i)
+    {
+      if (m_isErased[i])
+        continue;
+
+      if (alive != i)
+      {
+        m_values[alive] = std::move(m_values[i]);
+        m_boxes[alive] = m_boxes[i];
+      }
+      ++alive;
+    }
+    CHECK_EQUAL(alive, m_size, ());
+
+    m_values.erase(m_values.begin() + alive, m_values.end());
+    m_boxes.resize(alive);
+    m_isErased.assign(alive, false);
+    m_trees.clear();
+    m_buffer.clear();
+
+    std::vector<uint32_t> items(alive);
+    for (uint32_t i = 0; i < alive; ++i)
+      items[i] = i;
+
+    if (alive < kBufferSize)
+      m_buffer = std::move(items);
+    else
+      m_trees.emplace_back(std::move(items), m_boxes);
+  }
+
+  // Objects in the order of adding with their rects, erased objects are marked.
+  std::vector<T> m_values;
+  std::vector<Box> m_boxes;
+  std::vector<bool> m_isErased;
+  size_t m_size = 0;
+
+  // Trees are sorted by size in descending order.
+  std::vector<PackedTree> m_trees;
+  std::vector<uint32_t> m_buffer;
 };
 
 template <typename T, typename Traits>
@@ -3,7 +3,6 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "coding/reader.hpp"
-#include "coding/reader_streambuf.hpp"
 
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
@@ -120,9 +119,10 @@ int8_t constexpr CategoriesHolder::kUnsupportedLocaleCode;
 
 CategoriesHolder::CategoriesHolder(std::unique_ptr<Reader> && reader)
 {
-  ReaderStreamBuf buffer(std::move(reader));
-  std::istream s(&buffer);
-  LoadFromStream(s);
+  // The file is read at once and parsed in place, without copying every line.
+  std::string content;
+  reader->ReadAsString(content);
+  LoadFromString(content);
 
 #if defined(DEBUG)
   for (auto const & entry : kLocaleMapping)
@@ -130,11 +130,12 @@ CategoriesHolder::CategoriesHolder(std::unique_ptr<Reader> && reader)
 #endif
 }
 
-void CategoriesHolder::AddCategory(Category & cat, std::vector<uint32_t> & types)
+void CategoriesHolder::AddCategory(Category & cat, std::vector<uint32_t> & types,
+                                   TokensCache & tokensCache)
 {
   if (!cat.m_synonyms.empty() && !types.empty())
   {
-    std::shared_ptr<Category> p(new Category());
+    auto p = std::make_shared<Category>();
     p->Swap(cat);
 
     for (uint32_t const t : types)
@@ -147,14 +148,22 @@ void CategoriesHolder::AddCategory(Category & cat, std::vector<uint32_t> & types
 
       auto const localePrefix = strings::UniString(1, static_cast<strings::UniChar>(locale));
 
-      search::ForEachNormalizedToken(synonym.m_name, [&](strings::UniString const & token)
+      auto const res = tokensCache.try_emplace(synonym.m_name);
+      auto & tokens = res.first->second;
+      if (res.second)
       {
-        if (ValidKeyToken(token))
+        search::ForEachNormalizedToken(synonym.m_name, [&tokens](strings::UniString const & token)
         {
-          for (uint32_t const t : types)
-            m_name2type.Add(localePrefix + token, t);
-        }
-      });
+          if (ValidKeyToken(token))
+            tokens.push_back(token);
+        });
+      }
+
+      for (auto const & token : tokens)
+      {
+        for (uint32_t const t : types)
+          m_name2type.Add(localePrefix + token, t);
+      }
     }
   }
 
@@ -177,23 +186,28 @@ bool CategoriesHolder::ValidKeyToken(strings::UniString const & s)
   return true;
 }
 
-void CategoriesHolder::LoadFromStream(std::istream & s)
+void CategoriesHolder::LoadFromString(std::string_view content)
 {
   m_type2cat.clear();
   m_name2type.Clear();
   m_groupTranslations.clear();
 
   ParseState state = EParseTypes;
-  std::string line;
   Category cat;
   std::vector<uint32_t> types;
   std::vector<std::string> currentGroups;
+  TokensCache tokensCache;
 
   int lineNumber = 0;
-  while (s.good())
+  for (bool hasMoreLines = true; hasMoreLines;)
   {
     ++lineNumber;
-    getline(s, line);
+    auto const eol = content.find('\n');
+    hasMoreLines = eol != std::string_view::npos;
+    std::string_view line = content.substr(0, eol);
+    if (hasMoreLines)
+      content.remove_prefix(eol + 1);
+
     strings::Trim(line);
     // Allow for comments starting with '#' character.
     if (!line.empty() && line[0] == '#')
@@ -203,7 +217,7 @@ void CategoriesHolder::LoadFromStream(std::istream & s)
 
     if (state == EParseTypes)
     {
-      AddCategory(cat, types);
+      AddCategory(cat, types, tokensCache);
       currentGroups.clear();
 
       while (iter)
@@ -241,7 +255,7 @@ void CategoriesHolder::LoadFromStream(std::istream & s)
     }
   }
   // Add the last category.
-  AddCategory(cat, types);
+  AddCategory(cat, types, tokensCache);
 }
 
 bool CategoriesHolder::GetNameByType(uint32_t type, int8_t locale, std::string & name) const
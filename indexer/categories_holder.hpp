@@ -7,6 +7,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -202,8 +203,11 @@ public:
   static std::string MapIntegerToLocale(int8_t code);
 
 private:
-  void LoadFromStream(std::istream & s);
-  void AddCategory(Category & cat, std::vector<uint32_t> & types);
+  // Normalized key tokens of the synonyms, they are shared by categories of the same group.
+  using TokensCache = std::unordered_map<std::string, std::vector<strings::UniString>>;
+
+  void LoadFromString(std::string_view content);
+  void AddCategory(Category & cat, std::vector<uint32_t> & types, TokensCache & tokensCache);
   static bool ValidKeyToken(strings::UniString const & s);
 };
 
@@ -54,6 +54,14 @@ public:
   // false if table does not have entry for the feature.
   [[nodiscard]] bool Get(uint32_t id, m2::PointD & center);
 
+  // Gets centers of the features with sorted |ids| at once: every block of the table is decoded
+  // only once. Calls |fn(id, center)| for the features which have entries in the table.
+  template <typename Fn>
+  void ForEachOf(std::vector<uint32_t> const & ids, Fn && fn) const
+  {
+    m_map->ForEachOf(ids, [&](uint32_t id, m2::PointU const & pointu) { fn(id, ToPointD(pointu)); });
+  }
+
   uint64_t Count() const { return m_map->Count(); };
 
   // Loads CentersTable instance. Note that |reader| must be alive
@@ -70,6 +78,8 @@ private:
   bool Init(Reader & reader, serial::GeometryCodingParams const & codingParams,
             m2::RectD const & limitRect);
 
+  m2::PointD ToPointD(m2::PointU const & pointu) const;
+
   serial::GeometryCodingParams m_codingParams;
   std::unique_ptr<Map> m_map;
   std::unique_ptr<Reader> m_centersSubreader;
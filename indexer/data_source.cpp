@@ -17,9 +17,11 @@ class ReadMWMFunctor
 public:
   using Fn = std::function<void(uint32_t, FeatureSource & src)>;
 
-  ReadMWMFunctor(FeatureSourceFactory const & factory, Fn const & fn) : m_factory(factory), m_fn(fn)
+  // When |prefetch| is true the records of all the covered features are requested from the
+  // reader before |fn| is called for the first of them. Use it when |fn| reads the features.
+  ReadMWMFunctor(FeatureSourceFactory const & factory, Fn const & fn, bool prefetch = false)
+    : m_factory(factory), m_fn(fn), m_prefetch(prefetch)
   {
-    m_stop = []() { return false; };
   }
 
   ReadMWMFunctor(FeatureSourceFactory const & factory, Fn const & fn,
@@ -53,16 +55,39 @@ public:
       covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
       ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
 
-      // iterate through intervals
-      for (auto const & i : intervals)
+      auto const processValue = [&](uint64_t /* key */, uint32_t value)
       {
-        index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint64_t /* key */, uint32_t value)
+        if (checkUnique(value))
+          m_fn(value, *src);
+      };
+
+      if (m_stop)
+      {
+        // Intervals go by distance from the center (see CoveringMode::Spiral) and reading
+        // may be stopped after any of them.
+        for (auto const & i : intervals)
+        {
+          index.ForEachInIntervalAndScale(i.first, i.second, scale, processValue);
+          if (m_stop())
+            break;
+        }
+      }
+      else if (m_prefetch)
+      {
+        std::vector<uint32_t> indexes;
+        index.ForEachInIntervalsAndScale(intervals, scale, [&](uint64_t /* key */, uint32_t value)
         {
           if (checkUnique(value))
-            m_fn(value, *src);
+            indexes.push_back(value);
         });
-        if (m_stop())
-          break;
+
+        src->PrefetchOriginalFeatures(indexes);
+        for (auto const i : indexes)
+          m_fn(i, *src);
+      }
+      else
+      {
+        index.ForEachInIntervalsAndScale(intervals, scale, processValue);
       }
     }
 
@@ -76,7 +101,9 @@ public:
 private:
   FeatureSourceFactory const & m_factory;
   Fn m_fn;
+  // Empty when reading can't be stopped.
   DataSource::StopSearchCallback m_stop;
+  bool m_prefetch = false;
 };
 
 void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
@@ -150,11 +177,22 @@ std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint
 // DataSource ----------------------------------------------------------------------------------
 std::unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
+  auto info = std::make_unique<MwmInfoEx>();
+
+  indexer::MwmInfoCache::Entry entry;
+  if (m_infoCache && m_infoCache->Get(localFile, entry))
+  {
+    info->m_bordersRect = entry.m_bordersRect;
+    info->m_minScale = entry.m_minScale;
+    info->m_maxScale = entry.m_maxScale;
+    info->m_version = entry.m_version;
+    info->m_data = std::move(entry.m_regionData);
+    return info;
+  }
+
   MwmValue value(localFile);
 
   feature::DataHeader const & h = value.GetHeader();
-
-  auto info = std::make_unique<MwmInfoEx>();
   info->m_bordersRect = h.GetBounds();
 
   auto const scaleR = h.GetScaleRange();
@@ -163,6 +201,16 @@ std::unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const
   info->m_version = value.GetMwmVersion();
   value.m_factory.MoveRegionData(info->m_data);
 
+  if (m_infoCache)
+  {
+    entry.m_bordersRect = info->m_bordersRect;
+    entry.m_minScale = info->m_minScale;
+    entry.m_maxScale = info->m_maxScale;
+    entry.m_version = info->m_version;
+    entry.m_regionData = info->m_data;
+    m_infoCache->Put(localFile, entry);
+  }
+
   return info;
 }
 
@@ -236,7 +284,7 @@ void DataSource::ForEachInRect(FeatureCallback const & f, m2::RectD const & rect
     ReadFeatureType(f, src, index);
   };
 
-  ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
+  ReadMWMFunctor readFunctor(*m_factory, readFeatureType, true /* prefetch */);
   ForEachInIntervals(readFunctor, covering::ViewportWithLowLevels, rect, scale);
 }
 
@@ -273,7 +321,7 @@ void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const
       ReadFeatureType(f, src, index);
     };
 
-    ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
+    ReadMWMFunctor readFunctor(*m_factory, readFeatureType, true /* prefetch */);
     readFunctor(handle, cov, scale);
   }
 }
@@ -290,23 +338,14 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID>
     MwmHandle const handle = GetMwmHandleById(id);
     if (handle.IsAlive())
     {
-      // Prepare features reading.
-      auto src = (*m_factory)(handle);
+      std::vector<uint32_t> indexes;
       do
       {
-        auto const fts = src->GetFeatureStatus(fidIter->m_index);
-        ASSERT_NOT_EQUAL(
-            FeatureStatus::Deleted, fts,
-            ("Deleted feature was cached. It should not be here. Please review your code."));
-        std::unique_ptr<FeatureType> ft;
-        if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
-          ft = src->GetModifiedFeature(fidIter->m_index);
-        else
-          ft = src->GetOriginalFeature(fidIter->m_index);
-
-        CHECK(ft, ());
-        fn(*ft);
+        indexes.push_back(fidIter->m_index);
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
+
+      // Features of the mwm are read by runs of close records instead of one by one.
+      (*m_factory)(handle)->LoadFeatures(indexes, fn);
     }
     else
     {
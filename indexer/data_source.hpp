@@ -2,6 +2,7 @@
 
 #include "indexer/feature_covering.hpp"
 #include "indexer/feature_source.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include <functional>
@@ -19,6 +20,10 @@ public:
   /// Registers a new map.
   std::pair<MwmId, RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  /// Sets the cache of registration data, maps found in it are registered without opening.
+  /// Must be set before the maps are registered.
+  void SetInfoCache(std::shared_ptr<indexer::MwmInfoCache> cache) { m_infoCache = std::move(cache); }
+
   /// Deregisters a map from internal records.
   ///
   /// \param countryFile A countryFile denoting a map to be deregistered.
@@ -68,6 +73,7 @@ protected:
 
 private:
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  std::shared_ptr<indexer::MwmInfoCache> m_infoCache;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
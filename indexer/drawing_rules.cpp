@@ -10,7 +10,9 @@
 
 #include "base/logging.hpp"
 
+#include <atomic>
 #include <functional>
+#include <memory>
 
 #include <boost/iterator/iterator_facade.hpp>
 
@@ -23,6 +25,8 @@ using namespace std;
 namespace
 {
   uint32_t const DEFAULT_BG_COLOR = 0xEEEEDD;
+
+  std::atomic<uint64_t> g_rulesVersion{0};
 } // namespace
 
 LineRuleProto const * BaseRule::GetLine() const
@@ -83,6 +87,7 @@ void RulesHolder::Clean()
 
   m_dRules.clear();
   m_colors.clear();
+  m_cont.reset();
 }
 
 Key RulesHolder::AddRule(int scale, TypeT type, BaseRule * p)
@@ -142,7 +147,7 @@ namespace
   {
     class Line : public BaseRule
     {
-      LineRuleProto m_line;
+      LineRuleProto const & m_line;
     public:
       explicit Line(LineRuleProto const & r)
         : m_line(r)
@@ -155,7 +160,7 @@ namespace
 
     class Area : public BaseRule
     {
-      AreaRuleProto m_area;
+      AreaRuleProto const & m_area;
     public:
       explicit Area(AreaRuleProto const & r) : m_area(r) {}
 
@@ -164,7 +169,7 @@ namespace
 
     class Symbol : public BaseRule
     {
-      SymbolRuleProto m_symbol;
+      SymbolRuleProto const & m_symbol;
     public:
       explicit Symbol(SymbolRuleProto const & r) : m_symbol(r) {}
 
@@ -173,7 +178,7 @@ namespace
 
     class Caption : public BaseRule
     {
-      CaptionRuleProto m_caption;
+      CaptionRuleProto const & m_caption;
     public:
       explicit Caption(CaptionRuleProto const & r)
         : m_caption(r)
@@ -186,7 +191,7 @@ namespace
 
     class PathText : public BaseRule
     {
-      PathTextRuleProto m_pathtext;
+      PathTextRuleProto const & m_pathtext;
     public:
       explicit PathText(PathTextRuleProto const & r) : m_pathtext(r) {}
 
@@ -195,7 +200,7 @@ namespace
 
     class Shield : public BaseRule
     {
-      ShieldRuleProto m_shield;
+      ShieldRuleProto const & m_shield;
     public:
       explicit Shield(ShieldRuleProto const & r) : m_shield(r) {}
 
@@ -205,11 +210,10 @@ namespace
 
   class DoSetIndex
   {
-  public:
-    ContainerProto m_cont;
+    ContainerProto const & m_cont;
 
-  private:
-    vector<string> m_names;
+    /// Full name of the current classificator object, like "highway-primary-bridge".
+    string m_name;
 
     typedef ClassifElementProto ElementT;
 
@@ -251,16 +255,12 @@ namespace
 
     int FindIndex() const
     {
-      string name = m_names[0];
-      for (size_t i = 1; i < m_names.size(); ++i)
-        name = name + "-" + m_names[i];
-
       int const count = m_cont.cont_size();
-      int const i = lower_bound(RandI(m_cont, 0), RandI(m_cont, count), name, less_name()).m_index;
+      int const i = lower_bound(RandI(m_cont, 0), RandI(m_cont, count), m_name, less_name()).m_index;
       ASSERT_GREATER_OR_EQUAL(i, 0, ());
       ASSERT_LESS_OR_EQUAL(i, count, ());
 
-      if (i < count && m_cont.cont(i).name() == name)
+      if (i < count && m_cont.cont(i).name() == m_name)
         return i;
       else
         return -1;
@@ -300,12 +300,15 @@ namespace
     }
 
   public:
-    explicit DoSetIndex(RulesHolder & holder)
-      : m_holder(holder) {}
+    DoSetIndex(ContainerProto const & cont, RulesHolder & holder)
+      : m_cont(cont), m_holder(holder) {}
 
     void operator() (ClassifObject * p)
     {
-      m_names.push_back(p->GetName());
+      size_t const parentSize = m_name.size();
+      if (!m_name.empty())
+        m_name += '-';
+      m_name += p->GetName();
 
       int const i = FindIndex();
       if (i != -1)
@@ -343,7 +346,7 @@ namespace
 
       p->ForEachObject(ref(*this));
 
-      m_names.pop_back();
+      m_name.resize(parentSize);
     }
   };
 } // namespace
@@ -413,14 +416,16 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
 {
   Clean();
 
-  DoSetIndex doSet(*this);
-
-  CHECK ( doSet.m_cont.ParseFromString(s), ("Error in proto loading!") );
+  m_cont = make_unique<ContainerProto>();
+  CHECK ( m_cont->ParseFromString(s), ("Error in proto loading!") );
 
+  DoSetIndex doSet(*m_cont, *this);
   classif().GetMutableRoot()->ForEachObject(ref(doSet));
 
-  InitBackgroundColors(doSet.m_cont);
-  InitColors(doSet.m_cont);
+  InitBackgroundColors(*m_cont);
+  InitColors(*m_cont);
+
+  m_version = ++g_rulesVersion;
 }
 
 void LoadRules()
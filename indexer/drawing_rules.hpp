@@ -48,6 +48,9 @@ namespace drule
     // Set runtime feature style selector
     void SetSelector(std::unique_ptr<ISelector> && selector);
 
+    // Returns true if the rule depends on feature's properties besides its types.
+    bool HasSelector() const { return m_selector != nullptr; }
+
   private:
     std::unique_ptr<ISelector> m_selector;
   };
@@ -62,6 +65,10 @@ namespace drule
 
     BaseRule const * Find(Key const & k) const;
 
+    // Returns an id of the loaded rules which is unique across all holders and loads,
+    // so results computed from the rules may be cached by it.
+    uint64_t GetVersion() const { return m_version; }
+
     uint32_t GetBgColor(int scale) const;
     uint32_t GetColor(std::string const & name) const;
 
@@ -83,6 +90,10 @@ namespace drule
     void InitColors(ContainerProto const & cp);
     void Clean();
 
+    /// Parsed style, rules refer to its elements instead of keeping copies.
+    std::unique_ptr<ContainerProto> m_cont;
+    uint64_t m_version = 0;
+
     /// background color for scales in range [0...scales::UPPER_STYLE_SCALE]
     std::vector<uint32_t> m_bgColors;
     std::unordered_map<std::string, uint32_t> m_colors;
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <sstream>
 
 using namespace feature;
 using namespace std;
@@ -117,9 +118,9 @@ uint32_t CalcOffset(ArrayByteSource const & source, uint8_t const * start)
   return static_cast<uint32_t>(distance(start, source.PtrUint8()));
 }
 
-uint8_t Header(vector<uint8_t> const & data)
+uint8_t Header(uint8_t const * data)
 {
- CHECK(!data.empty(), ());
+ CHECK(data, ());
  return data[0];
 }
 
@@ -190,10 +191,24 @@ uint8_t ReadByte(TSource & src)
 FeatureType::FeatureType(SharedLoadInfo const * loadInfo, vector<uint8_t> && buffer,
                          indexer::MetadataDeserializer * metadataDeserializer)
   : m_loadInfo(loadInfo)
-  , m_data(std::move(buffer))
+  , m_buffer(std::move(buffer))
   , m_metadataDeserializer(metadataDeserializer)
 {
   CHECK(m_loadInfo, ());
+  CHECK(!m_buffer.empty(), ());
+
+  m_data = m_buffer.data();
+  m_header = Header(m_data); // Parse the header and optional name/layer/addinfo.
+}
+
+FeatureType::FeatureType(SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+                         indexer::MetadataDeserializer * metadataDeserializer)
+  : m_loadInfo(loadInfo)
+  , m_data(data)
+  , m_metadataDeserializer(metadataDeserializer)
+{
+  CHECK(m_loadInfo, ());
+  CHECK_GREATER(size, 0, ());
 
   m_header = Header(m_data); // Parse the header and optional name/layer/addinfo.
 }
@@ -272,9 +287,10 @@ void FeatureType::ParseTypes()
   if (m_parsed.m_types)
     return;
 
+  CheckAllowed(PART_TYPES);
   auto const typesOffset = sizeof(m_header);
   Classificator & c = classif();
-  ArrayByteSource source(m_data.data() + typesOffset);
+  ArrayByteSource source(m_data + typesOffset);
 
   size_t const count = GetTypesCount();
   for (size_t i = 0; i < count; ++i)
@@ -293,7 +309,7 @@ void FeatureType::ParseTypes()
     }
   }
 
-  m_offsets.m_common = CalcOffset(source, m_data.data());
+  m_offsets.m_common = CalcOffset(source, m_data);
   m_parsed.m_types = true;
 }
 
@@ -302,10 +318,11 @@ void FeatureType::ParseCommon()
   if (m_parsed.m_common)
     return;
 
+  CheckAllowed(PART_COMMON);
   CHECK(m_loadInfo, ());
   ParseTypes();
 
-  ArrayByteSource source(m_data.data() + m_offsets.m_common);
+  ArrayByteSource source(m_data + m_offsets.m_common);
   uint8_t const h = Header(m_data);
   m_params.Read(source, h);
 
@@ -315,7 +332,7 @@ void FeatureType::ParseCommon()
     m_limitRect.Add(m_center);
   }
 
-  m_offsets.m_header2 = CalcOffset(source, m_data.data());
+  m_offsets.m_header2 = CalcOffset(source, m_data);
   m_parsed.m_common = true;
 }
 
@@ -347,11 +364,12 @@ void FeatureType::ParseHeader2()
   if (m_parsed.m_header2)
     return;
 
+  CheckAllowed(PART_HEADER2);
   CHECK(m_loadInfo, ());
   ParseCommon();
 
   uint8_t elemsCount = 0, geomScalesMask = 0;
-  BitSource bitSource(m_data.data() + m_offsets.m_header2);
+  BitSource bitSource(m_data + m_offsets.m_header2);
   auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
 
   if (headerGeomType == HeaderGeomType::Line || headerGeomType == HeaderGeomType::Area)
@@ -420,7 +438,7 @@ void FeatureType::ParseHeader2()
     }
   }
   // Size of the whole header incl. inner geometry / triangles.
-  m_innerStats.m_size = CalcOffset(src, m_data.data());
+  m_innerStats.m_size = CalcOffset(src, m_data);
   m_parsed.m_header2 = true;
 }
 
@@ -446,6 +464,7 @@ void FeatureType::ParseGeometry(int scale)
 {
   if (!m_parsed.m_points)
   {
+    CheckAllowed(PART_POINTS);
     CHECK(m_loadInfo, ());
     ParseHeader2();
 
@@ -547,6 +566,7 @@ void FeatureType::ParseTriangles(int scale)
 {
   if (!m_parsed.m_triangles)
   {
+    CheckAllowed(PART_TRIANGLES);
     CHECK(m_loadInfo, ());
     ParseHeader2();
 
@@ -613,6 +633,7 @@ void FeatureType::ParseMetadata()
   if (m_parsed.m_metadata)
     return;
 
+  CheckAllowed(PART_METADATA);
   CHECK(m_metadataDeserializer, ());
   try
   {
@@ -631,6 +652,7 @@ void FeatureType::ParseMetaIds()
   if (m_parsed.m_metaIds)
     return;
 
+  CheckAllowed(PART_META_IDS);
   CHECK(m_metadataDeserializer, ());
   try
   {
@@ -644,6 +666,61 @@ void FeatureType::ParseMetaIds()
   m_parsed.m_metaIds = true;
 }
 
+void FeatureType::Parse(uint8_t parts, int scale)
+{
+  if (parts & PART_TYPES)
+    ParseTypes();
+  if (parts & PART_COMMON)
+    ParseCommon();
+  if (parts & PART_HEADER2)
+    ParseHeader2();
+  if (parts & PART_POINTS)
+    ParseGeometry(scale);
+  if (parts & PART_TRIANGLES)
+    ParseTriangles(scale);
+  if (parts & PART_METADATA)
+    ParseMetadata();
+  if (parts & PART_META_IDS)
+    ParseMetaIds();
+}
+
+uint8_t FeatureType::GetParsedParts() const
+{
+  uint8_t parts = 0;
+  if (m_parsed.m_types)
+    parts |= PART_TYPES;
+  if (m_parsed.m_common)
+    parts |= PART_COMMON;
+  if (m_parsed.m_header2)
+    parts |= PART_HEADER2;
+  if (m_parsed.m_points)
+    parts |= PART_POINTS;
+  if (m_parsed.m_triangles)
+    parts |= PART_TRIANGLES;
+  if (m_parsed.m_metadata)
+    parts |= PART_METADATA;
+  if (m_parsed.m_metaIds)
+    parts |= PART_META_IDS;
+  return parts;
+}
+
+void FeatureType::SetAllowedParts(uint8_t parts)
+{
+  if (parts & (PART_POINTS | PART_TRIANGLES))
+    parts |= PART_HEADER2;
+  if (parts & PART_HEADER2)
+    parts |= PART_COMMON;
+  if (parts & PART_COMMON)
+    parts |= PART_TYPES;
+  m_allowedParts = parts;
+}
+
+void FeatureType::CheckAllowed(Parts part) const
+{
+  ASSERT((m_allowedParts & part) != 0, ("Decoding of a not allowed part", static_cast<int>(part), m_id));
+  UNUSED_VALUE(part);
+}
+
 StringUtf8Multilang const & FeatureType::GetNames()
 {
   ParseCommon();
@@ -866,3 +943,42 @@ bool FeatureType::HasMetadata(feature::Metadata::EType type)
   return base::FindIf(m_metaIds, [&type](auto const & v) { return v.first == type; }) !=
          m_metaIds.end();
 }
+
+namespace feature
+{
+void ParsedPartsStats::Add(FeatureType const & ft)
+{
+  ++m_featuresCount;
+  uint8_t const parts = ft.GetParsedParts();
+  for (size_t i = 0; i < m_counts.size(); ++i)
+  {
+    if (parts & (1 << i))
+      ++m_counts[i];
+  }
+}
+
+uint32_t ParsedPartsStats::GetCount(FeatureType::Parts part) const
+{
+  for (size_t i = 0; i < m_counts.size(); ++i)
+  {
+    if (part == (1 << i))
+      return m_counts[i];
+  }
+  ASSERT(false, ("Not a single part", static_cast<int>(part)));
+  return 0;
+}
+
+std::string DebugPrint(ParsedPartsStats const & stats)
+{
+  static char const * const kNames[] = {"types", "common", "header2", "points",
+                                        "triangles", "metadata", "metaIds"};
+  static_assert(ARRAY_SIZE(kNames) == FeatureType::kPartsCount);
+
+  std::ostringstream out;
+  out << "ParsedPartsStats [ features: " << stats.m_featuresCount;
+  for (size_t i = 0; i < stats.m_counts.size(); ++i)
+    out << ", " << kNames[i] << ": " << stats.m_counts[i];
+  out << " ]";
+  return out.str();
+}
+}  // namespace feature
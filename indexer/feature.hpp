@@ -36,6 +36,9 @@ public:
 
   FeatureType(feature::SharedLoadInfo const * loadInfo, std::vector<uint8_t> && buffer,
               indexer::MetadataDeserializer * metadataDeserializer);
+  /// Doesn't copy the record: |data| (e.g. a memory mapped features section) must outlive the feature.
+  FeatureType(feature::SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+              indexer::MetadataDeserializer * metadataDeserializer);
 
   static std::unique_ptr<FeatureType> CreateFromMapObject(osm::MapObject const & emo);
 
@@ -87,6 +90,33 @@ public:
   void ParseTriangles(int scale);
   //@}
 
+  /// @name Parts of the record, which are decoded on demand by the getters.
+  //@{
+  enum Parts : uint8_t
+  {
+    PART_TYPES = 1 << 0,
+    // Names, layer, rank, house number, ref and the center of a point.
+    PART_COMMON = 1 << 1,
+    // Inner geometry and offsets of outer geometry.
+    PART_HEADER2 = 1 << 2,
+    PART_POINTS = 1 << 3,
+    PART_TRIANGLES = 1 << 4,
+    PART_METADATA = 1 << 5,
+    PART_META_IDS = 1 << 6,
+    PARTS_ALL = (1 << 7) - 1
+  };
+  static size_t constexpr kPartsCount = 7;
+
+  /// Decodes |parts| at once, the geometry of |scale|.
+  void Parse(uint8_t parts, int scale);
+  /// Returns the mask of the decoded parts, including those decoded implicitly by the getters.
+  uint8_t GetParsedParts() const;
+  /// Parts which may be decoded from now on, the parts they depend on are allowed too.
+  /// A hot path sets it to be sure that it doesn't decode anything else: decoding of
+  /// other parts asserts in debug builds.
+  void SetAllowedParts(uint8_t parts);
+  //@}
+
   /// @name Geometry.
   //@{
   /// This constant values should be equal with feature::FeatureLoader implementation.
@@ -229,6 +259,7 @@ private:
   void ParseMetadata();
   void ParseMetaIds();
   void ParseGeometryAndTriangles(int scale);
+  void CheckAllowed(Parts part) const;
 
   uint8_t m_header = 0;
   std::array<uint32_t, feature::kMaxTypesCount> m_types = {};
@@ -245,12 +276,15 @@ private:
 
   // Non-owning pointer to shared load info. SharedLoadInfo created once per FeaturesVector.
   feature::SharedLoadInfo const * m_loadInfo = nullptr;
-  std::vector<uint8_t> m_data;
+  // Owned copy of the record, empty when the feature points to the mapped record.
+  std::vector<uint8_t> m_buffer;
+  uint8_t const * m_data = nullptr;
 
   // Pointer to shared metedata deserializer. Must be set for mwm format >= Format::v11
   indexer::MetadataDeserializer * m_metadataDeserializer = nullptr;
 
   ParsedFlags m_parsed;
+  uint8_t m_allowedParts = PARTS_ALL;
   Offsets m_offsets;
   uint32_t m_ptsSimpMask = 0;
 
@@ -258,3 +292,24 @@ private:
 
   DISALLOW_COPY_AND_MOVE(FeatureType);
 };
+
+namespace feature
+{
+/// Counts how many of the added features have each part decoded. Used to find out which parts
+/// a caller really decodes: add the features after they are processed and print the stats.
+class ParsedPartsStats
+{
+public:
+  void Add(FeatureType const & ft);
+
+  uint32_t GetFeaturesCount() const { return m_featuresCount; }
+  uint32_t GetCount(FeatureType::Parts part) const;
+
+  friend std::string DebugPrint(ParsedPartsStats const & stats);
+
+private:
+  uint32_t m_featuresCount = 0;
+  std::array<uint32_t, FeatureType::kPartsCount> m_counts = {};
+};
+}  // namespace feature
+
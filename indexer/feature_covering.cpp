@@ -182,4 +182,18 @@ Intervals SortAndMergeIntervals(Intervals const & v)
   SortAndMergeIntervals(v, res);
   return res;
 }
+
+// static
+CoveringCache & CoveringCache::Instance()
+{
+  static CoveringCache instance;
+  return instance;
+}
+
+void CoveringCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries = {};
+  m_next = 0;
+}
 }
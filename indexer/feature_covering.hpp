@@ -12,7 +12,10 @@
 
 #include "base/logging.hpp"
 
+#include <array>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <utility>
 #include <vector>
@@ -94,9 +97,60 @@ enum CoveringMode
   Spiral
 };
 
+// Thread-safe cache of the recently computed coverings. Drape reads the same tile rects on each
+// refresh and search reads the same rects for several requests, so the coverings are computed
+// once and shared.
+class CoveringCache
+{
+public:
+  static CoveringCache & Instance();
+
+  template <typename Compute>
+  std::shared_ptr<Intervals const> Get(m2::RectD const & rect, CoveringMode mode, int depthLevels,
+                                       int cellDepth, Compute && compute)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (auto const & entry : m_entries)
+      {
+        if (entry.m_intervals && entry.m_rect == rect && entry.m_mode == mode &&
+            entry.m_depthLevels == depthLevels && entry.m_cellDepth == cellDepth)
+        {
+          return entry.m_intervals;
+        }
+      }
+    }
+
+    auto intervals = std::make_shared<Intervals>();
+    compute(*intervals);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[m_next] = {rect, mode, depthLevels, cellDepth, intervals};
+    m_next = (m_next + 1) % m_entries.size();
+    return intervals;
+  }
+
+  void Clear();
+
+private:
+  struct Entry
+  {
+    m2::RectD m_rect;
+    CoveringMode m_mode = ViewportWithLowLevels;
+    int m_depthLevels = 0;
+    int m_cellDepth = 0;
+    std::shared_ptr<Intervals const> m_intervals;
+  };
+
+  std::mutex m_mutex;
+  // Entries are replaced in FIFO order, the search is linear as the cache is small.
+  std::array<Entry, 64> m_entries;
+  size_t m_next = 0;
+};
+
 class CoveringGetter
 {
-  Intervals m_res[2];
+  std::shared_ptr<Intervals const> m_res[2];
 
   m2::RectD const & m_rect;
   CoveringMode m_mode;
@@ -112,61 +166,70 @@ public:
     int const cellDepth = GetCodingDepth<DEPTH_LEVELS>(scale);
     int const ind = (cellDepth == DEPTH_LEVELS ? 0 : 1);
 
-    if (m_res[ind].empty())
+    if (!m_res[ind])
     {
-      switch (m_mode)
-      {
-      case ViewportWithLowLevels:
-        CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(m_rect, cellDepth, m_res[ind]);
-        break;
+      m_res[ind] = CoveringCache::Instance().Get(
+          m_rect, m_mode, DEPTH_LEVELS, cellDepth, [this, cellDepth](Intervals & res) {
+            Compute<DEPTH_LEVELS>(m_rect, m_mode, cellDepth, res);
+          });
+    }
 
-      case LowLevelsOnly:
-      {
-        m2::CellId<DEPTH_LEVELS> id = GetRectIdAsIs<DEPTH_LEVELS>(m_rect);
-        while (id.Level() >= cellDepth)
-          id = id.Parent();
-        AppendLowerLevels<DEPTH_LEVELS>(id, cellDepth, [this, ind](Interval const & interval) {
-          m_res[ind].push_back(interval);
-        });
-
-        // Check for optimal result intervals.
+    return *m_res[ind];
+  }
+
+private:
+  template <int DEPTH_LEVELS>
+  static void Compute(m2::RectD const & rect, CoveringMode mode, int cellDepth, Intervals & res)
+  {
+    switch (mode)
+    {
+    case ViewportWithLowLevels:
+      CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(rect, cellDepth, res);
+      break;
+
+    case LowLevelsOnly:
+    {
+      m2::CellId<DEPTH_LEVELS> id = GetRectIdAsIs<DEPTH_LEVELS>(rect);
+      while (id.Level() >= cellDepth)
+        id = id.Parent();
+      AppendLowerLevels<DEPTH_LEVELS>(id, cellDepth, [&res](Interval const & interval) {
+        res.push_back(interval);
+      });
+
+      // Check for optimal result intervals.
 #if 0
-        size_t oldSize = m_res[ind].size();
-        Intervals res;
-        SortAndMergeIntervals(m_res[ind], res);
-        if (res.size() != oldSize)
-          LOG(LINFO, ("Old =", oldSize, "; New =", res.size()));
-        res.swap(m_res[ind]);
+      size_t oldSize = res.size();
+      Intervals merged;
+      SortAndMergeIntervals(res, merged);
+      if (merged.size() != oldSize)
+        LOG(LINFO, ("Old =", oldSize, "; New =", merged.size()));
+      merged.swap(res);
 #endif
-        break;
-      }
+      break;
+    }
 
-      case FullCover:
-        m_res[ind].push_back(
-            Intervals::value_type(0, static_cast<int64_t>((uint64_t{1} << 63) - 1)));
-        break;
+    case FullCover:
+      res.push_back(Intervals::value_type(0, static_cast<int64_t>((uint64_t{1} << 63) - 1)));
+      break;
 
-      case Spiral:
-      {
-        std::vector<m2::CellId<DEPTH_LEVELS>> ids;
-        CoverSpiral<mercator::Bounds, m2::CellId<DEPTH_LEVELS>>(m_rect, cellDepth - 1, ids);
+    case Spiral:
+    {
+      std::vector<m2::CellId<DEPTH_LEVELS>> ids;
+      CoverSpiral<mercator::Bounds, m2::CellId<DEPTH_LEVELS>>(rect, cellDepth - 1, ids);
 
-        std::set<Interval> uniqueIds;
-        auto insertInterval = [this, ind, &uniqueIds](Interval const & interval) {
-          if (uniqueIds.insert(interval).second)
-            m_res[ind].push_back(interval);
-        };
+      std::set<Interval> uniqueIds;
+      auto insertInterval = [&res, &uniqueIds](Interval const & interval) {
+        if (uniqueIds.insert(interval).second)
+          res.push_back(interval);
+      };
 
-        for (auto const & id : ids)
-        {
-          if (cellDepth > id.Level())
-            AppendLowerLevels<DEPTH_LEVELS>(id, cellDepth, insertInterval);
-        }
-      }
+      for (auto const & id : ids)
+      {
+        if (cellDepth > id.Level())
+          AppendLowerLevels<DEPTH_LEVELS>(id, cellDepth, insertInterval);
       }
     }
-
-    return m_res[ind];
+    }
   }
 };
 }
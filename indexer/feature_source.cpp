@@ -41,6 +41,44 @@ std::unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) c
   return ft;
 }
 
+void FeatureSource::LoadFeatures(std::vector<uint32_t> const & indexes,
+                                 std::function<void(FeatureType &)> const & fn) const
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector, ());
+
+  std::vector<uint32_t> originalIndexes;
+  originalIndexes.reserve(indexes.size());
+  for (auto const index : indexes)
+  {
+    auto const status = GetFeatureStatus(index);
+    if (status == FeatureStatus::Deleted)
+      continue;
+
+    if (status == FeatureStatus::Modified || status == FeatureStatus::Created)
+    {
+      auto ft = GetModifiedFeature(index);
+      CHECK(ft, (index));
+      fn(*ft);
+      continue;
+    }
+
+    originalIndexes.push_back(index);
+  }
+
+  m_vector->ForEachByIndexes(originalIndexes, [&](uint32_t index, FeatureType & ft)
+  {
+    ft.SetID({GetMwmId(), index});
+    fn(ft);
+  });
+}
+
+void FeatureSource::PrefetchOriginalFeatures(std::vector<uint32_t> const & indexes) const
+{
+  ASSERT(m_vector, ());
+  m_vector->Prefetch(indexes);
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 enum class FeatureStatus
 {
@@ -35,6 +36,16 @@ public:
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
 
+  // Calls |fn| for the features with |indexes|, deleted ones are skipped. Original features are
+  // read in the order of their records in the mwm, see FeaturesVector::ForEachByIndexes(),
+  // so the order of the calls differs from |indexes| and |fn| mustn't keep the features.
+  void LoadFeatures(std::vector<uint32_t> const & indexes,
+                    std::function<void(FeatureType &)> const & fn) const;
+
+  // Starts reading of the original features with |indexes| in background, see
+  // FeaturesVector::Prefetch().
+  void PrefetchOriginalFeatures(std::vector<uint32_t> const & indexes) const;
+
   MwmSet::MwmId const & GetMwmId() const { return m_handle.GetId(); }
 
   virtual FeatureStatus GetFeatureStatus(uint32_t index) const;
@@ -109,17 +109,12 @@ namespace feature
                                                      m_table.select(size() - 1)));
     ASSERT_GREATER_OR_EQUAL(offset, m_table.select(0), ("Offset out of bounds", offset,
                                                         m_table.select(size() - 1)));
-    //Binary search in elias_fano list
-    size_t leftBound = 0, rightBound = size();
-    while (leftBound + 1 < rightBound) {
-      size_t middle = leftBound + (rightBound - leftBound) / 2;
-      if (m_table.select(middle) <= offset)
-        leftBound = middle;
-      else
-        rightBound = middle;
-    }
-    ASSERT_EQUAL(offset, m_table.select(leftBound), ("Can't find offset", offset, "in the table"));
-    return leftBound;
+    // The table is always built with the rank index (see Build()), so the index of the offset is
+    // the number of offsets less than it, which is found by one select over zeros of high bits
+    // instead of the binary search by select over ones.
+    auto const index = static_cast<size_t>(m_table.rank(offset));
+    ASSERT_EQUAL(offset, m_table.select(index), ("Can't find offset", offset, "in the table"));
+    return index;
   }
 
   bool BuildOffsetsTable(string const & filePath)
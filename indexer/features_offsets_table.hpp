@@ -78,10 +78,10 @@ namespace feature
     void Save(std::string const & filePath);
 
     /// \param index index of a feature
-    /// \return offset a feature
+    /// \return offset a feature, O(1) by select
     uint32_t GetFeatureOffset(size_t index) const;
 
-    /// \param offset offset of a feature
+    /// \param offset offset of a feature, O(1) by rank
     /// \return index of a feature
     size_t GetFeatureIndexbyOffset(uint32_t offset) const;
 
@@ -91,7 +91,7 @@ namespace feature
     /// \return byte size of a table, may be slightly different from a
     ///         real byte size in memory or on disk due to alignment, but
     ///         can be used in benchmarks, logging, etc.
-    // size_t byte_size() { return static_cast<size_t>(succinct::mapper::size_of(m_table)); }
+    size_t byte_size() { return static_cast<size_t>(succinct::mapper::size_of(m_table)); }
 
   private:
     FeaturesOffsetsTable(succinct::elias_fano::elias_fano_builder & builder);
@@ -5,6 +5,13 @@
 
 #include "platform/constants.hpp"
 
+#include "coding/byte_stream.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/varint.hpp"
+
+#include <algorithm>
+#include <utility>
+
 
 FeaturesVector::FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
                                feature::FeaturesOffsetsTable const * table,
@@ -22,16 +29,129 @@ void FeaturesVector::InitRecordsReader()
   header.Read(*reader.GetPtr());
   CHECK(header.m_version == feature::DatSectionHeader::Version::V0,
           (base::Underlying(header.m_version)));
-  m_recordReader = std::make_unique<RecordReader>(
-        reader.SubReader(header.m_featuresOffset, header.m_featuresSize));
+  auto recordsReader = reader.SubReader(header.m_featuresOffset, header.m_featuresSize);
+  if (auto const * mmapReader = dynamic_cast<MmapReader const *>(recordsReader.GetPtr()))
+  {
+    m_mappedRecords = mmapReader->Data();
+    m_mappedRecordsSize = mmapReader->Size();
+  }
+  m_recordReader = std::make_unique<RecordReader>(std::move(recordsReader));
+}
+
+uint8_t const * FeaturesVector::GetMappedRecord(uint64_t pos, size_t & size) const
+{
+  CHECK_LESS(pos, m_mappedRecordsSize, ());
+  ArrayByteSource source(m_mappedRecords + pos);
+  size = ReadVarUint<uint32_t>(source);
+  CHECK_LESS_OR_EQUAL(source.PtrUint8() + size, m_mappedRecords + m_mappedRecordsSize, (pos, size));
+  return source.PtrUint8();
 }
 
 std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
 {
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  if (m_mappedRecords)
+  {
+    size_t size = 0;
+    uint8_t const * data = GetMappedRecord(ftOffset, size);
+    return std::make_unique<FeatureType>(&m_loadInfo, data, size, m_metaDeserializer);
+  }
   return std::make_unique<FeatureType>(&m_loadInfo, m_recordReader->ReadRecord(ftOffset), m_metaDeserializer);
 }
 
+void FeaturesVector::Prefetch(std::vector<uint32_t> const & indexes) const
+{
+  // Records of close features are merged into one request when the gap between them is small,
+  // the end of the last record is unknown until it's read, so |kMaxRecordSize| is requested for it.
+  uint64_t constexpr kMaxGap = 16 * 1024;
+  uint64_t constexpr kMaxRecordSize = 4 * 1024;
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(indexes.size());
+  for (auto const index : indexes)
+    offsets.push_back(m_table ? m_table->GetFeatureOffset(index) : index);
+  std::sort(offsets.begin(), offsets.end());
+
+  size_t i = 0;
+  while (i < offsets.size())
+  {
+    uint64_t const beg = offsets[i];
+    uint64_t end = beg;
+    for (++i; i < offsets.size() && offsets[i] <= end + kMaxGap; ++i)
+      end = offsets[i];
+    m_recordReader->Prefetch(beg, end - beg + kMaxRecordSize);
+  }
+}
+
+void FeaturesVector::ForEachByIndexes(std::vector<uint32_t> const & indexes,
+                                      std::function<void(uint32_t, FeatureType &)> const & fn) const
+{
+  std::vector<std::pair<uint64_t, uint32_t>> records;
+  records.reserve(indexes.size());
+  for (auto const index : indexes)
+    records.emplace_back(m_table ? m_table->GetFeatureOffset(index) : index, index);
+  std::sort(records.begin(), records.end());
+
+  if (m_mappedRecords)
+  {
+    for (auto const & [offset, index] : records)
+    {
+      size_t size = 0;
+      uint8_t const * data = GetMappedRecord(offset, size);
+      FeatureType ft(&m_loadInfo, data, size, m_metaDeserializer);
+      fn(index, ft);
+    }
+    return;
+  }
+
+  // Records closer than |kMaxGap| are read together, up to |kMaxRunSize| bytes.
+  uint64_t constexpr kMaxGap = 4 * 1024;
+  uint64_t constexpr kMaxRunSize = 256 * 1024;
+  // Max size of VarUint<uint32_t> which precedes a record.
+  uint64_t constexpr kMaxRecordSizeBytes = 5;
+
+  auto const & reader = m_recordReader->GetReader();
+  uint64_t const recordsSize = reader.Size();
+  std::vector<uint8_t> buffer;
+  size_t i = 0;
+  while (i < records.size())
+  {
+    uint64_t const beg = records[i].first;
+    uint64_t last = beg;
+    size_t end = i + 1;
+    for (; end < records.size(); ++end)
+    {
+      uint64_t const offset = records[end].first;
+      if (offset > last + kMaxGap || offset - beg > kMaxRunSize)
+        break;
+      last = offset;
+    }
+
+    // The size of the last record is unknown until its header is read.
+    uint64_t const readEnd = std::min(last + kMaxRecordSizeBytes, recordsSize);
+    buffer.resize(static_cast<size_t>(readEnd - beg));
+    reader.Read(beg, buffer.data(), buffer.size());
+
+    ArrayByteSource lastSource(buffer.data() + (last - beg));
+    uint32_t const lastSize = ReadVarUint<uint32_t>(lastSource);
+    uint64_t const runEnd = beg + (lastSource.PtrUint8() - buffer.data()) + lastSize;
+    CHECK_LESS_OR_EQUAL(runEnd, recordsSize, (last, lastSize));
+    if (runEnd > readEnd)
+    {
+      buffer.resize(static_cast<size_t>(runEnd - beg));
+      reader.Read(readEnd, buffer.data() + (readEnd - beg), static_cast<size_t>(runEnd - readEnd));
+    }
+
+    for (; i < end; ++i)
+    {
+      ArrayByteSource source(buffer.data() + (records[i].first - beg));
+      uint32_t const size = ReadVarUint<uint32_t>(source);
+      FeatureType ft(&m_loadInfo, source.PtrUint8(), size, m_metaDeserializer);
+      fn(records[i].second, ft);
+    }
+  }
+}
+
 size_t FeaturesVector::GetNumFeatures() const
 {
   return m_table ? m_table->size() : 0;
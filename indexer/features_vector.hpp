@@ -7,13 +7,17 @@
 #include "coding/var_record_reader.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace feature { class FeaturesOffsetsTable; }
 
-/// Note! This class is NOT Thread-Safe.
-/// You should have separate instance of Vector for every thread.
+/// Note! This class is thread-safe only when IsThreadSafe() is true, i.e. when the container
+/// is memory mapped (see platform::GetCountryReader). Then records, geometry and offsets are
+/// read by position from the mapping, there are no shared cursors or caches, and several
+/// threads may call GetByIndex() and ForEach() at once without locks.
+/// Otherwise you should have separate instance of Vector for every thread.
 class FeaturesVector
 {
   DISALLOW_COPY(FeaturesVector);
@@ -27,19 +31,58 @@ public:
 
   size_t GetNumFeatures() const;
 
+  bool IsThreadSafe() const { return m_mappedRecords != nullptr; }
+
+  /// Asks the reader to load the records of the features with |indexes| in background,
+  /// so following GetByIndex() calls don't wait for the disk page by page. Doesn't block.
+  void Prefetch(std::vector<uint32_t> const & indexes) const;
+
+  /// Calls |fn(index, feature)| for the features with |indexes| in the order of their records.
+  /// Close records are read from the file by one request to a buffer which is reused for
+  /// all of them, so |feature| is valid only during the call.
+  void ForEachByIndexes(std::vector<uint32_t> const & indexes,
+                        std::function<void(uint32_t, FeatureType &)> const & fn) const;
+
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
-    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
+    auto const process = [&](FeatureType & ft, uint32_t pos)
     {
-      FeatureType ft(&m_loadInfo, std::move(data), m_metaDeserializer);
-
       // We can't properly set MwmId here, because FeaturesVector
       // works with FileContainerR, not with MwmId/MwmHandle/MwmValue.
       // But it's OK to set at least feature's index, because it can
       // be used later for Metadata loading.
       ft.SetID(FeatureID(MwmSet::MwmId(), index));
       toDo(ft, m_table ? index++ : pos);
+    };
+
+    if (m_mappedRecords)
+    {
+      // Mwms are mapped with Advice::Random which turns off the read-ahead of OS,
+      // so we do it here for the sequential scan.
+      uint64_t pos = 0;
+      uint64_t readAheadPos = 0;
+      while (pos < m_mappedRecordsSize)
+      {
+        if (pos >= readAheadPos)
+        {
+          m_recordReader->Prefetch(pos, 2 * kReadAheadSize);
+          readAheadPos = pos + kReadAheadSize;
+        }
+
+        size_t size = 0;
+        uint8_t const * data = GetMappedRecord(pos, size);
+        FeatureType ft(&m_loadInfo, data, size, m_metaDeserializer);
+        process(ft, static_cast<uint32_t>(pos));
+        pos = static_cast<uint64_t>(data + size - m_mappedRecords);
+      }
+      return;
+    }
+
+    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
+    {
+      FeatureType ft(&m_loadInfo, std::move(data), m_metaDeserializer);
+      process(ft, pos);
     });
   }
 
@@ -62,11 +105,20 @@ private:
 
   void InitRecordsReader();
 
+  // Returns the record at |pos| of the mapped features section and sets its |size|.
+  uint8_t const * GetMappedRecord(uint64_t pos, size_t & size) const;
+
+  static uint64_t constexpr kReadAheadSize = 1 << 20;
+
   friend class FeaturesVectorTest;
   using RecordReader = VarRecordReader<FilesContainerR::TReader>;
 
   feature::SharedLoadInfo m_loadInfo;
   std::unique_ptr<RecordReader> m_recordReader;
+  // Features section memory when the container is memory mapped (see MmapReader).
+  // Records are parsed in place then, without copying them to a buffer.
+  uint8_t const * m_mappedRecords = nullptr;
+  uint64_t m_mappedRecordsSize = 0;
   feature::FeaturesOffsetsTable const * m_table;
   indexer::MetadataDeserializer * m_metaDeserializer;
 };
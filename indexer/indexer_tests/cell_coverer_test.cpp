@@ -3,7 +3,9 @@
 #include "geometry/covering_utils.hpp"
 
 #include "indexer/cell_coverer.hpp"
+#include "indexer/feature_covering.hpp"
 #include "indexer/indexer_tests/bounds.hpp"
+#include "indexer/scales.hpp"
 
 #include "coding/hex.hpp"
 
@@ -64,3 +66,34 @@ UNIT_TEST(MaxDepthCoverSpiral)
     TEST_EQUAL(cells[0].Level(), levelMax, ());
   }
 }
+
+UNIT_TEST(CoveringGetter_Cache)
+{
+  using namespace covering;
+  int constexpr kDepthLevels = RectId::DEPTH_LEVELS;
+
+  CoveringCache::Instance().Clear();
+
+  m2::RectD const rect(27.43, 53.83, 27.70, 53.96);
+  int const scale = scales::GetUpperScale();
+
+  Intervals expected;
+  CoverViewportAndAppendLowerLevels<kDepthLevels>(rect, GetCodingDepth<kDepthLevels>(scale),
+                                                  expected);
+
+  CoveringGetter getter1(rect, ViewportWithLowLevels);
+  auto const & intervals = getter1.Get<kDepthLevels>(scale);
+  TEST_EQUAL(intervals, expected, ());
+
+  // Coverings of the same rect are shared.
+  CoveringGetter getter2(rect, ViewportWithLowLevels);
+  TEST_EQUAL(&getter2.Get<kDepthLevels>(scale), &intervals, ());
+
+  CoveringGetter getter3(rect, LowLevelsOnly);
+  TEST_NOT_EQUAL(&getter3.Get<kDepthLevels>(scale), &intervals, ());
+
+  m2::RectD const other(27.43, 53.83, 27.71, 53.96);
+  CoveringGetter getter4(other, ViewportWithLowLevels);
+  TEST_NOT_EQUAL(&getter4.Get<kDepthLevels>(scale), &intervals, ());
+  TEST_NOT_EQUAL(&getter4.Get<kDepthLevels>(scale - 1), &getter4.Get<kDepthLevels>(scale), ());
+}
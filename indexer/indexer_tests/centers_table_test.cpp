@@ -67,6 +67,25 @@ UNIT_CLASS_TEST(CentersTableTest, Smoke)
 
       TEST_LESS_OR_EQUAL(mercator::DistanceOnEarth(actual, expected), 1.0, (id));
     });
+
+    // Every third feature and an id out of the table.
+    vector<uint32_t> ids;
+    for (uint32_t id = 0; id < fv.GetVector().GetNumFeatures(); id += 3)
+      ids.push_back(id);
+    ids.push_back(static_cast<uint32_t>(fv.GetVector().GetNumFeatures()) + 10);
+
+    size_t count = 0;
+    table->ForEachOf(ids, [&](uint32_t id, m2::PointD const & center)
+    {
+      TEST_LESS(count, ids.size(), ());
+      TEST_EQUAL(id, ids[count], ());
+      ++count;
+
+      m2::PointD expected;
+      TEST(table->Get(id, expected), ());
+      TEST_EQUAL(center, expected, (id));
+    });
+    TEST_EQUAL(count, ids.size() - 1, ());
   }
 }
 
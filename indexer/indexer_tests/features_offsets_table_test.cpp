@@ -15,7 +15,9 @@
 
 #include <functional>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 using namespace platform;
 using namespace std;
@@ -65,6 +67,30 @@ namespace feature
     TEST_EQUAL(static_cast<size_t>(7), table->GetFeatureIndexbyOffset(1024), ());
   }
 
+  UNIT_TEST(FeaturesOffsetsTable_RankSelect)
+  {
+    mt19937 rng(0);
+    uniform_int_distribution<uint32_t> gap(1, 3000);
+
+    FeaturesOffsetsTable::Builder builder;
+    vector<uint32_t> offsets;
+    uint32_t offset = 0;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      offset += gap(rng);
+      offsets.push_back(offset);
+      builder.PushOffset(offset);
+    }
+
+    unique_ptr<FeaturesOffsetsTable> table(FeaturesOffsetsTable::Build(builder));
+    TEST_EQUAL(table->size(), offsets.size(), ());
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+      TEST_EQUAL(table->GetFeatureOffset(i), offsets[i], ());
+      TEST_EQUAL(table->GetFeatureIndexbyOffset(offsets[i]), i, ());
+    }
+  }
+
   UNIT_TEST(FeaturesOffsetsTable_ReadWrite)
   {
     string const testFileName = "test_file";
@@ -6,8 +6,13 @@
 
 #include "platform/local_country_file.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/mmap_reader.hpp"
+
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace features_vector_test
@@ -76,4 +81,105 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
   });
   TEST_EQUAL(expected, actual, ());
 }
+UNIT_TEST(FeaturesVectorTest_MappedRecords)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+  string const path = localFile.GetPath(MapFileType::Map);
+
+  // Records of the mapped container are parsed in place, without copying.
+  FeaturesVectorTest copied((FilesContainerR(make_unique<FileReader>(path))));
+  FeaturesVectorTest mapped((FilesContainerR(make_unique<MmapReader>(path))));
+
+  auto const & copiedVector = copied.GetVector();
+  auto const & mappedVector = mapped.GetVector();
+  TEST_EQUAL(copiedVector.GetNumFeatures(), mappedVector.GetNumFeatures(), ());
+  TEST_GREATER(mappedVector.GetNumFeatures(), 0, ());
+
+  vector<string> forEachFeatures;
+  mappedVector.ForEach([&](FeatureType & ft, uint32_t index)
+  {
+    TEST_EQUAL(index, forEachFeatures.size(), ());
+    forEachFeatures.push_back(ft.DebugString());
+  });
+  TEST_EQUAL(forEachFeatures.size(), mappedVector.GetNumFeatures(), ());
+
+  for (uint32_t i = 0; i < mappedVector.GetNumFeatures(); ++i)
+  {
+    auto const expected = copiedVector.GetByIndex(i)->DebugString();
+    TEST_EQUAL(expected, mappedVector.GetByIndex(i)->DebugString(), (i));
+    TEST_EQUAL(expected, forEachFeatures[i], (i));
+  }
+}
+
+UNIT_TEST(FeaturesVectorTest_ForEachByIndexes)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+  string const path = localFile.GetPath(MapFileType::Map);
+
+  FeaturesVectorTest copied((FilesContainerR(make_unique<FileReader>(path))));
+  FeaturesVectorTest mapped((FilesContainerR(make_unique<MmapReader>(path))));
+
+  auto const & featuresVector = copied.GetVector();
+  uint32_t const numFeatures = static_cast<uint32_t>(featuresVector.GetNumFeatures());
+  TEST_GREATER(numFeatures, 100, ());
+
+  // Dense runs of features and single ones far from each other, in reverse order.
+  vector<uint32_t> indexes;
+  for (uint32_t i = numFeatures; i > 0; i -= (i % 7 == 0 ? 50 : 1))
+  {
+    indexes.push_back(i - 1);
+    if (i <= 50)
+      break;
+  }
+
+  for (auto const * fv : {&featuresVector, &mapped.GetVector()})
+  {
+    vector<uint32_t> actualIndexes;
+    fv->ForEachByIndexes(indexes, [&](uint32_t index, FeatureType & ft)
+    {
+      TEST(actualIndexes.empty() || actualIndexes.back() < index, (index));
+      actualIndexes.push_back(index);
+      TEST_EQUAL(ft.DebugString(), featuresVector.GetByIndex(index)->DebugString(), (index));
+    });
+    TEST_EQUAL(actualIndexes.size(), indexes.size(), ());
+  }
+}
+
+UNIT_TEST(FeaturesVectorTest_ConcurrentReaders)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+  string const path = localFile.GetPath(MapFileType::Map);
+
+  FeaturesVectorTest copied((FilesContainerR(make_unique<FileReader>(path))));
+  FeaturesVectorTest mapped((FilesContainerR(make_unique<MmapReader>(path))));
+  TEST(!copied.GetVector().IsThreadSafe(), ());
+  TEST(mapped.GetVector().IsThreadSafe(), ());
+
+  auto const & featuresVector = mapped.GetVector();
+  uint32_t const numFeatures = static_cast<uint32_t>(featuresVector.GetNumFeatures());
+  vector<string> expected(numFeatures);
+  for (uint32_t i = 0; i < numFeatures; ++i)
+    expected[i] = featuresVector.GetByIndex(i)->DebugString();
+
+  // Every thread reads all the features of the same vector, starting from different ones.
+  size_t constexpr kNumThreads = 4;
+  vector<vector<string>> actual(kNumThreads, vector<string>(numFeatures));
+  vector<thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (uint32_t i = 0; i < numFeatures; ++i)
+      {
+        uint32_t const index = static_cast<uint32_t>((i + t * numFeatures / kNumThreads) % numFeatures);
+        actual[t][index] = featuresVector.GetByIndex(index)->DebugString();
+      }
+    });
+  }
+  for (auto & th : threads)
+    th.join();
+
+  for (size_t t = 0; t < kNumThreads; ++t)
+    TEST_EQUAL(expected, actual[t], (t));
+}
 } // namespace features_vector_test
@@ -9,6 +9,8 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -291,3 +293,53 @@ UNIT_TEST(IntervalIndex_Simple5)
     TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
   }
 }
+
+UNIT_TEST(IntervalIndex_ForEachInIntervals)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<uint64_t> keys(0xA0B1000000ULL, 0xA0B2FFFFFFULL);
+
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 5000; ++i)
+    data.emplace_back(keys(rng), i);
+  sort(data.begin(), data.end(), [](auto const & lhs, auto const & rhs)
+  {
+    return make_pair(lhs.m_cell, lhs.m_value) < make_pair(rhs.m_cell, rhs.m_value);
+  });
+
+  vector<char> serialIndex;
+  MemWriter<vector<char> > writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 40);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader, uint32_t> index(reader);
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    vector<uint64_t> bounds;
+    for (size_t i = 0; i < 2 * (test % 20 + 1); ++i)
+      bounds.push_back(keys(rng));
+    sort(bounds.begin(), bounds.end());
+
+    vector<pair<int64_t, int64_t>> intervals;
+    for (size_t i = 0; i < bounds.size(); i += 2)
+      intervals.emplace_back(bounds[i], bounds[i + 1]);
+    if (test % 10 == 0)
+      intervals.emplace_back(0xA0B2FFFFFFULL, 0x20000000000ULL);
+    TEST(IntervalIndexBase::AreSortedAndDisjoint(intervals), ());
+
+    vector<pair<uint64_t, uint32_t>> expected;
+    for (auto const & interval : intervals)
+    {
+      index.ForEach([&](uint64_t key, uint32_t value) { expected.emplace_back(key, value); },
+                    interval.first, interval.second);
+    }
+
+    vector<pair<uint64_t, uint32_t>> actual;
+    index.ForEachInIntervals([&](uint64_t key, uint32_t value) { actual.emplace_back(key, value); },
+                             intervals);
+    TEST_EQUAL(expected, actual, (test));
+  }
+
+  TEST(!IntervalIndexBase::AreSortedAndDisjoint(vector<pair<int64_t, int64_t>>{{0, 10}, {5, 20}}), ());
+  TEST(IntervalIndexBase::AreSortedAndDisjoint(vector<pair<int64_t, int64_t>>{{0, 10}, {10, 20}}), ());
+}
@@ -0,0 +1,46 @@
+#include "testing/testing.hpp"
+
+#include "indexer/isolines_info.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace isolines_info_tests
+{
+using Buffer = std::vector<uint8_t>;
+
+UNIT_TEST(IsolinesInfo_SerDes)
+{
+  isolines::IsolinesInfo info(-20 /* minAltitude */, 3500 /* maxAltitude */, 10 /* altStep */);
+  info.m_minAltClassByZoom = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 500, 100, 50};
+
+  Buffer buffer;
+  {
+    MemWriter<Buffer> writer(buffer);
+    isolines::Serializer serializer(isolines::IsolinesInfo(info));
+    serializer.Serialize(writer);
+  }
+
+  isolines::IsolinesInfo loaded;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    isolines::Deserializer deserializer(loaded);
+    TEST(deserializer.Deserialize(reader), ());
+  }
+
+  TEST_EQUAL(loaded.m_minAltitude, info.m_minAltitude, ());
+  TEST_EQUAL(loaded.m_maxAltitude, info.m_maxAltitude, ());
+  TEST_EQUAL(loaded.m_altStep, info.m_altStep, ());
+  TEST_EQUAL(loaded.m_minAltClassByZoom, info.m_minAltClassByZoom, ());
+
+  TEST_EQUAL(loaded.GetMinAltClass(9), 0, ());
+  TEST_EQUAL(loaded.GetMinAltClass(10), 500, ());
+  TEST_EQUAL(loaded.GetMinAltClass(12), 50, ());
+  // Zooms after the stored ones have no limits.
+  TEST_EQUAL(loaded.GetMinAltClass(13), 0, ());
+  TEST_EQUAL(loaded.GetMinAltClass(19), 0, ());
+}
+}  // namespace isolines_info_tests
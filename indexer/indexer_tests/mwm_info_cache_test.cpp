@@ -0,0 +1,69 @@
+#include "testing/testing.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mwm_info_cache_test
+{
+using namespace std;
+using indexer::MwmInfoCache;
+using platform::LocalCountryFile;
+
+UNIT_TEST(MwmInfoCache_Smoke)
+{
+  string const cachePath = GetPlatform().WritablePathForFile("mwm_info_cache_test.cache");
+  SCOPE_GUARD(deleteCache, [&cachePath]() { FileWriter::DeleteFileX(cachePath); });
+
+  auto const localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  shared_ptr<MwmInfo> expected;
+  {
+    auto cache = make_shared<MwmInfoCache>(cachePath);
+    TEST_EQUAL(cache->GetSize(), 0, ());
+
+    FrozenDataSource dataSource;
+    dataSource.SetInfoCache(cache);
+    auto const res = dataSource.RegisterMap(localFile);
+    TEST_EQUAL(res.second, MwmSet::RegResult::Success, ());
+    expected = res.first.GetInfo();
+
+    TEST_EQUAL(cache->GetSize(), 1, ());
+    TEST(cache->Save(), ());
+  }
+
+  auto cache = make_shared<MwmInfoCache>(cachePath);
+  TEST_EQUAL(cache->GetSize(), 1, ());
+
+  MwmInfoCache::Entry entry;
+  TEST(cache->Get(localFile, entry), ());
+  TEST_EQUAL(entry.m_bordersRect, expected->m_bordersRect, ());
+  TEST_EQUAL(entry.m_minScale, expected->m_minScale, ());
+  TEST_EQUAL(entry.m_maxScale, expected->m_maxScale, ());
+  TEST_EQUAL(entry.m_version.GetFormat(), expected->m_version.GetFormat(), ());
+  TEST_EQUAL(entry.m_version.GetSecondsSinceEpoch(), expected->m_version.GetSecondsSinceEpoch(), ());
+  TEST(entry.m_regionData.Equals(expected->GetRegionData()), ());
+
+  // The map is registered from the cache with the same info.
+  FrozenDataSource dataSource;
+  dataSource.SetInfoCache(cache);
+  auto const res = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(res.second, MwmSet::RegResult::Success, ());
+  auto const & info = *res.first.GetInfo();
+  TEST_EQUAL(info.m_bordersRect, expected->m_bordersRect, ());
+  TEST_EQUAL(info.m_version.GetVersion(), expected->m_version.GetVersion(), ());
+
+  // Unknown maps aren't in the cache.
+  TEST(!cache->Get(LocalCountryFile::MakeForTesting("minsk-pass-unknown"), entry), ());
+}
+}  // namespace mwm_info_cache_test
@@ -8,7 +8,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mwm_set_test
 {
@@ -137,6 +139,104 @@ UNIT_TEST(MwmSetIdTest)
   TEST_EQUAL(MwmInfo::STATUS_DEREGISTERED, id0.GetInfo()->GetStatus(), ());
 }
 
+UNIT_TEST(MwmSetBatchRegisterTest)
+{
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+  ScopedMwm mwm2("2.mwm");
+  ScopedMwm mwm3("3.mwm");
+
+  TestMwmSet mwmSet;
+  TEST_EQUAL(MwmSet::RegResult::Success,
+             mwmSet.Register(LocalCountryFile::MakeForTesting("1")).second, ());
+
+  vector<LocalCountryFile> const files = {
+      LocalCountryFile::MakeForTesting("0"), LocalCountryFile::MakeForTesting("1"),
+      LocalCountryFile::MakeForTesting("2"), LocalCountryFile::MakeForTesting("3")};
+  auto const results = mwmSet.Register(files, 3 /* threadsCount */);
+
+  TEST_EQUAL(results.size(), files.size(), ());
+  TEST_EQUAL(results[0].second, MwmSet::RegResult::Success, ());
+  TEST_EQUAL(results[1].second, MwmSet::RegResult::VersionAlreadyExists, ());
+  TEST_EQUAL(results[2].second, MwmSet::RegResult::Success, ());
+  TEST_EQUAL(results[3].second, MwmSet::RegResult::Success, ());
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    TEST(results[i].first.IsAlive(), (i));
+    TEST_EQUAL(results[i].first.GetInfo()->GetCountryName(), files[i].GetCountryName(), ());
+    TEST_EQUAL(static_cast<size_t>(results[i].first.GetInfo()->m_maxScale), i, ());
+  }
+
+  MwmsInfo mwmsInfo;
+  GetMwmsInfo(mwmSet, mwmsInfo);
+  TestFilesPresence(mwmsInfo, {"0", "1", "2", "3"});
+}
+
+UNIT_TEST(MwmSetCacheLimitsTest)
+{
+  class EvictionsObserver : public MwmSet::Observer
+  {
+  public:
+    void OnValueEvicted(LocalCountryFile const & localFile) override
+    {
+      m_evicted.push_back(localFile.GetCountryName());
+    }
+
+    vector<string> m_evicted;
+  };
+
+  ScopedMwm mwm1("1.mwm");
+  ScopedMwm mwm2("2.mwm");
+  ScopedMwm mwm3("3.mwm");
+
+  TestMwmSet mwmSet;
+  EvictionsObserver observer;
+  TEST(mwmSet.AddObserver(observer), ());
+
+  auto const id1 = mwmSet.Register(LocalCountryFile::MakeForTesting("1")).first;
+  auto const id2 = mwmSet.Register(LocalCountryFile::MakeForTesting("2")).first;
+  auto const id3 = mwmSet.Register(LocalCountryFile::MakeForTesting("3")).first;
+
+  uint64_t valueSize = 0;
+  for (auto const & id : {id1, id2, id3})
+  {
+    auto const handle = mwmSet.GetMwmHandleById(id);
+    TEST(handle.IsAlive(), ());
+    valueSize = handle.GetValue()->GetMemorySize();
+    TEST_GREATER(valueSize, 0, ());
+  }
+
+  auto stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_hits, 0, ());
+  TEST_EQUAL(stats.m_numValues, 3, ());
+  TEST_EQUAL(stats.m_memorySize, 3 * valueSize, ());
+
+  UNUSED_VALUE(mwmSet.GetMwmHandleById(id1));
+  TEST_EQUAL(mwmSet.GetCacheStats().m_hits, 1, ());
+
+  // The value of 1 is the most recently used now, 2 is pinned, so 3 is evicted.
+  mwmSet.Pin(id2);
+  mwmSet.SetCacheMaxBytes(2 * valueSize);
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_evictions, 1, ());
+  TEST_EQUAL(stats.m_numValues, 2, ());
+  TEST_EQUAL(observer.m_evicted, vector<string>({"3"}), ());
+
+  // Pinned values are kept even if they exceed the limit alone.
+  mwmSet.SetCacheMaxBytes(valueSize / 2);
+  TEST_EQUAL(mwmSet.GetCacheStats().m_numValues, 1, ());
+  TEST_EQUAL(observer.m_evicted, vector<string>({"3", "1"}), ());
+
+  mwmSet.Unpin(id2);
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_numValues, 0, ());
+  TEST_EQUAL(stats.m_memorySize, 0, ());
+  TEST_EQUAL(stats.m_evictions, 3, ());
+
+  TEST(mwmSet.RemoveObserver(observer), ());
+}
+
 UNIT_TEST(MwmSetLockAndIdTest)
 {
   ScopedMwm mwm4("4.mwm");
@@ -34,6 +34,19 @@ void TestTable(vector<uint8_t> const & ranks, search::RankTable const & table)
   TEST_EQUAL(table.GetVersion(), search::RankTable::V0, ());
   for (size_t i = 0; i < ranks.size(); ++i)
     TEST_EQUAL(ranks[i], table.Get(i), ());
+
+  // Batch access, including an id out of the table.
+  vector<uint32_t> ids;
+  for (uint32_t i = 0; i < ranks.size(); i += 3)
+    ids.push_back(i);
+  ids.push_back(static_cast<uint32_t>(ranks.size()));
+
+  vector<uint8_t> batchRanks;
+  table.GetRanks(ids, batchRanks);
+  TEST_EQUAL(batchRanks.size(), ids.size(), ());
+  for (size_t i = 0; i + 1 < ids.size(); ++i)
+    TEST_EQUAL(ranks[ids[i]], batchRanks[i], ());
+  TEST_EQUAL(batchRanks.back(), search::RankTable::kNoRank, ());
 }
 
 void TestTable(vector<uint8_t> const & ranks, string const & path)
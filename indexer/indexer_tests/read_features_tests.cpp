@@ -35,3 +35,38 @@ UNIT_TEST(ReadFeatures_Smoke)
     ft1->ForEachType([](auto const /* t */) {});
   }
 }
+
+UNIT_TEST(ReadFeatures_ParsedParts)
+{
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+
+  vector<shared_ptr<MwmInfo>> infos;
+  dataSource.GetMwmsInfo(infos);
+  CHECK_EQUAL(infos.size(), 1, ());
+
+  FeaturesLoaderGuard const guard(dataSource, MwmSet::MwmId(infos[0]));
+  TEST_GREATER(guard.GetNumFeatures(), 0, ());
+
+  feature::ParsedPartsStats stats;
+  for (uint32_t i = 0; i < guard.GetNumFeatures(); ++i)
+  {
+    auto ft = guard.GetFeatureByIndex(i);
+    // Names and types don't need geometry.
+    ft->SetAllowedParts(FeatureType::PART_COMMON);
+    ft->GetReadableName();
+    TEST_EQUAL(ft->GetParsedParts() & ~(FeatureType::PART_TYPES | FeatureType::PART_COMMON), 0, (i));
+    stats.Add(*ft);
+
+    ft->SetAllowedParts(FeatureType::PARTS_ALL);
+    ft->Parse(FeatureType::PART_POINTS | FeatureType::PART_TRIANGLES, FeatureType::BEST_GEOMETRY);
+    TEST_EQUAL(ft->GetParsedParts() & FeatureType::PART_HEADER2, FeatureType::PART_HEADER2, (i));
+  }
+
+  TEST_EQUAL(stats.GetFeaturesCount(), guard.GetNumFeatures(), ());
+  TEST_EQUAL(stats.GetCount(FeatureType::PART_POINTS), 0, ());
+  TEST_EQUAL(stats.GetCount(FeatureType::PART_METADATA), 0, ());
+  LOG(LINFO, (stats));
+}
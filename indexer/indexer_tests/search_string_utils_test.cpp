@@ -2,6 +2,7 @@
 
 #include "indexer/search_string_utils.hpp"
 
+#include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include <string>
@@ -96,6 +97,22 @@ UNIT_TEST(NormalizeAndSimplifyString_WithOurTambourines)
     TEST_EQUAL(arr[i + 1], NormalizeAndSimplifyStringUtf8(arr[i]), ());
 }
 
+UNIT_TEST(NormalizeAndSimplifyString_ASCII)
+{
+  // ASCII strings take a fast path which must be equal to the full pipeline.
+  string ascii;
+  for (int c = 1; c < 0x80; ++c)
+    ascii.push_back(static_cast<char>(c));
+  ascii += "  Double  SPACES ";
+
+  auto expected = MakeLowerCase(MakeUniString(ascii));
+  NormalizeInplace(expected);
+  base::Unique(expected, [](UniChar l, UniChar r) { return l == r && l == ' '; });
+
+  TEST_EQUAL(NormalizeAndSimplifyString(ascii), expected, ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Baker  Street 221B"), "baker street 221b", ());
+}
+
 UNIT_TEST(NormalizeAndSimplifyString_Contains)
 {
   constexpr char const * kTestStr = "ØøÆæŒœ Ўвага!";
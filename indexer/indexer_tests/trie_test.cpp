@@ -1,17 +1,22 @@
 #include "testing/testing.hpp"
 
+#include "indexer/louds_trie.hpp"
 #include "indexer/trie.hpp"
 #include "indexer/trie_builder.hpp"
 #include "indexer/trie_reader.hpp"
 
 #include "coding/byte_stream.hpp"
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
+#include "coding/writer.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -223,4 +228,59 @@ UNIT_TEST(TrieBuilder_Build)
   }
 }
 
+UNIT_TEST(LoudsTrie_Build)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using Value = uint32_t;
+  using KeyValuePair = pair<Key, Value>;
+
+  auto const makeKey = [](strings::UniString const & s) { return Key(s.begin(), s.end()); };
+
+  vector<vector<KeyValuePair>> tests = {
+      {}, {{Key{}, 1}}, {{makeKey(strings::MakeUniString("a")), 2}}};
+
+  vector<KeyValuePair> v;
+  vector<string> const strs = {"", "a", "abc", "abcdefghijabcdefghijabcdefghijabcdefghijabcdefghij",
+                               "abd", "b", "ba", "bab", "zz", "москва", "московский", "мост"};
+  for (size_t i = 0; i < strs.size(); ++i)
+  {
+    auto const key = makeKey(strings::MakeUniString(strs[i]));
+    v.emplace_back(key, static_cast<Value>(i));
+    v.emplace_back(key, static_cast<Value>(i + 100));
+  }
+  tests.push_back(v);
+
+  for (auto const & data : tests)
+  {
+    vector<uint8_t> buf;
+    PushBackByteSink<vector<uint8_t>> sink(buf);
+    SingleValueSerializer<Value> serializer;
+    trie::Build<PushBackByteSink<vector<uint8_t>>, Key, ValueList<Value>,
+                SingleValueSerializer<Value>>(sink, serializer, data);
+    reverse(buf.begin(), buf.end());
+
+    MemReader memReader(buf.data(), buf.size());
+    auto const root = trie::ReadTrie<MemReader, ValueList<Value>>(memReader, serializer);
+
+    vector<uint8_t> loudsBuf;
+    {
+      MemWriter<vector<uint8_t>> writer(loudsBuf);
+      trie::BuildLoudsTrie(writer, serializer, *root);
+    }
+    auto const louds =
+        make_shared<trie::LoudsTrie>(make_unique<CopiedMemoryRegion>(std::move(loudsBuf)));
+    auto const loudsRoot = trie::ReadLoudsTrie<ValueList<Value>>(louds, serializer);
+
+    vector<KeyValuePair> expected;
+    vector<KeyValuePair> actual;
+    trie::ForEachRef(*root, [&](Key const & k, Value const & v) { expected.emplace_back(k, v); },
+                     Key{});
+    trie::ForEachRef(*loudsRoot, [&](Key const & k, Value const & v) { actual.emplace_back(k, v); },
+                     Key{});
+    sort(expected.begin(), expected.end());
+    sort(actual.begin(), actual.end());
+    TEST_EQUAL(expected, actual, ());
+    TEST_EQUAL(expected.size(), data.size(), ());
+  }
+}
 } // namespace trie_test
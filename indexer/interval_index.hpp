@@ -7,7 +7,9 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <utility>
 
 class IntervalIndexBase
 {
@@ -29,6 +31,19 @@ public:
     return 1 << (bitsPerLevel - 3);
   }
 
+  // Returns true if [first, second) |intervals| are sorted and don't intersect,
+  // like the merged covering of a rect.
+  template <typename Intervals>
+  static bool AreSortedAndDisjoint(Intervals const & intervals)
+  {
+    for (size_t i = 1; i < intervals.size(); ++i)
+    {
+      if (intervals[i].first < intervals[i - 1].second)
+        return false;
+    }
+    return true;
+  }
+
   enum { kVersion = 1 };
 };
 
@@ -71,7 +86,147 @@ public:
     }
   }
 
+  // Calls |f| for the keys of all [first, second) |intervals| in one pass over the index:
+  // every node is read once for all the intervals it intersects, instead of reading
+  // the path from the root for every interval. Keys are reported in ascending order.
+  // @precondition AreSortedAndDisjoint(intervals).
+  template <typename F, typename Intervals>
+  void ForEachInIntervals(F const & f, Intervals const & intervals) const
+  {
+    ASSERT(AreSortedAndDisjoint(intervals), ());
+    if (m_Header.m_Levels == 0)
+      return;
+
+    // Clamped intervals with inclusive ends, as in ForEachNode().
+    buffer_vector<std::pair<uint64_t, uint64_t>, 32> inclusive;
+    for (auto const & interval : intervals)
+    {
+      uint64_t const beg = std::min(static_cast<uint64_t>(interval.first), KeyEnd());
+      uint64_t const end = std::min(static_cast<uint64_t>(interval.second), KeyEnd());
+      if (beg < end)
+        inclusive.emplace_back(beg, end - 1);
+    }
+
+    if (inclusive.empty())
+      return;
+
+    ForEachNodeInIntervals(f, inclusive.data(), inclusive.data() + inclusive.size(),
+                           m_Header.m_Levels, 0,
+                           m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels],
+                           0 /* started keyBase */);
+  }
+
 private:
+  using InclusiveInterval = std::pair<uint64_t, uint64_t>;
+
+  // Same as ForEachLeaf() and ForEachNode(), but for the sorted disjoint intervals [first, last)
+  // with absolute inclusive ends, each of which intersects the node.
+  template <typename F>
+  void ForEachLeafInIntervals(F const & f, InclusiveInterval const * first,
+                              InclusiveInterval const * last, uint32_t const offset,
+                              uint32_t const size, uint64_t keyBase) const
+  {
+    buffer_vector<uint8_t, 1024> data;
+    data.resize(size);
+
+    m_Reader.Read(offset, &data[0], size);
+    ArrayByteSource src(&data[0]);
+
+    void const * pEnd = &data[0] + size;
+    Value value = 0;
+    while (src.Ptr() < pEnd)
+    {
+      uint32_t key = 0;
+      src.Read(&key, m_Header.m_LeafBytes);
+      key = SwapIfBigEndianMacroBased(key);
+      value += ReadVarInt<int64_t>(src);
+
+      uint64_t const fullKey = keyBase + key;
+      while (first != last && first->second < fullKey)
+        ++first;
+      if (first == last)
+        break;
+      if (fullKey >= first->first)
+        f(fullKey, value);
+    }
+  }
+
+  template <typename F>
+  void ForEachNodeInIntervals(F const & f, InclusiveInterval const * first,
+                              InclusiveInterval const * last, int level, uint32_t offset,
+                              uint32_t size, uint64_t keyBase) const
+  {
+    ASSERT(size > 0, ());
+    ASSERT(first != last, ());
+    offset += m_LevelOffsets[level];
+
+    if (level == 0)
+    {
+      ForEachLeafInIntervals(f, first, last, offset, size, keyBase);
+      return;
+    }
+
+    uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
+    uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
+
+    buffer_vector<uint8_t, 576> data;
+    data.resize(size);
+
+    m_Reader.Read(offset, &data[0], size);
+    ArrayByteSource src(&data[0]);
+
+    // Recurses to the child |i| with the intervals which intersect it. Returns false when
+    // there are no intervals after the child.
+    auto const processChild = [&](uint32_t i, uint32_t childOffset, uint32_t childSize)
+    {
+      uint64_t const childBeg = keyBase + (uint64_t{i} << skipBits);
+      uint64_t const childEnd = childBeg + levelBytesFF;
+      while (first != last && first->second < childBeg)
+        ++first;
+      if (first == last)
+        return false;
+
+      auto childLast = first;
+      while (childLast != last && childLast->first <= childEnd)
+        ++childLast;
+      if (childLast != first)
+        ForEachNodeInIntervals(f, first, childLast, level - 1, childOffset, childSize, childBeg);
+      return true;
+    };
+
+    uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
+    uint32_t childOffset = offsetAndFlag >> 1;
+    if (offsetAndFlag & 1)
+    {
+      // Reading bitmap.
+      uint8_t const * pBitmap = static_cast<uint8_t const *>(src.Ptr());
+      src.Advance(BitmapSize(m_Header.m_BitsPerLevel));
+      uint32_t const numChildren = 1U << m_Header.m_BitsPerLevel;
+      for (uint32_t i = 0; i < numChildren; ++i)
+      {
+        if (bits::GetBit(pBitmap, i))
+        {
+          uint32_t const childSize = ReadVarUint<uint32_t>(src);
+          if (!processChild(i, childOffset, childSize))
+            break;
+          childOffset += childSize;
+        }
+      }
+    }
+    else
+    {
+      void const * pEnd = &data[0] + size;
+      while (src.Ptr() < pEnd)
+      {
+        uint8_t const i = src.ReadByte();
+        uint32_t const childSize = ReadVarUint<uint32_t>(src);
+        if (!processChild(i, childOffset, childSize))
+          break;
+        childOffset += childSize;
+      }
+    }
+  }
+
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
       uint32_t const offset, uint32_t const size,
@@ -1,11 +1,46 @@
 #include "indexer/isolines_info.hpp"
 
+#include "indexer/classificator.hpp"
 #include "indexer/data_source.hpp"
+#include "indexer/feature_data.hpp"
+
+#include "base/string_utils.hpp"
 
 #include "defines.hpp"
 
+#include <string>
+#include <utility>
+
 namespace isolines
 {
+std::vector<int16_t> const & GetAltClasses()
+{
+  static std::vector<int16_t> const kAltClasses = {1000, 500, 100, 50, 10};
+  return kAltClasses;
+}
+
+int16_t GetAltClass(feature::TypesHolder const & types)
+{
+  static auto const kTypesToClasses = []()
+  {
+    Classificator const & c = classif();
+    std::vector<std::pair<uint32_t, int16_t>> typesToClasses;
+    for (auto const altClass : GetAltClasses())
+    {
+      std::vector<std::string> const path = {"isoline", "step_" + strings::to_string(altClass)};
+      typesToClasses.emplace_back(c.GetTypeByPath(path), altClass);
+    }
+    return typesToClasses;
+  }();
+
+  for (auto const & [type, altClass] : kTypesToClasses)
+  {
+    if (types.Has(type))
+      return altClass;
+  }
+  return 0;
+}
+
 bool LoadIsolinesInfo(DataSource const & dataSource, MwmSet::MwmId const & mwmId,
                       IsolinesInfo & info)
 {
@@ -6,9 +6,16 @@
 #include "coding/write_to_sink.hpp"
 
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 class DataSource;
 
+namespace feature
+{
+class TypesHolder;
+}  // namespace feature
+
 namespace isolines
 {
 enum class Quality
@@ -38,15 +45,34 @@ struct IsolinesInfo
     return isolines::Quality::Normal;
   }
 
+  // Returns the minimal altitude class of the isolines which are drawn on |zoom|,
+  // 0 if all isolines are drawn.
+  int16_t GetMinAltClass(int zoom) const
+  {
+    if (zoom < 0 || static_cast<size_t>(zoom) >= m_minAltClassByZoom.size())
+      return 0;
+    return m_minAltClassByZoom[zoom];
+  }
+
   int16_t m_minAltitude = 0;
   int16_t m_maxAltitude = 0;
   int16_t m_altStep = 0;
+  // Minimal altitude classes by zoom levels, they limit the density of isolines in mountains.
+  std::vector<int16_t> m_minAltClassByZoom;
 };
 
+// Altitude classes of the isoline types "isoline-step_<class>" from the biggest one.
+// An isoline has the biggest class which divides its altitude.
+std::vector<int16_t> const & GetAltClasses();
+
+// Returns the altitude class of an isoline feature, 0 for the zero isoline and non-isolines.
+int16_t GetAltClass(feature::TypesHolder const & types);
+
 enum class Version : uint8_t
 {
   V0 = 0,
-  Latest = V0
+  V1 = 1,  // Minimal altitude classes by zoom levels.
+  Latest = V1
 };
 
 class Serializer
@@ -61,6 +87,11 @@ public:
     WriteToSink(sink, m_info.m_minAltitude);
     WriteToSink(sink, m_info.m_maxAltitude);
     WriteToSink(sink, m_info.m_altStep);
+
+    CHECK_LESS_OR_EQUAL(m_info.m_minAltClassByZoom.size(), std::numeric_limits<uint8_t>::max(), ());
+    WriteToSink(sink, static_cast<uint8_t>(m_info.m_minAltClassByZoom.size()));
+    for (auto const altClass : m_info.m_minAltClassByZoom)
+      WriteToSink(sink, altClass);
   }
 
 private:
@@ -85,6 +116,7 @@ public:
     switch (version)
     {
     case Version::V0: return DeserializeV0(*subReader);
+    case Version::V1: return DeserializeV1(*subReader);
     }
     UNREACHABLE();
 
@@ -99,6 +131,22 @@ private:
     m_info.m_minAltitude = ReadPrimitiveFromSource<int16_t>(source);
     m_info.m_maxAltitude = ReadPrimitiveFromSource<int16_t>(source);
     m_info.m_altStep = ReadPrimitiveFromSource<int16_t>(source);
+    m_info.m_minAltClassByZoom.clear();
+    return true;
+  }
+
+  template<typename Reader>
+  bool DeserializeV1(Reader & reader)
+  {
+    NonOwningReaderSource source(reader);
+    m_info.m_minAltitude = ReadPrimitiveFromSource<int16_t>(source);
+    m_info.m_maxAltitude = ReadPrimitiveFromSource<int16_t>(source);
+    m_info.m_altStep = ReadPrimitiveFromSource<int16_t>(source);
+
+    auto const zoomsCount = ReadPrimitiveFromSource<uint8_t>(source);
+    m_info.m_minAltClassByZoom.resize(zoomsCount);
+    for (auto & altClass : m_info.m_minAltClassByZoom)
+      altClass = ReadPrimitiveFromSource<int16_t>(source);
     return true;
   }
 
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "indexer/trie.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
+#include "coding/succinct_mapper.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "3party/succinct/elias_fano.hpp"
+
+// LOUDS trie format:
+// Nodes are numbered in the level order (breadth-first, the root is 0), so the children of
+// a node have consecutive numbers and the topology of the trie is just the sequence of node
+// degrees (level-order unary degree sequence). Every part is 8-byte aligned and is read right
+// from the memory where the trie lies (see coding::MapVisitor), so nothing but the value lists
+// of the visited nodes is decoded while the trie is walked.
+//
+// [elias-fano: degrees]: i-th number is the sum of degrees of nodes [0, i), i in [0, numNodes]
+// [elias-fano: label offsets]: i-th number is the offset of the i-th node label in [labels]
+// [labels]: label of the edge to the node, every char is encoded as varint difference from
+//           the previous char, the first one - from kDefaultChar, the label of the root is empty
+// [elias-fano: value offsets]: i-th number is the offset of the i-th node values in [values]
+// [values]: value list of the node as written by ValueList::Serialize, may be empty
+
+namespace trie
+{
+class LoudsTrie
+{
+public:
+  using Bytes = succinct::mapper::mappable_vector<uint8_t>;
+
+  // Maps the trie from |region|, which is kept by the trie. The region must be 8-byte aligned.
+  explicit LoudsTrie(std::unique_ptr<MemoryRegion> && region) : m_region(std::move(region))
+  {
+    CHECK(m_region, ());
+    CHECK(coding::IsAlign8(reinterpret_cast<uint64_t>(m_region->ImmutableData())), ());
+    coding::MapVisitor visitor(m_region->ImmutableData());
+    map(visitor);
+    CHECK_LESS_OR_EQUAL(visitor.BytesRead(), m_region->Size(), ());
+    CHECK_GREATER(m_degrees.num_ones(), 1, ());
+    CHECK_EQUAL(m_degrees.num_ones(), m_labelOffsets.num_ones(), ());
+    CHECK_EQUAL(m_degrees.num_ones(), m_valueOffsets.num_ones(), ());
+  }
+
+  // Used by the builder: all the sequences have (numNodes + 1) elements.
+  LoudsTrie(std::vector<uint64_t> const & degrees, std::vector<uint64_t> const & labelOffsets,
+            std::vector<uint8_t> && labels, std::vector<uint64_t> const & valueOffsets,
+            std::vector<uint8_t> && values)
+    : m_degrees(BuildEliasFano(degrees))
+    , m_labelOffsets(BuildEliasFano(labelOffsets))
+    , m_valueOffsets(BuildEliasFano(valueOffsets))
+  {
+    m_labels.steal(labels);
+    m_values.steal(values);
+  }
+
+  uint32_t GetNumNodes() const
+  {
+    return base::asserted_cast<uint32_t>(m_degrees.num_ones() - 1);
+  }
+
+  // Returns the range [first, last) of the |node| children.
+  std::pair<uint32_t, uint32_t> GetChildren(uint32_t node) const
+  {
+    ASSERT_LESS(node, GetNumNodes(), ());
+    // The root is not a child of any node, so the children numbers are shifted by one.
+    return {static_cast<uint32_t>(m_degrees.select(node) + 1),
+            static_cast<uint32_t>(m_degrees.select(node + 1) + 1)};
+  }
+
+  template <typename Label>
+  void GetLabel(uint32_t node, Label & label) const
+  {
+    ASSERT_LESS(node, GetNumNodes(), ());
+    label.clear();
+
+    auto const begin = m_labelOffsets.select(node);
+    auto const end = m_labelOffsets.select(node + 1);
+    ArrayByteSource source(m_labels.data() + begin);
+    TrieChar c = kDefaultChar;
+    while (source.PtrUint8() < m_labels.data() + end)
+    {
+      c += ReadVarInt<int32_t>(source);
+      label.push_back(c);
+    }
+  }
+
+  // Returns the serialized value list of |node|, it's empty when the node has no values.
+  MemReader GetValues(uint32_t node) const
+  {
+    ASSERT_LESS(node, GetNumNodes(), ());
+    auto const begin = m_valueOffsets.select(node);
+    auto const end = m_valueOffsets.select(node + 1);
+    return MemReader(m_values.data() + begin, static_cast<size_t>(end - begin));
+  }
+
+  template <typename Sink>
+  void Freeze(Sink & sink)
+  {
+    coding::FreezeVisitor<Sink> visitor(sink);
+    map(visitor);
+  }
+
+  template <typename Visitor>
+  void map(Visitor & visitor)
+  {
+    visitor(m_degrees, "degrees")(m_labelOffsets, "labelOffsets")(m_labels, "labels")(
+        m_valueOffsets, "valueOffsets")(m_values, "values");
+  }
+
+private:
+  static succinct::elias_fano BuildEliasFano(std::vector<uint64_t> const & sequence)
+  {
+    CHECK(!sequence.empty(), ());
+    succinct::elias_fano::elias_fano_builder builder(sequence.back(), sequence.size());
+    for (auto const v : sequence)
+      builder.push_back(v);
+    return succinct::elias_fano(&builder, false /* with_rank_index */);
+  }
+
+  std::unique_ptr<MemoryRegion> m_region;
+
+  succinct::elias_fano m_degrees;
+  succinct::elias_fano m_labelOffsets;
+  Bytes m_labels;
+  succinct::elias_fano m_valueOffsets;
+  Bytes m_values;
+
+  DISALLOW_COPY_AND_MOVE(LoudsTrie);
+};
+
+template <typename ValueList, typename Serializer>
+class LoudsIterator final : public Iterator<ValueList>
+{
+public:
+  using Iterator<ValueList>::m_values;
+  using Iterator<ValueList>::m_edges;
+
+  LoudsIterator(std::shared_ptr<LoudsTrie const> trie, uint32_t node, Serializer const & serializer)
+    : m_trie(std::move(trie)), m_serializer(serializer)
+  {
+    auto const [first, last] = m_trie->GetChildren(node);
+    m_firstChild = first;
+    m_edges.resize(last - first);
+    for (uint32_t i = first; i < last; ++i)
+      m_trie->GetLabel(i, m_edges[i - first].m_label);
+
+    auto const values = m_trie->GetValues(node);
+    ReaderSource<MemReader> source(values);
+    m_values.Deserialize(source, m_serializer);
+  }
+
+  ~LoudsIterator() override = default;
+
+  // trie::Iterator overrides:
+  std::unique_ptr<Iterator<ValueList>> Clone() const override
+  {
+    return std::make_unique<LoudsIterator<ValueList, Serializer>>(*this);
+  }
+
+  std::unique_ptr<Iterator<ValueList>> GoToEdge(size_t i) const override
+  {
+    ASSERT_LESS(i, m_edges.size(), ());
+    return std::make_unique<LoudsIterator<ValueList, Serializer>>(
+        m_trie, m_firstChild + static_cast<uint32_t>(i), m_serializer);
+  }
+
+private:
+  std::shared_ptr<LoudsTrie const> m_trie;
+  uint32_t m_firstChild = 0;
+  Serializer m_serializer;
+};
+
+// Returns iterator to the root of the trie.
+template <class ValueList, class Serializer>
+std::unique_ptr<Iterator<ValueList>> ReadLoudsTrie(std::shared_ptr<LoudsTrie const> trie,
+                                                   Serializer const & serializer)
+{
+  return std::make_unique<LoudsIterator<ValueList, Serializer>>(std::move(trie), 0 /* node */,
+                                                                serializer);
+}
+
+// Writes the trie with |root| in the LOUDS format. The trie is traversed in the level order,
+// so the iterators of a whole level are kept in memory. |sink| must be 8-byte aligned.
+template <typename Sink, typename ValueList, typename Serializer>
+void BuildLoudsTrie(Sink & sink, Serializer const & serializer, Iterator<ValueList> const & root)
+{
+  std::vector<uint64_t> degrees = {0};
+  std::vector<uint64_t> labelOffsets = {0, 0};
+  std::vector<uint64_t> valueOffsets = {0};
+  std::vector<uint8_t> labels;
+  std::vector<uint8_t> values;
+  MemWriter<std::vector<uint8_t>> labelsWriter(labels);
+  MemWriter<std::vector<uint8_t>> valuesWriter(values);
+
+  // Nodes of the current and the next levels in the level order.
+  std::vector<std::unique_ptr<Iterator<ValueList>>> level;
+  std::vector<std::unique_ptr<Iterator<ValueList>>> nextLevel;
+  level.push_back(root.Clone());
+  while (!level.empty())
+  {
+    for (auto & node : level)
+    {
+      node->m_values.Serialize(valuesWriter, serializer);
+      valueOffsets.push_back(values.size());
+
+      auto const & edges = node->m_edges;
+      degrees.push_back(degrees.back() + edges.size());
+      for (size_t i = 0; i < edges.size(); ++i)
+      {
+        auto const & label = edges[i].m_label;
+        CHECK(!label.empty(), ());
+        TrieChar prev = kDefaultChar;
+        for (auto const c : label)
+        {
+          WriteVarInt(labelsWriter, static_cast<int32_t>(c - prev));
+          prev = c;
+        }
+        labelOffsets.push_back(labels.size());
+        nextLevel.push_back(node->GoToEdge(i));
+      }
+      node.reset();
+    }
+    level.swap(nextLevel);
+    nextLevel.clear();
+  }
+
+  LoudsTrie trie(degrees, labelOffsets, std::move(labels), valueOffsets, std::move(values));
+  trie.Freeze(sink);
+}
+}  // namespace trie
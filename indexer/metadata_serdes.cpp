@@ -33,12 +33,21 @@ bool MetadataDeserializer::Get(uint32_t featureId, feature::MetadataBase & meta)
   if (!GetIds(featureId, metaIds))
     return false;
 
-  lock_guard<mutex> guard(m_stringsMutex);
+  vector<size_t> stringIds;
+  stringIds.reserve(metaIds.size());
   for (auto const & id : metaIds)
+    stringIds.push_back(id.second);
+
+  vector<string> values;
   {
-    CHECK_LESS_OR_EQUAL(id.second, m_strings.GetNumStrings(), ());
-    meta.Set(id.first, m_strings.ExtractString(*m_stringsSubreader, id.second));
+    lock_guard<mutex> guard(m_stringsMutex);
+    for (auto const id : stringIds)
+      CHECK_LESS_OR_EQUAL(id, m_strings.GetNumStrings(), ());
+    values = m_strings.ExtractStrings(*m_stringsSubreader, stringIds);
   }
+
+  for (size_t i = 0; i < metaIds.size(); ++i)
+    meta.Set(metaIds[i].first, std::move(values[i]));
   return true;
 }
 
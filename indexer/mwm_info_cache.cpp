@@ -0,0 +1,197 @@
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <cstring>
+
+namespace indexer
+{
+namespace
+{
+// Increment when the format of the entries changes, old caches are dropped then.
+uint8_t constexpr kVersion = 0;
+
+template <typename Sink>
+void WriteDouble(Sink & sink, double d)
+{
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(d));
+  std::memcpy(&bits, &d, sizeof(d));
+  WriteToSink(sink, bits);
+}
+
+template <typename Source>
+double ReadDouble(Source & src)
+{
+  auto const bits = ReadPrimitiveFromSource<uint64_t>(src);
+  double d;
+  std::memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+}  // namespace
+
+MwmInfoCache::MwmInfoCache(std::string const & path) : m_path(path)
+{
+  if (!Platform::IsFileExistsByFullPath(m_path))
+    return;
+
+  try
+  {
+    Load();
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Can't load mwm info cache", m_path, ex.Msg()));
+    m_items.clear();
+  }
+}
+
+bool MwmInfoCache::Get(platform::LocalCountryFile const & localFile, Entry & entry) const
+{
+  auto const path = localFile.GetPath(MapFileType::Map);
+  FileStamp stamp;
+  if (!GetStamp(path, stamp))
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_items.find(path);
+  if (it == m_items.end() || !(it->second.m_stamp == stamp))
+    return false;
+
+  entry = it->second.m_entry;
+  if (!it->second.m_used)
+  {
+    it->second.m_used = true;
+    m_changed = true;
+  }
+  return true;
+}
+
+void MwmInfoCache::Put(platform::LocalCountryFile const & localFile, Entry const & entry)
+{
+  auto const path = localFile.GetPath(MapFileType::Map);
+  FileStamp stamp;
+  if (!GetStamp(path, stamp))
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_items[path] = {stamp, entry, true /* used */};
+  m_changed = true;
+}
+
+bool MwmInfoCache::Save()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_changed)
+    return true;
+
+  std::string const tmpPath = m_path + EXTENSION_TMP;
+  try
+  {
+    {
+      FileWriter writer(tmpPath);
+      WriteToSink(writer, kVersion);
+
+      uint32_t count = 0;
+      for (auto const & item : m_items)
+      {
+        if (item.second.m_used)
+          ++count;
+      }
+      WriteVarUint(writer, count);
+
+      for (auto const & [path, item] : m_items)
+      {
+        if (!item.m_used)
+          continue;
+
+        rw::Write(writer, path);
+        WriteToSink(writer, item.m_stamp.m_size);
+        WriteToSink(writer, item.m_stamp.m_modificationTime);
+
+        auto const & entry = item.m_entry;
+        WriteDouble(writer, entry.m_bordersRect.minX());
+        WriteDouble(writer, entry.m_bordersRect.minY());
+        WriteDouble(writer, entry.m_bordersRect.maxX());
+        WriteDouble(writer, entry.m_bordersRect.maxY());
+        WriteToSink(writer, entry.m_minScale);
+        WriteToSink(writer, entry.m_maxScale);
+        WriteToSink(writer, static_cast<int8_t>(entry.m_version.GetFormat()));
+        WriteToSink(writer, entry.m_version.GetSecondsSinceEpoch());
+        entry.m_regionData.Serialize(writer);
+      }
+    }
+
+    if (!base::RenameFileX(tmpPath, m_path))
+      return false;
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Can't save mwm info cache", m_path, ex.Msg()));
+    return false;
+  }
+
+  m_changed = false;
+  return true;
+}
+
+size_t MwmInfoCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_items.size();
+}
+
+// static
+bool MwmInfoCache::GetStamp(std::string const & path, FileStamp & stamp)
+{
+  if (!Platform::GetFileSizeByFullPath(path, stamp.m_size))
+    return false;
+  stamp.m_modificationTime = static_cast<int64_t>(Platform::GetFileModificationTime(path));
+  return true;
+}
+
+void MwmInfoCache::Load()
+{
+  FileReader reader(m_path);
+  ReaderSource<FileReader> src(reader);
+  if (ReadPrimitiveFromSource<uint8_t>(src) != kVersion)
+    return;
+
+  auto const count = ReadVarUint<uint32_t>(src);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    std::string path;
+    rw::Read(src, path);
+
+    Item item;
+    item.m_stamp.m_size = ReadPrimitiveFromSource<uint64_t>(src);
+    item.m_stamp.m_modificationTime = ReadPrimitiveFromSource<int64_t>(src);
+
+    auto & entry = item.m_entry;
+    double const minX = ReadDouble(src);
+    double const minY = ReadDouble(src);
+    double const maxX = ReadDouble(src);
+    double const maxY = ReadDouble(src);
+    entry.m_bordersRect = m2::RectD(minX, minY, maxX, maxY);
+    entry.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+    entry.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+    entry.m_version.SetFormat(static_cast<version::Format>(ReadPrimitiveFromSource<int8_t>(src)));
+    entry.m_version.SetSecondsSinceEpoch(ReadPrimitiveFromSource<uint64_t>(src));
+    entry.m_regionData.Deserialize(src);
+
+    m_items.emplace(std::move(path), std::move(item));
+  }
+}
+}  // namespace indexer
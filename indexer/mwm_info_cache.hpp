@@ -0,0 +1,76 @@
+#pragma once
+
+#include "indexer/feature_meta.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/mwm_version.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace indexer
+{
+// Persistent cache of the mwm data which is needed to register an mwm (see
+// DataSource::CreateInfo), so registration of an unchanged mwm doesn't open its container.
+// An entry is valid while size and modification time of the mwm file are the same.
+// The class is thread-safe.
+class MwmInfoCache
+{
+public:
+  struct Entry
+  {
+    m2::RectD m_bordersRect;
+    uint8_t m_minScale = 0;
+    uint8_t m_maxScale = 0;
+    version::MwmVersion m_version;
+    feature::RegionData m_regionData;
+  };
+
+  // Loads the cache from |path|, a missing or broken file gives an empty cache.
+  explicit MwmInfoCache(std::string const & path);
+
+  // Returns false when there is no valid entry for |localFile|.
+  bool Get(platform::LocalCountryFile const & localFile, Entry & entry) const;
+  void Put(platform::LocalCountryFile const & localFile, Entry const & entry);
+
+  // Writes the entries which were got or put since loading, so entries of removed mwms
+  // are dropped. Does nothing when the cache is not changed.
+  bool Save();
+
+  size_t GetSize() const;
+
+private:
+  struct FileStamp
+  {
+    bool operator==(FileStamp const & rhs) const
+    {
+      return m_size == rhs.m_size && m_modificationTime == rhs.m_modificationTime;
+    }
+
+    uint64_t m_size = 0;
+    int64_t m_modificationTime = 0;
+  };
+
+  struct Item
+  {
+    FileStamp m_stamp;
+    Entry m_entry;
+    bool m_used = false;
+  };
+
+  static bool GetStamp(std::string const & path, FileStamp & stamp);
+
+  void Load();
+
+  std::string const m_path;
+
+  mutable std::mutex m_mutex;
+  // Full path of mwm file -> item.
+  mutable std::map<std::string, Item> m_items;
+  mutable bool m_changed = false;
+};
+}  // namespace indexer
@@ -3,14 +3,18 @@
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 
+#include "platform/constants.hpp"
 #include "platform/local_country_file_utils.hpp"
 
 #include "base/assert.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
+#include "base/math.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
 #include <exception>
@@ -21,7 +25,10 @@ using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+MwmInfo::MwmInfo()
+  : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0), m_numPins(0)
+{
+}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -98,52 +105,98 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile)
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const & localFile)
 {
   pair<MwmSet::MwmId, MwmSet::RegResult> result;
-  auto registerFile = [&](EventList & events)
+  WithEventLog([&](EventList & events) { result = RegisterOrUpdateImpl(localFile, nullptr, events); });
+  return result;
+}
+
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> MwmSet::Register(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  // Opening of the files is the expensive part of registration, so infos are created in
+  // parallel without the lock.
+  vector<shared_ptr<MwmInfo>> infos(localFiles.size());
+  vector<RegResult> errors(localFiles.size(), RegResult::Success);
+  atomic<size_t> next(0);
+  auto const createInfos = [&]()
   {
-    CountryFile const & countryFile = localFile.GetCountryFile();
-    MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
-    if (!id.IsAlive())
+    for (size_t i = next++; i < localFiles.size(); i = next++)
     {
-      result = RegisterImpl(localFile, events);
-      return;
+      try
+      {
+        infos[i] = CreateInfo(localFiles[i]);
+        if (!infos[i])
+          errors[i] = RegResult::UnsupportedFileFormat;
+      }
+      catch (RootException const & ex)
+      {
+        LOG(LERROR, ("IO error while adding", localFiles[i].GetCountryName(), "map.", ex.Msg()));
+        errors[i] = RegResult::BadFile;
+      }
     }
+  };
 
-    shared_ptr<MwmInfo> info = id.GetInfo();
+  threadsCount = base::Clamp(threadsCount, size_t(1), max(localFiles.size(), size_t(1)));
+  vector<threads::SimpleThread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(createInfos);
+  createInfos();
+  for (auto & thread : threads)
+    thread.join();
 
-    // Deregister old mwm for the country.
-    if (info->GetVersion() < localFile.GetVersion())
+  // All the files are registered under one lock and observers get one batch of events.
+  vector<pair<MwmId, RegResult>> results(localFiles.size());
+  WithEventLog([&](EventList & events)
+  {
+    for (size_t i = 0; i < localFiles.size(); ++i)
     {
-      DeregisterImpl(id, events);
-      result = RegisterImpl(localFile, events);
-      return;
+      if (errors[i] != RegResult::Success)
+        results[i] = make_pair(MwmId(), errors[i]);
+      else
+        results[i] = RegisterOrUpdateImpl(localFiles[i], std::move(infos[i]), events);
     }
+  });
+  return results;
+}
 
-    string const name = countryFile.GetName();
-    // Update the status of the mwm with the same version.
-    if (info->GetVersion() == localFile.GetVersion())
-    {
-      LOG(LINFO, ("Updating already registered mwm:", name));
-      SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-      info->m_file = localFile;
-      result = make_pair(id, RegResult::VersionAlreadyExists);
-      return;
-    }
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterOrUpdateImpl(
+    LocalCountryFile const & localFile, shared_ptr<MwmInfo> info, EventList & events)
+{
+  CountryFile const & countryFile = localFile.GetCountryFile();
+  MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+  if (!id.IsAlive())
+    return RegisterImpl(localFile, std::move(info), events);
 
-    LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
-                   "), current version:", info->GetVersion()));
-    result = make_pair(MwmId(), RegResult::VersionTooOld);
-    return;
-  };
+  shared_ptr<MwmInfo> const & registeredInfo = id.GetInfo();
 
-  WithEventLog(registerFile);
-  return result;
+  // Deregister old mwm for the country.
+  if (registeredInfo->GetVersion() < localFile.GetVersion())
+  {
+    DeregisterImpl(id, events);
+    return RegisterImpl(localFile, std::move(info), events);
+  }
+
+  string const name = countryFile.GetName();
+  // Update the status of the mwm with the same version.
+  if (registeredInfo->GetVersion() == localFile.GetVersion())
+  {
+    LOG(LINFO, ("Updating already registered mwm:", name));
+    SetStatus(*registeredInfo, MwmInfo::STATUS_REGISTERED, events);
+    registeredInfo->m_file = localFile;
+    return make_pair(id, RegResult::VersionAlreadyExists);
+  }
+
+  LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
+                 "), current version:", registeredInfo->GetVersion()));
+  return make_pair(MwmId(), RegResult::VersionTooOld);
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile const & localFile,
+                                                            shared_ptr<MwmInfo> info,
                                                             EventList & events)
 {
   // This function can throw an exception for a bad mwm file.
-  shared_ptr<MwmInfo> info(CreateInfo(localFile));
+  if (!info)
+    info = CreateInfo(localFile);
   if (!info)
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
@@ -167,9 +220,9 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
     for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
     {
-      if (it->first == id)
+      if (it->m_id == id)
       {
-        m_cache.erase(it);
+        ClearCacheImpl(it, next(it));
         break;
       }
     }
@@ -251,6 +304,9 @@ void MwmSet::ProcessEventList(EventList & events)
     case Event::TYPE_DEREGISTERED:
       m_observers.ForEach(&Observer::OnMapDeregistered, event.m_file);
       break;
+    case Event::TYPE_EVICTED:
+      m_observers.ForEach(&Observer::OnValueEvicted, event.m_file);
+      break;
     }
   }
 }
@@ -281,14 +337,17 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
   // Search in cache.
   for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
   {
-    if (it->first == id)
+    if (it->m_id == id)
     {
-      unique_ptr<MwmValue> result = std::move(it->second);
+      unique_ptr<MwmValue> result = std::move(it->m_value);
+      m_cacheStats.m_memorySize -= it->m_memorySize;
       m_cache.erase(it);
+      ++m_cacheStats.m_hits;
       return result;
     }
   }
 
+  ++m_cacheStats.m_misses;
   try
   {
     return CreateValue(*info);
@@ -335,16 +394,77 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, EventList
     /// @todo Probably, it's better to store only "unique by id" free caches here.
     /// But it's no obvious if we have many threads working with the single mwm.
 
-    m_cache.push_back(make_pair(id, std::move(p)));
-    if (m_cache.size() > m_cacheSize)
+    // The memory size is taken on unlock, so the tables loaded by the handle are counted.
+    auto const memorySize = p->GetMemorySize();
+    m_cache.push_back({id, std::move(p), memorySize});
+    m_cacheStats.m_memorySize += memorySize;
+    EvictImpl(events);
+  }
+}
+
+void MwmSet::EvictImpl(EventList & events)
+{
+  auto const exceedsLimits = [this]() {
+    return m_cache.size() > m_cacheSize ||
+           (m_cacheMaxBytes != 0 && m_cacheStats.m_memorySize > m_cacheMaxBytes);
+  };
+
+  for (auto it = m_cache.begin(); it != m_cache.end() && exceedsLimits();)
+  {
+    auto const & info = it->m_id.GetInfo();
+    if (info->m_numPins != 0)
     {
-      LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", m_cache.front().first));
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
+      ++it;
+      continue;
     }
+
+    LOG(LDEBUG, ("MwmValue cache limits reached, removed", it->m_id));
+    events.Add(Event(Event::TYPE_EVICTED, info->GetLocalFile()));
+    ++m_cacheStats.m_evictions;
+    m_cacheStats.m_memorySize -= it->m_memorySize;
+    it = m_cache.erase(it);
   }
 }
 
+void MwmSet::SetCacheMaxBytes(uint64_t maxBytes)
+{
+  WithEventLog([&](EventList & events)
+               {
+                 m_cacheMaxBytes = maxBytes;
+                 EvictImpl(events);
+               });
+}
+
+MwmSet::CacheStats MwmSet::GetCacheStats() const
+{
+  lock_guard<mutex> lock(m_lock);
+  auto stats = m_cacheStats;
+  stats.m_numValues = m_cache.size();
+  return stats;
+}
+
+void MwmSet::Pin(MwmId const & id)
+{
+  lock_guard<mutex> lock(m_lock);
+  if (id.IsAlive())
+    ++id.GetInfo()->m_numPins;
+}
+
+void MwmSet::Unpin(MwmId const & id)
+{
+  WithEventLog([&](EventList & events)
+               {
+                 auto const & info = id.GetInfo();
+                 if (!info)
+                   return;
+                 ASSERT_GREATER(info->m_numPins, 0, ());
+                 if (info->m_numPins == 0)
+                   return;
+                 --info->m_numPins;
+                 EvictImpl(events);
+               });
+}
+
 void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
@@ -392,13 +512,18 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & eve
   return MwmHandle(*this, id, std::move(value));
 }
 
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
+void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end)
+{
+  for (auto it = beg; it != end; ++it)
+    m_cacheStats.m_memorySize -= it->m_memorySize;
+  m_cache.erase(beg, end);
+}
 
 void MwmSet::ClearCache(MwmId const & id)
 {
-  auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmValue>> const & p)
+  auto sameId = [&id](CacheEntry const & entry)
   {
-    return (p.first == id);
+    return (entry.m_id == id);
   };
   ClearCacheImpl(base::RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
 }
@@ -411,6 +536,23 @@ MwmValue::MwmValue(LocalCountryFile const & localFile)
   m_factory.Load(m_cont);
 }
 
+uint64_t MwmValue::GetMemorySize() const
+{
+  uint64_t size = sizeof(MwmValue);
+
+  // MmapReader has no cache, the mapped pages are managed by OS.
+  if (!m_cont.IsExist(HEADER_FILE_TAG) ||
+      dynamic_cast<MmapReader const *>(m_cont.GetReader(HEADER_FILE_TAG).GetPtr()) == nullptr)
+  {
+    size += (uint64_t{1} << READER_CHUNK_LOG_SIZE) << READER_CHUNK_LOG_COUNT;
+  }
+
+  // The table is shared by the values of the mwm, but it's kept while any of them is alive.
+  if (m_table)
+    size += m_table->byte_size();
+  return size;
+}
+
 void MwmValue::SetTable(MwmInfoEx & info)
 {
   m_table = info.m_table.lock();
@@ -445,6 +587,7 @@ string DebugPrint(MwmSet::Event::Type type)
   {
     case MwmSet::Event::TYPE_REGISTERED: return "Registered";
     case MwmSet::Event::TYPE_DEREGISTERED: return "Deregistered";
+    case MwmSet::Event::TYPE_EVICTED: return "Evicted";
   }
   return "Undefined";
 }
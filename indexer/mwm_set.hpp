@@ -22,6 +22,7 @@
 #include <vector>
 
 namespace feature { class FeaturesOffsetsTable; }
+namespace trie { class LoudsTrie; }
 
 /// Information about stored mwm.
 class MwmInfo
@@ -89,6 +90,7 @@ protected:
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
   uint32_t m_numRefs;                 ///< Number of active handles.
+  uint32_t m_numPins;                 ///< Number of MwmSet::Pin() calls without Unpin().
 };
 
 class MwmInfoEx : public MwmInfo
@@ -138,7 +140,12 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize) {}
+  // Unlocked values are cached while there are at most |cacheSize| of them and, when
+  // |cacheMaxBytes| is not zero, while their memory size is at most |cacheMaxBytes|.
+  explicit MwmSet(size_t cacheSize = 64, uint64_t cacheMaxBytes = 0)
+    : m_cacheSize(cacheSize), m_cacheMaxBytes(cacheMaxBytes)
+  {
+  }
   virtual ~MwmSet() = default;
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -176,6 +183,7 @@ public:
     {
       TYPE_REGISTERED,
       TYPE_DEREGISTERED,
+      TYPE_EVICTED,
     };
 
     Event() = default;
@@ -244,6 +252,21 @@ public:
 
     // Called when a map is deregistered and can no longer be used.
     virtual void OnMapDeregistered(platform::LocalCountryFile const & /* localFile */) {}
+
+    // Called when an unlocked value of a map is removed from the cache to fit its limits.
+    virtual void OnValueEvicted(platform::LocalCountryFile const & /* localFile */) {}
+  };
+
+  struct CacheStats
+  {
+    // Numbers of values taken from the cache and created for new handles.
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    // Number of values removed from the cache to fit its limits.
+    uint64_t m_evictions = 0;
+
+    size_t m_numValues = 0;
+    uint64_t m_memorySize = 0;
   };
 
   /// Registers a new map.
@@ -254,11 +277,21 @@ public:
   /// are older than the localFile (in this case mwm handle will point
   /// to just-registered file).
 protected:
+  // Registers |localFile| or updates its registered version. |info| is created when it's null.
+  std::pair<MwmId, RegResult> RegisterOrUpdateImpl(platform::LocalCountryFile const & localFile,
+                                                   std::shared_ptr<MwmInfo> info, EventList & events);
   std::pair<MwmId, RegResult> RegisterImpl(platform::LocalCountryFile const & localFile,
-                                           EventList & events);
+                                           std::shared_ptr<MwmInfo> info, EventList & events);
 
 public:
   std::pair<MwmId, RegResult> Register(platform::LocalCountryFile const & localFile);
+
+  /// Registers |localFiles| at once, results go in the same order. Files are opened by
+  /// |threadsCount| threads and observers get all the events as one batch after that.
+  /// Unlike the single file version, bad files are reported as RegResult::BadFile
+  /// instead of exceptions.
+  std::vector<std::pair<MwmId, RegResult>> Register(
+      std::vector<platform::LocalCountryFile> const & localFiles, size_t threadsCount);
   //@}
 
   /// @name Remove mwm.
@@ -295,6 +328,17 @@ public:
 
   void ClearCache();
 
+  // Sets the limit of the memory size of the cached values, zero means no limit.
+  // The least recently used values are evicted first.
+  void SetCacheMaxBytes(uint64_t maxBytes);
+
+  CacheStats GetCacheStats() const;
+
+  // Values of a pinned mwm are never evicted from the cache, even when it exceeds its limits.
+  // Pins are counted, so every Pin() must be followed by Unpin().
+  void Pin(MwmId const & id);
+  void Unpin(MwmId const & id);
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -314,7 +358,15 @@ protected:
   virtual std::unique_ptr<MwmValue> CreateValue(MwmInfo & info) const = 0;
 
 private:
-  using Cache = std::deque<std::pair<MwmId, std::unique_ptr<MwmValue>>>;
+  struct CacheEntry
+  {
+    MwmId m_id;
+    std::unique_ptr<MwmValue> m_value;
+    uint64_t m_memorySize = 0;
+  };
+
+  // The least recently unlocked values are at the front.
+  using Cache = std::deque<CacheEntry>;
 
   // This is the only valid way to take |m_lock| and use *Impl()
   // functions. The reason is that event processing requires
@@ -352,8 +404,14 @@ private:
   /// @precondition This function is always called under mutex m_lock.
   void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
 
+  /// Evicts unpinned values from the front of the cache while it exceeds its limits.
+  /// @precondition This function is always called under mutex m_lock.
+  void EvictImpl(EventList & events);
+
   Cache m_cache;
   size_t const m_cacheSize;
+  uint64_t m_cacheMaxBytes;
+  CacheStats m_cacheStats;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -381,10 +439,15 @@ public:
   std::shared_ptr<feature::FeaturesOffsetsTable> m_table;
   std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
   std::unique_ptr<HouseToStreetTable> m_house2street, m_house2place;
+  // Search index of the LOUDS format, it's loaded on the first search in the mwm.
+  std::shared_ptr<trie::LoudsTrie const> m_searchTrie;
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
 
+  // Approximate memory used by the value: reader caches and loaded tables.
+  uint64_t GetMemorySize() const;
+
   feature::DataHeader const & GetHeader() const  { return m_factory.GetHeader(); }
   feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -6,6 +6,7 @@
 #include "coding/var_serial_vector.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -63,6 +64,29 @@ public:
     }
   }
 
+  // Calls |fn| for the features in all the [first, second) |intervals| visible at |scale|.
+  // When the intervals are sorted and disjoint, every node of the indexes is read once for
+  // all of them and features come bucket by bucket, otherwise interval by interval
+  // in the order of |intervals|.
+  template <typename Intervals>
+  void ForEachInIntervalsAndScale(Intervals const & intervals, int scale,
+                                  std::function<void(uint64_t, uint32_t)> const & fn) const
+  {
+    if (!IntervalIndexBase::AreSortedAndDisjoint(intervals))
+    {
+      for (auto const & i : intervals)
+        ForEachInIntervalAndScale(i.first, i.second, scale, fn);
+      return;
+    }
+
+    auto const scaleBucket = BucketByScale(scale);
+    if (scaleBucket < m_IndexForScale.size())
+    {
+      for (size_t i = 0; i <= scaleBucket; ++i)
+        m_IndexForScale[i]->ForEachInIntervals(fn, intervals);
+    }
+  }
+
 private:
   std::vector<std::unique_ptr<IntervalIndex<Reader, uint32_t>>> m_IndexForScale;
 };
@@ -92,6 +92,21 @@ LevenshteinDFA BuildLevenshteinDFA_Category(UniString const & s)
 
 UniString NormalizeAndSimplifyString(std::string_view s)
 {
+  // Fast path for ASCII strings (most of the query tokens and the names): nothing but lowercasing
+  // of the latin letters and merging of the spaces is done by the full pipeline below.
+  if (IsASCIIString(s))
+  {
+    UniString uniString;
+    uniString.reserve(s.size());
+    for (char const c : s)
+    {
+      if (c == ' ' && !uniString.empty() && uniString.back() == ' ')
+        continue;
+      uniString.push_back(static_cast<UniChar>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c));
+    }
+    return uniString;
+  }
+
   UniString uniString = MakeUniString(s);
   for (size_t i = 0; i < uniString.size(); ++i)
   {
@@ -230,46 +230,68 @@ void AppendValue(NodeInfo & node, Value const & value)
     LOG(LERROR, ("Cannot append to a finalized value list."));
 }
 
+// Builds the trie from <key, value> pairs which are added in the sorted order. Only the nodes
+// of the current key's path are kept in memory, so the pairs may be streamed from an external
+// storage.
 template <typename Sink, typename Key, typename ValueList, typename Serializer>
-void Build(Sink & sink, Serializer const & serializer,
-           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+class Builder
 {
+public:
   using Value = typename ValueList::Value;
-  using NodeInfo = NodeInfo<ValueList>;
 
-  std::vector<NodeInfo> nodes;
-  nodes.emplace_back(sink.Pos(), kDefaultChar);
-
-  Key prevKey;
-  std::pair<Key, Value> prevE;  // e for "element".
+  Builder(Sink & sink, Serializer const & serializer) : m_sink(sink), m_serializer(serializer)
+  {
+    m_nodes.emplace_back(m_sink.Pos(), kDefaultChar);
+  }
 
-  for (auto it = data.begin(); it != data.end(); ++it)
+  void Add(std::pair<Key, Value> const & e)
   {
-    auto e = *it;
-    if (it != data.begin() && e == prevE)
-      continue;
+    if (m_hasPrev && e == m_prev)
+      return;
 
     auto const & key = e.first;
+    auto const & prevKey = m_prev.first;
     CHECK(!(key < prevKey), (key, prevKey));
     size_t nCommon = 0;
     while (nCommon < std::min(key.size(), prevKey.size()) && prevKey[nCommon] == key[nCommon])
       ++nCommon;
 
     // Root is also a common node.
-    PopNodes(sink, serializer, nodes, nodes.size() - nCommon - 1);
-    uint64_t const pos = sink.Pos();
+    PopNodes(m_sink, m_serializer, m_nodes, m_nodes.size() - nCommon - 1);
+    uint64_t const pos = m_sink.Pos();
     for (size_t i = nCommon; i < key.size(); ++i)
-      nodes.emplace_back(pos, key[i]);
-    AppendValue(nodes.back(), e.second);
+      m_nodes.emplace_back(pos, key[i]);
+    AppendValue(m_nodes.back(), e.second);
+
+    m_prev = e;
+    m_hasPrev = true;
+  }
 
-    prevKey = key;
-    std::swap(e, prevE);
+  void Finish()
+  {
+    // Pop all the nodes from the stack.
+    PopNodes(m_sink, m_serializer, m_nodes, m_nodes.size() - 1);
+
+    // Write the root.
+    WriteNodeReverse(m_sink, m_serializer, kDefaultChar /* baseChar */, m_nodes.back(),
+                     true /* isRoot */);
   }
 
-  // Pop all the nodes from the stack.
-  PopNodes(sink, serializer, nodes, nodes.size() - 1);
+private:
+  Sink & m_sink;
+  Serializer const & m_serializer;
+  std::vector<NodeInfo<ValueList>> m_nodes;
+  std::pair<Key, Value> m_prev;
+  bool m_hasPrev = false;
+};
 
-  // Write the root.
-  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, nodes.back(), true /* isRoot */);
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void Build(Sink & sink, Serializer const & serializer,
+           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+{
+  Builder<Sink, Key, ValueList, Serializer> builder(sink, serializer);
+  for (auto const & e : data)
+    builder.Add(e);
+  builder.Finish();
 }
 }  // namespace trie
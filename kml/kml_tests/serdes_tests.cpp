@@ -568,6 +568,31 @@ UNIT_TEST(Kml_Serialization_Bin_Memory)
   TEST_EQUAL(data, data2, ());
 }
 
+UNIT_TEST(Kml_Deserialization_Bin_CategoryOnly)
+{
+  kml::FileData data;
+  {
+    kml::binary::DeserializerKml des(data);
+    MemReader reader(kBinKml.data(), kBinKml.size());
+    des.Deserialize(reader);
+  }
+  TEST(!data.m_bookmarksData.empty(), ());
+  TEST(!data.m_tracksData.empty(), ());
+
+  kml::FileData categoryData;
+  {
+    kml::binary::DeserializerKml des(categoryData);
+    MemReader reader(kBinKml.data(), kBinKml.size());
+    des.DeserializeCategoryOnly(reader);
+  }
+
+  TEST(categoryData.m_bookmarksData.empty(), ());
+  TEST(categoryData.m_tracksData.empty(), ());
+  TEST(categoryData.m_categoryData == data.m_categoryData, ());
+  TEST(categoryData.m_compilationsData == data.m_compilationsData, ());
+  TEST_EQUAL(categoryData.m_deviceId, data.m_deviceId, ());
+}
+
 // 4. Check deserialization from the text file.
 UNIT_TEST(Kml_Deserialization_Text_File)
 {
@@ -241,6 +241,15 @@ public:
     }
   }
 
+  // Reads the category and compilations data only, bookmarks and tracks are skipped without
+  // decoding. Strings are decoded only for the read data, so it's cheap for big files.
+  template <typename ReaderType>
+  void DeserializeCategoryOnly(ReaderType const & reader)
+  {
+    m_categoryOnly = true;
+    Deserialize(reader);
+  }
+
 private:
   template <typename ReaderType>
   void InitializeIfNeeded(ReaderType const & reader)
@@ -337,8 +346,11 @@ private:
     // - serialization/deserialization non-string members of structures;
     // - serialization/deserialization string members of structures.
     DeserializeCategory(subReader, data);
-    DeserializeBookmarks(subReader, data);
-    DeserializeTracks(subReader, data);
+    if (!m_categoryOnly)
+    {
+      DeserializeBookmarks(subReader, data);
+      DeserializeTracks(subReader, data);
+    }
     if constexpr (HasCompilationsData<FileDataType>::value)
       DeserializeCompilations(subReader, data);
     DeserializeStrings(subReader, data);
@@ -402,6 +414,7 @@ private:
   Header m_header;
   uint8_t m_doubleBits = 0;
   bool m_initialized = false;
+  bool m_categoryOnly = false;
 };
 }  // namespace binary
 }  // namespace kml
@@ -11,6 +11,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace kml
@@ -230,7 +231,8 @@ struct FileDataV7
     for (auto & d : m_bookmarksData)
       data.m_bookmarksData.emplace_back(d.ConvertToLatestVersion());
 
-    data.m_tracksData = m_tracksData;
+    // The data is converted once after reading, so the tracks geometry is moved, not copied.
+    data.m_tracksData = std::move(m_tracksData);
 
     return data;
   }
@@ -150,13 +150,14 @@ struct FileDataV8
     data.m_deviceId = m_deviceId;
     data.m_serverId = m_serverId;
 
-    data.m_categoryData = m_categoryData;
+    // The data is converted once after reading, so the category and the tracks are moved.
+    data.m_categoryData = std::move(m_categoryData);
 
     data.m_bookmarksData.reserve(m_bookmarksData.size());
     for (auto & d : m_bookmarksData)
       data.m_bookmarksData.emplace_back(d.ConvertToLatestVersion());
 
-    data.m_tracksData = m_tracksData;
+    data.m_tracksData = std::move(m_tracksData);
 
     return data;
   }
@@ -1,15 +1,36 @@
 #include "map/benchmark_tool/api.hpp"
 
+#include "coding/file_writer.hpp"
+
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <numeric>
 
+#include "cppjansson/cppjansson.hpp"
+
 using namespace std;
 
 namespace bench
 {
+namespace
+{
+base::JSONPtr ToJson(Result const & r)
+{
+  size_t const count = 1000;
+  auto node = base::NewJSONObject();
+  ToJSONObject(*node, "count", r.m_count);
+  ToJSONObject(*node, "total", r.m_all * count);
+  ToJSONObject(*node, "avg", r.m_avg * count);
+  ToJSONObject(*node, "median", r.m_med * count);
+  ToJSONObject(*node, "p90", r.m_p90 * count);
+  ToJSONObject(*node, "p99", r.m_p99 * count);
+  ToJSONObject(*node, "max", r.m_max * count);
+  return node;
+}
+}  // namespace
+
 void Result::PrintAllTimes()
 {
   sort(m_time.begin(), m_time.end());
@@ -19,16 +40,19 @@ void Result::PrintAllTimes()
 
 void Result::CalcMetrics()
 {
+  m_count = m_time.size();
   if (!m_time.empty())
   {
     sort(m_time.begin(), m_time.end());
 
+    auto const percentile = [this](size_t p) { return m_time[(m_time.size() - 1) * p / 100]; };
+
     m_max = m_time.back();
     m_med = m_time[m_time.size()/2];
+    m_p90 = percentile(90);
+    m_p99 = percentile(99);
     m_all = accumulate(m_time.begin(), m_time.end(), 0.0);
     m_avg = m_all / m_time.size();
-
-    m_time.clear();
   }
   else
     m_all = -1.0;
@@ -38,6 +62,7 @@ void AllResult::Print()
 {
   //m_reading.PrintAllTimes();
   m_reading.CalcMetrics();
+  m_geometry.CalcMetrics();
 
   if (m_all < 0.0)
     cout << "No frames" << endl;
@@ -47,10 +72,56 @@ void AllResult::Print()
     size_t const count = 1000;
     cout << "FRAME*1000[ median:" << m_reading.m_med * count <<
             " avg:" << m_reading.m_avg * count <<
+            " p99:" << m_reading.m_p99 * count <<
             " max:" << m_reading.m_max * count << " ] ";
+    cout << "GEOMETRY*1000[ median:" << m_geometry.m_med * count <<
+            " p99:" << m_geometry.m_p99 * count << " ] ";
     cout << "TOTAL[ idx:" << m_all - m_reading.m_all <<
             " decoding:" << m_reading.m_all <<
             " summ:" << m_all << " ]" << endl;
+
+    for (auto & [scale, r] : m_scales)
+    {
+      r.CalcMetrics();
+      cout << "SCALE " << scale << " QUERY*1000[ count:" << r.m_count <<
+              " median:" << r.m_med * count <<
+              " p90:" << r.m_p90 * count <<
+              " p99:" << r.m_p99 * count << " ]" << endl;
+    }
   }
 }
+
+void SaveToJson(vector<MwmResult> & results, string const & filePath)
+{
+  auto array = base::NewJSONArray();
+  for (auto & mwm : results)
+  {
+    auto & features = mwm.m_features;
+    features.m_reading.CalcMetrics();
+    features.m_geometry.CalcMetrics();
+    mwm.m_offsets.CalcMetrics();
+    mwm.m_centers.CalcMetrics();
+
+    auto node = base::NewJSONObject();
+    ToJSONObject(*node, "mwm", mwm.m_name);
+    ToJSONObject(*node, "feature_decoding", ToJson(features.m_reading));
+    ToJSONObject(*node, "geometry_decoding", ToJson(features.m_geometry));
+    ToJSONObject(*node, "offsets_lookup", ToJson(mwm.m_offsets));
+    ToJSONObject(*node, "centers_lookup", ToJson(mwm.m_centers));
+
+    auto scales = base::NewJSONObject();
+    for (auto & [scale, r] : features.m_scales)
+    {
+      r.CalcMetrics();
+      ToJSONObject(*scales, to_string(scale), ToJson(r));
+    }
+    ToJSONObject(*node, "rect_queries_by_scale", scales);
+
+    json_array_append_new(array.get(), node.release());
+  }
+
+  auto const str = base::DumpToString(array, JSON_INDENT(2));
+  FileWriter writer(filePath);
+  writer.Write(str.data(), str.size());
+}
 }  // namespace bench
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,10 +23,13 @@ namespace bench
     void PrintAllTimes();
     void CalcMetrics();
 
+    size_t m_count = 0;
     double m_all = 0.0;
     double m_max = 0.0;
     double m_avg = 0.0;
     double m_med = 0.0;
+    double m_p90 = 0.0;
+    double m_p99 = 0.0;
 
   private:
     std::vector<double> m_time;
@@ -39,10 +43,32 @@ namespace bench
     void Add(double t) { m_all += t; }
     void Print();
 
+    // Decoding of a feature: types, draw rules and geometry.
     Result m_reading;
+    // Part of |m_reading| spent in the geometry decoding.
+    Result m_geometry;
+    // Time of the index queries by scale, features decoding included.
+    std::map<int, Result> m_scales;
     double m_all = 0.0;
   };
 
+  struct MwmResult
+  {
+    std::string m_name;
+    AllResult m_features;
+    Result m_offsets;
+    Result m_centers;
+  };
+
   /// @param[in] count number of times to run benchmark
   void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR, AllResult & res);
+
+  /// Gets offsets of all the features from the features offsets table one by one.
+  void RunOffsetsBenchmark(std::string fileName, Result & res);
+
+  /// Gets centers of all the features from the search centers table one by one.
+  void RunCentersBenchmark(std::string fileName, Result & res);
+
+  /// Writes metrics of |results| as a json array, one object per mwm. Times are in milliseconds.
+  void SaveToJson(std::vector<MwmResult> & results, std::string const & filePath);
 }  // namespace bench
@@ -2,15 +2,22 @@
 
 #include "map/features_fetcher.hpp"
 
+#include "indexer/centers_table.hpp"
 #include "indexer/feature_visibility.hpp"
+#include "indexer/features_offsets_table.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/files_container.hpp"
+
+#include "platform/local_country_file.hpp"
 #include "platform/platform.hpp"
 
 #include "base/file_name_utils.hpp"
 #include "base/macros.hpp"
 #include "base/timer.hpp"
 
+#include "defines.hpp"
+
 #include <utility>
 #include <vector>
 
@@ -23,7 +30,7 @@ namespace
   class Accumulator
   {
   public:
-    explicit Accumulator(Result & res) : m_res(res) {}
+    Accumulator(Result & res, Result & geometryRes) : m_res(res), m_geometryRes(geometryRes) {}
 
     void Reset(int scale)
     {
@@ -44,8 +51,10 @@ namespace
 
       if (!keys.empty())
       {
+        base::Timer geometryTimer;
         // Call this function to load feature's inner data and geometry.
         UNUSED_VALUE(ft.IsEmptyGeometry(m_scale));
+        m_geometryRes.Add(geometryTimer.ElapsedSeconds());
       }
 
       m_res.Add(m_timer.ElapsedSeconds());
@@ -56,10 +65,18 @@ namespace
     size_t m_count = 0;
 
     Result & m_res;
+    Result & m_geometryRes;
 
     int m_scale = 0;
   };
 
+  platform::LocalCountryFile MakeLocalFile(string fileName)
+  {
+    base::GetNameFromFullPath(fileName);
+    base::GetNameWithoutExt(fileName);
+    return platform::LocalCountryFile::MakeForTesting(std::move(fileName));
+  }
+
   void RunBenchmark(FeaturesFetcher const & src, m2::RectD const & rect,
                     pair<int, int> const & scaleRange, AllResult & res)
   {
@@ -68,7 +85,7 @@ namespace
     vector<m2::RectD> rects;
     rects.push_back(rect);
 
-    Accumulator acc(res.m_reading);
+    Accumulator acc(res.m_reading, res.m_geometry);
 
     while (!rects.empty())
     {
@@ -83,7 +100,9 @@ namespace
 
         base::Timer timer;
         src.ForEachFeature(r, acc, scale);
-        res.Add(timer.ElapsedSeconds());
+        double const elapsed = timer.ElapsedSeconds();
+        res.Add(elapsed);
+        res.m_scales[scale].Add(elapsed);
 
         doDivide = !acc.IsEmpty();
       }
@@ -101,11 +120,8 @@ namespace
 
 void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, AllResult & res)
 {
-  base::GetNameFromFullPath(fileName);
-  base::GetNameWithoutExt(fileName);
-
   FeaturesFetcher src;
-  auto const r = src.RegisterMap(platform::LocalCountryFile::MakeForTesting(std::move(fileName)));
+  auto const r = src.RegisterMap(MakeLocalFile(std::move(fileName)));
   if (r.second != MwmSet::RegResult::Success)
     return;
 
@@ -121,4 +137,38 @@ void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, All
 
   RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, res);
 }
+
+void RunOffsetsBenchmark(string fileName, Result & res)
+{
+  FilesContainerR const cont(MakeLocalFile(std::move(fileName)).GetPath(MapFileType::Map));
+  auto const table = feature::FeaturesOffsetsTable::Load(cont);
+  for (size_t id = 0; id < table->size(); ++id)
+  {
+    base::Timer timer;
+    UNUSED_VALUE(table->GetFeatureOffset(id));
+    res.Add(timer.ElapsedSeconds());
+  }
+}
+
+void RunCentersBenchmark(string fileName, Result & res)
+{
+  FilesContainerR const cont(MakeLocalFile(std::move(fileName)).GetPath(MapFileType::Map));
+  if (!cont.IsExist(CENTERS_FILE_TAG))
+    return;
+
+  auto reader = cont.GetReader(CENTERS_FILE_TAG);
+  auto const table = search::CentersTable::LoadV1(*reader.GetPtr());
+  if (!table)
+    return;
+
+  // Ids of the features without centers are looked up too.
+  auto const count = feature::FeaturesOffsetsTable::Load(cont)->size();
+  for (uint32_t id = 0; id < count; ++id)
+  {
+    base::Timer timer;
+    m2::PointD center;
+    UNUSED_VALUE(table->Get(id, center));
+    res.Add(timer.ElapsedSeconds());
+  }
+}
 }  // namespace bench
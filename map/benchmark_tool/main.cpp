@@ -3,16 +3,21 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 
+#include "base/string_utils.hpp"
+
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <gflags/gflags.h>
 
 using namespace std;
 
-DEFINE_string(input, "", "MWM file name in the data directory");
+DEFINE_string(input, "", "MWM file name in the data directory, or comma-separated names");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_string(json, "", "Path to save the metrics of every MWM as json, for comparing runs");
 
 int main(int argc, char ** argv)
 {
@@ -41,10 +46,21 @@ int main(int argc, char ** argv)
   {
     using namespace bench;
 
-    AllResult res;
-    RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
+    vector<MwmResult> results;
+    for (auto const & name : strings::Tokenize<string>(FLAGS_input, ","))
+    {
+      MwmResult & mwm = results.emplace_back();
+      mwm.m_name = name;
+      RunFeaturesLoadingBenchmark(mwm.m_name, make_pair(FLAGS_lowS, FLAGS_highS), mwm.m_features);
+      RunOffsetsBenchmark(mwm.m_name, mwm.m_offsets);
+      RunCentersBenchmark(mwm.m_name, mwm.m_centers);
+
+      cout << mwm.m_name << endl;
+      mwm.m_features.Print();
+    }
 
-    res.Print();
+    if (!FLAGS_json.empty())
+      SaveToJson(results, FLAGS_json);
   }
 
   return 0;
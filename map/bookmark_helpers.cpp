@@ -331,7 +331,11 @@ std::unique_ptr<kml::FileData> LoadKmlFile(std::string const & file, KmlFileType
   std::unique_ptr<kml::FileData> kmlData;
   try
   {
-    kmlData = LoadKmlData(FileReader(file), fileType);
+    // Text files are read sequentially by big blocks, so big cache pages save many reads.
+    auto const reader = fileType == KmlFileType::Binary
+                            ? FileReader(file)
+                            : FileReader(file, 16 /* logPageSize */, 2 /* logPageCount */);
+    kmlData = LoadKmlData(reader, fileType);
     if (kmlData != nullptr)
       FillEmptyNames(kmlData, file);
   }
@@ -25,8 +25,10 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <iomanip>
 #include <limits>
@@ -1603,14 +1605,28 @@ UserMark const * BookmarkManager::FindMarkInRect(kml::MarkGroupId groupId, m2::A
   if (group->IsVisible())
   {
     FindMarkFunctor f(&resMark, d, rect);
-    for (auto markId : group->GetUserMarks())
+    auto const checkMark = [&](kml::MarkId markId)
     {
       auto const * mark = GetMark(markId);
       if (findOnlyVisible && !mark->IsVisible())
-        continue;
+        return;
 
       if (mark->IsAvailableForSearch() && rect.IsPointInside(mark->GetPivot()))
         f(mark);
+    };
+
+    // Bookmarks don't move, so categories are hit-tested by the index. Other marks are few.
+    if (IsBookmarkCategory(groupId))
+    {
+      group->ForEachUserMarkInRect(rect.GetGlobalRect(), [this](kml::MarkId markId)
+      {
+        return GetMark(markId)->GetPivot();
+      }, checkMark);
+    }
+    else
+    {
+      for (auto markId : group->GetUserMarks())
+        checkMark(markId);
     }
   }
   return resMark;
@@ -1920,19 +1936,37 @@ BookmarkManager::KMLDataCollectionPtr BookmarkManager::LoadBookmarks(
   Platform::FilesList files;
   Platform::GetFilesByExt(dir, ext, files);
 
+  // Files are parsed in parallel, it takes much time with many big files.
+  size_t constexpr kMaxThreadsCount = 4;
+  std::vector<std::unique_ptr<kml::FileData>> kmlDatas(files.size());
+  std::atomic<size_t> next(0);
+  auto const loadFiles = [&]()
+  {
+    for (size_t i = next++; i < files.size() && !m_needTeardown; i = next++)
+      kmlDatas[i] = LoadKmlFile(base::JoinPath(dir, files[i]), fileType);
+  };
+
+  auto const threadsCount = std::min({files.size(), kMaxThreadsCount,
+                                      static_cast<size_t>(std::thread::hardware_concurrency())});
+  std::vector<threads::SimpleThread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(loadFiles);
+  loadFiles();
+  for (auto & thread : threads)
+    thread.join();
+
   auto collection = std::make_shared<KMLDataCollection>();
   collection->reserve(files.size());
-  for (auto const & file : files)
+  for (size_t i = 0; i < files.size(); ++i)
   {
-    auto const filePath = base::JoinPath(dir, file);
-    auto kmlData = LoadKmlFile(filePath, fileType);
+    if (m_needTeardown)
+      break;
+    auto & kmlData = kmlDatas[i];
     if (kmlData == nullptr)
       continue;
     if (checker && !checker(*kmlData))
       continue;
-    if (m_needTeardown)
-      break;
-    collection->emplace_back(filePath, std::move(kmlData));
+    collection->emplace_back(base::JoinPath(dir, files[i]), std::move(kmlData));
   }
   return collection;
 }
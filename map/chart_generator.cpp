@@ -5,6 +5,7 @@
 #include "base/math.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 #include "3party/agg/agg_conv_curve.h"
 #include "3party/agg/agg_conv_stroke.h"
@@ -307,4 +308,118 @@ bool GenerateChart(uint32_t width, uint32_t height, vector<double> const & dista
 
   return GenerateChartByPoints(width, height, geometry, mapStyle, frameBuffer);
 }
+
+bool AltitudeChartPyramid::Build(vector<double> const & distanceDataM,
+                                 geometry::Altitudes const & altitudeDataM)
+{
+  m_levels.clear();
+
+  vector<double> uniformAltitudeDataM;
+  if (!NormalizeChartData(distanceDataM, altitudeDataM, kBasePointCount, uniformAltitudeDataM))
+    return false;
+
+  if (uniformAltitudeDataM.empty())
+    return true;
+
+  m_levels.push_back({uniformAltitudeDataM, uniformAltitudeDataM});
+  while (m_levels.back().m_min.size() > 1)
+  {
+    Level const & prev = m_levels.back();
+    size_t const prevSize = prev.m_min.size();
+
+    Level next;
+    next.m_min.reserve((prevSize + 1) / 2);
+    next.m_max.reserve((prevSize + 1) / 2);
+    for (size_t i = 0; i < prevSize; i += 2)
+    {
+      size_t const j = min(i + 1, prevSize - 1);
+      next.m_min.push_back(min(prev.m_min[i], prev.m_min[j]));
+      next.m_max.push_back(max(prev.m_max[i], prev.m_max[j]));
+    }
+    m_levels.push_back(move(next));
+  }
+  return true;
+}
+
+void AltitudeChartPyramid::GetChartData(uint32_t width, vector<m2::PointD> & chartDataM) const
+{
+  chartDataM.clear();
+  if (IsEmpty() || width == 0)
+    return;
+
+  double const oneSegLenPix = width == 1 ? 0.0 : static_cast<double>(width) / (width - 1);
+
+  vector<double> const & base = m_levels.front().m_min;
+  if (width >= base.size())
+  {
+    // There are more pixels than points, altitudes are interpolated.
+    chartDataM.reserve(width);
+    double const step = width == 1 ? 0.0 : static_cast<double>(base.size() - 1) / (width - 1);
+    for (uint32_t i = 0; i < width; ++i)
+    {
+      double const pos = i * step;
+      size_t const prevIdx = min(static_cast<size_t>(pos), base.size() - 1);
+      size_t const nextIdx = min(prevIdx + 1, base.size() - 1);
+      double const k = pos - prevIdx;
+      chartDataM.emplace_back(i * oneSegLenPix, base[prevIdx] + k * (base[nextIdx] - base[prevIdx]));
+    }
+    return;
+  }
+
+  // The coarsest level which still has a point for each pixel column, so a column covers
+  // not more than two points of it.
+  size_t levelIdx = 0;
+  while (levelIdx + 1 < m_levels.size() && m_levels[levelIdx + 1].m_min.size() >= width)
+    ++levelIdx;
+
+  Level const & level = m_levels[levelIdx];
+  size_t const levelSize = level.m_min.size();
+  chartDataM.reserve(2 * width);
+  for (uint32_t i = 0; i < width; ++i)
+  {
+    size_t const begin = static_cast<size_t>(i) * levelSize / width;
+    size_t const end = max(begin + 1, static_cast<size_t>(i + 1) * levelSize / width);
+
+    double minAltM = level.m_min[begin];
+    double maxAltM = level.m_max[begin];
+    for (size_t j = begin + 1; j < end; ++j)
+    {
+      minAltM = min(minAltM, level.m_min[j]);
+      maxAltM = max(maxAltM, level.m_max[j]);
+    }
+
+    double const x = i * oneSegLenPix;
+    if (minAltM == maxAltM)
+    {
+      chartDataM.emplace_back(x, minAltM);
+      continue;
+    }
+
+    // The extremum which is closer to the previous point goes first to keep the line smooth.
+    bool const maxFirst =
+        !chartDataM.empty() && fabs(chartDataM.back().y - maxAltM) < fabs(chartDataM.back().y - minAltM);
+    chartDataM.emplace_back(x, maxFirst ? maxAltM : minAltM);
+    chartDataM.emplace_back(x, maxFirst ? minAltM : maxAltM);
+  }
+}
+
+bool GenerateChart(uint32_t width, uint32_t height, AltitudeChartPyramid const & pyramid,
+                   MapStyle mapStyle, vector<uint8_t> & frameBuffer)
+{
+  vector<m2::PointD> geometry;
+  pyramid.GetChartData(width, geometry);
+
+  vector<double> altitudeDataM(geometry.size());
+  for (size_t i = 0; i < geometry.size(); ++i)
+    altitudeDataM[i] = geometry[i].y;
+
+  vector<double> yAxisDataPxl;
+  if (!GenerateYAxisChartData(height, 1.0 /* minMetersPerPxl */, altitudeDataM, yAxisDataPxl))
+    return false;
+
+  for (size_t i = 0; i < geometry.size(); ++i)
+    geometry[i].y = yAxisDataPxl[i];
+
+  return GenerateChartByPoints(width, height, geometry, mapStyle, frameBuffer);
+}
 }  // namespace maps
@@ -48,4 +48,37 @@ bool GenerateChartByPoints(uint32_t width, uint32_t height,
 bool GenerateChart(uint32_t width, uint32_t height, std::vector<double> const & distanceDataM,
                    geometry::Altitudes const & altitudeDataM, MapStyle mapStyle,
                    std::vector<uint8_t> & frameBuffer);
+
+/// \brief Altitude profile prepared for charts of any width. The profile is evenly resampled
+/// once to |kBasePointCount| points and every next level keeps the minimum and the maximum
+/// altitudes of pairs of points of the previous level. A chart is read from the level with
+/// the closest resolution, so it costs O(width) whatever the length of the route or the track
+/// and peaks aren't lost when the profile has more points than the chart has pixels.
+class AltitudeChartPyramid
+{
+public:
+  static size_t constexpr kBasePointCount = 4096;
+
+  /// \returns false if |distanceDataM| and |altitudeDataM| are inconsistent.
+  bool Build(std::vector<double> const & distanceDataM, geometry::Altitudes const & altitudeDataM);
+
+  bool IsEmpty() const { return m_levels.empty(); }
+
+  /// \brief fills |chartDataM| with points of a chart of |width| pixels, x is in pixels and
+  /// y is altitude in meters. A pixel column gets both the minimum and the maximum altitude
+  /// if it covers several points of the profile.
+  void GetChartData(uint32_t width, std::vector<m2::PointD> & chartDataM) const;
+
+private:
+  struct Level
+  {
+    std::vector<double> m_min;
+    std::vector<double> m_max;
+  };
+
+  std::vector<Level> m_levels;
+};
+
+bool GenerateChart(uint32_t width, uint32_t height, AltitudeChartPyramid const & pyramid,
+                   MapStyle mapStyle, std::vector<uint8_t> & frameBuffer);
 }  // namespace maps
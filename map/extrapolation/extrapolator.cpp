@@ -132,7 +132,6 @@ bool AreCoordsGoodForExtrapolation(location::GpsInfo const & info1, location::Gp
 Extrapolator::Extrapolator(ExtrapolatedLocationUpdateFn const & update)
   : m_isEnabled(false), m_extrapolatedLocationUpdate(update)
 {
-  RunTaskOnBackgroundThread(false /* delayed */);
 }
 
 void Extrapolator::OnLocationUpdate(location::GpsInfo const & gpsInfo)
@@ -182,8 +181,15 @@ void Extrapolator::ExtrapolatedLocationUpdate(uint64_t locationUpdateCounter)
 
   {
     lock_guard<mutex> guard(m_mutex);
-    if (m_consecutiveRuns != kExtrapolationCounterUndefined)
-      ++m_consecutiveRuns;
+    if (m_consecutiveRuns == kExtrapolationCounterUndefined)
+      return;
+
+    ++m_consecutiveRuns;
+    // The chain of updates is stopped when the next one would be past |kMaxExtrapolationTimeMs|,
+    // so the background thread doesn't wake up without new locations.
+    // OnLocationUpdate() starts a new chain.
+    if (kExtrapolationPeriodMs * m_consecutiveRuns >= kMaxExtrapolationTimeMs)
+      return;
   }
 
   // Calling ExtrapolatedLocationUpdate() in |kExtrapolationPeriodMs| milliseconds.
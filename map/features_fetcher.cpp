@@ -7,6 +7,9 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
@@ -57,6 +60,29 @@ std::pair<MwmSet::MwmId, MwmSet::RegResult> FeaturesFetcher::RegisterMap(
   }
 }
 
+std::vector<std::pair<MwmSet::MwmId, MwmSet::RegResult>> FeaturesFetcher::RegisterMaps(
+    std::vector<LocalCountryFile> const & localFiles)
+{
+  // Registration mostly waits for reading of the files, so it's fine to have more threads than cores.
+  size_t const threadsCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U) * 2, 8);
+  auto results = m_dataSource.Register(localFiles, threadsCount);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    auto const & [id, regResult] = results[i];
+    if (regResult != MwmSet::RegResult::Success)
+    {
+      LOG(LWARNING, ("Can't add map", localFiles[i].GetCountryName(), "(", regResult, ").",
+                     "Probably it's already added or has newer data version."));
+    }
+    else
+    {
+      ASSERT(id.IsAlive(), ());
+      m_rect.Add(id.GetInfo()->m_bordersRect);
+    }
+  }
+  return results;
+}
+
 bool FeaturesFetcher::DeregisterMap(CountryFile const & countryFile)
 {
   return m_dataSource.Deregister(countryFile);
@@ -34,6 +34,10 @@ public:
   // Registers a new map.
   std::pair<MwmSet::MwmId, MwmSet::RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  // Registers several maps in parallel, see MwmSet::Register.
+  std::vector<std::pair<MwmSet::MwmId, MwmSet::RegResult>> RegisterMaps(
+      std::vector<platform::LocalCountryFile> const & localFiles);
+
   // Deregisters a map denoted by file from internal records.
   bool DeregisterMap(platform::CountryFile const & countryFile);
 
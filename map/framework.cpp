@@ -38,7 +38,9 @@
 #include "indexer/feature_source.hpp"
 #include "indexer/feature_utils.hpp"
 #include "indexer/feature_visibility.hpp"
+#include "indexer/isolines_info.hpp"
 #include "indexer/map_style_reader.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/scales.hpp"
 #include "indexer/transliteration_loader.hpp"
 
@@ -73,6 +75,8 @@
 #include "defines.hpp"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 
 using namespace location;
@@ -107,6 +111,7 @@ char const kLargeFontsSize[] = "LargeFontsSize";
 char const kTranslitMode[] = "TransliterationMode";
 char const kPreferredGraphicsAPI[] = "PreferredGraphicsAPI";
 char const kShowDebugInfo[] = "DebugInfo";
+char const kMwmInfoCacheFile[] = "mwm_info.cache";
 
 auto constexpr kLargeFontsScaleFactor = 1.6;
 size_t constexpr kMaxTrafficCacheSizeBytes = 64 /* Mb */ * 1024 * 1024;
@@ -532,10 +537,26 @@ void Framework::RegisterAllMaps()
 {
   m_storage.RegisterAllLocalMaps(m_enabledDiffs);
 
+  // Maps which weren't changed since the previous start are registered without opening them.
+  auto infoCache = make_shared<indexer::MwmInfoCache>(GetPlatform().WritablePathForFile(kMwmInfoCacheFile));
+  m_featuresFetcher.GetDataSource().SetInfoCache(infoCache);
+
   vector<shared_ptr<LocalCountryFile>> maps;
   m_storage.GetLocalMaps(maps);
+  vector<LocalCountryFile> files;
+  files.reserve(maps.size());
   for (auto const & localFile : maps)
-    UNUSED_VALUE(RegisterMap(*localFile));
+    files.push_back(*localFile);
+
+  auto const results = m_featuresFetcher.RegisterMaps(files);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    if (results[i].second == MwmSet::RegResult::Success)
+      LOG(LINFO, ("Loaded", files[i].GetCountryName(), "map, of version", results[i].first.GetInfo()->GetVersion()));
+  }
+
+  if (!infoCache->Save())
+    LOG(LWARNING, ("Can't save", kMwmInfoCacheFile));
 }
 
 void Framework::DeregisterAllMaps()
@@ -680,7 +701,13 @@ void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & inf
   info.SetLocalizedWifiString(m_stringsBundle.GetString("wifi"));
 
   if (ftypes::IsAddressObjectChecker::Instance()(ft))
-    info.SetAddress(GetAddressAtPoint(feature::GetCenter(ft)).FormatAddress());
+  {
+    // The address is a title of an unnamed building, otherwise it's slow to wait for.
+    if (!ft.HasName() && ftypes::IsBuildingChecker::Instance()(ft))
+      info.SetAddress(GetAddressAtPoint(feature::GetCenter(ft)).FormatAddress());
+    else
+      info.SetAddressPending(feature::GetCenter(ft));
+  }
 
   info.SetFromFeatureType(ft);
 
@@ -1395,9 +1422,30 @@ void Framework::FillSearchResultsMarks(bool clear, search::Results const & resul
 
 void Framework::FillSearchResultsMarks(SearchResultsIterT beg, SearchResultsIterT end, bool clear)
 {
-  auto editSession = GetBookmarkManager().GetEditSession();
+  auto & bmManager = GetBookmarkManager();
+  auto editSession = bmManager.GetEditSession();
+
+  // Marks of features which are found again are kept, so only added and removed results
+  // are passed to drape instead of the whole layer.
+  unordered_map<FeatureID, kml::MarkId> keptMarks;
   if (clear)
-    editSession.ClearGroup(UserMark::Type::SEARCH);
+  {
+    unordered_set<FeatureID> features;
+    for (auto it = beg; it != end; ++it)
+    {
+      if (it->HasPoint() && it->GetResultType() == search::Result::Type::Feature)
+        features.insert(it->GetFeatureID());
+    }
+
+    editSession.DeleteUserMarks<SearchMarkPoint>(UserMark::Type::SEARCH,
+                                                 [&](SearchMarkPoint const * mark)
+    {
+      auto const & fID = mark->GetFeatureID();
+      if (!fID.IsValid() || features.count(fID) == 0)
+        return true;
+      return !keptMarks.emplace(fID, mark->GetId()).second;
+    });
+  }
   editSession.SetIsVisible(UserMark::Type::SEARCH, true);
 
   for (auto it = beg; it != end; ++it)
@@ -1406,6 +1454,18 @@ void Framework::FillSearchResultsMarks(SearchResultsIterT beg, SearchResultsIter
     if (!r.HasPoint())
       continue;
 
+    if (r.GetResultType() == search::Result::Type::Feature)
+    {
+      auto const kept = keptMarks.find(r.GetFeatureID());
+      if (kept != keptMarks.end())
+      {
+        // Visited and selected states of the kept mark are maintained by m_searchMarks.
+        if (bmManager.GetMark<SearchMarkPoint>(kept->second)->GetMatchedName() != r.GetString())
+          editSession.GetMarkForEdit<SearchMarkPoint>(kept->second)->SetMatchedName(r.GetString());
+        continue;
+      }
+    }
+
     auto * mark = editSession.CreateUserMark<SearchMarkPoint>(r.GetFeatureCenter());
     mark->SetMatchedName(r.GetString());
 
@@ -1490,6 +1550,13 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
 
   auto isCountryLoadedByNameFn = bind(&Framework::IsCountryLoadedByName, this, _1);
   auto updateCurrentCountryFn = bind(&Framework::OnUpdateCurrentCountry, this, _1, _2);
+  auto getIsolinesMinAltClassFn = [this](MwmSet::MwmId const & mwmId, int zoom) -> int16_t
+  {
+    isolines::IsolinesInfo info;
+    if (!isolines::LoadIsolinesInfo(m_featuresFetcher.GetDataSource(), mwmId, info))
+      return 0;
+    return info.GetMinAltClass(zoom);
+  };
 
   bool allow3d;
   bool allow3dBuildings;
@@ -1507,7 +1574,8 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
       params.m_apiVersion, contextFactory,
       dp::Viewport(0, 0, params.m_surfaceWidth, params.m_surfaceHeight),
       df::MapDataProvider(std::move(idReadFn), std::move(featureReadFn),
-                          std::move(isCountryLoadedByNameFn), std::move(updateCurrentCountryFn)),
+                          std::move(isCountryLoadedByNameFn), std::move(updateCurrentCountryFn),
+                          std::move(getIsolinesMinAltClassFn)),
       params.m_hints, params.m_visualScale, fontsScaleFactor, std::move(params.m_widgetsInitInfo),
       std::move(myPositionModeChangedFn), allow3dBuildings, trafficEnabled, isolinesEnabled,
       params.m_isChoosePositionMode, params.m_isChoosePositionMode, GetSelectedFeatureTriangles(),
@@ -1538,6 +1606,7 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
   OnSize(params.m_surfaceWidth, params.m_surfaceHeight);
 
   Allow3dMode(allow3d, allow3dBuildings);
+  m_drapeEngine->SetPowerSavingMode(m_powerManager.IsPowerSavingMode());
 
   LoadViewport();
 
@@ -2129,6 +2198,7 @@ std::optional<place_page::Info> Framework::BuildPlacePageInfo(
       }
 
       SetPlacePageLocation(outInfo);
+      FillPendingAddress(outInfo);
       return outInfo;
     }
   }
@@ -2191,6 +2261,7 @@ std::optional<place_page::Info> Framework::BuildPlacePageInfo(
     outInfo.SetSelectedObject(df::SelectionShape::OBJECT_POI);
     GetBookmarkManager().SelectionMark().SetPtOrg(outInfo.GetMercator());
     SetPlacePageLocation(outInfo);
+    FillPendingAddress(outInfo);
 
     return outInfo;
   }
@@ -3169,6 +3240,31 @@ void Framework::SetPlacePageLocation(place_page::Info & info)
   }
 }
 
+void Framework::FillPendingAddress(place_page::Info const & info)
+{
+  auto const & pt = info.GetPendingAddressPoint();
+  if (!pt)
+    return;
+
+  GetPlatform().RunTask(Platform::Thread::Background, [this, fid = info.GetID(), pt = *pt]()
+  {
+    auto address = GetAddressAtPoint(pt).FormatAddress();
+    GetPlatform().RunTask(Platform::Thread::Gui, [this, fid, address = std::move(address)]() mutable
+    {
+      // The place page could be closed or rebuilt for another object meanwhile.
+      if (!m_currentPlacePageInfo || m_currentPlacePageInfo->GetID() != fid ||
+          !m_currentPlacePageInfo->GetPendingAddressPoint())
+      {
+        return;
+      }
+
+      m_currentPlacePageInfo->SetPendingAddress(std::move(address));
+      if (m_onPlacePageUpdate)
+        m_onPlacePageUpdate();
+    });
+  });
+}
+
 void Framework::FillDescription(FeatureType & ft, place_page::Info & info) const
 {
   if (!ft.GetID().m_mwmId.IsAlive())
@@ -3189,6 +3285,10 @@ void Framework::FillDescription(FeatureType & ft, place_page::Info & info) const
 
 void Framework::OnPowerFacilityChanged(power_management::Facility const facility, bool enabled)
 {
+  // Auto scheme changes facilities only, so power saving mode may change here.
+  if (m_drapeEngine)
+    m_drapeEngine->SetPowerSavingMode(m_powerManager.IsPowerSavingMode());
+
   if (facility == power_management::Facility::PerspectiveView ||
       facility == power_management::Facility::Buildings3d)
   {
@@ -3214,6 +3314,9 @@ void Framework::OnPowerFacilityChanged(power_management::Facility const facility
 
 void Framework::OnPowerSchemeChanged(power_management::Scheme const actualScheme)
 {
+  if (m_drapeEngine)
+    m_drapeEngine->SetPowerSavingMode(m_powerManager.IsPowerSavingMode());
+
   if (actualScheme == power_management::Scheme::EconomyMaximum && GetTrafficManager().IsEnabled())
     GetTrafficManager().SetEnabled(false);
 }
@@ -611,6 +611,9 @@ private:
   void FillTrackInfo(Track const & track, m2::PointD const & trackPoint,
                      place_page::Info & info) const;
   void SetPlacePageLocation(place_page::Info & info);
+  /// Looks up the pending address of |info| in background and updates the current place page
+  /// if it still shows the same feature.
+  void FillPendingAddress(place_page::Info const & info);
   void FillDescription(FeatureType & ft, place_page::Info & info) const;
 
 public:
@@ -183,7 +183,10 @@ void GpsTrack::InitCollection(hours duration)
     vector<location::GpsInfo> originPoints;
     originPoints.reserve(gps_track::kItemBlockSize);
 
-    m_storage->ForEach([this, &originPoints](location::GpsInfo const & originPoint)->bool
+    // Points older than |duration| are evicted from the collection anyway, so they aren't read.
+    double const minTimestamp =
+        m_storage->GetLastTimestamp() - duration_cast<seconds>(duration).count();
+    m_storage->ForEach(minTimestamp, [this, &originPoints](location::GpsInfo const & originPoint)->bool
     {
       originPoints.emplace_back(originPoint);
       if (originPoints.size() == originPoints.capacity())
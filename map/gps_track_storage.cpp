@@ -1,13 +1,18 @@
 #include "map/gps_track_storage.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/endianness.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <limits>
 
 using namespace std;
 
@@ -15,18 +20,25 @@ namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+uint32_t constexpr kCurrentVersion = 2;
+
+// Version of the files with items of fixed size, such files are converted on opening
+uint32_t constexpr kFixedSizeItemsVersion = 1;
 
 // Header size in bytes, header consists of uint32_t 'version' only
 uint32_t constexpr kHeaderSize = sizeof(uint32_t);
 
-// Number of items for batch processing
+// Number of items for batch processing and max number of items in a block
 size_t constexpr kItemBlockSize = 1000;
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
+// Block header consists of uint32_t 'payload size', uint32_t 'item count'
+// and double 'max timestamp of the block items'
+size_t constexpr kBlockHeaderSize = 2 * sizeof(uint32_t) + sizeof(double);
+
+// Max size of an encoded item: 8 varints of uint64_t and a byte of the source
+size_t constexpr kMaxEncodedItemSize = 8 * 10 + sizeof(uint8_t);
 
-// Size of point in bytes to write in file of read from file
+// Size of point in bytes in the files of kFixedSizeItemsVersion
 size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
 
 // Writes value in memory in LittleEndian
@@ -46,21 +58,6 @@ T MemRead(void const * ptr)
   return SwapIfBigEndianMacroBased(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speedMpS);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
-  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
-}
-
 void Unpack(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
@@ -75,9 +72,60 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+array<double *, 8> GetFields(location::GpsInfo & info)
+{
+  return {&info.m_timestamp, &info.m_latitude, &info.m_longitude, &info.m_altitude,
+          &info.m_speedMpS, &info.m_bearing, &info.m_horizontalAccuracy, &info.m_verticalAccuracy};
+}
+
+array<double, 8> GetFields(location::GpsInfo const & info)
+{
+  return {info.m_timestamp, info.m_latitude, info.m_longitude, info.m_altitude,
+          info.m_speedMpS, info.m_bearing, info.m_horizontalAccuracy, info.m_verticalAccuracy};
+}
+
+uint64_t ToBits(double d)
+{
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(d));
+  return bits;
+}
+
+double FromBits(uint64_t bits)
+{
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+// Appends |item| to |payload|. Each field is written as xor of its bits with the bits of
+// the same field of |prev|, so the values which are equal or close to the previous ones
+// take a few bytes only. The encoding is lossless.
+void EncodeItem(location::GpsInfo const & item, location::GpsInfo const & prev,
+                vector<uint8_t> & payload)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  PushBackByteSink<vector<uint8_t>> sink(payload);
+  auto const fields = GetFields(item);
+  auto const prevFields = GetFields(prev);
+  for (size_t i = 0; i < fields.size(); ++i)
+    WriteVarUint(sink, ToBits(fields[i]) ^ ToBits(prevFields[i]));
+
+  ASSERT_LESS_OR_EQUAL(static_cast<int>(item.m_source), 255, ());
+  uint8_t const source = static_cast<uint8_t>(item.m_source);
+  sink.Write(&source, sizeof(source));
+}
+
+template <typename Source>
+void DecodeItem(Source & src, location::GpsInfo const & prev, location::GpsInfo & item)
+{
+  auto const fields = GetFields(item);
+  auto const prevFields = GetFields(prev);
+  for (size_t i = 0; i < fields.size(); ++i)
+    *fields[i] = FromBits(ReadVarUint<uint64_t>(src) ^ ToBits(prevFields[i]));
+
+  uint8_t source;
+  src.Read(&source, sizeof(source));
+  item.m_source = static_cast<location::TLocationSource>(source);
 }
 
 inline size_t GetItemCount(size_t fileSize)
@@ -102,12 +150,49 @@ inline bool ReadVersion(fstream & f, uint32_t & version)
   return f.good();
 }
 
+bool WriteBlockHeader(fstream & f, uint32_t size, uint32_t itemCount, double maxTimestamp)
+{
+  char buff[kBlockHeaderSize];
+  MemWrite<uint32_t>(buff, size);
+  MemWrite<uint32_t>(buff + sizeof(uint32_t), itemCount);
+  MemWrite<double>(buff + 2 * sizeof(uint32_t), maxTimestamp);
+  f.write(buff, kBlockHeaderSize);
+  return f.good();
+}
+
+// Writes |items| as a new block at the current position of |f|.
+bool WriteBlock(fstream & f, vector<location::GpsInfo> const & items)
+{
+  ASSERT(!items.empty(), ());
+  ASSERT_LESS_OR_EQUAL(items.size(), kItemBlockSize, ());
+
+  vector<uint8_t> payload;
+  payload.reserve(items.size() * kMaxEncodedItemSize);
+  location::GpsInfo prev;
+  double maxTimestamp = numeric_limits<double>::lowest();
+  for (auto const & item : items)
+  {
+    EncodeItem(item, prev, payload);
+    prev = item;
+    maxTimestamp = max(maxTimestamp, item.m_timestamp);
+  }
+
+  if (!WriteBlockHeader(f, static_cast<uint32_t>(payload.size()), static_cast<uint32_t>(items.size()),
+                        maxTimestamp))
+  {
+    return false;
+  }
+  f.write(reinterpret_cast<char const *>(payload.data()), payload.size());
+  return f.good();
+}
+
 } // namespace
 
 GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
   : m_filePath(filePath)
   , m_maxItemCount(maxItemCount)
   , m_itemCount(0)
+  , m_endOffset(kHeaderSize)
 {
   ASSERT_GREATER(m_maxItemCount, 0, ());
 
@@ -122,26 +207,16 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
 
     if (version == kCurrentVersion)
     {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      auto const fileSize = static_cast<size_t>(m_stream.tellp());
-
-      m_itemCount = GetItemCount(fileSize);
-
-      // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
+      ReadIndex();
+    }
+    else if (version == kFixedSizeItemsVersion)
+    {
+      ConvertFixedSizeItems();
     }
     else
     {
       m_stream.close();
-      // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
+      // TODO: For now we support only the previous version, but in future migration may be needed.
     }
   }
 
@@ -157,6 +232,8 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
       MYTHROW(OpenException, ("Write version error.", m_filePath));
 
     m_itemCount = 0;
+    m_endOffset = kHeaderSize;
+    m_blocks.clear();
   }
 }
 
@@ -172,22 +249,45 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (needTrunc)
     TruncFile();
 
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
-
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
+  // Items are added to the last block while it is not full, so small batches are stored
+  // as compact as the big ones. The payload is written before the updated block header,
+  // so an interrupted write leaves a broken tail which is dropped on the next opening.
+  vector<uint8_t> payload;
   for (size_t i = 0; i < items.size();)
   {
-    size_t const n = min(items.size() - i, kItemBlockSize);
+    if (m_blocks.empty() || m_blocks.back().m_itemCount == kItemBlockSize)
+    {
+      Block block;
+      block.m_offset = m_endOffset;
+      m_blocks.push_back(block);
+      m_lastItem = TItem();
+    }
+
+    auto & block = m_blocks.back();
+    size_t const n = min(items.size() - i, kItemBlockSize - block.m_itemCount);
 
+    payload.clear();
     for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
+    {
+      auto const & item = items[i + j];
+      EncodeItem(item, m_lastItem, payload);
+      m_lastItem = item;
+      block.m_maxTimestamp = max(block.m_maxTimestamp, item.m_timestamp);
+    }
 
-    m_stream.write(&buff[0], n * kPointSize);
+    m_stream.seekp(block.m_offset + kBlockHeaderSize + block.m_size, ios::beg);
+    m_stream.write(reinterpret_cast<char const *>(payload.data()), payload.size());
     if (!m_stream.good())
       MYTHROW(WriteException, ("File:", m_filePath));
 
+    block.m_size += static_cast<uint32_t>(payload.size());
+    block.m_itemCount += static_cast<uint32_t>(n);
+
+    m_stream.seekp(block.m_offset, ios::beg);
+    if (!WriteBlockHeader(m_stream, block.m_size, block.m_itemCount, block.m_maxTimestamp))
+      MYTHROW(WriteException, ("File:", m_filePath));
+
+    m_endOffset = block.m_offset + kBlockHeaderSize + block.m_size;
     i += n;
   }
 
@@ -203,6 +303,8 @@ void GpsTrackStorage::Clear()
   ASSERT(m_stream.is_open(), ());
 
   m_itemCount = 0;
+  m_endOffset = kHeaderSize;
+  m_blocks.clear();
 
   m_stream.close();
 
@@ -213,45 +315,176 @@ void GpsTrackStorage::Clear()
 
   if (!WriteVersion(m_stream, kCurrentVersion))
     MYTHROW(WriteException, ("File:", m_filePath));
-
-  // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(0)), ());
 }
 
 void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
+{
+  ForEach(numeric_limits<double>::lowest(), fn);
+}
+
+void GpsTrackStorage::ForEach(double minTimestamp, std::function<bool(TItem const & item)> const & fn)
 {
   ASSERT(m_stream.is_open(), ());
 
-  size_t i = GetFirstItemIndex();
+  ForEachImpl(GetFirstItemIndex(), minTimestamp, fn);
+}
+
+double GpsTrackStorage::GetLastTimestamp() const
+{
+  return m_itemCount == 0 ? 0.0 : m_lastItem.m_timestamp;
+}
+
+void GpsTrackStorage::ForEachImpl(size_t firstItemIndex, double minTimestamp,
+                                  std::function<bool(TItem const & item)> const & fn)
+{
+  vector<TItem> items;
+  size_t index = 0;
+  for (auto const & block : m_blocks)
+  {
+    size_t const blockIndex = index;
+    index += block.m_itemCount;
+    if (index <= firstItemIndex || block.m_maxTimestamp < minTimestamp)
+      continue;
+
+    ReadBlock(block, items);
+    for (size_t i = firstItemIndex > blockIndex ? firstItemIndex - blockIndex : 0; i < items.size(); ++i)
+    {
+      if (!fn(items[i]))
+        return;
+    }
+  }
+}
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+void GpsTrackStorage::ReadBlock(Block const & block, vector<TItem> & items)
+{
+  vector<uint8_t> payload(block.m_size);
+  m_stream.seekg(block.m_offset + kBlockHeaderSize, ios::beg);
+  m_stream.read(reinterpret_cast<char *>(payload.data()), payload.size());
   if (!m_stream.good())
     MYTHROW(ReadException, ("File:", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  MemReaderWithExceptions reader(payload.data(), payload.size());
+  ReaderSource<MemReaderWithExceptions> src(reader);
+
+  items.resize(block.m_itemCount);
+  TItem prev;
+  for (auto & item : items)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    DecodeItem(src, prev, item);
+    prev = item;
+  }
+}
 
-    m_stream.read(&buff[0], n * kPointSize);
+void GpsTrackStorage::ReadIndex()
+{
+  m_blocks.clear();
+  m_itemCount = 0;
+
+  m_stream.seekg(0, ios::end);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+  auto const fileSize = static_cast<uint64_t>(m_stream.tellg());
+
+  // Only block headers are read here, payloads are read on demand.
+  uint64_t offset = kHeaderSize;
+  while (offset + kBlockHeaderSize <= fileSize)
+  {
+    char buff[kBlockHeaderSize];
+    m_stream.seekg(offset, ios::beg);
+    m_stream.read(buff, kBlockHeaderSize);
     if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+      MYTHROW(OpenException, ("Read block header error:", offset, m_filePath));
 
-    for (size_t j = 0; j < n; ++j)
-    {      
-      TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
-      if (!fn(item))
-        return;
+    Block block;
+    block.m_offset = offset;
+    block.m_size = MemRead<uint32_t>(buff);
+    block.m_itemCount = MemRead<uint32_t>(buff + sizeof(uint32_t));
+    block.m_maxTimestamp = MemRead<double>(buff + 2 * sizeof(uint32_t));
+
+    if (block.m_itemCount == 0 || block.m_itemCount > kItemBlockSize ||
+        block.m_size > block.m_itemCount * kMaxEncodedItemSize ||
+        offset + kBlockHeaderSize + block.m_size > fileSize)
+    {
+      break;
     }
 
-    i += n;
+    m_blocks.push_back(block);
+    m_itemCount += block.m_itemCount;
+    offset += kBlockHeaderSize + block.m_size;
+  }
+
+  if (offset != fileSize)
+  {
+    LOG(LWARNING, ("Broken tail of the track file is dropped:", fileSize - offset, "bytes", m_filePath));
+    m_stream.close();
+    base::FileData(m_filePath, base::FileData::OP_WRITE_EXISTING).Truncate(offset);
+    m_stream.open(m_filePath, ios::in | ios::out | ios::binary);
+    if (!m_stream)
+      MYTHROW(OpenException, ("Open file error.", m_filePath));
+  }
+
+  m_endOffset = offset;
+
+  // The last item is a base for the encoding of the items which are appended to the last block.
+  m_lastItem = TItem();
+  if (!m_blocks.empty())
+  {
+    vector<TItem> items;
+    ReadBlock(m_blocks.back(), items);
+    m_lastItem = items.back();
   }
 }
 
+void GpsTrackStorage::ConvertFixedSizeItems()
+{
+  m_stream.seekg(0, ios::end);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+
+  size_t const itemCount = GetItemCount(static_cast<size_t>(m_stream.tellg()));
+  size_t i = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
+
+  m_stream.seekg(kHeaderSize + i * kPointSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("File:", m_filePath));
+
+  RewriteFile([&](std::function<void(TItem const & item)> const & fn)
+  {
+    vector<char> buff(min(kItemBlockSize, itemCount) * kPointSize);
+    for (; i < itemCount;)
+    {
+      size_t const n = min(itemCount - i, kItemBlockSize);
+
+      m_stream.read(buff.data(), n * kPointSize);
+      if (!m_stream.good())
+        MYTHROW(OpenException, ("File:", m_filePath));
+
+      for (size_t j = 0; j < n; ++j)
+      {
+        TItem item;
+        Unpack(buff.data() + j * kPointSize, item);
+        fn(item);
+      }
+
+      i += n;
+    }
+  });
+}
+
 void GpsTrackStorage::TruncFile()
+{
+  RewriteFile([this](std::function<void(TItem const & item)> const & fn)
+  {
+    ForEachImpl(GetFirstItemIndex(), numeric_limits<double>::lowest(), [&fn](TItem const & item)
+    {
+      fn(item);
+      return true;
+    });
+  });
+}
+
+void GpsTrackStorage::RewriteFile(
+    std::function<void(std::function<void(TItem const & item)> const & fn)> const & forEachItem)
 {
   string const tmpFilePath = m_filePath + ".tmp";
 
@@ -264,34 +497,23 @@ void GpsTrackStorage::TruncFile()
   if (!WriteVersion(tmp, kCurrentVersion))
     MYTHROW(WriteException, ("File:", tmpFilePath));
 
-  size_t i = GetFirstItemIndex();
-
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
-  if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
-
-  size_t newItemCount = 0;
-
   // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<TItem> items;
+  items.reserve(kItemBlockSize);
+  auto const writeBlock = [&]()
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
-
-    m_stream.read(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
-
-    tmp.write(&buff[0], n * kPointSize);
-    if (!tmp.good())
+    if (!items.empty() && !WriteBlock(tmp, items))
       MYTHROW(WriteException, ("File:", tmpFilePath));
+    items.clear();
+  };
 
-    i += n;
-    newItemCount += n;
-  }
-  buff.clear();
-  buff.shrink_to_fit();
+  forEachItem([&](TItem const & item)
+  {
+    items.push_back(item);
+    if (items.size() == kItemBlockSize)
+      writeBlock();
+  });
+  writeBlock();
 
   tmp.close();
   m_stream.close();
@@ -304,16 +526,12 @@ void GpsTrackStorage::TruncFile()
   }
 
   // Reopen stream
-  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::ate);
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary);
 
   if (!m_stream)
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  m_itemCount = newItemCount;
-
-  // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
+  ReadIndex();
 }
 
 size_t GpsTrackStorage::GetFirstItemIndex() const
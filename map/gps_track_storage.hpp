@@ -7,6 +7,7 @@
 
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -39,16 +40,45 @@ public:
   /// @exceptions ReadException if read fails.
   void ForEach(std::function<bool(TItem const & item)> const & fn);
 
+  /// Same as ForEach, but skips the blocks of items which all are older than minTimestamp,
+  /// so only the needed time window is read. Some of the items may still be older.
+  /// @exceptions ReadException if read fails.
+  void ForEach(double minTimestamp, std::function<bool(TItem const & item)> const & fn);
+
+  /// Returns timestamp of the last appended item or 0 when the storage is empty.
+  double GetLastTimestamp() const;
+
 private:
   DISALLOW_COPY_AND_MOVE(GpsTrackStorage);
 
+  // Items are stored in blocks of delta-encoded items, the index of the blocks is read
+  // on opening and kept in memory.
+  struct Block
+  {
+    uint64_t m_offset = 0;
+    uint32_t m_size = 0;  // size of the encoded items
+    uint32_t m_itemCount = 0;
+    double m_maxTimestamp = std::numeric_limits<double>::lowest();
+  };
+
+  void ForEachImpl(size_t firstItemIndex, double minTimestamp,
+                   std::function<bool(TItem const & item)> const & fn);
+  void ReadBlock(Block const & block, std::vector<TItem> & items);
+  void ReadIndex();
+  void ConvertFixedSizeItems();
   void TruncFile();
+  // Writes the items enumerated by |forEachItem| to a new file which replaces the current one.
+  void RewriteFile(
+      std::function<void(std::function<void(TItem const & item)> const & fn)> const & forEachItem);
   size_t GetFirstItemIndex() const;
 
   std::string const m_filePath;
   size_t const m_maxItemCount;
   std::fstream m_stream;
   size_t m_itemCount; // current number of items in file, read note
+  uint64_t m_endOffset; // offset of the end of the last block
+  std::vector<Block> m_blocks;
+  TItem m_lastItem;
 
   // NOTE
   // New items append to the end of file, when file become too big, it is truncated.
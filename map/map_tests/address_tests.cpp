@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace address_tests
 {
@@ -104,4 +105,53 @@ UNIT_TEST(ReverseGeocoder_Smoke)
     TestAddress(coder, mwmInfo, {53.89745, 27.55835}, streetNames, "18А");
   }
 }
+
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  LocalCountryFile file = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto const regResult = dataSource.RegisterMap(file);
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+  ReverseGeocoder coder(dataSource);
+
+  std::vector<m2::PointD> centers;
+  for (auto const & ll : {ms::LatLon(53.89815, 27.54265), ms::LatLon(53.8997617, 27.5429365),
+                          ms::LatLon(53.89666, 27.54904), ms::LatLon(53.89724, 27.54983),
+                          ms::LatLon(53.89745, 27.55835), ms::LatLon(0.0, 0.0)})
+  {
+    centers.push_back(mercator::FromLatLon(ll));
+  }
+  std::vector<std::string> const expectedHouseNumbers = {"32", "40", "19", "11", "18А"};
+
+  // Points of a track which are close to each other.
+  for (size_t i = 0; i < 50; ++i)
+    centers.push_back(mercator::FromLatLon({53.8967 + i * 1e-5, 27.5490 + i * 2e-5}));
+
+  std::vector<ReverseGeocoder::Address> expected;
+  coder.GetNearbyAddresses(centers, ReverseGeocoder::kLookupRadiusM, expected);
+  TEST_EQUAL(expected.size(), centers.size(), ());
+
+  for (size_t i = 0; i < expectedHouseNumbers.size(); ++i)
+    TEST_EQUAL(expected[i].GetHouseNumber(), expectedHouseNumbers[i], (expected[i]));
+  TEST(!expected[expectedHouseNumbers.size()].IsValid(), ());
+
+  for (size_t i = expectedHouseNumbers.size() + 1; i < centers.size(); ++i)
+  {
+    TEST(expected[i].IsValid(), (i));
+    TEST_LESS_OR_EQUAL(expected[i].GetDistance(), ReverseGeocoder::kLookupRadiusM, (i));
+  }
+
+  std::vector<ReverseGeocoder::Address> actual;
+  coder.GetNearbyAddresses(centers, ReverseGeocoder::kLookupRadiusM, actual, 4 /* threadsCount */);
+  TEST_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < actual.size(); ++i)
+  {
+    TEST_EQUAL(actual[i].m_building.m_id, expected[i].m_building.m_id, (i));
+    TEST_EQUAL(actual[i].m_street.m_id, expected[i].m_street.m_id, (i));
+  }
+}
 } // namespace address_tests
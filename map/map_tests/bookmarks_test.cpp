@@ -1201,6 +1201,42 @@ UNIT_CLASS_TEST(Runner, TrackParsingTest_2)
   TEST_EQUAL(track->GetColor(0), dp::Color(57, 255, 32, 255), ());
 }
 
+UNIT_TEST(Track_SelectionInfo)
+{
+  // A long zigzag line, so the segments index of the track has several levels.
+  kml::TrackData data;
+  data.m_id = 1;
+  kml::MultiGeometry::LineT line;
+  size_t constexpr kPointsCount = 10000;
+  for (size_t i = 0; i < kPointsCount; ++i)
+    line.emplace_back(m2::PointD(i * 0.001, (i % 2) * 0.001));
+  data.m_geometry.m_lines.push_back(line);
+  Track const track(std::move(data), false /* interactive */);
+
+  auto const getSelection = [&track](m2::PointD const & pt)
+  {
+    Track::TrackSelectionInfo info;
+    track.UpdateSelectionInfo(m2::RectD(pt.x - 0.0002, pt.y - 0.0002, pt.x + 0.0002, pt.y + 0.0002), info);
+    return info;
+  };
+
+  for (size_t i : {size_t(0), size_t(31), size_t(32), size_t(5000), kPointsCount - 2})
+  {
+    auto const & pt1 = line[i].GetPoint();
+    auto const pt = pt1 + (line[i + 1].GetPoint() - pt1) * 0.5;
+    auto const info = getSelection(pt);
+    TEST_EQUAL(info.m_trackId, 1, (i));
+    TEST(info.m_trackPoint.EqualDxDy(pt, 1e-9), (i, info.m_trackPoint, pt));
+    double expectedDist = mercator::DistanceOnEarth(pt1, pt);
+    for (size_t j = 0; j < i; ++j)
+      expectedDist += mercator::DistanceOnEarth(line[j].GetPoint(), line[j + 1].GetPoint());
+    TEST_ALMOST_EQUAL_ABS(info.m_distFromBegM, expectedDist, 1e-3, (i));
+  }
+
+  TEST_EQUAL(getSelection({5.0, 1.0}).m_trackId, kml::kInvalidTrackId, ());
+  TEST_EQUAL(getSelection({-1.0, 0.0}).m_trackId, kml::kInvalidTrackId, ());
+}
+
 UNIT_CLASS_TEST(Runner, Bookmarks_Listeners)
 {
   struct Changes
@@ -5,6 +5,7 @@
 #include "geometry/point_with_altitude.hpp"
 #include "base/math.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -261,4 +262,76 @@ UNIT_TEST(GenerateChart_Test)
                230 /* expectedG */, 140 /* expectedB */, 255 /* expectedA */),
        ());
 }
+
+UNIT_TEST(AltitudeChartPyramid_InterpolationTest)
+{
+  vector<double> const distanceDataM = {0.0, 100.0};
+  geometry::Altitudes const altitudeDataM = {0, 1000};
+
+  AltitudeChartPyramid pyramid;
+  TEST(pyramid.Build(distanceDataM, altitudeDataM), ());
+
+  vector<m2::PointD> chartDataM;
+  pyramid.GetChartData(AltitudeChartPyramid::kBasePointCount * 2, chartDataM);
+  TEST_EQUAL(chartDataM.size(), AltitudeChartPyramid::kBasePointCount * 2, ());
+  TEST(base::AlmostEqualAbs(chartDataM.front().y, 0.0, kEpsilon), ());
+  TEST(base::AlmostEqualAbs(chartDataM.back().y, 1000.0, kEpsilon), ());
+  TEST(base::AlmostEqualAbs(chartDataM.back().x, AltitudeChartPyramid::kBasePointCount * 2.0,
+                            kEpsilon), ());
+}
+
+UNIT_TEST(AltitudeChartPyramid_PeakTest)
+{
+  // A narrow peak which falls between the points of a uniform chart of 10 points.
+  vector<double> distanceDataM = {0.0};
+  geometry::Altitudes altitudeDataM = {0};
+  for (size_t i = 1; i < 10000; ++i)
+  {
+    distanceDataM.push_back(static_cast<double>(i));
+    altitudeDataM.push_back(i == 5050 ? 500 : 0);
+  }
+
+  vector<double> uniformAltitudeDataM;
+  TEST(maps::NormalizeChartData(distanceDataM, altitudeDataM, 10 /* resultPointCount */,
+                                uniformAltitudeDataM), ());
+  TEST_EQUAL(*max_element(uniformAltitudeDataM.cbegin(), uniformAltitudeDataM.cend()), 0.0, ());
+
+  AltitudeChartPyramid pyramid;
+  TEST(pyramid.Build(distanceDataM, altitudeDataM), ());
+
+  vector<m2::PointD> chartDataM;
+  pyramid.GetChartData(10 /* width */, chartDataM);
+  TEST_GREATER(chartDataM.size(), 10, ());
+  TEST_LESS_OR_EQUAL(chartDataM.size(), 20, ());
+  auto const maxIt = max_element(chartDataM.cbegin(), chartDataM.cend(),
+                                 [](m2::PointD const & p1, m2::PointD const & p2) { return p1.y < p2.y; });
+  TEST_GREATER(maxIt->y, 0.0, ());
+  TEST(is_sorted(chartDataM.cbegin(), chartDataM.cend(),
+                 [](m2::PointD const & p1, m2::PointD const & p2) { return p1.x < p2.x; }), ());
+}
+
+UNIT_TEST(AltitudeChartPyramid_GenerateChartTest)
+{
+  size_t constexpr width = 50;
+  vector<double> const distanceDataM = {0.0, 100.0};
+  geometry::Altitudes const altitudeDataM = {0, 1000};
+
+  AltitudeChartPyramid pyramid;
+  TEST(pyramid.Build(distanceDataM, altitudeDataM), ());
+
+  vector<uint8_t> frameBuffer;
+  TEST(maps::GenerateChart(width, 50 /* height */, pyramid, MapStyleDark /* mapStyle */, frameBuffer), ());
+  TEST(IsColor(frameBuffer, 0 /* startColorIdx */, 255 /* expectedR */, 255 /* expectedG */,
+               255 /* expectedB */, 0 /* expectedA */),
+       ());
+  TEST(IsColor(frameBuffer, kAltitudeChartBPP * 3 * width -
+               kAltitudeChartBPP /* startColorIdx */, 255 /* expectedR */,
+               230 /* expectedG */, 140 /* expectedB */, 255 /* expectedA */),
+       ());
+
+  AltitudeChartPyramid const emptyPyramid;
+  TEST(maps::GenerateChart(width, 50 /* height */, emptyPyramid, MapStyleDark /* mapStyle */, frameBuffer), ());
+  TestAngleColors(width, 50 /* height */, frameBuffer, 255 /* expectedR */, 255 /* expectedG */,
+                  255 /* expectedB */, 0 /* expectedA */);
+}
 }  // namespace
@@ -12,6 +12,7 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <vector>
@@ -186,4 +187,102 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+UNIT_TEST(GpsTrackStorage_AppendByOneItem)
+{
+  double const timestamp = system_clock::to_time_t(system_clock::now());
+
+  string const filePath = GetGpsTrackFilePath();
+  SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+  size_t const itemCount = 2500;
+
+  vector<location::GpsInfo> points;
+  points.reserve(itemCount);
+  for (size_t i = 0; i < itemCount; ++i)
+    points.emplace_back(Make(timestamp + i, ms::LatLon(55.75 + i * 1e-5, 37.61 - i * 1e-5), 10 + i % 3));
+
+  // Items are appended one by one and the storage is reopened several times.
+  for (size_t i = 0; i < itemCount;)
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    for (size_t const end = min(i + 700, itemCount); i < end; ++i)
+      stg.Append({points[i]});
+  }
+
+  // Items of the same batch are stored in one block, so they take less space than
+  // the plain values.
+  uint64_t fileSize = 0;
+  TEST(Platform::GetFileSizeByFullPath(filePath, fileSize), ());
+  TEST_LESS(fileSize, itemCount * 8 * sizeof(double) / 2, ());
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  TEST_EQUAL(stg.GetLastTimestamp(), points.back().m_timestamp, ());
+
+  size_t i = 0;
+  stg.ForEach([&](location::GpsInfo const & point)->bool
+  {
+    TEST_EQUAL(point.m_latitude, points[i].m_latitude, ());
+    TEST_EQUAL(point.m_longitude, points[i].m_longitude, ());
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    TEST_EQUAL(point.m_speedMpS, points[i].m_speedMpS, ());
+    TEST(point.m_source == points[i].m_source, ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, itemCount, ());
+
+  // Blocks with old items only are skipped.
+  size_t count = 0;
+  double const minTimestamp = points[2200].m_timestamp;
+  stg.ForEach(minTimestamp, [&](location::GpsInfo const & point)->bool
+  {
+    if (count == 0)
+      TEST_LESS_OR_EQUAL(point.m_timestamp, minTimestamp, ());
+    ++count;
+    return true;
+  });
+  TEST_GREATER_OR_EQUAL(count, itemCount - 2200, ());
+  TEST_LESS(count, itemCount, ());
+}
+
+UNIT_TEST(GpsTrackStorage_BrokenTail)
+{
+  double const timestamp = system_clock::to_time_t(system_clock::now());
+
+  string const filePath = GetGpsTrackFilePath();
+  SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 1000;
+  vector<location::GpsInfo> points;
+  for (size_t i = 0; i < 10; ++i)
+    points.emplace_back(Make(timestamp + i, ms::LatLon(-30 + i, -60 + i), 5 + i));
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    stg.Append(points);
+  }
+
+  // Emulate an interrupted write.
+  {
+    FileWriter writer(filePath, FileWriter::OP_APPEND);
+    char const garbage[] = "garbage";
+    writer.Write(garbage, sizeof(garbage));
+  }
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  stg.Append({Make(timestamp + 10, ms::LatLon(0, 0), 1)});
+
+  size_t i = 0;
+  stg.ForEach([&](location::GpsInfo const & point)->bool
+  {
+    if (i < points.size())
+      TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, points.size() + 1, ());
+}
 } // namespace gps_track_storage_test
@@ -285,4 +285,39 @@ UNIT_TEST(PowerManager_OnBatteryLevelChanged)
     TEST_EQUAL(subscriber.m_onFacilityEvents[i].m_state, true, ());
   }
 }
+
+UNIT_TEST(PowerManager_IsPowerSavingMode)
+{
+  auto const configPath = PowerManager::GetConfigPath();
+  SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, std::cref(configPath)));
+  PowerManager manager;
+
+  TEST(!manager.IsPowerSavingMode(), ());
+
+  manager.SetScheme(Scheme::EconomyMedium);
+  TEST(manager.IsPowerSavingMode(), ());
+
+  manager.SetScheme(Scheme::EconomyMaximum);
+  TEST(manager.IsPowerSavingMode(), ());
+
+  manager.SetScheme(Scheme::Normal);
+  TEST(!manager.IsPowerSavingMode(), ());
+
+  manager.SetScheme(Scheme::Auto);
+  manager.OnBatteryLevelReceived(50);
+  TEST(!manager.IsPowerSavingMode(), ());
+
+  manager.OnBatteryLevelReceived(28);
+  TEST(manager.IsPowerSavingMode(), ());
+
+  manager.OnBatteryLevelReceived(10);
+  TEST(manager.IsPowerSavingMode(), ());
+
+  manager.OnBatteryLevelReceived(100);
+  TEST(!manager.IsPowerSavingMode(), ());
+
+  manager.SetFacility(Facility::Buildings3d, false);
+  TEST_EQUAL(manager.GetScheme(), Scheme::None, ());
+  TEST(!manager.IsPowerSavingMode(), ());
+}
 }  // namespace
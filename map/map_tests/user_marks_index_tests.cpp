@@ -0,0 +1,67 @@
+#include "testing/testing.hpp"
+
+#include "map/user_marks_index.hpp"
+
+#include "base/stl_helpers.hpp"
+
+#include <map>
+#include <vector>
+
+namespace user_marks_index_tests
+{
+std::vector<kml::MarkId> GetMarksInRect(UserMarksIndex & index, kml::MarkIdSet const & marks,
+                                        std::map<kml::MarkId, m2::PointD> const & points,
+                                        m2::RectD const & rect)
+{
+  index.Update(marks, [&points](kml::MarkId markId) { return points.at(markId); });
+
+  std::vector<kml::MarkId> result;
+  index.ForEachInRect(rect, [&result](kml::MarkId markId) { result.push_back(markId); });
+  base::SortUnique(result);
+  return result;
+}
+
+UNIT_TEST(UserMarksIndex_Smoke)
+{
+  std::map<kml::MarkId, m2::PointD> const points = {
+      {1, {0.0, 0.0}}, {2, {1.0, 1.0}}, {3, {5.0, 5.0}}, {4, {1.5, 0.5}}};
+  m2::RectD const rect(-0.5, -0.5, 2.0, 2.0);
+
+  UserMarksIndex index;
+  kml::MarkIdSet marks = {1, 2, 3};
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>({1, 2}), ());
+  TEST_EQUAL(index.GetSize(), 3, ());
+
+  marks.insert(4);
+  index.OnAttach(4);
+  marks.erase(1);
+  index.OnDetach(1);
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>({2, 4}), ());
+  TEST_EQUAL(index.GetSize(), 3, ());
+
+  // Detaching of a mark which isn't indexed yet.
+  marks.insert(1);
+  index.OnAttach(1);
+  marks.erase(1);
+  index.OnDetach(1);
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>({2, 4}), ());
+
+  index.Clear();
+  marks.clear();
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>(), ());
+}
+
+UNIT_TEST(UserMarksIndex_MarksAddedDirectly)
+{
+  std::map<kml::MarkId, m2::PointD> const points = {{1, {0.0, 0.0}}, {2, {1.0, 1.0}}};
+  m2::RectD const rect(-0.5, -0.5, 2.0, 2.0);
+
+  UserMarksIndex index;
+  kml::MarkIdSet marks = {1};
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>({1}), ());
+
+  // The index is rebuilt since it doesn't match the marks.
+  marks.insert(2);
+  TEST_EQUAL(GetMarksInRect(index, marks, points, rect), std::vector<kml::MarkId>({1, 2}), ());
+}
+}  // namespace user_marks_index_tests
@@ -100,6 +100,13 @@ void Info::SetFromFeatureType(FeatureType & ft)
   m_hotelType = ftypes::IsHotelChecker::Instance().GetHotelType(ft);
 }
 
+void Info::SetPendingAddress(std::string && address)
+{
+  m_pendingAddressPoint.reset();
+  m_address = std::move(address);
+  m_uiAddress = m_address;
+}
+
 void Info::SetMercator(m2::PointD const & mercator)
 {
   m_mercator = mercator;
@@ -143,6 +143,11 @@ public:
   void SetCustomNames(std::string const & title, std::string const & subtitle);
   void SetCustomNameWithCoordinates(m2::PointD const & mercator, std::string const & name);
   void SetAddress(std::string && address) { m_address = std::move(address); }
+  /// Address which isn't a part of the title is looked up in background at |pt|,
+  /// see Framework::FillPendingAddress().
+  void SetAddressPending(m2::PointD const & pt) { m_pendingAddressPoint = pt; }
+  std::optional<m2::PointD> const & GetPendingAddressPoint() const { return m_pendingAddressPoint; }
+  void SetPendingAddress(std::string && address);
   void SetCanEditOrAdd(bool canEditOrAdd) { m_canEditOrAdd = canEditOrAdd; }
   void SetLocalizedWifiString(std::string const & str) { m_localizedWifiString = str; }
 
@@ -261,6 +266,7 @@ private:
   std::string m_apiUrl;
   /// Formatted feature address for inner using.
   std::string m_address;
+  std::optional<m2::PointD> m_pendingAddressPoint;
 
   /// Routing
   RouteMarkType m_routeMarkType;
@@ -154,6 +154,19 @@ Scheme const & PowerManager::GetScheme() const
   return m_config.m_scheme;
 }
 
+bool PowerManager::IsPowerSavingMode() const
+{
+  switch (m_config.m_scheme)
+  {
+  case Scheme::EconomyMedium:
+  case Scheme::EconomyMaximum: return true;
+  case Scheme::Auto: return m_config.m_facilities != GetFacilitiesState(AutoScheme::Normal);
+  case Scheme::None:
+  case Scheme::Normal: return false;
+  }
+  UNREACHABLE();
+}
+
 void PowerManager::OnBatteryLevelReceived(uint8_t level)
 {
   CHECK_LESS_OR_EQUAL(level, 100, ());
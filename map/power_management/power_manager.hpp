@@ -34,6 +34,9 @@ public:
   bool IsFacilityEnabled(Facility const facility) const;
   FacilitiesState const & GetFacilities() const;
   Scheme const & GetScheme() const;
+  // Returns true if one of the economy schemes is in use, including the ones
+  // which are chosen by Scheme::Auto.
+  bool IsPowerSavingMode() const;
 
   // BatteryLevelTracker::Subscriber overrides:
   void OnBatteryLevelReceived(uint8_t level) override;
@@ -6,6 +6,7 @@
 #include "routing/absent_regions_finder.hpp"
 #include "routing/checkpoint_predictor.hpp"
 #include "routing/index_router.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/routing_helpers.hpp"
@@ -55,6 +56,11 @@ string const kRoutePointsFile = "route_points.dat";
 
 uint32_t constexpr kInvalidTransactionId = 0;
 
+// Road geometry decoded for a route is reused by route rebuilds and by the next routes.
+size_t constexpr kSharedRoadGeometryCacheBytes = 16 * 1024 * 1024;
+// The router is warmed up again when the user moves further from the previous warm-up point.
+double constexpr kRouterWarmUpDistanceM = 10000;
+
 void FillTurnsDistancesForRendering(vector<RouteSegment> const & segments,
                                     double baseDistance, vector<double> & turns)
 {
@@ -314,6 +320,8 @@ RoutingManager::RoutingManager(Callbacks && callbacks, Delegate & delegate)
   , m_extrapolator(
         [this](location::GpsInfo const & gpsInfo) { this->OnExtrapolatedLocationUpdate(gpsInfo); })
 {
+  RoadGeometryCache::Instance().SetMemoryBudget(kSharedRoadGeometryCacheBytes);
+
   m_routingSession.Init(
 #ifdef SHOW_ROUTE_DEBUG_MARKS
                         [this](m2::PointD const & pt) {
@@ -469,6 +477,14 @@ void RoutingManager::OnRoutePointPassed(RouteMarkType type, size_t intermediateI
 void RoutingManager::OnLocationUpdate(location::GpsInfo const & info)
 {
   m_extrapolator.OnLocationUpdate(info);
+
+  // Routing data near the user is loaded in background, so the first route is as fast as the next ones.
+  auto const point = mercator::FromLatLon(info.m_latitude, info.m_longitude);
+  if (!m_warmUpPoint || mercator::DistanceOnEarth(*m_warmUpPoint, point) > kRouterWarmUpDistanceM)
+  {
+    m_warmUpPoint = point;
+    m_routingSession.WarmUpRouter(point);
+  }
 }
 
 RouterType RoutingManager::GetBestRouter(m2::PointD const & startPoint,
@@ -541,6 +557,7 @@ void RoutingManager::SetRouterImpl(RouterType type)
   m_routingSession.SetRoutingSettings(GetRoutingSettings(vehicleType));
   m_routingSession.SetRouter(std::move(router), std::move(regionsFinder));
   m_currentRouterType = type;
+  m_warmUpPoint.reset();
 }
 
 void RoutingManager::RemoveRoute(bool deactivateFollowing)
@@ -1243,6 +1260,8 @@ void RoutingManager::DistanceAltitude::Simplify(double altitudeDeviation)
   // 2. Default square distance from segment.
   SimplifyDefault(IterT(*this, true), IterT(*this, false), base::Pow2(altitudeDeviation), out);
 
+  m_chartPyramid = {};
+
   size_t const count = out.size();
   m_distances.resize(count);
   m_altitudes.resize(count);
@@ -1259,7 +1278,10 @@ bool RoutingManager::DistanceAltitude::GenerateRouteAltitudeChart(
   if (GetSize() == 0)
     return false;
 
-  return maps::GenerateChart(width, height, m_distances, m_altitudes, GetStyleReader().GetCurrentStyle(), imageRGBAData);
+  if (m_chartPyramid.IsEmpty() && !m_chartPyramid.Build(m_distances, m_altitudes))
+    return false;
+
+  return maps::GenerateChart(width, height, m_chartPyramid, GetStyleReader().GetCurrentStyle(), imageRGBAData);
 }
 
 void RoutingManager::DistanceAltitude::CalculateAscentDescent(uint32_t & totalAscentM, uint32_t & totalDescentM) const
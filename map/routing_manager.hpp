@@ -1,6 +1,7 @@
 #pragma once
 
 #include "map/bookmark_manager.hpp"
+#include "map/chart_generator.hpp"
 #include "map/extrapolation/extrapolator.hpp"
 #include "map/routing_mark.hpp"
 #include "map/transit/transit_display.hpp"
@@ -29,6 +30,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -285,6 +287,7 @@ public:
     /// \returns If there is valid route info and the chart was generated returns true
     /// and false otherwise. If the method returns true it is guaranteed that the size of
     /// |imageRGBAData| is not zero.
+    /// The altitude pyramid is built on the first call, so charts of other sizes are cheap.
     bool GenerateRouteAltitudeChart(uint32_t width, uint32_t height, std::vector<uint8_t> & imageRGBAData) const;
 
     /// \param totalAscent is total ascent of the route in meters.
@@ -292,6 +295,9 @@ public:
     void CalculateAscentDescent(uint32_t & totalAscentM, uint32_t & totalDescentM) const;
 
     friend std::string DebugPrint(DistanceAltitude const & da);
+
+  private:
+    mutable maps::AltitudeChartPyramid m_chartPyramid;
   };
 
   /// \brief Fills altitude of current route points and distance in meters form the beginning
@@ -374,6 +380,8 @@ private:
   df::DrapeEngineSafePtr m_drapeEngine;
   routing::RouterType m_currentRouterType = routing::RouterType::Count;
   bool m_loadAltitudes = false;
+  // The point near which the current router was warmed up last time.
+  std::optional<m2::PointD> m_warmUpPoint;
   routing::RoutingSession m_routingSession;
   Delegate & m_delegate;
 
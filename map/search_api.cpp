@@ -19,6 +19,7 @@
 #include <iterator>
 #include <map>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 using namespace search;
@@ -31,6 +32,17 @@ using BookmarkIdDoc = pair<bookmarks::Id, bookmarks::Doc>;
 double const kDistEqualQueryMeters = 100.0;
 double const kDistEqualQueryMercator = mercator::MetersToMercator(kDistEqualQueryMeters);
 
+// Retrieval threads make "everywhere" queries over many mwms faster,
+// a few threads are enough since matching stays sequential.
+size_t constexpr kMaxRetrievalThreads = 4;
+
+Engine::Params MakeEngineParams(size_t numThreads)
+{
+  Engine::Params params(languages::GetCurrentTwine() /* locale */, numThreads);
+  params.m_numRetrievalThreads = min<size_t>(thread::hardware_concurrency() / 2, kMaxRetrievalThreads);
+  return params;
+}
+
 // Cancels search query by |handle|.
 void CancelQuery(weak_ptr<ProcessorHandle> & handle)
 {
@@ -145,8 +157,7 @@ SearchAPI::SearchAPI(DataSource & dataSource, storage::Storage const & storage,
   , m_storage(storage)
   , m_infoGetter(infoGetter)
   , m_delegate(delegate)
-  , m_engine(m_dataSource, GetDefaultCategories(), m_infoGetter,
-             Engine::Params(languages::GetCurrentTwine() /* locale */, numThreads))
+  , m_engine(m_dataSource, GetDefaultCategories(), m_infoGetter, MakeEngineParams(numThreads))
 {
 }
 
@@ -186,6 +197,7 @@ bool SearchAPI::SearchEverywhere(EverywhereSearchParams params)
   p.m_needAddress = true;
   p.m_needHighlighting = true;
   p.m_categorialRequest = params.m_isCategory;
+  p.m_earlyTermination = true;
   if (params.m_timeout)
     p.m_timeout = *params.m_timeout;
 
@@ -6,10 +6,14 @@
 #include "geometry/mercator.hpp"
 #include "geometry/rect_intersect.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace
 {
+size_t constexpr kSegmentsPerBlock = 32;
+size_t constexpr kRectsPerNode = 8;
+
 bool GetTrackPoint(std::vector<geometry::PointWithAltitude> const & points,
                    std::vector<double> const & lengths, double distanceInMeters, m2::PointD & pt)
 {
@@ -70,6 +74,78 @@ Track::Track(kml::TrackData && data, bool interactive)
   CHECK(m_data.m_geometry.IsValid(), ());
   if (interactive && HasAltitudes())
     CacheDataForInteraction();
+  BuildSegmentsIndex();
+}
+
+void Track::BuildSegmentsIndex()
+{
+  m_segmentsIndex.clear();
+  m_segmentsIndex.reserve(m_data.m_geometry.m_lines.size());
+  for (auto const & line : m_data.m_geometry.m_lines)
+  {
+    auto & levels = m_segmentsIndex.emplace_back().m_levels;
+    if (line.size() < 2)
+      continue;
+
+    size_t const segmentsCount = line.size() - 1;
+    auto & blocks = levels.emplace_back();
+    blocks.reserve((segmentsCount + kSegmentsPerBlock - 1) / kSegmentsPerBlock);
+    for (size_t i = 0; i < segmentsCount; i += kSegmentsPerBlock)
+    {
+      m2::RectD rect;
+      size_t const last = std::min(i + kSegmentsPerBlock, segmentsCount);
+      for (size_t j = i; j <= last; ++j)
+        rect.Add(line[j].GetPoint());
+      blocks.push_back(rect);
+    }
+
+    while (levels.back().size() > 1)
+    {
+      std::vector<m2::RectD> nodes;
+      auto const & prev = levels.back();
+      nodes.reserve((prev.size() + kRectsPerNode - 1) / kRectsPerNode);
+      for (size_t i = 0; i < prev.size(); i += kRectsPerNode)
+      {
+        m2::RectD rect;
+        size_t const last = std::min(i + kRectsPerNode, prev.size());
+        for (size_t j = i; j < last; ++j)
+          rect.Add(prev[j]);
+        nodes.push_back(rect);
+      }
+      levels.push_back(std::move(nodes));
+    }
+  }
+}
+
+template <typename Fn>
+void Track::ForEachSegmentInRect(size_t lineIndex, m2::RectD const & rect, Fn && fn) const
+{
+  auto const & levels = m_segmentsIndex[lineIndex].m_levels;
+  if (levels.empty())
+    return;
+
+  size_t const segmentsCount = m_data.m_geometry.m_lines[lineIndex].size() - 1;
+  // Segments are visited in ascending order, as by the plain loop over the line.
+  auto const visit = [&](auto const & self, size_t level, size_t index) -> void
+  {
+    if (!levels[level][index].IsIntersect(rect))
+      return;
+
+    if (level == 0)
+    {
+      size_t const first = index * kSegmentsPerBlock;
+      size_t const last = std::min(first + kSegmentsPerBlock, segmentsCount);
+      for (size_t i = first; i < last; ++i)
+        fn(i);
+      return;
+    }
+
+    size_t const first = index * kRectsPerNode;
+    size_t const last = std::min(first + kRectsPerNode, levels[level - 1].size());
+    for (size_t i = first; i < last; ++i)
+      self(self, level - 1, i);
+  };
+  visit(visit, levels.size() - 1, 0);
 }
 
 void Track::CacheDataForInteraction()
@@ -179,20 +255,22 @@ void Track::UpdateSelectionInfo(m2::RectD const & touchRect, TrackSelectionInfo
   if (m_interactionData && !m_interactionData->m_limitRect.IsIntersect(touchRect))
     return;
 
-  for (auto const & line : m_data.m_geometry.m_lines)
+  auto const & lines = m_data.m_geometry.m_lines;
+  for (size_t lineIndex = 0; lineIndex < lines.size(); ++lineIndex)
   {
-    for (size_t i = 0; i + 1 < line.size(); ++i)
+    auto const & line = lines[lineIndex];
+    ForEachSegmentInRect(lineIndex, touchRect, [&](size_t i)
     {
       auto pt1 = line[i].GetPoint();
       auto pt2 = line[i + 1].GetPoint();
       if (!m2::Intersect(touchRect, pt1, pt2))
-        continue;
+        return;
 
       m2::ParametrizedSegment<m2::PointD> seg(pt1, pt2);
       auto const closestPoint = seg.ClosestPointTo(touchRect.Center());
       auto const squaredDist = closestPoint.SquaredLength(touchRect.Center());
       if (squaredDist >= info.m_squareDist)
-        continue;
+        return;
 
       info.m_squareDist = squaredDist;
       info.m_trackId = m_data.m_id;
@@ -200,7 +278,7 @@ void Track::UpdateSelectionInfo(m2::RectD const & touchRect, TrackSelectionInfo
 
       auto const segDistInMeters = mercator::DistanceOnEarth(line[i].GetPoint(), closestPoint);
       info.m_distFromBegM = segDistInMeters + GetLengthMetersImpl(line, i);
-    }
+    });
   }
 }
 
@@ -5,6 +5,7 @@
 #include "drape_frontend/user_marks_provider.hpp"
 
 #include <string>
+#include <vector>
 
 class Track : public df::UserLineMark
 {
@@ -73,6 +74,10 @@ private:
   void CacheDataForInteraction();
   bool HasAltitudes() const;
 
+  void BuildSegmentsIndex();
+  template <typename Fn>
+  void ForEachSegmentInRect(size_t lineIndex, m2::RectD const & rect, Fn && fn) const;
+
   double GetLengthMetersImpl(kml::MultiGeometry::LineT const & line, size_t ptIdx) const;
 
   kml::TrackData m_data;
@@ -85,5 +90,15 @@ private:
   };
   std::optional<InteractionData> m_interactionData;
 
+  // Bounding rects of the segments of a line. A rect of the first level covers
+  // kSegmentsPerBlock consecutive segments, a rect of each next level covers kRectsPerNode
+  // rects of the previous one, the last level has a single rect.
+  struct SegmentsIndex
+  {
+    std::vector<std::vector<m2::RectD>> m_levels;
+  };
+  // One index per line of the geometry.
+  std::vector<SegmentsIndex> m_segmentsIndex;
+
   mutable bool m_isDirty = true;
 };
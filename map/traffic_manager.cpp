@@ -115,6 +115,7 @@ void TrafficManager::Clear()
   m_activeRoutingMwms.clear();
   m_requestedMwms.clear();
   m_trafficETags.clear();
+  m_lastTrafficInfos.clear();
 }
 
 void TrafficManager::SetDrapeEngine(ref_ptr<df::DrapeEngine> engine)
@@ -236,14 +237,19 @@ void TrafficManager::ThreadRoutine()
       if (!mwm.IsAlive())
         continue;
 
-      traffic::TrafficInfo info(mwm, m_currentDataVersion);
-
       std::string tag;
+      std::optional<traffic::TrafficInfo> lastInfo;
       {
         std::lock_guard<std::mutex> lock(m_mutex);
         tag = m_trafficETags[mwm];
+        auto const it = m_lastTrafficInfos.find(mwm);
+        if (it != m_lastTrafficInfos.cend())
+          lastInfo = it->second;
       }
 
+      traffic::TrafficInfo info = lastInfo ? traffic::TrafficInfo(*lastInfo, m_currentDataVersion)
+                                           : traffic::TrafficInfo(mwm, m_currentDataVersion);
+
       if (info.ReceiveTrafficData(tag))
       {
         OnTrafficDataResponse(std::move(info));
@@ -340,6 +346,9 @@ void TrafficManager::OnTrafficRequestFailed(traffic::TrafficInfo && info)
   it->second.m_isWaitingForResponse = false;
   it->second.m_lastAvailability = info.GetAvailability();
 
+  // The values may not correspond to the ETag anymore, so the next request is the full one.
+  m_lastTrafficInfos.erase(info.GetMwmId());
+
   if (info.GetAvailability() == traffic::TrafficInfo::Availability::Unknown &&
       !it->second.m_isLoaded)
   {
@@ -373,11 +382,14 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
     it->second.m_isWaitingForResponse = false;
     it->second.m_lastAvailability = info.GetAvailability();
 
-    if (!info.GetColoring().empty())
+    // The keys and the values are reused by the next request of the mwm.
+    if (info.HasValues())
+      m_lastTrafficInfos.insert_or_assign(info.GetMwmId(), info);
+
+    if (!info.GetColoring().IsEmpty())
     {
       // Update cache.
-      size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::RoadSegmentId) + sizeof(traffic::SpeedGroup);
-      size_t const dataSize = info.GetColoring().size() * kElementSize;
+      size_t const dataSize = info.GetColoring().GetMemorySize();
       m_currentCacheSizeBytes += (dataSize - it->second.m_dataSize);
       it->second.m_dataSize = dataSize;
       ShrinkCacheToAllowableSize();
@@ -386,7 +398,7 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
     UpdateState();
   }
 
-  if (!info.GetColoring().empty())
+  if (!info.GetColoring().IsEmpty())
   {
     m_drapeEngine.SafeCall(&df::DrapeEngine::UpdateTraffic,
                            static_cast<traffic::TrafficInfo const &>(info));
@@ -444,6 +456,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   }
   m_mwmCache.erase(it);
   m_trafficETags.erase(mwmId);
+  m_lastTrafficInfos.erase(mwmId);
   m_activeDrapeMwms.erase(mwmId);
   m_activeRoutingMwms.erase(mwmId);
   m_lastDrapeMwmsByRect.clear();
@@ -179,6 +179,8 @@ private:
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
   std::map<MwmSet::MwmId, std::string> m_trafficETags;
+  // The last received traffic of the mwms with the values which correspond to m_trafficETags.
+  std::map<MwmSet::MwmId, traffic::TrafficInfo> m_lastTrafficInfos;
 
   std::atomic<bool> m_isPaused;
 
@@ -26,6 +26,7 @@ void UserMarkLayer::Clear()
   SetDirty();
   m_userMarks.clear();
   m_tracks.clear();
+  m_marksIndex.Clear();
 }
 
 bool UserMarkLayer::IsEmpty() const
@@ -52,12 +53,14 @@ void UserMarkLayer::AttachUserMark(kml::MarkId markId)
 {
   SetDirty();
   m_userMarks.insert(markId);
+  m_marksIndex.OnAttach(markId);
 }
 
 void UserMarkLayer::DetachUserMark(kml::MarkId markId)
 {
   SetDirty();
   m_userMarks.erase(markId);
+  m_marksIndex.OnDetach(markId);
 }
 
 void UserMarkLayer::AttachTrack(kml::TrackId trackId)
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "map/user_mark.hpp"
+#include "map/user_marks_index.hpp"
 
 #include <base/macros.hpp>
 
+#include <utility>
+
 
 class UserMarkLayer
 {
@@ -30,6 +33,16 @@ public:
   void Clear();
   bool IsEmpty() const;
 
+  // Calls |fn| for ids of the marks which may be inside |rect|. |getPivot| returns positions
+  // of the marks to index. Positions must be fixed, so it's used for bookmark categories only.
+  template <typename Fn>
+  void ForEachUserMarkInRect(m2::RectD const & rect, UserMarksIndex::GetPivotFn const & getPivot,
+                             Fn && fn) const
+  {
+    m_marksIndex.Update(m_userMarks, getPivot);
+    m_marksIndex.ForEachInRect(rect, std::forward<Fn>(fn));
+  }
+
   virtual void SetIsVisible(bool isVisible);
 
 protected:
@@ -40,6 +53,8 @@ protected:
   kml::MarkIdSet m_userMarks;
   kml::TrackIdSet m_tracks;
 
+  mutable UserMarksIndex m_marksIndex;
+
   bool m_isDirty = true;
   bool m_isVisible = true;
   bool m_wasVisible = false;
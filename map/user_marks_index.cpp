@@ -0,0 +1,59 @@
+#include "map/user_marks_index.hpp"
+
+void UserMarksIndex::OnAttach(kml::MarkId markId)
+{
+  if (m_isBuilt && m_points.count(markId) == 0)
+    m_attachedMarks.insert(markId);
+}
+
+void UserMarksIndex::OnDetach(kml::MarkId markId)
+{
+  if (!m_isBuilt)
+    return;
+
+  m_attachedMarks.erase(markId);
+  auto const it = m_points.find(markId);
+  if (it == m_points.end())
+    return;
+
+  m_tree.Erase(Entry(markId, it->second));
+  m_points.erase(it);
+}
+
+void UserMarksIndex::Clear()
+{
+  m_tree.Clear();
+  m_points.clear();
+  m_attachedMarks.clear();
+  m_isBuilt = false;
+}
+
+void UserMarksIndex::Update(kml::MarkIdSet const & marks, GetPivotFn const & getPivot)
+{
+  if (!m_isBuilt)
+  {
+    Rebuild(marks, getPivot);
+    return;
+  }
+
+  for (auto const markId : m_attachedMarks)
+    Add(markId, getPivot(markId));
+  m_attachedMarks.clear();
+
+  if (m_points.size() != marks.size())
+    Rebuild(marks, getPivot);
+}
+
+void UserMarksIndex::Add(kml::MarkId markId, m2::PointD const & point)
+{
+  m_tree.Add(Entry(markId, point));
+  m_points.emplace(markId, point);
+}
+
+void UserMarksIndex::Rebuild(kml::MarkIdSet const & marks, GetPivotFn const & getPivot)
+{
+  Clear();
+  for (auto const markId : marks)
+    Add(markId, getPivot(markId));
+  m_isBuilt = true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "kml/type_utils.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+// Spatial index of the marks of a layer for hit-tests. The index is built on the first query,
+// then attached and detached marks are collected and applied on the next query, so the marks
+// are never rescanned. Positions of indexed marks must not change, i.e. it fits bookmarks only.
+class UserMarksIndex
+{
+public:
+  using GetPivotFn = std::function<m2::PointD(kml::MarkId)>;
+
+  void OnAttach(kml::MarkId markId);
+  void OnDetach(kml::MarkId markId);
+  void Clear();
+
+  // Applies the collected changes. |marks| is the full set of the layer marks, the index is
+  // rebuilt if it doesn't match the set, e.g. when marks were added bypassing OnAttach().
+  void Update(kml::MarkIdSet const & marks, GetPivotFn const & getPivot);
+
+  template <typename Fn>
+  void ForEachInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    m_tree.ForEachInRect(rect, [&fn](Entry const & entry) { fn(entry.m_markId); });
+  }
+
+  size_t GetSize() const { return m_points.size(); }
+
+private:
+  struct Entry
+  {
+    Entry(kml::MarkId markId, m2::PointD const & point) : m_markId(markId), m_point(point) {}
+
+    bool operator==(Entry const & rhs) const { return m_markId == rhs.m_markId; }
+    m2::RectD GetLimitRect() const { return m2::RectD(m_point, m_point); }
+
+    kml::MarkId m_markId;
+    m2::PointD m_point;
+  };
+
+  void Add(kml::MarkId markId, m2::PointD const & point);
+  void Rebuild(kml::MarkIdSet const & marks, GetPivotFn const & getPivot);
+
+  m4::Tree<Entry> m_tree;
+  std::unordered_map<kml::MarkId, m2::PointD> m_points;
+  std::unordered_set<kml::MarkId> m_attachedMarks;
+  bool m_isBuilt = false;
+};
@@ -9,11 +9,14 @@
 #include "geometry/mercator.hpp"
 
 #include "base/string_utils.hpp"
+#include "base/thread_pool_delayed.hpp"
 
 #include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include <gflags/gflags.h>
@@ -29,6 +32,7 @@ DEFINE_int32(width, 480, "Resulting image width");
 DEFINE_int32(height, 640, "Resulting image height");
 DEFINE_double(vs, 2.0, "Visual scale (mdpi = 1.0, hdpi = 1.5, xhdpiScale = 2.0, "
                        "6plus = 2.4, xxhdpi = 3.0, xxxhdpi = 3.5)");
+DEFINE_int32(threads, 1, "Number of rendering threads for places from stdin");
 
 //----------------------------------------------------------------------------------------
 
@@ -71,29 +75,19 @@ string FilenameSeq(string const & path)
   return filename.str();
 }
 
-unique_ptr<software_renderer::CPUDrawer> cpuDrawer;
-
-bool IsFrameRendererInitialized()
-{
-  return cpuDrawer != nullptr;
-}
-
-void InitFrameRenderer(float visualScale)
+// Every rendering thread has its own drawer with the agg context and the glyph cache, while
+// the data source and the drawing rules of the framework are shared.
+software_renderer::CPUDrawer & GetFrameRenderer(float visualScale)
 {
   using namespace software_renderer;
 
+  thread_local unique_ptr<CPUDrawer> cpuDrawer;
   if (cpuDrawer == nullptr)
   {
-    df::VisualParams::Init(visualScale, 1024 /* dummy tile size */);
     string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
     cpuDrawer = make_unique_dp<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
   }
-}
-
-void ReleaseFrameRenderer()
-{
-  if (IsFrameRendererInitialized())
-    cpuDrawer.reset();
+  return *cpuDrawer;
 }
 
 /// @param center - map center in Mercator
@@ -107,49 +101,47 @@ void ReleaseFrameRenderer()
 ///                   It must be equal render buffer height. For retina it's equal 2.0 * displayHeight
 /// @param symbols - configuration for symbols on the frame
 /// @param image [out] - result image
-void DrawFrame(Framework & framework,
+void DrawFrame(Framework & framework, software_renderer::CPUDrawer & cpuDrawer,
                m2::PointD const & center, int zoomModifier,
                uint32_t pxWidth, uint32_t pxHeight,
                software_renderer::FrameSymbols const & symbols,
                software_renderer::FrameImage & image)
 {
-  ASSERT(IsFrameRendererInitialized(), ());
-
   int resultZoom = -1;
-  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
+  ScreenBase screen = cpuDrawer.CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
   ASSERT_GREATER(resultZoom, 0, ());
 
   uint32_t const bgColor = drule::rules().GetBgColor(resultZoom);
-  cpuDrawer->BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+  cpuDrawer.BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
 
   m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
   m2::RectD selectRect;
   m2::RectD clipRect;
-  double const inflationSize = 24 * cpuDrawer->GetVisualScale();
+  double const inflationSize = 24 * cpuDrawer.GetVisualScale();
   screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
   screen.PtoG(renderRect, selectRect);
 
   uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
-  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer->GetVisualScale());
-  software_renderer::FeatureProcessor doDraw(make_ref(cpuDrawer), clipRect, screen, drawScale);
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer.GetVisualScale());
+  software_renderer::FeatureProcessor doDraw(make_ref(&cpuDrawer), clipRect, screen, drawScale);
 
   int const upperScale = scales::GetUpperScale();
 
   framework.GetDataSource().ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); },
                                           selectRect, min(upperScale, drawScale));
 
-  cpuDrawer->Flush();
-  //cpuDrawer->DrawMyPosition(screen.GtoP(center));
+  cpuDrawer.Flush();
+  //cpuDrawer.DrawMyPosition(screen.GtoP(center));
 
   if (symbols.m_showSearchResult)
   {
     if (!screen.PixelRect().IsPointInside(screen.GtoP(symbols.m_searchResult)))
-      cpuDrawer->DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
+      cpuDrawer.DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
     else
-      cpuDrawer->DrawSearchResult(screen.GtoP(symbols.m_searchResult));
+      cpuDrawer.DrawSearchResult(screen.GtoP(symbols.m_searchResult));
   }
 
-  cpuDrawer->EndFrame(image);
+  cpuDrawer.EndFrame(image);
 }
 
 void RenderPlace(Framework & framework, Place const & place, string const & filename)
@@ -162,7 +154,7 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   // It is almost UpperComfortScale but there is some magic involved.
   int constexpr kMagicBaseScale = 17;
 
-  DrawFrame(framework, mercator::FromLatLon(place.lat, place.lon),
+  DrawFrame(framework, GetFrameRenderer(FLAGS_vs), mercator::FromLatLon(place.lat, place.lon),
             place.zoom - kMagicBaseScale, place.width, place.height, sym, frame);
 
   ofstream file(filename.c_str());
@@ -193,33 +185,51 @@ int main(int argc, char * argv[])
   {
     Framework f(FrameworkParams(false /* m_enableDiffs */));
 
-    auto processPlace = [&](string const & place)
+    df::VisualParams::Init(FLAGS_vs, 1024 /* dummy tile size */);
+
+    mutex outputMutex;
+    auto processPlace = [&](string const & place, string const & filename)
     {
       Place p = ParsePlace(place);
       p.width = FLAGS_width;
       p.height = FLAGS_height;
-      string const & filename = FilenameSeq(FLAGS_outpath);
       RenderPlace(f, p, filename);
+
+      lock_guard<mutex> lock(outputMutex);
       cout << "Rendering " << place << " into " << filename << " is finished." << endl;
     };
 
-    InitFrameRenderer(FLAGS_vs);
-
     if (!FLAGS_place.empty())
-      processPlace(FLAGS_place);
+      processPlace(FLAGS_place, FilenameSeq(FLAGS_outpath));
 
     if (FLAGS_c)
     {
+      // Places are read in one process, so mwms, styles and glyphs are loaded only once.
+      // Files are named in the order of places whatever thread renders them.
+      unique_ptr<base::thread_pool::delayed::ThreadPool> pool;
+      if (FLAGS_threads > 1)
+      {
+        pool = make_unique<base::thread_pool::delayed::ThreadPool>(
+            static_cast<size_t>(FLAGS_threads), base::thread_pool::delayed::ThreadPool::Exit::ExecPending);
+      }
+
       for (string line; getline(cin, line);)
-        processPlace(line);
+      {
+        string filename = FilenameSeq(FLAGS_outpath);
+        if (pool)
+          pool->Push([&processPlace, line, filename]() { processPlace(line, filename); });
+        else
+          processPlace(line, filename);
+      }
+
+      if (pool)
+        pool->ShutdownAndJoin();
     }
 
-    ReleaseFrameRenderer();
     return 0;
   }
   catch (exception & e)
   {
-    ReleaseFrameRenderer();
     cerr << e.what() << endl;
   }
   return 1;
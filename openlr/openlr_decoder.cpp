@@ -8,6 +8,7 @@
 #include "openlr/helpers.hpp"
 #include "openlr/openlr_model.hpp"
 #include "openlr/paths_connector.hpp"
+#include "openlr/road_points_cache.hpp"
 #include "openlr/road_info_getter.hpp"
 #include "openlr/router.hpp"
 #include "openlr/score_candidate_paths_getter.hpp"
@@ -309,8 +310,10 @@ private:
 class SegmentsDecoderV3
 {
 public:
-  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory)
+  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory,
+                    RoadPointsCache const & roadPointsCache)
       : m_dataSource(dataSource), m_graph(dataSource, std::move(carModelFactory)), m_infoGetter(dataSource)
+      , m_roadPointsCache(roadPointsCache)
   {
   }
 
@@ -330,7 +333,7 @@ public:
     LOG(LINFO, ("Decoding segment:", segment.m_segmentId, "with", points.size(), "points"));
 
     ScoreCandidatePointsGetter pointsGetter(kMaxJunctionCandidates, kMaxProjectionCandidates,
-                                            m_dataSource, m_graph);
+                                            m_dataSource, m_graph, &m_roadPointsCache);
     ScoreCandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, stat);
 
     if (!pathsGetter.GetLineCandidatesForPoints(points, segment.m_source, lineCandidates))
@@ -396,6 +399,7 @@ private:
   DataSource const & m_dataSource;
   Graph m_graph;
   RoadInfoGetter m_infoGetter;
+  RoadPointsCache const & m_roadPointsCache;
 };
 
 size_t constexpr GetOptimalBatchSize()
@@ -450,12 +454,25 @@ void OpenLRDecoder::DecodeV2(vector<LinearSegment> const & segments, uint32_t co
 void OpenLRDecoder::DecodeV3(vector<LinearSegment> const & segments, uint32_t numThreads,
                              vector<DecodedPath> & paths)
 {
-  Decode<SegmentsDecoderV3, v2::Stats>(segments, numThreads, paths);
+  // Neighboring segments share road points around their location reference points, so the
+  // points are read once for the whole feed before decoding.
+  vector<m2::PointD> points;
+  for (auto const & segment : segments)
+  {
+    auto const segmentPoints = segment.GetMercatorPoints();
+    points.insert(points.end(), segmentPoints.begin(), segmentPoints.end());
+  }
+
+  RoadPointsCache roadPointsCache;
+  roadPointsCache.Prefetch(points, ScoreCandidatePointsGetter::kRadiusM, m_dataSources);
+
+  Decode<SegmentsDecoderV3, v2::Stats>(segments, numThreads, paths, roadPointsCache);
 }
 
-template <typename Decoder, typename Stats>
+template <typename Decoder, typename Stats, typename... DecoderArgs>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
-                           uint32_t const numThreads, vector<DecodedPath> & paths)
+                           uint32_t const numThreads, vector<DecodedPath> & paths,
+                           DecoderArgs const &... decoderArgs)
 {
   auto const worker = [&](size_t threadNum, DataSource & dataSource, Stats & stat)
   {
@@ -464,7 +481,8 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
 
     size_t const numSegments = segments.size();
 
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
+    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter),
+                    decoderArgs...);
     base::Timer timer;
     for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
     {
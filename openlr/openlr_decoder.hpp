@@ -51,9 +51,9 @@ public:
                 std::vector<DecodedPath> & paths);
 
 private:
-  template <typename Decoder, typename Stats>
+  template <typename Decoder, typename Stats, typename... DecoderArgs>
   void Decode(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
-              std::vector<DecodedPath> & paths);
+              std::vector<DecodedPath> & paths, DecoderArgs const &... decoderArgs);
 
   std::vector<FrozenDataSource> & m_dataSources;
   CountryParentNameGetter m_countryParentNameGetter;
@@ -0,0 +1,94 @@
+#include "openlr/road_points_cache.hpp"
+
+#include "routing/routing_helpers.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/scales.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+namespace openlr
+{
+void RoadPointsCache::Prefetch(std::vector<m2::PointD> const & points, double radiusM,
+                               std::vector<FrozenDataSource> & dataSources)
+{
+  CHECK(!dataSources.empty(), ());
+
+  base::Timer timer;
+  std::set<Cell> cellsSet;
+  for (auto const & point : points)
+  {
+    ForEachCell(mercator::RectByCenterXYAndSizeInMeters(point, radiusM), [&](Cell const & cell) {
+      if (m_cells.count(cell) == 0)
+        cellsSet.insert(cell);
+    });
+  }
+
+  std::vector<Cell> const cells(cellsSet.cbegin(), cellsSet.cend());
+  size_t const numThreads = std::min(dataSources.size(), std::max<size_t>(cells.size(), 1));
+
+  std::vector<std::vector<std::vector<m2::PointD>>> loaded(numThreads);
+  auto const worker = [&](size_t threadNum) {
+    auto & threadLoaded = loaded[threadNum];
+    for (size_t i = threadNum; i < cells.size(); i += numThreads)
+    {
+      threadLoaded.emplace_back();
+      LoadCell(dataSources[threadNum], cells[i], threadLoaded.back());
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < numThreads; ++i)
+    workers.emplace_back(worker, i);
+
+  worker(0 /* threadNum */);
+  for (auto & w : workers)
+    w.join();
+
+  for (size_t threadNum = 0; threadNum < numThreads; ++threadNum)
+  {
+    for (size_t i = threadNum, j = 0; i < cells.size(); i += numThreads, ++j)
+      m_cells.emplace(cells[i], std::move(loaded[threadNum][j]));
+  }
+
+  LOG(LINFO, ("Road points of", cells.size(), "cells are prefetched in", timer.ElapsedSeconds(),
+              "seconds."));
+}
+
+// static
+void RoadPointsCache::LoadCell(DataSource const & dataSource, Cell const & cell,
+                               std::vector<m2::PointD> & points)
+{
+  m2::RectD const rect(cell.first * kCellSize, cell.second * kCellSize,
+                       (cell.first + 1) * kCellSize, (cell.second + 1) * kCellSize);
+
+  dataSource.ForEachInRect(
+      [&](FeatureType & ft) {
+        ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+        if (ft.GetGeomType() != feature::GeomType::Line ||
+            !routing::IsRoad(feature::TypesHolder(ft)))
+        {
+          return;
+        }
+
+        ft.ForEachPoint(
+            [&](m2::PointD const & point) {
+              if (rect.IsPointInside(point))
+                points.push_back(point);
+            },
+            scales::GetUpperScale());
+      },
+      rect, scales::GetUpperScale());
+
+  base::SortUnique(points);
+}
+}  // namespace openlr
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "indexer/data_source.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace openlr
+{
+// Points of road features split by the cells of a regular grid. The cache is filled for the
+// vicinities of all points of a feed before decoding and is read-only then, so it's shared
+// between decoding threads without locks.
+class RoadPointsCache
+{
+public:
+  // Loads the cells which intersect the |radiusM| vicinities of |points|. Cells are split
+  // between threads, one thread per data source.
+  void Prefetch(std::vector<m2::PointD> const & points, double radiusM,
+                std::vector<FrozenDataSource> & dataSources);
+
+  // Calls |fn| for each road point of the cells which cover |rect|, points of |rect| vicinity
+  // may be passed too. Returns false and doesn't call |fn| if some of the cells isn't loaded.
+  template <typename Fn>
+  bool ForEachPointInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    std::vector<std::vector<m2::PointD> const *> cells;
+    bool loaded = true;
+    ForEachCell(rect, [&](Cell const & cell) {
+      auto const it = m_cells.find(cell);
+      if (it == m_cells.cend())
+        loaded = false;
+      else
+        cells.push_back(&it->second);
+    });
+
+    if (!loaded)
+      return false;
+
+    for (auto const * points : cells)
+    {
+      for (auto const & point : *points)
+        fn(point);
+    }
+    return true;
+  }
+
+  size_t GetCellsCount() const { return m_cells.size(); }
+
+private:
+  using Cell = std::pair<int32_t, int32_t>;
+
+  template <typename Fn>
+  static void ForEachCell(m2::RectD const & rect, Fn && fn)
+  {
+    auto const minX = static_cast<int32_t>(std::floor(rect.minX() / kCellSize));
+    auto const minY = static_cast<int32_t>(std::floor(rect.minY() / kCellSize));
+    auto const maxX = static_cast<int32_t>(std::floor(rect.maxX() / kCellSize));
+    auto const maxY = static_cast<int32_t>(std::floor(rect.maxY() / kCellSize));
+    for (int32_t x = minX; x <= maxX; ++x)
+    {
+      for (int32_t y = minY; y <= maxY; ++y)
+        fn(Cell(x, y));
+    }
+  }
+
+  static void LoadCell(DataSource const & dataSource, Cell const & cell,
+                       std::vector<m2::PointD> & points);
+
+  // Size of a cell in mercator, it's about 500 meters on the equator.
+  static double constexpr kCellSize = 0.005;
+
+  std::map<Cell, std::vector<m2::PointD>> m_cells;
+};
+}  // namespace openlr
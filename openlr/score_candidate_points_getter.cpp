@@ -24,33 +24,33 @@
 
 using namespace routing;
 
-namespace
-{
-// Ends of segments and intermediate points of segments are considered only within this radius.
-double const kRadius = 30.0;
-} //  namespace
-
 namespace openlr
 {
 void ScoreCandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p, bool isLastPoint,
                                                             ScoreEdgeVec & edgeCandidates)
 {
   ScorePointVec pointCandidates;
-  auto const selectCandidates = [&p, &pointCandidates, this](FeatureType & ft) {
-    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-    if (ft.GetGeomType() != feature::GeomType::Line || !routing::IsRoad(feature::TypesHolder(ft)))
-      return;
-
-    ft.ForEachPoint(
-        [&p, &pointCandidates, this](m2::PointD const & candidate) {
-          if (mercator::DistanceOnEarth(p, candidate) < kRadius)
-            pointCandidates.emplace_back(GetScoreByDistance(p, candidate), candidate);
-        },
-        scales::GetUpperScale());
+  auto const addCandidate = [&p, &pointCandidates, this](m2::PointD const & candidate) {
+    if (mercator::DistanceOnEarth(p, candidate) < kRadiusM)
+      pointCandidates.emplace_back(GetScoreByDistance(p, candidate), candidate);
   };
 
-  m_dataSource.ForEachInRect(selectCandidates, mercator::RectByCenterXYAndSizeInMeters(p, kRadius),
-                             scales::GetUpperScale());
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(p, kRadiusM);
+  if (!m_roadPointsCache || !m_roadPointsCache->ForEachPointInRect(rect, addCandidate))
+  {
+    auto const selectCandidates = [&addCandidate](FeatureType & ft) {
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      if (ft.GetGeomType() != feature::GeomType::Line ||
+          !routing::IsRoad(feature::TypesHolder(ft)))
+      {
+        return;
+      }
+
+      ft.ForEachPoint(addCandidate, scales::GetUpperScale());
+    };
+
+    m_dataSource.ForEachInRect(selectCandidates, rect, scales::GetUpperScale());
+  }
 
   base::SortUnique(pointCandidates);
   std::reverse(pointCandidates.begin(), pointCandidates.end());
@@ -85,7 +85,7 @@ void ScoreCandidatePointsGetter::EnrichWithProjectionPoints(m2::PointD const & p
     CHECK(edge.HasRealPart(), ());
     CHECK(!edge.IsFake(), ());
 
-    if (mercator::DistanceOnEarth(p, proj.GetPoint()) >= kRadius)
+    if (mercator::DistanceOnEarth(p, proj.GetPoint()) >= kRadiusM)
       continue;
 
     edgeCandidates.emplace_back(GetScoreByDistance(p, proj.GetPoint()), edge);
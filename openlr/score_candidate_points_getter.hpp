@@ -1,6 +1,7 @@
 #pragma once
 
 #include "openlr/graph.hpp"
+#include "openlr/road_points_cache.hpp"
 #include "openlr/score_types.hpp"
 #include "openlr/stats.hpp"
 
@@ -17,15 +18,22 @@ namespace openlr
 class ScoreCandidatePointsGetter
 {
 public:
+  // Road points are taken from |roadPointsCache| if it's set and has the cells around a point,
+  // otherwise they are read from |dataSource|.
   ScoreCandidatePointsGetter(size_t maxJunctionCandidates, size_t maxProjectionCandidates,
-                             DataSource const & dataSource, Graph & graph)
+                             DataSource const & dataSource, Graph & graph,
+                             RoadPointsCache const * roadPointsCache = nullptr)
     : m_maxJunctionCandidates(maxJunctionCandidates)
     , m_maxProjectionCandidates(maxProjectionCandidates)
     , m_dataSource(dataSource)
     , m_graph(graph)
+    , m_roadPointsCache(roadPointsCache)
   {
   }
 
+  // Ends of segments and intermediate points of segments are considered only within this radius.
+  static double constexpr kRadiusM = 30.0;
+
   void GetEdgeCandidates(m2::PointD const & p, bool isLastPoint, ScoreEdgeVec & edges)
   {
     GetJunctionPointCandidates(p, isLastPoint, edges);
@@ -46,5 +54,6 @@ private:
 
   DataSource const & m_dataSource;
   Graph & m_graph;
+  RoadPointsCache const * m_roadPointsCache;
 };
 }  // namespace openlr
@@ -10,11 +10,22 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace downloader
 {
-ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
+namespace
+{
+// Adaptive chunks: a request is aimed to take about this time, so the size of the requests
+// follows the bandwidth and the latency of each server.
+auto constexpr kTargetRequestTime = chrono::seconds(4);
+size_t constexpr kMaxChunksPerRequest = 16;
+}  // namespace
+
+ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls, bool adaptiveChunks)
+  : m_adaptiveChunks(adaptiveChunks)
 {
   // init servers list
   for (size_t i = 0; i < urls.size(); ++i)
@@ -142,19 +153,29 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
   {
     for (size_t s = 0; s < m_servers.size(); ++s)
     {
-      if (m_servers[s].m_chunkIndex == res.second)
+      if (m_servers[s].m_chunkPos == res.first->m_pos)
       {
         url = m_servers[s].m_url;
         if (success)
         {
           // mark server as free and chunk as ready
-          m_servers[s].m_chunkIndex = SERVER_READY;
+          m_servers[s].m_chunkPos = SERVER_READY;
           res.first->m_status = CHUNK_COMPLETE;
+
+          if (m_adaptiveChunks)
+          {
+            auto & perRequest = m_servers[s].m_chunksPerRequest;
+            auto const time = ClockT::now() - m_servers[s].m_requestTime;
+            if (time < kTargetRequestTime / 2)
+              perRequest = min(perRequest * 2, kMaxChunksPerRequest);
+            else if (time > kTargetRequestTime * 2)
+              perRequest = max(perRequest / 2, size_t(1));
+          }
         }
         else
         {
           LOG(LINFO, ("Thread for url", m_servers[s].m_url,
-                      "failed to download chunk number", m_servers[s].m_chunkIndex));
+                      "failed to download chunk number", res.second));
           // remove failed server and mark chunk as free
           m_servers.erase(m_servers.begin() + s);
           res.first->m_status = CHUNK_FREE;
@@ -166,6 +187,17 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
   return url;
 }
 
+int64_t ChunksDownloadStrategy::GetCompleteRangeEnd(int64_t pos) const
+{
+  auto it = upper_bound(m_chunks.begin(), m_chunks.end(), pos, LessChunks());
+  if (it == m_chunks.begin() || it == m_chunks.end())
+    return pos;
+
+  for (--it; it != m_chunks.end() && it->m_status == CHUNK_COMPLETE; ++it)
+    pos = (it + 1)->m_pos;
+  return pos;
+}
+
 ChunksDownloadStrategy::ResultT
 ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
 {
@@ -177,7 +209,7 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   ServerT * server = 0;
   for (size_t i = 0; i < m_servers.size(); ++i)
   {
-    if (m_servers[i].m_chunkIndex == SERVER_READY)
+    if (m_servers[i].m_chunkPos == SERVER_READY)
     {
       server = &m_servers[i];
       break;
@@ -194,7 +226,20 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     switch (m_chunks[i].m_status)
     {
     case CHUNK_FREE:
-      server->m_chunkIndex = static_cast<int>(i);
+      if (m_adaptiveChunks)
+      {
+        // Merge the next free chunks into this one.
+        size_t end = i + 1;
+        while (end < m_chunks.size() - 1 && end - i < server->m_chunksPerRequest &&
+               m_chunks[end].m_status == CHUNK_FREE)
+        {
+          ++end;
+        }
+        m_chunks.erase(m_chunks.begin() + i + 1, m_chunks.begin() + end);
+        server->m_requestTime = ClockT::now();
+      }
+
+      server->m_chunkPos = m_chunks[i].m_pos;
       outUrl = server->m_url;
 
       range.first = m_chunks[i].m_pos;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -39,24 +40,35 @@ private:
 
   using RangeT = std::pair<int64_t, int64_t>;
 
-  static const int SERVER_READY = -1;
+  using ClockT = std::chrono::steady_clock;
+
+  static int64_t constexpr SERVER_READY = -1;
   struct ServerT
   {
     std::string m_url;
-    int m_chunkIndex;
+    /// Position of the downloading chunk or SERVER_READY.
+    int64_t m_chunkPos;
+    /// How many free chunks are merged into one request, see m_adaptiveChunks.
+    size_t m_chunksPerRequest = 1;
+    ClockT::time_point m_requestTime;
 
-    ServerT(std::string const & url, int ind) : m_url(url), m_chunkIndex(ind) {}
+    ServerT(std::string const & url, int64_t pos) : m_url(url), m_chunkPos(pos) {}
   };
 
   std::vector<ChunkT> m_chunks;
 
   std::vector<ServerT> m_servers;
 
+  /// When true, a server which downloads its chunks fast gets several consecutive free chunks
+  /// merged into one request, and a slow server gets less of them. Merged chunks stay merged,
+  /// so the resume file keeps working.
+  bool m_adaptiveChunks;
+
   /// @return Chunk pointer and it's index for given file offsets range.
   std::pair<ChunkT *, int> GetChunk(RangeT const & range);
 
 public:
-  ChunksDownloadStrategy(std::vector<std::string> const & urls);
+  explicit ChunksDownloadStrategy(std::vector<std::string> const & urls, bool adaptiveChunks = false);
 
   /// Init chunks vector for fileSize.
   void InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status = CHUNK_FREE);
@@ -74,6 +86,10 @@ public:
 
   size_t ActiveServersCount() const { return m_servers.size(); }
 
+  /// @return End of the complete chunks which go without gaps from |pos|,
+  /// or |pos| if the chunk of |pos| is not complete.
+  int64_t GetCompleteRangeEnd(int64_t pos) const;
+
   enum ResultT
   {
     ENextChunk,
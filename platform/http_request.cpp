@@ -10,6 +10,7 @@
 
 #include "coding/internal/file_data.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/sha1.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
@@ -139,6 +140,12 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   size_t m_goodChunksCount;
   bool m_doCleanProgressFiles;
 
+  // Hash of the file prefix [0, m_sha1Size). Data at the end of the prefix is hashed when it's
+  // written, complete chunks which were written before are read back from the file.
+  // Reset when the hash can't be calculated cheaply.
+  unique_ptr<coding::SHA1::Calculator> m_sha1Calculator;
+  int64_t m_sha1Size = 0;
+
   ChunksDownloadStrategy::ResultT StartThreads()
   {
     string url;
@@ -189,6 +196,14 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     {
       m_writer->Seek(offset);
       m_writer->Write(buffer, size);
+
+      if (m_sha1Calculator && offset <= m_sha1Size &&
+          m_sha1Size < offset + static_cast<int64_t>(size))
+      {
+        auto const skip = static_cast<size_t>(m_sha1Size - offset);
+        m_sha1Calculator->Update(static_cast<uint8_t const *>(buffer) + skip, size - skip);
+        m_sha1Size = offset + static_cast<int64_t>(size);
+      }
       return true;
     }
     catch (Writer::Exception const & e)
@@ -198,6 +213,46 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     }
   }
 
+  void UpdateSha1FromFile()
+  {
+    // Don't read much on this thread, the file is checked after download then.
+    int64_t constexpr kMaxReadSize = 16 * 1024 * 1024;
+    size_t constexpr kBufferSize = 64 * 1024;
+
+    if (!m_sha1Calculator)
+      return;
+
+    int64_t const end = m_strategy.GetCompleteRangeEnd(m_sha1Size);
+    if (end == m_sha1Size)
+      return;
+
+    if (end - m_sha1Size > kMaxReadSize)
+    {
+      m_sha1Calculator.reset();
+      return;
+    }
+
+    try
+    {
+      m_writer->Flush();
+
+      base::FileData file(m_filePath + DOWNLOADING_FILE_EXTENSION, base::FileData::OP_READ);
+      vector<uint8_t> buffer(kBufferSize);
+      while (m_sha1Size < end)
+      {
+        auto const toRead = static_cast<size_t>(min<int64_t>(kBufferSize, end - m_sha1Size));
+        file.Read(m_sha1Size, buffer.data(), toRead);
+        m_sha1Calculator->Update(buffer.data(), toRead);
+        m_sha1Size += toRead;
+      }
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't read downloaded data for SHA1", e.Msg()));
+      m_sha1Calculator.reset();
+    }
+  }
+
   void SaveResumeChunks()
   {
     try
@@ -233,11 +288,17 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
       m_progress.m_bytesDownloaded += (endRange - begRange) + 1;
       if (m_onProgress)
         m_onProgress(*this);
+
+      UpdateSha1FromFile();
     }
     else
     {
       auto const message = non_http_error_code::DebugPrint(httpOrErrorCode);
       LOG(LWARNING, (m_filePath, "HttpRequest error:", message));
+
+      // Data of the failed chunk is downloaded again, so the hashed part of it may be wrong.
+      if (m_sha1Size > begRange)
+        m_sha1Calculator.reset();
     }
 
     ChunksDownloadStrategy::ResultT const result = StartThreads();
@@ -261,6 +322,12 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     if (m_status == DownloadStatus::Failed || m_status == DownloadStatus::FileNotFound)
       SaveResumeChunks();
 
+    if (m_status == DownloadStatus::Completed && m_sha1Calculator &&
+        m_sha1Size == m_progress.m_bytesTotal)
+    {
+      m_sha1 = coding::SHA1::ToBase64(m_sha1Calculator->Final());
+    }
+
     // 2. Free file handle.
     CloseWriter();
 
@@ -295,9 +362,9 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
 public:
   FileHttpRequest(vector<string> const & urls, string const & filePath, int64_t fileSize,
                   Callback && onFinish, Callback && onProgress,
-                  int64_t chunkSize, bool doCleanProgressFiles)
+                  int64_t chunkSize, bool doCleanProgressFiles, bool calcSha1)
     : HttpRequest(std::move(onFinish), std::move(onProgress)),
-      m_strategy(urls), m_filePath(filePath),
+      m_strategy(urls, true /* adaptiveChunks */), m_filePath(filePath),
       m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles)
   {
     ASSERT ( !urls.empty(), () );
@@ -325,6 +392,13 @@ public:
     // Assign here, because previous functions can throw an exception.
     m_writer.swap(writer);
     Platform::DisableBackupForFile(filePath + DOWNLOADING_FILE_EXTENSION);
+
+    if (calcSha1)
+    {
+      m_sha1Calculator = make_unique<coding::SHA1::Calculator>();
+      UpdateSha1FromFile();
+    }
+
     StartThreads();
   }
 
@@ -385,12 +459,12 @@ HttpRequest * HttpRequest::PostJson(string const & url, string const & postData,
 HttpRequest * HttpRequest::GetFile(vector<string> const & urls,
                                    string const & filePath, int64_t fileSize,
                                    Callback && onFinish, Callback && onProgress,
-                                   int64_t chunkSize, bool doCleanOnCancel)
+                                   int64_t chunkSize, bool doCleanOnCancel, bool calcSha1)
 {
   try
   {
     return new FileHttpRequest(urls, filePath, fileSize, std::move(onFinish), std::move(onProgress),
-                               chunkSize, doCleanOnCancel);
+                               chunkSize, doCleanOnCancel, calcSha1);
   }
   catch (FileWriter::Exception const & e)
   {
@@ -20,6 +20,8 @@ auto constexpr kInvalidURL = -5;
 auto constexpr kCancelled = -6;
 }  // namespace non_http_error_code
 
+int64_t constexpr kDefaultChunkSize = 512 * 1024;
+
 /// Request in progress will be canceled on delete
 class HttpRequest
 {
@@ -31,6 +33,7 @@ protected:
   Progress m_progress;
   Callback m_onFinish;
   Callback m_onProgress;
+  std::string m_sha1;
 
   HttpRequest(Callback && onFinish, Callback && onProgress);
 
@@ -41,6 +44,8 @@ public:
   Progress const & GetProgress() const { return m_progress; }
   /// Either file path (for chunks) or downloaded data
   virtual std::string const & GetData() const = 0;
+  /// Base64 encoded SHA1 of the downloaded file, empty when it is not calculated.
+  std::string const & GetSha1() const { return m_sha1; }
 
   /// Response saved to memory buffer and retrieved with Data()
   static HttpRequest * Get(std::string const & url,
@@ -54,11 +59,15 @@ public:
 
   /// Download file to filePath.
   /// @param[in]  fileSize  Correct file size (needed for resuming and reserving).
+  /// @param[in]  calcSha1  Calculate SHA1 of the file while it is written, so it doesn't need to be
+  ///                       read again to check it. The hash may still be not calculated (see GetSha1),
+  ///                       e.g. when a big part of the file was downloaded before resuming.
   static HttpRequest * GetFile(std::vector<std::string> const & urls,
                                std::string const & filePath, int64_t fileSize,
                                Callback && onFinish,
                                Callback && onProgress = Callback(),
-                               int64_t chunkSize = 512 * 1024,
-                               bool doCleanOnCancel = true);
+                               int64_t chunkSize = kDefaultChunkSize,
+                               bool doCleanOnCancel = true,
+                               bool calcSha1 = false);
 };
 } // namespace downloader
@@ -6,6 +6,7 @@
 #include "platform/settings.hpp"
 
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 
 #include "base/assert.hpp"
@@ -14,6 +15,8 @@
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/target_os.hpp"
+
 #include <algorithm>
 #include <cctype>
 #include <memory>
@@ -336,8 +339,24 @@ unique_ptr<ModelReader> GetCountryReader(LocalCountryFile const & file, MapFileT
   Platform & platform = GetPlatform();
   if (file.IsInBundle())
     return platform.GetReader(file.GetFileName(type), GetAdditionalWorldScope());
-  else
-    return platform.GetReader(file.GetPath(type), "f");
+
+#ifndef OMIM_OS_WINDOWS
+  // Downloaded maps are memory mapped when the address space is large enough, so features
+  // are parsed right from the mapping without copying (see FeaturesVector).
+  // MmapReader opens files exclusively on Windows, which would break map updates.
+  if (type == MapFileType::Map && sizeof(void *) >= 8)
+  {
+    try
+    {
+      return make_unique<MmapReader>(file.GetPath(type), MmapReader::Advice::Random);
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't map", file.GetPath(type), e.Msg()));
+    }
+  }
+#endif
+  return platform.GetReader(file.GetPath(type), "f");
 }
 
 // static
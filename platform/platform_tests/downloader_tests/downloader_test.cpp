@@ -9,6 +9,7 @@
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
 #include "base/std_serialization.hpp"
 
 #include <QtCore/QCoreApplication>
@@ -331,6 +332,59 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyAdaptive)
+{
+  typedef pair<int64_t, int64_t> RangeT;
+
+  int64_t constexpr kFileSize = 1000;
+  int64_t constexpr kChunkSize = 100;
+  ChunksDownloadStrategy strategy({"UrlOfServer1"}, true /* adaptiveChunks */);
+  strategy.InitChunks(kFileSize, kChunkSize);
+
+  // Chunks are downloaded instantly here, so each next request is twice bigger.
+  string s;
+  RangeT r;
+  TEST_EQUAL(strategy.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(0, 99), ());
+  TEST_EQUAL(strategy.GetCompleteRangeEnd(0), 0, ());
+  strategy.ChunkFinished(true, r);
+  TEST_EQUAL(strategy.GetCompleteRangeEnd(0), 100, ());
+  TEST_EQUAL(strategy.GetCompleteRangeEnd(50), 100, ());
+  TEST_EQUAL(strategy.GetCompleteRangeEnd(100), 100, ());
+
+  TEST_EQUAL(strategy.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(100, 299), ());
+
+  // A failed request frees the merged chunk.
+  strategy.ChunkFinished(false, r);
+  TEST_EQUAL(strategy.NextChunk(s, r), ChunksDownloadStrategy::EDownloadFailed, ());
+
+  string const resumeFile = "chunks_download_strategy_adaptive.resume";
+  SCOPE_GUARD(removeResume, [&resumeFile]() { Platform::RemoveFileIfExists(resumeFile); });
+  strategy.SaveChunks(kFileSize, resumeFile);
+
+  ChunksDownloadStrategy resumed({"UrlOfServer1"}, true /* adaptiveChunks */);
+  TEST_EQUAL(resumed.LoadOrInitChunks(resumeFile, kFileSize, kChunkSize), 100, ());
+  TEST_EQUAL(resumed.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(100, 299), ());
+  resumed.ChunkFinished(true, r);
+
+  TEST_EQUAL(resumed.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(300, 499), ());
+  resumed.ChunkFinished(true, r);
+
+  TEST_EQUAL(resumed.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(500, 899), ());
+  resumed.ChunkFinished(true, r);
+
+  TEST_EQUAL(resumed.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r, RangeT(900, 999), ());
+  resumed.ChunkFinished(true, r);
+
+  TEST_EQUAL(resumed.NextChunk(s, r), ChunksDownloadStrategy::EDownloadSucceeded, ());
+  TEST_EQUAL(resumed.GetCompleteRangeEnd(0), kFileSize, ());
+}
+
 namespace
 {
 string ReadFileAsString(string const & file)
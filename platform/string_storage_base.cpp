@@ -3,6 +3,7 @@
 #include "coding/reader_streambuf.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "base/exception.hpp"
 #include "base/logging.hpp"
@@ -49,23 +50,31 @@ StringStorageBase::StringStorageBase(std::string const & path) : m_path(path)
 
 void StringStorageBase::Save() const
 {
-  try
+  std::string content;
+  for (auto const & value : m_values)
   {
-    FileWriter file(m_path);
-    for (auto const & value : m_values)
-    {
-      std::string line(value.first);
-      line += kKeyValueDelimChar;
-      line += value.second;
-      line += '\n';
-      file.Write(line.data(), line.size());
-    }
+    content += value.first;
+    content += kKeyValueDelimChar;
+    content += value.second;
+    content += '\n';
   }
-  catch (RootException const & ex)
+
+  // The file is replaced at once, so it's never left half-written if the app is killed.
+  base::WriteToTempAndRenameToFile(m_path, [&content](std::string const & fileName)
   {
-    // Ignore all settings saving exceptions.
-    LOG(LWARNING, ("Saving settings:", ex.Msg()));
-  }
+    try
+    {
+      FileWriter file(fileName);
+      file.Write(content.data(), content.size());
+    }
+    catch (RootException const & ex)
+    {
+      // Ignore all settings saving exceptions.
+      LOG(LWARNING, ("Saving settings:", ex.Msg()));
+      return false;
+    }
+    return true;
+  });
 }
 
 void StringStorageBase::Clear()
@@ -91,7 +100,12 @@ void StringStorageBase::SetValue(std::string const & key, std::string && value)
 {
   std::lock_guard guard(m_mutex);
 
-  m_values[key] = std::move(value);
+  // Many settings are set on every start with the same values, the file isn't rewritten for them.
+  auto & current = m_values[key];
+  if (current == value)
+    return;
+
+  current = std::move(value);
   Save();
 }
 
@@ -99,15 +113,26 @@ void StringStorageBase::Update(std::map<std::string, std::string> const & values
 {
   std::lock_guard guard(m_mutex);
 
+  bool changed = false;
   for (const auto & pair : values)
   {
     if (pair.second.empty())
-      m_values.erase(pair.first);
+    {
+      changed = m_values.erase(pair.first) != 0 || changed;
+    }
     else
-      m_values[pair.first] = pair.second;
+    {
+      auto & current = m_values[pair.first];
+      if (current != pair.second)
+      {
+        current = pair.second;
+        changed = true;
+      }
+    }
   }
 
-  Save();
+  if (changed)
+    Save();
 }
 
 void StringStorageBase::DeleteKeyAndValue(std::string const & key)
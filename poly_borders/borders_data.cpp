@@ -18,6 +18,7 @@
 #include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <future>
 #include <tuple>
 
@@ -124,6 +125,17 @@ m2::RectD BoundingBox(std::vector<MarkedPoint> const & points)
   return rect;
 }
 
+// Points are equal if their coordinates differ less than |kEqualityEpsilon|. It is so small that
+// it makes difference for coordinates around zero only, so they are zeroed to compare points
+// exactly.
+m2::PointD NormalizeForComparison(m2::PointD const & point)
+{
+  auto const normalize = [](double coord) {
+    return std::abs(coord) < BordersData::kEqualityEpsilon ? 0.0 : coord;
+  };
+  return {normalize(point.x), normalize(point.y)};
+}
+
 void SwapIfNeeded(size_t & a, size_t & b)
 {
   if (a > b)
@@ -185,8 +197,26 @@ void BordersData::Init(std::string const & bordersDir)
   LOG(LINFO, ("Removed:", m_duplicatedPointsCount, "from input data."));
 }
 
+void BordersData::BuildPointsIndex()
+{
+  m_pointsIndex.clear();
+  for (size_t borderId = 0; borderId < m_bordersPolygons.size(); ++borderId)
+  {
+    auto const & points = m_bordersPolygons[borderId].m_points;
+    for (size_t pointId = 0; pointId < points.size(); ++pointId)
+    {
+      m_pointsIndex.emplace_back(NormalizeForComparison(points[pointId].m_point),
+                                 Link(borderId, pointId));
+    }
+  }
+
+  std::sort(m_pointsIndex.begin(), m_pointsIndex.end());
+}
+
 void BordersData::MarkPoints()
 {
+  BuildPointsIndex();
+
   size_t const threadsNumber = std::thread::hardware_concurrency();
   LOG(LINFO, ("Start marking points, threads number:", threadsNumber));
 
@@ -266,37 +296,46 @@ void BordersData::MarkPoint(size_t curBorderId, size_t curPointId)
 {
   MarkedPoint & curMarkedPoint = m_bordersPolygons[curBorderId].m_points[curPointId];
 
-  for (size_t anotherBorderId = 0; anotherBorderId < m_bordersPolygons.size(); ++anotherBorderId)
+  // Points with the same coordinates go in a row in |m_pointsIndex|, ordered by border and point
+  // ids, so the first point of the first another border which has the same point is linked.
+  auto const point = NormalizeForComparison(curMarkedPoint.m_point);
+  struct LessByPoint
+  {
+    bool operator()(PointWithLink const & lhs, m2::PointD const & rhs) const
+    {
+      return lhs.first < rhs;
+    }
+    bool operator()(m2::PointD const & lhs, PointWithLink const & rhs) const
+    {
+      return lhs < rhs.first;
+    }
+  };
+
+  auto const range =
+      std::equal_range(m_pointsIndex.cbegin(), m_pointsIndex.cend(), point, LessByPoint());
+
+  for (auto it = range.first; it != range.second; ++it)
   {
+    size_t const anotherBorderId = it->second.m_borderId;
     if (curBorderId == anotherBorderId)
       continue;
 
     if (curMarkedPoint.m_marked)
       return;
 
-    Polygon & anotherPolygon = m_bordersPolygons[anotherBorderId];
+    size_t const anotherPointId = it->second.m_pointId;
+    auto & anotherMarkedPoint = m_bordersPolygons[anotherBorderId].m_points[anotherPointId];
 
-    if (!anotherPolygon.m_rect.IsPointInside(curMarkedPoint.m_point))
-      continue;
+    anotherMarkedPoint.m_marked = true;
+    curMarkedPoint.m_marked = true;
 
-    for (size_t anotherPointId = 0; anotherPointId < anotherPolygon.m_points.size(); ++anotherPointId)
-    {
-      auto & anotherMarkedPoint = anotherPolygon.m_points[anotherPointId];
-
-      if (base::AlmostEqualAbs(anotherMarkedPoint.m_point, curMarkedPoint.m_point, kEqualityEpsilon))
-      {
-        anotherMarkedPoint.m_marked = true;
-        curMarkedPoint.m_marked = true;
-
-        // Save info that border with id: |anotherBorderId| has the same point with id:
-        // |anotherPointId|.
-        curMarkedPoint.AddLink(anotherBorderId, anotherPointId);
-        // And vice versa.
-        anotherMarkedPoint.AddLink(curBorderId, curPointId);
+    // Save info that border with id: |anotherBorderId| has the same point with id:
+    // |anotherPointId|.
+    curMarkedPoint.AddLink(anotherBorderId, anotherPointId);
+    // And vice versa.
+    anotherMarkedPoint.AddLink(curBorderId, curPointId);
 
-        return;
-      }
-    }
+    return;
   }
 }
 
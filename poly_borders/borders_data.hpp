@@ -6,6 +6,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace poly_borders
@@ -41,10 +42,15 @@ private:
   /// points and leaves only unique.
   size_t RemoveDuplicatePoints();
 
+  /// \brief Fills |m_pointsIndex| with points of all borders sorted by coordinates.
+  void BuildPointsIndex();
+
   /// \brief Finds point on other polygons equal to points passed as in the argument. If such point
   /// is found, the method will create a link of the form "some border (with id = anotherBorderId)
   /// has the same point (with id = anotherPointId)".
   //  If point belongs to more than 2 polygons, the link will be created for an arbitrary pair.
+  /// \note Equal points are looked up in |m_pointsIndex|, so |BuildPointsIndex()| must be called
+  /// before.
   void MarkPoint(size_t curBorderId, size_t curPointId);
 
   /// \brief Checks whether we can replace points from segment: [curLeftPointId, curRightPointId]
@@ -67,5 +73,10 @@ private:
   std::map<size_t, std::string> m_indexToPolyFileName;
   std::vector<Polygon> m_bordersPolygons;
   std::vector<Polygon> m_prevCopy;
+
+  using PointWithLink = std::pair<m2::PointD, Link>;
+  // Points of all borders sorted by coordinates, to find equal points of different borders
+  // without scanning of the borders.
+  std::vector<PointWithLink> m_pointsIndex;
 };
 }  // namespace poly_borders
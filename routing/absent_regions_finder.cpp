@@ -1,8 +1,13 @@
 #include "routing/absent_regions_finder.hpp"
-#include "routing/regions_router.hpp"
 
 namespace routing
 {
+namespace
+{
+// Regions of a subroute take a few hundred bytes, the cache is dropped when it grows bigger.
+size_t constexpr kMaxCachedSubroutes = 128;
+}  // namespace
+
 AbsentRegionsFinder::AbsentRegionsFinder(CountryFileGetterFn const & countryFileGetter,
                                          LocalFileCheckerFn const & localFileChecker,
                                          std::shared_ptr<NumMwmIds> numMwmIds,
@@ -24,12 +29,44 @@ void AbsentRegionsFinder::GenerateAbsentRegions(Checkpoints const & checkpoints,
     m_routerThread->Cancel();
     m_routerThread.reset();
   }
+  m_cachedRegions.clear();
 
   if (AreCheckpointsInSameMwm(checkpoints))
     return;
 
+  std::set<RegionsPair> cachedSubroutes;
+  bool allCached = true;
+  for (size_t i = 0; i < checkpoints.GetNumSubroutes(); ++i)
+  {
+    RegionsPair regions(m_countryFileGetterFn(checkpoints.GetPoint(i)),
+                        m_countryFileGetterFn(checkpoints.GetPoint(i + 1)));
+    if (regions.first == regions.second)
+      continue;
+
+    auto const it = m_subroutesCache.find(regions);
+    if (it == m_subroutesCache.end())
+    {
+      allCached = false;
+      continue;
+    }
+
+    m_cachedRegions.insert(it->second.cbegin(), it->second.cend());
+    cachedSubroutes.insert(std::move(regions));
+  }
+
+  if (allCached)
+    return;
+
+  if (!m_sparseGraph)
+  {
+    // The graph is loaded on the router thread.
+    m_sparseGraph =
+        std::make_shared<RegionsSparseGraph>(m_countryFileGetterFn, m_numMwmIds, m_dataSource);
+  }
+
   std::unique_ptr<RegionsRouter> router = std::make_unique<RegionsRouter>(
-      m_countryFileGetterFn, m_numMwmIds, m_dataSource, delegate, checkpoints);
+      m_countryFileGetterFn, m_numMwmIds, m_dataSource, delegate, checkpoints, m_sparseGraph,
+      std::move(cachedSubroutes));
 
   // iOS can't reuse threads. So we need to recreate the thread.
   m_routerThread = std::make_unique<threads::Thread>();
@@ -54,20 +91,37 @@ void AbsentRegionsFinder::GetAllRegions(std::set<std::string> & countries)
 {
   countries.clear();
 
+  for (auto const & mwmName : m_cachedRegions)
+  {
+    if (!mwmName.empty())
+      countries.emplace(mwmName);
+  }
+
   if (!m_routerThread)
     return;
 
   m_routerThread->Join();
 
-  for (auto const & mwmName : m_routerThread->GetRoutineAs<RegionsRouter>()->GetMwmNames())
+  auto const * router = m_routerThread->GetRoutineAs<RegionsRouter>();
+  for (auto const & mwmName : router->GetMwmNames())
   {
     if (!mwmName.empty())
       countries.emplace(mwmName);
   }
+  CacheSubroutes(router->GetSubroutesMwmNames());
 
   m_routerThread.reset();
 }
 
+void AbsentRegionsFinder::CacheSubroutes(RegionsRouter::SubroutesMwmNames const & subroutes)
+{
+  if (m_subroutesCache.size() + subroutes.size() > kMaxCachedSubroutes)
+    m_subroutesCache.clear();
+
+  for (auto const & [regions, mwmNames] : subroutes)
+    m_subroutesCache[regions] = std::set<std::string>(mwmNames.cbegin(), mwmNames.cend());
+}
+
 bool AbsentRegionsFinder::AreCheckpointsInSameMwm(Checkpoints const & checkpoints) const
 {
   for (size_t i = 0; i < checkpoints.GetNumSubroutes(); ++i)
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "routing/regions_decl.hpp"
+#include "routing/regions_router.hpp"
+#include "routing/regions_sparse_graph.hpp"
 #include "routing/router_delegate.hpp"
 
 #include "base/thread.hpp"
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -15,7 +18,9 @@ namespace routing
 using LocalFileCheckerFn = std::function<bool(std::string const &)>;
 
 // Encapsulates generation of mwm names of absent regions needed for building the route between
-// |checkpoints|. For this purpose the new thread is used.
+// |checkpoints|. For this purpose the new thread is used. The regions sparse graph and the regions
+// of subroutes between every pair of start and finish regions are cached between requests, so
+// the thread isn't started at all when all the subroutes are cached.
 class AbsentRegionsFinder
 {
 public:
@@ -23,7 +28,8 @@ public:
                       LocalFileCheckerFn const & localFileChecker,
                       std::shared_ptr<NumMwmIds> numMwmIds, DataSource & dataSource);
 
-  // Creates new thread |m_routerThread| and starts routing in it.
+  // Creates new thread |m_routerThread| and starts routing in it for the subroutes which aren't
+  // cached.
   void GenerateAbsentRegions(Checkpoints const & checkpoints, RouterDelegate const & delegate);
   // Waits for the routing thread |m_routerThread| to finish and returns results from it.
   void GetAllRegions(std::set<std::string> & countries);
@@ -31,7 +37,10 @@ public:
   void GetAbsentRegions(std::set<std::string> & absentCountries);
 
 private:
+  using RegionsPair = RegionsRouter::RegionsPair;
+
   bool AreCheckpointsInSameMwm(Checkpoints const & checkpoints) const;
+  void CacheSubroutes(RegionsRouter::SubroutesMwmNames const & subroutes);
 
   CountryFileGetterFn const m_countryFileGetterFn;
   LocalFileCheckerFn const m_localFileCheckerFn;
@@ -39,6 +48,11 @@ private:
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   DataSource & m_dataSource;
 
+  std::shared_ptr<RegionsSparseGraph> m_sparseGraph;
+  std::map<RegionsPair, std::set<std::string>> m_subroutesCache;
+  // Regions of the current request taken from |m_subroutesCache|.
+  std::set<std::string> m_cachedRegions;
+
   std::unique_ptr<threads::Thread> m_routerThread;
 };
 }  // namespace routing
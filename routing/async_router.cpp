@@ -30,6 +30,8 @@ AsyncRouter::RouterDelegateProxy::RouterDelegateProxy(ReadyCallbackOwnership con
   m_delegate.Reset();
   m_delegate.SetPointCheckCallback(std::bind(&RouterDelegateProxy::OnPointCheck, this, std::placeholders::_1));
   m_delegate.SetProgressCallback(std::bind(&RouterDelegateProxy::OnProgress, this, std::placeholders::_1));
+  if (m_onReadyOwnership)
+    m_delegate.SetEarlyRouteCallback(std::bind(&RouterDelegateProxy::OnEarlyRoute, this, std::placeholders::_1));
   m_delegate.SetTimeout(timeoutSec);
 }
 
@@ -70,6 +72,18 @@ void AsyncRouter::RouterDelegateProxy::OnRemoveRoute(RouterResultCode resultCode
   m_onRemoveRoute(resultCode);
 }
 
+void AsyncRouter::RouterDelegateProxy::OnRouteUpdated(std::shared_ptr<Route> const & earlyRoute,
+                                                      std::shared_ptr<Route> const & route)
+{
+  {
+    lock_guard l(m_guard);
+    if (m_delegate.IsCancelled())
+      return;
+  }
+  CHECK_EQUAL(earlyRoute->GetRouteSegments().size(), route->GetRouteSegments().size(), ());
+  earlyRoute->SetRouteSegments(std::move(route->GetRouteSegments()));
+}
+
 void AsyncRouter::RouterDelegateProxy::Cancel()
 {
   lock_guard l(m_guard);
@@ -83,6 +97,14 @@ bool AsyncRouter::FindClosestProjectionToRoad(m2::PointD const & point,
   return m_router->FindClosestProjectionToRoad(point, direction, radius, proj);
 }
 
+void AsyncRouter::WarmUp(m2::PointD const & point)
+{
+  unique_lock ul(m_guard);
+
+  m_warmUpPoint = point;
+  m_threadCondVar.notify_one();
+}
+
 void AsyncRouter::RouterDelegateProxy::OnProgress(float progress)
 {
   ProgressCallback onProgress = nullptr;
@@ -124,6 +146,21 @@ void AsyncRouter::RouterDelegateProxy::OnPointCheck(ms::LatLon const & pt)
 #endif
 }
 
+void AsyncRouter::RouterDelegateProxy::OnEarlyRoute(Route const & route)
+{
+  {
+    lock_guard l(m_guard);
+    if (m_delegate.IsCancelled())
+      return;
+  }
+
+  // Note. The copy is used only on ui thread after this call.
+  m_earlyRoute = std::make_shared<Route>(route);
+  GetPlatform().RunTask(Platform::Thread::Gui, [self = shared_from_this(), earlyRoute = m_earlyRoute]() {
+    self->OnReady(earlyRoute, RouterResultCode::NoError);
+  });
+}
+
 // -------------------------------------------------------------------------------------------------
 
 AsyncRouter::AsyncRouter(PointCheckCallback const & pointCheckCallback)
@@ -273,9 +310,14 @@ void AsyncRouter::ThreadFunc()
 {
   while (true)
   {
+    std::optional<m2::PointD> warmUpPoint;
+    std::shared_ptr<IRouter> router;
     {
       unique_lock ul(m_guard);
-      m_threadCondVar.wait(ul, [this](){ return m_threadExit || m_hasRequest || m_clearState; });
+      m_threadCondVar.wait(ul, [this]()
+      {
+        return m_threadExit || m_hasRequest || m_clearState || m_warmUpPoint;
+      });
 
       if (m_clearState && m_router)
       {
@@ -287,10 +329,21 @@ void AsyncRouter::ThreadFunc()
         break;
 
       if (!m_hasRequest)
-        continue;
+      {
+        // Route requests go first, warm-up is done when the thread is idle.
+        if (!m_warmUpPoint || !m_router)
+          continue;
+
+        warmUpPoint = m_warmUpPoint;
+        m_warmUpPoint.reset();
+        router = m_router;
+      }
     }
 
-    CalculateRoute();
+    if (warmUpPoint)
+      router->WarmUp(*warmUpPoint);
+    else
+      CalculateRoute();
   }
 }
 
@@ -367,8 +420,18 @@ void AsyncRouter::CalculateRoute()
   {
     // Note. After call of this method |route| should be used only on ui thread.
     // And |route| should stop using on routing background thread, in this method.
-    GetPlatform().RunTask(Platform::Thread::Gui,
-                          [delegateProxy, route, code]() { delegateProxy->OnReady(route, code); });
+    if (auto const & earlyRoute = delegateProxy->GetEarlyRoute())
+    {
+      // The route is already shown, so only its turns are updated.
+      GetPlatform().RunTask(Platform::Thread::Gui, [delegateProxy, earlyRoute, route]() {
+        delegateProxy->OnRouteUpdated(earlyRoute, route);
+      });
+    }
+    else
+    {
+      GetPlatform().RunTask(Platform::Thread::Gui,
+                            [delegateProxy, route, code]() { delegateProxy->OnReady(route, code); });
+    }
   }
 
   bool const needAbsentRegions = (code != RouterResultCode::Cancelled &&
@@ -16,6 +16,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -62,6 +63,9 @@ public:
   bool FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction,
                                    double radius, EdgeProj & proj);
 
+  /// Warms up the router near |point| on the worker thread when it has no route requests.
+  void WarmUp(m2::PointD const & point);
+
 private:
   /// Worker thread function
   void ThreadFunc();
@@ -72,7 +76,7 @@ private:
   static void LogCode(RouterResultCode code, double const elapsedSec);
 
   /// Blocks callbacks when routing has been cancelled
-  class RouterDelegateProxy
+  class RouterDelegateProxy : public std::enable_shared_from_this<RouterDelegateProxy>
   {
   public:
     RouterDelegateProxy(ReadyCallbackOwnership const & onReady,
@@ -85,13 +89,19 @@ private:
     void OnReady(std::shared_ptr<Route> route, RouterResultCode resultCode);
     void OnNeedMoreMaps(uint64_t routeId, std::set<std::string> const & absentCounties);
     void OnRemoveRoute(RouterResultCode resultCode);
+    /// Moves turns and road names of the finished |route| to |earlyRoute| which has been
+    /// passed to |m_onReadyOwnership| before.
+    void OnRouteUpdated(std::shared_ptr<Route> const & earlyRoute, std::shared_ptr<Route> const & route);
     void Cancel();
 
     RouterDelegate const & GetDelegate() const { return m_delegate; }
+    /// Should be called on the routing thread only.
+    std::shared_ptr<Route> const & GetEarlyRoute() const { return m_earlyRoute; }
 
   private:
     void OnProgress(float progress);
     void OnPointCheck(ms::LatLon const & pt);
+    void OnEarlyRoute(Route const & route);
 
     std::mutex m_guard;
     ReadyCallbackOwnership const m_onReadyOwnership;
@@ -103,6 +113,8 @@ private:
     PointCheckCallback const m_onPointCheck;
     ProgressCallback const m_onProgress;
     RouterDelegate m_delegate;
+    // Route which has been passed to |m_onReadyOwnership| before the router finished it.
+    std::shared_ptr<Route> m_earlyRoute;
   };
 
 private:
@@ -116,6 +128,7 @@ private:
 
   /// Current request parameters
   bool m_clearState = false;
+  std::optional<m2::PointD> m_warmUpPoint;
   Checkpoints m_checkpoints;
   GuidesTracks m_guides;
 
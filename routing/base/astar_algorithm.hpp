@@ -10,11 +10,15 @@
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <queue>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -130,9 +134,11 @@ public:
   class Context final
   {
   public:
-    Context(Graph & graph) : m_graph(graph)
+    // A context with |forward| == false is used to propagate a wave along ingoing edges.
+    // In that case the parent of a vertex is the next vertex on the way to the wave start.
+    explicit Context(Graph & graph, bool forward = true) : m_graph(graph), m_forward(forward)
     {
-      m_graph.SetAStarParents(true /* forward */, m_parents);
+      m_graph.SetAStarParents(m_forward, m_parents);
     }
 
     ~Context()
@@ -184,10 +190,13 @@ public:
 
     typename Graph::Parents & GetParents() { return m_parents; }
 
+    bool IsForward() const { return m_forward; }
+
     void ReconstructPath(Vertex const & v, std::vector<Vertex> & path) const;
 
   private:
     Graph & m_graph;
+    bool const m_forward;
     ska::bytell_hash_map<Vertex, Weight> m_distanceMap;
     typename Graph::Parents m_parents;
   };
@@ -200,6 +209,14 @@ public:
                      AdjustEdgeWeight && adjustEdgeWeight, FilterStates && filterStates,
                      ReducedToRealLength && reducedToRealLength, Context & context) const;
 
+  // Propagates a wave from all |startVertices| at once.
+  template <typename VisitVertex, typename AdjustEdgeWeight, typename FilterStates,
+            typename ReducedToRealLength>
+  void PropagateWave(Graph & graph, std::vector<Vertex> const & startVertices,
+                     VisitVertex && visitVertex, AdjustEdgeWeight && adjustEdgeWeight,
+                     FilterStates && filterStates, ReducedToRealLength && reducedToRealLength,
+                     Context & context) const;
+
   template <typename VisitVertex>
   void PropagateWave(Graph & graph, Vertex const & startVertex, VisitVertex && visitVertex,
                      Context & context) const;
@@ -222,6 +239,60 @@ public:
     });
   }
 
+  /// Opt-in variant of FindPathBidirectional which propagates the forward wave on the calling
+  /// thread and the backward wave on a separate thread. The waves exchange distances through
+  /// per-wave locks and the best meeting point is checked through an atomic before locking.
+  /// \warning The graph must support concurrent calls of GetOutgoingEdgesList/GetIngoingEdgesList,
+  /// HeuristicCostEstimate and AreWavesConnectible from the two waves. The visitor is called
+  /// from both threads under a mutex.
+  template <class P>
+  Result FindPathBidirectionalParallel(P & params, RoutingResult<Vertex, Weight> & result) const;
+
+  struct AlternativesParams
+  {
+    // Maximum number of alternatives besides the best route.
+    size_t m_maxAlternatives = 2;
+    // An alternative may be at most (1 + m_maxStretch) times longer than the best route.
+    double m_maxStretch = 0.25;
+    // An alternative may share at most m_maxSharing of its weight with the best route
+    // and with each of the chosen alternatives.
+    double m_maxSharing = 0.7;
+    // Maximum number of via vertices which are evaluated.
+    size_t m_maxCandidates = 2000;
+    size_t m_threadsCount = 1;
+  };
+
+  /// Finds the best route like FindPathBidirectional and up to |altParams.m_maxAlternatives|
+  /// via-vertex alternatives. The search continues until both waves have covered all vertices
+  /// of routes which are not longer than the stretch limit. Every vertex settled by both waves
+  /// gives a candidate route start -> v -> finish. Candidates are evaluated (simplicity and
+  /// sharing with the best route) in |altParams.m_threadsCount| threads and chosen greedily
+  /// from the shortest one.
+  /// \note Candidate evaluation reads the search trees only, the graph is used on the calling
+  /// thread.
+  template <class P>
+  Result FindPathBidirectionalWithAlternatives(
+      P & params, AlternativesParams const & altParams, RoutingResult<Vertex, Weight> & result,
+      std::vector<RoutingResult<Vertex, Weight>> & alternatives) const;
+
+  // Vertices from which the finish of a route is known to be reachable. The way to the finish
+  // goes along |m_next| links and |m_weights| keeps its weight.
+  struct RemainingTree
+  {
+    void Clear()
+    {
+      m_weights.clear();
+      m_next.clear();
+    }
+
+    bool IsEmpty() const { return m_weights.empty(); }
+
+    ska::bytell_hash_map<Vertex, Weight> m_weights;
+    ska::bytell_hash_map<Vertex, Vertex> m_next;
+  };
+
+  static void MakeRemainingTree(std::vector<Edge> const & route, RemainingTree & tree);
+
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
@@ -229,6 +300,12 @@ public:
                                                                     std::vector<Edge> const & prevRoute,
                                                                     RoutingResult<Vertex, Weight> & result) const;
 
+  // Adjust route to any vertex of |tree|, e.g. to a tree of ways to the previous route.
+  template <typename P>
+  typename AStarAlgorithm<Vertex, Edge, Weight>::Result AdjustRoute(P & params,
+                                                                    RemainingTree const & tree,
+                                                                    RoutingResult<Vertex, Weight> & result) const;
+
 private:
   // Periodicity of switching a wave of bidirectional algorithm.
   static uint32_t constexpr kQueueSwitchPeriod = 128;
@@ -406,6 +483,22 @@ void AStarAlgorithm<Vertex, Edge, Weight>::PropagateWave(
     FilterStates && filterStates,
     ReducedToFullLength && reducedToFullLength,
     AStarAlgorithm<Vertex, Edge, Weight>::Context & context) const
+{
+  PropagateWave(graph, std::vector<Vertex>{startVertex}, std::forward<VisitVertex>(visitVertex),
+                std::forward<AdjustEdgeWeight>(adjustEdgeWeight),
+                std::forward<FilterStates>(filterStates),
+                std::forward<ReducedToFullLength>(reducedToFullLength), context);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename VisitVertex, typename AdjustEdgeWeight, typename FilterStates, typename ReducedToFullLength>
+void AStarAlgorithm<Vertex, Edge, Weight>::PropagateWave(
+    Graph & graph, std::vector<Vertex> const & startVertices,
+    VisitVertex && visitVertex,
+    AdjustEdgeWeight && adjustEdgeWeight,
+    FilterStates && filterStates,
+    ReducedToFullLength && reducedToFullLength,
+    AStarAlgorithm<Vertex, Edge, Weight>::Context & context) const
 {
   auto const epsilon = graph.GetAStarWeightEpsilon();
 
@@ -413,8 +506,11 @@ void AStarAlgorithm<Vertex, Edge, Weight>::PropagateWave(
 
   std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
 
-  context.SetDistance(startVertex, kZeroDistance);
-  queue.push(State(startVertex, kZeroDistance));
+  for (auto const & startVertex : startVertices)
+  {
+    context.SetDistance(startVertex, kZeroDistance);
+    queue.push(State(startVertex, kZeroDistance));
+  }
 
   typename Graph::EdgeListT adj;
 
@@ -430,7 +526,11 @@ void AStarAlgorithm<Vertex, Edge, Weight>::PropagateWave(
       return;
 
     astar::VertexData const vertexData(stateV.vertex, reducedToFullLength(stateV));
-    graph.GetOutgoingEdgesList(vertexData, adj);
+    if (context.IsForward())
+      graph.GetOutgoingEdgesList(vertexData, adj);
+    else
+      graph.GetIngoingEdgesList(vertexData, adj);
+
     for (auto const & edge : adj)
     {
       State stateW(edge.GetTarget(), kZeroDistance);
@@ -737,16 +837,581 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalEx(P & params, Emitte
   return Result::NoPath;
 }
 
+template <typename Vertex, typename Edge, typename Weight>
+template <class P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalParallel(
+    P & params, RoutingResult<Vertex, Weight> & result) const
+{
+  auto const epsilon = params.m_weightEpsilon;
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  result.Clear();
+
+  struct Wave
+  {
+    Wave(bool forward, Vertex const & startVertex, Vertex const & finalVertex, Graph & graph)
+      : m_context(forward, startVertex, finalVertex, graph)
+    {
+    }
+
+    BidirectionalStepContext m_context;
+    // Guards |m_context.bestDistance| and |m_context.parent| which are read by the other wave.
+    std::mutex m_mutex;
+    // Reduced distance of the top of |m_context.queue|.
+    std::atomic<Weight> m_topDistance{kZeroDistance};
+  };
+
+  Wave forward(true /* forward */, startVertex, finalVertex, graph);
+  Wave backward(false /* forward */, startVertex, finalVertex, graph);
+
+  auto & forwardParents = forward.m_context.GetParents();
+  auto & backwardParents = backward.m_context.GetParents();
+
+  forward.m_context.UpdateDistance(State(startVertex, kZeroDistance));
+  forward.m_context.queue.push(
+      State(startVertex, kZeroDistance, forward.m_context.ConsistentHeuristic(startVertex)));
+
+  backward.m_context.UpdateDistance(State(finalVertex, kZeroDistance));
+  backward.m_context.queue.push(
+      State(finalVertex, kZeroDistance, backward.m_context.ConsistentHeuristic(finalVertex)));
+
+  // The best meeting point. |bestReducedLength| duplicates |bestPathReducedLength| to skip locking
+  // of |bestMutex| and the waves for paths which are not better anyway.
+  std::mutex bestMutex;
+  std::atomic<Weight> bestReducedLength{kInfiniteDistance};
+  bool foundAnyPath = false;
+  Weight bestPathReducedLength = kZeroDistance;
+  Weight bestPathRealLength = kZeroDistance;
+  Vertex bestForwardVertex = startVertex;
+  Vertex bestBackwardVertex = finalVertex;
+
+  std::atomic<bool> stop{false};
+  std::atomic<bool> cancelled{false};
+  std::mutex visitorMutex;
+
+  auto const propagate = [&](Wave & curWave, Wave & nxtWave) {
+    auto & cur = curWave.m_context;
+    auto & nxt = nxtWave.m_context;
+    auto const endV = cur.forward ? cur.finalVertex : cur.startVertex;
+
+    PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+    typename Graph::EdgeListT adj;
+
+    while (!stop)
+    {
+      if (periodicCancellable.IsCancelled())
+      {
+        cancelled = true;
+        break;
+      }
+
+      // If we have not found a path by the time one of the queues is exhausted, we never will.
+      if (cur.queue.empty())
+        break;
+
+      auto const curTop = cur.TopDistance();
+      curWave.m_topDistance = curTop;
+      // See FindPathBidirectionalEx for the stop criterion. Distance of the top of the other queue
+      // never decreases so a stale value just postpones the stop.
+      if (curTop + nxtWave.m_topDistance >= bestReducedLength - epsilon)
+        break;
+
+      State const stateV = cur.queue.top();
+      cur.queue.pop();
+
+      if (cur.ExistsStateWithBetterDistance(stateV))
+        continue;
+
+      {
+        std::lock_guard<std::mutex> lock(visitorMutex);
+        params.m_onVisitedVertexCallback(std::make_pair(stateV, &cur), endV);
+      }
+
+      cur.GetAdjacencyList(stateV, adj);
+      auto const & pV = stateV.heuristic;
+      for (auto const & edge : adj)
+      {
+        State stateW(edge.GetTarget(), kZeroDistance);
+
+        if (stateV.vertex == stateW.vertex)
+          continue;
+
+        auto const weight = edge.GetWeight();
+        auto const pW = cur.ConsistentHeuristic(stateW.vertex);
+        auto const reducedWeight = weight + pW - pV;
+
+        if (reducedWeight < -epsilon && params.m_badReducedWeight(reducedWeight, std::max(pW, pV)))
+        {
+          LOG(LERROR, ("Invariant violated for:", "v =", stateV.vertex, "w =", stateW.vertex,
+                       "reduced weight =", reducedWeight));
+        }
+
+        stateW.distance = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+        auto const fullLength = weight + stateV.distance + cur.pS - pV;
+        if (!params.m_checkLengthCallback(fullLength))
+          continue;
+
+        {
+          std::lock_guard<std::mutex> lock(curWave.m_mutex);
+          if (cur.ExistsStateWithBetterDistance(stateW, epsilon))
+            continue;
+
+          stateW.heuristic = pW;
+          cur.UpdateDistance(stateW);
+          cur.UpdateParent(stateW.vertex, stateV.vertex);
+        }
+
+        std::optional<Weight> distW;
+        {
+          std::lock_guard<std::mutex> lock(nxtWave.m_mutex);
+          distW = nxt.GetDistance(stateW.vertex);
+        }
+
+        // Both waves update their own distances before they look at the other wave's ones,
+        // so at least one of them notices every meeting point.
+        if (distW && stateW.distance + *distW < bestReducedLength)
+        {
+          std::scoped_lock lock(forward.m_mutex, backward.m_mutex, bestMutex);
+          // The distances might be improved while the locks were being taken.
+          auto const curDistW = cur.GetDistance(stateW.vertex);
+          auto const nxtDistW = nxt.GetDistance(stateW.vertex);
+          CHECK(curDistW && nxtDistW, ());
+          auto const curPathReducedLength = *curDistW + *nxtDistW;
+          if ((!foundAnyPath || bestPathReducedLength > curPathReducedLength) &&
+              graph.AreWavesConnectible(forwardParents, stateW.vertex, backwardParents))
+          {
+            auto const parentW = cur.GetParent(stateW.vertex);
+            CHECK(parentW, ());
+
+            bestPathReducedLength = curPathReducedLength;
+            bestReducedLength = curPathReducedLength;
+
+            // Real length of the path: real length from the wave start to |stateW.vertex|
+            // plus real length from |stateW.vertex| to the other wave start.
+            bestPathRealLength = *curDistW + cur.pS - pW;
+            bestPathRealLength += *nxtDistW + nxt.pS - nxt.ConsistentHeuristic(stateW.vertex);
+
+            foundAnyPath = true;
+            bestForwardVertex = cur.forward ? *parentW : stateW.vertex;
+            bestBackwardVertex = cur.forward ? stateW.vertex : *parentW;
+          }
+        }
+
+        if (stateW.vertex != endV)
+          cur.queue.push(stateW);
+      }
+    }
+
+    stop = true;
+  };
+
+  std::exception_ptr backwardError;
+  std::thread backwardThread([&]() {
+    try
+    {
+      propagate(backward, forward);
+    }
+    catch (...)
+    {
+      backwardError = std::current_exception();
+      stop = true;
+    }
+  });
+
+  try
+  {
+    propagate(forward, backward);
+  }
+  catch (...)
+  {
+    stop = true;
+    backwardThread.join();
+    throw;
+  }
+
+  backwardThread.join();
+  if (backwardError)
+    std::rethrow_exception(backwardError);
+
+  if (cancelled)
+    return Result::Cancelled;
+
+  if (!foundAnyPath)
+    return Result::NoPath;
+
+  ReconstructPathBidirectional(bestForwardVertex, bestBackwardVertex, forwardParents,
+                               backwardParents, result.m_path);
+  result.m_distance = bestPathRealLength;
+  return Result::OK;
+}
+
+// static
+template <typename Vertex, typename Edge, typename Weight>
+void AStarAlgorithm<Vertex, Edge, Weight>::MakeRemainingTree(std::vector<Edge> const & route,
+                                                             RemainingTree & tree)
+{
+  tree.Clear();
+
+  auto remainingDistance = kZeroDistance;
+  for (auto it = route.crbegin(); it != route.crend(); ++it)
+  {
+    tree.m_weights[it->GetTarget()] = remainingDistance;
+    if (it != route.crbegin())
+      tree.m_next[it->GetTarget()] = std::prev(it)->GetTarget();
+
+    remainingDistance += it->GetWeight();
+  }
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <class P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalWithAlternatives(
+    P & params, AlternativesParams const & altParams, RoutingResult<Vertex, Weight> & result,
+    std::vector<RoutingResult<Vertex, Weight>> & alternatives) const
+{
+  alternatives.clear();
+
+  auto const epsilon = params.m_weightEpsilon;
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+
+  auto & forwardParents = forward.GetParents();
+  auto & backwardParents = backward.GetParents();
+
+  // Real (not reduced) distances from the start for the forward wave and to the finish for
+  // the backward one. They are not needed by the search itself but by candidate evaluation.
+  ska::bytell_hash_map<Vertex, Weight> realDistances[2];
+  auto & forwardReal = realDistances[0];
+  auto & backwardReal = realDistances[1];
+
+  bool foundAnyPath = false;
+  Weight bestPathReducedLength = kZeroDistance;
+  Weight bestPathRealLength = kZeroDistance;
+
+  forward.UpdateDistance(State(startVertex, kZeroDistance));
+  forward.queue.push(State(startVertex, kZeroDistance, forward.ConsistentHeuristic(startVertex)));
+  forwardReal[startVertex] = kZeroDistance;
+
+  backward.UpdateDistance(State(finalVertex, kZeroDistance));
+  backward.queue.push(State(finalVertex, kZeroDistance, backward.ConsistentHeuristic(finalVertex)));
+  backwardReal[finalVertex] = kZeroDistance;
+
+  BidirectionalStepContext * cur = &forward;
+  BidirectionalStepContext * nxt = &backward;
+
+  typename Graph::EdgeListT adj;
+
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  while (!cur->queue.empty() && !nxt->queue.empty())
+  {
+    if (periodicCancellable.IsCancelled())
+      return Result::Cancelled;
+
+    // In contrast to FindPathBidirectionalEx the search goes on until no route within
+    // the stretch limit can be found. Reduced and real lengths of a route differ by a constant,
+    // so the limit may be applied to the reduced length. The wave with the smaller top distance
+    // is propagated, so both trees cover the vertices of such routes and give candidates.
+    auto const curTop = cur->TopDistance();
+    auto const nxtTop = nxt->TopDistance();
+    if (foundAnyPath &&
+        curTop + nxtTop >= bestPathReducedLength + altParams.m_maxStretch * bestPathRealLength - epsilon)
+    {
+      break;
+    }
+
+    if (nxtTop < curTop)
+      std::swap(cur, nxt);
+
+    State const stateV = cur->queue.top();
+    cur->queue.pop();
+
+    if (cur->ExistsStateWithBetterDistance(stateV))
+      continue;
+
+    auto const endV = cur->forward ? cur->finalVertex : cur->startVertex;
+    params.m_onVisitedVertexCallback(std::make_pair(stateV, cur), endV);
+
+    cur->GetAdjacencyList(stateV, adj);
+    auto const & pV = stateV.heuristic;
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const weight = edge.GetWeight();
+      auto const pW = cur->ConsistentHeuristic(stateW.vertex);
+      auto const reducedWeight = weight + pW - pV;
+
+      if (reducedWeight < -epsilon && params.m_badReducedWeight(reducedWeight, std::max(pW, pV)))
+      {
+        LOG(LERROR, ("Invariant violated for:", "v =", stateV.vertex, "w =", stateW.vertex,
+                     "reduced weight =", reducedWeight));
+      }
+
+      stateW.distance = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const fullLength = weight + stateV.distance + cur->pS - pV;
+      if (!params.m_checkLengthCallback(fullLength))
+        continue;
+
+      if (cur->ExistsStateWithBetterDistance(stateW, epsilon))
+        continue;
+
+      stateW.heuristic = pW;
+      cur->UpdateDistance(stateW);
+      cur->UpdateParent(stateW.vertex, stateV.vertex);
+      realDistances[cur->forward ? 0 : 1][stateW.vertex] = fullLength;
+
+      if (auto op = nxt->GetDistance(stateW.vertex); op)
+      {
+        auto const & distW = *op;
+        auto const curPathReducedLength = stateW.distance + distW;
+        if ((!foundAnyPath || bestPathReducedLength > curPathReducedLength) &&
+            graph.AreWavesConnectible(forwardParents, stateW.vertex, backwardParents))
+        {
+          bestPathReducedLength = curPathReducedLength;
+
+          bestPathRealLength = stateV.distance + weight + distW;
+          bestPathRealLength += cur->pS - pV;
+          bestPathRealLength += nxt->pS - nxt->ConsistentHeuristic(stateW.vertex);
+
+          foundAnyPath = true;
+          cur->bestVertex = stateV.vertex;
+          nxt->bestVertex = stateW.vertex;
+        }
+      }
+
+      if (stateW.vertex != endV)
+        cur->queue.push(stateW);
+    }
+  }
+
+  if (!foundAnyPath)
+    return Result::NoPath;
+
+  result.m_path.clear();
+  ReconstructPathBidirectional(forward.bestVertex, backward.bestVertex, forwardParents,
+                               backwardParents, result.m_path);
+  result.m_distance = bestPathRealLength;
+
+  if (altParams.m_maxAlternatives == 0)
+    return Result::OK;
+
+  // Route start -> v -> finish along the search trees with distances from the start.
+  auto const reconstructViaPath = [&](Vertex const & v, std::vector<Vertex> & path,
+                                      std::vector<Weight> & distances)
+  {
+    ReconstructPathBidirectional(v, v, forwardParents, backwardParents, path);
+    // |v| is the last vertex of the forward part and the first one of the backward part.
+    auto const viaIt = std::find(path.begin(), path.end(), v);
+    CHECK(viaIt != path.end(), ());
+    path.erase(viaIt);
+
+    auto const length = forwardReal.at(v) + backwardReal.at(v);
+    distances.resize(path.size());
+    bool backwardPart = false;
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      backwardPart = backwardPart || path[i] == v;
+      distances[i] = backwardPart ? length - backwardReal.at(path[i]) : forwardReal.at(path[i]);
+    }
+  };
+
+  // Weight of the edges of |path| which are edges of the route indexed by |routeIndex|.
+  auto const getSharedWeight = [](std::vector<Vertex> const & path,
+                                  std::vector<Weight> const & distances,
+                                  ska::bytell_hash_map<Vertex, size_t> const & routeIndex,
+                                  std::vector<Weight> const & routeDistances)
+  {
+    Weight shared = kZeroDistance;
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      auto const from = routeIndex.find(path[i - 1]);
+      if (from == routeIndex.cend())
+        continue;
+      auto const to = routeIndex.find(path[i]);
+      if (to == routeIndex.cend() || to->second != from->second + 1)
+        continue;
+
+      shared += std::max(routeDistances[to->second] - routeDistances[from->second], kZeroDistance);
+    }
+    return shared;
+  };
+
+  ska::bytell_hash_map<Vertex, size_t> mainIndex;
+  std::vector<Weight> mainDistances(result.m_path.size());
+  {
+    bool backwardPart = false;
+    for (size_t i = 0; i < result.m_path.size(); ++i)
+    {
+      auto const & v = result.m_path[i];
+      mainIndex[v] = i;
+      backwardPart = backwardPart || v == backward.bestVertex;
+      mainDistances[i] = backwardPart ? bestPathRealLength - backwardReal.at(v) : forwardReal.at(v);
+    }
+  }
+
+  struct Candidate
+  {
+    Vertex m_vertex;
+    Weight m_length;
+    bool m_valid = false;
+  };
+
+  Weight const maxLength = (1.0 + altParams.m_maxStretch) * bestPathRealLength;
+  std::vector<Candidate> candidates;
+  for (auto const & [v, forwardLength] : forwardReal)
+  {
+    if (mainIndex.count(v) != 0)
+      continue;
+
+    auto const it = backwardReal.find(v);
+    if (it == backwardReal.cend() || forwardLength + it->second > maxLength)
+      continue;
+
+    candidates.push_back({v, forwardLength + it->second});
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](Candidate const & lhs, Candidate const & rhs)
+  {
+    return lhs.m_length < rhs.m_length;
+  });
+  if (candidates.size() > altParams.m_maxCandidates)
+    candidates.resize(altParams.m_maxCandidates);
+
+  // Evaluation of a candidate only reads the search trees, so it is done in parallel.
+  std::atomic<size_t> nextCandidate = 0;
+  auto const evaluate = [&]()
+  {
+    std::vector<Vertex> path;
+    std::vector<Weight> distances;
+    ska::bytell_hash_set<Vertex> visited;
+    for (size_t i = nextCandidate++; i < candidates.size(); i = nextCandidate++)
+    {
+      auto & candidate = candidates[i];
+      reconstructViaPath(candidate.m_vertex, path, distances);
+
+      visited.clear();
+      bool isSimple = true;
+      for (auto const & v : path)
+      {
+        if (!visited.insert(v).second)
+        {
+          isSimple = false;
+          break;
+        }
+      }
+
+      candidate.m_valid =
+          isSimple && getSharedWeight(path, distances, mainIndex, mainDistances) <=
+                          altParams.m_maxSharing * candidate.m_length;
+    }
+  };
+
+  size_t const threadsCount =
+      std::min(std::max(altParams.m_threadsCount, size_t{1}), candidates.size());
+  if (threadsCount <= 1)
+  {
+    evaluate();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+      threads.emplace_back(evaluate);
+    for (auto & t : threads)
+      t.join();
+  }
+
+  // Greedy choice of the shortest candidates which are different enough from the chosen ones.
+  struct ChosenRoute
+  {
+    ska::bytell_hash_map<Vertex, size_t> m_index;
+    std::vector<Weight> m_distances;
+  };
+  std::vector<ChosenRoute> chosen;
+
+  std::vector<Vertex> path;
+  std::vector<Weight> distances;
+  for (auto const & candidate : candidates)
+  {
+    if (alternatives.size() >= altParams.m_maxAlternatives)
+      break;
+
+    if (!candidate.m_valid)
+      continue;
+
+    // A candidate on a chosen alternative gives the same route.
+    auto const onChosen = std::any_of(chosen.cbegin(), chosen.cend(), [&](ChosenRoute const & r)
+    {
+      return r.m_index.count(candidate.m_vertex) != 0;
+    });
+    if (onChosen)
+      continue;
+
+    reconstructViaPath(candidate.m_vertex, path, distances);
+
+    auto const maxShared = altParams.m_maxSharing * candidate.m_length;
+    auto const sharesTooMuch = std::any_of(chosen.cbegin(), chosen.cend(), [&](ChosenRoute const & r)
+    {
+      return getSharedWeight(path, distances, r.m_index, r.m_distances) > maxShared;
+    });
+    if (sharesTooMuch)
+      continue;
+
+    if (!graph.AreWavesConnectible(forwardParents, candidate.m_vertex, backwardParents))
+      continue;
+
+    ChosenRoute route;
+    for (size_t i = 0; i < path.size(); ++i)
+      route.m_index[path[i]] = i;
+    route.m_distances = distances;
+    chosen.push_back(std::move(route));
+
+    RoutingResult<Vertex, Weight> alternative;
+    alternative.m_path = path;
+    alternative.m_distance = candidate.m_length;
+    alternatives.push_back(std::move(alternative));
+  }
+
+  return Result::OK;
+}
+
 template <typename Vertex, typename Edge, typename Weight>
 template <typename P>
 typename AStarAlgorithm<Vertex, Edge, Weight>::Result
 AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
                                                   std::vector<Edge> const & prevRoute,
                                                   RoutingResult<Vertex, Weight> & result) const
+{
+  CHECK(!prevRoute.empty(), ());
+
+  RemainingTree tree;
+  MakeRemainingTree(prevRoute, tree);
+  return AdjustRoute(params, tree, result);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params, RemainingTree const & tree,
+                                                  RoutingResult<Vertex, Weight> & result) const
 {
   auto & graph = params.m_graph;
   auto const & startVertex = params.m_startVertex;
-  CHECK(!prevRoute.empty(), ());
+  CHECK(!tree.IsEmpty(), ());
 
   result.Clear();
 
@@ -754,15 +1419,6 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
   auto minDistance = kInfiniteDistance;
   Vertex returnVertex;
 
-  std::map<Vertex, Weight> remainingDistances;
-  auto remainingDistance = kZeroDistance;
-
-  for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
-  {
-    remainingDistances[it->GetTarget()] = remainingDistance;
-    remainingDistance += it->GetWeight();
-  }
-
   Context context(graph);
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
@@ -774,12 +1430,18 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
       return false;
     }
 
+    // Remaining weights are not negative, so a vertex which is farther than the best found
+    // connection can't improve it.
+    auto const distance = context.GetDistance(vertex);
+    if (distance >= minDistance)
+      return false;
+
     params.m_onVisitedVertexCallback(startVertex, vertex);
 
-    auto it = remainingDistances.find(vertex);
-    if (it != remainingDistances.cend())
+    auto it = tree.m_weights.find(vertex);
+    if (it != tree.m_weights.cend())
     {
-      auto const fullDistance = context.GetDistance(vertex) + it->second;
+      auto const fullDistance = distance + it->second;
       if (fullDistance < minDistance)
       {
         minDistance = fullDistance;
@@ -811,25 +1473,15 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
   context.ReconstructPath(returnVertex, result.m_path);
 
   // Append remaining route.
-  bool found = false;
-  for (size_t i = 0; i < prevRoute.size(); ++i)
+  for (auto it = tree.m_next.find(returnVertex); it != tree.m_next.cend();
+       it = tree.m_next.find(it->second))
   {
-    if (prevRoute[i].GetTarget() == returnVertex)
-    {
-      for (size_t j = i + 1; j < prevRoute.size(); ++j)
-        result.m_path.push_back(prevRoute[j].GetTarget());
-
-      found = true;
-      break;
-    }
+    result.m_path.push_back(it->second);
+    CHECK_LESS_OR_EQUAL(result.m_path.size(), context.GetParents().size() + tree.m_next.size() + 1,
+                        ("Cycle in remaining tree, return vertex:", returnVertex));
   }
 
-  CHECK(found, ("Can't find", returnVertex, ", prev:", prevRoute.size(),
-                ", adjust:", result.m_path.size()));
-
-  auto const & it = remainingDistances.find(returnVertex);
-  CHECK(it != remainingDistances.end(), ());
-  result.m_distance = context.GetDistance(returnVertex) + it->second;
+  result.m_distance = minDistance;
   return Result::OK;
 }
 
@@ -79,6 +79,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  swap(m_segIndex, rhs.m_segIndex);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -106,6 +107,13 @@ void FollowedPolyline::Update()
     m_segProj.emplace_back(p1, p2);
   }
 
+  m_segIndex.Clear();
+  if (n > kMaxScannedSegments)
+  {
+    for (size_t i = 0; i < n; ++i)
+      m_segIndex.Add(i, m2::RectD(m_poly.GetPoint(i), m_poly.GetPoint(i + 1)));
+  }
+
   m_current = Iter(m_poly.Front(), 0);
 }
 
@@ -229,20 +237,20 @@ Iter FollowedPolyline::GetClosestMatchingProjectionInInterval(m2::RectD const &
 
   m2::PointD const currPos = posRect.Center();
 
-  for (size_t i = startIdx; i < endIdx; ++i)
+  ForEachSegmentInInterval(posRect, startIdx, endIdx, [&](size_t i)
   {
     m2::PointD const pt = m_segProj[i].ClosestPointTo(currPos);
 
     if (!posRect.IsPointInside(pt))
-      continue;
+      return;
 
     double const dp = mercator::DistanceOnEarth(pt, currPos);
-    if (dp >= minDist)
-      continue;
+    if (dp > minDist || (dp == minDist && i > nearestIter.m_ind))
+      return;
 
     nearestIter = Iter(pt, i);
     minDist = dp;
-  }
+  });
 
   return nearestIter;
 }
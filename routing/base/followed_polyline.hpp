@@ -1,10 +1,13 @@
 #pragma once
 
+#include "coding/point_coding.hpp"
+
 #include "geometry/mercator.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/polyline2d.hpp"
 #include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
 #include <cstddef>
 #include <limits>
@@ -102,21 +105,21 @@ public:
     Iter res;
     double minDist = std::numeric_limits<double>::max();
 
-    for (size_t i = startIdx; i < endIdx; ++i)
+    ForEachSegmentInInterval(posRect, startIdx, endIdx, [&](size_t i)
     {
       m2::PointD const & pt = m_segProj[i].ClosestPointTo(posRect.Center());
 
       if (!posRect.IsPointInside(pt))
-        continue;
+        return;
 
       Iter it(pt, i);
       double const dp = distFn(it);
-      if (dp < minDist)
+      if (dp < minDist || (dp == minDist && i < res.m_ind))
       {
         res = it;
         minDist = dp;
       }
-    }
+    });
 
     return res;
   }
@@ -127,6 +130,32 @@ public:
   bool IsFakeSegment(size_t index) const;
 
 private:
+  /// Intervals which are longer are looked up in |m_segIndex| instead of scanning.
+  static size_t constexpr kMaxScannedSegments = 32;
+
+  /// \brief Calls |fn| for indexes in [|startIdx|, |endIdx|) of the segments which may have a point
+  /// inside |posRect|. Segments of a long interval come in arbitrary order, so |fn| should prefer
+  /// the smaller index of equally good segments to get the same result as the scan.
+  template <typename Fn>
+  void ForEachSegmentInInterval(m2::RectD const & posRect, size_t startIdx, size_t endIdx,
+                                Fn && fn) const
+  {
+    if (endIdx - startIdx <= kMaxScannedSegments)
+    {
+      for (size_t i = startIdx; i < endIdx; ++i)
+        fn(i);
+      return;
+    }
+
+    // The rects which only touch each other don't intersect in the index.
+    auto const rect = m2::Inflate(posRect, kMwmPointAccuracy, kMwmPointAccuracy);
+    m_segIndex.ForEachInRect(rect, [&](size_t i)
+    {
+      if (startIdx <= i && i < endIdx)
+        fn(i);
+    });
+  }
+
   /// \returns iterator to the best projection of center of |posRect| to the |m_poly|.
   /// If there's a good projection of center of |posRect| to two closest segments of |m_poly|
   /// after |m_current| the iterator corresponding of the projection is returned.
@@ -147,6 +176,8 @@ private:
   size_t m_nextCheckpointIndex;
   /// Precalculated info for fast projection finding.
   std::vector<m2::ParametrizedSegment<m2::PointD>> m_segProj;
+  /// Rects of |m_segProj| for projection to far segments. It's built for long polylines only.
+  m4::Tree<size_t> m_segIndex;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
 };
@@ -4,10 +4,14 @@
 
 #include "indexer/data_source.hpp"
 
+#include "coding/memory_region.hpp"
+
 #include "base/logging.hpp"
 
 #include <utility>
 
+#include "3party/succinct/elias_fano.hpp"
+
 #include "defines.hpp"
 
 namespace routing
@@ -20,7 +24,14 @@ bool CityRoads::IsCityRoad(uint32_t fid) const
 void CityRoads::Load(ReaderT const & reader)
 {
   ReaderSource<ReaderT> src(reader);
-  CityRoadsSerializer::Deserialize(src, m_cityRoadsRegion, m_cityRoads);
+  std::unique_ptr<CopiedMemoryRegion> cityRoadsRegion;
+  succinct::elias_fano cityRoads;
+  CityRoadsSerializer::Deserialize(src, cityRoadsRegion, cityRoads);
+
+  m_cityRoads.assign(cityRoads.size(), false);
+  succinct::elias_fano::select_enumerator it(cityRoads, 0 /* i */);
+  for (uint64_t i = 0; i < cityRoads.num_ones(); ++i)
+    m_cityRoads[it.next()] = true;
 }
 
 std::unique_ptr<CityRoads> LoadCityRoads(MwmSet::MwmHandle const & handle)
@@ -2,19 +2,18 @@
 
 #include "indexer/mwm_set.hpp"
 
-#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
 
+#include <cstdint>
 #include <memory>
-
-#include "3party/succinct/elias_fano.hpp"
+#include <vector>
 
 namespace routing
 {
 class CityRoads
 {
 public:
-  bool HaveCityRoads() const { return m_cityRoads.size() > 0; }
+  bool HaveCityRoads() const { return !m_cityRoads.empty(); }
   /// \returns true if |fid| is a feature id of a road (for cars, bicycles or pedestrians) in city
   /// or town.
   /// \note if there's no section with city roads returns false. That means for maps without
@@ -25,9 +24,9 @@ public:
   void Load(ReaderT const & reader);
 
 private:
-  std::unique_ptr<CopiedMemoryRegion> m_cityRoadsRegion;
-  // |m_cityRoads| contains true for feature ids which are roads in cities.
-  succinct::elias_fano m_cityRoads;
+  // |m_cityRoads| contains true for feature ids which are roads in cities. The compressed section
+  // data is decoded on loading, because it's looked up for every road loaded by the routing.
+  std::vector<bool> m_cityRoads;
 };
 
 std::unique_ptr<CityRoads> LoadCityRoads(MwmSet::MwmHandle const & handle);
@@ -0,0 +1,510 @@
+#include "routing/contraction_hierarchy.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+#include "3party/skarupke/bytell_hash_map.hpp"
+
+namespace routing
+{
+namespace
+{
+using Vertex = ContractionHierarchy::Vertex;
+using Weight = ContractionHierarchy::Weight;
+using HierarchyEdge = ContractionHierarchy::HierarchyEdge;
+
+using QueueItem = std::pair<Weight, Vertex>;
+using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+Weight constexpr kInf = ContractionHierarchy::kUnreachable;
+
+class Contractor
+{
+public:
+  Contractor(uint32_t verticesCount, std::vector<ContractionHierarchy::Edge> const & edges,
+             ContractionHierarchy::BuildParams const & params)
+    : m_params(params)
+    , m_outgoing(verticesCount)
+    , m_ingoing(verticesCount)
+    , m_contracted(verticesCount, false)
+    , m_contractedNeighbours(verticesCount, 0)
+    , m_witnessDistances(verticesCount, kInf)
+    , m_ranks(verticesCount, 0)
+    , m_up(verticesCount)
+    , m_down(verticesCount)
+  {
+    for (auto const & edge : edges)
+    {
+      CHECK_LESS(edge.m_from, verticesCount, (edge));
+      CHECK_LESS(edge.m_to, verticesCount, (edge));
+      CHECK_GREATER_OR_EQUAL(edge.m_weight, 0.0, (edge));
+      if (edge.m_from != edge.m_to)
+        AddEdge(edge.m_from, edge.m_to, edge.m_weight, ContractionHierarchy::kInvalidVertex);
+    }
+  }
+
+  void Run()
+  {
+    uint32_t const verticesCount = static_cast<uint32_t>(m_ranks.size());
+
+    using PriorityItem = std::pair<int64_t, Vertex>;
+    std::priority_queue<PriorityItem, std::vector<PriorityItem>, std::greater<PriorityItem>> queue;
+    for (Vertex v = 0; v < verticesCount; ++v)
+      queue.emplace(GetPriority(v), v);
+
+    uint32_t rank = 0;
+    size_t shortcuts = 0;
+    while (!queue.empty())
+    {
+      Vertex const v = queue.top().second;
+      queue.pop();
+
+      // Priorities of the queued vertices are updated lazily: a vertex is contracted only if
+      // its actual priority is still not worse than the best queued one.
+      auto const priority = GetPriority(v);
+      if (!queue.empty() && priority > queue.top().first)
+      {
+        queue.emplace(priority, v);
+        continue;
+      }
+
+      shortcuts += Contract(v, rank++);
+    }
+
+    LOG(LDEBUG, ("Contraction hierarchy is built. Vertices:", verticesCount,
+                 "shortcuts:", shortcuts));
+  }
+
+  std::vector<uint32_t> & GetRanks() { return m_ranks; }
+  std::vector<std::vector<HierarchyEdge>> & GetUpEdges() { return m_up; }
+  std::vector<std::vector<HierarchyEdge>> & GetDownEdges() { return m_down; }
+
+private:
+  struct Shortcut
+  {
+    Vertex m_from;
+    Vertex m_to;
+    Weight m_weight;
+  };
+
+  static void AddOrRelax(std::vector<HierarchyEdge> & edges, Vertex target, Weight weight,
+                         Vertex middle)
+  {
+    for (auto & edge : edges)
+    {
+      if (edge.m_target != target)
+        continue;
+
+      if (weight < edge.m_weight)
+      {
+        edge.m_weight = weight;
+        edge.m_middle = middle;
+      }
+      return;
+    }
+    edges.push_back({target, middle, weight});
+  }
+
+  void AddEdge(Vertex from, Vertex to, Weight weight, Vertex middle)
+  {
+    AddOrRelax(m_outgoing[from], to, weight, middle);
+    AddOrRelax(m_ingoing[to], from, weight, middle);
+  }
+
+  // Dijkstra from |source| which avoids |avoid| and contracted vertices.
+  // Distances are left in |m_witnessDistances| until the next search.
+  void WitnessSearch(Vertex source, Vertex avoid, Weight limit)
+  {
+    for (auto const v : m_witnessTouched)
+      m_witnessDistances[v] = kInf;
+    m_witnessTouched.clear();
+
+    Queue queue;
+    m_witnessDistances[source] = 0.0;
+    m_witnessTouched.push_back(source);
+    queue.emplace(0.0, source);
+
+    uint32_t settled = 0;
+    while (!queue.empty() && settled < m_params.m_witnessSettledLimit)
+    {
+      auto const [distance, v] = queue.top();
+      queue.pop();
+      if (distance > m_witnessDistances[v])
+        continue;
+      if (distance > limit)
+        break;
+
+      ++settled;
+      for (auto const & edge : m_outgoing[v])
+      {
+        if (edge.m_target == avoid || m_contracted[edge.m_target])
+          continue;
+
+        Weight const newDistance = distance + edge.m_weight;
+        if (newDistance >= m_witnessDistances[edge.m_target])
+          continue;
+
+        if (m_witnessDistances[edge.m_target] == kInf)
+          m_witnessTouched.push_back(edge.m_target);
+        m_witnessDistances[edge.m_target] = newDistance;
+        queue.emplace(newDistance, edge.m_target);
+      }
+    }
+  }
+
+  void FindShortcuts(Vertex v, std::vector<Shortcut> & shortcuts)
+  {
+    shortcuts.clear();
+    for (auto const & in : m_ingoing[v])
+    {
+      Vertex const u = in.m_target;
+      if (m_contracted[u])
+        continue;
+
+      Weight limit = 0.0;
+      bool hasTargets = false;
+      for (auto const & out : m_outgoing[v])
+      {
+        if (out.m_target != u && !m_contracted[out.m_target])
+        {
+          limit = std::max(limit, in.m_weight + out.m_weight);
+          hasTargets = true;
+        }
+      }
+
+      if (!hasTargets)
+        continue;
+
+      WitnessSearch(u, v, limit);
+      for (auto const & out : m_outgoing[v])
+      {
+        Vertex const w = out.m_target;
+        if (w == u || m_contracted[w])
+          continue;
+
+        Weight const weight = in.m_weight + out.m_weight;
+        if (m_witnessDistances[w] <= weight)
+          continue;
+
+        shortcuts.push_back({u, w, weight});
+      }
+    }
+  }
+
+  // Edge difference heuristic: number of added shortcuts minus number of removed edges.
+  // Counting contracted neighbours spreads contraction uniformly over the graph.
+  int64_t GetPriority(Vertex v)
+  {
+    FindShortcuts(v, m_shortcuts);
+
+    int64_t removed = 0;
+    for (auto const & edge : m_ingoing[v])
+      removed += m_contracted[edge.m_target] ? 0 : 1;
+    for (auto const & edge : m_outgoing[v])
+      removed += m_contracted[edge.m_target] ? 0 : 1;
+
+    return static_cast<int64_t>(m_shortcuts.size()) - removed + m_contractedNeighbours[v];
+  }
+
+  size_t Contract(Vertex v, uint32_t rank)
+  {
+    FindShortcuts(v, m_shortcuts);
+
+    m_ranks[v] = rank;
+    m_contracted[v] = true;
+
+    for (auto const & edge : m_outgoing[v])
+    {
+      if (m_contracted[edge.m_target])
+        continue;
+      m_up[v].push_back(edge);
+      ++m_contractedNeighbours[edge.m_target];
+    }
+
+    for (auto const & edge : m_ingoing[v])
+    {
+      if (m_contracted[edge.m_target])
+        continue;
+      m_down[v].push_back(edge);
+      ++m_contractedNeighbours[edge.m_target];
+    }
+
+    for (auto const & shortcut : m_shortcuts)
+      AddEdge(shortcut.m_from, shortcut.m_to, shortcut.m_weight, v);
+
+    // Edges of the contracted vertex are not needed for the rest of the build.
+    m_outgoing[v] = {};
+    m_ingoing[v] = {};
+    return m_shortcuts.size();
+  }
+
+  ContractionHierarchy::BuildParams const m_params;
+
+  std::vector<std::vector<HierarchyEdge>> m_outgoing;
+  std::vector<std::vector<HierarchyEdge>> m_ingoing;
+  std::vector<bool> m_contracted;
+  std::vector<int64_t> m_contractedNeighbours;
+
+  std::vector<Weight> m_witnessDistances;
+  std::vector<Vertex> m_witnessTouched;
+  std::vector<Shortcut> m_shortcuts;
+
+  std::vector<uint32_t> m_ranks;
+  std::vector<std::vector<HierarchyEdge>> m_up;
+  std::vector<std::vector<HierarchyEdge>> m_down;
+};
+
+void Flatten(std::vector<std::vector<HierarchyEdge>> && adjacency, std::vector<uint32_t> & offsets,
+             std::vector<HierarchyEdge> & edges)
+{
+  offsets.clear();
+  edges.clear();
+  offsets.reserve(adjacency.size() + 1);
+  offsets.push_back(0);
+  for (auto & adj : adjacency)
+  {
+    edges.insert(edges.end(), adj.begin(), adj.end());
+    CHECK_LESS_OR_EQUAL(edges.size(), std::numeric_limits<uint32_t>::max(), ());
+    offsets.push_back(static_cast<uint32_t>(edges.size()));
+    adj = {};
+  }
+}
+
+struct SearchDirection
+{
+  ska::bytell_hash_map<Vertex, Weight> m_distances;
+  ska::bytell_hash_map<Vertex, Vertex> m_parents;
+  Queue m_queue;
+
+  Weight GetDistance(Vertex v) const
+  {
+    auto const it = m_distances.find(v);
+    return it == m_distances.cend() ? kInf : it->second;
+  }
+
+  Weight TopDistance() const { return m_queue.empty() ? kInf : m_queue.top().first; }
+
+  void Relax(Vertex from, Vertex to, Weight distance)
+  {
+    auto const it = m_distances.find(to);
+    if (it != m_distances.cend() && it->second <= distance)
+      return;
+
+    m_distances[to] = distance;
+    m_parents[to] = from;
+    m_queue.emplace(distance, to);
+  }
+};
+}  // namespace
+
+void ContractionHierarchy::Build(uint32_t verticesCount, std::vector<Edge> const & edges)
+{
+  Build(verticesCount, edges, BuildParams());
+}
+
+void ContractionHierarchy::Build(uint32_t verticesCount, std::vector<Edge> const & edges,
+                                 BuildParams const & params)
+{
+  Contractor contractor(verticesCount, edges, params);
+  contractor.Run();
+
+  m_ranks = std::move(contractor.GetRanks());
+  Flatten(std::move(contractor.GetUpEdges()), m_upOffsets, m_upEdges);
+  Flatten(std::move(contractor.GetDownEdges()), m_downOffsets, m_downEdges);
+}
+
+size_t ContractionHierarchy::GetShortcutsCount() const
+{
+  auto const isShortcut = [](HierarchyEdge const & edge) {
+    return edge.m_middle != kInvalidVertex;
+  };
+  return std::count_if(m_upEdges.cbegin(), m_upEdges.cend(), isShortcut) +
+         std::count_if(m_downEdges.cbegin(), m_downEdges.cend(), isShortcut);
+}
+
+uint32_t ContractionHierarchy::GetRank(Vertex v) const
+{
+  CHECK_LESS(v, m_ranks.size(), ());
+  return m_ranks[v];
+}
+
+bool ContractionHierarchy::FindPath(Vertex from, Vertex to,
+                                    RoutingResult<Vertex, Weight> & result) const
+{
+  result.Clear();
+
+  std::vector<Vertex> forwardPath;
+  std::vector<Vertex> backwardPath;
+  Weight distance = kUnreachable;
+  Vertex const meeting = Query(from, to, distance, &forwardPath, &backwardPath);
+  if (meeting == kInvalidVertex)
+    return false;
+
+  // |forwardPath| is meeting -> ... -> from, |backwardPath| is meeting -> ... -> to.
+  std::reverse(forwardPath.begin(), forwardPath.end());
+  result.m_path.push_back(from);
+  for (size_t i = 0; i + 1 < forwardPath.size(); ++i)
+    UnpackEdge(forwardPath[i], forwardPath[i + 1], result.m_path);
+  for (size_t i = 0; i + 1 < backwardPath.size(); ++i)
+    UnpackEdge(backwardPath[i], backwardPath[i + 1], result.m_path);
+
+  result.m_distance = distance;
+  return true;
+}
+
+ContractionHierarchy::Weight ContractionHierarchy::GetDistance(Vertex from, Vertex to) const
+{
+  Weight distance = kUnreachable;
+  Query(from, to, distance, nullptr /* forwardPath */, nullptr /* backwardPath */);
+  return distance;
+}
+
+ContractionHierarchy::Vertex ContractionHierarchy::Query(
+    Vertex from, Vertex to, Weight & distance, std::vector<Vertex> * forwardPath,
+    std::vector<Vertex> * backwardPath) const
+{
+  CHECK_LESS(from, GetVerticesCount(), ());
+  CHECK_LESS(to, GetVerticesCount(), ());
+
+  distance = kUnreachable;
+  if (from == to)
+  {
+    distance = 0.0;
+    if (forwardPath)
+      forwardPath->assign({from});
+    if (backwardPath)
+      backwardPath->assign({to});
+    return from;
+  }
+
+  SearchDirection forward;
+  SearchDirection backward;
+  forward.Relax(kInvalidVertex, from, 0.0);
+  backward.Relax(kInvalidVertex, to, 0.0);
+
+  Vertex meeting = kInvalidVertex;
+  bool isForward = true;
+  while (std::min(forward.TopDistance(), backward.TopDistance()) < distance)
+  {
+    if (forward.m_queue.empty() || backward.m_queue.empty())
+      isForward = !forward.m_queue.empty();
+
+    auto & cur = isForward ? forward : backward;
+    auto const & other = isForward ? backward : forward;
+    auto const & offsets = isForward ? m_upOffsets : m_downOffsets;
+    auto const & edges = isForward ? m_upEdges : m_downEdges;
+    // Edges which lead to |v| from higher vertices in the current direction. They are used for
+    // stall-on-demand: if some higher vertex gives a shorter distance to |v|, |v| is not on
+    // a shortest up-down path and its edges need not be relaxed.
+    auto const & stallOffsets = isForward ? m_downOffsets : m_upOffsets;
+    auto const & stallEdges = isForward ? m_downEdges : m_upEdges;
+    isForward = !isForward;
+
+    if (cur.TopDistance() >= distance)
+      continue;
+
+    auto const [d, v] = cur.m_queue.top();
+    cur.m_queue.pop();
+    if (d > cur.GetDistance(v))
+      continue;
+
+    if (auto const otherDistance = other.GetDistance(v); otherDistance != kInf)
+    {
+      if (d + otherDistance < distance)
+      {
+        distance = d + otherDistance;
+        meeting = v;
+      }
+    }
+
+    bool stalled = false;
+    for (uint32_t i = stallOffsets[v]; i < stallOffsets[v + 1]; ++i)
+    {
+      auto const higherDistance = cur.GetDistance(stallEdges[i].m_target);
+      if (higherDistance != kInf && higherDistance + stallEdges[i].m_weight < d)
+      {
+        stalled = true;
+        break;
+      }
+    }
+
+    if (stalled)
+      continue;
+
+    for (uint32_t i = offsets[v]; i < offsets[v + 1]; ++i)
+      cur.Relax(v, edges[i].m_target, d + edges[i].m_weight);
+  }
+
+  if (meeting == kInvalidVertex)
+    return kInvalidVertex;
+
+  auto const collect = [meeting](SearchDirection const & direction, std::vector<Vertex> & path) {
+    path.clear();
+    for (Vertex v = meeting; v != kInvalidVertex; v = direction.m_parents.at(v))
+      path.push_back(v);
+  };
+
+  if (forwardPath)
+    collect(forward, *forwardPath);
+  if (backwardPath)
+    collect(backward, *backwardPath);
+  return meeting;
+}
+
+ContractionHierarchy::HierarchyEdge const * ContractionHierarchy::FindUpEdge(Vertex from,
+                                                                             Vertex to) const
+{
+  for (uint32_t i = m_upOffsets[from]; i < m_upOffsets[from + 1]; ++i)
+  {
+    if (m_upEdges[i].m_target == to)
+      return &m_upEdges[i];
+  }
+  return nullptr;
+}
+
+ContractionHierarchy::HierarchyEdge const * ContractionHierarchy::FindDownEdge(Vertex from,
+                                                                               Vertex to) const
+{
+  for (uint32_t i = m_downOffsets[to]; i < m_downOffsets[to + 1]; ++i)
+  {
+    if (m_downEdges[i].m_target == from)
+      return &m_downEdges[i];
+  }
+  return nullptr;
+}
+
+void ContractionHierarchy::UnpackEdge(Vertex from, Vertex to, std::vector<Vertex> & path) const
+{
+  // Shortcuts may be nested deeply, so an explicit stack is used instead of recursion.
+  std::vector<std::pair<Vertex, Vertex>> stack = {{from, to}};
+  while (!stack.empty())
+  {
+    auto const [u, w] = stack.back();
+    stack.pop_back();
+
+    auto const * edge = m_ranks[u] < m_ranks[w] ? FindUpEdge(u, w) : FindDownEdge(u, w);
+    CHECK(edge, ("No hierarchy edge", u, "->", w));
+    if (edge->m_middle == kInvalidVertex)
+    {
+      path.push_back(w);
+      continue;
+    }
+
+    stack.emplace_back(edge->m_middle, w);
+    stack.emplace_back(u, edge->m_middle);
+  }
+}
+
+std::string DebugPrint(ContractionHierarchy::Edge const & edge)
+{
+  std::ostringstream out;
+  out << "ContractionHierarchy::Edge [ " << edge.m_from << " -> " << edge.m_to
+      << ", weight: " << edge.m_weight << " ]";
+  return out.str();
+}
+}  // namespace routing
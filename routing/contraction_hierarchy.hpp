@@ -0,0 +1,172 @@
+#pragma once
+
+#include "routing/base/routing_result.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+// Contraction hierarchy (CH) over a directed graph with vertices [0, verticesCount) and
+// non-negative double weights. Vertices are contracted one by one in the order of their
+// importance and shortcuts are added to keep shortest path distances between the remaining
+// vertices. A query is a bidirectional Dijkstra which walks only "upwards" in the hierarchy,
+// so it settles a small number of vertices even for very long routes.
+//
+// The class knows nothing about mwms and segments: a caller maps its vertices (e.g. cross-mwm
+// transitions) to [0, verticesCount) and builds the hierarchy offline, then serializes it.
+class ContractionHierarchy
+{
+public:
+  using Vertex = uint32_t;
+  using Weight = double;
+
+  static Vertex constexpr kInvalidVertex = std::numeric_limits<Vertex>::max();
+
+  struct Edge
+  {
+    Edge() = default;
+    Edge(Vertex from, Vertex to, Weight weight) : m_from(from), m_to(to), m_weight(weight) {}
+
+    Vertex m_from = kInvalidVertex;
+    Vertex m_to = kInvalidVertex;
+    Weight m_weight = 0.0;
+  };
+
+  // Edge of the hierarchy. For upward edges |m_target| is the head of the edge, for downward
+  // edges |m_target| is the tail, i.e. the edge is walked in reverse direction by backward search.
+  // |m_middle| is the contracted vertex a shortcut bypasses, kInvalidVertex for original edges.
+  struct HierarchyEdge
+  {
+    Vertex m_target = kInvalidVertex;
+    Vertex m_middle = kInvalidVertex;
+    Weight m_weight = 0.0;
+  };
+
+  struct BuildParams
+  {
+    // Witness searches stop after settling so many vertices. Smaller values speed up the build
+    // but may add excess shortcuts, shortest paths are correct anyway.
+    uint32_t m_witnessSettledLimit = 500;
+  };
+
+  ContractionHierarchy() = default;
+
+  // Builds the hierarchy. Parallel edges are merged keeping the lightest one, loops are dropped.
+  void Build(uint32_t verticesCount, std::vector<Edge> const & edges);
+  void Build(uint32_t verticesCount, std::vector<Edge> const & edges, BuildParams const & params);
+
+  uint32_t GetVerticesCount() const { return static_cast<uint32_t>(m_ranks.size()); }
+  size_t GetEdgesCount() const { return m_upEdges.size() + m_downEdges.size(); }
+  size_t GetShortcutsCount() const;
+  uint32_t GetRank(Vertex v) const;
+
+  // Finds the shortest path from |from| to |to|. |result.m_path| contains vertices of the original
+  // graph, shortcuts are unpacked. Returns false if there is no path.
+  bool FindPath(Vertex from, Vertex to, RoutingResult<Vertex, Weight> & result) const;
+
+  // Returns only the shortest distance, without unpacking the path.
+  // Returns kUnreachable if there is no path.
+  Weight GetDistance(Vertex from, Vertex to) const;
+
+  static Weight constexpr kUnreachable = std::numeric_limits<Weight>::max();
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kVersion);
+    WriteToSink(sink, GetVerticesCount());
+    for (auto const rank : m_ranks)
+      WriteToSink(sink, rank);
+
+    SerializeEdges(sink, m_upOffsets, m_upEdges);
+    SerializeEdges(sink, m_downOffsets, m_downEdges);
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kVersion, ("Unknown contraction hierarchy version."));
+
+    auto const verticesCount = ReadPrimitiveFromSource<uint32_t>(src);
+    m_ranks.resize(verticesCount);
+    for (auto & rank : m_ranks)
+      rank = ReadPrimitiveFromSource<uint32_t>(src);
+
+    DeserializeEdges(src, verticesCount, m_upOffsets, m_upEdges);
+    DeserializeEdges(src, verticesCount, m_downOffsets, m_downEdges);
+  }
+
+private:
+  static uint16_t constexpr kVersion = 0;
+
+  template <typename Sink>
+  static void SerializeEdges(Sink & sink, std::vector<uint32_t> const & offsets,
+                             std::vector<HierarchyEdge> const & edges)
+  {
+    CHECK(!offsets.empty(), ());
+    for (auto const offset : offsets)
+      WriteToSink(sink, offset);
+
+    for (auto const & edge : edges)
+    {
+      WriteToSink(sink, edge.m_target);
+      WriteToSink(sink, edge.m_middle);
+      uint64_t bits = 0;
+      static_assert(sizeof(bits) == sizeof(edge.m_weight));
+      std::memcpy(&bits, &edge.m_weight, sizeof(bits));
+      WriteToSink(sink, bits);
+    }
+  }
+
+  template <typename Source>
+  static void DeserializeEdges(Source & src, uint32_t verticesCount,
+                               std::vector<uint32_t> & offsets, std::vector<HierarchyEdge> & edges)
+  {
+    offsets.resize(verticesCount + 1);
+    for (auto & offset : offsets)
+      offset = ReadPrimitiveFromSource<uint32_t>(src);
+
+    edges.resize(offsets.back());
+    for (auto & edge : edges)
+    {
+      edge.m_target = ReadPrimitiveFromSource<uint32_t>(src);
+      edge.m_middle = ReadPrimitiveFromSource<uint32_t>(src);
+      auto const bits = ReadPrimitiveFromSource<uint64_t>(src);
+      std::memcpy(&edge.m_weight, &bits, sizeof(bits));
+      CHECK(edge.m_target < verticesCount, (edge.m_target, verticesCount));
+    }
+  }
+
+  // Returns the meeting vertex of the upward searches or kInvalidVertex.
+  Vertex Query(Vertex from, Vertex to, Weight & distance, std::vector<Vertex> * forwardPath,
+               std::vector<Vertex> * backwardPath) const;
+
+  HierarchyEdge const * FindUpEdge(Vertex from, Vertex to) const;
+  HierarchyEdge const * FindDownEdge(Vertex from, Vertex to) const;
+
+  // Appends the original vertices of the edge |from| -> |to| (except |from|) to |path|.
+  void UnpackEdge(Vertex from, Vertex to, std::vector<Vertex> & path) const;
+
+  std::vector<uint32_t> m_ranks;
+
+  // Upward edges v -> w with rank(w) > rank(v) are stored at v.
+  std::vector<uint32_t> m_upOffsets;
+  std::vector<HierarchyEdge> m_upEdges;
+
+  // Downward edges w -> v with rank(w) > rank(v) are stored at v.
+  std::vector<uint32_t> m_downOffsets;
+  std::vector<HierarchyEdge> m_downEdges;
+};
+
+std::string DebugPrint(ContractionHierarchy::Edge const & edge);
+}  // namespace routing
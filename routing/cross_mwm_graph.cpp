@@ -16,12 +16,13 @@ using namespace std;
 CrossMwmGraph::CrossMwmGraph(shared_ptr<NumMwmIds> numMwmIds,
                              shared_ptr<m4::Tree<NumMwmId>> numMwmTree,
                              VehicleType vehicleType, CountryRectFn const & countryRectFn,
-                             MwmDataSource & dataSource)
+                             MwmDataSource & dataSource,
+                             shared_ptr<ConnectorsCache> connectorsCache)
   : m_dataSource(dataSource)
   , m_numMwmIds(numMwmIds)
   , m_numMwmTree(numMwmTree)
   , m_countryRectFn(countryRectFn)
-  , m_crossMwmIndexGraph(m_dataSource, vehicleType)
+  , m_crossMwmIndexGraph(m_dataSource, vehicleType, std::move(connectorsCache))
   , m_crossMwmTransitGraph(m_dataSource, VehicleType::Transit)
 {
   CHECK(m_numMwmIds, ());
@@ -32,10 +32,15 @@ public:
     NoSection,
   };
 
+  using ConnectorsCache = CrossMwmConnectorsCache<base::GeoObjectId>;
+
+  /// \param connectorsCache is shared between graphs to keep connectors between routes.
+  /// It may be nullptr.
   CrossMwmGraph(std::shared_ptr<NumMwmIds> numMwmIds,
                 std::shared_ptr<m4::Tree<NumMwmId>> numMwmTree,
                 VehicleType vehicleType, CountryRectFn const & countryRectFn,
-                MwmDataSource & dataSource);
+                MwmDataSource & dataSource,
+                std::shared_ptr<ConnectorsCache> connectorsCache = nullptr);
 
   /// \brief Transition segment is a segment which is crossed by mwm border. That means
   /// start and finish of such segment have to lie in different mwms. If a segment is
@@ -19,8 +19,10 @@
 #include "base/logging.hpp"
 
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <vector>
 
@@ -52,14 +54,87 @@ inline void AssertConnectorIsFound<TransitId>(NumMwmId /* neighbor */, bool /* i
 }
 }  // namespace connector
 
+/// \brief LRU cache of connectors which is shared between CrossMwmIndexGraph instances, so
+/// routes built one after another don't deserialize connectors of the same mwms again.
+/// \note Connectors keep readers of mwm files, so the cache must be cleared together with
+/// mwm handles of MwmDataSource.
+template <typename CrossMwmId>
+class CrossMwmConnectorsCache final
+{
+public:
+  using ConnectorPtr = std::shared_ptr<CrossMwmConnector<CrossMwmId>>;
+
+  explicit CrossMwmConnectorsCache(size_t maxConnectorsCount)
+    : m_maxConnectorsCount(maxConnectorsCount)
+  {
+    CHECK_GREATER(m_maxConnectorsCount, 0, ());
+  }
+
+  ConnectorPtr Get(NumMwmId numMwmId)
+  {
+    std::lock_guard guard(m_mutex);
+    auto const it = m_connectors.find(numMwmId);
+    if (it == m_connectors.end())
+      return nullptr;
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+    return it->second.m_connector;
+  }
+
+  void Put(NumMwmId numMwmId, ConnectorPtr connector)
+  {
+    std::lock_guard guard(m_mutex);
+    auto const [it, inserted] = m_connectors.emplace(numMwmId, Entry());
+    if (inserted)
+    {
+      m_lru.push_front(numMwmId);
+      it->second.m_lruIt = m_lru.begin();
+    }
+    else
+    {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+    }
+    it->second.m_connector = std::move(connector);
+
+    while (m_connectors.size() > m_maxConnectorsCount)
+    {
+      m_connectors.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+  }
+
+  void Clear()
+  {
+    std::lock_guard guard(m_mutex);
+    m_connectors.clear();
+    m_lru.clear();
+  }
+
+private:
+  struct Entry
+  {
+    ConnectorPtr m_connector;
+    typename std::list<NumMwmId>::iterator m_lruIt;
+  };
+
+  size_t const m_maxConnectorsCount;
+
+  std::mutex m_mutex;
+  std::map<NumMwmId, Entry> m_connectors;
+  std::list<NumMwmId> m_lru;
+};
+
 template <typename CrossMwmId>
 class CrossMwmIndexGraph final
 {
 public:
   using ReaderSourceFile = ReaderSource<FilesContainerR::TReader>;
+  using ConnectorsCache = CrossMwmConnectorsCache<CrossMwmId>;
 
-  CrossMwmIndexGraph(MwmDataSource & dataSource, VehicleType vehicleType)
-    : m_dataSource(dataSource), m_vehicleType(vehicleType)
+  /// \param connectorsCache may be nullptr, then connectors are not shared.
+  CrossMwmIndexGraph(MwmDataSource & dataSource, VehicleType vehicleType,
+                     std::shared_ptr<ConnectorsCache> connectorsCache = nullptr)
+    : m_dataSource(dataSource), m_vehicleType(vehicleType), m_connectorsCache(std::move(connectorsCache))
   {
   }
 
@@ -94,7 +169,7 @@ public:
       if (it == m_connectors.cend())
         continue;
 
-      CrossMwmConnector<CrossMwmId> const & connector = it->second;
+      CrossMwmConnector<CrossMwmId> const & connector = *it->second;
       // Note. Last parameter in the method below (isEnter) should be set to |isOutgoing|.
       // If |isOutgoing| == true |s| should be an exit transition segment and the method below searches enters
       // and the last parameter (|isEnter|) should be set to true.
@@ -160,7 +235,13 @@ public:
   {
     auto const it = m_connectors.find(numMwmId);
     if (it != m_connectors.cend())
-      return it->second;
+      return *it->second;
+
+    if (m_connectorsCache)
+    {
+      if (auto connector = m_connectorsCache->Get(numMwmId))
+        return *m_connectors.emplace(numMwmId, std::move(connector)).first->second;
+    }
 
     return Deserialize(numMwmId, [this](CrossMwmConnectorBuilder<CrossMwmId> & builder, auto & src)
     {
@@ -256,18 +337,25 @@ private:
   {
     MwmValue const & mwmValue = m_dataSource.GetMwmValue(numMwmId);
 
-    auto it = m_connectors.emplace(numMwmId, CrossMwmConnector<CrossMwmId>(numMwmId)).first;
+    auto it = m_connectors.find(numMwmId);
+    if (it == m_connectors.end())
+    {
+      it = m_connectors.emplace(numMwmId, std::make_shared<CrossMwmConnector<CrossMwmId>>(numMwmId)).first;
+      if (m_connectorsCache)
+        m_connectorsCache->Put(numMwmId, it->second);
+    }
 
-    CrossMwmConnectorBuilder<CrossMwmId> builder(it->second);
+    CrossMwmConnectorBuilder<CrossMwmId> builder(*it->second);
     builder.ApplyNumerationOffset();
 
     auto reader = connector::GetReader<CrossMwmId>(mwmValue.m_cont);
     fn(builder, reader);
-    return it->second;
+    return *it->second;
   }
 
   MwmDataSource & m_dataSource;
   VehicleType m_vehicleType;
+  std::shared_ptr<ConnectorsCache> m_connectorsCache;
 
   /// \note |m_connectors| contains cache with transition segments and leap edges.
   /// Each mwm in |m_connectors| may be in two conditions:
@@ -276,7 +364,8 @@ private:
   /// * with loaded transition segments and with loaded weights
   ///   (after a call to CrossMwmConnectorSerializer::DeserializeTransitions()
   ///   and CrossMwmConnectorSerializer::DeserializeWeights())
-  using ConnectersMapT = std::map<NumMwmId, CrossMwmConnector<CrossMwmId>>;
+  /// Connectors are shared with |m_connectorsCache|.
+  using ConnectersMapT = std::map<NumMwmId, std::shared_ptr<CrossMwmConnector<CrossMwmId>>>;
   ConnectersMapT m_connectors;
 };
 }  // namespace routing
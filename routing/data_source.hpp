@@ -8,7 +8,9 @@
 #include "base/lru_cache.hpp"
 
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace routing
 {
@@ -104,6 +106,25 @@ public:
     m_dataSource.ForEachInRect(fn, rect, scales::GetUpperScale());
   }
 
+  template <class FnT> void ForEachStreet(FnT && fn, m2::RectD const & rect, MwmSet::MwmId const & mwmId)
+  {
+    m_dataSource.ForEachInRectForMWM(fn, rect, scales::GetUpperScale(), mwmId);
+  }
+
+  // Calls |fn| for the mwms which are read by ForEachStreet(fn, rect).
+  template <class FnT> void ForEachMwmWithStreets(FnT && fn, m2::RectD const & rect) const
+  {
+    std::vector<std::shared_ptr<MwmInfo>> infos;
+    m_dataSource.GetMwmsInfo(infos);
+
+    int const scale = scales::GetUpperScale();
+    for (auto const & info : infos)
+    {
+      if (info->m_minScale <= scale && scale <= info->m_maxScale && rect.IsIntersect(info->m_bordersRect))
+        fn(MwmSet::MwmId(info));
+    }
+  }
+
   MwmSet::MwmHandle const & GetHandle(MwmSet::MwmId const & mwmId)
   {
     if (m_numMwmIDs)
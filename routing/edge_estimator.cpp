@@ -67,7 +67,7 @@ double CalcClimbSegment(EdgeEstimator::Purpose purpose, Segment const & segment,
   double speedMpS = GetSpeedMpS(purpose, segment, road);
 
   static double constexpr kSmallDistanceM = 1;   // we have altitude threshold is 0.5m
-  if (distance > kSmallDistanceM && !IsTransit(road.GetHighwayType()))
+  if (road.HasAltitudeChanges() && distance > kSmallDistanceM && !IsTransit(road.GetHighwayType()))
   {
     LatLonWithAltitude const & from = road.GetJunction(segment.GetPointId(false /* front */));
     LatLonWithAltitude const & to = road.GetJunction(segment.GetPointId(true /* front */));
@@ -382,6 +382,11 @@ public:
     UNREACHABLE();
   }
 
+  uint64_t GetWeightsVersion() const override
+  {
+    return m_trafficStash ? m_trafficStash->GetVersion() : 0;
+  }
+
 private:
   shared_ptr<TrafficStash> m_trafficStash;
 };
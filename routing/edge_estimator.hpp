@@ -9,6 +9,7 @@
 #include "geometry/latlon.hpp"
 #include "geometry/point_with_altitude.hpp"
 
+#include <cstdint>
 #include <memory>
 
 class DataSource;
@@ -49,6 +50,9 @@ public:
                                    Purpose purpose) const = 0;
   virtual double GetUTurnPenalty(Purpose purpose) const = 0;
   virtual double GetFerryLandingPenalty(Purpose purpose) const = 0;
+  // Returns a number which is changed every time results of CalcSegmentWeight() may be changed,
+  // e.g. when traffic is updated. Callers may cache segment weights while it stays the same.
+  virtual uint64_t GetWeightsVersion() const { return 0; }
 
   static std::shared_ptr<EdgeEstimator> Create(VehicleType vehicleType, double maxWeighSpeedKMpH,
                                                SpeedKMpH const & offroadSpeedKMpH,
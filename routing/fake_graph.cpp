@@ -4,7 +4,6 @@
 #include "routing/latlon_with_altitude.hpp"
 
 #include "base/assert.hpp"
-#include "base/stl_helpers.hpp"
 
 #include <algorithm>
 
@@ -44,17 +43,12 @@ void FakeGraph::AddConnection(Segment const & from, Segment const & to)
 
 void FakeGraph::Append(FakeGraph const & rhs)
 {
-  std::map<Segment, FakeVertex> intersection;
-  typename std::map<Segment, FakeVertex>::iterator intersectionIt(intersection.begin());
-
-  std::set_intersection(m_segmentToVertex.begin(), m_segmentToVertex.end(),
-                        rhs.m_segmentToVertex.begin(), rhs.m_segmentToVertex.end(),
-                        std::inserter(intersection, intersectionIt),
-                        base::LessBy(&std::pair<Segment, FakeVertex>::first));
-
   size_t countEqual = 0;
-  for (auto const & segmentVertexPair : intersection)
+  for (auto const & segmentVertexPair : rhs.m_segmentToVertex)
   {
+    if (m_segmentToVertex.count(segmentVertexPair.first) == 0)
+      continue;
+
     auto const it = m_fakeToReal.find(segmentVertexPair.first);
     if (it == m_fakeToReal.cend() || !FakeFeatureIds::IsGuidesFeature(it->second.GetFeatureId()))
       countEqual++;
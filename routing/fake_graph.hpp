@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "3party/skarupke/bytell_hash_map.hpp"
+
 namespace routing
 {
 class FakeGraph
@@ -46,19 +48,24 @@ private:
   void ConnectLoopToExistentPartsOfReal(FakeVertex const & loop, Segment const & guidesSegment,
                                         Segment const & directedGuidesSegment);
 
+  // Segment keyed maps are looked up for every edge of A*, e.g. |m_realToFake| for each target
+  // of a real segment in IndexGraphStarter::AddFakeEdges(), so they are open addressing hash maps.
+  template <typename Value>
+  using SegmentMap = ska::bytell_hash_map<Segment, Value>;
+
   // Key is fake segment, value is set of outgoing fake segments.
-  std::map<Segment, std::set<Segment>> m_outgoing;
+  SegmentMap<std::set<Segment>> m_outgoing;
   // Key is fake segment, value is set of ingoing fake segments.
-  std::map<Segment, std::set<Segment>> m_ingoing;
+  SegmentMap<std::set<Segment>> m_ingoing;
   // Key is fake segment, value is fake vertex which corresponds fake segment.
-  std::map<Segment, FakeVertex> m_segmentToVertex;
+  SegmentMap<FakeVertex> m_segmentToVertex;
   // Key is fake vertex, value is fake segment which corresponds fake vertex.
   std::map<FakeVertex, Segment> m_vertexToSegment;
   // Key is fake segment of type PartOfReal, value is corresponding real segment.
-  std::map<Segment, Segment> m_fakeToReal;
+  SegmentMap<Segment> m_fakeToReal;
   // Key is real segment, value is set of fake segments with type PartOfReal
   // which are parts of this real segment.
-  std::map<Segment, std::set<Segment>> m_realToFake;
+  SegmentMap<std::set<Segment>> m_realToFake;
   // To return empty set by const reference.
   std::set<Segment> const kEmptySet = std::set<Segment>();
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Set of feature ids of one mwm as a bitset. Feature ids of an mwm are dense, so it's compact and
+// a lookup is a single bit test. It's used to skip hash map lookups of routing rules (road access,
+// restrictions) for the most of features which have no rules.
+class FeaturesBitset final
+{
+public:
+  void Insert(uint32_t featureId)
+  {
+    if (featureId >= m_bits.size())
+      m_bits.resize(static_cast<size_t>(featureId) + 1);
+    m_bits[featureId] = true;
+  }
+
+  bool Contains(uint32_t featureId) const
+  {
+    return featureId < m_bits.size() && m_bits[featureId];
+  }
+
+  void Clear() { m_bits.clear(); }
+
+private:
+  std::vector<bool> m_bits;
+};
+}  // namespace routing
@@ -8,7 +8,9 @@
 
 #include "coding/point_coding.hpp"
 
+#include <cmath>
 #include <limits>
+#include <unordered_set>
 
 namespace routing
 {
@@ -20,6 +22,17 @@ uint32_t constexpr kPowOfTwoForFeatureCacheSize = 10; // cache contains 2 ^ kPow
 
 double constexpr kMwmRoadCrossingRadiusMeters = 2.0;
 
+// Size of a cell of roads grid in mercator units. It's about 200 meters in middle latitudes.
+double constexpr kRoadsGridCellSizeMercator = 0.003;
+size_t constexpr kMaxRoadsGridCellsCount = 256;
+// Roads in bigger rects are read directly, not to fill the cache with cells which are not reused.
+size_t constexpr kMaxRoadsGridCellsInRect = 64;
+
+int32_t GetRoadsGridCellIdx(double coord)
+{
+  return static_cast<int32_t>(floor(coord / kRoadsGridCellSizeMercator));
+}
+
 auto constexpr kInvalidSpeedKMPH = numeric_limits<double>::max();
 }  // namespace
 
@@ -97,9 +110,44 @@ void FeaturesRoadGraph::RoadInfoCache::Clear()
   m_cache.clear();
 }
 
+shared_ptr<FeaturesRoadGraphBase::RoadsGrid::Roads const> FeaturesRoadGraphBase::RoadsGrid::Find(
+    CellKey const & key)
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_cells.find(key);
+  if (it == m_cells.end())
+    return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  return it->second.m_roads;
+}
+
+void FeaturesRoadGraphBase::RoadsGrid::Put(CellKey const & key, shared_ptr<Roads const> roads)
+{
+  std::lock_guard lock(m_mutex);
+  auto [it, inserted] = m_cells.emplace(key, Entry());
+  if (inserted)
+  {
+    m_lru.push_front(key);
+    it->second.m_lruIt = m_lru.begin();
+  }
+  else
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  }
+  it->second.m_roads = std::move(roads);
+
+  while (m_cells.size() > m_maxCellsCount)
+  {
+    m_cells.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
 FeaturesRoadGraphBase::FeaturesRoadGraphBase(MwmDataSource & dataSource, IRoadGraph::Mode mode,
                                              shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory)
   : m_dataSource(dataSource), m_mode(mode), m_vehicleModel(vehicleModelFactory)
+  , m_roadsGrid(kMaxRoadsGridCellsCount)
 {
 }
 
@@ -141,16 +189,10 @@ void FeaturesRoadGraphBase::FindClosestEdges(m2::RectD const & rect, uint32_t co
 {
   NearestEdgeFinder finder(rect.Center(), nullptr /* IsEdgeProjGood */);
 
-  m_dataSource.ForEachStreet([&](FeatureType & ft)
+  ForEachRoadInRect(rect, [&](FeatureID const & featureId, RoadInfo const & roadInfo)
   {
-    if (!m_vehicleModel.IsRoad(ft))
-      return;
-
-    FeatureID const & featureId = ft.GetID();
-
-    IRoadGraph::RoadInfo const & roadInfo = GetCachedRoadInfo(featureId, ft, kInvalidSpeedKMPH);
     finder.AddInformationSource(IRoadGraph::FullRoadInfo(featureId, roadInfo));
-  }, rect);
+  });
 
   finder.MakeResult(vicinities, count);
 }
@@ -160,23 +202,89 @@ FeaturesRoadGraphBase::FindRoads(m2::RectD const & rect, IsGoodFeatureFn const &
 {
   vector<IRoadGraph::FullRoadInfo> roads;
 
-  m_dataSource.ForEachStreet([&](FeatureType & ft)
+  ForEachRoadInRect(rect, [&](FeatureID const & featureId, RoadInfo const & roadInfo)
   {
-    if (!m_vehicleModel.IsRoad(ft))
-      return;
-
-    FeatureID const & featureId = ft.GetID();
     if (isGoodFeature && !isGoodFeature(featureId))
       return;
 
-    // DataSource::ForEachInRect() gives not only features inside |rect| but some other features
+    // ForEachRoadInRect() gives not only features inside |rect| but some other features
     // which lie close to the rect. Removes all the features which don't cross |rect|.
-    auto const & roadInfo = GetCachedRoadInfo(featureId, ft, kInvalidSpeedKMPH);
     if (!RectCoversPolyline(roadInfo.m_junctions, rect))
       return;
 
     roads.emplace_back(featureId, roadInfo);
+  });
+
+  return roads;
+}
+
+template <typename Fn>
+void FeaturesRoadGraphBase::ForEachRoadInRect(m2::RectD const & rect, Fn && fn) const
+{
+  int32_t const minX = GetRoadsGridCellIdx(rect.minX());
+  int32_t const minY = GetRoadsGridCellIdx(rect.minY());
+  int32_t const maxX = GetRoadsGridCellIdx(rect.maxX());
+  int32_t const maxY = GetRoadsGridCellIdx(rect.maxY());
+
+  auto const cellsCount = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+  if (cellsCount > kMaxRoadsGridCellsInRect)
+  {
+    m_dataSource.ForEachStreet([&](FeatureType & ft)
+    {
+      if (!m_vehicleModel.IsRoad(ft))
+        return;
+
+      FeatureID const & featureId = ft.GetID();
+      fn(featureId, GetCachedRoadInfo(featureId, ft, kInvalidSpeedKMPH));
+    }, rect);
+    return;
+  }
+
+  m_dataSource.ForEachMwmWithStreets([&](MwmSet::MwmId const & mwmId)
+  {
+    // A road may cross several cells.
+    unordered_set<uint32_t> featureIndices;
+    RoadsGrid::CellKey key;
+    key.m_mwmId = mwmId;
+    for (key.m_x = minX; key.m_x <= maxX; ++key.m_x)
+    {
+      for (key.m_y = minY; key.m_y <= maxY; ++key.m_y)
+      {
+        auto roads = m_roadsGrid.Find(key);
+        if (!roads)
+        {
+          roads = LoadRoadsGridCell(key);
+          m_roadsGrid.Put(key, roads);
+        }
+
+        for (auto const & road : *roads)
+        {
+          if (featureIndices.insert(road.m_featureId.m_index).second)
+            fn(road.m_featureId, road.m_roadInfo);
+        }
+      }
+    }
   }, rect);
+}
+
+shared_ptr<FeaturesRoadGraphBase::RoadsGrid::Roads const> FeaturesRoadGraphBase::LoadRoadsGridCell(
+    RoadsGrid::CellKey const & key) const
+{
+  m2::RectD const cellRect(key.m_x * kRoadsGridCellSizeMercator, key.m_y * kRoadsGridCellSizeMercator,
+                           (key.m_x + 1) * kRoadsGridCellSizeMercator,
+                           (key.m_y + 1) * kRoadsGridCellSizeMercator);
+
+  auto roads = make_shared<RoadsGrid::Roads>();
+  m_dataSource.ForEachStreet([&](FeatureType & ft)
+  {
+    if (!m_vehicleModel.IsRoad(ft))
+      return;
+
+    FeatureID const & featureId = ft.GetID();
+    auto const & roadInfo = GetCachedRoadInfo(featureId, ft, kInvalidSpeedKMPH);
+    if (RectCoversPolyline(roadInfo.m_junctions, cellRect))
+      roads->emplace_back(featureId, roadInfo);
+  }, cellRect, key.m_mwmId);
 
   return roads;
 }
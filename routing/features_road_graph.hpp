@@ -13,6 +13,8 @@
 
 #include "base/cache.hpp"
 
+#include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -74,6 +76,49 @@ private:
     std::map<MwmSet::MwmId, TMwmFeatureCache> m_cache;
   };
 
+  // LRU cache of roads by cells of a regular grid, separately for every mwm. A cell keeps all
+  // the roads which cross it, so the roads near a point are taken without reading and decoding
+  // all the features around the point. The cache is thread-safe.
+  class RoadsGrid
+  {
+  public:
+    using Roads = std::vector<FullRoadInfo>;
+
+    struct CellKey
+    {
+      bool operator<(CellKey const & rhs) const
+      {
+        if (m_mwmId != rhs.m_mwmId)
+          return m_mwmId < rhs.m_mwmId;
+        if (m_x != rhs.m_x)
+          return m_x < rhs.m_x;
+        return m_y < rhs.m_y;
+      }
+
+      MwmSet::MwmId m_mwmId;
+      int32_t m_x = 0;
+      int32_t m_y = 0;
+    };
+
+    explicit RoadsGrid(size_t maxCellsCount) : m_maxCellsCount(maxCellsCount) {}
+
+    std::shared_ptr<Roads const> Find(CellKey const & key);
+    void Put(CellKey const & key, std::shared_ptr<Roads const> roads);
+
+  private:
+    struct Entry
+    {
+      std::shared_ptr<Roads const> m_roads;
+      std::list<CellKey>::iterator m_lruIt;
+    };
+
+    size_t const m_maxCellsCount;
+
+    std::mutex m_mutex;
+    std::map<CellKey, Entry> m_cells;
+    std::list<CellKey> m_lru;
+  };
+
 public:
   static double constexpr kClosestEdgesRadiusM = 150.0;
 
@@ -122,8 +167,17 @@ private:
   RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId, FeatureType & ft, double speedKMPH) const;
   void ExtractRoadInfo(FeatureID const & featureId, FeatureType & ft, double speedKMpH, RoadInfo & ri) const;
 
+  // Calls |fn| once for every road which is read by m_dataSource.ForEachStreet(..., rect)
+  // or crosses a grid cell covering |rect|.
+  template <typename Fn>
+  void ForEachRoadInRect(m2::RectD const & rect, Fn && fn) const;
+  std::shared_ptr<RoadsGrid::Roads const> LoadRoadsGridCell(RoadsGrid::CellKey const & key) const;
+
   IRoadGraph::Mode const m_mode;
   mutable RoadInfoCache m_cache;
+  // Unlike |m_cache| it's not cleared by ClearState(), because it's used to snap points
+  // to roads between routes, e.g. when a route is followed.
+  mutable RoadsGrid m_roadsGrid;
   mutable CrossCountryVehicleModel m_vehicleModel;
 };
 
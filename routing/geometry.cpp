@@ -13,6 +13,8 @@
 #include "base/assert.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <string>
 
 namespace routing
@@ -147,6 +149,7 @@ private:
 RoadGeometry::RoadGeometry(bool oneWay, double weightSpeedKMpH, double etaSpeedKMpH, Points const & points)
   : m_forwardSpeed{weightSpeedKMpH, etaSpeedKMpH}, m_backwardSpeed(m_forwardSpeed)
   , m_isOneWay(oneWay), m_valid(true), m_isPassThroughAllowed(false), m_inCity(false)
+  , m_hasAltitudeChanges(false)
 {
   ASSERT_GREATER(weightSpeedKMpH, 0.0, ());
   ASSERT_GREATER(etaSpeedKMpH, 0.0, ());
@@ -192,6 +195,11 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
       m_routingOptions.Add(*it);
   }
 
+  // Features without altitude changes are the most of them (flat features and features without
+  // altitude data), so climb penalties are skipped for them by the estimators.
+  m_hasAltitudeChanges = altitudes && std::adjacent_find(altitudes->begin(), altitudes->end(),
+                                                         std::not_equal_to<>()) != altitudes->end();
+
   m_junctions.clear();
   m_junctions.reserve(count);
   for (size_t i = 0; i < count; ++i)
@@ -280,9 +288,20 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize)
 {
   CHECK(m_loader, ());
 
-  m_featureIdToRoad = make_unique<RoutingCacheT>(roadsCacheSize, [this](uint32_t featureId, RoadGeometry & road)
+  m_featureIdToRoad = make_unique<RoutingCacheT>(roadsCacheSize, [this](uint32_t featureId, RoadPtrT & road)
   {
-    m_loader->Load(featureId, road);
+    if (m_sharedSourceId)
+    {
+      road = RoadGeometryCache::Instance().GetRoad(*m_sharedSourceId, featureId, [&](RoadGeometry & r)
+      {
+        m_loader->Load(featureId, r);
+      });
+      return;
+    }
+
+    auto loaded = make_shared<RoadGeometry>();
+    m_loader->Load(featureId, *loaded);
+    road = std::move(loaded);
   });
 }
 
@@ -291,7 +310,7 @@ RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
   ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
-  return m_featureIdToRoad->GetValue(featureId);
+  return *m_featureIdToRoad->GetValue(featureId);
 }
 
 SpeedInUnits GeometryLoader::GetSavedMaxspeed(uint32_t featureId, bool forward)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/latlon_with_altitude.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/road_point.hpp"
 #include "routing/routing_options.hpp"
 
@@ -31,7 +32,11 @@ class RoadAttrsGetter;
 class RoadGeometry final
 {
 public:
-  RoadGeometry() : m_isOneWay(false), m_valid(false), m_isPassThroughAllowed(false), m_inCity(false) {}
+  RoadGeometry()
+    : m_isOneWay(false), m_valid(false), m_isPassThroughAllowed(false), m_inCity(false)
+    , m_hasAltitudeChanges(false)
+  {
+  }
 
   /// Used in tests.
   using Points = std::vector<m2::PointD>;
@@ -46,6 +51,8 @@ public:
   bool IsOneWay() const { return m_isOneWay; }
   bool IsPassThroughAllowed() const { return m_isPassThroughAllowed; }
   bool IsInCity() const { return m_inCity; }
+  /// @return false if all the junctions have the same altitude, so no climbs along the road.
+  bool HasAltitudeChanges() const { return m_hasAltitudeChanges; }
 
   LatLonWithAltitude const & GetJunction(uint32_t junctionId) const
   {
@@ -96,6 +103,7 @@ private:
   bool m_valid : 1;
   bool m_isPassThroughAllowed : 1;
   bool m_inCity : 1;
+  bool m_hasAltitudeChanges : 1;
 };
 
 class GeometryLoader
@@ -126,6 +134,8 @@ public:
 /// On the other hand methods GetRoad() and GetPoint() return geometry information by reference.
 /// The reference may be invalid after the next call of GetRoad() or GetPoint() because the cache
 /// item which is referred by returned reference may be evicted. It's done for performance reasons.
+/// \note If a shared cache source is set, |m_featureIdToRoad| keeps references to the roads of
+/// RoadGeometryCache, so the roads decoded by other routers are reused.
 /// \note The cache |m_featureIdToRoad| is used for road geometry for single-directional
 /// and bidirectional A*. According to tests it's faster to use one cache for both directions
 /// in bidirectional A* case than two separate caches, one for each direction (one for each A* wave).
@@ -137,6 +147,10 @@ public:
   /// \param roadsCacheSize in-memory geometry elements count limit
   Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
 
+  /// \brief Takes roads from RoadGeometryCache::Instance() which is shared with other Geometry
+  /// instances created for the same |sourceId|. Loaded roads are put there too.
+  void SetSharedCacheSource(RoadGeometryCache::SourceId sourceId) { m_sharedSourceId = sourceId; }
+
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
   RoadGeometry const & GetRoad(uint32_t featureId);
@@ -155,9 +169,11 @@ public:
 
 private:
   /// @todo Use LRU cache?
-  using RoutingCacheT = FifoCache<uint32_t, RoadGeometry, ska::bytell_hash_map<uint32_t, RoadGeometry>>;
+  using RoadPtrT = RoadGeometryCache::RoadPtr;
+  using RoutingCacheT = FifoCache<uint32_t, RoadPtrT, ska::bytell_hash_map<uint32_t, RoadPtrT>>;
 
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<RoutingCacheT> m_featureIdToRoad;
+  std::optional<RoadGeometryCache::SourceId> m_sharedSourceId;
 };
 }  // namespace routing
@@ -43,6 +43,25 @@ IndexGraph::IndexGraph(shared_ptr<Geometry> geometry, shared_ptr<EdgeEstimator>
   CHECK(m_estimator, ());
 }
 
+IndexGraph::IndexGraph(IndexGraph const & graph, shared_ptr<Geometry> geometry,
+                       shared_ptr<EdgeEstimator> estimator, RoutingOptions routingOptions)
+  : m_geometry(std::move(geometry)),
+    m_estimator(std::move(estimator)),
+    m_roadIndex(graph.m_roadIndex),
+    m_jointIndex(graph.m_jointIndex),
+    m_restrictionsForward(graph.m_restrictionsForward),
+    m_restrictionsBackward(graph.m_restrictionsBackward),
+    m_restrictedForward(graph.m_restrictedForward),
+    m_restrictedBackward(graph.m_restrictedBackward),
+    m_noUTurnRestrictions(graph.m_noUTurnRestrictions),
+    m_noUTurnFeatures(graph.m_noUTurnFeatures),
+    m_roadAccess(graph.m_roadAccess),
+    m_avoidRoutingOptions(routingOptions)
+{
+  CHECK(m_geometry, ());
+  CHECK(m_estimator, ());
+}
+
 bool IndexGraph::IsJoint(RoadPoint const & roadPoint) const
 {
   return m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
@@ -197,6 +216,7 @@ optional<JointEdge> IndexGraph::GetJointEdgeByLastPoint(Segment const & parent,
 
 void IndexGraph::Build(uint32_t numJoints)
 {
+  m_roadIndex.Build();
   m_jointIndex.Build(m_roadIndex, numJoints);
 }
 
@@ -211,6 +231,8 @@ void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   m_restrictionsForward.clear();
   m_restrictionsBackward.clear();
+  m_restrictedForward.Clear();
+  m_restrictedBackward.Clear();
 
   base::HighResTimer timer;
   for (auto const & restriction : restrictions)
@@ -222,6 +244,9 @@ void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
     reverse(forward.back().begin(), forward.back().end());
 
     m_restrictionsBackward[restriction.front()].emplace_back(next(restriction.begin()), restriction.end());
+
+    m_restrictedForward.Insert(restriction.back());
+    m_restrictedBackward.Insert(restriction.front());
   }
 
   LOG(LDEBUG, ("Restrictions are loaded in:", timer.ElapsedMilliseconds(), "ms"));
@@ -235,6 +260,8 @@ void IndexGraph::SetUTurnRestrictions(vector<RestrictionUTurn> && noUTurnRestric
       m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheBegin = true;
     else
       m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheEnd = true;
+
+    m_noUTurnFeatures.Insert(noUTurn.m_featureId);
   }
 }
 
@@ -450,6 +477,27 @@ IndexGraph::PenaltyData IndexGraph::GetRoadPenaltyData(Segment const & segment)
   return { road.IsPassThroughAllowed(), road.GetRoutingOptions().Has(RoutingOptions::Road::Ferry) };
 }
 
+double IndexGraph::GetSegmentWeight(EdgeEstimator::Purpose purpose, Segment const & segment) const
+{
+  auto const version = m_estimator->GetWeightsVersion();
+  if (version != m_segmentWeightsVersion)
+  {
+    for (auto & weights : m_segmentWeights)
+      weights.clear();
+    m_segmentWeightsVersion = version;
+  }
+
+  auto & weights = m_segmentWeights[static_cast<size_t>(purpose)];
+  auto const it = weights.find(segment);
+  if (it != weights.cend())
+    return it->second;
+
+  auto const weight =
+      m_estimator->CalcSegmentWeight(segment, GetRoadGeometry(segment.GetFeatureId()), purpose);
+  weights.emplace(segment, weight);
+  return weight;
+}
+
 RouteWeight IndexGraph::GetPenalties(EdgeEstimator::Purpose purpose, Segment const & u,
                                      Segment const & v, optional<RouteWeight> const & prevWeight) const
 {
@@ -536,6 +584,9 @@ bool IndexGraph::IsUTurnAndRestricted(Segment const & parent, Segment const & ch
   if (m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
     return true;
 
+  if (!m_noUTurnFeatures.Contains(featureId))
+    return false;
+
   auto const it = m_noUTurnRestrictions.find(featureId);
   if (it == m_noUTurnRestrictions.cend())
     return false;
@@ -553,10 +604,7 @@ RouteWeight IndexGraph::CalculateEdgeWeight(EdgeEstimator::Purpose purpose, bool
                                             Segment const & from, Segment const & to,
                                             std::optional<RouteWeight const> const & prevWeight) const
 {
-  auto const & segment = isOutgoing ? to : from;
-  auto const & road = GetRoadGeometry(segment.GetFeatureId());
-
-  auto const weight = RouteWeight(m_estimator->CalcSegmentWeight(segment, road, purpose));
+  auto const weight = RouteWeight(GetSegmentWeight(purpose, isOutgoing ? to : from));
   auto const penalties = GetPenalties(purpose, isOutgoing ? from : to, isOutgoing ? to : from, prevWeight);
 
   return weight + penalties;
@@ -4,6 +4,7 @@
 #include "routing/base/astar_vertex_data.hpp"
 
 #include "routing/edge_estimator.hpp"
+#include "routing/features_bitset.hpp"
 #include "routing/geometry.hpp"
 #include "routing/joint.hpp"
 #include "routing/joint_index.hpp"
@@ -17,6 +18,10 @@
 
 #include "geometry/point2d.hpp"
 
+#include "3party/skarupke/bytell_hash_map.hpp"
+
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -50,6 +55,10 @@ public:
   IndexGraph() = default;
   IndexGraph(std::shared_ptr<Geometry> geometry, std::shared_ptr<EdgeEstimator> estimator,
              RoutingOptions routingOptions = RoutingOptions());
+  /// Copies roads, joints, restrictions and road access of |graph|, which are read from
+  /// the routing section, and binds them to |geometry| and |estimator|.
+  IndexGraph(IndexGraph const & graph, std::shared_ptr<Geometry> geometry,
+             std::shared_ptr<EdgeEstimator> estimator, RoutingOptions routingOptions);
 
   // Put outgoing (or ingoing) egdes for segment to the 'edges' vector.
   void GetEdgeList(astar::VertexData<Segment, RouteWeight> const & vertexData, bool isOutgoing,
@@ -73,7 +82,7 @@ public:
   Joint::Id GetJointId(RoadPoint const & rp) const { return m_roadIndex.GetJointId(rp); }
 
   bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
-  RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
+  RoadJointIds GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
   RoadGeometry const & GetRoadGeometry(uint32_t featureId) const { return m_geometry->GetRoad(featureId); }
 
   Geometry & GetGeometry() const { return *m_geometry; }
@@ -174,6 +183,11 @@ private:
 
   PenaltyData GetRoadPenaltyData(Segment const & segment) const;
 
+  // Returns m_estimator->CalcSegmentWeight() for |segment|. Weights are memoized since the same
+  // segments are relaxed many times while a route is built (bidirectional waves, AdjustRoute,
+  // ETA calculation).
+  double GetSegmentWeight(EdgeEstimator::Purpose purpose, Segment const & segment) const;
+
   /// \brief Calculates penalties for moving from |u| to |v|.
   /// \param |prevWeight| uses for fetching access:conditional. In fact it is time when user
   /// will be at |u|. This time is based on start time of route building and weight of calculated
@@ -204,6 +218,9 @@ private:
 
   Restrictions m_restrictionsForward;
   Restrictions m_restrictionsBackward;
+  // Keys of the maps above, so features without restrictions are skipped by a bit test.
+  FeaturesBitset m_restrictedForward;
+  FeaturesBitset m_restrictedBackward;
 
   // u_turn can be in both sides of feature.
   struct UTurnEnding
@@ -217,10 +234,16 @@ private:
   // If m_noUTurnRestrictions.count(featureId) == 0, that means, that there are no any
   // no_u_turn restriction at the feature with id = featureId.
   std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
+  FeaturesBitset m_noUTurnFeatures;
 
   RoadAccess m_roadAccess;
   RoutingOptions m_avoidRoutingOptions;
 
+  // Memoized estimator weights of segments, one map per EdgeEstimator::Purpose. The maps are valid
+  // while m_estimator->GetWeightsVersion() is equal to |m_segmentWeightsVersion|.
+  mutable std::array<ska::bytell_hash_map<Segment, double>, 2> m_segmentWeights;
+  mutable uint64_t m_segmentWeightsVersion = 0;
+
   std::function<time_t()> m_currentTimeGetter = []() {
     return GetCurrentTimestamp();
   };
@@ -246,6 +269,10 @@ bool IndexGraph::IsRestricted(ParentVertex const & parent,
   if (parentFeatureId == currentFeatureId)
     return false;
 
+  auto const & restricted = isOutgoing ? m_restrictedForward : m_restrictedBackward;
+  if (!restricted.Contains(currentFeatureId))
+    return false;
+
   auto const & restrictions = isOutgoing ? m_restrictionsForward : m_restrictionsBackward;
   auto const it = restrictions.find(currentFeatureId);
   if (it == restrictions.cend())
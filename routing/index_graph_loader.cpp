@@ -3,6 +3,7 @@
 #include "routing/data_source.hpp"
 #include "routing/index_graph_serialization.hpp"
 #include "routing/restriction_loader.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_access_serialization.hpp"
 #include "routing/route.hpp"
@@ -30,13 +31,14 @@ public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                        shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                       RoutingOptions routingOptions = RoutingOptions())
+                       RoutingOptions routingOptions, shared_ptr<IndexGraphsCache> graphsCache)
     : m_vehicleType(vehicleType)
     , m_loadAltitudes(loadAltitudes)
     , m_dataSource(dataSource)
     , m_vehicleModelFactory(std::move(vehicleModelFactory))
     , m_estimator(std::move(estimator))
     , m_avoidRoutingOptions(routingOptions)
+    , m_graphsCache(std::move(graphsCache))
   {
     CHECK(m_vehicleModelFactory, ());
     CHECK(m_estimator, ());
@@ -47,6 +49,7 @@ public:
   Geometry & GetGeometry(NumMwmId numMwmId) override;
   vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) override;
   void Clear() override;
+  double GetLoadingTimeMs() const override { return m_loadingTimeMs; }
 
 private:
   using GeometryPtrT = shared_ptr<Geometry>;
@@ -72,6 +75,9 @@ private:
   SpeedCamerasMapT const & ReceiveSpeedCamsFromMwm(NumMwmId numMwmId);
 
   RoutingOptions m_avoidRoutingOptions;
+  // May be nullptr.
+  shared_ptr<IndexGraphsCache> m_graphsCache;
+  double m_loadingTimeMs = 0.0;
   std::function<time_t()> m_currentTimeGetter = [time = GetCurrentTimestamp()]() {
     return time;
   };
@@ -82,8 +88,10 @@ IndexGraph & IndexGraphLoaderImpl::GetIndexGraph(NumMwmId numMwmId)
   auto res = m_graphs.try_emplace(numMwmId, GraphAttrs());
   if (res.second || res.first->second.m_graph == nullptr)
   {
+    base::HighResTimer timer;
     // Create graph using (or initializing) existing geometry.
     res.first->second.m_graph = CreateIndexGraph(numMwmId, res.first->second.m_geometry);
+    m_loadingTimeMs += timer.ElapsedNanoseconds() / 1e6;
   }
   return *(res.first->second.m_graph);
 }
@@ -93,8 +101,10 @@ Geometry & IndexGraphLoaderImpl::GetGeometry(NumMwmId numMwmId)
   auto res = m_graphs.try_emplace(numMwmId, GraphAttrs());
   if (res.second)
   {
+    base::HighResTimer timer;
     // Create geometry only, graph stays nullptr.
     res.first->second.m_geometry = CreateGeometry(numMwmId);
+    m_loadingTimeMs += timer.ElapsedNanoseconds() / 1e6;
   }
   return *(res.first->second.m_geometry);
 }
@@ -134,9 +144,17 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
   MwmValue const * value = handle.GetValue();
 
   if (!geometry)
+    geometry = CreateGeometry(numMwmId);
+
+  int64_t const mwmVersion = handle.GetInfo()->GetVersion();
+  if (m_graphsCache)
   {
-    auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-    geometry = make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+    if (auto const cached = m_graphsCache->Get(numMwmId, mwmVersion))
+    {
+      auto graph = make_unique<IndexGraph>(*cached, geometry, m_estimator, m_avoidRoutingOptions);
+      graph->SetCurrentTimeGetter(m_currentTimeGetter);
+      return graph;
+    }
   }
 
   auto graph = make_unique<IndexGraph>(geometry, m_estimator, m_avoidRoutingOptions);
@@ -146,6 +164,14 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
   DeserializeIndexGraph(*value, m_vehicleType, *graph);
   LOG(LINFO, (ROUTING_FILE_TAG, "section for", value->GetCountryFileName(), "loaded in", timer.ElapsedSeconds(), "seconds"));
 
+  if (m_graphsCache)
+  {
+    // The cached copy gets an empty geometry, so it doesn't keep the mwm handle.
+    m_graphsCache->Put(numMwmId, mwmVersion,
+                       make_shared<IndexGraph>(*graph, make_shared<Geometry>(), m_estimator,
+                                               RoutingOptions()));
+  }
+
   return graph;
 }
 
@@ -155,7 +181,16 @@ IndexGraphLoaderImpl::GeometryPtrT IndexGraphLoaderImpl::CreateGeometry(NumMwmId
   MwmValue const * value = handle.GetValue();
 
   auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-  return make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+  auto geometry = make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+
+  auto & sharedCache = RoadGeometryCache::Instance();
+  if (sharedCache.IsEnabled())
+  {
+    geometry->SetSharedCacheSource(sharedCache.GetSourceId(value->GetCountryFileName(),
+                                                           handle.GetInfo()->GetVersion(),
+                                                           m_vehicleType, m_loadAltitudes));
+  }
+  return geometry;
 }
 
 void IndexGraphLoaderImpl::Clear() { m_graphs.clear(); }
@@ -207,10 +242,67 @@ unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
     shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-    RoutingOptions routingOptions)
+    RoutingOptions routingOptions, shared_ptr<IndexGraphsCache> graphsCache)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, vehicleModelFactory,
-                                           estimator, dataSource, routingOptions);
+                                           estimator, dataSource, routingOptions,
+                                           std::move(graphsCache));
+}
+
+// IndexGraphsCache --------------------------------------------------------------------------------
+IndexGraphsCache::IndexGraphsCache(size_t maxGraphsCount) : m_maxGraphsCount(maxGraphsCount)
+{
+  CHECK_GREATER(m_maxGraphsCount, 0, ());
+}
+
+IndexGraphsCache::GraphPtr IndexGraphsCache::Get(NumMwmId numMwmId, int64_t mwmVersion)
+{
+  lock_guard guard(m_mutex);
+  auto const it = m_graphs.find(numMwmId);
+  if (it == m_graphs.end() || it->second.m_mwmVersion != mwmVersion)
+    return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  return it->second.m_graph;
+}
+
+void IndexGraphsCache::Put(NumMwmId numMwmId, int64_t mwmVersion, GraphPtr graph)
+{
+  CHECK(graph, ());
+
+  lock_guard guard(m_mutex);
+  auto const [it, inserted] = m_graphs.emplace(numMwmId, Entry());
+  if (inserted)
+  {
+    m_lru.push_front(numMwmId);
+    it->second.m_lruIt = m_lru.begin();
+  }
+  else
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  }
+  it->second.m_graph = std::move(graph);
+  it->second.m_mwmVersion = mwmVersion;
+
+  while (m_graphs.size() > m_maxGraphsCount)
+  {
+    m_graphs.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+bool IndexGraphsCache::Contains(NumMwmId numMwmId, int64_t mwmVersion) const
+{
+  lock_guard guard(m_mutex);
+  auto const it = m_graphs.find(numMwmId);
+  return it != m_graphs.end() && it->second.m_mwmVersion == mwmVersion;
+}
+
+void IndexGraphsCache::Clear()
+{
+  lock_guard guard(m_mutex);
+  m_graphs.clear();
+  m_lru.clear();
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
@@ -9,7 +9,11 @@
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
+#include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class MwmValue;
@@ -18,6 +22,42 @@ namespace routing
 {
 class MwmDataSource;
 
+/// \brief LRU cache of index graphs read from routing sections. It's kept by a router between
+/// routes, so the first route through an mwm doesn't deserialize its routing section again
+/// if the graph was loaded by a previous route or by warm-up.
+/// \note Cached graphs keep no mwm handles and readers, so the cache isn't cleared with them.
+/// A graph is bound to the geometry and estimator of a route by a copy.
+class IndexGraphsCache final
+{
+public:
+  using GraphPtr = std::shared_ptr<IndexGraph const>;
+
+  explicit IndexGraphsCache(size_t maxGraphsCount);
+
+  /// \returns nullptr if there is no graph of |numMwmId| with |mwmVersion| in the cache.
+  GraphPtr Get(NumMwmId numMwmId, int64_t mwmVersion);
+  void Put(NumMwmId numMwmId, int64_t mwmVersion, GraphPtr graph);
+  bool Contains(NumMwmId numMwmId, int64_t mwmVersion) const;
+  void Clear();
+
+  size_t GetMaxGraphsCount() const { return m_maxGraphsCount; }
+
+private:
+  struct Entry
+  {
+    GraphPtr m_graph;
+    int64_t m_mwmVersion = 0;
+    std::list<NumMwmId>::iterator m_lruIt;
+  };
+
+  size_t const m_maxGraphsCount;
+
+  mutable std::mutex m_mutex;
+  std::map<NumMwmId, Entry> m_graphs;
+  // Most recently used mwms are at the front.
+  std::list<NumMwmId> m_lru;
+};
+
 class IndexGraphLoader
 {
 public:
@@ -30,11 +70,15 @@ public:
   virtual std::vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) = 0;
   virtual void Clear() = 0;
 
+  /// \returns time spent on loading of index graphs and geometry in milliseconds.
+  virtual double GetLoadingTimeMs() const { return 0.0; }
+
   static std::unique_ptr<IndexGraphLoader> Create(
       VehicleType vehicleType, bool loadAltitudes,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
       std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-      RoutingOptions routingOptions = RoutingOptions());
+      RoutingOptions routingOptions = RoutingOptions(),
+      std::shared_ptr<IndexGraphsCache> graphsCache = nullptr);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
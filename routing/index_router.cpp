@@ -44,6 +44,8 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
+#include "base/trace.hpp"
 
 #include "defines.hpp"
 
@@ -72,6 +74,21 @@ double constexpr kAdjustRangeM = 5000.0;
 double constexpr kMinDistanceToFinishM = 10000;
 // Near MWMs criteria when choosing routing mode.
 double constexpr kCloseMwmPointsDistanceM = 300000;
+// Number of cross-mwm connectors which are kept between routes.
+size_t constexpr kMaxCachedCrossMwmConnectorsCount = 100;
+// Number of index graphs which are kept between routes. A graph of a big mwm takes tens of Mb.
+size_t constexpr kMaxCachedIndexGraphsCount = 4;
+// Mwms which are closer to the user than the distance are warmed up.
+double constexpr kWarmUpRadiusM = 20000;
+// Limits of the tree of ways to the previous route which is used to adjust the route.
+double constexpr kMaxRemainingTreeDetourSec = 3 * 60;
+size_t constexpr kMaxRemainingTreeSize = 100000;
+// Turns of routes longer than kMinEarlyRouteDistanceM are generated for the first
+// kEarlyRouteAnnotationDistanceM at first and the route is passed to RouterDelegate::OnEarlyRoute().
+double constexpr kMinEarlyRouteDistanceM = 100000;
+double constexpr kEarlyRouteAnnotationDistanceM = 20000;
+
+double ElapsedMs(base::HighResTimer const & timer) { return timer.ElapsedNanoseconds() / 1e6; }
 
 double CalcMaxSpeed(NumMwmIds const & numMwmIds,
                     VehicleModelFactoryInterface const & vehicleModelFactory,
@@ -263,6 +280,9 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
         m_vehicleType, CalcMaxSpeed(*m_numMwmIds, *m_vehicleModelFactory, m_vehicleType),
         CalcOffroadSpeed(*m_vehicleModelFactory), m_trafficStash,
         &dataSource, m_numMwmIds))
+  , m_crossMwmConnectorsCache(
+        make_shared<CrossMwmGraph::ConnectorsCache>(kMaxCachedCrossMwmConnectorsCount))
+  , m_indexGraphsCache(make_shared<IndexGraphsCache>(kMaxCachedIndexGraphsCount))
   , m_directionsEngine(CreateDirectionsEngine(m_vehicleType, m_numMwmIds, m_dataSource))
   , m_countryParentNameGetterFn(countryParentNameGetterFn)
 {
@@ -284,6 +304,8 @@ void IndexRouter::ClearState()
 {
   m_roadGraph.ClearState();
   m_directionsEngine->Clear();
+  // Cached connectors keep readers which belong to the handles.
+  m_crossMwmConnectorsCache->Clear();
   m_dataSource.FreeHandles();
 }
 
@@ -326,6 +348,58 @@ bool IndexRouter::FindClosestProjectionToRoad(m2::PointD const & point,
   return true;
 }
 
+void IndexRouter::WarmUp(m2::PointD const & point)
+{
+  base::Timer timer;
+  SCOPE_GUARD(clearStateGuard, [this]() { ClearState(); });
+
+  std::vector<NumMwmId> mwmIds;
+  auto const addMwm = [&](NumMwmId numMwmId)
+  {
+    if (mwmIds.size() < m_indexGraphsCache->GetMaxGraphsCount() &&
+        m_dataSource.IsLoaded(m_numMwmIds->GetFile(numMwmId)) &&
+        !base::IsExist(mwmIds, numMwmId))
+    {
+      mwmIds.push_back(numMwmId);
+    }
+  };
+
+  platform::CountryFile const pointFile(m_countryFileFn(point));
+  if (m_numMwmIds->ContainsFile(pointFile))
+    addMwm(m_numMwmIds->GetId(pointFile));
+
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(point, kWarmUpRadiusM);
+  m_numMwmTree->ForEachInRect(rect, addMwm);
+
+  auto const vehicleType =
+      m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType;
+  auto loader = IndexGraphLoader::Create(vehicleType, m_loadAltitudes, m_vehicleModelFactory,
+                                         m_estimator, m_dataSource, RoutingOptions(),
+                                         m_indexGraphsCache);
+  size_t loadedCount = 0;
+  for (auto const numMwmId : mwmIds)
+  {
+    if (m_dataSource.GetSectionStatus(numMwmId, ROUTING_FILE_TAG) != MwmDataSource::SectionExists)
+      continue;
+
+    auto const mwmVersion = m_dataSource.GetHandle(numMwmId).GetInfo()->GetVersion();
+    if (m_indexGraphsCache->Contains(numMwmId, mwmVersion))
+      continue;
+
+    try
+    {
+      loader->GetIndexGraph(numMwmId);
+      ++loadedCount;
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't warm up", m_numMwmIds->GetFile(numMwmId), e.Msg()));
+    }
+  }
+
+  LOG(LINFO, ("Warmed up", loadedCount, "index graphs in", timer.ElapsedSeconds(), "seconds"));
+}
+
 void IndexRouter::SetGuides(GuidesTracks && guides) { m_guides = GuidesConnections(guides); }
 
 RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
@@ -333,9 +407,15 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
                                              bool adjustToPrevRoute,
                                              RouterDelegate const & delegate, Route & route)
 {
+  TRACE_SCOPE(Routing, "IndexRouter::CalculateRoute");
+
   auto const & startPoint = checkpoints.GetStart();
   auto const & finalPoint = checkpoints.GetFinish();
 
+  m_stats = {};
+  base::HighResTimer timer;
+  SCOPE_GUARD(statsGuard, [&]() { m_stats.m_totalMs = ElapsedMs(timer); });
+
   try
   {
     SCOPE_GUARD(featureRoadGraphClear, [this]
@@ -369,6 +449,32 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
   }
 }
 
+RouterResultCode IndexRouter::CalculateRouteWithAlternatives(Checkpoints const & checkpoints,
+                                                             m2::PointD const & startDirection,
+                                                             RouterDelegate const & delegate,
+                                                             size_t maxAlternatives, Route & route,
+                                                             vector<Route> & alternatives)
+{
+  alternatives.clear();
+
+  // Alternatives of a route with intermediate points are not looked for.
+  if (checkpoints.GetNumSubroutes() == checkpoints.GetPassedIdx() + 1)
+    m_maxAlternatives = maxAlternatives;
+
+  SCOPE_GUARD(alternativesGuard, [this]()
+  {
+    m_maxAlternatives = 0;
+    m_alternativeSubroutes.clear();
+    m_alternativeRoutes.clear();
+  });
+
+  auto const code = CalculateRoute(checkpoints, startDirection, false /* adjustToPrevRoute */,
+                                   delegate, route);
+  if (code == RouterResultCode::NoError)
+    alternatives = std::move(m_alternativeRoutes);
+  return code;
+}
+
 std::vector<Segment> IndexRouter::GetBestOutgoingSegments(m2::PointD const & checkpoint, WorldGraph & graph)
 {
   bool dummy = false;
@@ -515,6 +621,7 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                RouterDelegate const & delegate, Route & route)
 {
   m_lastRoute.reset();
+  m_lastRouteTree.reset();
   // MwmId used for guides segments in RedressRoute().
   NumMwmId guidesMwmId = kFakeNumMwmId;
 
@@ -548,6 +655,7 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   TrafficStash::Guard guard(m_trafficStash);
   unique_ptr<WorldGraph> graph = MakeWorldGraph();
+  SCOPE_GUARD(graphStatsGuard, [&]() { m_stats.m_graphLoadingMs += graph->GetGraphsLoadingTimeMs(); });
 
   vector<Segment> segments;
 
@@ -583,8 +691,11 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
       bool const isLastSubroute = (i == subroutesCount - 1);
 
       bool startIsCodirectional = false;
-      switch (snapping.Snap(startCheckpoint, finishCheckpoint, startDirection,
-                            startFakeEnding, finishFakeEnding, startIsCodirectional))
+      base::HighResTimer snappingTimer;
+      int const snapResult = snapping.Snap(startCheckpoint, finishCheckpoint, startDirection,
+                                           startFakeEnding, finishFakeEnding, startIsCodirectional);
+      m_stats.m_snappingMs += ElapsedMs(snappingTimer);
+      switch (snapResult)
       {
       case 1: return RouterResultCode::StartPointNotFound;
       case 2: return isLastSubroute ? RouterResultCode::EndPointNotFound : RouterResultCode::IntermediatePointNotFound;
@@ -646,6 +757,12 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
       starter->Append(FakeEdgesContainer(std::move(subrouteStarter)));
   }
 
+  // Alternatives are found for the last subroute only, so it's the only one which is not passed.
+  Route const emptyRoute = route;
+  vector<Route::SubrouteAttrs> alternativeSubroutes;
+  if (!m_alternativeSubroutes.empty())
+    PushPassedSubroutes(checkpoints, alternativeSubroutes);
+
   route.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
   route.SetSubroteAttrs(std::move(subroutes));
 
@@ -653,10 +770,38 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   // TODO (@gmoryes) https://jira.mail.ru/browse/MAPSME-10694
   //  We should do RedressRoute for each subroute separately.
-  auto redressResult = RedressRoute(segments, delegate.GetCancellable(), *starter, route);
+  auto redressResult = RedressRoute(segments, delegate, *starter, route);
   if (redressResult != RouterResultCode::NoError)
     return redressResult;
 
+  for (auto const & alternativeSegments : m_alternativeSubroutes)
+  {
+    IndexGraphStarter::CheckValidRoute(alternativeSegments);
+
+    auto attrs = alternativeSubroutes;
+    attrs.emplace_back(starter->GetStartJunction().ToPointWithAltitude(),
+                       starter->GetFinishJunction().ToPointWithAltitude(), 0 /* beginSegmentIdx */,
+                       alternativeSegments.size());
+
+    Route alternative = emptyRoute;
+    alternative.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
+    alternative.SetSubroteAttrs(std::move(attrs));
+    auto const code = RedressRoute(alternativeSegments, delegate, *starter, alternative,
+                                   false /* makeEarlyRoute */);
+    if (code == RouterResultCode::Cancelled)
+      return code;
+
+    if (code != RouterResultCode::NoError)
+    {
+      LOG(LWARNING, ("Can't redress alternative route, code:", code));
+      continue;
+    }
+
+    LOG(LINFO, ("Alternative route length:", alternative.GetTotalDistanceMeters(), "meters. ETA:",
+                alternative.GetTotalTimeSec(), "seconds."));
+    m_alternativeRoutes.push_back(std::move(alternative));
+  }
+
   LOG(LINFO, ("Route length:", route.GetTotalDistanceMeters(), "meters. ETA:",
       route.GetTotalTimeSec(), "seconds."));
 
@@ -670,6 +815,216 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   return RouterResultCode::NoError;
 }
 
+RouterResultCode IndexRouter::CalculateMatrix(vector<m2::PointD> const & sources,
+                                              vector<m2::PointD> const & targets,
+                                              RouterDelegate const & delegate, Matrix & matrix)
+{
+  matrix.assign(sources.size(), vector<MatrixItem>(targets.size()));
+  if (sources.empty() || targets.empty())
+    return RouterResultCode::NoError;
+
+  for (auto const * points : {&sources, &targets})
+  {
+    for (auto const & point : *points)
+    {
+      auto const country = platform::CountryFile(m_countryFileFn(point));
+      if (country.IsEmpty())
+      {
+        LOG(LWARNING, ("For point", mercator::ToLatLon(point),
+                       "CountryInfoGetter returns an empty CountryFile()."));
+        return RouterResultCode::InternalError;
+      }
+
+      if (!m_dataSource.IsLoaded(country))
+        return RouterResultCode::NeedMoreMaps;
+    }
+  }
+
+  TrafficStash::Guard guard(m_trafficStash);
+  unique_ptr<WorldGraph> graph = MakeWorldGraph();
+  graph->SetMode(WorldGraphMode::NoLeaps);
+
+  // Every point is snapped to roads once. An ending without projections means that
+  // the point can't be snapped.
+  PointsOnEdgesSnapping snapping(*this, *graph);
+  auto const makeEnding = [&](m2::PointD const & point, bool isOutgoing)
+  {
+    vector<Segment> segments;
+    bool dummy;
+    if (!snapping.FindBestSegments(point, {} /* direction */, isOutgoing, segments, dummy))
+      return FakeEnding();
+    return MakeFakeEnding(segments, point, *graph);
+  };
+
+  vector<FakeEnding> targetEndings;
+  targetEndings.reserve(targets.size());
+  for (auto const & target : targets)
+    targetEndings.push_back(makeEnding(target, false /* isOutgoing */));
+
+  using Algorithm = AStarAlgorithm<IndexGraphStarter::Vertex, IndexGraphStarter::Edge,
+                                   IndexGraphStarter::Weight>;
+  Algorithm algorithm;
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    auto & row = matrix[i];
+    FakeEnding const sourceEnding = makeEnding(sources[i], true /* isOutgoing */);
+    if (sourceEnding.m_projections.empty())
+    {
+      for (auto & item : row)
+        item.m_code = RouterResultCode::StartPointNotFound;
+      continue;
+    }
+
+    // Fake edges of all the targets are gathered in one starter, so a single wave from
+    // the source reaches every target.
+    unique_ptr<IndexGraphStarter> starter;
+    map<Segment, size_t> finishToTarget;
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      if (targetEndings[j].m_projections.empty())
+      {
+        row[j].m_code = RouterResultCode::EndPointNotFound;
+        continue;
+      }
+
+      uint32_t const fakeNumerationStart = starter ? starter->GetNumFakeSegments() : 0;
+      IndexGraphStarter targetStarter(sourceEnding, targetEndings[j], fakeNumerationStart,
+                                      false /* strictForward */, *graph);
+      finishToTarget.emplace(targetStarter.GetFinishSegment(), j);
+
+      if (!starter)
+        starter = make_unique<IndexGraphStarter>(std::move(targetStarter));
+      else
+        starter->Append(FakeEdgesContainer(std::move(targetStarter)));
+    }
+
+    if (!starter)
+      continue;
+
+    size_t targetsLeft = finishToTarget.size();
+    uint32_t visitCount = 0;
+    bool cancelled = false;
+    auto const visitVertex = [&](Segment const & segment)
+    {
+      if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+      {
+        cancelled = true;
+        return false;
+      }
+
+      if (finishToTarget.count(segment) != 0)
+        --targetsLeft;
+      return targetsLeft != 0;
+    };
+
+    Algorithm::Context context(*starter);
+    algorithm.PropagateWave(*starter, starter->GetStartSegment(), visitVertex, context);
+    if (cancelled)
+      return RouterResultCode::Cancelled;
+
+    vector<Segment> path;
+    for (auto const & [finish, j] : finishToTarget)
+    {
+      if (!context.HasDistance(finish))
+        continue;
+
+      context.ReconstructPath(finish, path);
+      double distanceMeters = 0.0;
+      for (auto const & segment : path)
+      {
+        distanceMeters += ms::DistanceOnEarth(starter->GetPoint(segment, false /* front */),
+                                              starter->GetPoint(segment, true /* front */));
+      }
+
+      row[j].m_code = RouterResultCode::NoError;
+      row[j].m_timeSec = context.GetDistance(finish).GetWeight();
+      row[j].m_distanceMeters = distanceMeters;
+    }
+  }
+
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateIsochrone(m2::PointD const & start, double maxTimeSec,
+                                                 RouterDelegate const & delegate,
+                                                 Isochrone & isochrone)
+{
+  isochrone = {};
+
+  auto const country = platform::CountryFile(m_countryFileFn(start));
+  if (country.IsEmpty())
+  {
+    LOG(LWARNING, ("For point", mercator::ToLatLon(start),
+                   "CountryInfoGetter returns an empty CountryFile()."));
+    return RouterResultCode::InternalError;
+  }
+
+  if (!m_dataSource.IsLoaded(country))
+    return RouterResultCode::NeedMoreMaps;
+
+  TrafficStash::Guard guard(m_trafficStash);
+  unique_ptr<WorldGraph> graph = MakeWorldGraph();
+  graph->SetMode(WorldGraphMode::NoLeaps);
+
+  PointsOnEdgesSnapping snapping(*this, *graph);
+  vector<Segment> startSegments;
+  bool dummy;
+  if (!snapping.FindBestSegments(start, {} /* direction */, true /* isOutgoing */, startSegments,
+                                 dummy))
+  {
+    return RouterResultCode::StartPointNotFound;
+  }
+
+  // There is no finish, so the start ending is used as a finish one as well.
+  FakeEnding const startEnding = MakeFakeEnding(startSegments, start, *graph);
+  IndexGraphStarter starter(startEnding, startEnding, 0 /* fakeNumerationStart */,
+                            false /* strictForward */, *graph);
+
+  using Algorithm = AStarAlgorithm<IndexGraphStarter::Vertex, IndexGraphStarter::Edge,
+                                   IndexGraphStarter::Weight>;
+
+  vector<m2::PointD> reachedPoints;
+  uint32_t visitCount = 0;
+  bool cancelled = false;
+  auto const visitVertex = [&](Segment const & segment)
+  {
+    if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    Segment real = segment;
+    if (starter.ConvertToReal(real))
+      isochrone.m_segments.push_back(real);
+    reachedPoints.push_back(mercator::FromLatLon(starter.GetPoint(segment, true /* front */)));
+    return true;
+  };
+  auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge)
+  {
+    return edge.GetWeight();
+  };
+  auto const filterStates = [maxTimeSec](auto const & state)
+  {
+    return state.distance.GetWeight() <= maxTimeSec;
+  };
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  Algorithm algorithm;
+  Algorithm::Context context(starter);
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, adjustEdgeWeight,
+                          filterStates, reducedToRealLength, context);
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  base::SortUnique(isochrone.m_segments);
+
+  size_t constexpr kHullSectorsCount = 180;
+  isochrone.m_polygon = MakeStarShapedHull(start, reachedPoints, kHullSectorsCount);
+  return RouterResultCode::NoError;
+}
+
 vector<Segment> ProcessJoints(vector<JointSegment> const & jointsPath,
                               IndexGraphStarterJoints<IndexGraphStarter> & jointStarter)
 {
@@ -746,13 +1101,17 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(
       AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
-  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  vector<RoutingResult<Vertex, Weight>> alternatives;
+  RouterResultCode const result =
+      FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult, &alternatives);
 
   if (result != RouterResultCode::NoError)
     return result;
 
   LOG(LDEBUG, ("Result route weight:", routingResult.m_distance));
   subroute = ProcessJoints(routingResult.m_path, jointStarter);
+  for (auto const & alternative : alternatives)
+    m_alternativeSubroutes.push_back(ProcessJoints(alternative.m_path, jointStarter));
   return result;
 }
 
@@ -772,14 +1131,18 @@ RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(
       delegate.GetCancellable(), std::move(visitor), AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
+  vector<RoutingResult<Vertex, Weight>> alternatives;
   set<NumMwmId> const mwmIds = starter.GetMwms();
-  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult);
+  RouterResultCode const result =
+      FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult, &alternatives);
 
   if (result != RouterResultCode::NoError)
     return result;
 
   LOG(LDEBUG, ("Result route weight:", routingResult.m_distance));
   subroute = std::move(routingResult.m_path);
+  for (auto & alternative : alternatives)
+    m_alternativeSubroutes.push_back(std::move(alternative.m_path));
   return result;
 }
 
@@ -814,6 +1177,9 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
   std::vector<RouteWeight> candidateMidWeights;
 
   {
+    base::HighResTimer leapsTimer;
+    SCOPE_GUARD(leapsStatsGuard, [&]() { m_stats.m_leapsMs += ElapsedMs(leapsTimer); });
+
     LeapsGraph leapsGraph(starter, MwmHierarchyHandler(m_numMwmIds, m_countryParentNameGetterFn));
 
     AStarSubProgress leapsProgress(mercator::ToLatLon(checkpoints.GetPoint(subrouteIdx)),
@@ -879,6 +1245,7 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
       // Stop if have some routes and reached timeout.
       return (!routes.empty() && timer.ElapsedMilliseconds() > kTimeoutMilliS);
     });
+    m_stats.m_visitedVertices += params.m_onVisitedVertexCallback.GetVisitsCount();
 
     if (routes.empty() || result == AlgoT::Result::Cancelled)
       return ConvertResult<Vertex, Edge, Weight>(result);
@@ -954,6 +1321,13 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
   starter.GetGraph().GetCrossMwmGraph().Purge();
 
   RoutesCalculator calculator(starter, delegate);
+  base::HighResTimer crossMwmTimer;
+  SCOPE_GUARD(crossMwmStatsGuard, [&]()
+  {
+    m_stats.m_crossMwmMs += ElapsedMs(crossMwmTimer);
+    m_stats.m_visitedVertices += calculator.GetVisitedVertices();
+  });
+
   RoutingResultT const * bestC = nullptr;
 
   {
@@ -1017,16 +1391,18 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   TrafficStash::Guard guard(m_trafficStash);
   auto graph = MakeWorldGraph();
   graph->SetMode(WorldGraphMode::NoLeaps);
+  SCOPE_GUARD(graphStatsGuard, [&]() { m_stats.m_graphLoadingMs += graph->GetGraphsLoadingTimeMs(); });
 
   vector<Segment> startSegments;
   m2::PointD const & pointFrom = checkpoints.GetPointFrom();
   bool bestSegmentIsAlmostCodirectional = false;
   PointsOnEdgesSnapping snapping(*this, *graph);
-  if (!snapping.FindBestSegments(pointFrom, startDirection, true /* isOutgoing */, startSegments,
-                        bestSegmentIsAlmostCodirectional))
-  {
+  base::HighResTimer snappingTimer;
+  bool const isSnapped = snapping.FindBestSegments(pointFrom, startDirection, true /* isOutgoing */,
+                                                   startSegments, bestSegmentIsAlmostCodirectional);
+  m_stats.m_snappingMs += ElapsedMs(snappingTimer);
+  if (!isSnapped)
     return RouterResultCode::StartPointNotFound;
-  }
 
   auto const & lastSubroutes = m_lastRoute->GetSubroutes();
   CHECK(!lastSubroutes.empty(), ());
@@ -1051,6 +1427,17 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
                            EdgeEstimator::Purpose::Weight));
   }
 
+  if (!m_lastRouteTree || m_lastRouteTreeSubrouteIdx != checkpoints.GetPassedIdx())
+  {
+    auto tree = make_unique<RemainingTree>();
+    MakeRemainingTree(starter, prevEdges, delegate, *tree);
+    if (delegate.IsCancelled())
+      return RouterResultCode::Cancelled;
+
+    m_lastRouteTree = std::move(tree);
+    m_lastRouteTreeSubrouteIdx = checkpoints.GetPassedIdx();
+  }
+
   using Visitor = JunctionVisitor<IndexGraphStarter>;
   Visitor visitor(starter, delegate, kVisitPeriod);
 
@@ -1065,7 +1452,7 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 
   RoutingResult<Segment, RouteWeight> result;
   auto const resultCode =
-      ConvertResult<Vertex, Edge, Weight>(algorithm.AdjustRoute(params, prevEdges, result));
+      ConvertResult<Vertex, Edge, Weight>(algorithm.AdjustRoute(params, *m_lastRouteTree, result));
   if (resultCode != RouterResultCode::NoError)
     return resultCode;
 
@@ -1097,7 +1484,7 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   route.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
   route.SetSubroteAttrs(std::move(subroutes));
 
-  auto const redressResult = RedressRoute(result.m_path, delegate.GetCancellable(), starter, route);
+  auto const redressResult = RedressRoute(result.m_path, delegate, starter, route);
   if (redressResult != RouterResultCode::NoError)
     return redressResult;
 
@@ -1107,6 +1494,68 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   return RouterResultCode::NoError;
 }
 
+void IndexRouter::MakeRemainingTree(IndexGraphStarter & starter,
+                                    vector<SegmentEdge> const & prevRoute,
+                                    RouterDelegate const & delegate, RemainingTree & tree) const
+{
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+  Algorithm::MakeRemainingTree(prevRoute, tree);
+
+  vector<Segment> routeSegments;
+  routeSegments.reserve(prevRoute.size());
+  for (auto const & edge : prevRoute)
+    routeSegments.push_back(edge.GetTarget());
+
+  // The wave goes along ingoing edges from all segments of the route at once. So every segment
+  // is attached to the route by the fastest way to any of its segments.
+  Algorithm::Context context(starter, false /* forward */);
+  uint32_t visitCount = 0;
+  auto const visitVertex = [&](Segment const & vertex)
+  {
+    if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+      return false;
+
+    if (tree.m_weights.size() >= kMaxRemainingTreeSize)
+      return false;
+
+    if (tree.m_weights.count(vertex) != 0)
+      return true;
+
+    auto const & next = context.GetParent(vertex);
+    auto const nextIt = tree.m_weights.find(next);
+    CHECK(nextIt != tree.m_weights.cend(), (vertex, next));
+
+    tree.m_weights.emplace(
+        vertex, nextIt->second + context.GetDistance(vertex) - context.GetDistance(next));
+    tree.m_next.emplace(vertex, next);
+    return true;
+  };
+
+  auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge)
+  {
+    return edge.GetWeight();
+  };
+
+  uint32_t const lastFakeEdgesCount = m_lastFakeEdges->GetNumFakeEdges();
+  auto const filterStates = [&](auto const & state)
+  {
+    if (IndexGraphStarter::IsFakeSegment(state.vertex) &&
+        state.vertex.GetSegmentIdx() >= lastFakeEdgesCount)
+    {
+      return false;
+    }
+
+    return state.distance <= RouteWeight(kMaxRemainingTreeDetourSec);
+  };
+
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  Algorithm().PropagateWave(starter, routeSegments, visitVertex, adjustEdgeWeight, filterStates,
+                            reducedToRealLength, context);
+
+  LOG(LINFO, ("Remaining tree of", prevRoute.size(), "route segments:", tree.m_weights.size()));
+}
+
 unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 {
   // Use saved routing options for all types (car, bicycle, pedestrian).
@@ -1119,11 +1568,12 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
   auto crossMwmGraph = make_unique<CrossMwmGraph>(
       m_numMwmIds, m_numMwmTree,
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_countryRectFn, m_dataSource);
+      m_countryRectFn, m_dataSource, m_crossMwmConnectorsCache);
 
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_loadAltitudes, m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions);
+      m_loadAltitudes, m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions,
+      m_indexGraphsCache);
 
   if (m_vehicleType != VehicleType::Transit)
   {
@@ -1434,7 +1884,9 @@ IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc(
     RoutingResult<JointSegment, RouteWeight> route;
     using AlgoT = AStarAlgorithm<Vertex, Edge, Weight>;
 
-    if (AlgoT().FindPathBidirectional(params, route) == AlgoT::Result::OK)
+    auto const result = AlgoT().FindPathBidirectional(params, route);
+    m_visitedVertices += params.m_onVisitedVertexCallback.GetVisitsCount();
+    if (result == AlgoT::Result::OK)
     {
       LOG(LDEBUG, ("Sub-route weight:", route.m_distance));
 
@@ -1655,9 +2107,14 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
 }
 
 RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
-                                           base::Cancellable const & cancellable,
-                                           IndexGraphStarter & starter, Route & route)
+                                           RouterDelegate const & delegate,
+                                           IndexGraphStarter & starter, Route & route,
+                                           bool makeEarlyRoute /* = true */)
 {
+  base::HighResTimer timer;
+  SCOPE_GUARD(statsGuard, [&]() { m_stats.m_directionsMs += ElapsedMs(timer); });
+
+  auto const & cancellable = delegate.GetCancellable();
   CHECK(!segments.empty(), ());
   IndexGraphStarter::CheckValidRoute(segments);
 
@@ -1685,6 +2142,12 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
   }
 
   m_directionsEngine->SetVehicleType(m_vehicleType);
+  if (makeEarlyRoute && delegate.HasEarlyRouteCallback() && m_vehicleType != VehicleType::Transit)
+    MakeEarlyRoute(segments, junctions, times, delegate, starter, route);
+
+  if (cancellable.IsCancelled())
+    return RouterResultCode::Cancelled;
+
   ReconstructRoute(*m_directionsEngine, roadGraph, cancellable, junctions, times, route);
 
   if (cancellable.IsCancelled())
@@ -1696,12 +2159,11 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
     return RouterResultCode::RouteNotFoundRedressRouteError;
   }
 
-  auto & worldGraph = starter.GetGraph();
-
   /// @todo I suspect that we can avoid calculating segments inside ReconstructRoute
   /// and use original |segments| (IndexRoadGraph::GetRouteSegments).
 #ifdef DEBUG
   {
+    auto & worldGraph = starter.GetGraph();
     auto const isPassThroughAllowed = [&worldGraph](Segment const & s)
     {
       return worldGraph.IsPassThroughAllowed(s.GetMwmId(), s.GetFeatureId());
@@ -1725,6 +2187,83 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
   }
 #endif
 
+  FillRouteSegmentsAttrs(starter, route);
+
+  vector<platform::CountryFile> speedCamProhibited;
+  FillSpeedCamProhibitedMwms(segments, speedCamProhibited);
+  route.SetMwmsPartlyProhibitedForSpeedCams(std::move(speedCamProhibited));
+
+  return RouterResultCode::NoError;
+}
+
+void IndexRouter::MakeEarlyRoute(vector<Segment> const & segments,
+                                 vector<geometry::PointWithAltitude> const & junctions,
+                                 vector<double> const & times, RouterDelegate const & delegate,
+                                 IndexGraphStarter & starter, Route const & route)
+{
+  size_t const segsCount = segments.size();
+  vector<double> distances(segsCount + 1, 0.0);
+  for (size_t i = 1; i <= segsCount; ++i)
+  {
+    distances[i] = distances[i - 1] +
+                   mercator::DistanceOnEarth(junctions[i - 1].GetPoint(), junctions[i].GetPoint());
+  }
+
+  if (distances.back() < kMinEarlyRouteDistanceM)
+    return;
+
+  // Number of the first segments which are annotated.
+  size_t const annotatedCount = static_cast<size_t>(
+      distance(distances.cbegin(), lower_bound(distances.cbegin(), distances.cend(),
+                                               kEarlyRouteAnnotationDistanceM)));
+  if (annotatedCount >= segsCount)
+    return;
+
+  vector<Segment> const annotatedSegments(segments.cbegin(), segments.cbegin() + annotatedCount);
+  vector<geometry::PointWithAltitude> const annotatedJunctions(junctions.cbegin(),
+                                                               junctions.cbegin() + annotatedCount + 1);
+  IndexRoadGraph roadGraph(starter, annotatedSegments, annotatedJunctions, m_dataSource);
+
+  vector<RouteSegment> routeSegments;
+  if (!m_directionsEngine->Generate(roadGraph, annotatedJunctions, delegate.GetCancellable(), routeSegments))
+    return;
+
+  CHECK_EQUAL(routeSegments.size(), annotatedCount, ());
+
+  // The last turn of the annotated part is the finish of the whole route.
+  auto finishTurn = routeSegments.back().GetTurn();
+  finishTurn.m_index = base::asserted_cast<uint32_t>(segsCount);
+  routeSegments.back().ClearTurn();
+
+  routeSegments.reserve(segsCount);
+  for (size_t i = annotatedCount; i < segsCount; ++i)
+  {
+    routeSegments.emplace_back(segments[i], i + 1 == segsCount ? finishTurn : turns::TurnItem(),
+                               junctions[i + 1], RouteSegment::RoadNameInfo());
+  }
+
+  FillSegmentInfo(times, routeSegments);
+
+  Route earlyRoute(route);
+  earlyRoute.SetRouteSegments(std::move(routeSegments));
+
+  vector<m2::PointD> routeGeometry;
+  JunctionsToPoints(junctions, routeGeometry);
+  earlyRoute.SetGeometry(routeGeometry.begin(), routeGeometry.end());
+
+  FillRouteSegmentsAttrs(starter, earlyRoute);
+
+  vector<platform::CountryFile> speedCamProhibited;
+  FillSpeedCamProhibitedMwms(segments, speedCamProhibited);
+  earlyRoute.SetMwmsPartlyProhibitedForSpeedCams(std::move(speedCamProhibited));
+
+  LOG(LINFO, ("Early route is ready, turns are generated for", annotatedCount, "of", segsCount, "segments."));
+  delegate.OnEarlyRoute(earlyRoute);
+}
+
+void IndexRouter::FillRouteSegmentsAttrs(IndexGraphStarter & starter, Route & route)
+{
+  auto & worldGraph = starter.GetGraph();
   for (auto & routeSegment : route.GetRouteSegments())
   {
     auto & segment = routeSegment.GetSegment();
@@ -1754,11 +2293,7 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
       starter.ConvertToReal(segment);
   }
 
-  vector<platform::CountryFile> speedCamProhibited;
-  FillSpeedCamProhibitedMwms(segments, speedCamProhibited);
-  route.SetMwmsPartlyProhibitedForSpeedCams(std::move(speedCamProhibited));
-
-  return RouterResultCode::NoError;
+  route.FillSpeedCamerasOnRoute();
 }
 
 bool IndexRouter::AreSpeedCamerasProhibited(NumMwmId mwmID) const
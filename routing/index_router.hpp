@@ -4,14 +4,18 @@
 #include "routing/base/astar_progress.hpp"
 #include "routing/base/routing_result.hpp"
 
+#include "routing/cross_mwm_graph.hpp"
 #include "routing/data_source.hpp"
 #include "routing/directions_engine.hpp"
 #include "routing/edge_estimator.hpp"
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/guides_connections.hpp"
+#include "routing/index_graph_loader.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/regions_decl.hpp"
+#include "routing/route.hpp"
+#include "routing/route_building_stats.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segment.hpp"
@@ -22,13 +26,17 @@
 
 #include "platform/country_file.hpp"
 
+#include "base/timer.hpp"
+
 #include "geometry/point2d.hpp"
 #include "geometry/tree4d.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace traffic { class TrafficCache; }
@@ -65,6 +73,26 @@ public:
     m2::PointD const m_direction;
   };
 
+  /// \brief Travel time and distance of the best route from a source to a target of a matrix.
+  struct MatrixItem
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    double m_timeSec = 0.0;
+    double m_distanceMeters = 0.0;
+  };
+
+  // Rows correspond to sources and columns correspond to targets.
+  using Matrix = std::vector<std::vector<MatrixItem>>;
+
+  /// \brief Part of the road graph which is reachable from a point within a time limit.
+  struct Isochrone
+  {
+    // Real segments which are reached within the limit.
+    std::vector<Segment> m_segments;
+    // Star-shaped polygon around the reached segments. The first point is not repeated.
+    std::vector<m2::PointD> m_polygon;
+  };
+
   IndexRouter(VehicleType vehicleType, bool loadAltitudes,
               CountryParentNameGetterFn const & countryParentNameGetterFn,
               TCountryFileFn const & countryFileFn, CountryRectFn const & countryRectFn,
@@ -82,12 +110,45 @@ public:
                                   m2::PointD const & startDirection, bool adjustToPrevRoute,
                                   RouterDelegate const & delegate, Route & route) override;
 
+  /// \brief Calculates |route| like CalculateRoute() without adjustment to the previous route
+  /// and fills |alternatives| with up to |maxAlternatives| alternative routes. Alternatives are
+  /// found for the last subroute only, when routing is done in Joints or NoLeaps mode.
+  /// So |alternatives| may be empty even if |route| is built.
+  RouterResultCode CalculateRouteWithAlternatives(Checkpoints const & checkpoints,
+                                                  m2::PointD const & startDirection,
+                                                  RouterDelegate const & delegate,
+                                                  size_t maxAlternatives, Route & route,
+                                                  std::vector<Route> & alternatives);
+
+  /// \brief Calculates travel times and distances from each of |sources| to each of |targets|.
+  /// One Dijkstra wave is propagated from every source until all the targets are reached, so
+  /// a matrix of N x M items costs about N routes, not N x M ones.
+  /// \note Routes are neither built nor redressed. Leaps are not used, so the method is intended
+  /// for points which are not too far from each other.
+  /// \returns NoError if all the sources have been processed. Every item of |matrix| has its own
+  /// result code.
+  RouterResultCode CalculateMatrix(std::vector<m2::PointD> const & sources,
+                                   std::vector<m2::PointD> const & targets,
+                                   RouterDelegate const & delegate, Matrix & matrix);
+
+  /// \brief Fills |isochrone| with the roads which are reachable from |start| within |maxTimeSec|.
+  /// A Dijkstra wave bounded by |maxTimeSec| is propagated in NoLeaps mode, so it crosses mwm
+  /// borders and uses the same edge weights as routes.
+  RouterResultCode CalculateIsochrone(m2::PointD const & start, double maxTimeSec,
+                                      RouterDelegate const & delegate, Isochrone & isochrone);
+
   bool FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction,
                                    double radius, EdgeProj & proj) override;
 
+  /// Loads index graphs of the downloaded mwms near |point| to |m_indexGraphsCache|,
+  /// the mwm of |point| first.
+  void WarmUp(m2::PointD const & point) override;
+
   bool GetBestOutgoingEdges(m2::PointD const & checkpoint, WorldGraph & graph, std::vector<Edge> & edges);
 
   VehicleType GetVehicleType() const { return m_vehicleType; }
+  /// \returns timings of the last CalculateRoute() call.
+  RouteBuildingStats const & GetStats() const { return m_stats; }
 
 private:
   RouterResultCode CalculateSubrouteJointsMode(IndexGraphStarter & starter,
@@ -117,6 +178,12 @@ private:
                                m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
 
+  using RemainingTree = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>::RemainingTree;
+  // Fills |tree| with |prevRoute| and ways to it from the segments which are near to it.
+  // Fake segments of |starter| which are not kept in |m_lastFakeEdges| are not used.
+  void MakeRemainingTree(IndexGraphStarter & starter, std::vector<SegmentEdge> const & prevRoute,
+                         RouterDelegate const & delegate, RemainingTree & tree) const;
+
   std::unique_ptr<WorldGraph> MakeWorldGraph();
 
   using EdgeProjectionT = IRoadGraph::EdgeProjectionT;
@@ -196,11 +263,14 @@ private:
     std::map<std::pair<Segment, Segment>, RoutingResultT> m_cache;
     IndexGraphStarter & m_starter;
     RouterDelegate const & m_delegate;
+    uint64_t m_visitedVertices = 0;
 
   public:
     RoutesCalculator(IndexGraphStarter & starter, RouterDelegate const & delegate)
       : m_starter(starter), m_delegate(delegate) {}
 
+    uint64_t GetVisitedVertices() const { return m_visitedVertices; }
+
     using ProgressPtrT = std::shared_ptr<AStarProgress>;
     RoutingResultT const * Calc(Segment const & beg, Segment const & end,
                                 ProgressPtrT const & progress, double progressCoef);
@@ -217,9 +287,17 @@ private:
                                       RoutesCalculator & calculator,
                                       RoutingResultT & result);
 
-  RouterResultCode RedressRoute(std::vector<Segment> const & segments,
-                                base::Cancellable const & cancellable, IndexGraphStarter & starter,
-                                Route & route);
+  RouterResultCode RedressRoute(std::vector<Segment> const & segments, RouterDelegate const & delegate,
+                                IndexGraphStarter & starter, Route & route,
+                                bool makeEarlyRoute = true);
+  /// \brief Passes to |delegate| a copy of |route| where turns are generated only for
+  /// the beginning of the route. |route| should have no segments yet.
+  void MakeEarlyRoute(std::vector<Segment> const & segments,
+                      std::vector<geometry::PointWithAltitude> const & junctions,
+                      std::vector<double> const & times, RouterDelegate const & delegate,
+                      IndexGraphStarter & starter, Route const & route);
+  /// \brief Fills transit info, road types, speed cameras, traffic and speed limits of |route| segments.
+  void FillRouteSegmentsAttrs(IndexGraphStarter & starter, Route & route);
 
   bool AreSpeedCamerasProhibited(NumMwmId mwmID) const;
   bool AreMwmsNear(IndexGraphStarter const & starter) const;
@@ -245,13 +323,33 @@ private:
     UNREACHABLE();
   }
 
+  /// \param alternatives is filled with alternatives of |routingResult| if it's not nullptr
+  /// and alternatives are requested by CalculateRouteWithAlternatives().
   template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
   RouterResultCode FindPath(AStarParams & params, std::set<NumMwmId> const & mwmIds,
-                            RoutingResult<Vertex, Weight> & routingResult)
+                            RoutingResult<Vertex, Weight> & routingResult,
+                            std::vector<RoutingResult<Vertex, Weight>> * alternatives = nullptr)
   {
-    AStarAlgorithm<Vertex, Edge, Weight> algorithm;
-    return ConvertTransitResult(
-        mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectional(params, routingResult)));
+    using Algorithm = AStarAlgorithm<Vertex, Edge, Weight>;
+    Algorithm algorithm;
+    base::HighResTimer timer;
+    typename Algorithm::Result result;
+    if (alternatives && m_maxAlternatives != 0)
+    {
+      typename Algorithm::AlternativesParams altParams;
+      altParams.m_maxAlternatives = m_maxAlternatives;
+      altParams.m_threadsCount =
+          std::min(std::max(std::thread::hardware_concurrency(), 1u), kMaxAlternativesThreads);
+      result = algorithm.FindPathBidirectionalWithAlternatives(params, altParams, routingResult,
+                                                               *alternatives);
+    }
+    else
+    {
+      result = algorithm.FindPathBidirectional(params, routingResult);
+    }
+    m_stats.m_searchMs += timer.ElapsedNanoseconds() / 1e6;
+    m_stats.m_visitedVertices += params.m_onVisitedVertexCallback.GetVisitsCount();
+    return ConvertTransitResult(mwmIds, ConvertResult<Vertex, Edge, Weight>(result));
   }
 
   void SetupAlgorithmMode(IndexGraphStarter & starter, bool guidesActive = false) const;
@@ -283,9 +381,24 @@ private:
   FeaturesRoadGraphBase m_roadGraph;
 
   std::shared_ptr<EdgeEstimator> m_estimator;
+  // Keeps cross-mwm connectors between routes. It is cleared with mwm handles of |m_dataSource|.
+  std::shared_ptr<CrossMwmGraph::ConnectorsCache> m_crossMwmConnectorsCache;
+  // Keeps index graphs between routes. Graphs don't keep mwm handles, so it isn't cleared.
+  std::shared_ptr<IndexGraphsCache> m_indexGraphsCache;
   std::unique_ptr<DirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  // Ways to the subroute |m_lastRouteTreeSubrouteIdx| of |m_lastRoute|. The tree is built
+  // on the first adjustment of the route and is reused by the next ones.
+  std::unique_ptr<RemainingTree> m_lastRouteTree;
+  size_t m_lastRouteTreeSubrouteIdx = 0;
+  RouteBuildingStats m_stats;
+
+  // Alternatives are requested for the current CalculateRouteWithAlternatives() call only.
+  static uint32_t constexpr kMaxAlternativesThreads = 4;
+  size_t m_maxAlternatives = 0;
+  std::vector<std::vector<Segment>> m_alternativeSubroutes;
+  std::vector<Route> m_alternativeRoutes;
 
   // If a ckeckpoint is near to the guide track we need to build route through this track.
   GuidesConnections m_guides;
@@ -75,6 +75,8 @@ public:
     }
   }
 
+  uint32_t GetVisitsCount() const { return m_visitCounter; }
+
 private:
   Graph & m_graph;
   RouterDelegate const & m_delegate;
@@ -16,17 +16,17 @@ namespace routing
 {
 bool Maxspeeds::IsEmpty() const
 {
-  return m_forwardMaxspeedsTable.size() == 0 && m_bidirectionalMaxspeeds.empty();
+  return m_forwardMaxspeeds.empty() && m_bidirectionalMaxspeeds.empty();
 }
 
 Maxspeed Maxspeeds::GetMaxspeed(uint32_t fid) const
 {
   // Forward only maxspeeds.
-  if (HasForwardMaxspeed(fid))
+  uint8_t const macro = fid < m_forwardMaxspeeds.size()
+                            ? m_forwardMaxspeeds[fid]
+                            : static_cast<uint8_t>(SpeedMacro::Undefined);
+  if (macro != static_cast<uint8_t>(SpeedMacro::Undefined))
   {
-    auto const r = m_forwardMaxspeedsTable.rank(fid);
-    CHECK_LESS(r, m_forwardMaxspeeds.Size(), ());
-    uint8_t const macro = m_forwardMaxspeeds.Get(r);
     auto const speed = GetMaxspeedConverter().MacroToSpeed(static_cast<SpeedMacro>(macro));
     CHECK(speed.IsValid(), ());
     return {speed.GetUnits(), speed.GetSpeed(), kInvalidSpeed};
@@ -51,11 +51,6 @@ MaxspeedType Maxspeeds::GetDefaultSpeed(bool inCity, HighwayType hwType) const
   return (it != theMap.end()) ? it->second : kInvalidSpeed;
 }
 
-bool Maxspeeds::HasForwardMaxspeed(uint32_t fid) const
-{
-  return fid < m_forwardMaxspeedsTable.size() ? m_forwardMaxspeedsTable[fid] : false;
-}
-
 void Maxspeeds::Load(ReaderT const & reader)
 {
   ReaderSource<ReaderT> src(reader);
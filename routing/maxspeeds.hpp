@@ -5,17 +5,13 @@
 
 #include "indexer/mwm_set.hpp"
 
-#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
-#include "coding/simple_dense_coding.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 
-#include "3party/succinct/elias_fano.hpp"
-
-
 namespace routing
 {
 class MaxspeedsSerializer;
@@ -37,15 +33,10 @@ public:
   void Load(ReaderT const & reader);
 
 private:
-  bool HasForwardMaxspeed(uint32_t fid) const;
-
-  // Feature IDs (compressed rank bit-vector).
-  std::unique_ptr<CopiedMemoryRegion> m_forwardMaxspeedTableRegion;
-  succinct::elias_fano m_forwardMaxspeedsTable;
-
-  // Forward speeds (compressed uint8_t vector).
-  std::unique_ptr<CopiedMemoryRegion> m_forwardMaxspeedRegion;
-  coding::SimpleDenseCoding m_forwardMaxspeeds;
+  // Forward speed macros indexed by feature id, SpeedMacro::Undefined for features without
+  // forward only maxspeed. The compressed section data is decoded on loading, because maxspeed
+  // is looked up for every road loaded by the routing.
+  std::vector<uint8_t> m_forwardMaxspeeds;
 
   std::vector<FeatureMaxspeed> m_bidirectionalMaxspeeds;
 
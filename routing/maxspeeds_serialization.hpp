@@ -5,6 +5,7 @@
 #include "routing_common/vehicle_model.hpp"
 
 #include "coding/reader.hpp"
+#include "coding/simple_dense_coding.hpp"
 #include "coding/succinct_mapper.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
@@ -19,6 +20,8 @@
 #include <memory>
 #include <vector>
 
+#include "3party/succinct/elias_fano.hpp"
+
 namespace routing
 {
 /// \brief
@@ -179,14 +182,31 @@ public:
       // Reading maxspeed information for features which have only forward maxspeed.
       std::vector<uint8_t> forwardTableData(header.m_forwardMaxspeedOffset);
       src.Read(forwardTableData.data(), forwardTableData.size());
-      maxspeeds.m_forwardMaxspeedTableRegion = std::make_unique<CopiedMemoryRegion>(std::move(forwardTableData));
-      coding::Map(maxspeeds.m_forwardMaxspeedsTable,
-          maxspeeds.m_forwardMaxspeedTableRegion->ImmutableData(), "ForwardMaxspeedsTable");
+      succinct::elias_fano forwardMaxspeedsTable;
+      coding::Map(forwardMaxspeedsTable, forwardTableData.data(), "ForwardMaxspeedsTable");
 
       std::vector<uint8_t> forwardData(header.m_bidirectionalMaxspeedOffset - header.m_forwardMaxspeedOffset);
       src.Read(forwardData.data(), forwardData.size());
-      maxspeeds.m_forwardMaxspeedRegion = std::make_unique<CopiedMemoryRegion>(std::move(forwardData));
-      Map(maxspeeds.m_forwardMaxspeeds, maxspeeds.m_forwardMaxspeedRegion->ImmutableData(), "ForwardMaxspeeds");
+      coding::SimpleDenseCoding forwardMaxspeeds;
+      Map(forwardMaxspeeds, forwardData.data(), "ForwardMaxspeeds");
+
+      // Decoding to the table indexed by feature id.
+      uint64_t const forwardCount = forwardMaxspeedsTable.num_ones();
+      CHECK_EQUAL(forwardCount, forwardMaxspeeds.Size(), ());
+      if (forwardCount != 0)
+      {
+        auto & table = maxspeeds.m_forwardMaxspeeds;
+        table.assign(forwardMaxspeedsTable.select(forwardCount - 1) + 1,
+                     static_cast<uint8_t>(SpeedMacro::Undefined));
+
+        succinct::elias_fano::select_enumerator it(forwardMaxspeedsTable, 0 /* i */);
+        for (uint64_t i = 0; i < forwardCount; ++i)
+        {
+          uint8_t const macro = forwardMaxspeeds.Get(i);
+          ASSERT_NOT_EQUAL(macro, static_cast<uint8_t>(SpeedMacro::Undefined), (i));
+          table[it.next()] = macro;
+        }
+      }
     }
 
     // Loading bidirectional speeds.
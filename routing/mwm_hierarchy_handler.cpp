@@ -95,10 +95,23 @@ bool MwmHierarchyHandler::HasCrossBorderPenalty(NumMwmId mwmId1, NumMwmId mwmId2
   if (mwmId1 == mwmId2)
     return false;
 
+  static_assert(sizeof(NumMwmId) * 2 <= sizeof(uint32_t));
+  uint32_t const key = (static_cast<uint32_t>(mwmId1) << 16) | mwmId2;
+  auto const it = m_crossBorderPenaltyCache.find(key);
+  if (it != m_crossBorderPenaltyCache.end())
+    return it->second;
+
+  bool const res = HasCrossBorderPenaltyImpl(mwmId1, mwmId2);
+  m_crossBorderPenaltyCache.emplace(key, res);
+  return res;
+}
+
+bool MwmHierarchyHandler::HasCrossBorderPenaltyImpl(NumMwmId mwmId1, NumMwmId mwmId2)
+{
   std::string const mwm1 = GetMwmName(mwmId1);
   std::string const mwm2 = GetMwmName(mwmId2);
-  std::string const country1 = GetParentCountryCached(mwmId1);
-  std::string const country2 = GetParentCountryCached(mwmId2);
+  std::string const & country1 = GetParentCountryCached(mwmId1);
+  std::string const & country2 = GetParentCountryCached(mwmId2);
 
   // If one of the mwms belongs to the territorial dispute we add penalty for crossing its borders.
   if (country1.empty() || country2.empty())
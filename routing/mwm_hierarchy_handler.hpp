@@ -5,6 +5,7 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -30,11 +31,17 @@ private:
   std::string GetMwmName(NumMwmId mwmId) const;
   std::string GetParentCountry(NumMwmId mwmId) const;
   std::string const & GetParentCountryCached(NumMwmId mwmId);
+  bool HasCrossBorderPenaltyImpl(NumMwmId mwmId1, NumMwmId mwmId2);
 
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   CountryParentNameGetterFn m_countryParentNameGetterFn;
 
   using MwmToCountry = std::unordered_map<NumMwmId, std::string>;
   MwmToCountry m_mwmCountriesCache;
+
+  /// Penalty flag for each ordered pair of mwms. Leaps search asks for it on every twin edge
+  /// while the number of crossed mwm pairs is small, so names and countries aren't compared again.
+  using MwmPairToPenalty = std::unordered_map<uint32_t, bool>;
+  MwmPairToPenalty m_crossBorderPenaltyCache;
 };
 }  // namespace routing
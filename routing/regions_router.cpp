@@ -4,7 +4,6 @@
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/junction_visitor.hpp"
-#include "routing/regions_sparse_graph.hpp"
 #include "routing/routing_helpers.hpp"
 
 #include "base/scope_guard.hpp"
@@ -13,14 +12,19 @@ namespace routing
 {
 RegionsRouter::RegionsRouter(CountryFileGetterFn const & countryFileGetter,
                              std::shared_ptr<NumMwmIds> numMwmIds, DataSource & dataSource,
-                             RouterDelegate const & delegate, Checkpoints const & checkpoints)
+                             RouterDelegate const & delegate, Checkpoints const & checkpoints,
+                             std::shared_ptr<RegionsSparseGraph> sparseGraph,
+                             std::set<RegionsPair> skippedSubroutes)
   : m_countryFileGetterFn(countryFileGetter)
   , m_numMwmIds(std::move(numMwmIds))
   , m_dataSource(dataSource)
   , m_checkpoints(checkpoints)
+  , m_sparseGraph(std::move(sparseGraph))
+  , m_skippedSubroutes(std::move(skippedSubroutes))
   , m_delegate(delegate)
 {
   CHECK(m_countryFileGetterFn, ());
+  CHECK(m_sparseGraph, ());
 }
 
 template <typename Vertex, typename Edge, typename Weight>
@@ -85,25 +89,29 @@ RouterResultCode RegionsRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter &
 void RegionsRouter::Do()
 {
   m_mwmNames.clear();
+  m_subroutesMwmNames.clear();
 
-  auto sparseGraph = std::make_shared<RegionsSparseGraph>(m_countryFileGetterFn, m_numMwmIds, m_dataSource);
-  sparseGraph->LoadRegionsSparseGraph();
+  m_sparseGraph->LoadRegionsSparseGraph();
 
   std::unique_ptr<WorldGraph> graph = std::make_unique<DummyWorldGraph>();
 
   for (size_t i = 0; i < m_checkpoints.GetNumSubroutes(); ++i)
   {
+    RegionsPair regions(GetCheckpointRegion(i).second, GetCheckpointRegion(i + 1).second);
     // equal mwm ids
-    if (GetCheckpointRegion(i).second == GetCheckpointRegion(i + 1).second)
+    if (regions.first == regions.second)
+      continue;
+
+    if (m_skippedSubroutes.count(regions) != 0)
       continue;
 
     std::optional<FakeEnding> const startFakeEnding =
-        sparseGraph->GetFakeEnding(m_checkpoints.GetPoint(i));
+        m_sparseGraph->GetFakeEnding(m_checkpoints.GetPoint(i));
     if (!startFakeEnding)
       return;
 
     std::optional<FakeEnding> const finishFakeEnding =
-        sparseGraph->GetFakeEnding(m_checkpoints.GetPoint(i + 1));
+        m_sparseGraph->GetFakeEnding(m_checkpoints.GetPoint(i + 1));
     if (!finishFakeEnding)
       return;
 
@@ -113,7 +121,7 @@ void RegionsRouter::Do()
 
     subrouteStarter.GetGraph().SetMode(WorldGraphMode::NoLeaps);
 
-    subrouteStarter.SetRegionsGraphMode(sparseGraph);
+    subrouteStarter.SetRegionsGraphMode(m_sparseGraph);
 
     std::vector<Segment> subroute;
 
@@ -123,6 +131,7 @@ void RegionsRouter::Do()
     if (result != RouterResultCode::NoError)
       return;
 
+    auto & subrouteMwmNames = m_subroutesMwmNames[regions];
     for (auto const & s : subroute)
     {
       for (bool front : {false, true})
@@ -133,7 +142,8 @@ void RegionsRouter::Do()
         if (name.empty() && !IndexGraphStarter::IsFakeSegment(s))
           name = m_numMwmIds->GetFile(s.GetMwmId()).GetName();
 
-        m_mwmNames.emplace(name);
+        subrouteMwmNames.emplace(name);
+        m_mwmNames.emplace(std::move(name));
       }
     }
   }
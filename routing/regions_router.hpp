@@ -3,10 +3,15 @@
 #include "routing/base/astar_algorithm.hpp"
 #include "routing/checkpoints.hpp"
 #include "routing/regions_decl.hpp"
+#include "routing/regions_sparse_graph.hpp"
 #include "routing/router_delegate.hpp"
 
 #include "base/thread.hpp"
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -20,13 +25,22 @@ class IndexGraphStarter;
 class RegionsRouter : public threads::IRoutine
 {
 public:
+  // Start and finish regions of a subroute.
+  using RegionsPair = std::pair<std::string, std::string>;
+  using SubroutesMwmNames = std::map<RegionsPair, std::unordered_set<std::string>>;
+
+  // |sparseGraph| is loaded on the first use and may be shared between the routers which don't
+  // run simultaneously. Subroutes between |skippedSubroutes| regions are not calculated.
   RegionsRouter(CountryFileGetterFn const & countryFileGetter, std::shared_ptr<NumMwmIds> numMwmIds,
                 DataSource & dataSource, RouterDelegate const & delegate,
-                Checkpoints const & checkpoints);
+                Checkpoints const & checkpoints, std::shared_ptr<RegionsSparseGraph> sparseGraph,
+                std::set<RegionsPair> skippedSubroutes = {});
 
   void Do() override;
 
   std::unordered_set<std::string> const & GetMwmNames() const;
+  // Mwm names of every calculated subroute keyed by the subroute regions.
+  SubroutesMwmNames const & GetSubroutesMwmNames() const { return m_subroutesMwmNames; }
 
 private:
   template <typename Vertex, typename Edge, typename Weight>
@@ -45,7 +59,10 @@ private:
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   DataSource & m_dataSource;
   Checkpoints const m_checkpoints;
+  std::shared_ptr<RegionsSparseGraph> m_sparseGraph;
+  std::set<RegionsPair> const m_skippedSubroutes;
   std::unordered_set<std::string> m_mwmNames;
+  SubroutesMwmNames m_subroutesMwmNames;
 
   RouterDelegate const & m_delegate;
 };
@@ -23,6 +23,10 @@ RegionsSparseGraph::RegionsSparseGraph(CountryFileGetterFn const & countryFileGe
 
 void RegionsSparseGraph::LoadRegionsSparseGraph()
 {
+  if (m_isLoaded)
+    return;
+  m_isLoaded = true;
+
   MwmSet::MwmHandle mwmWorld = indexer::FindWorld(m_dataSource);
   if (!mwmWorld.IsAlive())
   {
@@ -21,7 +21,8 @@ public:
   RegionsSparseGraph(CountryFileGetterFn const & countryFileGetter,
                      std::shared_ptr<NumMwmIds> numMwmIds, DataSource & dataSource);
 
-  // Loads data from mwm section.
+  // Loads data from mwm section. Does nothing if the graph is already loaded, so the graph may be
+  // kept between requests.
   void LoadRegionsSparseGraph();
 
   std::optional<FakeEnding> GetFakeEnding(m2::PointD const & point) const;
@@ -38,6 +39,7 @@ private:
   CrossBorderSegment const & GetDataById(RegionSegmentId const & id) const;
 
   CrossBorderGraph m_graph;
+  bool m_isLoaded = false;
 
   CountryFileGetterFn const m_countryFileGetterFn;
   std::shared_ptr<NumMwmIds> m_numMwmIds = nullptr;
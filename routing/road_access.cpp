@@ -48,6 +48,9 @@ std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
 std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
     uint32_t featureId, double weight) const
 {
+  if (!m_waysWithRules.Contains(featureId))
+    return {Type::Yes, Confidence::Sure};
+
   auto const itConditional = m_wayToAccessConditional.find(featureId);
   if (itConditional != m_wayToAccessConditional.cend())
   {
@@ -67,6 +70,9 @@ std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
 std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
     RoadPoint const & point, double weight) const
 {
+  if (!m_waysWithPointRules.Contains(point.GetFeatureId()))
+    return {Type::Yes, Confidence::Sure};
+
   auto const itConditional = m_pointToAccessConditional.find(point);
   if (itConditional != m_pointToAccessConditional.cend())
   {
@@ -86,8 +92,9 @@ std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
 std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccessWithoutConditional(
     uint32_t featureId) const
 {
-  // todo(@m) This may or may not be too slow. Consider profiling this and using
-  // a Bloom filter or anything else that is faster than ska::flat_hash_map
+  if (!m_waysWithRules.Contains(featureId))
+    return {Type::Yes, Confidence::Sure};
+
   auto const it = m_wayToAccess.find(featureId);
   if (it != m_wayToAccess.cend())
     return {it->second, Confidence::Sure};
@@ -98,6 +105,9 @@ std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccessWithout
 std::pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccessWithoutConditional(
     RoadPoint const & point) const
 {
+  if (!m_waysWithPointRules.Contains(point.GetFeatureId()))
+    return {Type::Yes, Confidence::Sure};
+
   auto const it = m_pointToAccess.find(point);
   if (it != m_pointToAccess.cend())
     return {it->second, Confidence::Sure};
@@ -112,6 +122,21 @@ bool RoadAccess::operator==(RoadAccess const & rhs) const
          m_pointToAccessConditional == rhs.m_pointToAccessConditional;
 }
 
+void RoadAccess::UpdateFeaturesWithRules()
+{
+  m_waysWithRules.Clear();
+  for (auto const & kv : m_wayToAccess)
+    m_waysWithRules.Insert(kv.first);
+  for (auto const & kv : m_wayToAccessConditional)
+    m_waysWithRules.Insert(kv.first);
+
+  m_waysWithPointRules.Clear();
+  for (auto const & kv : m_pointToAccess)
+    m_waysWithPointRules.Insert(kv.first.GetFeatureId());
+  for (auto const & kv : m_pointToAccessConditional)
+    m_waysWithPointRules.Insert(kv.first.GetFeatureId());
+}
+
 // static
 std::optional<RoadAccess::Confidence> RoadAccess::GetConfidenceForAccessConditional(
     time_t momentInTime, osmoh::OpeningHours const & openingHours)
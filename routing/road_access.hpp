@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/features_bitset.hpp"
 #include "routing/road_point.hpp"
 #include "routing/route_weight.hpp"
 
@@ -125,24 +126,28 @@ public:
   {
     m_wayToAccess = std::move(access);
     m_wayToAccessConditional = std::move(condAccess);
+    UpdateFeaturesWithRules();
   }
 
   void SetPointAccess(PointToAccess && access, PointToAccessConditional && condAccess)
   {
     m_pointToAccess = std::move(access);
     m_pointToAccessConditional = std::move(condAccess);
+    UpdateFeaturesWithRules();
   }
 
   void SetAccess(WayToAccess && wayAccess, PointToAccess && pointAccess)
   {
     m_wayToAccess = std::move(wayAccess);
     m_pointToAccess = std::move(pointAccess);
+    UpdateFeaturesWithRules();
   }
 
   void SetAccessConditional(WayToAccessConditional && wayAccess, PointToAccessConditional && pointAccess)
   {
     m_wayToAccessConditional = std::move(wayAccess);
     m_pointToAccessConditional = std::move(pointAccess);
+    UpdateFeaturesWithRules();
   }
 
   bool operator==(RoadAccess const & rhs) const;
@@ -151,6 +156,7 @@ public:
   void SetWayToAccessForTests(WayToAccess && wayToAccess)
   {
     m_wayToAccess = std::forward<WayToAccess>(wayToAccess);
+    UpdateFeaturesWithRules();
   }
 
   template <typename T>
@@ -170,6 +176,8 @@ private:
   std::pair<Type, Confidence> GetAccess(uint32_t featureId, double weight) const;
   std::pair<Type, Confidence> GetAccess(RoadPoint const & point, double weight) const;
 
+  void UpdateFeaturesWithRules();
+
   std::function<time_t()> m_currentTimeGetter;
 
   // If segmentIdx of a key in this map is 0, it means the
@@ -179,6 +187,11 @@ private:
   PointToAccess m_pointToAccess;
   WayToAccessConditional m_wayToAccessConditional;
   PointToAccessConditional m_pointToAccessConditional;
+
+  // Features which have way or point rules, conditional or not. Most of features have no rules
+  // at all, so the maps above are looked up for the rest only.
+  FeaturesBitset m_waysWithRules;
+  FeaturesBitset m_waysWithPointRules;
 };
 
 time_t GetCurrentTimestamp();
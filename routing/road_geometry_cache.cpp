@@ -0,0 +1,145 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/latlon_with_altitude.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace routing
+{
+RoadGeometryCache::RoadGeometryCache(size_t memoryBudgetBytes)
+{
+  SetMemoryBudget(memoryBudgetBytes);
+}
+
+// static
+RoadGeometryCache & RoadGeometryCache::Instance()
+{
+  static RoadGeometryCache instance;
+  return instance;
+}
+
+void RoadGeometryCache::SetMemoryBudget(size_t memoryBudgetBytes)
+{
+  size_t const shardBudget = memoryBudgetBytes / kShardsCount;
+  m_shardBudget = shardBudget;
+  for (auto & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.Evict(shardBudget);
+  }
+}
+
+RoadGeometryCache::SourceId RoadGeometryCache::GetSourceId(std::string const & countryName,
+                                                           int64_t mwmVersion,
+                                                           VehicleType vehicleType,
+                                                           bool loadAltitudes)
+{
+  std::lock_guard<std::mutex> lock(m_sourcesMutex);
+  auto const it = m_sources.emplace(std::make_tuple(countryName, mwmVersion, vehicleType, loadAltitudes),
+                                    static_cast<SourceId>(m_sources.size())).first;
+  return it->second;
+}
+
+RoadGeometryCache::RoadPtr RoadGeometryCache::GetRoad(SourceId sourceId, uint32_t featureId,
+                                                      Loader const & loader)
+{
+  Key const key = {sourceId, featureId};
+  auto & shard = GetShard(key);
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    auto const it = shard.m_items.find(key);
+    if (it != shard.m_items.cend())
+    {
+      shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+      ++m_hitsCount;
+      return it->second.m_road;
+    }
+  }
+  ++m_missesCount;
+
+  // Feature decoding is the expensive part so it's done without the lock. Two threads may load
+  // the same road simultaneously, then the first inserted copy wins.
+  auto road = std::make_shared<RoadGeometry>();
+  loader(*road);
+  // The road is read from several threads, so the lazy distances cache is filled in advance.
+  road->GetRoadLengthM();
+
+  size_t const budget = m_shardBudget;
+  if (budget == 0)
+    return road;
+
+  size_t const memory = EstimateMemoryUsage(*road);
+
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  auto const [it, inserted] = shard.m_items.try_emplace(key);
+  if (!inserted)
+  {
+    shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+    return it->second.m_road;
+  }
+
+  shard.m_lru.push_front(key);
+  it->second.m_road = std::move(road);
+  it->second.m_memory = memory;
+  it->second.m_lruIt = shard.m_lru.begin();
+  shard.m_memory += memory;
+
+  RoadPtr result = it->second.m_road;
+  shard.Evict(budget);
+  return result;
+}
+
+void RoadGeometryCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.Evict(0 /* budget */);
+  }
+}
+
+size_t RoadGeometryCache::GetMemoryUsage() const
+{
+  size_t memory = 0;
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    memory += shard.m_memory;
+  }
+  return memory;
+}
+
+size_t RoadGeometryCache::GetRoadsCount() const
+{
+  size_t count = 0;
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    count += shard.m_items.size();
+  }
+  return count;
+}
+
+// static
+size_t RoadGeometryCache::EstimateMemoryUsage(RoadGeometry const & road)
+{
+  // Junctions and the distances cache, plus the item, the key and the hash table node overhead.
+  return sizeof(RoadGeometry) + sizeof(Shard::Item) + 2 * sizeof(Key) + 4 * sizeof(void *) +
+         road.GetPointsCount() * (sizeof(LatLonWithAltitude) + sizeof(double));
+}
+
+void RoadGeometryCache::Shard::Evict(size_t budget)
+{
+  while (m_memory > budget && !m_lru.empty())
+  {
+    auto const it = m_items.find(m_lru.back());
+    CHECK(it != m_items.end(), ());
+    m_memory -= it->second.m_memory;
+    m_items.erase(it);
+    m_lru.pop_back();
+  }
+}
+}  // namespace routing
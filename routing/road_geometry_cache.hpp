@@ -0,0 +1,114 @@
+#pragma once
+
+#include "routing/vehicle_mask.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace routing
+{
+class RoadGeometry;
+
+/// \brief Process-wide cache of road geometry which is shared by all routers working with
+/// the same mwm files: route rebuilds, several routers in one process, routes_builder workers.
+/// \note Items are kept in |kShardsCount| independent LRU shards with their own locks,
+/// so concurrent routers rarely wait for each other. Items are reference-counted:
+/// an evicted item stays alive while somebody holds it.
+/// \note Road geometry depends on the vehicle model, so the cache expects that all routers of
+/// the same vehicle type use the same vehicle model for the same mwm.
+class RoadGeometryCache
+{
+public:
+  using RoadPtr = std::shared_ptr<RoadGeometry const>;
+  using Loader = std::function<void(RoadGeometry & road)>;
+
+  /// Compact id of a road geometry source: mwm file, vehicle type and altitudes flag.
+  using SourceId = uint32_t;
+
+  /// |memoryBudgetBytes| is a limit of the estimated memory used by the cached roads.
+  /// Zero budget means the cache is disabled.
+  explicit RoadGeometryCache(size_t memoryBudgetBytes = 0);
+
+  static RoadGeometryCache & Instance();
+
+  void SetMemoryBudget(size_t memoryBudgetBytes);
+  bool IsEnabled() const { return m_shardBudget != 0; }
+
+  SourceId GetSourceId(std::string const & countryName, int64_t mwmVersion,
+                       VehicleType vehicleType, bool loadAltitudes);
+
+  /// \returns the road from the cache. If the road is not cached it's loaded by |loader|
+  /// without holding any locks and put to the cache.
+  RoadPtr GetRoad(SourceId sourceId, uint32_t featureId, Loader const & loader);
+
+  void Clear();
+
+  size_t GetMemoryUsage() const;
+  size_t GetRoadsCount() const;
+  /// Numbers of GetRoad() calls which found and didn't find the road in the cache.
+  uint64_t GetHitsCount() const { return m_hitsCount; }
+  uint64_t GetMissesCount() const { return m_missesCount; }
+
+  static size_t EstimateMemoryUsage(RoadGeometry const & road);
+
+private:
+  static size_t constexpr kShardsCount = 16;
+
+  struct Key
+  {
+    bool operator==(Key const & rhs) const
+    {
+      return m_sourceId == rhs.m_sourceId && m_featureId == rhs.m_featureId;
+    }
+
+    SourceId m_sourceId;
+    uint32_t m_featureId;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const
+    {
+      return std::hash<uint64_t>()((static_cast<uint64_t>(key.m_sourceId) << 32) | key.m_featureId);
+    }
+  };
+
+  struct Shard
+  {
+    struct Item
+    {
+      RoadPtr m_road;
+      size_t m_memory = 0;
+      std::list<Key>::iterator m_lruIt;
+    };
+
+    void Evict(size_t budget);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, Item, KeyHash> m_items;
+    // Most recently used keys are at the front.
+    std::list<Key> m_lru;
+    size_t m_memory = 0;
+  };
+
+  Shard & GetShard(Key const & key) { return m_shards[KeyHash()(key) % kShardsCount]; }
+
+  std::array<Shard, kShardsCount> m_shards;
+  std::atomic<size_t> m_shardBudget{0};
+  std::atomic<uint64_t> m_hitsCount{0};
+  std::atomic<uint64_t> m_missesCount{0};
+
+  std::mutex m_sourcesMutex;
+  std::map<std::tuple<std::string, int64_t, VehicleType, bool>, SourceId> m_sources;
+};
+}  // namespace routing
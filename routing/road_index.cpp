@@ -2,6 +2,9 @@
 
 #include "routing/routing_exceptions.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace routing
 {
 void RoadIndex::Import(std::vector<Joint> const & joints)
@@ -10,11 +13,52 @@ void RoadIndex::Import(std::vector<Joint> const & joints)
   {
     Joint const & joint = joints[jointId];
     for (uint32_t i = 0; i < joint.GetSize(); ++i)
+      PushFromSerializer(jointId, joint.GetEntry(i));
+  }
+}
+
+void RoadIndex::Build()
+{
+  std::sort(m_pendingJoints.begin(), m_pendingJoints.end(),
+            [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+
+  m_roads.clear();
+  m_jointIds.clear();
+
+  // Every road takes (its last joint point id + 1) items, so calculate the size at first.
+  size_t size = 0;
+  for (size_t i = 0; i < m_pendingJoints.size(); ++i)
+  {
+    auto const & rp = m_pendingJoints[i].first;
+    if (i + 1 == m_pendingJoints.size() ||
+        m_pendingJoints[i + 1].first.GetFeatureId() != rp.GetFeatureId())
     {
-      RoadPoint const & entry = joint.GetEntry(i);
-      RoadJointIds & roadJoints = m_roads[entry.GetFeatureId()];
-      roadJoints.AddJoint(entry.GetPointId(), jointId);
+      size += rp.GetPointId() + 1;
     }
   }
+
+  CHECK_LESS_OR_EQUAL(size, std::numeric_limits<uint32_t>::max(), ());
+  m_jointIds.reserve(size);
+
+  for (auto const & [rp, jointId] : m_pendingJoints)
+  {
+    ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
+
+    auto const [it, inserted] = m_roads.emplace(rp.GetFeatureId(), Range());
+    if (inserted)
+      it->second = {static_cast<uint32_t>(m_jointIds.size()), static_cast<uint32_t>(m_jointIds.size())};
+
+    auto & range = it->second;
+    uint32_t const end = range.m_begin + rp.GetPointId() + 1;
+    ASSERT_LESS(range.m_end, end, ("Duplicated joint of", rp));
+    m_jointIds.insert(m_jointIds.end(), end - range.m_end, Joint::kInvalidId);
+    range.m_end = end;
+    m_jointIds.back() = jointId;
+  }
+
+  CHECK_EQUAL(m_jointIds.size(), size, ());
+
+  m_pendingJoints.clear();
+  m_pendingJoints.shrink_to_fit();
 }
 }  // namespace routing
@@ -1,30 +1,30 @@
 #pragma once
 
 #include "routing/joint.hpp"
+#include "routing/road_point.hpp"
 
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 
+#include "3party/skarupke/bytell_hash_map.hpp"
+
 #include <algorithm>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace routing
 {
+// Joint ids of a road. It's a view of the joint ids which are kept by RoadIndex.
 class RoadJointIds final
 {
 public:
-  void Init(uint32_t maxPointId)
-  {
-    m_jointIds.clear();
-    m_jointIds.reserve(maxPointId + 1);
-  }
+  RoadJointIds() = default;
+  RoadJointIds(Joint::Id const * jointIds, uint32_t size) : m_jointIds(jointIds), m_size(size) {}
 
   Joint::Id GetJointId(uint32_t pointId) const
   {
-    if (pointId < m_jointIds.size())
+    if (pointId < m_size)
       return m_jointIds[pointId];
 
     return Joint::kInvalidId;
@@ -32,31 +32,20 @@ public:
 
   Joint::Id GetEndingJointId() const
   {
-    if (m_jointIds.empty())
+    if (m_size == 0)
       return Joint::kInvalidId;
 
-    ASSERT_NOT_EQUAL(m_jointIds.back(), Joint::kInvalidId, ());
-    return m_jointIds.back();
-  }
-
-  void AddJoint(uint32_t pointId, Joint::Id jointId)
-  {
-    ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
-
-    if (pointId >= m_jointIds.size())
-      m_jointIds.insert(m_jointIds.end(), pointId + 1 - m_jointIds.size(), Joint::kInvalidId);
-
-    ASSERT_EQUAL(m_jointIds[pointId], Joint::kInvalidId, ());
-    m_jointIds[pointId] = jointId;
+    ASSERT_NOT_EQUAL(m_jointIds[m_size - 1], Joint::kInvalidId, ());
+    return m_jointIds[m_size - 1];
   }
 
   uint32_t GetJointsNumber() const
   {
     uint32_t count = 0;
 
-    for (Joint::Id const jointId : m_jointIds)
+    for (uint32_t pointId = 0; pointId < m_size; ++pointId)
     {
-      if (jointId != Joint::kInvalidId)
+      if (m_jointIds[pointId] != Joint::kInvalidId)
         ++count;
     }
 
@@ -66,7 +55,7 @@ public:
   template <typename F>
   void ForEachJoint(F && f) const
   {
-    for (uint32_t pointId = 0; pointId < m_jointIds.size(); ++pointId)
+    for (uint32_t pointId = 0; pointId < m_size; ++pointId)
     {
       Joint::Id const jointId = m_jointIds[pointId];
       if (jointId != Joint::kInvalidId)
@@ -105,32 +94,35 @@ public:
 
 private:
   // Joint ids indexed by point id.
-  // If some point id doesn't match any joint id, this vector contains Joint::kInvalidId.
-  std::vector<Joint::Id> m_jointIds;
+  // If some point id doesn't match any joint id, it contains Joint::kInvalidId.
+  Joint::Id const * m_jointIds = nullptr;
+  uint32_t m_size = 0;
 };
 
+// RoadIndex contains mapping from feature id to joint ids of the feature points.
+//
+// Joint ids of all roads are kept in the single vector, so the roads don't need separate
+// allocations and the joints of a road are read from one contiguous block. Joints are added
+// with Import() or PushFromSerializer() and become available after Build().
 class RoadIndex final
 {
 public:
   void Import(std::vector<Joint> const & joints);
 
-  void AddJoint(RoadPoint const & rp, Joint::Id jointId)
+  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
+    m_pendingJoints.emplace_back(rp, jointId);
   }
 
+  void Build();
+
   bool IsRoad(uint32_t featureId) const { return m_roads.count(featureId) != 0; }
 
-  RoadJointIds const & GetRoad(uint32_t featureId) const
+  RoadJointIds GetRoad(uint32_t featureId) const
   {
     auto const & it = m_roads.find(featureId);
     CHECK(it != m_roads.cend(), ("Feature id:", featureId));
-    return it->second;
-  }
-
-  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
-  {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
+    return MakeRoad(it->second);
   }
 
   // Find nearest point with normal joint id.
@@ -148,18 +140,34 @@ public:
     if (it == m_roads.end())
       return Joint::kInvalidId;
 
-    return it->second.GetJointId(rp.GetPointId());
+    return MakeRoad(it->second).GetJointId(rp.GetPointId());
   }
 
   template <typename F>
   void ForEachRoad(F && f) const
   {
     for (auto const & it : m_roads)
-      f(it.first, it.second);
+      f(it.first, MakeRoad(it.second));
   }
 
 private:
-  // Map from feature id to RoadJointIds.
-  std::unordered_map<uint32_t, RoadJointIds> m_roads;
+  // Range of |m_jointIds| which belongs to a road.
+  struct Range
+  {
+    uint32_t m_begin = 0;
+    uint32_t m_end = 0;
+  };
+
+  RoadJointIds MakeRoad(Range const & range) const
+  {
+    ASSERT(m_pendingJoints.empty(), ("Build() has not been called."));
+    ASSERT_LESS_OR_EQUAL(range.m_end, m_jointIds.size(), ());
+    return RoadJointIds(m_jointIds.data() + range.m_begin, range.m_end - range.m_begin);
+  }
+
+  // Map from feature id to the range of joint ids of the feature.
+  ska::bytell_hash_map<uint32_t, Range> m_roads;
+  std::vector<Joint::Id> m_jointIds;
+  std::vector<std::pair<RoadPoint, Joint::Id>> m_pendingJoints;
 };
 }  // namespace routing
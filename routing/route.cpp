@@ -501,6 +501,34 @@ double Route::GetSegLenMeters(size_t segIdx) const
          (segIdx == 0 ? 0.0 : m_routeSegments[segIdx - 1].GetDistFromBeginningMeters());
 }
 
+void Route::FillSpeedCamerasOnRoute()
+{
+  m_speedCamerasOnRoute.clear();
+  for (size_t i = 1; i < m_routeSegments.size(); ++i)
+  {
+    auto const & speedCams = m_routeSegments[i].GetSpeedCams();
+    if (speedCams.empty())
+      continue;
+
+    auto const & prevSegment = m_routeSegments[i - 1];
+    auto const & startPoint = prevSegment.GetJunction().GetPoint();
+    auto const direction = m_routeSegments[i].GetJunction().GetPoint() - startPoint;
+    double const segmentLength = GetSegLenMeters(i);
+
+    for (auto const & speedCam : speedCams)
+    {
+      m_speedCamerasOnRoute.emplace_back(
+          prevSegment.GetDistFromBeginningMeters() + segmentLength * speedCam.m_coef,
+          speedCam.m_maxSpeedKmPH, startPoint + direction * speedCam.m_coef);
+    }
+  }
+
+  stable_sort(m_speedCamerasOnRoute.begin(), m_speedCamerasOnRoute.end(),
+              [](SpeedCameraOnRoute const & lhs, SpeedCameraOnRoute const & rhs) {
+                return lhs.m_distFromBeginMeters < rhs.m_distFromBeginMeters;
+              });
+}
+
 void Route::SetMwmsPartlyProhibitedForSpeedCams(vector<platform::CountryFile> && mwms)
 {
   m_speedCamPartlyProhibitedMwms = std::move(mwms);
@@ -3,6 +3,7 @@
 #include "routing/routing_options.hpp"
 #include "routing/routing_settings.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_camera.hpp"
 #include "routing/transit_info.hpp"
 #include "routing/turns.hpp"
 
@@ -428,6 +429,15 @@ public:
   /// \returns Length of the route segment with |segIdx| in meters.
   double GetSegLenMeters(size_t segIdx) const;
 
+  /// \brief Collects speed cameras of the route segments sorted by the distance from the beginning
+  /// of the route. It should be called on the routing thread after speed camera info is set to
+  /// the segments, so navigation only moves a cursor over the cameras.
+  void FillSpeedCamerasOnRoute();
+  std::vector<SpeedCameraOnRoute> const & GetSpeedCamerasOnRoute() const
+  {
+    return m_speedCamerasOnRoute;
+  }
+
   void SetMwmsPartlyProhibitedForSpeedCams(std::vector<platform::CountryFile> && mwms);
 
   /// \returns true if the route crosses at least one mwm where there are restrictions on warning
@@ -469,6 +479,7 @@ private:
 
   // Mwms which are crossed by the route where speed cameras are prohibited.
   std::vector<platform::CountryFile> m_speedCamPartlyProhibitedMwms;
+  std::vector<SpeedCameraOnRoute> m_speedCamerasOnRoute;
 };
 
 /// \returns true if |turn| is not equal to turns::CarDirection::None or
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace routing
+{
+/// \brief Time spent on phases of a route building and the number of vertices visited by A*.
+/// \note Loading of index graphs takes place inside the other phases, so |m_graphLoadingMs|
+/// is a part of their times.
+struct RouteBuildingStats
+{
+  double m_snappingMs = 0.0;
+  double m_graphLoadingMs = 0.0;
+  // A* in Joints and NoLeaps modes.
+  double m_searchMs = 0.0;
+  // A* over leaps and calculation of routes through mwms between leaps in LeapsOnly mode.
+  double m_leapsMs = 0.0;
+  double m_crossMwmMs = 0.0;
+  // Turns generation and filling of route segments.
+  double m_directionsMs = 0.0;
+  double m_totalMs = 0.0;
+  uint64_t m_visitedVertices = 0;
+};
+}  // namespace routing
@@ -82,6 +82,11 @@ public:
 
   virtual bool FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction,
                                            double radius, EdgeProj & proj) = 0;
+
+  /// Loads and keeps the data which is needed to build routes near |point| in advance,
+  /// so the first route there is as fast as the next ones.
+  /// It's called in the same thread as CalculateRoute().
+  virtual void WarmUp(m2::PointD const & /* point */) {}
 };
 
 }  // namespace routing
@@ -28,6 +28,12 @@ void RouterDelegate::OnPointCheck(ms::LatLon const & point) const
     m_pointCallback(point);
 }
 
+void RouterDelegate::OnEarlyRoute(Route const & route) const
+{
+  if (m_earlyRouteCallback && !m_cancellable.IsCancelled())
+    m_earlyRouteCallback(route);
+}
+
 void RouterDelegate::SetProgressCallback(ProgressCallback const & progressCallback)
 {
   m_progressCallback = progressCallback ? progressCallback : DefaultProgressFn;
@@ -38,6 +44,11 @@ void RouterDelegate::SetPointCheckCallback(PointCheckCallback const & pointCallb
   m_pointCallback = pointCallback ? pointCallback : DefaultPointFn;
 }
 
+void RouterDelegate::SetEarlyRouteCallback(RouteCallback const & earlyRouteCallback)
+{
+  m_earlyRouteCallback = earlyRouteCallback;
+}
+
 void RouterDelegate::SetTimeout(uint32_t timeoutSec)
 {
   if (timeoutSec == kNoTimeout)
@@ -21,9 +21,14 @@ public:
   /// Set routing progress. Waits current progress status from 0 to 100.
   void OnProgress(float progress) const;
   void OnPointCheck(ms::LatLon const & point) const;
+  /// Hands over a route which has turns only for its beginning. It's called before
+  /// the router finishes the route, so the driver may get guidance earlier.
+  void OnEarlyRoute(Route const & route) const;
+  bool HasEarlyRouteCallback() const { return m_earlyRouteCallback != nullptr; }
 
   void SetProgressCallback(ProgressCallback const & progressCallback);
   void SetPointCheckCallback(PointCheckCallback const & pointCallback);
+  void SetEarlyRouteCallback(RouteCallback const & earlyRouteCallback);
 
   void SetTimeout(uint32_t timeoutSec);
 
@@ -35,6 +40,7 @@ public:
 private:
   ProgressCallback m_progressCallback;
   PointCheckCallback m_pointCallback;
+  RouteCallback m_earlyRouteCallback;
 
   base::Cancellable m_cancellable;
 };
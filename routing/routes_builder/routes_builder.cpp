@@ -1,5 +1,6 @@
 #include "routing/routes_builder/routes_builder.hpp"
 
+#include "routing/road_geometry_cache.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "storage/routing_helpers.hpp"
@@ -21,6 +22,9 @@
 
 namespace
 {
+// All workers build routes over the same mwms, so decoded road geometry is shared between them.
+size_t constexpr kSharedRoadGeometryCacheBytes = 1024 * 1024 * 1024;
+
 void DumpPointDVector(std::vector<m2::PointD> const & points, FileWriter & writer)
 {
   WriteToSink(writer, points.size());
@@ -98,6 +102,7 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
   CHECK(m_cig, ());
   CHECK(m_cpg, ());
 
+  RoadGeometryCache::Instance().SetMemoryBudget(kSharedRoadGeometryCacheBytes);
   classificator::Load();
   std::vector<platform::LocalCountryFile> localFiles;
   platform::FindAllLocalMapsAndCleanup(std::numeric_limits<int64_t>::max(), localFiles);
@@ -132,20 +137,43 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
 
 RoutesBuilder::Result RoutesBuilder::ProcessTask(Params const & params)
 {
-  Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
-  return processor(params);
+  auto processor = GetProcessor();
+  SCOPE_GUARD(returnProcessor, [&]() { PushProcessor(std::move(processor)); });
+  return (*processor)(params);
 }
 
 std::future<RoutesBuilder::Result> RoutesBuilder::ProcessTaskAsync(Params const & params)
 {
   // Should be copyable to workaround MSVC bug (https://developercommunity.visualstudio.com/t/108672)
-  auto task = [processor = std::make_shared<Processor>(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig)](Params const & params) -> Result
+  auto task = [this](Params const & params) -> Result
   {
-      return (*processor)(params);
+      return ProcessTask(params);
   };
   return m_threadPool.Submit(std::move(task), params);
 }
 
+std::unique_ptr<RoutesBuilder::Processor> RoutesBuilder::GetProcessor()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_processorsMutex);
+    if (!m_freeProcessors.empty())
+    {
+      auto processor = std::move(m_freeProcessors.back());
+      m_freeProcessors.pop_back();
+      return processor;
+    }
+  }
+
+  return std::make_unique<Processor>(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
+}
+
+void RoutesBuilder::PushProcessor(std::unique_ptr<Processor> && processor)
+{
+  std::lock_guard<std::mutex> lock(m_processorsMutex);
+  // The last used processor is taken first, its caches are the warmest ones.
+  m_freeProcessors.emplace_back(std::move(processor));
+}
+
 // RoutesBuilder::Result ---------------------------------------------------------------------------
 
 // static
@@ -290,9 +318,6 @@ RoutesBuilder::Result
 RoutesBuilder::Processor::operator()(Params const & params)
 {
   InitRouter(params.m_type);
-  SCOPE_GUARD(returnDataSource, [&]() {
-    m_dataSourceStorage.PushDataSource(std::move(m_dataSource));
-  });
 
   LOG(LINFO, ("Start building route, checkpoints:", params.m_checkpoints));
 
@@ -301,6 +326,7 @@ RoutesBuilder::Processor::operator()(Params const & params)
 
   CHECK(m_dataSource, ());
 
+  Result result;
   double timeSum = 0.0;
   for (size_t i = 0; i < params.m_launchesNumber; ++i)
   {
@@ -313,9 +339,9 @@ RoutesBuilder::Processor::operator()(Params const & params)
       break;
 
     timeSum += timer.ElapsedSeconds();
+    result.m_stats.push_back(m_router->GetStats());
   }
 
-  Result result;
   result.m_params.m_checkpoints = params.m_checkpoints;
   result.m_code = resultCode;
   result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
@@ -4,6 +4,7 @@
 
 #include "routing/checkpoints.hpp"
 #include "routing/index_router.hpp"
+#include "routing/route_building_stats.hpp"
 #include "routing/router_delegate.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segment.hpp"
@@ -32,6 +33,7 @@
 #include <cstddef>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -93,8 +95,12 @@ public:
     Params m_params;
     std::vector<Route> m_routes;
     double m_buildTimeSeconds = 0.0;
+    // Stats of each launch. They are not dumped.
+    std::vector<RouteBuildingStats> m_stats;
   };
 
+  /// \note Tasks are processed by routers which are kept between tasks with their caches,
+  /// so tasks with close checkpoints should go one after another.
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
@@ -118,6 +124,8 @@ private:
     ms::LatLon m_start;
     ms::LatLon m_finish;
 
+    // Declared before |m_router|, so it's destroyed after the router.
+    std::unique_ptr<FrozenDataSource> m_dataSource;
     std::unique_ptr<IndexRouter> m_router;
     std::shared_ptr<RouterDelegate> m_delegate = std::make_shared<RouterDelegate>();
 
@@ -126,9 +134,17 @@ private:
     DataSourceStorage & m_dataSourceStorage;
     std::weak_ptr<storage::CountryParentGetter> m_cpg;
     std::weak_ptr<storage::CountryInfoGetter> m_cig;
-    std::unique_ptr<FrozenDataSource> m_dataSource;
   };
 
+  std::unique_ptr<Processor> GetProcessor();
+  void PushProcessor(std::unique_ptr<Processor> && processor);
+
+  // Processors which aren't busy with a task. A processor keeps its data source and router,
+  // so graphs and caches of the router survive between tasks. Their number doesn't exceed
+  // the number of the tasks processed at once.
+  std::mutex m_processorsMutex;
+  std::vector<std::unique_ptr<Processor>> m_freeProcessors;
+
   base::thread_pool::computational::ThreadPool m_threadPool;
 
   std::shared_ptr<storage::CountryParentGetter> m_cpg =
@@ -41,6 +41,8 @@ DEFINE_bool(verbose, false, "Verbose logging (default: false)");
 
 DEFINE_int32(launches_number, 1, "Number of launches of routes buildings. Needs for benchmarking (default: 1)");
 DEFINE_string(vehicle_type, "car", "Vehicle type: car|pedestrian|bicycle|transit. (Only for mapsme).");
+DEFINE_string(benchmark_output, "", "Path to a json file where latency percentiles of route building phases, "
+                                    "peak RSS and cache hit rates will be saved. (Only for mapsme).");
 
 using namespace routing;
 using namespace routes_builder;
@@ -108,7 +110,7 @@ int Main(int argc, char ** argv)
     }
 
     BuildRoutes(FLAGS_routes_file, FLAGS_dump_path, FLAGS_start_from, FLAGS_threads, FLAGS_timeout,
-                FLAGS_vehicle_type, FLAGS_verbose, launchesNumber);
+                FLAGS_vehicle_type, FLAGS_verbose, launchesNumber, FLAGS_benchmark_output);
   }
 
   if (IsApiBuild())
@@ -122,6 +124,10 @@ int Main(int argc, char ** argv)
 
 int main(int argc, char ** argv)
 {
+  // Routes are built by many threads which log a lot with --verbose, so messages are written to
+  // the console by a background thread.
+  base::SetLogMessageFn(&base::LogMessageAsync);
+
   try
   {
     Main(argc, argv);
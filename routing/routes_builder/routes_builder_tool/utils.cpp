@@ -4,6 +4,8 @@
 #include "routing/routing_quality/api/mapbox/mapbox_api.hpp"
 
 #include "routing/checkpoints.hpp"
+#include "routing/road_geometry_cache.hpp"
+#include "routing/route_building_stats.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "platform/platform.hpp"
@@ -16,15 +18,25 @@
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include "std/target_os.hpp"
+
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
 #include <future>
+#include <iomanip>
 #include <iostream>
 #include <optional>
 #include <thread>
 #include <tuple>
+#include <utility>
 
+#if !defined(OMIM_OS_WINDOWS)
+#include <sys/resource.h>
+#endif
 
 namespace routing
 {
@@ -61,6 +73,108 @@ routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
   CHECK(false, ("Unknown vehicle type:", str));
   UNREACHABLE();
 }
+
+uint64_t GetPeakRssBytes()
+{
+#if defined(OMIM_OS_WINDOWS)
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // Linux reports kilobytes.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// Writes mean, max and percentiles of |values| as a json object.
+void WriteDistribution(std::vector<double> values, std::ostream & out)
+{
+  out << "{";
+  if (!values.empty())
+  {
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double const v : values)
+      sum += v;
+
+    // Nearest-rank percentile.
+    auto const percentile = [&values](double p)
+    {
+      auto const rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+      return values[std::max(rank, size_t{1}) - 1];
+    };
+
+    out << "\"mean\": " << sum / values.size() << ", \"p50\": " << percentile(50)
+        << ", \"p90\": " << percentile(90) << ", \"p99\": " << percentile(99)
+        << ", \"max\": " << values.back();
+  }
+  out << "}";
+}
+
+void DumpBenchmark(std::vector<RouteBuildingStats> const & stats, size_t routesNumber,
+                   size_t failedNumber, std::string const & path)
+{
+  using Getter = std::function<double(RouteBuildingStats const &)>;
+  std::vector<std::pair<std::string, Getter>> const phases = {
+      {"total_ms", [](auto const & s) { return s.m_totalMs; }},
+      {"snapping_ms", [](auto const & s) { return s.m_snappingMs; }},
+      {"graph_loading_ms", [](auto const & s) { return s.m_graphLoadingMs; }},
+      {"search_ms", [](auto const & s) { return s.m_searchMs; }},
+      {"leaps_ms", [](auto const & s) { return s.m_leapsMs; }},
+      {"cross_mwm_ms", [](auto const & s) { return s.m_crossMwmMs; }},
+      {"directions_ms", [](auto const & s) { return s.m_directionsMs; }},
+      {"visited_vertices", [](auto const & s) { return static_cast<double>(s.m_visitedVertices); }}};
+
+  auto const & cache = RoadGeometryCache::Instance();
+  uint64_t const hits = cache.GetHitsCount();
+  uint64_t const requests = hits + cache.GetMissesCount();
+
+  std::ofstream out(path);
+  CHECK(out.good(), ("Error during opening:", path));
+  out << std::fixed << std::setprecision(3);
+  out << "{\n";
+  out << "  \"routes\": " << routesNumber << ",\n";
+  out << "  \"failed_routes\": " << failedNumber << ",\n";
+  out << "  \"launches\": " << stats.size() << ",\n";
+  for (auto const & [name, getter] : phases)
+  {
+    std::vector<double> values;
+    values.reserve(stats.size());
+    for (auto const & s : stats)
+      values.push_back(getter(s));
+
+    out << "  \"" << name << "\": ";
+    WriteDistribution(std::move(values), out);
+    out << ",\n";
+  }
+  out << "  \"peak_rss_bytes\": " << GetPeakRssBytes() << ",\n";
+  out << "  \"road_geometry_cache\": {\"hits\": " << hits << ", \"misses\": " << requests - hits
+      << ", \"hit_rate\": " << (requests == 0 ? 0.0 : static_cast<double>(hits) / requests) << "}\n";
+  out << "}\n";
+
+  LOG_FORCE(LINFO, ("Benchmark results are saved to:", path));
+}
+
+// Size of the cells which routes are grouped by.
+double constexpr kBatchCellSizeDeg = 1.0;
+
+int32_t GetBatchCell(double coordDeg)
+{
+  return static_cast<int32_t>(std::floor(coordDeg / kBatchCellSizeDeg));
+}
+
+// Routes are built in the order of the cells of their start and finish points. So routes which
+// go one after another to the same worker are close and reuse graphs and caches of its router.
+std::array<int32_t, 4> GetBatchKey(ms::LatLon const & start, ms::LatLon const & finish)
+{
+  return {GetBatchCell(start.m_lat), GetBatchCell(start.m_lon),
+          GetBatchCell(finish.m_lat), GetBatchCell(finish.m_lon)};
+}
 }  // namespace
 
 void BuildRoutes(std::string const & routesPath,
@@ -70,7 +184,8 @@ void BuildRoutes(std::string const & routesPath,
                  uint32_t timeoutPerRouteSeconds,
                  std::string const & vehicleTypeStr,
                  bool verbose,
-                 uint32_t launchesNumber)
+                 uint32_t launchesNumber,
+                 std::string const & benchmarkPath)
 {
   CHECK(Platform::IsFileExistsByFullPath(routesPath), ("Can not find file:", routesPath));
   CHECK(!dumpPath.empty(), ("Empty dumpPath."));
@@ -97,6 +212,7 @@ void BuildRoutes(std::string const & routesPath,
     params.m_launchesNumber = launchesNumber;
 
     base::ScopedLogLevelChanger changer(verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+    std::vector<std::pair<ms::LatLon, ms::LatLon>> routes;
     ms::LatLon start;
     ms::LatLon finish;
     size_t startFromCopy = startFrom;
@@ -108,8 +224,23 @@ void BuildRoutes(std::string const & routesPath,
         continue;
       }
 
-      auto const startPoint = mercator::FromLatLon(start);
-      auto const finishPoint = mercator::FromLatLon(finish);
+      routes.emplace_back(start, finish);
+    }
+
+    // Indexes of |routes| in the order of building.
+    std::vector<size_t> order(routes.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&routes](size_t lhs, size_t rhs)
+    {
+      return GetBatchKey(routes[lhs].first, routes[lhs].second) <
+             GetBatchKey(routes[rhs].first, routes[rhs].second);
+    });
+
+    for (size_t const idx : order)
+    {
+      auto const startPoint = mercator::FromLatLon(routes[idx].first);
+      auto const finishPoint = mercator::FromLatLon(routes[idx].second);
 
       params.m_checkpoints = Checkpoints(std::vector<m2::PointD>({startPoint, finishPoint}));
       tasks.emplace_back(routesBuilder.ProcessTaskAsync(params));
@@ -117,15 +248,25 @@ void BuildRoutes(std::string const & routesPath,
 
     LOG_FORCE(LINFO, ("Created:", tasks.size(), "tasks, vehicle type:", vehicleType));
     base::Timer timer;
+    std::vector<RouteBuildingStats> stats;
+    size_t failedNumber = 0;
     for (size_t i = 0; i < tasks.size(); ++i)
     {
-      size_t shiftIndex = i + startFrom;
+      size_t const shiftIndex = order[i] + startFrom;
       auto & task = tasks[i];
       task.wait();
 
       auto const result = task.get();
       if (result.m_code == RouterResultCode::Cancelled)
-        LOG_FORCE(LINFO, ("Route:", i, "(", i + 1, "line of file) was building too long."));
+      {
+        LOG_FORCE(LINFO, ("Route:", shiftIndex, "(", shiftIndex + 1,
+                          "line of file) was building too long."));
+      }
+
+      if (result.IsCodeOK())
+        stats.insert(stats.end(), result.m_stats.cbegin(), result.m_stats.cend());
+      else
+        ++failedNumber;
 
       std::string const fullPath =
           base::JoinPath(dumpPath, std::to_string(shiftIndex) + RoutesBuilder::Result::kDumpExtension);
@@ -133,15 +274,18 @@ void BuildRoutes(std::string const & routesPath,
       RoutesBuilder::Result::Dump(result, fullPath);
 
       double const curPercent =
-          static_cast<double>(shiftIndex + 1) / (tasks.size() + startFrom) * 100.0;
+          static_cast<double>(i + 1 + startFrom) / (tasks.size() + startFrom) * 100.0;
 
-      if (curPercent - lastPercent > 1.0 || shiftIndex + 1 == tasks.size())
+      if (curPercent - lastPercent > 1.0 || i + 1 == tasks.size())
       {
         lastPercent = curPercent;
         LOG_FORCE(LINFO, ("Progress:", lastPercent, "%"));
       }
     }
     LOG_FORCE(LINFO, ("BuildRoutes() took:", timer.ElapsedSeconds(), "seconds."));
+
+    if (!benchmarkPath.empty())
+      DumpBenchmark(stats, tasks.size(), failedNumber, benchmarkPath);
   }
 }
 
@@ -20,7 +20,8 @@ void BuildRoutes(std::string const & routesPath,
                  uint32_t timeoutPerRouteSeconds,
                  std::string const & vehicleType,
                  bool verbose,
-                 uint32_t launchesNumber);
+                 uint32_t launchesNumber,
+                 std::string const & benchmarkPath);
 
 void BuildRoutesWithApi(std::unique_ptr<routing_quality::api::RoutingApi> routingApi,
                         std::string const & routesPath,
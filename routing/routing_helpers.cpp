@@ -10,9 +10,11 @@
 
 #include "geometry/point2d.hpp"
 
+#include "base/math.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace routing
@@ -169,6 +171,39 @@ bool CheckGraphConnectivity(Segment const & start, bool isOutgoing, bool useRout
   return marked.size() >= limit;
 }
 
+vector<m2::PointD> MakeStarShapedHull(m2::PointD const & center, vector<m2::PointD> const & points,
+                                      size_t sectorsCount)
+{
+  CHECK_GREATER(sectorsCount, 0, ());
+
+  vector<double> squaredDistances(sectorsCount, 0.0);
+  vector<m2::PointD> farthestPoints(sectorsCount, center);
+  for (auto const & point : points)
+  {
+    auto const v = point - center;
+    double const squaredDistance = v.SquaredLength();
+    if (squaredDistance == 0.0)
+      continue;
+
+    double const angle = atan2(v.y, v.x) + math::pi;
+    auto const sector = min(static_cast<size_t>(angle / (2.0 * math::pi) * sectorsCount),
+                            sectorsCount - 1);
+    if (squaredDistance > squaredDistances[sector])
+    {
+      squaredDistances[sector] = squaredDistance;
+      farthestPoints[sector] = point;
+    }
+  }
+
+  vector<m2::PointD> hull;
+  for (size_t i = 0; i < sectorsCount; ++i)
+  {
+    if (squaredDistances[i] > 0.0)
+      hull.push_back(farthestPoints[i]);
+  }
+  return hull;
+}
+
 // AStarLengthChecker ------------------------------------------------------------------------------
 
 AStarLengthChecker::AStarLengthChecker(IndexGraphStarter & starter) : m_starter(starter) {}
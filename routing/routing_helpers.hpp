@@ -84,6 +84,13 @@ bool CheckGraphConnectivity(Segment const & start, bool isOutgoing,
                             bool useRoutingOptions, size_t limit, WorldGraph & graph,
                             std::set<Segment> & marked);
 
+/// \brief Builds a star-shaped polygon around |center| which contains |points|. The plane is split
+/// into |sectorsCount| equal angular sectors around |center| and the farthest point of every
+/// nonempty sector becomes a vertex of the polygon. Vertices go counterclockwise.
+std::vector<m2::PointD> MakeStarShapedHull(m2::PointD const & center,
+                                           std::vector<m2::PointD> const & points,
+                                           size_t sectorsCount);
+
 struct AStarLengthChecker
 {
   explicit AStarLengthChecker(IndexGraphStarter & starter);
@@ -288,6 +288,26 @@ UNIT_CLASS_TEST(TestAbsentRegionsFinder, Germany_Cologne_Croatia_Zagreb)
   TEST(rgns.count("Austria_Styria_Graz") > 0, ());
 }
 
+// The second request between the same regions is served from the subroutes cache.
+UNIT_CLASS_TEST(TestAbsentRegionsFinder, CachedSubroutes)
+{
+  AbsentRegionsFinder finder(m_countryFileGetter, m_localFileChecker, m_numMwmIds,
+                             m_callbacks.m_dataSourceGetter());
+  RouterDelegate delegate;
+
+  std::set<std::string> const planRegions{"Thailand_South", "Cambodia"};
+  for (auto const & checkpoints :
+       {Checkpoints(mercator::FromLatLon(7.89, 98.30), mercator::FromLatLon(11.56, 104.86)),
+        Checkpoints(mercator::FromLatLon(7.88, 98.39), mercator::FromLatLon(11.55, 104.92))})
+  {
+    finder.GenerateAbsentRegions(checkpoints, delegate);
+
+    std::set<std::string> regions;
+    finder.GetAllRegions(regions);
+    TEST_EQUAL(regions, planRegions, ());
+  }
+}
+
 UNIT_CLASS_TEST(TestAbsentRegionsFinder, Russia_SPB_Pechory)
 {
   Checkpoints const checkpoints{mercator::FromLatLon(59.9387323, 30.3162295),
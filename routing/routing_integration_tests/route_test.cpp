@@ -1,5 +1,7 @@
 #include "testing/testing.hpp"
 
+#include "routing/index_router.hpp"
+#include "routing/router_delegate.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/routing_options.hpp"
 
@@ -8,6 +10,7 @@
 #include "geometry/mercator.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace route_test
 {
@@ -985,4 +988,59 @@ UNIT_TEST(Spain_NoMaxSpeeds_KeepTrunk_NotTrunkLink)
                                    FromLatLon(43.3685773, -3.42580007), 1116.79);
 }
 
+UNIT_TEST(Moscow_MatrixAgreesWithRoutes)
+{
+  std::vector<m2::PointD> const points = {
+      FromLatLon(55.75100, 37.61790), FromLatLon(55.66216, 37.63259), FromLatLon(55.77398, 37.68469)};
+
+  auto & components = GetVehicleComponents(VehicleType::Car);
+  auto & router = dynamic_cast<IndexRouter &>(components.GetRouter());
+
+  RouterDelegate delegate;
+  IndexRouter::Matrix matrix;
+  TEST_EQUAL(router.CalculateMatrix(points, points, delegate, matrix), RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.size(), points.size(), ());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(matrix[i].size(), points.size(), ());
+    for (size_t j = 0; j < points.size(); ++j)
+    {
+      auto const & item = matrix[i][j];
+      TEST_EQUAL(item.m_code, RouterResultCode::NoError, (i, j));
+      if (i == j)
+      {
+        TEST_LESS(item.m_distanceMeters, 100.0, (i));
+        continue;
+      }
+
+      auto const [route, code] = CalculateRoute(components, points[i], {0., 0.}, points[j]);
+      TEST_EQUAL(code, RouterResultCode::NoError, (i, j));
+      TestRouteLength(*route, item.m_distanceMeters, 0.1 /* relativeError */);
+      TestRouteTime(*route, item.m_timeSec, 0.1 /* relativeError */);
+    }
+  }
+}
+
+UNIT_TEST(Moscow_Isochrone)
+{
+  auto & router = dynamic_cast<IndexRouter &>(GetVehicleComponents(VehicleType::Car).GetRouter());
+  m2::PointD const start = FromLatLon(55.75100, 37.61790);
+
+  RouterDelegate delegate;
+  IndexRouter::Isochrone small;
+  TEST_EQUAL(router.CalculateIsochrone(start, 5 * 60 /* maxTimeSec */, delegate, small),
+             RouterResultCode::NoError, ());
+  IndexRouter::Isochrone big;
+  TEST_EQUAL(router.CalculateIsochrone(start, 15 * 60 /* maxTimeSec */, delegate, big),
+             RouterResultCode::NoError, ());
+
+  TEST(!small.m_segments.empty(), ());
+  TEST_GREATER(big.m_segments.size(), small.m_segments.size(), ());
+  TEST_GREATER(small.m_polygon.size(), 2, ());
+
+  // 15 minutes by car in the city are definitely less than 30 km.
+  for (auto const & point : big.m_polygon)
+    TEST_LESS(mercator::DistanceOnEarth(start, point), 30000.0, (mercator::ToLatLon(point)));
+}
 } // namespace route_test
@@ -335,6 +335,22 @@ SessionState RoutingSession::OnLocationPositionChanged(GpsInfo const & info)
   return m_state;
 }
 
+SessionState RoutingSession::OnLocationPositionsChanged(std::vector<GpsInfo> const & infos)
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+
+  for (auto const & info : infos)
+  {
+    if (m_state == SessionState::RouteFinished || m_state == SessionState::RouteBuilding ||
+        m_state == SessionState::RouteNoFollowing || m_state == SessionState::NoValidRoute)
+    {
+      break;
+    }
+    OnLocationPositionChanged(info);
+  }
+  return m_state;
+}
+
 // For next street returns "[ref] name" .
 // For highway exits (or main roads with exit info) returns "[junction:ref]: [target:ref] > target".
 // If no |target| - it will be replaced by |name| of next street.
@@ -540,6 +556,13 @@ void RoutingSession::SetRouter(std::unique_ptr<IRouter> && router,
   m_router->SetRouter(std::move(router), std::move(finder));
 }
 
+void RoutingSession::WarmUpRouter(m2::PointD const & point)
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  ASSERT(m_router != nullptr, ());
+  m_router->WarmUp(point);
+}
+
 void RoutingSession::MatchLocationToRoadGraph(location::GpsInfo & location)
 {
   auto const locationMerc = mercator::FromLatLon(location.m_latitude, location.m_longitude);
@@ -836,15 +859,8 @@ void RoutingSession::OnTrafficInfoClear()
 
 void RoutingSession::OnTrafficInfoAdded(TrafficInfo && info)
 {
-  TrafficInfo::Coloring const & fullColoring = info.GetColoring();
-  auto coloring = std::make_shared<TrafficInfo::Coloring>();
-  for (auto const & kv : fullColoring)
-  {
-    ASSERT_NOT_EQUAL(kv.second, SpeedGroup::Unknown, ());
-    coloring->insert(kv);
-  }
-
-  // Note. |coloring| should not be used after this call on gui thread.
+  // The coloring is immutable and is shared with the renderer.
+  std::shared_ptr<TrafficInfo::PackedColoring const> coloring = info.GetSharedColoring();
   auto const mwmId = info.GetMwmId();
   GetPlatform().RunTask(Platform::Thread::Gui, [this, mwmId, coloring]() {
     Set(mwmId, coloring);
@@ -32,6 +32,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace location
 {
@@ -54,6 +55,8 @@ public:
 
   void SetRouter(std::unique_ptr<IRouter> && router,
                  std::unique_ptr<AbsentRegionsFinder> && finder);
+  /// Loads routing data near |point| in background. See IRouter::WarmUp().
+  void WarmUpRouter(m2::PointD const & point);
 
   /// @param[in] checkpoints in mercator
   /// @param[in] timeoutSec timeout in seconds, if zero then there is no timeout
@@ -99,6 +102,12 @@ public:
   bool GetRouteJunctionPoints(std::vector<m2::PointD> & routeJunctionPoints) const;
 
   SessionState OnLocationPositionChanged(location::GpsInfo const & info);
+  /// \brief Processes a chunk of fixes in order, e.g. a recorded drive or fixes collected while
+  /// the position was unavailable. The result is the same as of the sequential calls of
+  /// OnLocationPositionChanged(), but the fixes after the route is finished or stops being
+  /// followed are skipped.
+  /// \returns the state after the last processed fix.
+  SessionState OnLocationPositionsChanged(std::vector<location::GpsInfo> const & infos);
   void GetRouteFollowingInfo(FollowingInfo & info) const;
 
   bool MatchLocationToRoute(location::GpsInfo & location,
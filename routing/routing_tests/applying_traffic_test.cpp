@@ -105,7 +105,7 @@ public:
     m_estimator = CreateEstimatorForCar(m_trafficStash);
   }
 
-  void SetTrafficColoring(shared_ptr<TrafficInfo::Coloring const> coloring)
+  void SetTrafficColoring(shared_ptr<TrafficInfo::PackedColoring const> coloring)
   {
     m_trafficStash->SetColoring(kTestNumMwmId, coloring);
   }
@@ -142,7 +142,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_G0onF3)
   TrafficInfo::Coloring const coloring = {
       {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
        SpeedGroup::G0}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloring));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloring));
 
   unique_ptr<WorldGraph> graph = BuildXXGraph(GetEstimator());
   auto const start =
@@ -159,7 +159,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_TempBlockonF3)
   TrafficInfo::Coloring const coloring = {
       {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
        SpeedGroup::TempBlock}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloring));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloring));
 
   unique_ptr<WorldGraph> graph = BuildXXGraph(GetEstimator());
   auto const start =
@@ -176,7 +176,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_G0onF3ReverseDir)
   TrafficInfo::Coloring const coloring = {
       {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kReverseDirection},
        SpeedGroup::G0}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloring));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloring));
 
   unique_ptr<WorldGraph> graph = BuildXXGraph(GetEstimator());
   auto const start =
@@ -199,7 +199,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_G0onF3andF6andG4onF8andF4)
        SpeedGroup::G4},
       {{7 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
        SpeedGroup::G4}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloring));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloring));
 
   unique_ptr<WorldGraph> graph = BuildXXGraph(GetEstimator());
   auto const start =
@@ -230,7 +230,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_ChangingTraffic)
   TrafficInfo::Coloring const coloringHeavyF3 = {
       {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
        SpeedGroup::G0}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloringHeavyF3));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloringHeavyF3));
   {
     vector<m2::PointD> const heavyF3Geom = {{2 /* x */, -1 /* y */}, {2, 0}, {3, 0}, {3, 1}, {2, 2}, {3, 3}};
     TestRouteGeometry(*starter, Algorithm::Result::OK, heavyF3Geom);
@@ -248,7 +248,7 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_ChangingTraffic)
        SpeedGroup::G3},
       {{8 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
        SpeedGroup::G3}};
-  SetTrafficColoring(make_shared<TrafficInfo::Coloring const>(coloringMiddleF1F3F4F7F8));
+  SetTrafficColoring(make_shared<TrafficInfo::PackedColoring const>(coloringMiddleF1F3F4F7F8));
   {
     TestRouteGeometry(*starter, Algorithm::Result::OK, noTrafficGeom);
   }
@@ -34,6 +34,11 @@ void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute,
   TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
+
+  actualRoute.m_path.clear();
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectionalParallel(params, actualRoute), ());
+  TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 }
 
 UNIT_TEST(AStarAlgorithm_Sample)
@@ -78,6 +83,80 @@ UNIT_TEST(AStarAlgorithm_CheckLength)
   result = algo.FindPathBidirectional(params, routingResult);
   // Best route weight is 23 so we expect to find no route with restriction |weight < 23|.
   TEST_EQUAL(result, Algorithm::Result::NoPath, ());
+
+  routingResult = {};
+  result = algo.FindPathBidirectionalParallel(params, routingResult);
+  TEST_EQUAL(result, Algorithm::Result::NoPath, ());
+}
+
+UNIT_TEST(AStarAlgorithm_BidirectionalParallelGrid)
+{
+  // Grid |kSize| x |kSize| with several heavy edges, so there are many paths of close lengths.
+  uint32_t constexpr kSize = 30;
+  UndirectedGraph graph;
+  for (uint32_t i = 0; i < kSize; ++i)
+  {
+    for (uint32_t j = 0; j < kSize; ++j)
+    {
+      uint32_t const v = i * kSize + j;
+      if (j + 1 < kSize)
+        graph.AddEdge(v, v + 1, 1.0 + (i * 7 + j * 3) % 5);
+      if (i + 1 < kSize)
+        graph.AddEdge(v, v + kSize, 1.0 + (i * 3 + j * 7) % 5);
+    }
+  }
+
+  Algorithm algo;
+  for (uint32_t const finish : {1u, kSize * kSize / 2, kSize * kSize - 1})
+  {
+    Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, finish);
+
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> expected;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(params, expected), ());
+
+    for (size_t t = 0; t < 20; ++t)
+    {
+      RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+      TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectionalParallel(params, actual), ());
+      TEST_ALMOST_EQUAL_ABS(expected.m_distance, actual.m_distance, 1e-6, (finish));
+      TEST_EQUAL(actual.m_path.front(), 0, ());
+      TEST_EQUAL(actual.m_path.back(), finish, ());
+    }
+  }
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  // Two disjoint paths of close lengths: 0-1-4 and 0-2-3-4, and a detour 1-5-4
+  // which shares too much with the best path.
+  UndirectedGraph graph;
+  graph.AddEdge(0, 1, 15);
+  graph.AddEdge(1, 4, 5);
+  graph.AddEdge(0, 2, 7);
+  graph.AddEdge(2, 3, 7);
+  graph.AddEdge(3, 4, 7);
+  graph.AddEdge(1, 5, 1);
+  graph.AddEdge(5, 4, 5);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, 4u /* finishVertex */);
+
+  for (size_t threadsCount : {1, 4})
+  {
+    Algorithm::AlternativesParams altParams;
+    altParams.m_threadsCount = threadsCount;
+
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+    vector<RoutingResult<unsigned /* Vertex */, double /* Weight */>> alternatives;
+    TEST_EQUAL(Algorithm::Result::OK,
+               algo.FindPathBidirectionalWithAlternatives(params, altParams, result, alternatives), ());
+    TEST_EQUAL(result.m_path, vector<unsigned>({0, 1, 4}), ());
+    TEST_ALMOST_EQUAL_ULPS(result.m_distance, 20.0, ());
+
+    TEST_EQUAL(alternatives.size(), 1, ());
+    TEST_EQUAL(alternatives[0].m_path, vector<unsigned>({0, 2, 3, 4}), ());
+    TEST_ALMOST_EQUAL_ULPS(alternatives[0].m_distance, 21.0, ());
+  }
 }
 
 UNIT_TEST(AdjustRoute)
@@ -108,6 +187,44 @@ UNIT_TEST(AdjustRoute)
   TEST_EQUAL(result.m_distance, 4.0, ());
 }
 
+UNIT_TEST(AdjustRouteToRemainingTree)
+{
+  UndirectedGraph graph;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(7, 8, 1);
+  graph.AddEdge(8, 3, 1);
+
+  // Each edge contains {vertexId, weight}.
+  vector<SimpleEdge> const prevRoute = {{0, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+  Algorithm::RemainingTree tree;
+  Algorithm::MakeRemainingTree(prevRoute, tree);
+  TEST_EQUAL(tree.m_weights.at(0), 5.0, ());
+  TEST_EQUAL(tree.m_weights.at(5), 0.0, ());
+  TEST_EQUAL(tree.m_next.at(3), 4, ());
+  TEST_EQUAL(tree.m_next.count(5), 0, ());
+
+  // Vertex 3 is out of the limit from vertex 7, but vertex 8 of the tree is within it.
+  tree.m_weights[8] = 3.0;
+  tree.m_next[8] = 3;
+
+  auto checkLength = [](double weight) { return weight <= 1.0; };
+  Algorithm algo;
+  Algorithm::ParamsForTests<decltype(checkLength)> params(
+      graph, 7 /* startVertex */, {} /* finishVertex */, std::move(checkLength));
+
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  auto const code = algo.AdjustRoute(params, tree, result);
+
+  vector<unsigned> const expectedRoute = {7, 8, 3, 4, 5};
+  TEST_EQUAL(code, Algorithm::Result::OK, ());
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+  TEST_EQUAL(result.m_distance, 4.0, ());
+}
+
 UNIT_TEST(AdjustRouteNoPath)
 {
   UndirectedGraph graph;
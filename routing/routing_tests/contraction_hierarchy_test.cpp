@@ -0,0 +1,173 @@
+#include "testing/testing.hpp"
+
+#include "routing/contraction_hierarchy.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace contraction_hierarchy_test
+{
+using namespace routing;
+using namespace std;
+
+using Edge = ContractionHierarchy::Edge;
+using Vertex = ContractionHierarchy::Vertex;
+
+double Dijkstra(uint32_t verticesCount, vector<Edge> const & edges, Vertex from, Vertex to)
+{
+  vector<vector<pair<Vertex, double>>> adj(verticesCount);
+  for (auto const & e : edges)
+    adj[e.m_from].emplace_back(e.m_to, e.m_weight);
+
+  vector<double> dist(verticesCount, ContractionHierarchy::kUnreachable);
+  using Item = pair<double, Vertex>;
+  priority_queue<Item, vector<Item>, greater<Item>> queue;
+  dist[from] = 0.0;
+  queue.emplace(0.0, from);
+  while (!queue.empty())
+  {
+    auto const [d, v] = queue.top();
+    queue.pop();
+    if (d > dist[v])
+      continue;
+    for (auto const & [w, weight] : adj[v])
+    {
+      if (d + weight < dist[w])
+      {
+        dist[w] = d + weight;
+        queue.emplace(dist[w], w);
+      }
+    }
+  }
+  return dist[to];
+}
+
+double GetPathWeight(vector<Edge> const & edges, vector<Vertex> const & path)
+{
+  double weight = 0.0;
+  for (size_t i = 0; i + 1 < path.size(); ++i)
+  {
+    double best = ContractionHierarchy::kUnreachable;
+    for (auto const & e : edges)
+    {
+      if (e.m_from == path[i] && e.m_to == path[i + 1])
+        best = min(best, e.m_weight);
+    }
+    TEST_NOT_EQUAL(best, ContractionHierarchy::kUnreachable, (path[i], path[i + 1]));
+    weight += best;
+  }
+  return weight;
+}
+
+void TestAllPairs(ContractionHierarchy const & ch, uint32_t verticesCount, vector<Edge> const & edges)
+{
+  for (Vertex from = 0; from < verticesCount; ++from)
+  {
+    for (Vertex to = 0; to < verticesCount; ++to)
+    {
+      double const expected = Dijkstra(verticesCount, edges, from, to);
+      RoutingResult<Vertex, double> result;
+      bool const found = ch.FindPath(from, to, result);
+      TEST_EQUAL(found, expected != ContractionHierarchy::kUnreachable, (from, to));
+      if (!found)
+      {
+        TEST_EQUAL(ch.GetDistance(from, to), ContractionHierarchy::kUnreachable, ());
+        continue;
+      }
+
+      TEST_ALMOST_EQUAL_ABS(result.m_distance, expected, 1e-9, (from, to));
+      TEST_ALMOST_EQUAL_ABS(ch.GetDistance(from, to), expected, 1e-9, (from, to));
+      TEST_EQUAL(result.m_path.front(), from, ());
+      TEST_EQUAL(result.m_path.back(), to, ());
+      TEST_ALMOST_EQUAL_ABS(GetPathWeight(edges, result.m_path), expected, 1e-9, (result.m_path));
+    }
+  }
+}
+
+UNIT_TEST(ContractionHierarchy_Line)
+{
+  // 0 -> 1 -> 2 -> 3 -> 4 and a heavy direct edge 0 -> 4.
+  vector<Edge> const edges = {{0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {3, 4, 1.0}, {0, 4, 10.0}};
+
+  ContractionHierarchy ch;
+  ch.Build(5 /* verticesCount */, edges);
+
+  RoutingResult<Vertex, double> result;
+  TEST(ch.FindPath(0, 4, result), ());
+  TEST_EQUAL(result.m_path, vector<Vertex>({0, 1, 2, 3, 4}), ());
+  TEST_ALMOST_EQUAL_ABS(result.m_distance, 4.0, 1e-9, ());
+
+  TEST(!ch.FindPath(4, 0, result), ());
+  TEST(result.Empty(), ());
+
+  TEST(ch.FindPath(2, 2, result), ());
+  TEST_EQUAL(result.m_path, vector<Vertex>({2}), ());
+  TEST_EQUAL(result.m_distance, 0.0, ());
+}
+
+UNIT_TEST(ContractionHierarchy_Random)
+{
+  minstd_rand rng(0);
+  for (uint32_t const verticesCount : {2, 10, 50, 120})
+  {
+    uniform_int_distribution<Vertex> vertexDist(0, verticesCount - 1);
+    uniform_int_distribution<int> weightDist(1, 20);
+
+    vector<Edge> edges;
+    for (uint32_t i = 0; i < verticesCount * 3; ++i)
+      edges.emplace_back(vertexDist(rng), vertexDist(rng), static_cast<double>(weightDist(rng)));
+
+    ContractionHierarchy ch;
+    ch.Build(verticesCount, edges);
+    TestAllPairs(ch, verticesCount, edges);
+
+    // A very small witness limit produces more shortcuts but the same distances.
+    ContractionHierarchy::BuildParams params;
+    params.m_witnessSettledLimit = 1;
+    ContractionHierarchy chNoWitness;
+    chNoWitness.Build(verticesCount, edges, params);
+    TEST_GREATER_OR_EQUAL(chNoWitness.GetShortcutsCount(), ch.GetShortcutsCount(), ());
+    TestAllPairs(chNoWitness, verticesCount, edges);
+  }
+}
+
+UNIT_TEST(ContractionHierarchy_Serialization)
+{
+  minstd_rand rng(1);
+  uint32_t const verticesCount = 60;
+  uniform_int_distribution<Vertex> vertexDist(0, verticesCount - 1);
+  uniform_real_distribution<double> weightDist(0.5, 100.0);
+
+  vector<Edge> edges;
+  for (uint32_t i = 0; i < verticesCount * 4; ++i)
+    edges.emplace_back(vertexDist(rng), vertexDist(rng), weightDist(rng));
+
+  ContractionHierarchy ch;
+  ch.Build(verticesCount, edges);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    ch.Serialize(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  ContractionHierarchy deserialized;
+  deserialized.Deserialize(src);
+
+  TEST_EQUAL(deserialized.GetVerticesCount(), verticesCount, ());
+  TEST_EQUAL(deserialized.GetEdgesCount(), ch.GetEdgesCount(), ());
+  for (Vertex v = 0; v < verticesCount; ++v)
+    TEST_EQUAL(deserialized.GetRank(v), ch.GetRank(v), ());
+
+  TestAllPairs(deserialized, verticesCount, edges);
+}
+}  // namespace contraction_hierarchy_test
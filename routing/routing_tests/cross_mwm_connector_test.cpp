@@ -2,6 +2,7 @@
 
 #include "routing/cross_mwm_connector_serialization.hpp"
 #include "routing/cross_mwm_ids.hpp"
+#include "routing/cross_mwm_index_graph.hpp"
 
 #include "coding/writer.hpp"
 
@@ -333,4 +334,30 @@ UNIT_TEST(CMWMC_WeightsSerialization)
   TestWeightsSerialization<base::GeoObjectId>();
   TestWeightsSerialization<TransitId>();
 }
+
+UNIT_TEST(CrossMwmConnectorsCache_Lru)
+{
+  using Cache = CrossMwmConnectorsCache<base::GeoObjectId>;
+  Cache cache(2 /* maxConnectorsCount */);
+  auto const makeConnector = [](NumMwmId numMwmId)
+  {
+    return make_shared<CrossMwmConnector<base::GeoObjectId>>(numMwmId);
+  };
+
+  auto const connector1 = makeConnector(1);
+  cache.Put(1, connector1);
+  cache.Put(2, makeConnector(2));
+  TEST_EQUAL(cache.Get(1), connector1, ());
+  TEST(!cache.Get(3), ());
+
+  // The least recently used connector is evicted.
+  cache.Put(3, makeConnector(3));
+  TEST(!cache.Get(2), ());
+  TEST_EQUAL(cache.Get(1), connector1, ());
+  TEST(cache.Get(3), ());
+
+  cache.Clear();
+  TEST(!cache.Get(1), ());
+  TEST(!cache.Get(3), ());
+}
 } // namespace cross_mwm_connector_test
@@ -125,4 +125,37 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
       mercator::DistanceOnEarth(kTestDirectedPolyline1.Front(), point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+
+UNIT_TEST(FollowedPolylineLongRouteJumpTest)
+{
+  // The route goes along a road and returns by the same road, the polyline is long enough to look
+  // up far segments in the index.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i <= 50; ++i)
+    points.emplace_back(i * 0.01, 0.0);
+  for (size_t i = 50; i > 0; --i)
+    points.emplace_back((i - 1) * 0.01, 0.0);
+  points.emplace_back(0.0, 0.01);
+
+  FollowedPolyline polyline(points.cbegin(), points.cend());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 0, ());
+
+  // The first of the overlapping segments is taken.
+  auto iter = polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.305, 0.0}, 2));
+  TEST(iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 30, ());
+
+  // The projection can't return to the passed segments.
+  iter = polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.105, 0.0}, 2));
+  TEST(iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 89, ());
+
+  iter = polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.0, 0.005}, 2));
+  TEST(iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 100, ());
+
+  iter = polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.2, 0.005}, 2));
+  TEST(!iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 100, ());
+}
 }  // namespace routing_test
@@ -8,6 +8,7 @@
 #include "routing/edge_estimator.hpp"
 #include "routing/fake_ending.hpp"
 #include "routing/index_graph.hpp"
+#include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_router.hpp"
@@ -850,4 +851,45 @@ UNIT_TEST(FinishNearZeroEdge)
       {1.0 /* x */, 0.0 /* y */}, {2.0, 0.0}, {4.0, 0.0}, {5.0, 0.0}};
   TestRouteGeometry(*starter, AlgorithmForIndexGraphStarter::Result::OK, expectedGeom);
 }
+
+UNIT_TEST(IndexGraphsCache_CopiedGraph)
+{
+  auto const makeLoader = []()
+  {
+    auto loader = make_unique<TestGeometryLoader>();
+    loader->AddRoad(0 /* featureId */, false, 1.0 /* speed */,
+                    RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}}));
+    loader->AddRoad(1 /* featureId */, true, 1.0 /* speed */,
+                    RoadGeometry::Points({{1.0, 1.0}, {1.0, 0.0}, {1.0, -1.0}}));
+    return loader;
+  };
+
+  traffic::TrafficCache const trafficCache;
+  auto const estimator = CreateEstimatorForCar(trafficCache);
+  IndexGraph graph(make_shared<Geometry>(makeLoader()), estimator);
+  graph.Import({MakeJoint({{0, 1}, {1, 1}})});
+
+  IndexGraphsCache cache(2 /* maxGraphsCount */);
+  cache.Put(kTestNumMwmId, 1 /* mwmVersion */,
+            make_shared<IndexGraph>(graph, make_shared<Geometry>(), estimator, RoutingOptions()));
+  TEST(!cache.Get(kTestNumMwmId, 2 /* mwmVersion */), ());
+  auto const cached = cache.Get(kTestNumMwmId, 1 /* mwmVersion */);
+  TEST(cached, ());
+
+  IndexGraph copy(*cached, make_shared<Geometry>(makeLoader()), estimator, RoutingOptions());
+  TestOutgoingEdges(
+      copy, {kTestNumMwmId, 0 /* featureId */, 0 /* segmentIdx */, true /* forward */},
+      {{kTestNumMwmId, 0, 0, false}, {kTestNumMwmId, 0, 1, true}, {kTestNumMwmId, 1, 1, true}});
+  TestIngoingEdges(
+      copy, {kTestNumMwmId, 1, 1, true},
+      {{kTestNumMwmId, 1, 0, true}, {kTestNumMwmId, 0, 0, true}, {kTestNumMwmId, 0, 1, false}});
+
+  // The least recently used graph is evicted.
+  cache.Put(kTestNumMwmId + 1, 1 /* mwmVersion */, cached);
+  TEST(cache.Get(kTestNumMwmId, 1 /* mwmVersion */), ());
+  cache.Put(kTestNumMwmId + 2, 1 /* mwmVersion */, cached);
+  TEST(!cache.Contains(kTestNumMwmId + 1, 1 /* mwmVersion */), ());
+  TEST(cache.Contains(kTestNumMwmId, 1 /* mwmVersion */), ());
+  TEST(cache.Contains(kTestNumMwmId + 2, 1 /* mwmVersion */), ());
+}
 }  // namespace index_graph_test
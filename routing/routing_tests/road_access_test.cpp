@@ -223,6 +223,30 @@ UNIT_CLASS_TEST(RoadAccessSerDesTest, RoadAccess_Serdes)
 //  TestDeserialize(VehicleType::Pedestrian, roadAccessPedestrian);
 //}
 
+UNIT_TEST(RoadAccess_FeaturesWithAndWithoutRules)
+{
+  RoadAccess roadAccess;
+  FillRoadAccessBySample_1(roadAccess);
+
+  auto const sure = [](RoadAccess::Type type) { return make_pair(type, RoadAccess::Confidence::Sure); };
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(1 /* featureId */), sure(RoadAccess::Type::No), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(2 /* featureId */), sure(RoadAccess::Type::Private), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(3 /* featureId */), sure(RoadAccess::Type::Yes), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(1000 /* featureId */), sure(RoadAccess::Type::Yes), ());
+
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(RoadPoint(3, 0)), sure(RoadAccess::Type::No), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(RoadPoint(3, 1)), sure(RoadAccess::Type::Yes), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(RoadPoint(1, 0)), sure(RoadAccess::Type::Yes), ());
+
+  // Setting of conditional rules keeps the others.
+  roadAccess.SetAccessConditional({}, {});
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(2 /* featureId */), sure(RoadAccess::Type::Private), ());
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(RoadPoint(4, 7)), sure(RoadAccess::Type::Private), ());
+
+  roadAccess.SetAccess({}, {});
+  TEST_EQUAL(roadAccess.GetAccessWithoutConditional(1 /* featureId */), sure(RoadAccess::Type::Yes), ());
+}
+
 UNIT_TEST(RoadAccess_WayBlocked)
 {
   // Add edges to the graph in the following format: (from, to, weight).
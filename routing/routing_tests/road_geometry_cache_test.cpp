@@ -0,0 +1,104 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace road_geometry_cache_test
+{
+using namespace routing;
+using namespace std;
+
+RoadGeometryCache::Loader MakeLoader(uint32_t featureId, atomic<size_t> & loadsCount)
+{
+  return [featureId, &loadsCount](RoadGeometry & road) {
+    ++loadsCount;
+    road = RoadGeometry(false /* oneWay */, 10.0 /* weightSpeedKMpH */, 10.0 /* etaSpeedKMpH */,
+                        {{0.0, 0.0}, {0.0, static_cast<double>(featureId + 1)}});
+  };
+}
+
+UNIT_TEST(RoadGeometryCache_Smoke)
+{
+  RoadGeometryCache cache(1024 * 1024 /* memoryBudgetBytes */);
+  auto const source = cache.GetSourceId("Country", 1 /* mwmVersion */, VehicleType::Car,
+                                        false /* loadAltitudes */);
+  TEST_EQUAL(cache.GetSourceId("Country", 1 /* mwmVersion */, VehicleType::Car,
+                               false /* loadAltitudes */), source, ());
+  TEST_NOT_EQUAL(cache.GetSourceId("Country", 1 /* mwmVersion */, VehicleType::Pedestrian,
+                                   false /* loadAltitudes */), source, ());
+  TEST_NOT_EQUAL(cache.GetSourceId("Country", 2 /* mwmVersion */, VehicleType::Car,
+                                   false /* loadAltitudes */), source, ());
+
+  atomic<size_t> loadsCount{0};
+  auto const road = cache.GetRoad(source, 5 /* featureId */, MakeLoader(5, loadsCount));
+  TEST_EQUAL(loadsCount, 1, ());
+  TEST_EQUAL(road->GetPointsCount(), 2, ());
+
+  auto const sameRoad = cache.GetRoad(source, 5 /* featureId */, MakeLoader(5, loadsCount));
+  TEST_EQUAL(loadsCount, 1, ());
+  TEST_EQUAL(road, sameRoad, ());
+  TEST_EQUAL(cache.GetRoadsCount(), 1, ());
+  TEST_EQUAL(cache.GetMemoryUsage(), RoadGeometryCache::EstimateMemoryUsage(*road), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetRoadsCount(), 0, ());
+  TEST_EQUAL(cache.GetMemoryUsage(), 0, ());
+  // The road is still alive because it's referenced here.
+  TEST_EQUAL(road->GetPointsCount(), 2, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Budget)
+{
+  atomic<size_t> loadsCount{0};
+  RoadGeometryCache cache(0 /* memoryBudgetBytes */);
+  TEST(!cache.IsEnabled(), ());
+  auto const source = cache.GetSourceId("Country", 1 /* mwmVersion */, VehicleType::Car,
+                                        false /* loadAltitudes */);
+  cache.GetRoad(source, 1 /* featureId */, MakeLoader(1, loadsCount));
+  cache.GetRoad(source, 1 /* featureId */, MakeLoader(1, loadsCount));
+  TEST_EQUAL(loadsCount, 2, ());
+  TEST_EQUAL(cache.GetRoadsCount(), 0, ());
+
+  size_t const budget = 64 * 1024;
+  cache.SetMemoryBudget(budget);
+  TEST(cache.IsEnabled(), ());
+  for (uint32_t featureId = 0; featureId < 10000; ++featureId)
+    cache.GetRoad(source, featureId, MakeLoader(featureId, loadsCount));
+
+  TEST_LESS_OR_EQUAL(cache.GetMemoryUsage(), budget, ());
+  TEST_GREATER(cache.GetRoadsCount(), 0, ());
+  TEST_LESS(cache.GetRoadsCount(), 10000, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Concurrent)
+{
+  RoadGeometryCache cache(16 * 1024 * 1024 /* memoryBudgetBytes */);
+  auto const source = cache.GetSourceId("Country", 1 /* mwmVersion */, VehicleType::Car,
+                                        false /* loadAltitudes */);
+  uint32_t constexpr kRoadsCount = 1000;
+  atomic<size_t> loadsCount{0};
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&]() {
+      for (uint32_t featureId = 0; featureId < kRoadsCount; ++featureId)
+      {
+        auto const road = cache.GetRoad(source, featureId, MakeLoader(featureId, loadsCount));
+        TEST_ALMOST_EQUAL_ABS(road->GetPoint(1).m_lon, static_cast<double>(featureId + 1), 1e-6, ());
+      }
+    });
+  }
+
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(cache.GetRoadsCount(), kRoadsCount, ());
+  TEST_GREATER_OR_EQUAL(loadsCount, kRoadsCount, ());
+}
+}  // namespace road_geometry_cache_test
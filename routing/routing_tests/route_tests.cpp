@@ -454,4 +454,38 @@ UNIT_TEST(RouteNameTest)
   route.GetCurrentStreetName(roadNameInfo);
   TEST_EQUAL(roadNameInfo.m_name, "Street2", (roadNameInfo.m_name));
 }
+
+UNIT_TEST(SpeedCamerasOnRouteTest)
+{
+  Route route("TestRouter", 0 /* route id */);
+
+  route.SetGeometry(kTestGeometry.begin(), kTestGeometry.end());
+  vector<RouteSegment> routeSegments;
+  GetTestRouteSegments(kTestGeometry, kTestTurns, {}, {}, routeSegments);
+  routeSegments[3].SetSpeedCameraInfo({{0.5 /* coef */, 60}, {0.25 /* coef */, 40}});
+  routeSegments[1].SetSpeedCameraInfo({{1.0 /* coef */, 90}});
+  route.SetRouteSegments(std::move(routeSegments));
+  route.FillSpeedCamerasOnRoute();
+
+  auto const & segments = route.GetRouteSegments();
+  auto const & speedCams = route.GetSpeedCamerasOnRoute();
+  TEST_EQUAL(speedCams.size(), 3, ());
+
+  TEST_EQUAL(speedCams[0].m_maxSpeedKmH, 90, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[0].m_distFromBeginMeters,
+                        segments[1].GetDistFromBeginningMeters(), 1e-6, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[0].m_position, m2::PointD(1.0, 1.0), 1e-9, ());
+
+  double const segmentStartM = segments[2].GetDistFromBeginningMeters();
+  double const segmentLengthM = route.GetSegLenMeters(3);
+  TEST_EQUAL(speedCams[1].m_maxSpeedKmH, 40, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[1].m_distFromBeginMeters, segmentStartM + 0.25 * segmentLengthM,
+                        1e-6, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[1].m_position, m2::PointD(1.0, 2.25), 1e-9, ());
+
+  TEST_EQUAL(speedCams[2].m_maxSpeedKmH, 60, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[2].m_distFromBeginMeters, segmentStartM + 0.5 * segmentLengthM,
+                        1e-6, ());
+  TEST_ALMOST_EQUAL_ABS(speedCams[2].m_position, m2::PointD(1.0, 2.5), 1e-9, ());
+}
 }  // namespace route_tests
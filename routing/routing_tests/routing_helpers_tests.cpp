@@ -149,4 +149,20 @@ UNIT_TEST(PolylineInRectTest)
     TEST(RectCoversPolyline(junctions, m2::RectD(0.0, 0.0, 1.0, 1.0)), ());
   }
 }
+UNIT_TEST(MakeStarShapedHull_Smoke)
+{
+  m2::PointD const center(0.0, 0.0);
+  TEST(MakeStarShapedHull(center, {}, 4 /* sectorsCount */).empty(), ());
+  TEST(MakeStarShapedHull(center, {center}, 4 /* sectorsCount */).empty(), ());
+
+  // Only the farthest point of every sector is kept.
+  vector<m2::PointD> const points = {{1.0, 1.0},  {2.0, 2.0}, {-1.0, 1.0}, {-1.0, -3.0},
+                                     {0.5, -0.5}, {3.0, -1.0}, {-0.5, 0.5}};
+  vector<m2::PointD> const expected = {{-1.0, -3.0}, {3.0, -1.0}, {2.0, 2.0}, {-1.0, 1.0}};
+  TEST_EQUAL(MakeStarShapedHull(center, points, 4 /* sectorsCount */), expected, ());
+
+  // Empty sectors are skipped.
+  TEST_EQUAL(MakeStarShapedHull(center, {{1.0, 2.0}, {2.0, 1.0}}, 8 /* sectorsCount */),
+             vector<m2::PointD>({{2.0, 1.0}, {1.0, 2.0}}), ());
+}
 }  // namespace routing_test
@@ -557,6 +557,51 @@ UNIT_CLASS_TEST(AsyncGuiThreadTestWithRoutingSession, TestFollowRoutePercentTest
        ("Route checking timeout."));
 }
 
+UNIT_CLASS_TEST(AsyncGuiThreadTestWithRoutingSession, TestFollowRouteWithLocationsChunk)
+{
+  TimedSignal alongTimedSignal;
+  GetPlatform().RunTask(Platform::Thread::Gui, [&alongTimedSignal, this]() {
+    InitRoutingSession();
+    Route masterRoute("dummy", kTestRoute.begin(), kTestRoute.end(), 0 /* route id */);
+    FillSubroutesInfo(masterRoute);
+
+    size_t counter = 0;
+    unique_ptr<DummyRouter> router =
+        make_unique<DummyRouter>(masterRoute, RouterResultCode::NoError, counter);
+    m_session->SetRouter(std::move(router), nullptr);
+
+    m_session->SetRoutingCallbacks(
+        [&alongTimedSignal](Route const &, RouterResultCode) { alongTimedSignal.Signal(); },
+        nullptr /* rebuildReadyCallback */, nullptr /* needMoreMapsCallback */,
+        nullptr /* removeRouteCallback */);
+    m_session->BuildRoute(Checkpoints(kTestRoute.front(), kTestRoute.back()),
+                          RouterDelegate::kNoTimeout);
+  });
+  TEST(alongTimedSignal.WaitUntil(steady_clock::now() + kRouteBuildingMaxDuration), ("Route was not built."));
+
+  TimedSignal checkTimedSignal;
+  GetPlatform().RunTask(Platform::Thread::Gui, [&checkTimedSignal, this] {
+    location::GpsInfo info;
+    info.m_horizontalAccuracy = 0.01;
+    info.m_verticalAccuracy = 0.01;
+    info.m_longitude = 0.;
+
+    // Go through two thirds of the route by one chunk of locations.
+    vector<location::GpsInfo> infos;
+    for (info.m_latitude = 1.; info.m_latitude < 3.; info.m_latitude += 0.01)
+      infos.push_back(info);
+    info.m_latitude = 3.;
+    infos.push_back(info);
+
+    TEST_EQUAL(m_session->OnLocationPositionsChanged(infos), SessionState::OnRoute, ());
+    TEST(base::AlmostEqualAbs(m_session->GetCompletionPercent(), 66.6, 0.5),
+         (m_session->GetCompletionPercent()));
+    checkTimedSignal.Signal();
+  });
+  TEST(checkTimedSignal.WaitUntil(steady_clock::now() + kRouteBuildingMaxDuration),
+       ("Route checking timeout."));
+}
+
 UNIT_CLASS_TEST(AsyncGuiThreadTestWithRoutingSession, TestRouteRebuildingError)
 {
   vector<m2::PointD> const kRoute = {{0.0, 0.001}, {0.0, 0.002}, {0.0, 0.003}, {0.0, 0.004}};
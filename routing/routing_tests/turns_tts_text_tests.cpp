@@ -140,6 +140,8 @@ UNIT_TEST(GetTtsTextTest)
   TEST_EQUAL(getTtsText.GetTurnNotification(notification2), "In 300 meters. Make a left turn.", ());
   TEST_EQUAL(getTtsText.GetTurnNotification(notification3), "You have reached the destination.", ());
   TEST_EQUAL(getTtsText.GetTurnNotification(notification4), "Then. Make a left turn.", ());
+  // Cached text.
+  TEST_EQUAL(getTtsText.GetTurnNotification(notification1), "In 500 meters. Make a right turn.", ());
 
   getTtsText.ForTestingSetLocaleWithJson(rusShortJson, "ru");
   TEST_EQUAL(getTtsText.GetTurnNotification(notification1), "Через 500 метров. Поворот направо.", ());
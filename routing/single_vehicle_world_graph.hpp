@@ -78,6 +78,8 @@ public:
     return m_loader->GetIndexGraph(numMwmId);
   }
 
+  double GetGraphsLoadingTimeMs() const override { return m_loader->GetLoadingTimeMs(); }
+
   void SetAStarParents(bool forward, Parents<Segment> & parents) override;
   void SetAStarParents(bool forward, Parents<JointSegment> & parents) override;
   void DropAStarParents() override;
@@ -139,7 +139,7 @@ void SpeedCameraManager::Reset()
 
   m_closestCamera.Invalidate();
 
-  m_firstNotCheckedSpeedCameraIndex = 1;
+  m_firstNotCheckedSpeedCameraIndex = 0;
   m_cachedSpeedCameras = std::queue<SpeedCameraOnRoute>();
 }
 
@@ -170,44 +170,18 @@ void SpeedCameraManager::FindCamerasOnRouteAndCache(double passedDistanceMeters)
 {
   CHECK(!m_route.expired(), ());
 
-  auto const & segments = m_route.lock()->GetRouteSegments();
-  size_t firstNotChecked = m_firstNotCheckedSpeedCameraIndex;
-  if (firstNotChecked == segments.size())
-    return;
-
-  CHECK_LESS(firstNotChecked, segments.size(), ());
-
-  double distToPrevSegment = segments[firstNotChecked].GetDistFromBeginningMeters();
-  double distFromCurPosToLatestCheckedSegmentM = distToPrevSegment - passedDistanceMeters;
+  auto const & speedCams = m_route.lock()->GetSpeedCamerasOnRoute();
+  CHECK_LESS_OR_EQUAL(m_firstNotCheckedSpeedCameraIndex, speedCams.size(), ());
 
-  while (firstNotChecked < segments.size() &&
-         distFromCurPosToLatestCheckedSegmentM < kLookAheadDistanceMeters)
+  while (m_firstNotCheckedSpeedCameraIndex < speedCams.size())
   {
-    CHECK_GREATER(firstNotChecked, 0, ());
-
-    auto const & lastSegment = segments[firstNotChecked];
-    auto const & prevSegment = segments[firstNotChecked - 1];
-
-    auto const & endPoint = lastSegment.GetJunction().GetPoint();
-    auto const & startPoint = prevSegment.GetJunction().GetPoint();
-    auto const direction = endPoint - startPoint;
+    auto const & speedCam = speedCams[m_firstNotCheckedSpeedCameraIndex];
+    if (speedCam.m_distFromBeginMeters - passedDistanceMeters >= kLookAheadDistanceMeters)
+      break;
 
-    auto const & speedCamsVector = lastSegment.GetSpeedCams();
-    double segmentLength = m_route.lock()->GetSegLenMeters(firstNotChecked);
-
-    for (auto const & speedCam : speedCamsVector)
-    {
-      segmentLength *= speedCam.m_coef;
-      m_cachedSpeedCameras.emplace(distToPrevSegment + segmentLength, speedCam.m_maxSpeedKmPH,
-                                   startPoint + direction * speedCam.m_coef);
-    }
-
-    distToPrevSegment = lastSegment.GetDistFromBeginningMeters();
-    distFromCurPosToLatestCheckedSegmentM = distToPrevSegment - passedDistanceMeters;
-    ++firstNotChecked;
+    m_cachedSpeedCameras.push(speedCam);
+    ++m_firstNotCheckedSpeedCameraIndex;
   }
-
-  m_firstNotCheckedSpeedCameraIndex = firstNotChecked;
 }
 
 void SpeedCameraManager::PassClosestCameraToUI()
@@ -170,6 +170,7 @@ private:
   // Queue of speedCams, that we have found, but they are too far, to make warning about them.
   std::queue<SpeedCameraOnRoute> m_cachedSpeedCameras;
 
+  // Index of the first camera of Route::GetSpeedCamerasOnRoute() which is not cached yet.
   size_t m_firstNotCheckedSpeedCameraIndex;
   std::weak_ptr<Route> m_route;
   turns::sound::NotificationManager & m_notificationManager;
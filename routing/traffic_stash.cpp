@@ -20,22 +20,17 @@ traffic::SpeedGroup TrafficStash::GetSpeedGroup(Segment const & segment) const
   if (itMwm == m_mwmToTraffic.cend())
     return traffic::SpeedGroup::Unknown;
 
-  auto const & coloring = itMwm->second;
-  auto const itSeg = coloring->find(traffic::TrafficInfo::RoadSegmentId(
+  return itMwm->second->Get(traffic::TrafficInfo::RoadSegmentId(
       segment.GetFeatureId(), base::asserted_cast<uint16_t>(segment.GetSegmentIdx()),
       segment.IsForward() ? traffic::TrafficInfo::RoadSegmentId::kForwardDirection
                           : traffic::TrafficInfo::RoadSegmentId::kReverseDirection));
-
-  if (itSeg == coloring->cend())
-    return traffic::SpeedGroup::Unknown;
-
-  return itSeg->second;
 }
 
 void TrafficStash::SetColoring(NumMwmId numMwmId,
-                               shared_ptr<const traffic::TrafficInfo::Coloring> coloring)
+                               shared_ptr<const traffic::TrafficInfo::PackedColoring> coloring)
 {
   m_mwmToTraffic[numMwmId] = coloring;
+  ++m_version;
 }
 
 bool TrafficStash::Has(NumMwmId numMwmId) const
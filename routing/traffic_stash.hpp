@@ -11,6 +11,7 @@
 
 #include "base/assert.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -42,16 +43,23 @@ public:
   TrafficStash(traffic::TrafficCache const & source, std::shared_ptr<NumMwmIds> numMwmIds);
 
   traffic::SpeedGroup GetSpeedGroup(Segment const & segment) const;
-  void SetColoring(NumMwmId numMwmId, std::shared_ptr<const traffic::TrafficInfo::Coloring> coloring);
+  void SetColoring(NumMwmId numMwmId, std::shared_ptr<const traffic::TrafficInfo::PackedColoring> coloring);
   bool Has(NumMwmId numMwmId) const;
+  // Returns a number which is changed every time the stashed traffic is changed.
+  uint64_t GetVersion() const { return m_version; }
 
 private:
   void CopyTraffic();
 
-  void Clear() { m_mwmToTraffic.clear(); }
+  void Clear()
+  {
+    m_mwmToTraffic.clear();
+    ++m_version;
+  }
 
   traffic::TrafficCache const & m_source;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::unordered_map<NumMwmId, std::shared_ptr<const traffic::TrafficInfo::Coloring>> m_mwmToTraffic;
+  std::unordered_map<NumMwmId, std::shared_ptr<const traffic::TrafficInfo::PackedColoring>> m_mwmToTraffic;
+  uint64_t m_version = 0;
 };
 }  // namespace routing
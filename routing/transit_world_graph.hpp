@@ -76,6 +76,8 @@ public:
     return m_indexLoader->GetIndexGraph(numMwmId);
   }
 
+  double GetGraphsLoadingTimeMs() const override { return m_indexLoader->GetLoadingTimeMs(); }
+
 private:
   // WorldGraph overrides:
   void GetTwinsInner(Segment const & s, bool isOutgoing, std::vector<Segment> & twins) override;
@@ -40,14 +40,27 @@ template <class TIter> std::string DistToTextId(TIter begin, TIter end, uint32_t
 void GetTtsText::SetLocale(std::string const & locale)
 {
   m_getCurLang = platform::GetTextByIdFactory(platform::TextSource::TtsSound, locale);
+  m_turnNotifications.clear();
 }
 
 void GetTtsText::ForTestingSetLocaleWithJson(std::string const & jsonBuffer, std::string const & locale)
 {
   m_getCurLang = platform::ForTestingGetTextByIdFactory(jsonBuffer, locale);
+  m_turnNotifications.clear();
 }
 
 std::string GetTtsText::GetTurnNotification(Notification const & notification) const
+{
+  NotificationKey const key(notification.m_distanceUnits, notification.m_exitNum,
+                            notification.m_useThenInsteadOfDistance, notification.m_turnDir,
+                            notification.m_turnDirPedestrian, notification.m_lengthUnits);
+  auto it = m_turnNotifications.find(key);
+  if (it == m_turnNotifications.end())
+    it = m_turnNotifications.emplace(key, GenerateTurnNotification(notification)).first;
+  return it->second;
+}
+
+std::string GetTtsText::GenerateTurnNotification(Notification const & notification) const
 {
   if (notification.m_distanceUnits == 0 && !notification.m_useThenInsteadOfDistance)
     return GetTextById(GetDirectionTextId(notification));
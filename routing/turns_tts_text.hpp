@@ -1,9 +1,15 @@
 #pragma once
 
+#include "routing/turns.hpp"
+
 #include "platform/get_text_by_id.hpp"
+#include "platform/measurement_utils.hpp"
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 namespace routing
 {
@@ -17,6 +23,8 @@ struct Notification;
 /// by notification. To get this message use operator().
 /// If the message is not available for specified locale GetTtsText tries to find it in
 /// English locale.
+/// Distances of notifications are rounded to the sounded ones, so a route repeats a few
+/// notifications only. Generated texts are cached until the locale is changed.
 class GetTtsText
 {
 public:
@@ -38,9 +46,15 @@ public:
   void ForTestingSetLocaleWithJson(std::string const & jsonBuffer, std::string const & locale);
 
 private:
+  using NotificationKey = std::tuple<uint32_t /* distanceUnits */, uint8_t /* exitNum */,
+                                     bool /* useThenInsteadOfDistance */, CarDirection,
+                                     PedestrianDirection, measurement_utils::Units>;
+
+  std::string GenerateTurnNotification(Notification const & notification) const;
   std::string GetTextById(std::string const & textId) const;
 
   std::unique_ptr<platform::GetTextById> m_getCurLang;
+  mutable std::map<NotificationKey, std::string> m_turnNotifications;
 };
 
 /// Generates text message id about the distance of the notification. For example: In 300 meters.
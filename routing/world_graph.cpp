@@ -80,6 +80,11 @@ CrossMwmGraph & WorldGraph::GetCrossMwmGraph()
   UNREACHABLE();
 }
 
+double WorldGraph::GetGraphsLoadingTimeMs() const
+{
+  return 0.0;
+}
+
 RouteWeight WorldGraph::GetCrossBorderPenalty(NumMwmId mwmId1, NumMwmId mwmId2)
 {
   return RouteWeight(0);
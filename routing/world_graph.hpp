@@ -119,6 +119,8 @@ public:
 
   virtual IndexGraph & GetIndexGraph(NumMwmId numMwmId) = 0;
   virtual CrossMwmGraph & GetCrossMwmGraph();
+  /// \returns time spent on loading of index graphs in milliseconds.
+  virtual double GetGraphsLoadingTimeMs() const;
   virtual void GetTwinsInner(Segment const & segment, bool isOutgoing,
                              std::vector<Segment> & twins) = 0;
 
@@ -61,17 +61,36 @@ public:
   }
 
 private:
-  // Reads postings for the current token.
+  // Reads postings for the current token. Tokens of |m_dict| and of the
+  // dictionaries of both indices are sorted, so the ids of the current token in
+  // the indices are found by advancing a cursor over each dictionary.
   void ReadPostings()
   {
     m_postings.clear();
     if (!IsValid())
       return;
 
-    auto const & tokens = m_dict.GetTokens();
-    m_index1.ForEachPosting(tokens[m_tokenId], base::MakeBackInsertFunctor(m_postings));
-    m_index2.ForEachPosting(tokens[m_tokenId], base::MakeBackInsertFunctor(m_postings));
-    base::SortUnique(m_postings);
+    auto const & token = m_dict.GetTokens()[m_tokenId];
+    m_postings1.clear();
+    m_postings2.clear();
+    if (AdvanceTo(m_index1, token, m_tokenId1))
+      m_index1.ForEachPostingByTokenId(m_tokenId1, base::MakeBackInsertFunctor(m_postings1));
+    if (AdvanceTo(m_index2, token, m_tokenId2))
+      m_index2.ForEachPostingByTokenId(m_tokenId2, base::MakeBackInsertFunctor(m_postings2));
+
+    // Both lists are sorted and have no duplicates.
+    set_union(m_postings1.begin(), m_postings1.end(), m_postings2.begin(), m_postings2.end(),
+              back_inserter(m_postings));
+  }
+
+  // Advances |tokenId| to the first token of |index| which is not less than |token|.
+  // Returns true if it is |token|.
+  static bool AdvanceTo(TextIndexReader const & index, Token const & token, size_t & tokenId)
+  {
+    auto const & tokens = index.GetDictionary().GetTokens();
+    while (tokenId < tokens.size() && tokens[tokenId] < token)
+      ++tokenId;
+    return tokenId < tokens.size() && tokens[tokenId] == token;
   }
 
   TextIndexDictionary const & m_dict;
@@ -79,6 +98,11 @@ private:
   TextIndexReader const & m_index2;
   // Index of the next token from |m_dict| to be processed.
   size_t m_tokenId = 0;
+  // Indices of the current token in the dictionaries of |m_index1| and |m_index2|.
+  size_t m_tokenId1 = 0;
+  size_t m_tokenId2 = 0;
+  vector<uint32_t> m_postings1;
+  vector<uint32_t> m_postings2;
   vector<uint32_t> m_postings;
 };
 
@@ -3,6 +3,7 @@
 #include "search/base/text_index/dictionary.hpp"
 #include "search/base/text_index/text_index.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/varint.hpp"
@@ -46,15 +47,30 @@ public:
   void ForEachPosting(Token const & token, Fn && fn) const
   {
     size_t tokenId = 0;
-    if (!m_dictionary.GetTokenId(token, tokenId))
-      return;
+    if (m_dictionary.GetTokenId(token, tokenId))
+      ForEachPostingByTokenId(tokenId, std::forward<Fn>(fn));
+  }
+
+  // Executes |fn| on every posting of the token with index |tokenId| in
+  // the dictionary. Postings are passed in increasing order.
+  template <typename Fn>
+  void ForEachPostingByTokenId(size_t tokenId, Fn && fn) const
+  {
     CHECK_LESS(tokenId + 1, m_postingsStarts.size(), ());
 
-    ReaderSource<FileReader> source(m_fileReader.SubReader(
-        m_postingsStarts[tokenId], m_postingsStarts[tokenId + 1] - m_postingsStarts[tokenId]));
+    // The list is read at once and decoded from memory.
+    uint32_t const start = m_postingsStarts[tokenId];
+    uint32_t const size = m_postingsStarts[tokenId + 1] - start;
+    if (size == 0)
+      return;
+
+    std::vector<uint8_t> buffer(size);
+    m_fileReader.Read(start, buffer.data(), size);
 
+    ArrayByteSource source(buffer.data());
+    uint8_t const * const end = buffer.data() + size;
     uint32_t last = 0;
-    while (source.Size() > 0)
+    while (source.PtrUint8() < end)
     {
       last += ReadVarUint<uint32_t>(source);
       fn(last);
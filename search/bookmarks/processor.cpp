@@ -75,7 +75,7 @@ Processor::Processor(Emitter & emitter, base::Cancellable const & cancellable)
 
 void Processor::Reset()
 {
-  m_index = {};
+  m_indexes.clear();
   m_docs.clear();
   m_indexDescriptions = false;
   m_indexableGroups.clear();
@@ -97,43 +97,46 @@ void Processor::EnableIndexingOfBookmarkGroup(GroupId const & groupId, bool enab
   if (wasIndexable == nowIndexable)
     return;
 
-  for (auto const & id : m_bookmarksInGroup[groupId])
+  if (!nowIndexable)
   {
-    if (nowIndexable)
-      AddToIndex(id);
-    else
-      EraseFromIndex(id);
+    m_indexes.erase(groupId);
+    return;
   }
+
+  auto const it = m_bookmarksInGroup.find(groupId);
+  if (it == m_bookmarksInGroup.end())
+    return;
+
+  for (auto const & id : it->second)
+    AddToIndex(id, groupId);
 }
 
 void Processor::Add(Id const & id, Doc const & doc)
 {
   ASSERT_EQUAL(m_docs.count(id), 0, ());
 
-  DocVec::Builder builder;
-  doc.ForEachNameToken(
-      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
-
-  if (m_indexDescriptions)
-  {
-    doc.ForEachDescriptionToken(
-        [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
-  }
-
-  DocVec const docVec(builder);
-
-  m_docs[id] = docVec;
+  m_docs[id] = MakeDocVec(doc);
 }
 
-void Processor::AddToIndex(Id const & id)
+void Processor::AddToIndex(Id const & id, GroupId const & group)
 {
   ASSERT_EQUAL(m_docs.count(id), 1, ());
 
-  m_index.Add(id, DocVecWrapper(m_docs[id]));
+  m_indexes[group].Add(id, DocVecWrapper(m_docs[id]));
 }
 
 void Processor::Update(Id const & id, Doc const & doc)
 {
+  auto const docIt = m_docs.find(id);
+  if (docIt != m_docs.end())
+  {
+    // Most of the updates don't touch the name and the description,
+    // there is nothing to re-index then.
+    auto docVec = MakeDocVec(doc);
+    if (docVec == docIt->second)
+      return;
+  }
+
   auto group = kInvalidGroupId;
   auto const groupIt = m_idToGroup.find(id);
   if (groupIt != m_idToGroup.end())
@@ -160,12 +163,16 @@ void Processor::Erase(Id const & id)
   m_docs.erase(id);
 }
 
-void Processor::EraseFromIndex(Id const & id)
+void Processor::EraseFromIndex(Id const & id, GroupId const & group)
 {
   ASSERT_EQUAL(m_docs.count(id), 1, ());
 
+  auto const it = m_indexes.find(group);
+  if (it == m_indexes.end())
+    return;
+
   auto const & docVec = m_docs[id];
-  m_index.Erase(id, DocVecWrapper(docVec));
+  it->second.Erase(id, DocVecWrapper(docVec));
 }
 
 void Processor::AttachToGroup(Id const & id, GroupId const & group)
@@ -180,7 +187,7 @@ void Processor::AttachToGroup(Id const & id, GroupId const & group)
   m_idToGroup[id] = group;
   m_bookmarksInGroup[group].insert(id);
   if (m_indexableGroups.count(group) > 0)
-    AddToIndex(id);
+    AddToIndex(id, group);
 }
 
 void Processor::DetachFromGroup(Id const & id, GroupId const & group)
@@ -204,12 +211,15 @@ void Processor::DetachFromGroup(Id const & id, GroupId const & group)
   m_bookmarksInGroup[group].erase(id);
 
   if (m_indexableGroups.count(group) > 0)
-    EraseFromIndex(id);
+    EraseFromIndex(id, group);
 
   auto const groupIt = m_bookmarksInGroup.find(group);
   CHECK(groupIt != m_bookmarksInGroup.end(), (group, m_bookmarksInGroup));
   if (groupIt->second.size() == 0)
+  {
     m_bookmarksInGroup.erase(groupIt);
+    m_indexes.erase(group);
+  }
 }
 
 void Processor::Search(Params const & params) const
@@ -217,15 +227,30 @@ void Processor::Search(Params const & params) const
   std::set<Id> ids;
   auto insertId = [&ids](Id const & id, bool /* exactMatch */) { ids.insert(id); };
 
-  for (size_t i = 0; i < params.GetNumTokens(); ++i)
+  auto const retrieve = [&](Index const & index)
   {
-    BailIfCancelled();
+    for (size_t i = 0; i < params.GetNumTokens(); ++i)
+    {
+      BailIfCancelled();
 
-    auto const & token = params.GetToken(i);
-    if (params.IsPrefixToken(i))
-      Retrieve<strings::PrefixDFAModifier<strings::LevenshteinDFA>>(token, insertId);
-    else
-      Retrieve<strings::LevenshteinDFA>(token, insertId);
+      auto const & token = params.GetToken(i);
+      if (params.IsPrefixToken(i))
+        Retrieve<strings::PrefixDFAModifier<strings::LevenshteinDFA>>(index, token, insertId);
+      else
+        Retrieve<strings::LevenshteinDFA>(index, token, insertId);
+    }
+  };
+
+  if (params.m_groupId != kInvalidGroupId)
+  {
+    auto const it = m_indexes.find(params.m_groupId);
+    if (it != m_indexes.end())
+      retrieve(it->second);
+  }
+  else
+  {
+    for (auto const & groupIndex : m_indexes)
+      retrieve(groupIndex.second);
   }
 
   IdfMap idfs(*this, 1.0 /* unknownIdf */);
@@ -236,13 +261,6 @@ void Processor::Search(Params const & params) const
   {
     BailIfCancelled();
 
-    if (params.m_groupId != kInvalidGroupId)
-    {
-      auto const it = m_idToGroup.find(id);
-      if (it == m_idToGroup.end() || it->second != params.m_groupId)
-        continue;
-    }
-
     auto it = m_docs.find(id);
     CHECK(it != m_docs.end(), ("Can't find retrieved doc:", id));
     auto const & doc = it->second;
@@ -270,8 +288,26 @@ void Processor::Finish(bool cancelled) { m_emitter.Finish(cancelled); }
 
 uint64_t Processor::GetNumDocs(strings::UniString const & token, bool isPrefix) const
 {
-  return base::asserted_cast<uint64_t>(
-      m_index.GetNumDocs(StringUtf8Multilang::kDefaultCode, token, isPrefix));
+  // A bookmark belongs to at most one group, so the documents of the groups don't intersect.
+  size_t numDocs = 0;
+  for (auto const & groupIndex : m_indexes)
+    numDocs += groupIndex.second.GetNumDocs(StringUtf8Multilang::kDefaultCode, token, isPrefix);
+  return base::asserted_cast<uint64_t>(numDocs);
+}
+
+DocVec Processor::MakeDocVec(Doc const & doc) const
+{
+  DocVec::Builder builder;
+  doc.ForEachNameToken(
+      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+
+  if (m_indexDescriptions)
+  {
+    doc.ForEachDescriptionToken(
+        [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+  }
+
+  return DocVec(builder);
 }
 
 QueryVec Processor::GetQueryVec(IdfMap & idfs, QueryParams const & params) const
@@ -52,14 +52,14 @@ public:
 
   // Adds a bookmark to Processor but does not index it.
   void Add(Id const & id, Doc const & doc);
-  // Indexes an already added bookmark.
-  void AddToIndex(Id const & id);
+  // Indexes an already added bookmark in the index of |group|.
+  void AddToIndex(Id const & id, GroupId const & group);
   // Updates a bookmark with a new |doc|. Re-indexes if the bookmarks
-  // is already attached to an indexable group.
+  // is already attached to an indexable group and its tokens have changed.
   void Update(Id const & id, Doc const & doc);
 
   void Erase(Id const & id);
-  void EraseFromIndex(Id const & id);
+  void EraseFromIndex(Id const & id, GroupId const & group);
 
   void AttachToGroup(Id const & id, GroupId const & group);
   void DetachFromGroup(Id const & id, GroupId const & group);
@@ -75,23 +75,28 @@ private:
   void BailIfCancelled() const { ::search::BailIfCancelled(m_cancellable); }
 
   template <typename DFA, typename Fn>
-  void Retrieve(QueryParams::Token const & token, Fn && fn) const
+  void Retrieve(Index const & index, QueryParams::Token const & token, Fn && fn) const
   {
     SearchTrieRequest<DFA> request;
     FillRequestFromToken(token, request);
     request.m_langs.insert(StringUtf8Multilang::kDefaultCode);
 
     MatchFeaturesInTrie(
-        request, m_index.GetRootIterator(), [](Id const & /* id */) { return true; } /* filter */,
+        request, index.GetRootIterator(), [](Id const & /* id */) { return true; } /* filter */,
         std::forward<Fn>(fn));
   }
 
+  DocVec MakeDocVec(Doc const & doc) const;
+
   QueryVec GetQueryVec(IdfMap & idfs, QueryParams const & params) const;
 
   Emitter & m_emitter;
   base::Cancellable const & m_cancellable;
 
-  Index m_index;
+  // Bookmarks of every indexable group are indexed separately, so a search in a group
+  // doesn't touch the bookmarks of the other groups and a group is dropped from the
+  // index at once.
+  std::unordered_map<GroupId, Index> m_indexes;
   std::unordered_map<Id, DocVec> m_docs;
 
   bool m_indexDescriptions = false;
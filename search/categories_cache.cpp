@@ -7,15 +7,128 @@
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/search_string_utils.hpp"
 
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace search
 {
 using namespace std;
 
+// CategoriesCacheStorage --------------------------------------------------------------------------
+CategoriesCacheStorage::CategoriesCacheStorage(size_t maxBytes)
+  : m_maxShardMemorySize(maxBytes / kNumShards)
+{
+  CHECK_GREATER(m_maxShardMemorySize, 0, ());
+}
+
+CBV CategoriesCacheStorage::Get(MwmSet::MwmId const & id, vector<uint32_t> const & categories,
+                                Loader const & loader)
+{
+  auto & shard = GetShard(id);
+  Key key(id, categories);
+
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    auto const it = shard.m_entries.find(key);
+    if (it != shard.m_entries.end())
+    {
+      ++shard.m_hits;
+      shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+      return it->second.m_features;
+    }
+  }
+
+  // Retrieval may be long and may throw CancelException, nothing is cached then.
+  auto features = loader();
+  auto const memorySize = features.GetMemorySize();
+
+  lock_guard<mutex> lock(shard.m_mutex);
+  ++shard.m_misses;
+  auto const [it, inserted] = shard.m_entries.emplace(std::move(key), Entry());
+  if (!inserted)
+  {
+    // The features have been loaded by another thread.
+    shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+    return it->second.m_features;
+  }
+
+  shard.m_lru.push_front(it->first);
+  it->second.m_features = features;
+  it->second.m_memorySize = memorySize;
+  it->second.m_lruIt = shard.m_lru.begin();
+  shard.m_memorySize += memorySize;
+
+  // The entry which has just been added is kept even if it exceeds the limit alone.
+  while (shard.m_memorySize > m_maxShardMemorySize && shard.m_lru.size() > 1)
+  {
+    auto const lruIt = shard.m_entries.find(shard.m_lru.back());
+    CHECK(lruIt != shard.m_entries.end(), ());
+    shard.m_memorySize -= lruIt->second.m_memorySize;
+    shard.m_entries.erase(lruIt);
+    shard.m_lru.pop_back();
+  }
+  return features;
+}
+
+void CategoriesCacheStorage::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    shard.m_entries.clear();
+    shard.m_lru.clear();
+    shard.m_memorySize = 0;
+  }
+}
+
+size_t CategoriesCacheStorage::GetNumEntries() const
+{
+  size_t numEntries = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    numEntries += shard.m_entries.size();
+  }
+  return numEntries;
+}
+
+uint64_t CategoriesCacheStorage::GetMemorySize() const
+{
+  uint64_t memorySize = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    memorySize += shard.m_memorySize;
+  }
+  return memorySize;
+}
+
+pair<uint64_t, uint64_t> CategoriesCacheStorage::GetHitsAndMisses() const
+{
+  pair<uint64_t, uint64_t> result;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    result.first += shard.m_hits;
+    result.second += shard.m_misses;
+  }
+  return result;
+}
+
+CategoriesCacheStorage::Shard & CategoriesCacheStorage::GetShard(MwmSet::MwmId const & id)
+{
+  return m_shards[hash<MwmSet::MwmId>()(id) % kNumShards];
+}
+
 // CategoriesCache ---------------------------------------------------------------------------------
 CBV CategoriesCache::Get(MwmContext const & context)
 {
   auto const id = context.m_handle.GetId();
+  if (m_storage)
+    return m_storage->Get(id, m_key, [&]() { return Load(context); });
+
   auto const it = m_cache.find(id);
   if (it != m_cache.cend())
     return it->second;
@@ -25,6 +138,12 @@ CBV CategoriesCache::Get(MwmContext const & context)
   return cbv;
 }
 
+void CategoriesCache::InitKey()
+{
+  m_categories.ForEach([this](uint32_t type) { m_key.push_back(type); });
+  sort(m_key.begin(), m_key.end());
+}
+
 CBV CategoriesCache::Load(MwmContext const & context) const
 {
   auto const & c = classif();
@@ -47,49 +166,52 @@ CBV CategoriesCache::Load(MwmContext const & context) const
 }
 
 // StreetsCache ------------------------------------------------------------------------------------
-StreetsCache::StreetsCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsStreetOrSquareChecker::Instance(), cancellable)
+StreetsCache::StreetsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsStreetOrSquareChecker::Instance(), cancellable, storage)
 {
 }
 
 // SuburbsCache ------------------------------------------------------------------------------------
-SuburbsCache::SuburbsCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsSuburbChecker::Instance(), cancellable)
+SuburbsCache::SuburbsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsSuburbChecker::Instance(), cancellable, storage)
 {
 }
 // VillagesCache -----------------------------------------------------------------------------------
-VillagesCache::VillagesCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsVillageChecker::Instance(), cancellable)
+VillagesCache::VillagesCache(base::Cancellable const & cancellable,
+                             CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsVillageChecker::Instance(), cancellable, storage)
 {
 }
 
 // CountriesCache ----------------------------------------------------------------------------------
-CountriesCache::CountriesCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsCountryChecker::Instance(), cancellable)
+CountriesCache::CountriesCache(base::Cancellable const & cancellable,
+                               CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsCountryChecker::Instance(), cancellable, storage)
 {
 }
 
 // StatesCache -------------------------------------------------------------------------------------
-StatesCache::StatesCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsStateChecker::Instance(), cancellable)
+StatesCache::StatesCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsStateChecker::Instance(), cancellable, storage)
 {
 }
 
 // CitiesTownsOrVillagesCache ----------------------------------------------------------------------
-CitiesTownsOrVillagesCache::CitiesTownsOrVillagesCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsCityTownOrVillageChecker::Instance(), cancellable)
+CitiesTownsOrVillagesCache::CitiesTownsOrVillagesCache(base::Cancellable const & cancellable,
+                                                       CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsCityTownOrVillageChecker::Instance(), cancellable, storage)
 {
 }
 
 // HotelsCache -------------------------------------------------------------------------------------
-HotelsCache::HotelsCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsHotelChecker::Instance(), cancellable)
+HotelsCache::HotelsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsHotelChecker::Instance(), cancellable, storage)
 {
 }
 
 // FoodCache ---------------------------------------------------------------------------------------
-FoodCache::FoodCache(base::Cancellable const & cancellable)
-  : CategoriesCache(ftypes::IsEatChecker::Instance(), cancellable)
+FoodCache::FoodCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage)
+  : CategoriesCache(ftypes::IsEatChecker::Instance(), cancellable, storage)
 {
 }
 }  // namespace search
@@ -6,73 +6,148 @@
 #include "indexer/mwm_set.hpp"
 
 #include "base/cancellable.hpp"
+#include "base/macros.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
 #include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace search
 {
 class MwmContext;
 
+// Storage of the features of categories in mwms which is shared by the categories caches of
+// all the search threads (see Engine), so the features of a category in an mwm are loaded once
+// for all of them. Entries are spread over shards by mwms, every shard has its own lock and
+// evicts its least recently used entries when their size exceeds the shard's part of |maxBytes|.
+//
+// *NOTE* This class is thread-safe.
+class CategoriesCacheStorage
+{
+public:
+  using Loader = std::function<CBV()>;
+
+  explicit CategoriesCacheStorage(size_t maxBytes);
+
+  // Returns cached features of |categories| (sorted types) in the mwm |id| or features from
+  // |loader| which are put to the storage. |loader| is called without holding the lock.
+  CBV Get(MwmSet::MwmId const & id, std::vector<uint32_t> const & categories,
+          Loader const & loader);
+
+  void Clear();
+
+  size_t GetNumEntries() const;
+  uint64_t GetMemorySize() const;
+
+  // Returns the numbers of Get() calls which have found the features in the storage and
+  // which have loaded them, since the storage was created.
+  std::pair<uint64_t, uint64_t> GetHitsAndMisses() const;
+
+private:
+  static size_t constexpr kNumShards = 16;
+
+  using Key = std::pair<MwmSet::MwmId, std::vector<uint32_t>>;
+
+  struct Entry
+  {
+    CBV m_features;
+    uint64_t m_memorySize = 0;
+    std::list<Key>::iterator m_lruIt;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m_mutex;
+    std::map<Key, Entry> m_entries;
+    std::list<Key> m_lru;
+    uint64_t m_memorySize = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  Shard & GetShard(MwmSet::MwmId const & id);
+
+  uint64_t const m_maxShardMemorySize;
+  std::array<Shard, kNumShards> m_shards;
+
+  DISALLOW_COPY_AND_MOVE(CategoriesCacheStorage);
+};
+
 class CategoriesCache
 {
 public:
+  // Features are kept in |storage| when it's not null and in the cache itself otherwise.
   template <typename TypesSource>
-  CategoriesCache(TypesSource const & source, base::Cancellable const & cancellable)
-    : m_cancellable(cancellable)
+  CategoriesCache(TypesSource const & source, base::Cancellable const & cancellable,
+                  CategoriesCacheStorage * storage = nullptr)
+    : m_cancellable(cancellable), m_storage(storage)
   {
     source.ForEachType([this](uint32_t type) { m_categories.Add(type); });
+    InitKey();
   }
 
-  CategoriesCache(std::vector<uint32_t> const & types, base::Cancellable const & cancellable)
-    : m_cancellable(cancellable)
+  CategoriesCache(std::vector<uint32_t> const & types, base::Cancellable const & cancellable,
+                  CategoriesCacheStorage * storage = nullptr)
+    : m_cancellable(cancellable), m_storage(storage)
   {
     for (uint32_t type : types)
       m_categories.Add(type);
+    InitKey();
   }
 
   virtual ~CategoriesCache() = default;
 
   CBV Get(MwmContext const & context);
 
+  // Clears features kept in the cache itself, the shared storage is cleared by its owner.
   inline void Clear() { m_cache.clear(); }
 
 private:
+  void InitKey();
   CBV Load(MwmContext const & context) const;
 
   CategoriesSet m_categories;
+  // Sorted types of |m_categories|, which identify the cache in |m_storage|.
+  std::vector<uint32_t> m_key;
   base::Cancellable const & m_cancellable;
+  CategoriesCacheStorage * m_storage;
   std::map<MwmSet::MwmId, CBV> m_cache;
 };
 
 class StreetsCache : public CategoriesCache
 {
 public:
-  StreetsCache(base::Cancellable const & cancellable);
+  StreetsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 class SuburbsCache : public CategoriesCache
 {
 public:
-  SuburbsCache(base::Cancellable const & cancellable);
+  SuburbsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 class VillagesCache : public CategoriesCache
 {
 public:
-  VillagesCache(base::Cancellable const & cancellable);
+  VillagesCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 class CountriesCache : public CategoriesCache
 {
 public:
-  CountriesCache(base::Cancellable const & cancellable);
+  CountriesCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 class StatesCache : public CategoriesCache
 {
 public:
-  StatesCache(base::Cancellable const & cancellable);
+  StatesCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 // Used for cities/towns/villages from world. Currently we do not have villages in World.mwm but
@@ -80,18 +155,19 @@ public:
 class CitiesTownsOrVillagesCache : public CategoriesCache
 {
 public:
-  CitiesTownsOrVillagesCache(base::Cancellable const & cancellable);
+  CitiesTownsOrVillagesCache(base::Cancellable const & cancellable,
+                             CategoriesCacheStorage * storage = nullptr);
 };
 
 class HotelsCache : public CategoriesCache
 {
 public:
-  HotelsCache(base::Cancellable const & cancellable);
+  HotelsCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 
 class FoodCache : public CategoriesCache
 {
 public:
-  FoodCache(base::Cancellable const & cancellable);
+  FoodCache(base::Cancellable const & cancellable, CategoriesCacheStorage * storage = nullptr);
 };
 }  // namespace search
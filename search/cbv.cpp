@@ -1,5 +1,7 @@
 #include "search/cbv.hpp"
 
+#include "base/assert.hpp"
+
 #include <limits>
 #include <vector>
 
@@ -120,4 +122,19 @@ uint64_t CBV::Hash() const
     return kModulo;
   return coding::CompressedBitVectorHasher::Hash(*m_p) % kModulo;
 }
+
+uint64_t CBV::GetMemorySize() const
+{
+  if (IsEmpty() || IsFull())
+    return 0;
+
+  switch (m_p->GetStorageStrategy())
+  {
+  case coding::CompressedBitVector::StorageStrategy::Dense:
+    return static_cast<coding::DenseCBV const &>(*m_p).NumBitGroups() * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Sparse:
+    return m_p->PopCount() * sizeof(uint64_t);
+  }
+  UNREACHABLE();
+}
 }  // namespace search
@@ -53,6 +53,9 @@ public:
 
   uint64_t Hash() const;
 
+  // Returns approximate number of bytes taken by the set bits.
+  uint64_t GetMemorySize() const;
+
 private:
   explicit CBV(bool full);
 
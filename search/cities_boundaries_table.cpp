@@ -16,6 +16,8 @@
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <sstream>
 
 namespace search
@@ -26,15 +28,16 @@ using namespace std;
 // CitiesBoundariesTable::Boundaries ---------------------------------------------------------------
 bool CitiesBoundariesTable::Boundaries::HasPoint(m2::PointD const & p) const
 {
-  return any_of(m_boundaries.begin(), m_boundaries.end(),
-                [&](CityBoundary const & b) { return b.HasPoint(p, m_eps); });
+  return m_boundaries && any_of(m_boundaries->begin(), m_boundaries->end(),
+                                [&](CityBoundary const & b) { return b.HasPoint(p, m_eps); });
 }
 
 std::string DebugPrint(CitiesBoundariesTable::Boundaries const & boundaries)
 {
   std::ostringstream os;
   os << "Boundaries [";
-  os << ::DebugPrint(boundaries.m_boundaries) << ", ";
+  if (boundaries.m_boundaries)
+    os << ::DebugPrint(*boundaries.m_boundaries) << ", ";
   os << "eps: " << boundaries.m_eps;
   os << "]";
   return os.str();
@@ -54,7 +57,40 @@ bool CitiesBoundariesTable::Load()
   if (handle.GetId() == m_mwmId)
     return true;
 
-  MwmContext context(std::move(handle));
+  // Tables decoded from the World mwms, they are kept while any CitiesBoundariesTable uses them.
+  static mutex tablesMutex;
+  static map<MwmSet::MwmId, weak_ptr<Table const>> tables;
+
+  auto const mwmId = handle.GetId();
+  shared_ptr<Table const> table;
+  {
+    lock_guard<mutex> lock(tablesMutex);
+    auto const it = tables.find(mwmId);
+    if (it != tables.end())
+      table = it->second.lock();
+  }
+
+  if (!table)
+  {
+    table = LoadTable(MwmContext(std::move(handle)));
+    if (!table)
+      return false;
+
+    lock_guard<mutex> lock(tablesMutex);
+    for (auto it = tables.begin(); it != tables.end();)
+      it = it->second.expired() ? tables.erase(it) : next(it);
+    tables[mwmId] = table;
+  }
+
+  m_mwmId = mwmId;
+  m_table = std::move(table);
+  return true;
+}
+
+// static
+shared_ptr<CitiesBoundariesTable::Table const> CitiesBoundariesTable::LoadTable(
+    MwmContext const & context)
+{
   base::Cancellable const cancellable;
   auto const localities = CategoriesCache(LocalitiesSource{}, cancellable).Get(context);
 
@@ -63,7 +99,7 @@ bool CitiesBoundariesTable::Load()
   if (!cont.IsExist(CITIES_BOUNDARIES_FILE_TAG))
   {
     LOG(LWARNING, ("No cities boundaries table in the world map."));
-    return false;
+    return {};
   }
 
   vector<vector<CityBoundary>> all;
@@ -78,31 +114,30 @@ bool CitiesBoundariesTable::Load()
   catch (Reader::Exception const & e)
   {
     LOG(LERROR, ("Can't read cities boundaries table from the world map:", e.Msg()));
-    return false;
+    return {};
   }
 
   if (all.size() != localities.PopCount())
   {
     LOG(LERROR, ("Wrong number of boundaries, expected:", localities.PopCount(), "actual:", all.size()));
-    return false;
+    return {};
   }
 
-  m_mwmId = context.GetId();
-  m_table.clear();
-  m_eps = precision;
+  auto table = make_shared<Table>();
+  table->m_eps = precision;
   size_t idx = 0, notEmpty = 0;
   localities.ForEach([&](uint64_t fid)
   {
     if (!all[idx].empty())
     {
-      CHECK(m_table.emplace(base::asserted_cast<uint32_t>(fid), std::move(all[idx])).second, ());
+      CHECK(table->m_boundaries.emplace(base::asserted_cast<uint32_t>(fid), std::move(all[idx])).second, ());
       ++notEmpty;
     }
     ++idx;
   });
 
   LOG(LDEBUG, ("Localities count =", idx, "; with boundary =", notEmpty));
-  return true;
+  return table;
 }
 
 bool CitiesBoundariesTable::Get(FeatureID const & fid, Boundaries & bs) const
@@ -114,10 +149,15 @@ bool CitiesBoundariesTable::Get(FeatureID const & fid, Boundaries & bs) const
 
 bool CitiesBoundariesTable::Get(uint32_t fid, Boundaries & bs) const
 {
-  auto const it = m_table.find(fid);
-  if (it == m_table.end())
+  if (!m_table)
     return false;
-  bs = Boundaries(it->second, m_eps);
+
+  auto const it = m_table->m_boundaries.find(fid);
+  if (it == m_table->m_boundaries.end())
+    return false;
+
+  // Aliases the table, so the boundaries stay valid even if this table is reloaded.
+  bs = Boundaries(shared_ptr<vector<CityBoundary> const>(m_table, &it->second), m_table->m_eps);
   return true;
 }
 
@@ -125,7 +165,10 @@ void GetCityBoundariesInRectForTesting(CitiesBoundariesTable const & table, m2::
                                        vector<uint32_t> & featureIds)
 {
   featureIds.clear();
-  for (auto const & kv : table.m_table)
+  if (!table.m_table)
+    return;
+
+  for (auto const & kv : table.m_table->m_boundaries)
   {
     for (auto const & cb : kv.second)
     {
@@ -6,6 +6,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,8 @@ class DataSource;
 
 namespace search
 {
+class MwmContext;
+
 class CitiesBoundariesTable
 {
   friend void GetCityBoundariesInRectForTesting(CitiesBoundariesTable const &,
@@ -26,8 +29,9 @@ public:
   public:
     Boundaries() = default;
 
-    Boundaries(std::vector<indexer::CityBoundary> const & boundaries, double eps)
-      : m_boundaries(boundaries), m_eps(eps)
+    // |boundaries| are shared with the table, so the copies of Boundaries are cheap.
+    Boundaries(std::shared_ptr<std::vector<indexer::CityBoundary> const> boundaries, double eps)
+      : m_boundaries(std::move(boundaries)), m_eps(eps)
     {
     }
 
@@ -38,46 +42,55 @@ public:
     m2::RectD GetLimitRect() const
     {
       m2::RectD rect;
-      for (auto const & boundary : m_boundaries)
+      ForEachBoundary([&rect](indexer::CityBoundary const & boundary, size_t /* i */)
       {
         rect.Add(boundary.m_bbox.Min());
         rect.Add(boundary.m_bbox.Max());
-      }
+      });
       return rect;
     }
 
-    size_t GetCount() const { return m_boundaries.size(); }
+    size_t GetCount() const { return m_boundaries ? m_boundaries->size() : 0; }
 
     template <class FnT> void ForEachBoundary(FnT && fn) const
     {
-      for (size_t i = 0; i < m_boundaries.size(); ++i)
-        fn(m_boundaries[i], i);
+      for (size_t i = 0; i < GetCount(); ++i)
+        fn((*m_boundaries)[i], i);
     }
 
     friend std::string DebugPrint(Boundaries const & boundaries);
 
   private:
-    std::vector<indexer::CityBoundary> m_boundaries;
+    std::shared_ptr<std::vector<indexer::CityBoundary> const> m_boundaries;
     double m_eps = 0.0;
   };
 
   explicit CitiesBoundariesTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
 
+  // Decoded tables are shared between all CitiesBoundariesTable instances loaded from the same
+  // World mwm, e.g. by the processors of a multi-threaded engine.
   bool Load();
 
   bool Has(FeatureID const & fid) const { return fid.m_mwmId == m_mwmId && Has(fid.m_index); }
-  bool Has(uint32_t fid) const { return m_table.find(fid) != m_table.end(); }
+  bool Has(uint32_t fid) const { return m_table && m_table->m_boundaries.count(fid) != 0; }
 
   bool Get(FeatureID const & fid, Boundaries & bs) const;
   bool Get(uint32_t fid, Boundaries & bs) const;
 
-  size_t GetSize() const { return m_table.size(); }
+  size_t GetSize() const { return m_table ? m_table->m_boundaries.size() : 0; }
 
 private:
+  struct Table
+  {
+    std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_boundaries;
+    double m_eps = 0.0;
+  };
+
+  static std::shared_ptr<Table const> LoadTable(MwmContext const & context);
+
   DataSource const & m_dataSource;
   MwmSet::MwmId m_mwmId;
-  std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_table;
-  double m_eps = 0.0;
+  std::shared_ptr<Table const> m_table;
 };
 
 /// \brief Fills |featureIds| with feature ids of city boundaries if bounding rect of
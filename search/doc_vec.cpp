@@ -1,5 +1,6 @@
 #include "search/doc_vec.hpp"
 
+#include "base/buffer_vector.hpp"
 #include "base/logging.hpp"
 
 #include <limits>
@@ -46,19 +47,6 @@ double SqrL2(IdfMap & idfs, vector<TokenFrequencyPair> const & tfs)
     sum += GetSqrWeightImpl(idfs, tf, false /* isPrefix */);
   return sum;
 }
-
-// Computes squared L2 norm of vector of tokens + prefix token.
-double SqrL2(IdfMap & idfs, vector<TokenFrequencyPair> const & tfs,
-             optional<strings::UniString> const & prefix)
-{
-  auto result = SqrL2(idfs, tfs);
-  if (prefix)
-  {
-    result +=
-        GetSqrWeightImpl(idfs, TokenFrequencyPair(*prefix, 1 /* frequency */), true /* isPrefix */);
-  }
-  return result;
-}
 }  // namespace
 
 // TokenFrequencyPair ------------------------------------------------------------------------------
@@ -93,6 +81,12 @@ strings::UniString const & DocVec::GetToken(size_t i) const
   return m_tfs[i].m_token;
 }
 
+uint64_t DocVec::GetFrequency(size_t i) const
+{
+  ASSERT_LESS(i, m_tfs.size(), ());
+  return m_tfs[i].m_frequency;
+}
+
 double DocVec::GetIdf(IdfMap & idfs, size_t i) const
 {
   ASSERT_LESS(i, m_tfs.size(), ());
@@ -114,7 +108,7 @@ QueryVec::QueryVec(IdfMap & idfs, Builder const & builder)
 
 double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
 {
-  size_t kInvalidIndex = numeric_limits<size_t>::max();
+  size_t constexpr kInvalidIndex = numeric_limits<size_t>::max();
 
   if (Empty() && rhs.Empty())
     return 1.0;
@@ -122,13 +116,28 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
   if (Empty() || rhs.Empty())
     return 0.0;
 
-  vector<size_t> rsMatchTo(rhs.GetNumTokens(), kInvalidIndex);
+  InitWeights();
+
+  // Idfs and weights of the document tokens are looked up once, they are used by both the full
+  // tokens and the prefix matching.
+  size_t const numDocTokens = rhs.GetNumTokens();
+  buffer_vector<double, 16> rsIdfs(numDocTokens);
+  buffer_vector<double, 16> rsWeights(numDocTokens);
+  buffer_vector<size_t, 16> rsMatchTo(numDocTokens, kInvalidIndex);
+
+  double rn = 0;
+  for (size_t j = 0; j < numDocTokens; ++j)
+  {
+    rsIdfs[j] = rhs.GetIdf(docIdfs, j);
+    rsWeights[j] = GetTfIdf(rhs.GetFrequency(j), rsIdfs[j]);
+    rn += rsWeights[j] * rsWeights[j];
+  }
 
   double dot = 0;
   {
     size_t i = 0, j = 0;
 
-    while (i < m_tfs.size() && j < rhs.GetNumTokens())
+    while (i < m_tfs.size() && j < numDocTokens)
     {
       auto const & lt = m_tfs[i].m_token;
       auto const & rt = rhs.GetToken(j);
@@ -143,7 +152,7 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
       }
       else
       {
-        dot += GetFullTokenWeight(i) * rhs.GetWeight(docIdfs, j);
+        dot += GetFullTokenWeight(i) * rsWeights[j];
         rsMatchTo[j] = i;
         ++i;
         ++j;
@@ -152,7 +161,6 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
   }
 
   auto const ln = Norm();
-  auto const rn = rhs.Norm(docIdfs);
 
   // This similarity metric assumes that prefix is not matched in the document.
   double const similarityNoPrefix = ln > 0 && rn > 0 ? dot / sqrt(ln) / sqrt(rn) : 0;
@@ -165,7 +173,7 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
 
   // Let's try to match prefix token with all tokens in the
   // document, and compute the best cosine distance.
-  for (size_t j = 0; j < rhs.GetNumTokens(); ++j)
+  for (size_t j = 0; j < numDocTokens; ++j)
   {
     auto const & t = rhs.GetToken(j);
     if (!strings::StartsWith(t.begin(), t.end(), prefix.begin(), prefix.end()))
@@ -182,10 +190,10 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
       // - so we need to update correspondingly dot product and
       // vector norms of query and doc.
       auto const oldW = GetPrefixTokenWeight();
-      auto const newW = GetTfIdf(1 /* frequency */, rhs.GetIdf(docIdfs, j));
+      auto const newW = GetTfIdf(1 /* frequency */, rsIdfs[j]);
       auto const l = max(0.0, ln - oldW * oldW + newW * newW);
 
-      num = dot + newW * rhs.GetWeight(docIdfs, j);
+      num = dot + newW * rsWeights[j];
       denom = sqrt(l) * sqrt(rn);
     }
     else
@@ -198,12 +206,11 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
       auto const oldPW = GetPrefixTokenWeight();
 
       auto const tf = m_tfs[i].m_frequency + 1;
-      auto const idf = m_idfs->Get(m_tfs[i].m_token, false /* isPrefix */);
-      auto const newW = GetTfIdf(tf, idf);
+      auto const newW = GetTfIdf(tf, m_fullIdfs[i]);
 
       auto const l = ln - oldFW * oldFW - oldPW * oldPW + newW * newW;
 
-      num = dot + (newW - oldFW) * rhs.GetWeight(docIdfs, j);
+      num = dot + (newW - oldFW) * rsWeights[j];
       denom = sqrt(l) * sqrt(rn);
     }
 
@@ -214,18 +221,46 @@ double QueryVec::Similarity(IdfMap & docIdfs, DocVec const & rhs)
   return max(similarityWithPrefix, similarityNoPrefix);
 }
 
-double QueryVec::Norm() { return SqrL2(*m_idfs, m_tfs, m_prefix); }
+double QueryVec::Norm()
+{
+  InitWeights();
+  return *m_norm;
+}
+
+void QueryVec::InitWeights()
+{
+  if (m_norm)
+    return;
+
+  m_fullIdfs.resize(m_tfs.size());
+  for (size_t i = 0; i < m_tfs.size(); ++i)
+    m_fullIdfs[i] = m_idfs->Get(m_tfs[i].m_token, false /* isPrefix */);
+
+  if (m_prefix)
+    m_prefixWeight = GetTfIdf(1 /* frequency */, m_idfs->Get(*m_prefix, true /* isPrefix */));
+
+  double norm = 0;
+  for (size_t i = 0; i < m_tfs.size(); ++i)
+  {
+    auto const w = GetFullTokenWeight(i);
+    norm += w * w;
+  }
+  if (m_prefix)
+    norm += m_prefixWeight * m_prefixWeight;
+  m_norm = norm;
+}
 
 double QueryVec::GetFullTokenWeight(size_t i)
 {
   ASSERT_LESS(i, m_tfs.size(), ());
-  return GetWeightImpl(*m_idfs, m_tfs[i], false /* isPrefix */);
+  ASSERT_EQUAL(m_fullIdfs.size(), m_tfs.size(), ());
+  return GetTfIdf(m_tfs[i].m_frequency, m_fullIdfs[i]);
 }
 
 double QueryVec::GetPrefixTokenWeight()
 {
   ASSERT(m_prefix, ());
-  return GetWeightImpl(*m_idfs, TokenFrequencyPair(*m_prefix, 1 /* frequency */),
-                       true /* isPrefix */);
+  ASSERT(m_norm, ());
+  return m_prefixWeight;
 }
 }  // namespace search
@@ -66,11 +66,20 @@ public:
   size_t GetNumTokens() const { return m_tfs.size(); }
 
   strings::UniString const & GetToken(size_t i) const;
+  uint64_t GetFrequency(size_t i) const;
   double GetIdf(IdfMap & idfs, size_t i) const;
   double GetWeight(IdfMap & idfs, size_t i) const;
 
   bool Empty() const { return m_tfs.empty(); }
 
+  bool operator==(DocVec const & rhs) const
+  {
+    return std::equal(m_tfs.begin(), m_tfs.end(), rhs.m_tfs.begin(), rhs.m_tfs.end(),
+                      [](TokenFrequencyPair const & lhs, TokenFrequencyPair const & rhs) {
+                        return lhs.m_frequency == rhs.m_frequency && lhs.m_token == rhs.m_token;
+                      });
+  }
+
 private:
   friend std::string DebugPrint(DocVec const & dv)
   {
@@ -119,6 +128,9 @@ public:
   bool Empty() const { return m_tfs.empty() && !m_prefix; }
 
 private:
+  // Caches idfs of the query tokens and the norm, they don't change for the query.
+  void InitWeights();
+
   double GetFullTokenWeight(size_t i);
   double GetPrefixTokenWeight();
 
@@ -134,5 +146,9 @@ private:
   IdfMap * m_idfs;
   std::vector<TokenFrequencyPair> m_tfs;
   std::optional<strings::UniString> m_prefix;
+
+  std::vector<double> m_fullIdfs;
+  double m_prefixWeight = 0.0;
+  std::optional<double> m_norm;
 };
 }  // namespace search
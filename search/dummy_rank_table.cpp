@@ -6,6 +6,11 @@ namespace search
 {
 uint8_t DummyRankTable::Get(uint64_t /* i */) const { return kNoRank; }
 
+void DummyRankTable::GetRanks(std::vector<uint32_t> const & ids, std::vector<uint8_t> & ranks) const
+{
+  ranks.assign(ids.size(), kNoRank);
+}
+
 uint64_t DummyRankTable::Size() const
 {
   NOTIMPLEMENTED();
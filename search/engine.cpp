@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <map>
+#include <tuple>
 #include <vector>
 
 namespace search
@@ -83,16 +84,26 @@ Engine::Params::Params(string const & locale, size_t numThreads)
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
   : m_shutdown(false)
+  , m_maxQueuedRequests(params.m_maxQueuedRequests)
+  , m_categoriesCacheStorage(params.m_categoriesCacheMaxBytes)
 {
   InitSuggestions doInit;
   categories.ForEachName(doInit);
   doInit.GetSuggests(m_suggests);
 
+  if (params.m_numRetrievalThreads != 0)
+  {
+    m_retrievalPool =
+        make_unique<base::thread_pool::work_stealing::ThreadPool>(params.m_numRetrievalThreads);
+  }
+
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
-    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
+    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter,
+                                            &m_categoriesCacheStorage);
     processor->SetPreferredLocale(params.m_locale);
+    processor->SetRetrievalThreadPool(m_retrievalPool.get());
     m_contexts[i].m_processor = std::move(processor);
   }
 
@@ -120,11 +131,44 @@ Engine::~Engine()
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams params)
 {
   shared_ptr<ProcessorHandle> handle(new ProcessorHandle());
-  PostMessage(Message::TYPE_TASK, [this, params = std::move(params), handle](Processor & processor)
-              {
-                DoSearch(std::move(params), handle, processor);
-              });
-  return handle;
+  {
+    lock_guard<mutex> lock(m_mu);
+    if (m_maxQueuedRequests == 0 || m_numQueuedRequests < m_maxQueuedRequests)
+    {
+      ++m_numQueuedRequests;
+      m_messages.emplace(Message::TYPE_TASK,
+                         [this, params = std::move(params), queueTimer = base::Timer(),
+                          handle](Processor & processor)
+                         {
+                           DoSearch(std::move(params), queueTimer, handle, processor);
+                         });
+      m_cv.notify_one();
+
+      lock_guard<mutex> statsLock(m_statsMu);
+      ++m_stats.m_accepted;
+      return handle;
+    }
+  }
+
+  LOG(LWARNING, ("Search request is rejected, queue is full:", params.m_query));
+  {
+    lock_guard<mutex> lock(m_statsMu);
+    ++m_stats.m_rejected;
+  }
+  FinishUnprocessed(params);
+  return {};
+}
+
+Engine::Stats Engine::GetStats() const
+{
+  Stats stats;
+  {
+    lock_guard<mutex> lock(m_statsMu);
+    stats = m_stats;
+  }
+  tie(stats.m_categoriesCacheHits, stats.m_categoriesCacheMisses) =
+      m_categoriesCacheStorage.GetHitsAndMisses();
+  return stats;
 }
 
 void Engine::SetLocale(string const & locale)
@@ -137,6 +181,7 @@ size_t Engine::GetNumThreads() const { return m_threads.size(); }
 
 void Engine::ClearCaches()
 {
+  m_categoriesCacheStorage.Clear();
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
@@ -253,6 +298,8 @@ void Engine::MainLoop(Context & context)
       // next free search thread.
       if (!m_messages.empty())
       {
+        ASSERT_GREATER(m_numQueuedRequests, 0, ());
+        --m_numQueuedRequests;
         context.m_messages.push(std::move(m_messages.front()));
         m_messages.pop();
       }
@@ -279,13 +326,40 @@ void Engine::PostMessage(Args &&... args)
   m_cv.notify_one();
 }
 
-void Engine::DoSearch(SearchParams params, shared_ptr<ProcessorHandle> handle, Processor & processor)
+void Engine::DoSearch(SearchParams params, base::Timer const & queueTimer,
+                      shared_ptr<ProcessorHandle> handle, Processor & processor)
 {
+  auto const queueTime = queueTimer.TimeElapsed();
+  double const queueTimeMs = chrono::duration<double, milli>(queueTime).count();
+  {
+    lock_guard<mutex> lock(m_statsMu);
+    m_stats.m_totalQueueTimeMs += queueTimeMs;
+    m_stats.m_maxQueueTimeMs = max(m_stats.m_maxQueueTimeMs, queueTimeMs);
+  }
+
+  if (queueTime >= params.m_timeout)
+  {
+    LOG(LWARNING, ("Search request is expired in the queue after", queueTimeMs, "ms."));
+    {
+      lock_guard<mutex> lock(m_statsMu);
+      ++m_stats.m_expired;
+    }
+    FinishUnprocessed(params);
+    return;
+  }
+  params.m_timeout -= queueTime;
+
   LOG(LINFO, ("Search started:", params.m_mode, params.m_viewport));
   base::Timer timer;
-  SCOPE_GUARD(printDuration, [&timer]()
+  SCOPE_GUARD(printDuration, [&]()
   {
-    LOG(LINFO, ("Search ended in", timer.ElapsedMilliseconds(), "ms."));
+    double const processingTimeMs = timer.ElapsedMilliseconds();
+    LOG(LINFO, ("Search ended in", processingTimeMs, "ms."));
+
+    lock_guard<mutex> lock(m_statsMu);
+    ++m_stats.m_processed;
+    m_stats.m_totalProcessingTimeMs += processingTimeMs;
+    m_stats.m_maxProcessingTimeMs = max(m_stats.m_maxProcessingTimeMs, processingTimeMs);
   });
 
   processor.Reset();
@@ -294,4 +368,18 @@ void Engine::DoSearch(SearchParams params, shared_ptr<ProcessorHandle> handle, P
 
   processor.Search(std::move(params));
 }
+
+// static
+void Engine::FinishUnprocessed(SearchParams const & params)
+{
+  if (params.m_onStarted)
+    params.m_onStarted();
+
+  if (params.m_onResults)
+  {
+    Results results;
+    results.SetEndMarker(true /* cancelled */);
+    params.m_onResults(results);
+  }
+}
 }  // namespace search
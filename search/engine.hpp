@@ -1,5 +1,6 @@
 #pragma once
 
+#include "search/categories_cache.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
 
@@ -7,8 +8,11 @@
 
 #include "base/macros.hpp"
 #include "base/thread.hpp"
+#include "base/thread_pool_work_stealing.hpp"
+#include "base/timer.hpp"
 
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -80,6 +84,39 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // Number of threads shared by all queries to retrieve features of several mwms
+    // in parallel, see Geocoder::SetRetrievalThreadPool(). Zero disables the pool.
+    size_t m_numRetrievalThreads = 0;
+
+    // Max number of search requests waiting for a free thread. When the queue is full,
+    // new requests are rejected. Zero means no limit.
+    size_t m_maxQueuedRequests = 0;
+
+    // Memory limit of the categories caches (streets, villages, hotels and so on) which are
+    // shared by all the search threads.
+    size_t m_categoriesCacheMaxBytes = 32 * 1024 * 1024;
+  };
+
+  // Counters of search requests since the engine was created.
+  struct Stats
+  {
+    uint64_t m_accepted = 0;
+    // Requests rejected because the queue was full.
+    uint64_t m_rejected = 0;
+    // Requests whose timeout expired while they were waiting in the queue.
+    uint64_t m_expired = 0;
+    // Requests which have been processed, including cancelled ones.
+    uint64_t m_processed = 0;
+
+    double m_totalQueueTimeMs = 0.0;
+    double m_maxQueueTimeMs = 0.0;
+    double m_totalProcessingTimeMs = 0.0;
+    double m_maxProcessingTimeMs = 0.0;
+
+    // Accesses of the categories caches storage shared by the search threads.
+    uint64_t m_categoriesCacheHits = 0;
+    uint64_t m_categoriesCacheMisses = 0;
   };
 
   // Doesn't take ownership of dataSource and categories.
@@ -88,8 +125,14 @@ public:
   ~Engine();
 
   // Posts search request to the queue and returns its handle.
+  // The time the request waits in the queue counts towards |params.m_timeout|.
+  // A request which is rejected (see Params::m_maxQueuedRequests) or expires in the queue
+  // is finished as cancelled without processing: |params.m_onStarted| and |params.m_onResults|
+  // with an end marker are called.
   std::weak_ptr<ProcessorHandle> Search(SearchParams params);
 
+  Stats GetStats() const;
+
   // Sets default locale on all query processors.
   void SetLocale(std::string const & locale);
 
@@ -166,7 +209,11 @@ private:
   template <typename... Args>
   void PostMessage(Args &&... args);
 
-  void DoSearch(SearchParams params, std::shared_ptr<ProcessorHandle> handle, Processor & processor);
+  void DoSearch(SearchParams params, base::Timer const & queueTimer,
+                std::shared_ptr<ProcessorHandle> handle, Processor & processor);
+
+  // May be called on any thread.
+  static void FinishUnprocessed(SearchParams const & params);
 
   std::vector<Suggest> m_suggests;
 
@@ -174,7 +221,18 @@ private:
   std::mutex m_mu;
   std::condition_variable m_cv;
 
+  size_t const m_maxQueuedRequests;
+  // Number of task messages in |m_messages|. Guarded by |m_mu|.
+  size_t m_numQueuedRequests = 0;
+
+  mutable std::mutex m_statsMu;
+  Stats m_stats;
+
   std::queue<Message> m_messages;
+  // Shared by all processors, so it's destroyed after them.
+  std::unique_ptr<base::thread_pool::work_stealing::ThreadPool> m_retrievalPool;
+  CategoriesCacheStorage m_categoriesCacheStorage;
+
   std::vector<Context> m_contexts;
   std::vector<threads::SimpleThread> m_threads;
 };
@@ -85,8 +85,13 @@ bool MatchInTrie(trie::Iterator<ValueList> const & trieRoot, strings::UniChar co
     {
       auto const & edge = trieIt->m_edges[i];
 
+      // Labels of a compressed trie may be long, so stop as soon as the DFA rejects.
       auto curIt = dfaIt;
-      strings::DFAMove(curIt, edge.m_label.begin(), edge.m_label.end());
+      for (auto const c : edge.m_label)
+      {
+        if (curIt.Move(c).Rejects())
+          break;
+      }
       if (!curIt.Rejects())
         q.emplace(trieIt->GoToEdge(i), curIt);
     }
@@ -27,6 +27,7 @@ FeaturesLayerMatcher::FeaturesLayerMatcher(DataSource const & dataSource,
   , m_reverseGeocoder(dataSource)
   , m_nearbyStreetsCache("FeatureToNearbyStreets")
   , m_matchingStreetsCache("BuildingToStreet")
+  , m_houseNumberParsesCache("BuildingToHouseNumberParses")
   , m_place2address("PlaceToAddresses")
   , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM)
   , m_cancellable(cancellable)
@@ -52,6 +53,7 @@ void FeaturesLayerMatcher::OnQueryFinished()
 {
   m_nearbyStreetsCache.ClearIfNeeded();
   m_matchingStreetsCache.ClearIfNeeded();
+  m_houseNumberParsesCache.ClearIfNeeded();
   m_place2address.ClearIfNeeded();
 
   m_loader.OnQueryFinished();
@@ -116,7 +116,7 @@ private:
 
   void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
 
-  static bool HouseNumbersMatch(FeatureType & feature, std::vector<house_numbers::Token> const & queryParse)
+  bool HouseNumbersMatch(FeatureType & feature, std::vector<house_numbers::Token> const & queryParse)
   {
     auto const interpol = ftypes::IsAddressInterpolChecker::Instance().GetInterpolType(feature);
     if (interpol != feature::InterpolType::None)
@@ -126,7 +126,19 @@ private:
     if (feature.GetID().IsEqualCountry({"Czech", "Slovakia"}))
       return house_numbers::HouseNumbersMatchConscription(uniHouse, queryParse);
 
-    return house_numbers::HouseNumbersMatch(uniHouse, queryParse);
+    auto const index = feature.GetID().m_index;
+    if (!m_context->IsUntouched(index))
+      return house_numbers::HouseNumbersMatch(uniHouse, queryParse);
+
+    if (!house_numbers::HouseNumbersMayMatch(uniHouse, queryParse))
+      return false;
+
+    // The same buildings are checked for every street and query, so their house numbers are
+    // parsed only once.
+    auto entry = m_houseNumberParsesCache.Get(index);
+    if (entry.second)
+      house_numbers::ParseHouseNumber(uniHouse, entry.first);
+    return house_numbers::HouseNumbersMatch(entry.first, queryParse);
   }
 
   template <typename Fn>
@@ -155,16 +167,7 @@ private:
     BailIfCancelled();
 
     std::vector<PointRectMatcher::PointIdPair> poiCenters;
-    poiCenters.reserve(pois.size());
-
-    for (size_t i = 0; i < pois.size(); ++i)
-    {
-      if (auto poiFt = GetByIndex(pois[i]))
-      {
-        poiCenters.emplace_back(feature::GetCenter(*poiFt, FeatureType::WORST_GEOMETRY),
-                                i /* id */);
-      }
-    }
+    LoadCenters(pois, poiCenters);
 
     std::vector<PointRectMatcher::RectIdPair> buildingRects;
     buildingRects.reserve(buildings.size());
@@ -211,12 +214,12 @@ private:
     if (queryParse.empty())
       return;
 
-    for (size_t i = 0; i < pois.size(); ++i)
+    for (auto const & poiCenter : poiCenters)
     {
       BailIfCancelled();
 
       m_context->ForEachFeature(
-          mercator::RectByCenterXYAndSizeInMeters(poiCenters[i].m_point, maxRadius),
+          mercator::RectByCenterXYAndSizeInMeters(poiCenter.m_point, maxRadius),
           [&](FeatureType & ft)
           {
             BailIfCancelled();
@@ -229,9 +232,9 @@ private:
             if (HouseNumbersMatch(ft, queryParse))
             {
               double const distanceM =
-                  mercator::DistanceOnEarth(feature::GetCenter(ft), poiCenters[i].m_point);
+                  mercator::DistanceOnEarth(feature::GetCenter(ft), poiCenter.m_point);
               if (distanceM < maxRadius)
-                fn(pois[i], ft.GetID().m_index);
+                fn(pois[poiCenter.m_id], ft.GetID().m_index);
             }
           });
     }
@@ -249,16 +252,7 @@ private:
     auto const & streets = *parent.m_sortedFeatures;
 
     std::vector<PointRectMatcher::PointIdPair> poiCenters;
-    poiCenters.reserve(pois.size());
-
-    for (size_t i = 0; i < pois.size(); ++i)
-    {
-      if (auto poiFt = GetByIndex(pois[i]))
-      {
-        poiCenters.emplace_back(feature::GetCenter(*poiFt, FeatureType::WORST_GEOMETRY),
-                                i /* id */);
-      }
-    }
+    LoadCenters(pois, poiCenters);
 
     std::vector<PointRectMatcher::RectIdPair> streetRects;
     streetRects.reserve(streets.size());
@@ -303,7 +297,12 @@ private:
                             [&](size_t poiId, size_t streetId) {
                               ASSERT_LESS(poiId, pois.size(), ());
                               ASSERT_LESS(streetId, streets.size(), ());
-                              auto const & poiCenter = poiCenters[poiId].m_point;
+                              // |poiCenters| are sorted by ids but may skip deleted POIs.
+                              auto const it = std::lower_bound(
+                                  poiCenters.begin(), poiCenters.end(), poiId,
+                                  [](auto const & p, size_t id) { return p.m_id < id; });
+                              ASSERT(it != poiCenters.end() && it->m_id == poiId, ());
+                              auto const & poiCenter = it->m_point;
                               ProjectionOnStreet proj;
                               if (streetProjectors[streetId].GetProjection(poiCenter, proj) &&
                                   proj.m_distMeters < kStreetRadiusMeters)
@@ -460,6 +459,42 @@ private:
 
   Streets const & GetNearbyStreets(FeatureType & feature);
 
+  // Fills |centers| with the centers of |ids| and their positions in |ids|. The centers of
+  // untouched features are decoded in one pass over the centers table, so only the features
+  // without a center in the table or edited by the user are loaded.
+  void LoadCenters(std::vector<uint32_t> const & ids,
+                   std::vector<PointRectMatcher::PointIdPair> & centers)
+  {
+    centers.clear();
+    centers.reserve(ids.size());
+
+    size_t i = 0;
+    auto const loadFeatures = [&](size_t end)
+    {
+      for (; i < end; ++i)
+      {
+        if (auto ft = GetByIndex(ids[i]))
+          centers.emplace_back(feature::GetCenter(*ft, FeatureType::WORST_GEOMETRY), i /* id */);
+      }
+    };
+
+    m_context->ForEachCenter(ids, [&](uint32_t id, m2::PointD const & center)
+    {
+      // |ids| are sorted and unique, so the position of |id| is after the previous one.
+      auto const end = static_cast<size_t>(
+          std::lower_bound(ids.begin() + i, ids.end(), id) - ids.begin());
+      ASSERT_LESS(end, ids.size(), ());
+      loadFeatures(end);
+
+      if (m_context->IsUntouched(id))
+        centers.emplace_back(center, i /* id */);
+      else
+        loadFeatures(i + 1);
+      i = end + 1;
+    });
+    loadFeatures(ids.size());
+  }
+
   std::unique_ptr<FeatureType> GetByIndex(uint32_t id) const
   {
     /// @todo Add Cache for feature id -> (point, name / house number).
@@ -487,6 +522,9 @@ private:
   // located on multiple streets.
   Cache<uint32_t, uint32_t> m_matchingStreetsCache;
 
+  // Cache of parsed house numbers of buildings which are not edited by the user.
+  Cache<uint32_t, std::vector<house_numbers::TokensT>> m_houseNumberParsesCache;
+
   // Cache of addresses that belong to a place (city/village).
   Cache<uint32_t, std::vector<uint32_t>> m_place2address;
 
@@ -5,10 +5,13 @@
 
 #include "indexer/features_vector.hpp"
 
+#include "base/arena.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <deque>
+#include <functional>
 #include <unordered_map>
+#include <utility>
 
 namespace search
 {
@@ -19,7 +22,11 @@ FeaturesLayerPathFinder::Mode FeaturesLayerPathFinder::m_mode = MODE_AUTO;
 
 namespace
 {
-using ParentGraph = deque<unordered_map<uint32_t, uint32_t>>;
+// Parent maps are filled by millions of edges for wide queries and are dropped right after the
+// pass, so their nodes are taken from an arena.
+using ParentMap = unordered_map<uint32_t, uint32_t, hash<uint32_t>, equal_to<uint32_t>,
+                                base::ArenaAllocator<pair<uint32_t const, uint32_t>>>;
+using ParentGraph = deque<ParentMap>;
 
 // This function tries to estimate amount of work needed to perform an
 // intersection pass on a sequence of layers.
@@ -112,6 +119,7 @@ void FeaturesLayerPathFinder::FindReachableVerticesTopDown(
   vector<uint32_t> reachable = *(layers.back()->m_sortedFeatures);
   vector<uint32_t> buffer;
 
+  base::Arena arena;
   ParentGraph parentGraph;
 
   auto addEdge = [&](uint32_t childFeature, uint32_t parentFeature) {
@@ -126,7 +134,7 @@ void FeaturesLayerPathFinder::FindReachableVerticesTopDown(
   {
     BailIfCancelled();
 
-    parentGraph.emplace_back();
+    parentGraph.emplace_back(ParentMap::allocator_type(arena));
     FeaturesLayer parent(*layers[i]);
     if (i != layers.size() - 1)
       base::SortUnique(reachable);
@@ -164,6 +172,7 @@ void FeaturesLayerPathFinder::FindReachableVerticesBottomUp(
   vector<uint32_t> reachable = *(layers.front()->m_sortedFeatures);
   vector<uint32_t> buffer;
 
+  base::Arena arena;
   ParentGraph parentGraph;
 
   // It is possible that there are delayed features on the lowest level.
@@ -191,7 +200,7 @@ void FeaturesLayerPathFinder::FindReachableVerticesBottomUp(
   {
     BailIfCancelled();
 
-    parentGraph.emplace_front();
+    parentGraph.emplace_front(ParentMap::allocator_type(arena));
     FeaturesLayer child(*layers[i]);
     if (i != 0)
       base::SortUnique(reachable);
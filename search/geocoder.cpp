@@ -8,6 +8,7 @@
 #include "search/house_to_street_table.hpp"
 #include "search/locality_scorer.hpp"
 #include "search/pre_ranker.hpp"
+#include "search/ranking_info.hpp"
 #include "search/retrieval.hpp"
 #include "search/token_slice.hpp"
 #include "search/tracer.hpp"
@@ -36,8 +37,11 @@
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_work_stealing.hpp"
 
 #include <algorithm>
+#include <future>
+#include <map>
 
 #include "defines.hpp"
 
@@ -71,6 +75,8 @@ size_t constexpr kPivotRectsCacheSize = 10;
 size_t constexpr kPostcodesRectsCacheSize = 10;
 size_t constexpr kSuburbsRectsCacheSize = 10;
 size_t constexpr kLocalityRectsCacheSize = 10;
+size_t constexpr kTokenFeaturesCacheSize = 16;
+size_t constexpr kRankTablesCacheSize = 8;
 
 UniString const kUniSpace(MakeUniString(" "));
 
@@ -108,63 +114,22 @@ struct ScopedMarkTokens
 // static
 BaseContext::TokenType constexpr ScopedMarkTokens::kUnused;
 
-class LazyRankTable : public RankTable
-{
-public:
-  explicit LazyRankTable(MwmValue const & value) : m_value(value) {}
-
-  uint8_t Get(uint64_t i) const override
-  {
-    EnsureTableLoaded();
-    return m_table->Get(i);
-  }
-
-  uint64_t Size() const override
-  {
-    EnsureTableLoaded();
-    return m_table->Size();
-  }
-
-  RankTable::Version GetVersion() const override
-  {
-    EnsureTableLoaded();
-    return m_table->GetVersion();
-  }
-
-  void Serialize(Writer & writer) override
-  {
-    EnsureTableLoaded();
-    m_table->Serialize(writer);
-  }
-
-private:
-  void EnsureTableLoaded() const
-  {
-    if (m_table)
-      return;
-    m_table = search::RankTable::Load(m_value.m_cont, SEARCH_RANKS_FILE_TAG);
-    if (!m_table)
-      m_table = make_unique<search::DummyRankTable>();
-  }
-
-  MwmValue const & m_value;
-  mutable unique_ptr<search::RankTable> m_table;
-};
-
 class LocalityScorerDelegate : public LocalityScorer::Delegate
 {
 public:
   LocalityScorerDelegate(MwmContext & context, Geocoder::Params const & params,
                          function<bool(m2::PointD const &)> const & belongsToMatchedRegionFn,
+                         function<RankTable const &()> const & getRanksFn,
                          base::Cancellable const & cancellable)
     : m_context(context)
     , m_params(params)
     , m_cancellable(cancellable)
     , m_belongsToMatchedRegionFn(belongsToMatchedRegionFn)
+    , m_getRanksFn(getRanksFn)
     , m_retrieval(m_context, m_cancellable)
-    , m_ranks(m_context.m_value)
   {
     ASSERT(m_belongsToMatchedRegionFn, ());
+    ASSERT(m_getRanksFn, ());
   }
 
   // LocalityScorer::Delegate overrides:
@@ -181,7 +146,13 @@ public:
     }
   }
 
-  uint8_t GetRank(uint32_t featureId) const override { return m_ranks.Get(featureId); }
+  uint8_t GetRank(uint32_t featureId) const override
+  {
+    // The table is taken only when it's needed, there may be no candidates.
+    if (!m_ranks)
+      m_ranks = &m_getRanksFn();
+    return m_ranks->Get(featureId);
+  }
 
   optional<m2::PointD> GetCenter(uint32_t featureId) override
   {
@@ -210,10 +181,11 @@ private:
   Geocoder::Params const & m_params;
   base::Cancellable const & m_cancellable;
   function<bool(m2::PointD const &)> m_belongsToMatchedRegionFn;
+  function<RankTable const &()> m_getRanksFn;
 
   Retrieval m_retrieval;
 
-  LazyRankTable m_ranks;
+  mutable RankTable const * m_ranks = nullptr;
 };
 
 void JoinQueryTokens(QueryParams const & params, TokenRange const & range, UniString const & sep,
@@ -284,6 +256,24 @@ double GetDistanceMeters(m2::PointD const & pivot, m2::RectD const & rect)
   return distance;
 }
 
+// Returns a string which identifies the retrieval request for the |i|-th token:
+// features retrieved for equal keys are equal.
+string MakeTokenFeaturesKey(QueryParams const & params, size_t i)
+{
+  string key = params.IsPrefixToken(i) ? "p" : "f";
+  params.GetToken(i).ForOriginalAndSynonyms([&key](UniString const & s) {
+    key += '\x1f';
+    key += ToUtf8(s);
+  });
+  key += '\x1e';
+  for (auto const index : params.GetTypeIndices(i))
+    key += std::to_string(index) + ',';
+  key += '\x1e';
+  for (auto const lang : params.GetLangs())
+    key += std::to_string(lang) + ',';
+  return key;
+}
+
 unique_ptr<MwmContext> GetWorldContext(DataSource const & dataSource)
 {
   vector<shared_ptr<MwmInfo>> infos;
@@ -301,11 +291,12 @@ unique_ptr<MwmContext> GetWorldContext(DataSource const & dataSource)
 
 
 // Geocoder::LocalitiesCaches ----------------------------------------------------------------------
-Geocoder::LocalitiesCaches::LocalitiesCaches(base::Cancellable const & cancellable)
-  : m_countries(cancellable)
-  , m_states(cancellable)
-  , m_citiesTownsOrVillages(cancellable)
-  , m_villages(cancellable)
+Geocoder::LocalitiesCaches::LocalitiesCaches(base::Cancellable const & cancellable,
+                                             CategoriesCacheStorage * storage)
+  : m_countries(cancellable, storage)
+  , m_states(cancellable, storage)
+  , m_citiesTownsOrVillages(cancellable, storage)
+  , m_villages(cancellable, storage)
 {
 }
 
@@ -321,15 +312,16 @@ void Geocoder::LocalitiesCaches::Clear()
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories,
                    CitiesBoundariesTable const & citiesBoundaries, PreRanker & preRanker,
-                   LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable)
+                   LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable,
+                   CategoriesCacheStorage * categoriesCacheStorage)
   : m_dataSource(dataSource)
   , m_infoGetter(infoGetter)
   , m_categories(categories)
-  , m_streetsCache(cancellable)
-  , m_suburbsCache(cancellable)
+  , m_streetsCache(cancellable, categoriesCacheStorage)
+  , m_suburbsCache(cancellable, categoriesCacheStorage)
   , m_localitiesCaches(localitiesCaches)
-  , m_hotelsCache(cancellable)
-  , m_foodCache(cancellable)
+  , m_hotelsCache(cancellable, categoriesCacheStorage)
+  , m_foodCache(cancellable, categoriesCacheStorage)
   , m_cuisineFilter(m_foodCache)
   , m_cancellable(cancellable)
   , m_citiesBoundaries(citiesBoundaries)
@@ -337,6 +329,7 @@ Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter con
   , m_postcodesRectsCache(kPostcodesRectsCacheSize, m_cancellable, kMaxPostcodeRadiusM)
   , m_suburbsRectsCache(kSuburbsRectsCacheSize, m_cancellable, kMaxSuburbRadiusM)
   , m_localityRectsCache(kLocalityRectsCacheSize, m_cancellable)
+  , m_tokenFeaturesCache(kTokenFeaturesCacheSize)
   , m_filter(nullptr)
   , m_matcher(nullptr)
   , m_finder(m_cancellable)
@@ -366,8 +359,10 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenFeaturesKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    m_tokenFeaturesKeys.push_back(MakeTokenFeaturesKey(m_params, i));
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
@@ -432,8 +427,10 @@ void Geocoder::ClearCaches()
 {
   m_pivotRectsCache.Clear();
   m_localityRectsCache.Clear();
+  m_tokenFeaturesCache.Clear();
 
   m_matchersCache.clear();
+  m_rankTables.clear();
   m_streetsCache.Clear();
   m_hotelsCache.Clear();
   m_foodCache.Clear();
@@ -449,6 +446,11 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
 
+  string key = "c";
+  for (auto const type : m_params.m_preferredTypes)
+    key += ',' + std::to_string(type);
+  m_tokenFeaturesKeys.assign(m_params.GetNumTokens(), key);
+
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
 }
 
@@ -541,6 +543,8 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 {
   // base::PProf pprof("/tmp/geocoder.prof");
 
+  m_retrievalTime = {};
+
   // Tries to find world and fill localities table.
   {
     m_cities.clear();
@@ -580,6 +584,48 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
   // found.
   auto const infosWithType = OrderCountries(inViewport, infos);
 
+  // Token features retrieval doesn't depend on the results of the previous mwms, so with
+  // |m_retrievalPool| it's done for several next mwms in advance while the layers of the current
+  // mwm are matched here. Matching and emitting stay on this thread in the same mwms order,
+  // so PreRanker gets exactly the same input as without the pool.
+  map<MwmSet::MwmId, future<TokensFeatures>> prefetched;
+  size_t nextToPrefetch = 0;
+  auto const prefetch = [&](size_t count) {
+    if (!m_retrievalPool)
+      return;
+
+    auto const & extendedInfos = infosWithType.m_infos;
+    for (; count > 0 && nextToPrefetch < extendedInfos.size(); ++nextToPrefetch)
+    {
+      auto const & info = extendedInfos[nextToPrefetch].m_info;
+      if (!IsSearchableMwm(*info))
+        continue;
+
+      MwmSet::MwmId const id(info);
+      auto const type = extendedInfos[nextToPrefetch].m_type;
+      auto result = m_retrievalPool->Submit([this, id, type]() {
+        // The handle locks its own MwmValue, so the readers are not shared with this thread.
+        auto handle = m_dataSource.GetMwmHandleById(id);
+        if (!handle.IsAlive() || !handle.GetValue()->HasSearchIndex())
+          return TokensFeatures();
+        return RetrieveTokensFeatures(MwmContext(std::move(handle), type));
+      });
+      if (result.valid())
+        prefetched.emplace(id, std::move(result));
+      --count;
+    }
+  };
+
+  // Tasks refer to the geocoder, so all of them must be finished before leaving,
+  // including the break on a full PreRanker and the cancellation.
+  SCOPE_GUARD(waitPrefetched, [&]() {
+    for (auto & p : prefetched)
+      p.second.wait();
+  });
+
+  if (m_retrievalPool)
+    prefetch(m_retrievalPool->GetThreadCount() * 2);
+
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
   auto processCountry = [&](unique_ptr<MwmContext> context, bool updatePreranker) {
@@ -604,8 +650,23 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
     m_matcher = it->second.get();
     m_matcher->SetContext(m_context.get());
 
+    base::Timer retrievalTimer;
+    TokensFeatures tokensFeatures;
+    auto const prefetchedIt = prefetched.find(m_context->GetId());
+    if (prefetchedIt != prefetched.end())
+    {
+      auto result = std::move(prefetchedIt->second);
+      prefetched.erase(prefetchedIt);
+      prefetch(1);
+      // Rethrows CancelException from the pool thread.
+      tokensFeatures = result.get();
+    }
+    if (tokensFeatures.size() != m_params.GetNumTokens())
+      tokensFeatures = RetrieveTokensFeatures(*m_context);
+    m_retrievalTime += retrievalTimer.TimeElapsed();
+
     BaseContext ctx;
-    InitBaseContext(ctx);
+    InitBaseContext(ctx, std::move(tokensFeatures));
 
     if (inViewport)
     {
@@ -621,7 +682,11 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
     FillVillageLocalities(ctx);
     SCOPE_GUARD(remove_villages, [&]() { m_cities = citiesFromWorld; });
 
-    if (m_params.IsCategorialRequest())
+    if (!m_preRanker.CanGetIntoTop(GetMaxLinearModelRankInMwm()))
+    {
+      LOG(LDEBUG, ("Skipping", m_context->GetName(), "which can't improve the top results."));
+    }
+    else if (m_params.IsCategorialRequest())
     {
       MatchCategories(ctx, m_context->GetType().m_viewportIntersected /* aroundPivot */);
     }
@@ -652,31 +717,45 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  base::Timer retrievalTimer;
+  auto features = RetrieveTokensFeatures(*m_context);
+  m_retrievalTime += retrievalTimer.TimeElapsed();
+  InitBaseContext(ctx, std::move(features));
+}
 
+void Geocoder::InitBaseContext(BaseContext & ctx, TokensFeatures && features)
+{
   size_t const numTokens = m_params.GetNumTokens();
+  CHECK_EQUAL(features.size(), numTokens, ());
+
   ctx.m_tokens.assign(numTokens, BaseContext::TOKEN_TYPE_COUNT);
-  ctx.m_features.resize(numTokens);
+  ctx.m_features = std::move(features);
+  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+}
+
+Geocoder::TokensFeatures Geocoder::RetrieveTokensFeatures(MwmContext const & context) const
+{
+  Retrieval retrieval(context, m_cancellable);
+
+  size_t const numTokens = m_params.GetNumTokens();
+  CHECK_EQUAL(m_tokenFeaturesKeys.size(), numTokens, ());
+  TokensFeatures features(numTokens);
   for (size_t i = 0; i < numTokens; ++i)
   {
-    if (m_params.IsCategorialRequest())
-    {
-      // Implementation-wise, the simplest way to match a feature by
-      // its category bypassing the matching by name is by using a CategoriesCache.
-      CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
-      ctx.m_features[i] = Retrieval::ExtendedFeatures(cache.Get(*m_context));
-    }
-    else if (m_params.IsPrefixToken(i))
-    {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
-    }
-    else
-    {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
-    }
+    features[i] = m_tokenFeaturesCache.Get(context.GetId(), m_tokenFeaturesKeys[i], [&]() {
+      if (m_params.IsCategorialRequest())
+      {
+        // Implementation-wise, the simplest way to match a feature by
+        // its category bypassing the matching by name is by using a CategoriesCache.
+        CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
+        return Retrieval::ExtendedFeatures(cache.Get(context));
+      }
+      if (m_params.IsPrefixToken(i))
+        return retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      return retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+    });
   }
-
-  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+  return features;
 }
 
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
@@ -716,11 +795,37 @@ void Geocoder::FillLocalityCandidates(BaseContext const & ctx, CBV const & filte
     return m_infoGetter.BelongsToAnyRegion(point, ids);
   };
 
-  LocalityScorerDelegate delegate(*m_context, m_params, belongsToMatchedRegion, m_cancellable);
+  auto const getRanks = [this]() -> RankTable const & { return GetRankTable(*m_context); };
+
+  LocalityScorerDelegate delegate(*m_context, m_params, belongsToMatchedRegion, getRanks,
+                                  m_cancellable);
   LocalityScorer scorer(m_params, m_params.m_pivot.Center(), delegate);
   scorer.GetTopLocalities(m_context->GetId(), ctx, filter, maxNumLocalities, preLocalities);
 }
 
+RankTable const & Geocoder::GetRankTable(MwmContext const & context)
+{
+  auto const id = context.GetId();
+  auto it = find_if(m_rankTables.begin(), m_rankTables.end(),
+                    [&id](auto const & entry) { return entry.first == id; });
+  if (it == m_rankTables.end())
+  {
+    // The table is a copy of the section, so it stays valid when the mwm is closed.
+    unique_ptr<RankTable> table = RankTable::Load(context.m_value.m_cont, SEARCH_RANKS_FILE_TAG);
+    if (!table)
+      table = make_unique<DummyRankTable>();
+
+    if (m_rankTables.size() == kRankTablesCacheSize)
+      m_rankTables.pop_back();
+    it = m_rankTables.emplace(m_rankTables.begin(), id, std::move(table));
+  }
+  else if (it != m_rankTables.begin())
+  {
+    m_rankTables.splice(m_rankTables.begin(), m_rankTables, it);
+  }
+  return *it->second;
+}
+
 void Geocoder::CacheWorldLocalities()
 {
   if (auto context = GetWorldContext(m_dataSource))
@@ -891,15 +996,44 @@ bool Geocoder::CityHasPostcode(BaseContext const & ctx) const
   return m_postcodes.Has(ctx.m_city->GetFeatureIndex(), ctx.m_city->m_featureId.IsWorld());
 }
 
+double Geocoder::GetMaxLinearModelRankInMwm() const
+{
+  // GetDistanceMeters() finds the closest point in mercator, so leave some slack.
+  double constexpr kDistanceSlack = 0.9;
+
+  auto const & rect = m_context->GetInfo()->m_bordersRect;
+  // Ranker measures the distance from the matched city center, when there is one, and
+  // the results matched with a city lie in its rect.
+  bool nearMatchedCity = false;
+  for (auto const & p : m_cities)
+  {
+    nearMatchedCity = any_of(p.second.begin(), p.second.end(),
+                             [&rect](City const & city) { return city.m_rect.IsIntersect(rect); });
+    if (nearMatchedCity)
+      break;
+  }
+
+  double const distance =
+      nearMatchedCity ? 0.0 : kDistanceSlack * GetDistanceMeters(m_params.m_pivot.Center(), rect);
+  auto constexpr kMaxRank = numeric_limits<uint8_t>::max();
+  return RankingInfo::GetMaxLinearModelRank(distance, kMaxRank /* rank */, kMaxRank /* popularity */,
+                                            m_params.IsCategorialRequest());
+}
+
+bool Geocoder::IsSearchableMwm(MwmInfo const & info) const
+{
+  if (info.GetType() != MwmInfo::COUNTRY && info.GetType() != MwmInfo::WORLD)
+    return false;
+  return info.GetType() != MwmInfo::COUNTRY || m_params.m_mode != Mode::Downloader;
+}
+
 template <typename Fn>
 void Geocoder::ForEachCountry(ExtendedMwmInfos const & extendedInfos, Fn && fn)
 {
   for (size_t i = 0; i < extendedInfos.m_infos.size(); ++i)
   {
     auto const & info = extendedInfos.m_infos[i].m_info;
-    if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
-      continue;
-    if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
+    if (!IsSearchableMwm(*info))
       continue;
 
     auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(info));
@@ -928,8 +1062,11 @@ void Geocoder::MatchCategories(BaseContext & ctx, bool aroundPivot)
   {
     auto const pivotFeatures =
         RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RectId::Pivot);
-    ViewportFilter filter(pivotFeatures, m_preRanker.Limit() /* threshold */);
-    features.m_features = filter.Filter(features.m_features);
+    auto const inPivot = features.m_features.Intersect(pivotFeatures);
+    // When there are no features of the category around the pivot, e.g. in rural areas, the
+    // nearest ones are taken instead of the first ones by ids.
+    features.m_features =
+        inPivot.IsEmpty() ? TakeNearestToPivot(features.m_features, m_preRanker.Limit()) : inPivot;
     features.m_exactMatchingFeatures =
         features.m_exactMatchingFeatures.Intersect(features.m_features);
   }
@@ -948,6 +1085,36 @@ void Geocoder::MatchCategories(BaseContext & ctx, bool aroundPivot)
  });
 }
 
+CBV Geocoder::TakeNearestToPivot(CBV const & features, size_t n)
+{
+  if (features.PopCount() <= n)
+    return features;
+
+  vector<uint32_t> ids;
+  features.ForEach([&ids](uint64_t id) { ids.push_back(base::asserted_cast<uint32_t>(id)); });
+
+  // Features which are not in the centers table, i.e. created by the editor, are skipped.
+  auto const pivot = m_params.m_pivot.Center();
+  vector<pair<double, uint64_t>> distances;
+  distances.reserve(ids.size());
+  m_context->ForEachCenter(ids, [&](uint32_t id, m2::PointD const & center) {
+    distances.emplace_back(pivot.SquaredLength(center), id);
+  });
+
+  if (distances.size() > n)
+  {
+    nth_element(distances.begin(), distances.begin() + n, distances.end());
+    distances.resize(n);
+  }
+
+  vector<uint64_t> nearest;
+  nearest.reserve(distances.size());
+  for (auto const & d : distances)
+    nearest.push_back(d.second);
+  sort(nearest.begin(), nearest.end());
+  return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(std::move(nearest)));
+}
+
 void Geocoder::MatchRegions(BaseContext & ctx, Region::Type type)
 {
   TRACE(MatchRegions);
@@ -1287,23 +1454,16 @@ void Geocoder::CentersFilter::ClusterizeStreets(std::vector<uint32_t> & streets,
   std::vector<std::tuple<double, m2::PointD, uint32_t>> loadedStreets;
   loadedStreets.reserve(streets.size());
 
-  // Calculate {distance, center, feature id}.
-  for (uint32_t fid : streets)
+  // Calculate {distance, center, feature id}. |streets| are sorted, so the centers are read at once.
+  geocoder.m_context->ForEachCenter(streets, [&](uint32_t fid, m2::PointD const & ftCenter)
   {
-    m2::PointD ftCenter;
-    if (geocoder.m_context->GetCenter(fid, ftCenter))
-    {
-      double minDist = std::numeric_limits<double>::max();
-      for (auto const & c : m_centers)
-        minDist = std::min(minDist, ftCenter.Length(c));
-      loadedStreets.emplace_back(minDist, ftCenter, fid);
-    }
-    else
-    {
-      // In general, we don't have centers for newly created features, but editor doesn't support streets now.
-      ASSERT(false, ("Street feature without table's center"));
-    }
-  }
+    double minDist = std::numeric_limits<double>::max();
+    for (auto const & c : m_centers)
+      minDist = std::min(minDist, ftCenter.Length(c));
+    loadedStreets.emplace_back(minDist, ftCenter, fid);
+  });
+  // In general, we don't have centers for newly created features, but editor doesn't support streets now.
+  ASSERT_EQUAL(loadedStreets.size(), streets.size(), ("Street feature without table's center"));
 
   // Sort by distance.
   std::sort(loadedStreets.begin(), loadedStreets.end(), [](auto const & t1, auto const & t2)
@@ -18,6 +18,7 @@
 #include "search/postcode_points.hpp"
 #include "search/query_params.hpp"
 #include "search/streets_matcher.hpp"
+#include "search/token_features_cache.hpp"
 #include "search/token_range.hpp"
 #include "search/tracer.hpp"
 
@@ -29,16 +30,24 @@
 #include "base/cancellable.hpp"
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
+#include "base/timer.hpp"
 
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 class CategoriesHolder;
 class DataSource;
 class MwmValue;
 
+namespace base::thread_pool::work_stealing
+{
+class ThreadPool;
+}  // namespace base::thread_pool::work_stealing
+
 namespace storage
 {
 class CountryInfoGetter;
@@ -49,6 +58,7 @@ namespace search
 class FeaturesFilter;
 class FeaturesLayerMatcher;
 class PreRanker;
+class RankTable;
 class TokenSlice;
 
 // This class is used to retrieve all features corresponding to a
@@ -88,7 +98,8 @@ public:
 
   struct LocalitiesCaches
   {
-    LocalitiesCaches(base::Cancellable const & cancellable);
+    LocalitiesCaches(base::Cancellable const & cancellable,
+                     CategoriesCacheStorage * storage = nullptr);
     void Clear();
 
     CountriesCache m_countries;
@@ -100,12 +111,21 @@ public:
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
            CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
            PreRanker & preRanker, LocalitiesCaches & localitiesCaches,
-           base::Cancellable const & cancellable);
+           base::Cancellable const & cancellable,
+           CategoriesCacheStorage * categoriesCacheStorage = nullptr);
   ~Geocoder();
 
   // Sets search query params.
   void SetParams(Params const & params);
 
+  // Sets the pool which retrieves token features of the next mwms while layers of the current
+  // mwm are matched. Without the pool all mwms are processed on the calling thread.
+  // Doesn't take ownership, |pool| must outlive the geocoder.
+  void SetRetrievalThreadPool(base::thread_pool::work_stealing::ThreadPool * pool)
+  {
+    m_retrievalPool = pool;
+  }
+
   // Starts geocoding, retrieved features will be appended to
   // |results|.
   void GoEverywhere();
@@ -127,6 +147,15 @@ public:
   void CacheWorldLocalities();
   void ClearCaches();
 
+  // Time spent by the last GoEverywhere() or GoInViewport() in getting features of the query
+  // tokens, including waiting for the retrieval pool.
+  base::Timer::DurationT RetrievalTime() const { return m_retrievalTime; }
+
+  TokenFeaturesCache::Stats GetTokenFeaturesCacheStats() const
+  {
+    return m_tokenFeaturesCache.GetStats();
+  }
+
 private:
   enum class RectId
   {
@@ -189,21 +218,38 @@ private:
 
   QueryParams::Token const & GetTokens(size_t i) const;
 
+  using TokensFeatures = std::vector<Retrieval::ExtendedFeatures>;
+
   // Creates a cache of posting lists corresponding to features in m_context
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
+  void InitBaseContext(BaseContext & ctx, TokensFeatures && features);
+
+  // Retrieves features for each token from |context|. Doesn't modify the geocoder state,
+  // so it may be called from |m_retrievalPool| threads.
+  TokensFeatures RetrieveTokensFeatures(MwmContext const & context) const;
 
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
   void FillLocalityCandidates(BaseContext const & ctx, CBV const & filter,
                               size_t const maxNumLocalities, std::vector<Locality> & preLocalities);
 
+  // Returns the search rank table of the mwm, loads it on the first request.
+  RankTable const & GetRankTable(MwmContext const & context);
+
   void FillLocalitiesTable(BaseContext const & ctx);
 
   void FillVillageLocalities(BaseContext const & ctx);
 
   bool CityHasPostcode(BaseContext const & ctx) const;
 
+  // Returns false for the mwms which are not searched in the current mode.
+  bool IsSearchableMwm(MwmInfo const & info) const;
+
+  // Returns an upper bound of the linear model rank of the results in the current mwm.
+  // Must be called after the villages of the mwm are added to |m_cities|.
+  double GetMaxLinearModelRankInMwm() const;
+
   template <typename Fn>
   void ForEachCountry(ExtendedMwmInfos const & infos, Fn && fn);
 
@@ -213,6 +259,9 @@ private:
   // A fast-path branch for categorial requests.
   void MatchCategories(BaseContext & ctx, bool aroundPivot);
 
+  // Returns at most |n| of |features| of the current mwm which are nearest to the pivot center.
+  CBV TakeNearestToPivot(CBV const & features, size_t n);
+
   // Tries to find all countries and states in a search query and then
   // performs matching of cities in found maps.
   void MatchRegions(BaseContext & ctx, Region::Type type);
@@ -324,6 +373,8 @@ private:
 
   base::Cancellable const & m_cancellable;
 
+  base::thread_pool::work_stealing::ThreadPool * m_retrievalPool = nullptr;
+
   // Geocoder params.
   Params m_params;
 
@@ -353,6 +404,12 @@ private:
   PivotRectsCache m_suburbsRectsCache;
   LocalityRectsCache m_localityRectsCache;
 
+  // Features retrieved for the query tokens. The cache lives across queries and
+  // is used from the retrieval pool threads, hence it's mutable.
+  mutable TokenFeaturesCache m_tokenFeaturesCache;
+
+  base::Timer::DurationT m_retrievalTime{};
+
   PostcodePointsCache m_postcodePointsCache;
 
   // Postcodes features in the mwm that is currently being processed and World.mwm.
@@ -361,6 +418,10 @@ private:
   // This filter is used to throw away excess features.
   FeaturesFilter const * m_filter;
 
+  // Search rank tables of the recently used mwms, the most recent first. They are kept
+  // between the queries, since the localities of World are scored on every keystroke.
+  std::list<std::pair<MwmSet::MwmId, std::unique_ptr<RankTable>>> m_rankTables;
+
   // Features matcher for layers intersection.
   std::map<MwmSet::MwmId, std::unique_ptr<FeaturesLayerMatcher>> m_matchersCache;
   FeaturesLayerMatcher * m_matcher;
@@ -371,6 +432,8 @@ private:
   // Search query params prepared for retrieval.
   std::vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
+  // Keys of |m_tokenFeaturesCache| for the query tokens.
+  std::vector<std::string> m_tokenFeaturesKeys;
 
   ResultTracer m_resultTracer;
 
@@ -560,22 +560,32 @@ void ParseQuery(UniString const & query, bool queryIsPrefix, TokensT & parse)
   SimplifyParse(parse);
 }
 
-bool HouseNumbersMatch(UniString const & houseNumber, TokensT const & queryParse)
+bool HouseNumbersMayMatch(UniString const & houseNumber, TokensT const & queryParse)
 {
   if (houseNumber.empty() || queryParse.empty())
     return false;
 
   // Fast pre-check, helps to early exit without complex house number parsing.
-  if (IsASCIIDigit(houseNumber[0]) && IsASCIIDigit(queryParse[0].m_value[0]) &&
-      houseNumber[0] != queryParse[0].m_value[0])
-  {
+  return !(IsASCIIDigit(houseNumber[0]) && IsASCIIDigit(queryParse[0].m_value[0]) &&
+           houseNumber[0] != queryParse[0].m_value[0]);
+}
+
+bool HouseNumbersMatch(UniString const & houseNumber, TokensT const & queryParse)
+{
+  if (!HouseNumbersMayMatch(houseNumber, queryParse))
     return false;
-  }
 
   vector<TokensT> houseNumberParses;
   ParseHouseNumber(houseNumber, houseNumberParses);
+  return HouseNumbersMatch(houseNumberParses, queryParse);
+}
+
+bool HouseNumbersMatch(vector<TokensT> const & houseNumberParses, TokensT const & queryParse)
+{
+  if (queryParse.empty())
+    return false;
 
-  for (auto & parse : houseNumberParses)
+  for (auto const & parse : houseNumberParses)
   {
     if (parse.empty())
       continue;
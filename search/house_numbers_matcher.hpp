@@ -69,9 +69,14 @@ void ParseHouseNumber(strings::UniString const & s, std::vector<TokensT> & parse
 // Parses a part of search query that can be a house number.
 void ParseQuery(strings::UniString const & query, bool queryIsPrefix, TokensT & parse);
 
+// Returns false if |houseNumber| surely doesn't match |queryParse|, without parsing it.
+bool HouseNumbersMayMatch(strings::UniString const & houseNumber, TokensT const & queryParse);
+
 /// @return true if house number matches to a given parsed query.
 /// @{
 bool HouseNumbersMatch(strings::UniString const & houseNumber, TokensT const & queryParse);
+// |houseNumberParses| are from ParseHouseNumber(), so they can be reused between the queries.
+bool HouseNumbersMatch(std::vector<TokensT> const & houseNumberParses, TokensT const & queryParse);
 bool HouseNumbersMatchConscription(strings::UniString const & houseNumber, TokensT const & queryParse);
 bool HouseNumbersMatchRange(std::string_view const & hnRange, TokensT const & queryParse, feature::InterpolType interpol);
 /// @}
@@ -8,6 +8,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class MwmValue;
 
@@ -31,6 +33,15 @@ public:
 
   [[nodiscard]] bool Get(uint32_t id, m2::PointD & center);
 
+  // See CentersTable::ForEachOf(), |ids| must be sorted.
+  template <typename Fn>
+  void ForEachOf(std::vector<uint32_t> const & ids, Fn && fn)
+  {
+    EnsureTableLoaded();
+    if (m_state == STATE_LOADED)
+      m_table->ForEachOf(ids, std::forward<Fn>(fn));
+  }
+
 private:
   MwmValue const & m_value;
   State m_state;
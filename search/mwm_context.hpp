@@ -18,6 +18,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 class MwmValue;
 
@@ -106,8 +107,22 @@ public:
     return m_centers.Get(index, center);
   }
 
+  // Calls |fn(index, center)| for the features with sorted |indexes| which have centers in the
+  // table, decoding the table much faster than GetCenter() for each of them.
+  template <typename Fn>
+  void ForEachCenter(std::vector<uint32_t> const & indexes, Fn && fn)
+  {
+    m_centers.ForEachOf(indexes, std::forward<Fn>(fn));
+  }
+
   std::optional<uint32_t> GetStreet(uint32_t index) const;
 
+  // Returns true if the feature isn't changed by the editor, so its data in the mwm is actual.
+  bool IsUntouched(uint32_t index) const
+  {
+    return GetEditedStatus(index) == FeatureStatus::Untouched;
+  }
+
   MwmSet::MwmHandle m_handle;
   MwmValue & m_value;
 
@@ -121,13 +136,12 @@ private:
   void ForEachIndexImpl(covering::Intervals const & intervals, uint32_t scale, Fn && fn) const
   {
     CheckUniqueIndexes checkUnique;
-    for (auto const & i : intervals)
-      m_index.ForEachInIntervalAndScale(i.first, i.second, scale,
-          [&](uint64_t /* key */, uint32_t value)
-          {
-            if (checkUnique(value))
-              fn(value);
-          });
+    m_index.ForEachInIntervalsAndScale(intervals, scale,
+        [&](uint64_t /* key */, uint32_t value)
+        {
+          if (checkUnique(value))
+            fn(value);
+        });
   }
 
   FeaturesVector m_vector;
@@ -9,6 +9,7 @@
 #include "geometry/mercator.hpp"
 
 #include "base/checked_cast.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
@@ -101,9 +102,15 @@ void PostcodePoints::Get(strings::UniString const & postcode, bool recursive,
         strings::UniString{});
   }
 
-  points.resize(indexes.size());
-  for (size_t i = 0; i < indexes.size(); ++i)
-    CHECK(m_points->Get(indexes[i], points[i]), ());
+  // Decodes every block of the points table once instead of once per postcode, it matters for
+  // the recursive lookups of postcode prefixes.
+  base::SortUnique(indexes);
+  points.reserve(indexes.size());
+  m_points->ForEachOf(indexes, [&points](uint32_t /* id */, m2::PointD const & point)
+  {
+    points.push_back(point);
+  });
+  CHECK_EQUAL(points.size(), indexes.size(), ());
 }
 
 void PostcodePoints::Get(strings::UniString const & postcode, vector<m2::PointD> & points) const
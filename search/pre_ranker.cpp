@@ -3,6 +3,7 @@
 #include "search/dummy_rank_table.hpp"
 #include "search/lazy_centers_table.hpp"
 #include "search/pre_ranking_info.hpp"
+#include "search/ranking_info.hpp"
 
 #include "editor/osm_editor.hpp"
 
@@ -13,10 +14,12 @@
 #include "geometry/mercator.hpp"
 #include "geometry/nearby_points_sweeper.hpp"
 
+#include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <random>
 
 namespace search
@@ -80,6 +83,8 @@ void PreRanker::Init(Params const & params)
 {
   m_numSentResults = 0;
   m_haveFullyMatchedResult = false;
+  m_preRankingTime = {};
+  m_rankingTime = {};
   m_results.clear();
   m_relaxedResults.clear();
   m_params = params;
@@ -91,71 +96,96 @@ void PreRanker::Finish(bool cancelled)
   m_ranker.Finish(cancelled);
 }
 
+bool PreRanker::CanGetIntoTop(double maxRank) const
+{
+  if (!m_params.m_earlyTermination || m_params.m_viewportSearch)
+    return true;
+  return maxRank > m_ranker.GetLimitRank();
+}
+
 void PreRanker::FillMissingFieldsInPreResults()
 {
-  MwmSet::MwmId mwmId;
-  MwmSet::MwmHandle mwmHandle;
-  unique_ptr<RankTable> ranks = make_unique<DummyRankTable>();
-  unique_ptr<RankTable> popularityRanks = make_unique<DummyRankTable>();
-  unique_ptr<LazyCentersTable> centers;
+  // Results are processed by mwms, so the tables of every mwm are loaded once and the ranks of
+  // all its results are read at once.
+  vector<PreRankerResult *> results;
+  results.reserve(m_results.size());
+  ForEachMwmOrder(m_results, [&results](PreRankerResult & r) { results.push_back(&r); });
+
   bool pivotFeaturesInitialized = false;
+  vector<uint32_t> ids;
+  vector<uint8_t> ranks;
+  vector<uint8_t> popularityRanks;
 
-  ForEachMwmOrder(m_results, [&](PreRankerResult & r)
+  for (size_t begin = 0; begin < results.size();)
   {
-    FeatureID const & id = r.GetId();
-    if (id.m_mwmId != mwmId)
+    auto const & mwmId = results[begin]->GetId().m_mwmId;
+    size_t end = begin + 1;
+    while (end < results.size() && results[end]->GetId().m_mwmId == mwmId)
+      ++end;
+
+    auto const mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
+    unique_ptr<RankTable> ranksTable;
+    unique_ptr<RankTable> popularityRanksTable;
+    unique_ptr<LazyCentersTable> centers;
+    if (mwmHandle.IsAlive())
     {
-      mwmId = id.m_mwmId;
-      mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
+      auto const * value = mwmHandle.GetValue();
 
-      ranks.reset();
-      centers.reset();
-      if (mwmHandle.IsAlive())
-      {
-        auto const * value = mwmHandle.GetValue();
-
-        ranks = RankTable::Load(value->m_cont, SEARCH_RANKS_FILE_TAG);
-        popularityRanks = RankTable::Load(value->m_cont, POPULARITY_RANKS_FILE_TAG);
-        centers = make_unique<LazyCentersTable>(*value);
-      }
-      if (!ranks)
-        ranks = make_unique<DummyRankTable>();
-      if (!popularityRanks)
-        popularityRanks = make_unique<DummyRankTable>();
+      ranksTable = RankTable::Load(value->m_cont, SEARCH_RANKS_FILE_TAG);
+      popularityRanksTable = RankTable::Load(value->m_cont, POPULARITY_RANKS_FILE_TAG);
+      centers = make_unique<LazyCentersTable>(*value);
     }
+    if (!ranksTable)
+      ranksTable = make_unique<DummyRankTable>();
+    if (!popularityRanksTable)
+      popularityRanksTable = make_unique<DummyRankTable>();
+
+    ids.clear();
+    for (size_t i = begin; i < end; ++i)
+      ids.push_back(results[i]->GetId().m_index);
+    ranksTable->GetRanks(ids, ranks);
+    popularityRanksTable->GetRanks(ids, popularityRanks);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      auto & r = *results[i];
+      FeatureID const & id = r.GetId();
 
-    r.SetRank(ranks->Get(id.m_index));
-    r.SetPopularity(popularityRanks->Get(id.m_index));
+      r.SetRank(ranks[i - begin]);
+      r.SetPopularity(popularityRanks[i - begin]);
 
-    m2::PointD center;
-    if (centers && centers->Get(id.m_index, center))
-    {
-      r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
-      r.SetCenter(center);
-    }
-    else
-    {
-      auto const & editor = osm::Editor::Instance();
-      if (editor.GetFeatureStatus(id.m_mwmId, id.m_index) == FeatureStatus::Created)
+      m2::PointD center;
+      if (centers && centers->Get(id.m_index, center))
       {
-        auto const emo = editor.GetEditedFeature(id);
-        CHECK(emo, ());
-        center = emo->GetMercator();
         r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
         r.SetCenter(center);
       }
       else
       {
-        // Possible when search while MWM is reloading or updating (!IsAlive).
-        if (!pivotFeaturesInitialized)
+        auto const & editor = osm::Editor::Instance();
+        if (editor.GetFeatureStatus(id.m_mwmId, id.m_index) == FeatureStatus::Created)
         {
-          m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
-          pivotFeaturesInitialized = true;
+          auto const emo = editor.GetEditedFeature(id);
+          CHECK(emo, ());
+          center = emo->GetMercator();
+          r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
+          r.SetCenter(center);
+        }
+        else
+        {
+          // Possible when search while MWM is reloading or updating (!IsAlive).
+          if (!pivotFeaturesInitialized)
+          {
+            m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
+            pivotFeaturesInitialized = true;
+          }
+          r.SetDistanceToPivot(m_pivotFeatures.GetDistanceToFeatureMeters(id));
         }
-        r.SetDistanceToPivot(m_pivotFeatures.GetDistanceToFeatureMeters(id));
       }
     }
-  });
+
+    begin = end;
+  }
 }
 
 namespace
@@ -181,6 +211,33 @@ void PreRanker::DbgFindAndLog(std::set<uint32_t> const & ids) const
       LOG(LDEBUG, (r));
 }
 
+void PreRanker::FilterByLimitRank()
+{
+  if (!m_params.m_earlyTermination || m_params.m_viewportSearch)
+    return;
+
+  double const limitRank = m_ranker.GetLimitRank();
+  if (limitRank == numeric_limits<double>::lowest())
+    return;
+
+  size_t const sizeBefore = m_results.size();
+  base::EraseIf(m_results, [&](PreRankerResult const & result)
+  {
+    auto const & info = result.GetInfo();
+    // Without the center the distance is just estimated by the nested rects.
+    if (!info.m_centerLoaded)
+      return false;
+
+    // Ranker measures the distance from the matched city center, when there is one.
+    double const distance = info.m_cityId.IsValid() ? 0.0 : result.GetDistance();
+    return RankingInfo::GetMaxLinearModelRank(distance, info.m_rank, info.m_popularity,
+                                              m_params.m_categorialRequest) <= limitRank;
+  });
+
+  if (m_results.size() != sizeBefore)
+    LOG(LDEBUG, ("Skipped", sizeBefore - m_results.size(), "results which can't get into the top."));
+}
+
 void PreRanker::Filter()
 {
   auto const lessForUnique = [](PreRankerResult const & lhs, PreRankerResult const & rhs)
@@ -253,9 +310,15 @@ void PreRanker::Filter()
 
 void PreRanker::UpdateResults(bool lastUpdate)
 {
+  base::Timer timer;
   FilterRelaxedResults(lastUpdate);
   FillMissingFieldsInPreResults();
+  FilterByLimitRank();
   Filter();
+  m_preRankingTime += timer.TimeElapsed();
+
+  timer.Reset();
+  SCOPE_GUARD(rankingTime, [&]() { m_rankingTime += timer.TimeElapsed(); });
   m_numSentResults += m_results.size();
   m_ranker.AddPreRankerResults(std::move(m_results));
   m_results.clear();
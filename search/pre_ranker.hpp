@@ -8,6 +8,7 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/macros.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -56,6 +57,10 @@ public:
     bool m_viewportSearch = false;
     bool m_categorialRequest = false;
 
+    // Skip results and mwms which can't get into the top results anymore, see CanGetIntoTop().
+    // Not used for the viewport search.
+    bool m_earlyTermination = false;
+
     size_t m_numQueryTokens = 0;
   };
 
@@ -89,9 +94,17 @@ public:
                                      : m_params.m_everywhereBatchSize;
   }
   size_t NumSentResults() const { return m_numSentResults; }
+
+  // Time spent since Init() on filtering of the pre-results and on ranking of them by the ranker.
+  base::Timer::DurationT PreRankingTime() const { return m_preRankingTime; }
+  base::Timer::DurationT RankingTime() const { return m_rankingTime; }
   bool HaveFullyMatchedResult() const { return m_haveFullyMatchedResult; }
   size_t Limit() const { return m_params.m_limit; }
 
+  // Returns false if the early termination is enabled and a result with the linear model rank
+  // not greater than |maxRank| can't get into the top results which have been ranked so far.
+  bool CanGetIntoTop(double maxRank) const;
+
   // Iterate results per-MWM clusters.
   // Made it "static template" for easy unit tests implementing.
   template <class T, class FnT>
@@ -139,6 +152,7 @@ private:
   void DbgFindAndLog(std::set<uint32_t> const & ids) const;
 
   void FilterForViewportSearch();
+  void FilterByLimitRank();
   void Filter();
   void FilterRelaxedResults(bool lastUpdate);
 
@@ -156,6 +170,9 @@ private:
   // True iff there is at least one result with all tokens used (not relaxed).
   bool m_haveFullyMatchedResult = false;
 
+  base::Timer::DurationT m_preRankingTime{};
+  base::Timer::DurationT m_rankingTime{};
+
   // Cache of nested rects used to estimate distance from a feature to the pivot.
   NestedRectsCache m_pivotFeatures;
 
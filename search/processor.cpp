@@ -10,6 +10,7 @@
 #include "search/postcode_points.hpp"
 #include "search/query_params.hpp"
 #include "search/ranking_utils.hpp"
+#include "search/request_stats.hpp"
 #include "search/search_params.hpp"
 #include "search/utils.hpp"
 #include "search/utm_mgrs_coords_match.hpp"
@@ -41,6 +42,8 @@
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
+#include "base/trace.hpp"
 
 #include <algorithm>
 #include <sstream>
@@ -160,18 +163,20 @@ bool EatVersion(string & s, uint32_t & version)
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
                      vector<Suggest> const & suggests,
-                     storage::CountryInfoGetter const & infoGetter)
+                     storage::CountryInfoGetter const & infoGetter,
+                     CategoriesCacheStorage * categoriesCacheStorage)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
   , m_dataSource(dataSource)
-  , m_localitiesCaches(static_cast<base::Cancellable const &>(*this))
+  , m_localitiesCaches(static_cast<base::Cancellable const &>(*this), categoriesCacheStorage)
   , m_citiesBoundaries(m_dataSource)
   , m_keywordsScorer(LanguageTier::LANGUAGE_TIER_COUNT)
   , m_ranker(m_dataSource, m_citiesBoundaries, infoGetter, m_keywordsScorer, m_emitter, categories,
              suggests, m_localitiesCaches.m_villages, static_cast<base::Cancellable const &>(*this))
   , m_preRanker(m_dataSource, m_ranker)
   , m_geocoder(m_dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker,
-               m_localitiesCaches, static_cast<base::Cancellable const &>(*this))
+               m_localitiesCaches, static_cast<base::Cancellable const &>(*this),
+               categoriesCacheStorage)
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
   // Current and input langs are to be set later.
@@ -220,6 +225,11 @@ void Processor::SetPreferredLocale(string const & locale)
   m_ranker.SetLocale(locale);
 }
 
+void Processor::SetRetrievalThreadPool(base::thread_pool::work_stealing::ThreadPool * pool)
+{
+  m_geocoder.SetRetrievalThreadPool(pool);
+}
+
 void Processor::SetInputLocale(string const & locale)
 {
   if (locale.empty())
@@ -547,6 +557,8 @@ void Processor::ForEachCategoryTypeFuzzy(StringSliceBase const & slice, ToDo &&
 
 void Processor::Search(SearchParams params)
 {
+  TRACE_SCOPE(Search, "Processor::Search");
+
   /// @DebugNote
   // Comment this line to run search in a debugger.
   SetDeadline(chrono::steady_clock::now() + params.m_timeout);
@@ -565,6 +577,8 @@ void Processor::Search(SearchParams params)
 
   m_emitter.Init(std::move(params.m_onResults));
 
+  base::Timer totalTimer;
+
   bool const viewportSearch = params.m_mode == Mode::Viewport;
 
   auto const & viewport = params.m_viewport;
@@ -574,7 +588,9 @@ void Processor::Search(SearchParams params)
 
   SetInputLocale(params.m_inputLocale);
 
+  base::Timer tokenizationTimer;
   SetQuery(params.m_query, params.m_categorialRequest);
+  auto const tokenizationTime = tokenizationTimer.TimeElapsed();
   SetViewport(viewport);
 
   // Used to store the earliest available cancellation status:
@@ -594,6 +610,8 @@ void Processor::Search(SearchParams params)
     InitPreRanker(geocoderParams, params);
     InitRanker(geocoderParams, params);
 
+    auto const tokenFeaturesCacheStats = m_geocoder.GetTokenFeaturesCacheStats();
+    base::Timer geocodingTimer;
     try
     {
       if (!SearchCoordinates() && !SearchDebug())
@@ -617,6 +635,10 @@ void Processor::Search(SearchParams params)
       LOG(LDEBUG, ("Search has been cancelled. Reason:", CancellationStatus()));
     }
 
+    // Geocoder calls PreRanker on every processed mwm.
+    auto const geocodingTime = geocodingTimer.TimeElapsed() - m_geocoder.RetrievalTime() -
+                               m_preRanker.PreRankingTime() - m_preRanker.RankingTime();
+
     cancellationStatus = CancellationStatus();
     if (cancellationStatus != base::Cancellable::Status::CancelCalled)
     {
@@ -626,6 +648,25 @@ void Processor::Search(SearchParams params)
       m_preRanker.UpdateResults(true /* lastUpdate */);
     }
 
+    if (params.m_stats)
+    {
+      auto const toMs = [](base::Timer::DurationT d) {
+        return chrono::duration<double, milli>(d).count();
+      };
+
+      auto & stats = *params.m_stats;
+      stats.m_tokenizationMs = toMs(tokenizationTime);
+      stats.m_retrievalMs = toMs(m_geocoder.RetrievalTime());
+      stats.m_geocodingMs = toMs(geocodingTime);
+      stats.m_preRankingMs = toMs(m_preRanker.PreRankingTime());
+      stats.m_rankingMs = toMs(m_preRanker.RankingTime());
+      stats.m_totalMs = toMs(totalTimer.TimeElapsed());
+
+      auto const cacheStats = m_geocoder.GetTokenFeaturesCacheStats();
+      stats.m_tokenFeaturesCacheHits = cacheStats.m_hits - tokenFeaturesCacheStats.m_hits;
+      stats.m_tokenFeaturesCacheMisses = cacheStats.m_misses - tokenFeaturesCacheStats.m_misses;
+    }
+
     // Emit finish marker to client.
     m_geocoder.Finish(cancellationStatus == Cancellable::Status::CancelCalled);
     break;
@@ -886,6 +927,7 @@ void Processor::InitPreRanker(Geocoder::Params const & geocoderParams,
   params.m_limit = max(SearchParams::kPreResultsCount, searchParams.m_maxNumResults);
   params.m_viewportSearch = viewportSearch;
   params.m_categorialRequest = geocoderParams.IsCategorialRequest();
+  params.m_earlyTermination = searchParams.m_earlyTermination;
   params.m_numQueryTokens = geocoderParams.GetNumTokens();
 
   m_preRanker.Init(params);
@@ -56,13 +56,17 @@ public:
   // Maximum result candidates count for each viewport/criteria.
   static size_t const kPreResultsCount;
 
+  // |categoriesCacheStorage| is shared with other processors, see CategoriesCacheStorage.
   Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter);
+            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter,
+            CategoriesCacheStorage * categoriesCacheStorage = nullptr);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
   void SetInputLocale(std::string const & locale);
   void SetQuery(std::string const & query, bool categorialRequest = false);
+  // See Geocoder::SetRetrievalThreadPool().
+  void SetRetrievalThreadPool(base::thread_pool::work_stealing::ThreadPool * pool);
 
   inline bool IsEmptyQuery() const { return m_query.IsEmpty(); }
 
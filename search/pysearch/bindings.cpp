@@ -7,8 +7,6 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_source.hpp"
 
-#include "storage/storage_defines.hpp"
-
 #include "platform/local_country_file.hpp"
 #include "platform/local_country_file_utils.hpp"
 #include "platform/platform.hpp"
@@ -129,14 +127,23 @@ struct TraceResult
   bool m_isCategory = false;
 };
 
+class ReleaseGil
+{
+public:
+  ReleaseGil() : m_state(PyEval_SaveThread()) {}
+  ~ReleaseGil() { PyEval_RestoreThread(m_state); }
+
+private:
+  PyThreadState * m_state;
+};
+
 struct SearchEngineProxy
 {
-  SearchEngineProxy()
+  explicit SearchEngineProxy(size_t numThreads = 1)
   {
     search::search_quality::InitDataSource(m_dataSource, "" /* mwmListPath */);
-    search::search_quality::InitStorageData(m_affiliations, m_countryNameSynonyms);
-    m_engine = search::search_quality::InitSearchEngine(m_dataSource, m_affiliations,
-                                                        "en" /* locale */, 1 /* numThreads */);
+    m_engine = search::search_quality::InitSearchEngine(m_dataSource, "en" /* locale */,
+                                                        numThreads);
   }
 
   search::SearchParams MakeSearchParams(Params const & params) const
@@ -167,6 +174,50 @@ struct SearchEngineProxy
     return results;
   }
 
+  // Runs all the queries at once on the engine threads. The GIL is released while the queries
+  // are processed. Queries with the same locale go together, as the locale is set for the engine.
+  boost::python::list QueryBatch(boost::python::list const & paramsList) const
+  {
+    vector<Params> params;
+    for (boost::python::ssize_t i = 0; i < boost::python::len(paramsList); ++i)
+      params.push_back(boost::python::extract<Params>(paramsList[i]));
+
+    vector<unique_ptr<search::tests_support::TestSearchRequest>> requests(params.size());
+    {
+      ReleaseGil const releaseGil;
+
+      size_t begin = 0;
+      while (begin < params.size())
+      {
+        size_t end = begin + 1;
+        while (end < params.size() && params[end].m_locale == params[begin].m_locale)
+          ++end;
+
+        m_engine->SetLocale(params[begin].m_locale);
+        for (size_t i = begin; i < end; ++i)
+        {
+          requests[i] = make_unique<search::tests_support::TestSearchRequest>(
+              *m_engine, MakeSearchParams(params[i]));
+          requests[i]->Start();
+        }
+        for (size_t i = begin; i < end; ++i)
+          requests[i]->Wait();
+
+        begin = end;
+      }
+    }
+
+    boost::python::list batch;
+    for (auto const & request : requests)
+    {
+      boost::python::list results;
+      for (auto const & result : request->Results())
+        results.append(Result(result));
+      batch.append(results);
+    }
+    return batch;
+  }
+
   boost::python::list Trace(Params const &params) const
   {
     m_engine->SetLocale(params.m_locale);
@@ -195,8 +246,6 @@ struct SearchEngineProxy
     return trs;
   }
 
-  storage::Affiliations m_affiliations;
-  storage::CountryNameSynonyms m_countryNameSynonyms;
   FrozenDataSource m_dataSource;
   unique_ptr<search::tests_support::TestSearchEngine> m_engine;
 };
@@ -247,6 +296,8 @@ BOOST_PYTHON_MODULE(pysearch)
       .def("__repr__", &TraceResult::ToString);
 
   class_<SearchEngineProxy, boost::noncopyable>("SearchEngine")
+      .def(init<size_t>())
       .def("query", &SearchEngineProxy::Query)
+      .def("query_batch", &SearchEngineProxy::QueryBatch)
       .def("trace", &SearchEngineProxy::Trace);
 }
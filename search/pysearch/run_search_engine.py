@@ -27,3 +27,4 @@ params.viewport = search.Viewport(search.Mercator(37.1336, 67.1349),
                                   search.Mercator(38.0314, 67.7348))
 print(engine.query(params))
 print(engine.trace(params))
+print(engine.query_batch([params, params]))
@@ -22,7 +22,11 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
 
 namespace search
@@ -421,16 +425,28 @@ public:
   }
 
 private:
-  bool IsSameLoader(FeatureID const & id) const
+  // Loaders are kept for the whole batch of results, so features of different mwms
+  // (e.g. a street and its city from World) may be loaded without reopening mwms.
+  FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id)
   {
-    return (m_loader && m_loader->GetId() == id.m_mwmId);
+    auto & loader = m_loaders[id];
+    if (!loader)
+      loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
+    return *loader;
   }
 
   unique_ptr<FeatureType> LoadFeature(FeatureID const & id)
   {
-    if (!IsSameLoader(id))
-      m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id.m_mwmId);
-    return LoadFeatureImpl(id, *m_loader);
+    return LoadFeatureImpl(id, GetLoader(id.m_mwmId));
+  }
+
+  // Streets, suburbs and cities are shared by many results, so they are decoded once.
+  FeatureType * LoadDependFeature(FeatureID const & id)
+  {
+    auto [it, inserted] = m_dependFeatures.emplace(id, nullptr);
+    if (inserted)
+      it->second = LoadFeature(id);
+    return it->second.get();
   }
 
   static unique_ptr<FeatureType> LoadFeatureImpl(FeatureID const & id, FeaturesLoaderGuard & loader)
@@ -457,16 +473,16 @@ private:
   unique_ptr<FeatureType> LoadFeature(FeatureID const & id, m2::PointD & center, string & name,
                                       string & country)
   {
-    auto ft = LoadFeature(id);
+    auto & loader = GetLoader(id.m_mwmId);
+    auto ft = LoadFeatureImpl(id, loader);
     if (!ft)
       return ft;
 
     // Country (region) name is a file name if feature isn't from World.mwm.
-    ASSERT(m_loader && m_loader->GetId() == id.m_mwmId, ());
-    if (m_loader->IsWorld())
+    if (loader.IsWorld())
       country.clear();
     else
-      country = m_loader->GetCountryFileName();
+      country = loader.GetCountryFileName();
 
     center = feature::GetCenter(*ft);
     m_ranker.GetBestMatchName(*ft, name);
@@ -477,20 +493,7 @@ private:
       ReverseGeocoder::Address addr;
       if (GetExactAddress(*ft, center, addr))
       {
-        unique_ptr<FeatureType> streetFeature;
-
-        // We can't change m_loader here, because of the following RankerResult. So do this trick:
-        if (IsSameLoader(addr.m_street.m_id))
-        {
-          streetFeature = LoadFeatureImpl(addr.m_street.m_id, *m_loader);
-        }
-        else
-        {
-          auto loader = make_unique<FeaturesLoaderGuard>(m_dataSource, addr.m_street.m_id.m_mwmId);
-          streetFeature = LoadFeatureImpl(addr.m_street.m_id, *loader);
-        }
-
-        if (streetFeature)
+        if (auto * streetFeature = LoadDependFeature(addr.m_street.m_id))
         {
           string streetName;
           m_ranker.GetBestMatchName(*streetFeature, streetName);
@@ -564,7 +567,7 @@ private:
       {
         if (info.m_type != type && dependID != IntersectionResult::kInvalidId)
         {
-          if (auto p = LoadFeature({ ft.GetID().m_mwmId, dependID }))
+          if (auto * p = LoadDependFeature({ ft.GetID().m_mwmId, dependID }))
             updateScoreForFeature(*p, type);
         }
       };
@@ -574,7 +577,7 @@ private:
 
       if (!Model::IsLocalityType(info.m_type) && preInfo.m_cityId.IsValid())
       {
-        if (auto city = LoadFeature(preInfo.m_cityId))
+        if (auto * city = LoadDependFeature(preInfo.m_cityId))
         {
           auto type = Model::TYPE_CITY;
           if (preInfo.m_tokenRanges[type].Empty())
@@ -668,7 +671,9 @@ private:
   Geocoder::Params const & m_params;
   bool m_isViewportMode;
 
-  unique_ptr<FeaturesLoaderGuard> m_loader;
+  map<MwmSet::MwmId, unique_ptr<FeaturesLoaderGuard>> m_loaders;
+  // Declared after |m_loaders| because features refer to the loaders' data.
+  map<FeatureID, unique_ptr<FeatureType>> m_dependFeatures;
 };
 
 Ranker::Ranker(DataSource const & dataSource, CitiesBoundariesTable const & boundariesTable,
@@ -694,6 +699,26 @@ void Ranker::Init(Params const & params, Geocoder::Params const & geocoderParams
   m_geocoderParams = geocoderParams;
   m_preRankerResults.clear();
   m_tentativeResults.clear();
+  m_emittedRanks.clear();
+}
+
+double Ranker::GetLimitRank() const
+{
+  ASSERT(!m_params.m_viewportSearch, ());
+
+  if (m_params.m_limit == 0 || m_emittedRanks.size() + m_tentativeResults.size() < m_params.m_limit)
+    return numeric_limits<double>::lowest();
+
+  // Emitted results are never displaced, so a new result goes after all of them and after the
+  // tentative results with a better rank.
+  vector<double> ranks(m_emittedRanks);
+  ranks.reserve(ranks.size() + m_tentativeResults.size());
+  for (auto const & r : m_tentativeResults)
+    ranks.push_back(r.GetLinearModelRank());
+
+  auto const nth = ranks.begin() + (m_params.m_limit - 1);
+  nth_element(ranks.begin(), nth, ranks.end(), greater<double>());
+  return *nth;
 }
 
 void Ranker::Finish(bool cancelled)
@@ -856,7 +881,10 @@ void Ranker::UpdateResults(bool lastUpdate)
     else
     {
       if (m_emitter.AddResult(std::move(result)))
+      {
+        m_emittedRanks.push_back(rankerResult.GetLinearModelRank());
         ++count;
+      }
     }
   }
 
@@ -884,18 +912,33 @@ void Ranker::MakeRankerResults()
 {
   LOG(LDEBUG, ("PreRankerResults number =", m_preRankerResults.size()));
 
-  RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder, m_geocoderParams);
-  for (auto const & r : m_preRankerResults)
+  // Features are loaded mwm by mwm, but results are kept in the pre-ranker order.
+  vector<size_t> order(m_preRankerResults.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs)
+  {
+    return m_preRankerResults[lhs].GetId().m_mwmId < m_preRankerResults[rhs].GetId().m_mwmId;
+  });
+
+  vector<optional<RankerResult>> results(m_preRankerResults.size());
+  {
+    RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder, m_geocoderParams);
+    for (size_t const i : order)
+      results[i] = maker(m_preRankerResults[i]);
+  }
+
+  for (size_t i = 0; i < results.size(); ++i)
   {
-    auto p = maker(r);
+    auto & p = results[i];
     if (!p)
       continue;
 
-    ASSERT(m_geocoderParams.m_mode != Mode::Viewport || m_geocoderParams.m_pivot.IsPointInside(p->GetCenter()), (r));
+    ASSERT(m_geocoderParams.m_mode != Mode::Viewport || m_geocoderParams.m_pivot.IsPointInside(p->GetCenter()),
+           (m_preRankerResults[i]));
 
     // Do not filter any _duplicates_ here. Leave it for high level Results class.
     m_tentativeResults.push_back(std::move(*p));
-  };
+  }
 
   m_preRankerResults.clear();
 }
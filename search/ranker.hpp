@@ -73,6 +73,11 @@ public:
 
   bool IsFull() const { return m_emitter.GetResults().GetCount() >= m_params.m_limit; }
 
+  // Returns the linear model rank which a new result must exceed to get into the top
+  // |m_limit| results among the emitted and the tentative ones, or the lowest double
+  // when there are not enough results yet. Not applicable to the viewport search.
+  double GetLimitRank() const;
+
   // Makes the final result that is shown to the user from a ranker's result.
   // |needAddress| and |needHighlighting| enable filling of optional fields
   // that may take a considerable amount of time to compute.
@@ -125,5 +130,7 @@ private:
 
   std::vector<PreRankerResult> m_preRankerResults;
   std::vector<RankerResult> m_tentativeResults;
+  // Linear model ranks of the results emitted during the current search.
+  std::vector<double> m_emittedRanks;
 };
 }  // namespace search
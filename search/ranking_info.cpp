@@ -8,6 +8,7 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <array>
 #include <limits>
 #include <sstream>
@@ -360,6 +361,30 @@ double RankingInfo::GetLinearRankViewportThreshold()
   return kViewportDiffThreshold;
 }
 
+double RankingInfo::GetMaxLinearModelRank(double distanceToPivot, uint8_t rank, uint8_t popularity,
+                                          bool categorialRequest)
+{
+  double const distance = TransformDistance(distanceToPivot);
+  double const rankFactor = static_cast<double>(rank) / numeric_limits<uint8_t>::max();
+  double const popularityFactor = static_cast<double>(popularity) / numeric_limits<uint8_t>::max();
+
+  if (categorialRequest)
+  {
+    return kCategoriesDistanceToPivot * distance + kCategoriesRank * rankFactor +
+           kCategoriesPopularity * popularityFactor + kHasName;
+  }
+
+  // The best possible values of all the factors which are unknown before the feature is loaded.
+  // False cats, errors, common tokens and alt names are penalties only.
+  double const maxType = *max_element(begin(kType), end(kType));
+  double const maxClassifType = max(*max_element(begin(kPoiType), end(kPoiType)),
+                                    *max_element(begin(kStreetType), end(kStreetType)));
+  double const maxNameScore = *max_element(begin(kNameScore), end(kNameScore));
+
+  return kDistanceToPivot * distance + kRank * rankFactor + kPopularity * popularityFactor +
+         maxType + maxClassifType + kAllTokensUsed + maxNameScore + kMatchedFraction;
+}
+
 double RankingInfo::GetLinearModelRank(bool viewportMode /* = false */) const
 {
   double const distanceToPivot = TransformDistance(m_distanceToPivot);
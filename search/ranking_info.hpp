@@ -88,6 +88,11 @@ struct RankingInfo : public StoredRankingInfo
 
   static double GetLinearRankViewportThreshold();
 
+  /// @return Upper bound of GetLinearModelRank() (not in the viewport mode) for any result with
+  /// the distance to the pivot not less than |distanceToPivot| and the given rank and popularity.
+  static double GetMaxLinearModelRank(double distanceToPivot, uint8_t rank, uint8_t popularity,
+                                      bool categorialRequest);
+
   double GetErrorsMadePerToken() const;
 
   NameScore GetNameScore() const;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace search
+{
+// Costs of a single search request, filled by the Processor before the final results are
+// emitted when SearchParams::m_stats is set. Times are wall times on the search thread.
+struct RequestStats
+{
+  // Splitting and normalization of the query.
+  double m_tokenizationMs = 0.0;
+  // Getting features of the query tokens from the search index, including waiting for
+  // the retrieval threads which do it in advance.
+  double m_retrievalMs = 0.0;
+  // The rest of the time of the geocoder: matching of the features layers and localities.
+  double m_geocodingMs = 0.0;
+  double m_preRankingMs = 0.0;
+  double m_rankingMs = 0.0;
+  double m_totalMs = 0.0;
+
+  // Accesses of the search index features of the query tokens cached by the geocoder.
+  uint64_t m_tokenFeaturesCacheHits = 0;
+  uint64_t m_tokenFeaturesCacheMisses = 0;
+};
+}  // namespace search
@@ -13,12 +13,15 @@
 #include "indexer/editable_map_object.hpp"
 #include "indexer/feature_data.hpp"
 #include "indexer/feature_source.hpp"
+#include "indexer/louds_trie.hpp"
 #include "indexer/search_string_utils.hpp"
 #include "indexer/trie_reader.hpp"
 
 #include "platform/mwm_version.hpp"
 
 #include "coding/compressed_bit_vector.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader_wrapper.hpp"
 
 #include "base/checked_cast.hpp"
@@ -345,6 +348,17 @@ unique_ptr<Retrieval::TrieRoot<Value>> ReadTrie(ModelReaderPtr & reader)
   return trie::ReadTrie<SubReaderWrapper<Reader>, ValueList<Value>>(
       SubReaderWrapper<Reader>(reader.GetPtr()), SingleValueSerializer<Value>());
 }
+
+shared_ptr<trie::LoudsTrie const> LoadLoudsTrie(ModelReaderPtr const & reader)
+{
+  // The trie is read right from the mapped file when it's possible (see GetCountryReader).
+  if (dynamic_cast<MmapReader const *>(reader.GetPtr()))
+    return make_shared<trie::LoudsTrie>(make_unique<MmapReaderMemoryRegion>(reader));
+
+  vector<uint8_t> buffer(static_cast<size_t>(reader.Size()));
+  reader.Read(0, buffer.data(), buffer.size());
+  return make_shared<trie::LoudsTrie>(make_unique<CopiedMemoryRegion>(std::move(buffer)));
+}
 }  // namespace
 
 Retrieval::Retrieval(MwmContext const & context, base::Cancellable const & cancellable)
@@ -364,9 +378,18 @@ Retrieval::Retrieval(MwmContext const & context, base::Cancellable const & cance
 
     SearchIndexHeader header;
     header.Read(*reader.GetPtr());
-    CHECK(header.m_version == SearchIndexHeader::Version::V2, (base::Underlying(header.m_version)));
-
     m_reader = reader.SubReader(header.m_indexOffset, header.m_indexSize);
+
+    if (header.m_version == SearchIndexHeader::Version::V3)
+    {
+      auto & searchTrie = context.m_value.m_searchTrie;
+      if (!searchTrie)
+        searchTrie = LoadLoudsTrie(m_reader);
+      m_root = trie::ReadLoudsTrie<ValueList<Uint64IndexValue>>(
+          searchTrie, SingleValueSerializer<Uint64IndexValue>());
+      return;
+    }
+    CHECK(header.m_version == SearchIndexHeader::Version::V2, (base::Underlying(header.m_version)));
   }
   else
   {
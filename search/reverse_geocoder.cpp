@@ -19,9 +19,15 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 namespace search
 {
@@ -32,6 +38,11 @@ namespace
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Min size of a cell which groups points in GetNearbyAddresses().
+double constexpr kMinBatchCellSizeM = 500.0;
+
+/// Guards lazy loading of house to street (place) tables which are kept in mwm values.
+mutex g_houseTablesMutex;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets =
@@ -195,6 +206,115 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, double maxDist
   }
 }
 
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & centers, double maxDistanceM,
+                                         vector<Address> & addrs, size_t threadsCount /* = 1 */,
+                                         bool placeAsStreet /* = false */) const
+{
+  addrs.assign(centers.size(), Address());
+
+  double const cellSize = mercator::MetersToMercator(max(maxDistanceM, kMinBatchCellSizeM));
+  map<pair<int64_t, int64_t>, vector<size_t>> cells;
+  for (size_t i = 0; i < centers.size(); ++i)
+  {
+    auto const x = static_cast<int64_t>(floor(centers[i].x / cellSize));
+    auto const y = static_cast<int64_t>(floor(centers[i].y / cellSize));
+    cells[{x, y}].push_back(i);
+  }
+
+  vector<vector<size_t> const *> tasks;
+  tasks.reserve(cells.size());
+  for (auto const & cell : cells)
+    tasks.push_back(&cell.second);
+
+  atomic<size_t> nextTask = 0;
+  auto const fn = [&]()
+  {
+    for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+      GetNearbyAddressesInCell(centers, *tasks[i], maxDistanceM, placeAsStreet, addrs);
+  };
+
+  threadsCount = min(max(threadsCount, size_t{1}), tasks.size());
+  if (threadsCount <= 1)
+  {
+    fn();
+    return;
+  }
+
+  vector<thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(fn);
+
+  for (auto & t : threads)
+    t.join();
+}
+
+void ReverseGeocoder::GetNearbyAddressesInCell(vector<m2::PointD> const & centers,
+                                               vector<size_t> const & indices, double maxDistanceM,
+                                               bool placeAsStreet, vector<Address> & addrs) const
+{
+  vector<m2::RectD> lookupRects;
+  lookupRects.reserve(indices.size());
+  m2::RectD cellRect;
+  for (auto const i : indices)
+  {
+    lookupRects.push_back(GetLookupRect(centers[i], maxDistanceM));
+    cellRect.Add(lookupRects.back());
+  }
+
+  // In contrast to GetNearbyBuildings() all the buildings around a point are considered,
+  // not the first found ones.
+  vector<vector<Building>> buildings(indices.size());
+  m_dataSource.ForEachInRect([&](FeatureType & ft)
+  {
+    std::string const & hn = GetHouseNumber(ft);
+    if (hn.empty())
+      return;
+
+    auto const rect = ft.GetLimitRect(kQueryScale);
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+      if (!rect.IsIntersect(lookupRects[j]))
+        continue;
+
+      auto const distance = feature::GetMinDistanceMeters(ft, centers[indices[j]]);
+      if (distance <= maxDistanceM)
+        buildings[j].push_back(FromFeatureImpl(ft, hn, distance));
+    }
+  }, cellRect, kQueryScale);
+
+  HouseTable table(m_dataSource, placeAsStreet);
+  // Streets of the cell's buildings. No value means that the building has no street.
+  map<FeatureID, optional<Street>> streets;
+  for (size_t j = 0; j < indices.size(); ++j)
+  {
+    auto & bs = buildings[j];
+    sort(bs.begin(), bs.end(), base::LessBy(&Building::m_distanceMeters));
+    if (bs.size() > kMaxNumTriesToApproxAddress)
+      bs.resize(kMaxNumTriesToApproxAddress);
+
+    auto & addr = addrs[indices[j]];
+    for (auto const & b : bs)
+    {
+      auto it = streets.find(b.m_id);
+      if (it == streets.end())
+      {
+        Address found;
+        optional<Street> street;
+        if (GetNearbyAddress(table, b, false /* ignoreEdits */, found))
+          street = std::move(found.m_street);
+        it = streets.emplace(b.m_id, std::move(street)).first;
+      }
+
+      if (it->second)
+      {
+        addr.m_building = b;
+        addr.m_street = *it->second;
+        break;
+      }
+    }
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType & ft, Address & addr, bool placeAsStreet/* = false*/) const
 {
   std::string const & hn = GetHouseNumber(ft);
@@ -357,15 +477,25 @@ std::optional<HouseToStreetTable::Result> ReverseGeocoder::HouseTable::Get(Featu
   }
 
   auto value = m_handle.GetValue();
-  if (!value->m_house2street)
-    value->m_house2street = LoadHouseToStreetTable(*value);
+  HouseToStreetTable const * house2street;
+  {
+    lock_guard guard(g_houseTablesMutex);
+    if (!value->m_house2street)
+      value->m_house2street = LoadHouseToStreetTable(*value);
+    house2street = value->m_house2street.get();
+  }
 
-  auto res = value->m_house2street->Get(fid.m_index);
+  auto res = house2street->Get(fid.m_index);
   if (!res && m_placeAsStreet)
   {
-    if (!value->m_house2place)
-      value->m_house2place = LoadHouseToPlaceTable(*value);
-    res = value->m_house2place->Get(fid.m_index);
+    HouseToStreetTable const * house2place;
+    {
+      lock_guard guard(g_houseTablesMutex);
+      if (!value->m_house2place)
+        value->m_house2place = LoadHouseToPlaceTable(*value);
+      house2place = value->m_house2place.get();
+    }
+    res = house2place->Get(fid.m_index);
   }
   return res;
 }
@@ -153,6 +153,15 @@ public:
 
   bool GetExactAddress(FeatureID const & fid, Address & addr) const;
 
+  /// Batch version of GetNearbyAddress(center, maxDistanceM, addr, placeAsStreet) for many points,
+  /// e.g. GPS tracks. Points are grouped by grid cells, features of a cell are read once for
+  /// all its points and streets are resolved once for every building of a cell.
+  /// Cells are processed in |threadsCount| threads.
+  /// @param[out] addrs  Addresses in the order of |centers|. Not found addresses are not valid.
+  void GetNearbyAddresses(std::vector<m2::PointD> const & centers, double maxDistanceM,
+                          std::vector<Address> & addrs, size_t threadsCount = 1,
+                          bool placeAsStreet = false) const;
+
   /// Returns the nearest region address where mwm or exact city is known.
   static RegionAddress GetNearbyRegionAddress(m2::PointD const & center,
                                               storage::CountryInfoGetter const & infoGetter,
@@ -181,6 +190,11 @@ private:
   bool GetNearbyAddress(HouseTable & table, Building const & bld, bool ignoreEdits,
                         Address & addr) const;
 
+  /// Fills |addrs| for points |centers[i]| for i in |indices| which are close to each other.
+  void GetNearbyAddressesInCell(std::vector<m2::PointD> const & centers,
+                                std::vector<size_t> const & indices, double maxDistanceM,
+                                bool placeAsStreet, std::vector<Address> & addrs) const;
+
   /// @return Sorted by distance houses vector with valid house number.
   void GetNearbyBuildings(m2::PointD const & center, double maxDistanceM,
                           std::vector<Building> & buildings) const;
@@ -15,13 +15,16 @@ public:
     V0 = 0,
     V1 = 1,
     V2 = 2,
-    Latest = V2
+    // The index is a LOUDS trie (see indexer/louds_trie.hpp), it's read right from the memory
+    // mapped file.
+    V3 = 3,
+    Latest = V3
   };
 
   template <typename Sink>
   void Serialize(Sink & sink) const
   {
-    CHECK_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::V2), ());
+    CHECK(m_version == Version::V2 || m_version == Version::V3, (static_cast<uint8_t>(m_version)));
     WriteToSink(sink, static_cast<uint8_t>(m_version));
     WriteToSink(sink, m_indexOffset);
     WriteToSink(sink, m_indexSize);
@@ -31,7 +34,7 @@ public:
   {
     NonOwningReaderSource source(reader);
     m_version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(source));
-    CHECK_EQUAL(static_cast<uint8_t>(m_version), static_cast<uint8_t>(Version::V2), ());
+    CHECK(m_version == Version::V2 || m_version == Version::V3, (static_cast<uint8_t>(m_version)));
     m_indexOffset = ReadPrimitiveFromSource<uint32_t>(source);
     m_indexSize = ReadPrimitiveFromSource<uint32_t>(source);
   }
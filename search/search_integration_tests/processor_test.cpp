@@ -16,6 +16,8 @@
 #include "search/token_range.hpp"
 #include "search/token_slice.hpp"
 
+#include "storage/country_info_getter.hpp"
+
 #include "indexer/feature_impl.hpp"
 
 #include "geometry/mercator.hpp"
@@ -478,6 +480,97 @@ UNIT_CLASS_TEST(ProcessorTest, SearchByName)
   }
 }
 
+UNIT_CLASS_TEST(ProcessorTest, ParallelRetrieval)
+{
+  TestCity london({1, 1}, "London", "en", 100 /* rank */);
+  BuildWorld([&](TestMwmBuilder & builder)
+  {
+    builder.Add(london);
+  });
+
+  for (int i = 0; i < 6; ++i)
+  {
+    m2::PointD const center(i * 3.0, 0.0);
+    TestPOI cafe(center, "London Cafe", "en");
+    TestStreet street({center, center + m2::PointD(0.5, 0.5)}, "London Street", "en");
+    BuildCountry("Wonderland" + strings::to_string(i), [&](TestMwmBuilder & builder)
+    {
+      builder.Add(cafe);
+      builder.Add(street);
+    });
+  }
+
+  // Same data, but token features of the mwms are retrieved on a pool.
+  Engine::Params params;
+  params.m_numRetrievalThreads = 3;
+  TestSearchEngine parallelEngine(m_dataSource, params, true /* mockCountryInfo */);
+  {
+    auto & infoGetter =
+        dynamic_cast<storage::CountryInfoGetterForTesting &>(parallelEngine.GetCountryInfoGetter());
+    vector<shared_ptr<MwmInfo>> infos;
+    m_dataSource.GetMwmsInfo(infos);
+    for (auto const & info : infos)
+    {
+      if (info->GetType() == MwmInfo::COUNTRY)
+        infoGetter.AddCountry(storage::CountryDef(info->GetCountryName(), info->m_bordersRect));
+    }
+    parallelEngine.LoadCitiesBoundaries();
+  }
+
+  SetViewport(m2::RectD(0.5, 0.5, 1.5, 1.5));
+  for (auto const & query : {"london", "london cafe", "cafe", "street"})
+  {
+    TestSearchRequest request(m_engine, query, "en", Mode::Everywhere, m_viewport);
+    request.Run();
+    TestSearchRequest parallelRequest(parallelEngine, query, "en", Mode::Everywhere, m_viewport);
+    parallelRequest.Run();
+
+    auto const & results = request.Results();
+    auto const & parallelResults = parallelRequest.Results();
+    TEST(!parallelResults.empty(), (query));
+    TEST_EQUAL(results.size(), parallelResults.size(), (query));
+    for (size_t i = 0; i < results.size(); ++i)
+      TEST_EQUAL(results[i].GetFeatureID(), parallelResults[i].GetFeatureID(), (query, i));
+  }
+}
+
+UNIT_CLASS_TEST(ProcessorTest, QueuedRequestsTimeout)
+{
+  TestCity london({1, 1}, "London", "en", 100 /* rank */);
+  auto const worldId = BuildWorld([&](TestMwmBuilder & builder)
+  {
+    builder.Add(london);
+  });
+
+  SetViewport(m2::RectD(0.5, 0.5, 1.5, 1.5));
+  auto const statsBefore = m_engine.GetStats();
+
+  SearchParams params;
+  params.m_query = "london";
+  params.m_inputLocale = "en";
+  params.m_viewport = m_viewport;
+  params.m_mode = Mode::Everywhere;
+  {
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(ResultsMatch(request.Results(), {ExactMatch(worldId, london)}), ());
+  }
+
+  // The time in the queue counts towards the timeout, so the request is not processed.
+  params.m_timeout = SearchParams::TimeDurationT::zero();
+  {
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(request.Results().empty(), ());
+  }
+
+  auto const stats = m_engine.GetStats();
+  TEST_EQUAL(stats.m_accepted, statsBefore.m_accepted + 2, ());
+  TEST_EQUAL(stats.m_expired, statsBefore.m_expired + 1, ());
+  TEST_EQUAL(stats.m_processed, statsBefore.m_processed + 1, ());
+  TEST_EQUAL(stats.m_rejected, statsBefore.m_rejected, ());
+}
+
 UNIT_CLASS_TEST(ProcessorTest, DisableSuggests)
 {
   TestCity london1({1, 1}, "London", "en", 100 /* rank */);
@@ -18,6 +18,7 @@ namespace search
 {
 class Results;
 class Tracer;
+struct RequestStats;
 
 struct SearchParams
 {
@@ -80,6 +81,9 @@ struct SearchParams
 
   std::shared_ptr<Tracer> m_tracer;
 
+  // When set, it's filled with the costs of the request before the final results.
+  std::shared_ptr<RequestStats> m_stats;
+
   Mode m_mode = Mode::Everywhere;
 
   // Needed to generate search suggests.
@@ -94,6 +98,10 @@ struct SearchParams
   // True if you need *pure* category results only, without names/addresses/etc matching.
   bool m_categorialRequest = false;
 
+  // Skip mwms and pre-results which can't get into the top |m_maxNumResults| results by
+  // the upper bound of their rank. Not used for the viewport search.
+  bool m_earlyTermination = false;
+
   // Set to true for debug logs and tests.
 #ifdef DEBUG
   bool m_useDebugInfo = true;
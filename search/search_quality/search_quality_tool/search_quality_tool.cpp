@@ -4,6 +4,7 @@
 #include "search/search_tests_support/test_search_request.hpp"
 
 #include "search/ranking_info.hpp"
+#include "search/request_stats.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
 
@@ -26,14 +27,17 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <new>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -58,6 +62,31 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_bool(benchmark, false,
+            "Replay the queries and report latency percentiles of the search stages "
+            "instead of the results");
+DEFINE_string(bench_viewports, "",
+              "Comma-separated viewports to replay every query against (default: --viewport)");
+DEFINE_int32(bench_runs, 1, "Number of times every query is replayed against every viewport");
+DEFINE_int32(bench_in_flight, 0,
+             "Max number of requests sent to the engine at once (default: --num_threads)");
+DEFINE_string(bench_output, "", "CSV file the stats of every request will be exported to");
+DEFINE_string(bench_baseline, "",
+              "CSV file exported by --bench_output of another build to compare with");
+
+// Allocations made by the process, to estimate the allocations per query in the benchmark mode.
+atomic<uint64_t> g_numAllocations{0};
+
+void * operator new(size_t size)
+{
+  g_numAllocations.fetch_add(1, memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw bad_alloc();
+}
+
+void operator delete(void * p) noexcept { free(p); }
+void operator delete(void * p, size_t) noexcept { free(p); }
 
 string const kDefaultQueriesPathSuffix =
     "/../search/search_quality/search_quality_tool/queries.txt";
@@ -355,6 +384,261 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
        << " (std. dev. " << stdDevTime << "s)" << endl;
 }
 
+struct BenchStage
+{
+  char const * m_name;
+  double RequestStats::*m_ms;
+};
+
+BenchStage const kBenchStages[] = {
+    {"tokenization", &RequestStats::m_tokenizationMs},
+    {"retrieval", &RequestStats::m_retrievalMs},
+    {"geocoding", &RequestStats::m_geocodingMs},
+    {"pre-ranking", &RequestStats::m_preRankingMs},
+    {"ranking", &RequestStats::m_rankingMs},
+    {"total", &RequestStats::m_totalMs},
+};
+
+string const kBenchCSVHeader =
+    "tokenization_ms,retrieval_ms,geocoding_ms,preranking_ms,ranking_ms,total_ms,"
+    "token_cache_hits,token_cache_misses,viewport,query";
+
+// Returns the nearest-rank percentile of sorted |values|.
+double Percentile(vector<double> const & values, double p)
+{
+  if (values.empty())
+    return 0.0;
+  auto const rank = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(values.size())));
+  return values[min(max(rank, size_t{1}), values.size()) - 1];
+}
+
+// Returns sorted times of every stage of |stats| in the order of |kBenchStages|.
+vector<vector<double>> GetStageTimes(vector<RequestStats> const & stats)
+{
+  vector<vector<double>> times(size(kBenchStages));
+  for (size_t i = 0; i < times.size(); ++i)
+  {
+    for (auto const & s : stats)
+      times[i].push_back(s.*kBenchStages[i].m_ms);
+    sort(times[i].begin(), times[i].end());
+  }
+  return times;
+}
+
+void PrintLatencyHistogram(vector<double> const & sortedTotalTimes)
+{
+  size_t constexpr kBarWidth = 50;
+
+  // Buckets are [0, 1), [1, 2), [2, 4), [4, 8) ... ms.
+  vector<size_t> buckets;
+  for (double const t : sortedTotalTimes)
+  {
+    size_t bucket = 0;
+    for (double bound = 1.0; t >= bound; bound *= 2)
+      ++bucket;
+    if (buckets.size() <= bucket)
+      buckets.resize(bucket + 1);
+    ++buckets[bucket];
+  }
+
+  size_t const maxCount = buckets.empty() ? 0 : *max_element(buckets.begin(), buckets.end());
+  for (size_t i = 0; i < buckets.size(); ++i)
+  {
+    double const from = i == 0 ? 0.0 : static_cast<double>(1 << (i - 1));
+    double const to = static_cast<double>(1 << i);
+    cout << setw(7) << from << " - " << setw(7) << to << " ms " << setw(7) << buckets[i] << " "
+         << string(buckets[i] * kBarWidth / maxCount, '#') << endl;
+  }
+}
+
+// Reads the stats exported by WriteBenchCSV(). Query and viewport are not needed to compare
+// the percentiles and are skipped.
+bool ReadBenchCSV(string const & path, vector<RequestStats> & stats)
+{
+  ifstream stream(path);
+  if (!stream.is_open())
+    return false;
+
+  string line;
+  if (!getline(stream, line) || line != kBenchCSVHeader)
+    return false;
+
+  while (getline(stream, line))
+  {
+    vector<string> parts;
+    Split(line, ',', parts);
+    if (parts.size() < 8)
+      return false;
+
+    RequestStats s;
+    for (size_t i = 0; i < size(kBenchStages); ++i)
+    {
+      if (!strings::to_double(parts[i], s.*kBenchStages[i].m_ms))
+        return false;
+    }
+    if (!strings::to_uint64(parts[6], s.m_tokenFeaturesCacheHits) ||
+        !strings::to_uint64(parts[7], s.m_tokenFeaturesCacheMisses))
+    {
+      return false;
+    }
+    stats.push_back(s);
+  }
+  return true;
+}
+
+void WriteBenchCSV(string const & path, vector<RequestStats> const & stats,
+                   vector<pair<string, string>> const & requests)
+{
+  ofstream csv(path);
+  if (!csv.is_open())
+  {
+    LOG(LERROR, ("Can't open file for CSV dump:", path));
+    return;
+  }
+
+  csv << kBenchCSVHeader << endl;
+  csv << fixed << setprecision(3);
+  for (size_t i = 0; i < stats.size(); ++i)
+  {
+    for (auto const & stage : kBenchStages)
+      csv << stats[i].*stage.m_ms << ",";
+    csv << stats[i].m_tokenFeaturesCacheHits << "," << stats[i].m_tokenFeaturesCacheMisses << ","
+        << requests[i].first << "," << requests[i].second << endl;
+  }
+}
+
+double HitRate(uint64_t hits, uint64_t misses)
+{
+  return hits + misses == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses);
+}
+
+// Replays every query against every viewport |runs| times, keeping up to |inFlight| requests
+// in the engine at once, and prints the percentiles of the times of the search stages.
+// The percentiles are compared with the ones of |baselinePath| when it's not empty.
+void RunBenchmark(TestSearchEngine & engine, vector<string> const & viewportNames,
+                  string queriesPath, string const & locale, size_t runs, size_t inFlight,
+                  string const & outputPath, string const & baselinePath)
+{
+  base::ScopedLogAbortLevelChanger const logAbortLevel(LCRITICAL);
+  base::ScopedLogLevelChanger const logLevel(LWARNING);
+
+  vector<string> queries;
+  if (queriesPath.empty())
+    queriesPath = base::JoinPath(GetPlatform().WritableDir(), kDefaultQueriesPathSuffix);
+  ReadStringsFromFile(queriesPath, queries);
+
+  // (viewport name, query) of every request.
+  vector<pair<string, string>> requests;
+  vector<m2::RectD> viewports;
+  for (size_t run = 0; run < runs; ++run)
+  {
+    for (auto const & name : viewportNames)
+    {
+      m2::RectD viewport;
+      InitViewport(name, viewport);
+      for (auto const & query : queries)
+      {
+        requests.emplace_back(name, MakePrefixFree(query));
+        viewports.push_back(viewport);
+      }
+    }
+  }
+
+  vector<RequestStats> stats(requests.size());
+  auto const engineStatsBefore = engine.GetStats();
+  uint64_t const numAllocationsBefore = g_numAllocations.load();
+  base::Timer timer;
+
+  for (size_t from = 0; from < requests.size(); from += inFlight)
+  {
+    size_t const to = min(requests.size(), from + inFlight);
+    vector<unique_ptr<TestSearchRequest>> batch;
+    for (size_t i = from; i < to; ++i)
+    {
+      batch.emplace_back(make_unique<TestSearchRequest>(engine, requests[i].second, locale,
+                                                        Mode::Everywhere, viewports[i]));
+      batch.back()->Start();
+    }
+    for (size_t i = from; i < to; ++i)
+    {
+      batch[i - from]->Wait();
+      stats[i] = batch[i - from]->Stats();
+    }
+  }
+
+  double const elapsedSeconds = timer.ElapsedSeconds();
+  uint64_t const numAllocations = g_numAllocations.load() - numAllocationsBefore;
+  auto const engineStats = engine.GetStats();
+
+  if (!outputPath.empty())
+    WriteBenchCSV(outputPath, stats, requests);
+
+  vector<RequestStats> baseline;
+  if (!baselinePath.empty() && !ReadBenchCSV(baselinePath, baseline))
+  {
+    LOG(LERROR, ("Can't read baseline stats from", baselinePath));
+    baseline.clear();
+  }
+
+  auto const times = GetStageTimes(stats);
+  auto const baselineTimes = GetStageTimes(baseline);
+  double const kPercentiles[] = {50, 90, 99, 100};
+
+  cout << fixed << setprecision(3);
+  cout << "Requests: " << requests.size() << " in " << elapsedSeconds << "s" << endl;
+  cout << "Allocations per request: "
+       << (requests.empty() ? 0 : numAllocations / requests.size()) << endl;
+  cout << endl;
+
+  cout << setw(14) << "stage, ms";
+  for (auto const p : kPercentiles)
+    cout << setw(12) << ("p" + to_string(static_cast<int>(p)));
+  cout << endl;
+  for (size_t i = 0; i < times.size(); ++i)
+  {
+    cout << setw(14) << kBenchStages[i].m_name;
+    for (auto const p : kPercentiles)
+      cout << setw(12) << Percentile(times[i], p);
+    cout << endl;
+
+    if (baseline.empty())
+      continue;
+
+    cout << setw(14) << "baseline";
+    for (auto const p : kPercentiles)
+      cout << setw(12) << Percentile(baselineTimes[i], p);
+    cout << endl;
+
+    cout << setw(14) << "change, %";
+    for (auto const p : kPercentiles)
+    {
+      double const base = Percentile(baselineTimes[i], p);
+      double const curr = Percentile(times[i], p);
+      cout << setw(12) << (base == 0.0 ? 0.0 : 100.0 * (curr - base) / base);
+    }
+    cout << endl;
+  }
+  cout << endl;
+
+  cout << "Total time histogram:" << endl;
+  PrintLatencyHistogram(times.back());
+  cout << endl;
+
+  uint64_t tokenCacheHits = 0;
+  uint64_t tokenCacheMisses = 0;
+  for (auto const & s : stats)
+  {
+    tokenCacheHits += s.m_tokenFeaturesCacheHits;
+    tokenCacheMisses += s.m_tokenFeaturesCacheMisses;
+  }
+  cout << "Token features cache hit rate: " << HitRate(tokenCacheHits, tokenCacheMisses) << "%"
+       << endl;
+  cout << "Categories cache hit rate: "
+       << HitRate(engineStats.m_categoriesCacheHits - engineStatsBefore.m_categoriesCacheHits,
+                  engineStats.m_categoriesCacheMisses - engineStatsBefore.m_categoriesCacheMisses)
+       << "%" << endl;
+}
+
 int main(int argc, char * argv[])
 {
   platform::tests_support::ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
@@ -384,6 +668,20 @@ int main(int argc, char * argv[])
     return 0;
   }
 
+  if (FLAGS_benchmark)
+  {
+    auto viewportNames = strings::Tokenize<string>(FLAGS_bench_viewports, ",");
+    if (viewportNames.empty())
+      viewportNames.push_back(FLAGS_viewport);
+
+    auto const inFlight = FLAGS_bench_in_flight > 0 ? FLAGS_bench_in_flight : FLAGS_num_threads;
+    RunBenchmark(*engine, viewportNames, FLAGS_queries_path, FLAGS_locale,
+                 static_cast<size_t>(max(FLAGS_bench_runs, 1)),
+                 static_cast<size_t>(max(inFlight, 1)), FLAGS_bench_output,
+                 FLAGS_bench_baseline);
+    return 0;
+  }
+
   RunRequests(*engine, viewport, FLAGS_queries_path, FLAGS_locale, FLAGS_ranking_csv_file,
               static_cast<size_t>(FLAGS_top));
   return 0;
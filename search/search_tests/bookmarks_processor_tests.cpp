@@ -207,4 +207,37 @@ UNIT_CLASS_TEST(BookmarksProcessorTest, IndexDescriptions)
   TEST_EQUAL(Search("cherry pie"), Ids{}, ());
 }
 
+UNIT_CLASS_TEST(BookmarksProcessorTest, Groups)
+{
+  GetProcessor().EnableIndexingOfBookmarkGroup(GroupId{0}, true /* enable */);
+  GetProcessor().EnableIndexingOfBookmarkGroup(GroupId{1}, true /* enable */);
+
+  auto const diner = MakeBookmarkData("Double R Diner" /* name */, "" /* customName */,
+                                      "" /* description */, {"amenity-cafe"} /* types */);
+  Add(Id{10}, GroupId{0}, diner);
+  Add(Id{12}, GroupId{1},
+      MakeBookmarkData("Diner" /* name */, "" /* customName */, "" /* description */,
+                       {"amenity-cafe"} /* types */));
+
+  TEST_EQUAL(Search("diner", GroupId{0}), Ids({10}), ());
+  TEST_EQUAL(Search("diner", GroupId{1}), Ids({12}), ());
+  TEST_EQUAL(Search("diner", GroupId{2}), Ids{}, ());
+
+  GetProcessor().EnableIndexingOfBookmarkGroup(GroupId{1}, false /* enable */);
+  TEST_EQUAL(Search("diner"), Ids({10}), ());
+  TEST_EQUAL(Search("diner", GroupId{1}), Ids{}, ());
+
+  // An update which doesn't change the tokens keeps the bookmark in its group.
+  Update(Id{10}, diner);
+  TEST_EQUAL(Search("diner", GroupId{0}), Ids({10}), ());
+
+  GetProcessor().EnableIndexingOfBookmarkGroup(GroupId{1}, true /* enable */);
+  TEST_EQUAL(Search("diner"), Ids({12, 10}), ());
+
+  DetachFromGroup(Id{12}, GroupId{1});
+  TEST_EQUAL(Search("diner"), Ids({10}), ());
+  AttachToGroup(Id{12}, GroupId{1});
+  TEST_EQUAL(Search("diner", GroupId{1}), Ids({12}), ());
+}
+
 } // namespace bookmarks_processor_tests
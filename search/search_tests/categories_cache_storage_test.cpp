@@ -0,0 +1,119 @@
+#include "testing/testing.hpp"
+
+#include "search/categories_cache.hpp"
+#include "search/cbv.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+class TestMwmInfo : public MwmInfo
+{
+public:
+  TestMwmInfo() { SetStatus(STATUS_REGISTERED); }
+};
+
+CBV MakeFeatures(vector<uint64_t> const & ids)
+{
+  return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(ids));
+}
+}  // namespace
+
+UNIT_TEST(CategoriesCacheStorage_Smoke)
+{
+  // Every shard keeps up to 64 bytes, i.e. 8 sparse features.
+  CategoriesCacheStorage storage(16 * 64 /* maxBytes */);
+
+  auto const info = make_shared<TestMwmInfo>();
+  MwmSet::MwmId const id(info);
+
+  size_t numLoads = 0;
+  auto const get = [&](vector<uint32_t> const & categories, vector<uint64_t> ids) {
+    // Features are far from each other, so they are stored sparse, 8 bytes per feature.
+    for (auto & featureId : ids)
+      featureId *= 1000;
+    return storage.Get(id, categories, [&]() {
+      ++numLoads;
+      return MakeFeatures(ids);
+    });
+  };
+
+  auto features = get({1, 2}, {1, 2, 3, 4});
+  TEST_EQUAL(numLoads, 1, ());
+  TEST_EQUAL(features.PopCount(), 4, ());
+
+  features = get({1, 2}, {});
+  TEST_EQUAL(numLoads, 1, ());
+  TEST_EQUAL(features.PopCount(), 4, ());
+  TEST_EQUAL(storage.GetMemorySize(), 32, ());
+
+  get({3}, {5, 6, 7, 8});
+  TEST_EQUAL(numLoads, 2, ());
+  TEST_EQUAL(storage.GetNumEntries(), 2, ());
+  TEST_EQUAL(storage.GetMemorySize(), 64, ());
+
+  // {1, 2} is the most recently used entry, so {3} is evicted.
+  get({1, 2}, {});
+  get({4}, {9, 10, 11, 12});
+  TEST_EQUAL(numLoads, 3, ());
+  TEST_EQUAL(storage.GetNumEntries(), 2, ());
+  TEST_EQUAL(storage.GetMemorySize(), 64, ());
+
+  get({1, 2}, {});
+  TEST_EQUAL(numLoads, 3, ());
+  get({3}, {5, 6, 7, 8});
+  TEST_EQUAL(numLoads, 4, ());
+
+  // An entry larger than the limit is still returned and cached alone.
+  features = get({5}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  TEST_EQUAL(features.PopCount(), 10, ());
+  TEST_EQUAL(storage.GetNumEntries(), 1, ());
+
+  storage.Clear();
+  TEST_EQUAL(storage.GetNumEntries(), 0, ());
+  TEST_EQUAL(storage.GetMemorySize(), 0, ());
+}
+
+UNIT_TEST(CategoriesCacheStorage_Threads)
+{
+  CategoriesCacheStorage storage(1024 * 1024 /* maxBytes */);
+
+  vector<shared_ptr<TestMwmInfo>> infos;
+  for (size_t i = 0; i < 8; ++i)
+    infos.push_back(make_shared<TestMwmInfo>());
+
+  atomic<size_t> numLoads = 0;
+  auto const fn = [&]() {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      auto const & info = infos[i % infos.size()];
+      auto const features =
+          storage.Get(MwmSet::MwmId(info), {static_cast<uint32_t>(i % 3)}, [&]() {
+            ++numLoads;
+            return MakeFeatures({i % infos.size()});
+          });
+      TEST(features.HasBit(i % infos.size()), ());
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+    threads.emplace_back(fn);
+  for (auto & t : threads)
+    t.join();
+
+  // Features may be loaded concurrently by several threads, but only once they are cached.
+  TEST_EQUAL(storage.GetNumEntries(), infos.size() * 3, ());
+  TEST_LESS_OR_EQUAL(numLoads, infos.size() * 3 * threads.size(), ());
+}
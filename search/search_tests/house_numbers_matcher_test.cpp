@@ -174,6 +174,23 @@ UNIT_TEST(HouseNumber_Matcher)
   TEST(!HouseNumbersMatch("12,14", "13"), ());
 }
 
+UNIT_TEST(HouseNumber_Matcher_Parsed)
+{
+  UniString const houseNumber = MakeUniString("12;14");
+  vector<vector<Token>> parses;
+  ParseHouseNumber(houseNumber, parses);
+
+  for (string const query : {"12", "14", "13", "2", "12 к2"})
+  {
+    vector<Token> queryParse;
+    ParseQuery(MakeUniString(query), false /* isPrefix */, queryParse);
+    bool const matches = search::house_numbers::HouseNumbersMatch(houseNumber, queryParse);
+    TEST_EQUAL(search::house_numbers::HouseNumbersMatch(parses, queryParse), matches, (query));
+    if (matches)
+      TEST(HouseNumbersMayMatch(houseNumber, queryParse), (query));
+  }
+}
+
 UNIT_TEST(HouseNumber_Matcher_Conscription)
 {
   TEST(HouseNumbersMatchConscription("77/21", "77"), ());
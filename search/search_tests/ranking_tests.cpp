@@ -247,6 +247,52 @@ UNIT_TEST(RankingInfo_PrefixVsFull)
   }
 }
 
+UNIT_TEST(RankingInfo_MaxLinearModelRank)
+{
+  RankingInfo info;
+  info.m_nameScore = NameScore::FULL_MATCH;
+  info.m_errorsMade = ErrorsMade(0);
+  info.m_numTokens = 1;
+  info.m_matchedFraction = 1;
+  info.m_allTokensUsed = true;
+  info.m_distanceToPivot = 5e4;
+  info.m_rank = 100;
+  info.m_popularity = 10;
+
+  auto country = info;
+  country.m_tokenRanges[Model::TYPE_COUNTRY] = TokenRange(0, 1);
+  country.m_type = Model::TYPE_COUNTRY;
+
+  auto cafe = info;
+  cafe.m_tokenRanges[Model::TYPE_SUBPOI] = TokenRange(0, 1);
+  cafe.m_type = Model::TYPE_SUBPOI;
+  cafe.m_classifType.poi = PoiType::TransportMajor;
+
+  for (auto const & r : {country, cafe})
+  {
+    double const maxRank = RankingInfo::GetMaxLinearModelRank(r.m_distanceToPivot, r.m_rank,
+                                                              r.m_popularity, false /* categorial */);
+    TEST_LESS_OR_EQUAL(r.GetLinearModelRank(), maxRank, (r));
+
+    // The bound decreases with the distance and increases with the rank.
+    TEST_LESS(RankingInfo::GetMaxLinearModelRank(2 * r.m_distanceToPivot, r.m_rank, r.m_popularity,
+                                                 false /* categorial */),
+              maxRank, ());
+    TEST_LESS(maxRank, RankingInfo::GetMaxLinearModelRank(r.m_distanceToPivot, r.m_rank + 1,
+                                                          r.m_popularity, false /* categorial */),
+              ());
+  }
+
+  auto category = info;
+  category.m_categorialRequest = true;
+  category.m_hasName = true;
+  category.m_type = Model::TYPE_SUBPOI;
+  TEST_LESS_OR_EQUAL(category.GetLinearModelRank(),
+                     RankingInfo::GetMaxLinearModelRank(category.m_distanceToPivot, category.m_rank,
+                                                        category.m_popularity, true /* categorial */),
+                     ());
+}
+
 namespace
 {
 class MwmIdWrapper
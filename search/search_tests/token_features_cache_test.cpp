@@ -0,0 +1,97 @@
+#include "testing/testing.hpp"
+
+#include "search/cbv.hpp"
+#include "search/token_features_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+class TestMwmInfo : public MwmInfo
+{
+public:
+  TestMwmInfo() { SetStatus(STATUS_REGISTERED); }
+
+  void Deregister() { SetStatus(STATUS_DEREGISTERED); }
+};
+
+TokenFeaturesCache::Features MakeFeatures(vector<uint64_t> const & ids)
+{
+  return TokenFeaturesCache::Features(CBV(coding::CompressedBitVectorBuilder::FromBitPositions(ids)));
+}
+}  // namespace
+
+UNIT_TEST(TokenFeaturesCache_Smoke)
+{
+  TokenFeaturesCache cache(2 /* maxNumEntries */);
+
+  auto const info = make_shared<TestMwmInfo>();
+  MwmSet::MwmId const id(info);
+
+  size_t numLoads = 0;
+  auto const get = [&](string const & key, vector<uint64_t> const & ids) {
+    return cache.Get(id, key, [&]() {
+      ++numLoads;
+      return MakeFeatures(ids);
+    });
+  };
+
+  auto features = get("a", {1, 2});
+  TEST_EQUAL(numLoads, 1, ());
+  TEST_EQUAL(features.m_features.PopCount(), 2, ());
+
+  features = get("a", {3});
+  TEST_EQUAL(numLoads, 1, ());
+  TEST(features.m_features.HasBit(1), ());
+  TEST(features.m_features.HasBit(2), ());
+
+  get("b", {3});
+  TEST_EQUAL(numLoads, 2, ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  // "b" is the most recently used entry, so "a" is evicted.
+  get("b", {});
+  get("c", {4});
+  TEST_EQUAL(numLoads, 3, ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  get("b", {});
+  TEST_EQUAL(numLoads, 3, ());
+  get("a", {1, 2});
+  TEST_EQUAL(numLoads, 4, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  get("a", {1, 2});
+  TEST_EQUAL(numLoads, 5, ());
+}
+
+UNIT_TEST(TokenFeaturesCache_DeadMwms)
+{
+  TokenFeaturesCache cache(4 /* maxNumEntries */);
+
+  auto const oldInfo = make_shared<TestMwmInfo>();
+  auto const newInfo = make_shared<TestMwmInfo>();
+  MwmSet::MwmId const oldId(oldInfo);
+  MwmSet::MwmId const newId(newInfo);
+
+  auto const loader = []() { return MakeFeatures({1}); };
+
+  cache.Get(oldId, "a", loader);
+  cache.Get(oldId, "b", loader);
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  oldInfo->Deregister();
+  cache.Get(newId, "a", loader);
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+}
@@ -29,6 +29,8 @@ public:
 
   std::weak_ptr<ProcessorHandle> Search(SearchParams const & params);
 
+  Engine::Stats GetStats() const { return m_engine.GetStats(); }
+
   storage::CountryInfoGetter & GetCountryInfoGetter() { return *m_infoGetter; }
 
 private:
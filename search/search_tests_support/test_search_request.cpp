@@ -5,6 +5,7 @@
 #include "base/assert.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace search
 {
@@ -72,6 +73,14 @@ vector<search::Result> const & TestSearchRequest::Results() const
   return m_results;
 }
 
+RequestStats const & TestSearchRequest::Stats() const
+{
+  lock_guard<mutex> lock(m_mu);
+  CHECK(m_done, ("This function may be called only when request is processed."));
+  CHECK(m_params.m_stats, ());
+  return *m_params.m_stats;
+}
+
 void TestSearchRequest::Start()
 {
   m_engine.Search(m_params);
@@ -87,6 +96,8 @@ void TestSearchRequest::SetUpCallbacks()
 {
   m_params.m_onStarted = bind(&TestSearchRequest::OnStarted, this);
   m_params.m_onResults = bind(&TestSearchRequest::OnResults, this, placeholders::_1);
+  if (!m_params.m_stats)
+    m_params.m_stats = make_shared<RequestStats>();
 }
 
 void TestSearchRequest::SetUpResultParams()
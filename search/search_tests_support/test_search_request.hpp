@@ -2,6 +2,7 @@
 
 #include "geometry/rect2d.hpp"
 
+#include "search/request_stats.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
 
@@ -44,6 +45,7 @@ public:
   using TimeDurationT = base::Timer::DurationT;
   TimeDurationT ResponseTime() const;
   std::vector<search::Result> const & Results() const;
+  RequestStats const & Stats() const;
 
 protected:
   TestSearchRequest(TestSearchEngine & engine, std::string const & query,
@@ -0,0 +1,87 @@
+#include "search/token_features_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace search
+{
+TokenFeaturesCache::TokenFeaturesCache(size_t maxNumEntries) : m_maxNumEntries(maxNumEntries)
+{
+  CHECK_GREATER(m_maxNumEntries, 0, ());
+}
+
+TokenFeaturesCache::Features TokenFeaturesCache::Get(MwmSet::MwmId const & id,
+                                                     std::string const & key, Loader const & loader)
+{
+  auto const isSameKey = [&key](Entry const & entry) { return entry.m_key == key; };
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_entries.find(id);
+    if (it != m_entries.end())
+    {
+      auto & entries = it->second;
+      auto const entryIt = std::find_if(entries.begin(), entries.end(), isSameKey);
+      if (entryIt != entries.end())
+      {
+        std::rotate(entries.begin(), entryIt, std::next(entryIt));
+        ++m_stats.m_hits;
+        return entries.front().m_features;
+      }
+    }
+  }
+
+  // Retrieval may be long and may throw CancelException, nothing is cached then.
+  auto features = loader();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_stats.m_misses;
+  if (m_entries.count(id) == 0)
+    RemoveDeadMwms();
+
+  auto & entries = m_entries[id];
+  if (std::none_of(entries.begin(), entries.end(), isSameKey))
+  {
+    entries.push_front({key, features});
+    if (entries.size() == m_maxNumEntries + 1)
+      entries.pop_back();
+  }
+  ASSERT_LESS_OR_EQUAL(entries.size(), m_maxNumEntries, ());
+  return features;
+}
+
+void TokenFeaturesCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+size_t TokenFeaturesCache::GetNumEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t numEntries = 0;
+  for (auto const & p : m_entries)
+    numEntries += p.second.size();
+  return numEntries;
+}
+
+TokenFeaturesCache::Stats TokenFeaturesCache::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void TokenFeaturesCache::RemoveDeadMwms()
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (!it->first.IsAlive())
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+}  // namespace search
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "search/retrieval.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace search
+{
+// This class caches features retrieved from the search index for the query tokens. It lives
+// across queries, so as-you-type requests which resend almost the same tokens on every
+// keystroke don't walk the search index trie for the tokens they already had.
+//
+// Entries are keyed by mwm and by a string which identifies the retrieval request
+// (the token, its synonyms, types and languages). Entries of deregistered mwms are dropped
+// when a new mwm is added.
+//
+// *NOTE* This class is thread-safe.
+class TokenFeaturesCache
+{
+public:
+  using Features = Retrieval::ExtendedFeatures;
+  using Loader = std::function<Features()>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  // |maxNumEntries| denotes the maximum number of tokens that will be cached
+  // for each mwm individually.
+  explicit TokenFeaturesCache(size_t maxNumEntries);
+
+  // Returns cached features or features from |loader| which are put to the cache.
+  // |loader| is called without holding the lock.
+  Features Get(MwmSet::MwmId const & id, std::string const & key, Loader const & loader);
+
+  void Clear();
+
+  size_t GetNumEntries() const;
+
+  // Returns the numbers of Get() calls since the cache was created.
+  Stats GetStats() const;
+
+private:
+  struct Entry
+  {
+    std::string m_key;
+    Features m_features;
+  };
+
+  void RemoveDeadMwms();
+
+  mutable std::mutex m_mutex;
+  std::map<MwmSet::MwmId, std::deque<Entry>> m_entries;
+  size_t const m_maxNumEntries;
+  Stats m_stats;
+};
+}  // namespace search
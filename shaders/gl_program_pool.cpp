@@ -5,8 +5,34 @@
 #include "drape/gl_gpu_program.hpp"
 #include "drape/gl_functions.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+
+#include <functional>
+#include <utility>
+
 namespace gpu
 {
+namespace
+{
+std::string const kDumpFileName = "gl_programs_dump.bin";
+uint32_t constexpr kDumpVersion = 1;
+
+std::string GetDumpFilePath()
+{
+  return base::JoinPath(GetPlatform().TmpDir(), kDumpFileName);
+}
+}  // namespace
+
 GLProgramPool::GLProgramPool(dp::ApiVersion apiVersion)
   : m_apiVersion(apiVersion)
 {
@@ -19,11 +45,22 @@ GLProgramPool::GLProgramPool(dp::ApiVersion apiVersion)
 #else
     m_baseDefines = std::string(GLES3_SHADER_VERSION);
 #endif
+
+    m_useProgramBinaries = GLFunctions::glHasProgramBinary();
+    if (m_useProgramBinaries)
+    {
+      m_driverName = GLFunctions::glGetString(gl_const::GLVendor) + "|" +
+                     GLFunctions::glGetString(gl_const::GLRenderer) + "|" +
+                     GLFunctions::glGetString(gl_const::GLVersion);
+      ReadProgramBinaries();
+    }
   }
 }
 
 GLProgramPool::~GLProgramPool()
 {
+  DumpProgramBinaries();
+
   GLFunctions::glUseProgram(0);
   ProgramParams::Destroy();
 }
@@ -31,13 +68,27 @@ GLProgramPool::~GLProgramPool()
 drape_ptr<dp::GpuProgram> GLProgramPool::Get(Program program)
 {
   auto const programInfo = GetProgramInfo(m_apiVersion, program);
+  auto const name = DebugPrint(program);
+
+  uint64_t sourceHash = 0;
+  if (m_useProgramBinaries)
+  {
+    sourceHash = std::hash<std::string>()(m_baseDefines + m_defines +
+                                          programInfo.m_vertexShaderSource +
+                                          programInfo.m_fragmentShaderSource);
+    if (auto binaryProgram = LoadProgramBinary(name, sourceHash))
+      return binaryProgram;
+  }
+
   auto vertexShader = GetShader(programInfo.m_vertexShaderName, programInfo.m_vertexShaderSource,
                                 dp::Shader::Type::VertexShader);
   auto fragmentShader = GetShader(programInfo.m_fragmentShaderName, programInfo.m_fragmentShaderSource,
                                   dp::Shader::Type::FragmentShader);
 
-  auto const name = DebugPrint(program);
-  return make_unique_dp<dp::GLGpuProgram>(name, vertexShader, fragmentShader);
+  auto result = make_unique_dp<dp::GLGpuProgram>(name, vertexShader, fragmentShader);
+  if (m_useProgramBinaries)
+    SaveProgramBinary(name, sourceHash, result->GetID());
+  return result;
 }
 
 void GLProgramPool::SetDefines(std::string const & defines)
@@ -57,4 +108,116 @@ ref_ptr<dp::Shader> GLProgramPool::GetShader(std::string const & name, std::stri
   m_shaders[name] = std::move(shader);
   return result;
 }
+
+drape_ptr<dp::GpuProgram> GLProgramPool::LoadProgramBinary(std::string const & name,
+                                                           uint64_t sourceHash)
+{
+  auto const it = m_programBinaries.find(name);
+  if (it == m_programBinaries.end())
+    return nullptr;
+
+  if (it->second.m_sourceHash == sourceHash)
+  {
+    auto const programID = GLFunctions::glCreateProgram();
+    if (GLFunctions::glProgramBinary(programID, it->second.m_format, it->second.m_data))
+      return make_unique_dp<dp::GLGpuProgram>(name, programID);
+
+    GLFunctions::glDeleteProgram(programID);
+    LOG(LINFO, ("Program binary is rejected by the driver:", name));
+  }
+
+  // The binary is obsolete, it will be replaced after linking.
+  m_programBinaries.erase(it);
+  m_programBinariesChanged = true;
+  return nullptr;
+}
+
+void GLProgramPool::SaveProgramBinary(std::string const & name, uint64_t sourceHash,
+                                      uint32_t programID)
+{
+  ProgramBinary binary;
+  binary.m_sourceHash = sourceHash;
+  if (!GLFunctions::glGetProgramBinary(programID, binary.m_format, binary.m_data))
+    return;
+
+  m_programBinaries[name] = std::move(binary);
+  m_programBinariesChanged = true;
+}
+
+void GLProgramPool::ReadProgramBinaries()
+{
+  auto const dumpFilePath = GetDumpFilePath();
+  if (!GetPlatform().IsFileExistsByFullPath(dumpFilePath))
+    return;
+
+  try
+  {
+    FileReader r(dumpFilePath);
+    NonOwningReaderSource src(r);
+
+    std::string driverName;
+    auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+    if (version == kDumpVersion)
+      rw::Read(src, driverName);
+
+    if (driverName != m_driverName)
+    {
+      // Dump is obsolete.
+      FileWriter::DeleteFileX(dumpFilePath);
+      return;
+    }
+
+    auto const count = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      std::string name;
+      rw::Read(src, name);
+
+      ProgramBinary binary;
+      binary.m_sourceHash = ReadPrimitiveFromSource<uint64_t>(src);
+      binary.m_format = ReadPrimitiveFromSource<uint32_t>(src);
+      auto const size = ReadVarUint<uint32_t>(src);
+      if (size > src.Size())
+        MYTHROW(Reader::SizeException, ("Bad program binary size", size));
+      binary.m_data.resize(size);
+      src.Read(binary.m_data.data(), size);
+
+      m_programBinaries[name] = std::move(binary);
+    }
+  }
+  catch (Reader::Exception const & exception)
+  {
+    LOG(LWARNING, ("Exception while reading file:", dumpFilePath, "reason:", exception.what()));
+    m_programBinaries.clear();
+    FileWriter::DeleteFileX(dumpFilePath);
+  }
+}
+
+void GLProgramPool::DumpProgramBinaries()
+{
+  if (!m_programBinariesChanged)
+    return;
+
+  auto const dumpFilePath = GetDumpFilePath();
+  try
+  {
+    FileWriter w(dumpFilePath);
+    WriteToSink(w, kDumpVersion);
+    rw::Write(w, m_driverName);
+    WriteVarUint(w, static_cast<uint32_t>(m_programBinaries.size()));
+    for (auto const & [name, binary] : m_programBinaries)
+    {
+      rw::Write(w, name);
+      WriteToSink(w, binary.m_sourceHash);
+      WriteToSink(w, static_cast<uint32_t>(binary.m_format));
+      WriteVarUint(w, static_cast<uint32_t>(binary.m_data.size()));
+      w.Write(binary.m_data.data(), binary.m_data.size());
+    }
+  }
+  catch (FileWriter::Exception const & exception)
+  {
+    LOG(LWARNING, ("Exception while writing file:", dumpFilePath, "reason:", exception.what()));
+  }
+  m_programBinariesChanged = false;
+}
 }  // namespace gpu
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace gpu
 {
@@ -23,14 +24,34 @@ public:
   void SetDefines(std::string const & defines);
 
 private:
+  // Linked programs are kept in a dump between launches, so shaders aren't compiled again
+  // until the driver, the app or the defines change.
+  struct ProgramBinary
+  {
+    uint64_t m_sourceHash = 0;
+    glConst m_format = 0;
+    std::vector<uint8_t> m_data;
+  };
+
   ref_ptr<dp::Shader> GetShader(std::string const & name, std::string const & source,
                                 dp::Shader::Type type);
 
+  drape_ptr<dp::GpuProgram> LoadProgramBinary(std::string const & name, uint64_t sourceHash);
+  void SaveProgramBinary(std::string const & name, uint64_t sourceHash, uint32_t programID);
+  void ReadProgramBinaries();
+  void DumpProgramBinaries();
+
   dp::ApiVersion const m_apiVersion;
   std::string m_baseDefines;
 
   using Shaders = std::map<std::string, drape_ptr<dp::Shader>>;
   Shaders m_shaders;
   std::string m_defines;
+
+  bool m_useProgramBinaries = false;
+  bool m_programBinariesChanged = false;
+  // Binaries are valid only for the driver they have been made by.
+  std::string m_driverName;
+  std::map<std::string, ProgramBinary> m_programBinaries;
 };
 }  // namespace gpu
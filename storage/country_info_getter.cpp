@@ -34,6 +34,15 @@ CountryId CountryInfoGetterBase::GetRegionCountryId(m2::PointD const & pt) const
   return id == kInvalidId ? kInvalidCountryId : m_countries[id].m_countryId;
 }
 
+CountriesVec CountryInfoGetterBase::GetRegionCountryIds(std::vector<m2::PointD> const & points) const
+{
+  CountriesVec result;
+  result.reserve(points.size());
+  for (auto const & pt : points)
+    result.push_back(GetRegionCountryId(pt));
+  return result;
+}
+
 bool CountryInfoGetterBase::BelongsToAnyRegion(m2::PointD const & pt,
                                                RegionIdVec const & regions) const
 {
@@ -230,8 +239,9 @@ void CountryInfoReader::LoadRegionsFromDisk(size_t id, std::vector<m2::RegionD>
 }
 
 CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR)
-  : m_reader(polyR), m_cache(3 /* logCacheSize */)
-
+  : m_reader(polyR)
+  , m_cache(3 /* logCacheSize */)
+  , m_grid([this](m2::RectD const & cell) { return ClassifyGridCell(cell); })
 {
   ReaderSource<ModelReaderPtr> src(m_reader.GetReader(PACKED_POLYGONS_INFO_TAG));
   rw::Read(src, m_countries);
@@ -268,6 +278,42 @@ std::invoke_result_t<Fn, std::vector<m2::RegionD>> CountryInfoReader::WithRegion
   return fn(regions);
 }
 
+CountryInfoGetterBase::RegionId CountryInfoReader::FindFirstCountry(m2::PointD const & pt) const
+{
+  uint32_t const id = m_grid.Find(pt);
+  if (id == CountryInfoGrid::kNoCountry)
+    return kInvalidId;
+  if (id == CountryInfoGrid::kBorder)
+    return CountryInfoGetter::FindFirstCountry(pt);
+  return id;
+}
+
+uint32_t CountryInfoReader::ClassifyGridCell(m2::RectD const & cell) const
+{
+  for (size_t id = 0; id < m_countries.size(); ++id)
+  {
+    if (!m_countries[id].m_rect.IsIntersect(cell))
+      continue;
+
+    auto const position = WithRegion(id, [&cell](std::vector<m2::RegionD> const & regions) {
+      return CountryInfoGrid::GetCellPosition(regions, cell);
+    });
+
+    if (position == CountryInfoGrid::CellPosition::Outside)
+      continue;
+
+    // The first country which touches the cell has to own all of it, otherwise
+    // FindFirstCountry() depends on the point.
+    if (position == CountryInfoGrid::CellPosition::Inside &&
+        m_countries[id].m_rect.IsRectInside(cell))
+    {
+      return static_cast<uint32_t>(id);
+    }
+    return CountryInfoGrid::kBorder;
+  }
+  return CountryInfoGrid::kNoCountry;
+}
+
 bool CountryInfoReader::BelongsToRegion(m2::PointD const & pt, size_t id) const
 {
   if (!m_countries[id].m_rect.IsPointInside(pt))
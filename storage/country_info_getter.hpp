@@ -1,6 +1,7 @@
 #pragma once
 
 #include "storage/country_decl.hpp"
+#include "storage/country_info_grid.hpp"
 #include "storage/storage_defines.hpp"
 
 #include "platform/platform.hpp"
@@ -37,6 +38,9 @@ public:
   // string.
   CountryId GetRegionCountryId(m2::PointD const & pt) const;
 
+  // Returns GetRegionCountryId() for each of |points|.
+  CountriesVec GetRegionCountryIds(std::vector<m2::PointD> const & points) const;
+
   // Returns true when |pt| belongs to at least one of the specified
   // |regions|.
   bool BelongsToAnyRegion(m2::PointD const & pt, RegionIdVec const & regions) const;
@@ -48,7 +52,7 @@ public:
 
 protected:
   // Returns identifier of the first country containing |pt| or |kInvalidId| if there is none.
-  RegionId FindFirstCountry(m2::PointD const & pt) const;
+  virtual RegionId FindFirstCountry(m2::PointD const & pt) const;
 
   // Returns true when |pt| belongs to the country identified by |id|.
   virtual bool BelongsToRegion(m2::PointD const & pt, size_t id) const = 0;
@@ -142,6 +146,9 @@ public:
 protected:
   CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR);
 
+  // CountryInfoGetterBase overrides:
+  RegionId FindFirstCountry(m2::PointD const & pt) const override;
+
   // CountryInfoGetter overrides:
   void ClearCachesImpl() const override;
   bool BelongsToRegion(m2::PointD const & pt, size_t id) const override;
@@ -151,9 +158,16 @@ protected:
   template <typename Fn>
   std::invoke_result_t<Fn, std::vector<m2::RegionD>> WithRegion(size_t id, Fn && fn) const;
 
+  // Classifies a cell of |m_grid|, see CountryInfoGrid::ClassifyFn.
+  uint32_t ClassifyGridCell(m2::RectD const & cell) const;
+
   FilesContainerR m_reader;
   mutable base::Cache<uint32_t, std::vector<m2::RegionD>> m_cache;
   mutable std::mutex m_cacheMutex;
+
+  // Cells of the grid are filled on the first lookups, so most of the next lookups
+  // don't need the polygons at all.
+  CountryInfoGrid m_grid;
 };
 
 // This class allows users to get info about very simply rectangular
@@ -0,0 +1,108 @@
+#include "storage/country_info_grid.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect_intersect.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace storage
+{
+// static
+CountryInfoGrid::CellPosition CountryInfoGrid::GetCellPosition(
+    std::vector<m2::RegionD> const & regions, m2::RectD const & cell)
+{
+  for (auto const & region : regions)
+  {
+    auto const & points = region.Data();
+    if (points.empty() || !region.GetRect().IsIntersect(cell))
+      continue;
+
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+    {
+      m2::PointD p1 = points[j];
+      m2::PointD p2 = points[i];
+      if (m2::Intersect(cell, p1, p2))
+        return CellPosition::Border;
+    }
+  }
+
+  // There are no borders in the cell, so the whole cell is on the same side as its center.
+  auto const center = cell.Center();
+  for (auto const & region : regions)
+  {
+    if (region.Contains(center))
+      return CellPosition::Inside;
+  }
+  return CellPosition::Outside;
+}
+
+CountryInfoGrid::CountryInfoGrid(ClassifyFn && classify)
+  : m_classify(std::move(classify)), m_cells(new std::atomic<uint32_t>[kTopSize * kTopSize])
+{
+  for (uint32_t i = 0; i < kTopSize * kTopSize; ++i)
+    m_cells[i].store(kUnknown, std::memory_order_relaxed);
+}
+
+uint32_t CountryInfoGrid::Find(m2::PointD const & pt) const
+{
+  auto const & bounds = mercator::Bounds::FullRect();
+  if (!bounds.IsPointInside(pt))
+    return kBorder;
+
+  uint32_t constexpr kFullSize = kTopSize * kSubSize;
+  auto const toCell = [kFullSize](double v, double min, double size) {
+    auto const i = static_cast<int64_t>(std::floor((v - min) / size * kFullSize));
+    return static_cast<uint32_t>(std::clamp<int64_t>(i, 0, kFullSize - 1));
+  };
+  uint32_t const x = toCell(pt.x, bounds.minX(), bounds.SizeX());
+  uint32_t const y = toCell(pt.y, bounds.minY(), bounds.SizeY());
+
+  auto & cell = m_cells[(y / kSubSize) * kTopSize + x / kSubSize];
+  uint32_t id = cell.load(std::memory_order_relaxed);
+  if (id == kUnknown)
+  {
+    // Several threads may classify the same cell, they get the same result.
+    id = m_classify(Inflate(GetCellRect(x / kSubSize, y / kSubSize, kTopSize)));
+    cell.store(id, std::memory_order_relaxed);
+  }
+
+  if (id != kBorder)
+    return id;
+
+  uint32_t const key = y * kFullSize + x;
+  {
+    std::lock_guard<std::mutex> lock(m_subcellsMutex);
+    auto const it = m_subcells.find(key);
+    if (it != m_subcells.cend())
+      return it->second;
+  }
+
+  id = m_classify(Inflate(GetCellRect(x, y, kFullSize)));
+
+  std::lock_guard<std::mutex> lock(m_subcellsMutex);
+  m_subcells.emplace(key, id);
+  return id;
+}
+
+// static
+m2::RectD CountryInfoGrid::Inflate(m2::RectD rect)
+{
+  double constexpr kMargin = 1e-5;
+  rect.Inflate(kMargin, kMargin);
+  return rect;
+}
+
+m2::RectD CountryInfoGrid::GetCellRect(uint32_t x, uint32_t y, uint32_t size) const
+{
+  ASSERT_LESS(x, size, ());
+  ASSERT_LESS(y, size, ());
+  auto const & bounds = mercator::Bounds::FullRect();
+  double const sizeX = bounds.SizeX() / size;
+  double const sizeY = bounds.SizeY() / size;
+  return {bounds.minX() + x * sizeX, bounds.minY() + y * sizeY, bounds.minX() + (x + 1) * sizeX,
+          bounds.minY() + (y + 1) * sizeY};
+}
+}  // namespace storage
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace storage
+{
+// Two-level grid over the mercator plane which is filled lazily by lookups. A cell keeps the
+// id of the first country which contains the whole cell or a mark that no country touches it,
+// so most lookups don't test polygons at all. Top level cells crossed by borders are split
+// into subcells, lookups in subcells crossed by borders need the exact polygon tests.
+//
+// *NOTE* This class is thread-safe.
+class CountryInfoGrid
+{
+public:
+  static uint32_t constexpr kNoCountry = std::numeric_limits<uint32_t>::max() - 1;
+  static uint32_t constexpr kBorder = std::numeric_limits<uint32_t>::max() - 2;
+
+  // Number of top level cells along an axis and subcells of a top level cell along an axis,
+  // a subcell is about 10 km on the equator.
+  static uint32_t constexpr kTopSize = 256;
+  static uint32_t constexpr kSubSize = 16;
+
+  enum class CellPosition
+  {
+    Inside,
+    Outside,
+    Border
+  };
+
+  // Returns Inside if |cell| is inside one of |regions|, Outside if |cell| doesn't intersect
+  // any of them and Border otherwise.
+  static CellPosition GetCellPosition(std::vector<m2::RegionD> const & regions,
+                                      m2::RectD const & cell);
+
+  // Returns id of the first country which contains the whole cell, kNoCountry if there
+  // are no countries in the cell or kBorder otherwise.
+  using ClassifyFn = std::function<uint32_t(m2::RectD const & cell)>;
+
+  explicit CountryInfoGrid(ClassifyFn && classify);
+
+  // Returns id of the country which contains |pt|, kNoCountry or kBorder if |pt| is close to
+  // a border and the exact check is needed.
+  uint32_t Find(m2::PointD const & pt) const;
+
+private:
+  static uint32_t constexpr kUnknown = std::numeric_limits<uint32_t>::max();
+
+  // Returns |rect| extended by a margin, so borders close to the cell sides are not missed by
+  // the rounding errors of the classification.
+  static m2::RectD Inflate(m2::RectD rect);
+
+  m2::RectD GetCellRect(uint32_t x, uint32_t y, uint32_t size) const;
+
+  ClassifyFn m_classify;
+
+  std::unique_ptr<std::atomic<uint32_t>[]> m_cells;
+
+  // Subcells of the top level border cells, keyed by y * kTopSize * kSubSize + x.
+  mutable std::unordered_map<uint32_t, uint32_t> m_subcells;
+  mutable std::mutex m_subcellsMutex;
+
+  DISALLOW_COPY_AND_MOVE(CountryInfoGrid);
+};
+}  // namespace storage
@@ -393,12 +393,11 @@ MwmSubtreeAttrs LoadGroupImpl(size_t depth, json_t * node, CountryId const & par
   return make_pair(mwmCounter, mwmSize);
 }
 
-bool LoadCountriesImpl(string const & jsonBuffer, StoreInterface & store)
+bool LoadCountriesImpl(json_t * root, StoreInterface & store)
 {
   try
   {
-    base::Json root(jsonBuffer.c_str());
-    LoadGroupImpl(0 /* depth */, root.get(), kInvalidCountryId, store);
+    LoadGroupImpl(0 /* depth */, root, kInvalidCountryId, store);
     return true;
   }
   catch (base::Json::Exception const & e)
@@ -408,35 +407,44 @@ bool LoadCountriesImpl(string const & jsonBuffer, StoreInterface & store)
   }
 }
 
-int64_t LoadCountriesFromBuffer(string const & jsonBuffer, CountryTree & countries,
-                                Affiliations & affiliations,
-                                CountryNameSynonyms & countryNameSynonyms,
-                                MwmTopCityGeoIds & mwmTopCityGeoIds,
-                                MwmTopCountryGeoIds & mwmTopCountryGeoIds)
+namespace
+{
+// Parses |jsonBuffer| to |root|. Returns version of the countries file or -1 if it is broken.
+int64_t ParseCountriesJson(string const & jsonBuffer, base::Json & root)
 {
-  countries.Clear();
-  affiliations.clear();
-
   int64_t version = -1;
   try
   {
-    base::Json root(jsonBuffer.c_str());
+    root.ParseFrom(jsonBuffer);
     FromJSONObject(root.get(), "v", version);
-
-    StoreCountries store(countries, affiliations, countryNameSynonyms, mwmTopCityGeoIds,
-                         mwmTopCountryGeoIds);
-    if (!LoadCountriesImpl(jsonBuffer, store))
-      return -1;
   }
   catch (base::Json::Exception const & e)
   {
     LOG(LWARNING, (e.Msg()));
+    return -1;
   }
   return version;
 }
 
-namespace
+int64_t LoadCountriesFromJson(base::Json const & root, int64_t version, CountryTree & countries,
+                              Affiliations & affiliations,
+                              CountryNameSynonyms & countryNameSynonyms,
+                              MwmTopCityGeoIds & mwmTopCityGeoIds,
+                              MwmTopCountryGeoIds & mwmTopCountryGeoIds)
 {
+  countries.Clear();
+  affiliations.clear();
+
+  if (version < 0)
+    return -1;
+
+  StoreCountries store(countries, affiliations, countryNameSynonyms, mwmTopCityGeoIds,
+                       mwmTopCountryGeoIds);
+  if (!LoadCountriesImpl(root.get(), store))
+    return -1;
+  return version;
+}
+
 unique_ptr<Reader> GetReaderImpl(Platform & pl, string const & file, string const & scope)
 {
   try
@@ -450,54 +458,57 @@ unique_ptr<Reader> GetReaderImpl(Platform & pl, string const & file, string cons
 }
 } // namespace
 
+int64_t LoadCountriesFromBuffer(string const & jsonBuffer, CountryTree & countries,
+                                Affiliations & affiliations,
+                                CountryNameSynonyms & countryNameSynonyms,
+                                MwmTopCityGeoIds & mwmTopCityGeoIds,
+                                MwmTopCountryGeoIds & mwmTopCountryGeoIds)
+{
+  base::Json root;
+  int64_t const version = ParseCountriesJson(jsonBuffer, root);
+  return LoadCountriesFromJson(root, version, countries, affiliations, countryNameSynonyms,
+                               mwmTopCityGeoIds, mwmTopCountryGeoIds);
+}
+
 int64_t LoadCountriesFromFile(string const & path, CountryTree & countries,
                               Affiliations & affiliations,
                               CountryNameSynonyms & countryNameSynonyms,
                               MwmTopCityGeoIds & mwmTopCityGeoIds,
                               MwmTopCountryGeoIds & mwmTopCountryGeoIds)
 {
-  string json;
-  int64_t version = -1;
-
   // Choose the latest version from "resource" or "writable":
   // w > r in case of autoupdates
   // r > w in case of a new countries file with an updated app
+  // Only versions are compared, so the tree is built once from the chosen file.
 
   auto & pl = GetPlatform();
-  auto reader = GetReaderImpl(pl, path, "fr");
-  if (reader)
-  {
-    reader->ReadAsString(json);
-    version = LoadCountriesFromBuffer(json, countries, affiliations, countryNameSynonyms,
-                                      mwmTopCityGeoIds, mwmTopCountryGeoIds);
-  }
-
-  reader = GetReaderImpl(pl, path, "w");
-  if (reader)
+  base::Json root;
+  int64_t version = -1;
+  bool hasFile = false;
+  for (auto const & scope : {"fr", "w"})
   {
-    CountryTree newCountries;
-    Affiliations newAffs;
-    CountryNameSynonyms newSyms;
-    MwmTopCityGeoIds newCityIds;
-    MwmTopCountryGeoIds newCountryIds;
+    auto reader = GetReaderImpl(pl, path, scope);
+    if (!reader)
+      continue;
 
+    hasFile = true;
+    string json;
     reader->ReadAsString(json);
-    int64_t const newVersion = LoadCountriesFromBuffer(json, newCountries, newAffs, newSyms,
-                                                       newCityIds, newCountryIds);
 
-    if (newVersion > version)
+    base::Json fileRoot;
+    int64_t const fileVersion = ParseCountriesJson(json, fileRoot);
+    if (fileVersion > version)
     {
-      version = newVersion;
-
-      countries = std::move(newCountries);
-      affiliations = std::move(newAffs);
-      countryNameSynonyms = std::move(newSyms);
-      mwmTopCityGeoIds = std::move(newCityIds);
-      mwmTopCountryGeoIds = std::move(newCountryIds);
+      version = fileVersion;
+      root = fileRoot;
     }
   }
 
-  return version;
+  if (!hasFile)
+    return -1;
+
+  return LoadCountriesFromJson(root, version, countries, affiliations, countryNameSynonyms,
+                               mwmTopCityGeoIds, mwmTopCountryGeoIds);
 }
 
 void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryInfo> & id2info)
@@ -511,7 +522,7 @@ void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryI
     FromJSONObjectOptionalField(root.get(), "v", version);
 
     StoreFile2Info store(id2info);
-    LoadCountriesImpl(jsonBuffer, store);
+    LoadCountriesImpl(root.get(), store);
   }
   catch (base::Json::Exception const & e)
   {
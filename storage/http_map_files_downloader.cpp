@@ -64,10 +64,13 @@ void HttpMapFilesDownloader::Download()
   {
     queuedCountry.OnStartDownloading();
 
+    // Storage checks SHA1 of the maps, so it's calculated while downloading.
+    bool const calcSha1 = queuedCountry.GetFileType() == MapFileType::Map;
     m_request.reset(downloader::HttpRequest::GetFile(
         urls, path, size,
         std::bind(&HttpMapFilesDownloader::OnMapFileDownloaded, this, queuedCountry, _1),
-        std::bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, queuedCountry, _1)));
+        std::bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, queuedCountry, _1),
+        downloader::kDefaultChunkSize, true /* doCleanOnCancel */, calcSha1));
   }
   else
   {
@@ -126,7 +129,9 @@ void HttpMapFilesDownloader::OnMapFileDownloaded(QueuedCountry const & queuedCou
 
   m_queue.PopFront();
 
-  queuedCountry.OnDownloadFinished(request.GetStatus());
+  QueuedCountry country = queuedCountry;
+  country.SetDownloadedSha1(request.GetSha1());
+  country.OnDownloadFinished(request.GetStatus());
 
   m_request.reset();
 
@@ -77,6 +77,16 @@ uint64_t QueuedCountry::GetDownloadSize() const
   return GetRemoteSize(*m_diffsDataSource, m_countryFile);
 }
 
+void QueuedCountry::SetDownloadedSha1(std::string const & sha1)
+{
+  m_downloadedSha1 = sha1;
+}
+
+std::string const & QueuedCountry::GetDownloadedSha1() const
+{
+  return m_downloadedSha1;
+}
+
 void QueuedCountry::OnCountryInQueue() const
 {
   if (m_subscriber != nullptr)
@@ -42,6 +42,10 @@ public:
   std::string GetFileDownloadPath() const;
   uint64_t GetDownloadSize() const;
 
+  // Base64 SHA1 of the downloaded file when the downloader calculated it, empty otherwise.
+  void SetDownloadedSha1(std::string const & sha1);
+  std::string const & GetDownloadedSha1() const;
+
   void OnCountryInQueue() const;
   void OnStartDownloading() const;
   void OnDownloadProgress(downloader::Progress const & progress) const;
@@ -56,6 +60,7 @@ private:
   int64_t m_currentDataVersion;
   std::string m_dataDir;
   diffs::DiffsSourcePtr m_diffsDataSource;
+  std::string m_downloadedSha1;
 
   Subscriber * m_subscriber = nullptr;
 };
@@ -24,6 +24,7 @@
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/trace.hpp"
 
 #include "defines.hpp"
 
@@ -283,6 +284,8 @@ Storage::WorldStatus Storage::GetForceDownloadWorlds(std::vector<platform::Count
 
 void Storage::RegisterAllLocalMaps(bool enableDiffs /* = false */)
 {
+  TRACE_SCOPE(Storage, "Storage::RegisterAllLocalMaps");
+
   //CHECK_THREAD_CHECKER(m_threadChecker, ());
   //ASSERT(!IsDownloadInProgress(), ());
 
@@ -717,7 +720,20 @@ void Storage::OnDownloadFinished(QueuedCountry const & queuedCountry, DownloadSt
     OnFinishDownloading();
   };
 
-  if (status == DownloadStatus::Completed && m_integrityValidationEnabled)
+  if (status == DownloadStatus::Completed && m_integrityValidationEnabled &&
+      !queuedCountry.GetDownloadedSha1().empty())
+  {
+    // The downloader calculated the hash while the file was written.
+    if (queuedCountry.GetDownloadedSha1() != GetCountryFile(countryId).GetSha1())
+    {
+      auto const path = GetFileDownloadPath(countryId, fileType);
+      LOG(LERROR, ("SHA check error for", path));
+      base::DeleteFileX(path);
+      status = DownloadStatus::FailedSHA;
+    }
+    finishFn(status);
+  }
+  else if (status == DownloadStatus::Completed && m_integrityValidationEnabled)
   {
     /// @todo Can/Should be combined with ApplyDiff routine when we will restore it.
     /// While this is simple and working solution, I think that Downloader component
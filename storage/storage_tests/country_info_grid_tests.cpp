@@ -0,0 +1,114 @@
+#include "testing/testing.hpp"
+
+#include "storage/country_info_grid.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace country_info_grid_tests
+{
+using namespace storage;
+using namespace std;
+
+using Regions = vector<m2::RegionD>;
+
+m2::RegionD MakeRegion(vector<m2::PointD> const & points)
+{
+  return m2::RegionD(points.begin(), points.end());
+}
+
+// A square, a triangle inside of the square and a triangle which crosses the square.
+vector<Regions> MakeCountries()
+{
+  return {{MakeRegion({{0.0, 40.0}, {15.0, 40.0}, {5.0, 55.0}})},
+          {MakeRegion({{0.0, 0.0}, {50.0, 0.0}, {50.0, 50.0}, {0.0, 50.0}})},
+          {MakeRegion({{-30.0, -30.0}, {10.0, -20.0}, {-10.0, 30.0}}),
+           MakeRegion({{100.0, 100.0}, {110.0, 100.0}, {110.0, 110.0}})}};
+}
+
+uint32_t FindBruteForce(vector<Regions> const & countries, m2::PointD const & pt)
+{
+  for (uint32_t id = 0; id < countries.size(); ++id)
+  {
+    for (auto const & region : countries[id])
+    {
+      if (region.Contains(pt))
+        return id;
+    }
+  }
+  return CountryInfoGrid::kNoCountry;
+}
+
+uint32_t Classify(vector<Regions> const & countries, m2::RectD const & cell)
+{
+  for (uint32_t id = 0; id < countries.size(); ++id)
+  {
+    switch (CountryInfoGrid::GetCellPosition(countries[id], cell))
+    {
+    case CountryInfoGrid::CellPosition::Outside: continue;
+    case CountryInfoGrid::CellPosition::Inside: return id;
+    case CountryInfoGrid::CellPosition::Border: return CountryInfoGrid::kBorder;
+    }
+  }
+  return CountryInfoGrid::kNoCountry;
+}
+
+UNIT_TEST(CountryInfoGrid_CellPosition)
+{
+  Regions const square = {MakeRegion({{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}})};
+
+  TEST_EQUAL(CountryInfoGrid::GetCellPosition(square, {1.0, 1.0, 2.0, 2.0}),
+             CountryInfoGrid::CellPosition::Inside, ());
+  TEST_EQUAL(CountryInfoGrid::GetCellPosition(square, {11.0, 1.0, 12.0, 2.0}),
+             CountryInfoGrid::CellPosition::Outside, ());
+  TEST_EQUAL(CountryInfoGrid::GetCellPosition(square, {9.0, 1.0, 11.0, 2.0}),
+             CountryInfoGrid::CellPosition::Border, ());
+  // The square is inside of the cell.
+  TEST_EQUAL(CountryInfoGrid::GetCellPosition(square, {-1.0, -1.0, 11.0, 11.0}),
+             CountryInfoGrid::CellPosition::Border, ());
+  TEST_EQUAL(CountryInfoGrid::GetCellPosition({}, {1.0, 1.0, 2.0, 2.0}),
+             CountryInfoGrid::CellPosition::Outside, ());
+}
+
+UNIT_TEST(CountryInfoGrid_Find)
+{
+  auto const countries = MakeCountries();
+  uint32_t classified = 0;
+  CountryInfoGrid const grid([&](m2::RectD const & cell) {
+    ++classified;
+    return Classify(countries, cell);
+  });
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-40.0, 120.0);
+  uint32_t exact = 0;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    m2::PointD const pt(coord(rng), coord(rng));
+    auto const id = grid.Find(pt);
+    if (id == CountryInfoGrid::kBorder)
+    {
+      ++exact;
+      continue;
+    }
+    TEST_EQUAL(id, FindBruteForce(countries, pt), (pt));
+  }
+
+  // Only points close to the borders need the exact check.
+  TEST_LESS(exact, 10000, ());
+
+  // Cells are classified once.
+  auto const classifiedBefore = classified;
+  rng.seed(0);
+  for (size_t i = 0; i < 1000; ++i)
+    grid.Find(m2::PointD(coord(rng), coord(rng)));
+  TEST_EQUAL(classified, classifiedBefore, ());
+
+  TEST_EQUAL(grid.Find(m2::PointD(1000.0, 0.0)), CountryInfoGrid::kBorder, ());
+}
+}  // namespace country_info_grid_tests
@@ -76,13 +76,13 @@ bool LoadTileProfiles(std::string const & fileName, std::set<std::string> & prof
 class SrtmProvider : public ValuesProvider<Altitude>
 {
 public:
-  explicit SrtmProvider(std::string const & srtmDir):
-    m_srtmManager(srtmDir)
+  explicit SrtmProvider(generator::SrtmTileManager & srtmManager):
+    m_srtmManager(srtmManager)
   {}
 
   void SetPrefferedTile(ms::LatLon const & pos)
   {
-    m_preferredTile = &m_srtmManager.GetTile(pos);
+    m_preferredTile = m_srtmManager.GetTilePtr(pos);
     m_leftBottomOfPreferredTile = {std::floor(pos.m_lat), std::floor(pos.m_lon)};
   }
 
@@ -164,8 +164,10 @@ private:
     return kernel[kernel.size() / 2];
   }
 
-  generator::SrtmTileManager m_srtmManager;
-  generator::SrtmTile const * m_preferredTile = nullptr;
+  // The manager is shared between tasks, the preferred tile is owned to keep it alive when
+  // it's evicted from the manager by other tasks.
+  generator::SrtmTileManager & m_srtmManager;
+  std::shared_ptr<generator::SrtmTile const> m_preferredTile;
   ms::LatLon m_leftBottomOfPreferredTile;
 };
 
@@ -239,9 +241,10 @@ class TileIsolinesTask
 {
 public:
   TileIsolinesTask(int left, int bottom, int right, int top, std::string const & srtmDir,
-                   TileIsolinesParams const * params, bool forceRegenerate)
+                   generator::SrtmTileManager & srtmManager, TileIsolinesParams const * params,
+                   bool forceRegenerate)
     : m_strmDir(srtmDir)
-    , m_srtmProvider(srtmDir)
+    , m_srtmProvider(srtmManager)
     , m_params(params)
     , m_forceRegenerate(forceRegenerate)
   {
@@ -250,9 +253,10 @@ public:
   }
 
   TileIsolinesTask(int left, int bottom, int right, int top, std::string const & srtmDir,
+                   generator::SrtmTileManager & srtmManager,
                    TileIsolinesProfileParams const * profileParams, bool forceRegenerate)
     : m_strmDir(srtmDir)
-    , m_srtmProvider(srtmDir)
+    , m_srtmProvider(srtmManager)
     , m_profileParams(profileParams)
     , m_forceRegenerate(forceRegenerate)
   {
@@ -427,40 +431,23 @@ void RunGenerateIsolinesTasks(int left, int bottom, int right, int top,
                               long threadsCount, long maxCachedTilesPerThread,
                               bool forceRegenerate)
 {
-  std::vector<std::unique_ptr<TileIsolinesTask>> tasks;
-
   CHECK_GREATER(right, left, ());
   CHECK_GREATER(top, bottom, ());
 
-  int tilesRowPerTask = top - bottom;
-  int tilesColPerTask = right - left;
-
-  if (tilesRowPerTask * tilesColPerTask <= threadsCount)
-  {
-    tilesRowPerTask = 1;
-    tilesColPerTask = 1;
-  }
-  else
-  {
-    while (tilesRowPerTask * tilesColPerTask > maxCachedTilesPerThread)
-    {
-      if (tilesRowPerTask > tilesColPerTask)
-        tilesRowPerTask = (tilesRowPerTask + 1) / 2;
-      else
-        tilesColPerTask = (tilesColPerTask + 1) / 2;
-    }
-  }
+  // Tiles are loaded once for all threads and neighboring tiles are processed at close times,
+  // so the tiles which are read by several tasks are mostly taken from the cache.
+  generator::SrtmTileManager srtmManager(
+      srtmPath, static_cast<size_t>(threadsCount * maxCachedTilesPerThread));
 
+  // A task per tile balances the load: the time of a tile processing varies greatly, and there
+  // are no tiles at all in the ocean.
   base::thread_pool::computational::ThreadPool threadPool(threadsCount);
-
-  for (int lat = bottom; lat < top; lat += tilesRowPerTask)
+  for (int lat = bottom; lat < top; ++lat)
   {
-    int const topLat = std::min(lat + tilesRowPerTask - 1, top - 1);
-    for (int lon = left; lon < right; lon += tilesColPerTask)
+    for (int lon = left; lon < right; ++lon)
     {
-      int const rightLon = std::min(lon + tilesColPerTask - 1, right - 1);
-      auto task = std::make_unique<TileIsolinesTask>(lon, lat, rightLon, topLat, srtmPath, &params,
-                                                     forceRegenerate);
+      auto task = std::make_unique<TileIsolinesTask>(lon, lat, lon, lat, srtmPath, srtmManager,
+                                                     &params, forceRegenerate);
       threadPool.SubmitWork([task = std::move(task)](){ task->Do(); });
     }
   }
@@ -3,9 +3,14 @@
 #include "topography_generator/marching_squares/contours_builder.hpp"
 #include "topography_generator/marching_squares/square.hpp"
 #include "topography_generator/utils/contours.hpp"
+#include "topography_generator/utils/values_provider.hpp"
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace topography_generator
 {
 template <typename ValueType>
@@ -45,9 +50,14 @@ public:
     }
 
     ContoursBuilder contoursBuilder(levelsCount, m_debugId);
+    ValueType const invalidValue = m_valuesProvider.GetInvalidValue();
+    size_t const rowSize = m_stepsCountLon + 1;
 
     for (size_t i = 0; i < m_stepsCountLat; ++i)
     {
+      ValueType const * bottomRow = &m_values[i * rowSize];
+      ValueType const * topRow = &m_values[(i + 1) * rowSize];
+
       contoursBuilder.BeginLine();
       for (size_t j = 0; j < m_stepsCountLon; ++j)
       {
@@ -57,8 +67,9 @@ public:
         auto const rightTop = ms::LatLon(std::min(leftBottom.m_lat + m_step, m_rightTop.m_lat),
                                          std::min(leftBottom.m_lon + m_step, m_rightTop.m_lon));
 
-        Square<ValueType> square(leftBottom, rightTop, result.m_minValue, m_valueStep,
-                                 m_valuesProvider, m_debugId);
+        Square<ValueType> square(leftBottom, rightTop, bottomRow[j], topRow[j], topRow[j + 1],
+                                 bottomRow[j + 1], result.m_minValue, m_valueStep, invalidValue,
+                                 m_debugId);
         square.GenerateSegments(contoursBuilder);
       }
       auto const isLastLine = i == m_stepsCountLat - 1;
@@ -69,27 +80,36 @@ public:
   }
 
 private:
-  void ScanValuesInRect(ValueType & minValue, ValueType & maxValue, size_t & invalidValuesCount) const
+  // Reads the values of the grid nodes row by row, each value is read once and then it's
+  // shared by the squares around the node.
+  void ScanValuesInRect(ValueType & minValue, ValueType & maxValue, size_t & invalidValuesCount)
   {
+    size_t const rowSize = m_stepsCountLon + 1;
+    m_values.resize(rowSize * (m_stepsCountLat + 1));
+
+    ValueType const invalidValue = m_valuesProvider.GetInvalidValue();
     minValue = maxValue = m_valuesProvider.GetValue(m_leftBottom);
     invalidValuesCount = 0;
 
     for (size_t i = 0; i <= m_stepsCountLat; ++i)
     {
+      ValueType * row = &m_values[i * rowSize];
       for (size_t j = 0; j <= m_stepsCountLon; ++j)
       {
         auto const pos = ms::LatLon(m_leftBottom.m_lat + m_step * i,
                                     m_leftBottom.m_lon + m_step * j);
-        auto const value = m_valuesProvider.GetValue(pos);
-        if (value == m_valuesProvider.GetInvalidValue())
+        row[j] = m_valuesProvider.GetValue(pos);
+      }
+
+      for (size_t j = 0; j <= m_stepsCountLon; ++j)
+      {
+        if (row[j] == invalidValue)
         {
           ++invalidValuesCount;
           continue;
         }
-        if (value < minValue)
-          minValue = value;
-        if (value > maxValue)
-          maxValue = value;
+        minValue = std::min(minValue, row[j]);
+        maxValue = std::max(maxValue, row[j]);
       }
     }
 
@@ -110,6 +130,9 @@ private:
   size_t m_stepsCountLon;
   size_t m_stepsCountLat;
 
+  // Values of the grid nodes by rows from the bottom, a row is m_stepsCountLon + 1 values.
+  std::vector<ValueType> m_values;
+
   std::string m_debugId;
 };
 }  // namespace topography_generator
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "topography_generator/marching_squares/contours_builder.hpp"
-#include "topography_generator/utils/values_provider.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include <string>
 
 namespace topography_generator
 {
@@ -9,10 +12,11 @@ template <typename ValueType>
 class Square
 {
 public:
+  // Values are taken in the corners: left-bottom, left-top, right-top and right-bottom.
   Square(ms::LatLon const & leftBottom,
          ms::LatLon const & rightTop,
-         ValueType minValue, ValueType valueStep,
-         ValuesProvider<ValueType> & valuesProvider,
+         ValueType valueLB, ValueType valueLT, ValueType valueRT, ValueType valueRB,
+         ValueType minValue, ValueType valueStep, ValueType invalidValue,
          std::string const & debugId)
     : m_minValue(minValue)
     , m_valueStep(valueStep)
@@ -24,10 +28,10 @@ public:
   {
     static_assert(std::is_integral<ValueType>::value, "Only integral types are supported.");
 
-    m_valueLB = GetValue(leftBottom, valuesProvider);
-    m_valueLT = GetValue(ms::LatLon(m_top, m_left), valuesProvider);
-    m_valueRT = GetValue(ms::LatLon(m_top, m_right), valuesProvider);
-    m_valueRB = GetValue(ms::LatLon(m_bottom, m_right), valuesProvider);
+    m_valueLB = PrepareValue(valueLB, invalidValue, leftBottom);
+    m_valueLT = PrepareValue(valueLT, invalidValue, ms::LatLon(m_top, m_left));
+    m_valueRT = PrepareValue(valueRT, invalidValue, ms::LatLon(m_top, m_right));
+    m_valueRB = PrepareValue(valueRB, invalidValue, ms::LatLon(m_bottom, m_right));
   }
 
   void GenerateSegments(ContoursBuilder & builder)
@@ -70,12 +74,11 @@ private:
     Unclear,
   };
 
-  ValueType GetValue(ms::LatLon const & pos, ValuesProvider<ValueType> & valuesProvider)
+  ValueType PrepareValue(ValueType val, ValueType invalidValue, ms::LatLon const & pos)
   {
     // If a contour goes right through the corner of the square false segments can be generated.
     // Shift the value slightly from the corner.
-    ValueType val = valuesProvider.GetValue(pos);
-    if (val == valuesProvider.GetInvalidValue())
+    if (val == invalidValue)
     {
       LOG(LWARNING, ("Invalid value at the position", pos, m_debugId));
       m_isValid = false;
@@ -226,6 +229,6 @@ private:
   ValueType m_valueRB;
 
   bool m_isValid = true;
-  std::string m_debugId;
+  std::string const & m_debugId;
 };
 }  // topography_generator
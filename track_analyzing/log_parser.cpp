@@ -33,8 +33,8 @@ vector<DataPoint> ReadDataPoints(string const & data)
 
   try
   {
-    coding::TrafficGPSEncoder::DeserializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion, src,
-                                                     points);
+    // Points are logged in version 1 of the encoder.
+    coding::TrafficGPSEncoder::DeserializeDataPoints(1 /* version */, src, points);
   }
   catch (Reader::SizeException const & e)
   {
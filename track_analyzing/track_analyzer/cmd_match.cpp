@@ -23,10 +23,14 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -35,10 +39,57 @@ using namespace track_analyzing;
 
 namespace
 {
-using Iter = typename vector<string>::iterator;
+// Time of the stages of log files matching and amounts of the handled data. Summed over the
+// threads, so throughputs are per thread.
+struct StagesStats
+{
+  void Add(StagesStats const & rhs)
+  {
+    m_filesCount += rhs.m_filesCount;
+    m_compressedBytes += rhs.m_compressedBytes;
+    m_logBytes += rhs.m_logBytes;
+    m_tracksCount += rhs.m_tracksCount;
+    m_pointsCount += rhs.m_pointsCount;
+    m_unzipSeconds += rhs.m_unzipSeconds;
+    m_parseSeconds += rhs.m_parseSeconds;
+    m_matchSeconds += rhs.m_matchSeconds;
+    m_saveSeconds += rhs.m_saveSeconds;
+  }
+
+  void Log() const
+  {
+    auto const perSecond = [](double amount, double seconds) {
+      return seconds > 0.0 ? amount / seconds : 0.0;
+    };
+    double constexpr kMb = 1024.0 * 1024.0;
+
+    LOG(LINFO, ("Files:", m_filesCount, ", compressed MB:", m_compressedBytes / kMb,
+                ", log MB:", m_logBytes / kMb, ", tracks:", m_tracksCount,
+                ", points:", m_pointsCount));
+    LOG(LINFO, ("Unzip:", m_unzipSeconds, "seconds,",
+                perSecond(m_compressedBytes / kMb, m_unzipSeconds), "MB/s"));
+    LOG(LINFO, ("Parse:", m_parseSeconds, "seconds,",
+                perSecond(m_logBytes / kMb, m_parseSeconds), "MB/s"));
+    LOG(LINFO, ("Match:", m_matchSeconds, "seconds,",
+                perSecond(static_cast<double>(m_pointsCount), m_matchSeconds), "points/s"));
+    LOG(LINFO, ("Save:", m_saveSeconds, "seconds,",
+                perSecond(static_cast<double>(m_tracksCount), m_saveSeconds), "tracks/s"));
+  }
+
+  uint64_t m_filesCount = 0;
+  uint64_t m_compressedBytes = 0;
+  uint64_t m_logBytes = 0;
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  double m_unzipSeconds = 0.0;
+  double m_parseSeconds = 0.0;
+  double m_matchSeconds = 0.0;
+  double m_saveSeconds = 0.0;
+};
 
 void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks,
+                 StagesStats & stagesStats)
 {
   base::Timer timer;
 
@@ -85,51 +136,52 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
+  stagesStats.m_tracksCount += tracksCount;
+  stagesStats.m_pointsCount += pointsCount;
+
   LOG(LINFO,
       ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
        ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
 }
-}  // namespace
 
-namespace track_analyzing
-{
-void CmdMatch(string const & logFile, string const & trackFile,
-              shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, Stats & stats)
+void MatchLogFile(string const & logFile, string const & trackFile,
+                  shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, Stats & stats,
+                  StagesStats & stagesStats)
 {
+  base::Timer timer;
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, mwmToTracks);
   stats.AddTracksStats(mwmToTracks, *numMwmIds, storage);
+  stagesStats.m_parseSeconds += timer.ElapsedSeconds();
 
+  uint64_t logSize = 0;
+  if (Platform::GetFileSizeByFullPath(logFile, logSize))
+    stagesStats.m_logBytes += logSize;
+
+  timer.Reset();
   MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks, stagesStats);
+  stagesStats.m_matchSeconds += timer.ElapsedSeconds();
+
+  // Source tracks aren't needed any more, they are freed before the serialization.
+  mwmToTracks.clear();
 
+  timer.Reset();
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
   serializer.Serialize(mwmToMatchedTracks, writer);
+  stagesStats.m_saveSeconds += timer.ElapsedSeconds();
+  ++stagesStats.m_filesCount;
   LOG(LINFO, ("Matched tracks were saved to", trackFile));
 }
 
-void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution)
-{
-  LOG(LINFO, ("Matching", logFile));
-  Storage storage;
-  storage.RegisterAllLocalMaps();
-  shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-
-  Stats stats;
-  CmdMatch(logFile, trackFile, numMwmIds, storage, stats);
-  stats.SaveMwmDistributionToCsv(inputDistribution);
-  stats.Log();
-}
-
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
+// Unzips gzipped |file| near it, matches it and removes the unzipped log.
+void UnzipAndMatch(string file, string const & trackExt, shared_ptr<NumMwmIds> const & numMwmIds,
+                   Storage const & storage, Stats & stats, StagesStats & stagesStats)
 {
-  Storage storage;
-  storage.RegisterAllLocalMaps();
-  shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-  for (auto it = begin; it != end; ++it)
+  base::Timer timer;
   {
-    auto & file = *it;
+    // The compressed and the unzipped data are freed before matching.
     string data;
     try
     {
@@ -139,13 +191,14 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
     catch (FileReader::ReadException const & e)
     {
       LOG(LWARNING, (e.what()));
-      continue;
+      return;
     }
 
     using Inflate = coding::ZLib::Inflate;
     Inflate inflate(Inflate::Format::GZip);
     string track;
     inflate(data.data(), data.size(), back_inserter(track));
+    stagesStats.m_compressedBytes += data.size();
     base::GetNameWithoutExt(file);
     try
     {
@@ -155,12 +208,31 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
     catch (std::exception const & e)
     {
       LOG(LWARNING, (e.what()));
-      continue;
+      return;
     }
-
-    CmdMatch(file, file + trackExt, numMwmIds, storage, stats);
-    FileWriter::DeleteFileX(file);
   }
+  stagesStats.m_unzipSeconds += timer.ElapsedSeconds();
+
+  MatchLogFile(file, file + trackExt, numMwmIds, storage, stats, stagesStats);
+  FileWriter::DeleteFileX(file);
+}
+}  // namespace
+
+namespace track_analyzing
+{
+void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution)
+{
+  LOG(LINFO, ("Matching", logFile));
+  Storage storage;
+  storage.RegisterAllLocalMaps();
+  shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
+
+  Stats stats;
+  StagesStats stagesStats;
+  MatchLogFile(logFile, trackFile, numMwmIds, storage, stats, stagesStats);
+  stats.SaveMwmDistributionToCsv(inputDistribution);
+  stats.Log();
+  stagesStats.Log();
 }
 
 void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution)
@@ -196,31 +268,57 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
     return;
   }
 
-  auto const size = filesList.size();
+  // The biggest files are taken first, so threads don't wait for a big file at the end.
+  vector<pair<uint64_t, string>> files;
+  files.reserve(filesList.size());
+  for (auto & file : filesList)
+  {
+    uint64_t size = 0;
+    Platform::GetFileSizeByFullPath(file, size);
+    files.emplace_back(size, move(file));
+  }
+  sort(files.begin(), files.end(), greater<>());
+
   auto const hardwareConcurrency = static_cast<size_t>(thread::hardware_concurrency());
   CHECK_GREATER(hardwareConcurrency, 0, ("No available threads."));
   LOG(LINFO, ("Number of available threads =", hardwareConcurrency));
-  auto const threadsCount = min(size, hardwareConcurrency);
-  auto const blockSize = size / threadsCount;
-  vector<thread> threads(threadsCount - 1);
+  auto const threadsCount = min(files.size(), hardwareConcurrency);
+
+  // Files are taken by the threads one by one, only a file per thread is in memory.
+  atomic<size_t> nextFile(0);
   vector<Stats> stats(threadsCount);
-  auto begin = filesList.begin();
-  for (size_t i = 0; i < threadsCount - 1; ++i)
-  {
-    auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, ref(stats[i]));
-    begin = end;
-  }
+  vector<StagesStats> stagesStats(threadsCount);
+  auto const worker = [&](size_t threadNum) {
+    Storage storage;
+    storage.RegisterAllLocalMaps();
+    shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
+    for (size_t i = nextFile++; i < files.size(); i = nextFile++)
+    {
+      UnzipAndMatch(files[i].second, trackExt, numMwmIds, storage, stats[threadNum],
+                    stagesStats[threadNum]);
+    }
+  };
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, ref(stats[threadsCount - 1]));
+  base::Timer timer;
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker, i);
+
+  worker(0 /* threadNum */);
   for (auto & t : threads)
     t.join();
 
   Stats statSum;
-  for (auto const & s : stats)
-    statSum.Add(s);
+  StagesStats stagesStatSum;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    statSum.Add(stats[i]);
+    stagesStatSum.Add(stagesStats[i]);
+  }
 
   statSum.SaveMwmDistributionToCsv(inputDistribution);
   statSum.Log();
+  stagesStatSum.Log();
+  LOG(LINFO, ("Matching of", files.size(), "files took", timer.ElapsedSeconds(), "seconds."));
 }
 }  // namespace track_analyzing
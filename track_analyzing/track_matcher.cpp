@@ -1,17 +1,21 @@
 #include "track_analyzing/track_matcher.hpp"
 
-#include "track_analyzing/exceptions.hpp"
-
 #include "routing/index_graph_loader.hpp"
 
 #include "routing_common/car_model.hpp"
 
 #include "indexer/scales.hpp"
 
+#include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
 
-#include "base/stl_helpers.hpp"
+#include "base/beam.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
 
 namespace track_analyzing
 {
@@ -23,33 +27,29 @@ namespace
 {
 // Matching range in meters.
 double constexpr kMatchingRange = 20.0;
-
-// Mercator distance from segment to point in meters.
-double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
-                         m2::PointD const & point)
-{
-  m2::ParametrizedSegment<m2::PointD> const segment(segmentBegin, segmentEnd);
-  m2::PointD const projectionPoint = segment.ClosestPointTo(point);
-  return mercator::DistanceOnEarth(point, projectionPoint);
-}
-
-double DistanceToSegment(Segment const & segment, m2::PointD const & point, IndexGraph & indexGraph)
+// Maximum number of candidates of a point, the nearest segments are kept.
+size_t constexpr kMaxCandidates = 8;
+// Standard deviation of gps errors in meters.
+double constexpr kGpsSigmaM = 10.0;
+// Scale of the difference between route and straight distances in meters.
+double constexpr kTransitionBetaM = 5.0;
+// Route between candidates of neighbouring points is searched within
+// kMaxRouteFactor * straight distance + kMaxRouteMarginM.
+double constexpr kMaxRouteFactor = 2.0;
+double constexpr kMaxRouteMarginM = 2.0 * kMatchingRange;
+double constexpr kInfinity = numeric_limits<double>::max();
+size_t constexpr kNoParent = numeric_limits<size_t>::max();
+
+double GetSegmentLength(Segment const & segment, IndexGraph const & graph)
 {
-  auto const & road = indexGraph.GetRoadGeometry(segment.GetFeatureId());
-  return DistanceToSegment(
-      mercator::FromLatLon(road.GetPoint(segment.GetPointId(false))),
-      mercator::FromLatLon(road.GetPoint(segment.GetPointId(true))), point);
+  return ms::DistanceOnEarth(graph.GetPoint(segment, false /* front */),
+                             graph.GetPoint(segment, true /* front */));
 }
 
-bool EdgesContain(IndexGraph::SegmentEdgeListT const & edges, Segment const & segment)
+double GetEmissionCost(double distance)
 {
-  for (auto const & edge : edges)
-  {
-    if (edge.GetTarget() == segment)
-      return true;
-  }
-
-  return false;
+  double const normalized = distance / kGpsSigmaM;
+  return 0.5 * normalized * normalized;
 }
 }  // namespace
 
@@ -78,19 +78,21 @@ TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
 void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTrack> & matchedTracks)
 {
   m_pointsCount += track.size();
+  m_reachableCache.clear();
 
   vector<Step> steps;
   steps.reserve(track.size());
   for (auto const & routePoint : track)
+  {
     steps.emplace_back(routePoint);
+    FillCandidates(steps.back());
+  }
 
   for (size_t trackBegin = 0; trackBegin < steps.size();)
   {
     for (; trackBegin < steps.size(); ++trackBegin)
     {
-      steps[trackBegin].FillCandidatesWithNearbySegments(m_dataSource, *m_graph, *m_vehicleModel,
-                                                         m_mwmId);
-      if (steps[trackBegin].HasCandidates())
+      if (!steps[trackBegin].m_candidates.empty())
         break;
 
       ++m_nonMatchedPointsCount;
@@ -99,46 +101,35 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
     if (trackBegin >= steps.size())
       break;
 
-    size_t trackEnd = trackBegin;
-    for (; trackEnd < steps.size() - 1; ++trackEnd)
+    Step & firstStep = steps[trackBegin];
+    for (size_t i = 0; i < firstStep.m_candidates.size(); ++i)
     {
-      Step & nextStep = steps[trackEnd + 1];
-      Step const & prevStep = steps[trackEnd];
-      nextStep.FillCandidates(prevStep, *m_graph);
-      if (!nextStep.HasCandidates())
-        break;
+      firstStep.m_costs[i] = GetEmissionCost(firstStep.m_candidates[i].m_distance);
+      firstStep.m_parents[i] = kNoParent;
     }
 
-    steps[trackEnd].ChooseNearestSegment();
-
-    for (size_t i = trackEnd; i > trackBegin; --i)
-      steps[i - 1].ChooseSegment(steps[i], *m_graph);
-
-    ++m_tracksCount;
-
-    matchedTracks.push_back({});
-    MatchedTrack & matchedTrack = matchedTracks.back();
-    for (size_t i = trackBegin; i <= trackEnd; ++i)
+    size_t trackEnd = trackBegin;
+    for (; trackEnd + 1 < steps.size(); ++trackEnd)
     {
-      Step const & step = steps[i];
-      matchedTrack.emplace_back(step.GetDataPoint(), step.GetSegment());
+      Step & nextStep = steps[trackEnd + 1];
+      if (nextStep.m_candidates.empty() || !FillCosts(steps[trackEnd], nextStep))
+        break;
     }
 
+    AddMatchedTrack(steps, trackBegin, trackEnd, matchedTracks);
     trackBegin = trackEnd + 1;
   }
 }
 
-// TrackMatcher::Step ------------------------------------------------------------------------------
-TrackMatcher::Step::Step(DataPoint const & dataPoint)
-  : m_dataPoint(dataPoint), m_point(mercator::FromLatLon(dataPoint.m_latLon))
+void TrackMatcher::FillCandidates(Step & step) const
 {
-}
+  base::Beam<Candidate, double> nearest(kMaxCandidates);
+  auto const addCandidate = [&](Candidate const & candidate) {
+    if (m_graph->GetAccessType(candidate.m_segment) == RoadAccess::Type::Yes)
+      nearest.Add(candidate, -candidate.m_distance);
+  };
 
-void TrackMatcher::Step::FillCandidatesWithNearbySegments(
-    DataSource const & dataSource, IndexGraph const & graph,
-    VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
-{
-  dataSource.ForEachInRect([&](FeatureType & ft)
+  m_dataSource.ForEachInRect([&](FeatureType & ft)
   {
     if (!ft.GetID().IsValid())
       return;
@@ -147,107 +138,193 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
       return;
 
     feature::TypesHolder const types(ft);
-    if (!vehicleModel.IsRoad(types))
+    if (!m_vehicleModel->IsRoad(types))
       return;
 
     ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
     for (size_t segIdx = 0; segIdx + 1 < ft.GetPointsCount(); ++segIdx)
     {
-      double const distance =
-          DistanceToSegment(ft.GetPoint(segIdx), ft.GetPoint(segIdx + 1), m_point);
-      if (distance < kMatchingRange)
+      m2::PointD const & begin = ft.GetPoint(segIdx);
+      m2::PointD const & end = ft.GetPoint(segIdx + 1);
+      m2::PointD const projection =
+          m2::ParametrizedSegment<m2::PointD>(begin, end).ClosestPointTo(step.m_point);
+
+      Candidate candidate;
+      candidate.m_distance = mercator::DistanceOnEarth(step.m_point, projection);
+      if (candidate.m_distance >= kMatchingRange)
+        continue;
+
+      candidate.m_length = mercator::DistanceOnEarth(begin, end);
+      candidate.m_offset = mercator::DistanceOnEarth(begin, projection);
+      candidate.m_segment = Segment(m_mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
+                                    true /* forward */);
+      addCandidate(candidate);
+
+      if (!m_vehicleModel->IsOneWay(types))
       {
-        AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
-                             true /* forward */),
-                     distance, graph);
-
-        if (!vehicleModel.IsOneWay(types))
-        {
-          AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
-                               false /* forward */),
-                       distance, graph);
-        }
+        candidate.m_offset = candidate.m_length - candidate.m_offset;
+        candidate.m_segment = Segment(m_mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
+                                      false /* forward */);
+        addCandidate(candidate);
       }
     }
   },
-  mercator::RectByCenterXYAndSizeInMeters(m_point, kMatchingRange),
+  mercator::RectByCenterXYAndSizeInMeters(step.m_point, kMatchingRange),
   scales::GetUpperScale());
+
+  for (auto const & entry : nearest.GetEntries())
+    step.m_candidates.push_back(entry.m_key);
+
+  step.m_costs.assign(step.m_candidates.size(), kInfinity);
+  step.m_parents.assign(step.m_candidates.size(), kNoParent);
 }
 
-void TrackMatcher::Step::FillCandidates(Step const & previousStep, IndexGraph & graph)
+bool TrackMatcher::FillCosts(Step const & prevStep, Step & step)
 {
-  IndexGraph::SegmentEdgeListT edges;
+  double const straightDistance = mercator::DistanceOnEarth(prevStep.m_point, step.m_point);
+  double const maxRoute = kMaxRouteFactor * straightDistance + kMaxRouteMarginM;
 
-  for (Candidate const & candidate : previousStep.m_candidates)
+  bool reachable = false;
+  for (size_t i = 0; i < step.m_candidates.size(); ++i)
   {
-    Segment const & segment = candidate.GetSegment();
-    m_candidates.emplace_back(segment, DistanceToSegment(segment, m_point, graph));
+    Candidate const & candidate = step.m_candidates[i];
+    double bestCost = kInfinity;
+    for (size_t j = 0; j < prevStep.m_candidates.size(); ++j)
+    {
+      if (prevStep.m_costs[j] == kInfinity)
+        continue;
 
-    edges.clear();
-    graph.GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, edges);
+      double const route = GetRouteLength(prevStep.m_candidates[j], candidate, maxRoute);
+      if (route < 0.0)
+        continue;
 
-    for (SegmentEdge const & edge : edges)
+      double const cost =
+          prevStep.m_costs[j] + fabs(route - straightDistance) / kTransitionBetaM;
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        step.m_parents[i] = j;
+      }
+    }
+
+    if (bestCost == kInfinity)
     {
-      Segment const & target = edge.GetTarget();
-      if (!segment.IsInverse(target))
-        m_candidates.emplace_back(target, DistanceToSegment(target, m_point, graph));
+      step.m_costs[i] = kInfinity;
+      step.m_parents[i] = kNoParent;
+      continue;
     }
+
+    step.m_costs[i] = bestCost + GetEmissionCost(candidate.m_distance);
+    reachable = true;
   }
 
-  base::SortUnique(m_candidates);
+  return reachable;
+}
 
-  m_candidates.erase(remove_if(m_candidates.begin(), m_candidates.end(),
-                               [&](Candidate const & candidate) {
-                                 return candidate.GetDistance() > kMatchingRange;
-                               }),
-                     m_candidates.end());
+double TrackMatcher::GetRouteLength(Candidate const & from, Candidate const & to,
+                                    double maxDistance)
+{
+  // Gps noise may move the next point a bit back along the same segment.
+  if (from.m_segment == to.m_segment)
+    return fabs(to.m_offset - from.m_offset);
+
+  double const toFromEnd = from.m_length - from.m_offset;
+  if (toFromEnd + to.m_offset > maxDistance)
+    return -1.0;
+
+  auto const & distances = GetReachable(from.m_segment, maxDistance - toFromEnd).m_distances;
+  auto const it = distances.find(to.m_segment);
+  if (it == distances.cend())
+    return -1.0;
+
+  double const route = toFromEnd + it->second + to.m_offset;
+  return route <= maxDistance ? route : -1.0;
 }
 
-void TrackMatcher::Step::ChooseSegment(Step const & nextStep, IndexGraph & indexGraph)
+TrackMatcher::Reachable const & TrackMatcher::GetReachable(Segment const & from,
+                                                           double maxDistance)
 {
-  CHECK(!m_candidates.empty(), ());
+  auto & reachable = m_reachableCache[from];
+  if (!reachable.m_distances.empty() && reachable.m_maxDistance >= maxDistance)
+    return reachable;
 
-  double minDistance = numeric_limits<double>::max();
+  // Distances from the end of |from| to the starts of segments.
+  reachable.m_maxDistance = maxDistance;
+  reachable.m_distances.clear();
+  auto & distances = reachable.m_distances;
 
-  IndexGraph::SegmentEdgeListT edges;
-  indexGraph.GetEdgeList(nextStep.m_segment, false /* isOutgoing */, true /* useRoutingOptions */,
-                         edges);
-  edges.emplace_back(nextStep.m_segment, GetAStarWeightZero<RouteWeight>());
+  using State = pair<double, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  distances[from] = 0.0;
+  queue.emplace(0.0, from);
 
-  for (Candidate const & candidate : m_candidates)
+  IndexGraph::SegmentEdgeListT edges;
+  while (!queue.empty())
   {
-    if (candidate.GetDistance() < minDistance && EdgesContain(edges, candidate.GetSegment()))
+    auto const [distance, segment] = queue.top();
+    queue.pop();
+    if (distance > distances[segment])
+      continue;
+
+    // The whole |from| isn't passed, the route starts from its end.
+    double const throughDistance =
+        segment == from ? 0.0 : distance + GetSegmentLength(segment, *m_graph);
+    if (throughDistance > maxDistance)
+      continue;
+
+    edges.clear();
+    m_graph->GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, edges);
+    for (SegmentEdge const & edge : edges)
     {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
+      Segment const & target = edge.GetTarget();
+      if (segment.IsInverse(target) || target == from)
+        continue;
+
+      auto const it = distances.find(target);
+      if (it != distances.cend() && it->second <= throughDistance)
+        continue;
+
+      distances[target] = throughDistance;
+      queue.emplace(throughDistance, target);
     }
   }
 
-  if (minDistance == numeric_limits<double>::max())
-    MYTHROW(MessageException, ("Can't find previous step for", nextStep.m_segment));
+  return reachable;
 }
 
-void TrackMatcher::Step::ChooseNearestSegment()
+void TrackMatcher::AddMatchedTrack(vector<Step> const & steps, size_t trackBegin, size_t trackEnd,
+                                   vector<MatchedTrack> & matchedTracks)
 {
-  CHECK(!m_candidates.empty(), ());
+  Step const & lastStep = steps[trackEnd];
+  auto const bestIt = min_element(lastStep.m_costs.cbegin(), lastStep.m_costs.cend());
+  CHECK(bestIt != lastStep.m_costs.cend() && *bestIt != kInfinity, ());
+
+  vector<size_t> chosen(trackEnd - trackBegin + 1);
+  chosen.back() = static_cast<size_t>(distance(lastStep.m_costs.cbegin(), bestIt));
+  for (size_t i = trackEnd; i > trackBegin; --i)
+  {
+    size_t const parent = steps[i].m_parents[chosen[i - trackBegin]];
+    CHECK_NOT_EQUAL(parent, kNoParent, ());
+    chosen[i - trackBegin - 1] = parent;
+  }
 
-  double minDistance = numeric_limits<double>::max();
+  ++m_tracksCount;
 
-  for (Candidate const & candidate : m_candidates)
+  matchedTracks.push_back({});
+  MatchedTrack & matchedTrack = matchedTracks.back();
+  matchedTrack.reserve(chosen.size());
+  for (size_t i = trackBegin; i <= trackEnd; ++i)
   {
-    if (candidate.GetDistance() < minDistance)
-    {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
-    }
+    Step const & step = steps[i];
+    matchedTrack.emplace_back(step.m_dataPoint,
+                              step.m_candidates[chosen[i - trackBegin]].m_segment);
   }
 }
 
-void TrackMatcher::Step::AddCandidate(Segment const & segment, double distance,
-                                      IndexGraph const & graph)
+// TrackMatcher::Step ------------------------------------------------------------------------------
+TrackMatcher::Step::Step(DataPoint const & dataPoint)
+  : m_dataPoint(dataPoint), m_point(mercator::FromLatLon(dataPoint.m_latLon))
 {
-  if (graph.GetAccessType(segment) == RoadAccess::Type::Yes)
-    m_candidates.emplace_back(segment, distance);
 }
 }  // namespace track_analyzing
@@ -13,12 +13,18 @@
 
 #include "geometry/point2d.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace track_analyzing
 {
+// Matches track points to road segments with a hidden Markov model. Candidates of a point are
+// the nearest segments, emission cost depends on the distance to a candidate and transition
+// cost on the difference of the route length between candidates and the straight distance
+// between points. The most probable sequence of segments is found with the Viterbi algorithm.
+// A track is split to several matched tracks where there is no route between candidates.
 class TrackMatcher final
 {
 public:
@@ -32,53 +38,53 @@ public:
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
 
 private:
-  class Candidate final
+  struct Candidate
   {
-  public:
-    Candidate(routing::Segment segment, double distance) : m_segment(segment), m_distance(distance)
-    {
-    }
-
-    routing::Segment const & GetSegment() const { return m_segment; }
-    double GetDistance() const { return m_distance; }
-    bool operator==(Candidate const & candidate) const { return m_segment == candidate.m_segment; }
-    bool operator<(Candidate const & candidate) const { return m_segment < candidate.m_segment; }
-
-  private:
     routing::Segment m_segment;
-    double m_distance;
+    // Distance from the point to the segment in meters.
+    double m_distance = 0.0;
+    // Distance from the start of the segment to the projection of the point in meters.
+    double m_offset = 0.0;
+    double m_length = 0.0;
   };
 
-  class Step final
+  // Column of the Viterbi lattice.
+  struct Step
   {
-  public:
     explicit Step(DataPoint const & dataPoint);
 
-    DataPoint const & GetDataPoint() const { return m_dataPoint; }
-    routing::Segment const & GetSegment() const { return m_segment; }
-    bool HasCandidates() const { return !m_candidates.empty(); }
-    void FillCandidatesWithNearbySegments(DataSource const & dataSource,
-                                          routing::IndexGraph const & graph,
-                                          routing::VehicleModelInterface const & vehicleModel,
-                                          routing::NumMwmId mwmId);
-    void FillCandidates(Step const & previousStep, routing::IndexGraph & graph);
-    void ChooseSegment(Step const & nextStep, routing::IndexGraph & indexGraph);
-    void ChooseNearestSegment();
-
-  private:
-    void AddCandidate(routing::Segment const & segment, double distance,
-                      routing::IndexGraph const & graph);
-
     DataPoint m_dataPoint;
     m2::PointD m_point;
-    routing::Segment m_segment;
     std::vector<Candidate> m_candidates;
+    // Minimal cost of the path to the candidate and the index of the previous step candidate
+    // on this path.
+    std::vector<double> m_costs;
+    std::vector<size_t> m_parents;
   };
 
+  // Route lengths from the end of a segment to the ends of the reachable segments.
+  struct Reachable
+  {
+    double m_maxDistance = 0.0;
+    std::map<routing::Segment, double> m_distances;
+  };
+
+  void FillCandidates(Step & step) const;
+  // Returns false if no candidate of |step| is reachable from the candidates of |prevStep|.
+  bool FillCosts(Step const & prevStep, Step & step);
+  // Returns the route length from the point of |from| to the point of |to| or a negative value if
+  // |to| isn't reachable within |maxDistance|.
+  double GetRouteLength(Candidate const & from, Candidate const & to, double maxDistance);
+  Reachable const & GetReachable(routing::Segment const & from, double maxDistance);
+  void AddMatchedTrack(std::vector<Step> const & steps, size_t trackBegin, size_t trackEnd,
+                       std::vector<MatchedTrack> & matchedTracks);
+
   routing::NumMwmId const m_mwmId;
   FrozenDataSource m_dataSource;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
+  // Bounded Dijkstra results by start segments, it's cleared for each track.
+  std::map<routing::Segment, Reachable> m_reachableCache;
   uint64_t m_tracksCount = 0;
   uint64_t m_pointsCount = 0;
   uint64_t m_nonMatchedPointsCount = 0;
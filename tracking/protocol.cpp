@@ -25,6 +25,7 @@ vector<uint8_t> CreateDataPacketImpl(Container const & points,
   {
   case tracking::Protocol::PacketType::DataV0: version = 0; break;
   case tracking::Protocol::PacketType::DataV1: version = 1; break;
+  case tracking::Protocol::PacketType::DataV2: version = 2; break;
   case tracking::Protocol::PacketType::Error:
   case tracking::Protocol::PacketType::AuthV0:
     LOG(LERROR, ("Can't create a non-DATA packet as a DATA packet. PacketType =", type));
@@ -102,6 +103,7 @@ string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> con
   case Protocol::PacketType::Error:
   case Protocol::PacketType::DataV0:
   case Protocol::PacketType::DataV1:
+  case Protocol::PacketType::DataV2:
     LOG(LERROR, ("Error decoding AUTH packet. PacketType =", type));
     break;
   }
@@ -124,6 +126,9 @@ Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uin
     case Protocol::PacketType::DataV1:
       Encoder::DeserializeDataPoints(1 /* version */, src, points);
       break;
+    case Protocol::PacketType::DataV2:
+      Encoder::DeserializeDataPoints(2 /* version */, src, points);
+      break;
     case Protocol::PacketType::Error:
     case Protocol::PacketType::AuthV0:
       LOG(LERROR, ("Error decoding DATA packet. PacketType =", type));
@@ -161,6 +166,7 @@ string DebugPrint(Protocol::PacketType type)
   case Protocol::PacketType::AuthV0: return "AuthV0";
   case Protocol::PacketType::DataV0: return "DataV0";
   case Protocol::PacketType::DataV1: return "DataV1";
+  case Protocol::PacketType::DataV2: return "DataV2";
   }
   stringstream ss;
   ss << "Unknown(" << static_cast<uint32_t>(type) << ")";
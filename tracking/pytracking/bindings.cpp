@@ -42,6 +42,7 @@ BOOST_PYTHON_MODULE(pytracking)
       .value("AuthV0", Protocol::PacketType::AuthV0)
       .value("DataV0", Protocol::PacketType::DataV0)
       .value("DataV1", Protocol::PacketType::DataV1)
+      .value("DataV2", Protocol::PacketType::DataV2)
       .value("CurrentAuth", Protocol::PacketType::CurrentAuth)
       .value("CurrentData", Protocol::PacketType::CurrentData);
 
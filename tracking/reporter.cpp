@@ -1,14 +1,20 @@
 #include "tracking/reporter.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/traffic.hpp"
+
 #include "platform/location.hpp"
 #include "platform/platform.hpp"
 #include "platform/socket.hpp"
 
 #include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
 #include "std/target_os.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -20,6 +26,10 @@ double constexpr kRequiredHorizontalAccuracy = 10.0;
 double constexpr kMinDelaySeconds = 1.0;
 double constexpr kReconnectDelaySeconds = 40.0;
 double constexpr kNotChargingEventPeriod = 5 * 60.0;
+// Queued points which are older are not interesting for the realtime tracking.
+double constexpr kMaxQueuedPointAgeSeconds = 60 * 60.0;
+uint32_t constexpr kQueueVersion = 2;
+char constexpr kQueueFileName[] = "tracking_queue.bin";
 
 static_assert(kMinDelaySeconds != 0, "");
 } // namespace
@@ -30,14 +40,21 @@ const char Reporter::kEnableTrackingKey[] = "StatisticsEnabled";
 
 // static
 milliseconds const Reporter::kPushDelayMs = milliseconds(20000);
+// static
+seconds const Reporter::kCellularPushDelay = seconds(120);
 
-// Set m_points size to be enough to keep all points even if one reconnect attempt failed.
+// Set m_points size to be enough to keep all points of a batch even if one reconnect attempt
+// failed.
 Reporter::Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
                    milliseconds pushDelay)
   : m_allowSendingPoints(true)
+  , m_connectionType(Platform::EConnectionType::CONNECTION_WIFI)
   , m_realtimeSender(std::move(socket), host, port, false)
   , m_pushDelay(pushDelay)
-  , m_points(ceil(duration_cast<seconds>(pushDelay).count() + kReconnectDelaySeconds) / kMinDelaySeconds)
+  , m_points(ceil((duration_cast<seconds>(max<milliseconds>(pushDelay, kCellularPushDelay)).count() +
+                   kReconnectDelaySeconds) /
+                  kMinDelaySeconds))
+  , m_queueFilePath(GetPlatform().WritablePathForFile(kQueueFileName))
   , m_thread([this] { Run(); })
 {
 }
@@ -82,6 +99,8 @@ void Reporter::Run()
 {
   LOG(LINFO, ("Tracking Reporter started"));
 
+  LoadQueue();
+
   unique_lock<mutex> lock(m_mutex);
 
   while (!m_isFinished)
@@ -89,6 +108,8 @@ void Reporter::Run()
     auto const startTime = steady_clock::now();
 
     // Fetch input.
+    if (m_points.empty())
+      m_batchStartTime = startTime;
     m_points.insert(m_points.end(), m_input.begin(), m_input.end());
     m_input.clear();
 
@@ -97,7 +118,7 @@ void Reporter::Run()
     {
       m_idleFn();
     }
-    else
+    else if (IsBatchReady())
     {
       if (SendPoints())
         m_points.clear();
@@ -109,9 +130,23 @@ void Reporter::Run()
       m_cv.wait_for(lock, m_pushDelay - passedMs, [this]{return m_isFinished;});
   }
 
+  m_points.insert(m_points.end(), m_input.begin(), m_input.end());
+  m_input.clear();
+  SaveQueue();
+
   LOG(LINFO, ("Tracking Reporter finished"));
 }
 
+bool Reporter::IsBatchReady() const
+{
+  if (!m_allowSendingPoints || m_connectionType != Platform::EConnectionType::CONNECTION_WWAN)
+    return true;
+
+  // Points are sent earlier when there is a risk to lose the oldest of them.
+  return steady_clock::now() - m_batchStartTime >= kCellularPushDelay ||
+         2 * m_points.size() >= m_points.capacity();
+}
+
 bool Reporter::SendPoints()
 {
   if (!m_allowSendingPoints)
@@ -146,4 +181,50 @@ bool Reporter::SendPoints()
   m_wasConnected = m_realtimeSender.Send(m_points);
   return m_wasConnected;
 }
+
+void Reporter::LoadQueue()
+{
+  if (!Platform::IsFileExistsByFullPath(m_queueFilePath))
+    return;
+
+  vector<DataPoint> points;
+  try
+  {
+    FileReader reader(m_queueFilePath);
+    ReaderSource<FileReader> src(reader);
+    auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+    if (version == kQueueVersion)
+      coding::TrafficGPSEncoder::DeserializeDataPoints(version, src, points);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Error reading tracking queue", m_queueFilePath, e.Msg()));
+    points.clear();
+  }
+  FileWriter::DeleteFileX(m_queueFilePath);
+
+  double const minTimestamp = base::Timer::LocalTime() - kMaxQueuedPointAgeSeconds;
+  base::EraseIf(points, [minTimestamp](DataPoint const & point) {
+    return point.m_timestamp < minTimestamp;
+  });
+  m_points.insert(m_points.end(), points.begin(), points.end());
+  LOG(LINFO, (points.size(), "tracking points are loaded from the queue"));
+}
+
+void Reporter::SaveQueue()
+{
+  if (m_points.empty())
+    return;
+
+  try
+  {
+    FileWriter writer(m_queueFilePath);
+    WriteToSink(writer, kQueueVersion);
+    coding::TrafficGPSEncoder::SerializeDataPoints(kQueueVersion, writer, m_points);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Error writing tracking queue", m_queueFilePath, e.Msg()));
+  }
+}
 }  // namespace tracking
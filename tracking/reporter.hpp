@@ -4,6 +4,8 @@
 
 #include "traffic/speed_groups.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/thread.hpp"
 
 #include <atomic>
@@ -37,10 +39,14 @@ class Socket;
 
 namespace tracking
 {
+/// Collects points and sends them to the tracking server from a worker thread. Points are sent
+/// each |pushDelay| on Wi-Fi. On a cellular network they are sent in batches since each upload
+/// keeps the radio awake for seconds. Unsent points are kept in a file between the runs.
 class Reporter final
 {
 public:
   static std::chrono::milliseconds const kPushDelayMs;
+  static std::chrono::seconds const kCellularPushDelay;
   static const char kEnableTrackingKey[];
 
   Reporter(std::unique_ptr<platform::Socket> socket, std::string const & host, uint16_t port,
@@ -51,13 +57,20 @@ public:
 
   void SetAllowSendingPoints(bool allow) { m_allowSendingPoints = allow; }
 
+  /// Sets the current network type. Points are sent each |pushDelay| until it's set.
+  void SetConnectionType(Platform::EConnectionType type) { m_connectionType = type; }
+
   void SetIdleFunc(std::function<void()> fn) { m_idleFn = fn; }
 
 private:
   void Run();
+  bool IsBatchReady() const;
   bool SendPoints();
+  void LoadQueue();
+  void SaveQueue();
 
   std::atomic<bool> m_allowSendingPoints;
+  std::atomic<Platform::EConnectionType> m_connectionType;
   Connection m_realtimeSender;
   std::chrono::milliseconds m_pushDelay;
   bool m_wasConnected = false;
@@ -70,6 +83,9 @@ private:
   std::vector<DataPoint> m_input;
   // Last collected points, sends periodically to server.
   boost::circular_buffer<DataPoint> m_points;
+  // Time when the first of |m_points| was collected.
+  std::chrono::steady_clock::time_point m_batchStartTime;
+  std::string const m_queueFilePath;
   double m_lastGpsTime = 0.0;
   bool m_isFinished = false;
   std::mutex m_mutex;
@@ -121,6 +121,7 @@ UNIT_TEST(Protocol_DecodeDataPacket)
 
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV0);
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV1);
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
 }
 
 UNIT_TEST(Protocol_DecodeWrongDataPacket)
@@ -132,7 +133,8 @@ UNIT_TEST(Protocol_DecodeWrongDataPacket)
       vector<uint8_t>{0x0, 0x0, 0x23, 0xFF},
       vector<uint8_t>{0xFF, 0x1, 0x23, 0xFF, 0x1, 0x0, 0x27, 0x63, 0x32, 0x9, 0xFF},
   };
-  for (auto const packetType : {Protocol::PacketType::DataV0, Protocol::PacketType::DataV1})
+  for (auto const packetType : {Protocol::PacketType::DataV0, Protocol::PacketType::DataV1,
+                                Protocol::PacketType::DataV2})
   {
     for (auto const & payload : payloads)
     {
@@ -55,6 +55,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     case Packet::Error:
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -63,12 +64,10 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
   } while (readSize);
 
   TEST(!buffer.empty(), ());
-  vector<coding::TrafficGPSEncoder::DataPoint> points;
-  MemReader memReader(buffer.data(), buffer.size());
-  ReaderSource<MemReader> src(memReader);
-  src.Skip(sizeof(uint32_t /* header */));
-  coding::TrafficGPSEncoder::DeserializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion, src,
-                                                   points);
+  TEST_EQUAL(Packet(buffer[0]), Packet::CurrentData, ());
+  auto const points = tracking::Protocol::DecodeDataPacket(
+      Packet::CurrentData,
+      vector<uint8_t>(buffer.begin() + sizeof(uint32_t /* header */), buffer.end()));
 
   TEST_EQUAL(points.size(), 1, ());
   auto const & point = points[0];
@@ -75,6 +75,9 @@ string MakeRemoteURL(string const & name, uint64_t version)
 }
 
 char const kETag[] = "etag";
+// The header with the ETag of the values which the client has. The server may respond
+// with the changes since these values (see TrafficInfo::kDeltaValuesVersion).
+char const kDeltaBaseHeader[] = "X-Traffic-Delta-Base";
 }  // namespace
 
 // TrafficInfo::RoadSegmentId -----------------------------------------------------------------
@@ -85,11 +88,108 @@ TrafficInfo::RoadSegmentId::RoadSegmentId(uint32_t fid, uint16_t idx, uint8_t di
 {
 }
 
+// TrafficInfo::SegmentsIndex -----------------------------------------------------------------
+TrafficInfo::SegmentsIndex::SegmentsIndex(vector<RoadSegmentId> const & keys)
+{
+  ASSERT(is_sorted(keys.begin(), keys.end()), ());
+  for (size_t i = 0; i < keys.size();)
+  {
+    Feature feature;
+    feature.m_fid = keys[i].m_fid;
+    feature.m_firstSlot = m_slotsCount;
+    feature.m_dirsCount = 1;
+
+    uint32_t maxIdx = 0;
+    for (; i < keys.size() && keys[i].m_fid == feature.m_fid; ++i)
+    {
+      maxIdx = max(maxIdx, static_cast<uint32_t>(keys[i].m_idx));
+      if (keys[i].m_dir == RoadSegmentId::kReverseDirection)
+        feature.m_dirsCount = 2;
+    }
+
+    feature.m_segmentsCount = static_cast<uint16_t>(maxIdx + 1);
+    m_slotsCount += feature.m_segmentsCount * feature.m_dirsCount;
+    m_features.push_back(feature);
+  }
+  m_features.shrink_to_fit();
+}
+
+bool TrafficInfo::SegmentsIndex::GetSlot(RoadSegmentId const & id, uint32_t & slot) const
+{
+  auto const it = lower_bound(m_features.cbegin(), m_features.cend(), id.m_fid,
+                              [](Feature const & f, uint32_t fid) { return f.m_fid < fid; });
+  if (it == m_features.cend() || it->m_fid != id.m_fid || id.m_idx >= it->m_segmentsCount ||
+      id.m_dir >= it->m_dirsCount)
+  {
+    return false;
+  }
+
+  slot = it->m_firstSlot + id.m_idx * it->m_dirsCount + id.m_dir;
+  return true;
+}
+
+// TrafficInfo::PackedColoring ----------------------------------------------------------------
+TrafficInfo::PackedColoring::PackedColoring(shared_ptr<SegmentsIndex const> index,
+                                            vector<SpeedGroup> const & values)
+{
+  CHECK(index, ());
+  CHECK_EQUAL(index->GetSlotsCount(), values.size(), ());
+  Init(std::move(index));
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] != SpeedGroup::Unknown)
+      Set(static_cast<uint32_t>(i), values[i]);
+  }
+}
+
+TrafficInfo::PackedColoring::PackedColoring(Coloring const & coloring)
+{
+  vector<RoadSegmentId> keys;
+  keys.reserve(coloring.size());
+  for (auto const & kv : coloring)
+    keys.push_back(kv.first);
+
+  Init(make_shared<SegmentsIndex>(keys));
+  for (auto const & [id, group] : coloring)
+  {
+    uint32_t slot;
+    VERIFY(m_index->GetSlot(id, slot), (id));
+    if (group != SpeedGroup::Unknown)
+      Set(slot, group);
+  }
+}
+
+SpeedGroup TrafficInfo::PackedColoring::Get(RoadSegmentId const & id) const
+{
+  uint32_t slot;
+  if (IsEmpty() || !m_index->GetSlot(id, slot))
+    return SpeedGroup::Unknown;
+  return static_cast<SpeedGroup>((m_values[slot / 2] >> (4 * (slot % 2))) & 0xF);
+}
+
+void TrafficInfo::PackedColoring::Init(shared_ptr<SegmentsIndex const> index)
+{
+  m_index = std::move(index);
+  auto const unknown = static_cast<uint8_t>(SpeedGroup::Unknown);
+  m_values.assign((m_index->GetSlotsCount() + 1) / 2, static_cast<uint8_t>(unknown | (unknown << 4)));
+  m_knownCount = 0;
+}
+
+void TrafficInfo::PackedColoring::Set(uint32_t slot, SpeedGroup group)
+{
+  auto & byte = m_values[slot / 2];
+  auto const shift = 4 * (slot % 2);
+  if (static_cast<SpeedGroup>((byte >> shift) & 0xF) == SpeedGroup::Unknown)
+    ++m_knownCount;
+  byte = static_cast<uint8_t>((byte & ~(0xF << shift)) | (static_cast<uint8_t>(group) << shift));
+}
+
 // TrafficInfo --------------------------------------------------------------------------------
 
 // static
 uint8_t const TrafficInfo::kLatestKeysVersion = 0;
 uint8_t const TrafficInfo::kLatestValuesVersion = 0;
+uint8_t const TrafficInfo::kDeltaValuesVersion = 1;
 
 TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion)
   : m_mwmId(mwmId)
@@ -112,7 +212,9 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
       LOG(LINFO, ("Reading keys for", mwmId, "from section"));
       try
       {
-        DeserializeTrafficKeys(buf, m_keys);
+        vector<RoadSegmentId> keys;
+        DeserializeTrafficKeys(buf, keys);
+        m_segmentsIndex = make_shared<SegmentsIndex>(keys);
       }
       catch (Reader::Exception const & e)
       {
@@ -133,23 +235,34 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
   }
 }
 
+TrafficInfo::TrafficInfo(TrafficInfo const & prev, int64_t currentDataVersion)
+  : m_segmentsIndex(prev.m_segmentsIndex)
+  , m_values(prev.m_values)
+  , m_mwmId(prev.m_mwmId)
+  , m_currentDataVersion(currentDataVersion)
+{
+}
+
 // static
 TrafficInfo TrafficInfo::BuildForTesting(Coloring && coloring)
 {
   TrafficInfo info;
-  info.m_coloring = std::move(coloring);
+  info.m_coloring = make_shared<PackedColoring>(coloring);
   return info;
 }
 
 void TrafficInfo::SetTrafficKeysForTesting(vector<RoadSegmentId> const & keys)
 {
-  m_keys = keys;
+  m_segmentsIndex = make_shared<SegmentsIndex>(keys);
   m_availability = Availability::IsAvailable;
 }
 
 bool TrafficInfo::ReceiveTrafficData(string & etag)
 {
   vector<SpeedGroup> values;
+  if (m_values && !etag.empty())
+    values = *m_values;
+
   switch (ReceiveTrafficValues(etag, values))
   {
   case ServerDataStatus::New:
@@ -165,10 +278,7 @@ bool TrafficInfo::ReceiveTrafficData(string & etag)
 
 SpeedGroup TrafficInfo::GetSpeedGroup(RoadSegmentId const & id) const
 {
-  auto const it = m_coloring.find(id);
-  if (it == m_coloring.cend())
-    return SpeedGroup::Unknown;
-  return it->second;
+  return m_coloring->Get(id);
 }
 
 // static
@@ -363,6 +473,53 @@ void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
   deflate(buf.data(), buf.size(), back_inserter(result));
 }
 
+// static
+void TrafficInfo::SerializeTrafficValuesDelta(vector<SpeedGroup> const & prevValues,
+                                              vector<SpeedGroup> const & values,
+                                              vector<uint8_t> & result)
+{
+  CHECK_EQUAL(prevValues.size(), values.size(), ());
+
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> memWriter(buf);
+  WriteToSink(memWriter, kDeltaValuesVersion);
+  WriteVarUint(memWriter, values.size());
+
+  size_t numChanges = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] != prevValues[i])
+      ++numChanges;
+  }
+  WriteVarUint(memWriter, numChanges);
+
+  {
+    BitWriter<decltype(memWriter)> bitWriter(memWriter);
+    auto const numSpeedGroups = static_cast<uint8_t>(SpeedGroup::Count);
+    size_t prevIndex = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      if (values[i] == prevValues[i])
+        continue;
+
+      // Indices of the changed values are written as differences with the previous ones.
+      bool ok = coding::GammaCoder::Encode(bitWriter, static_cast<uint64_t>(i - prevIndex) + 1);
+      ASSERT(ok, ());
+      UNUSED_VALUE(ok);
+      prevIndex = i;
+
+      uint8_t const u = static_cast<uint8_t>(values[i]);
+      CHECK_LESS(u, numSpeedGroups, ());
+      bitWriter.Write(u, 3);
+    }
+  }
+
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  deflate(buf.data(), buf.size(), back_inserter(result));
+}
+
 // static
 void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
                                            vector<SpeedGroup> & result)
@@ -378,9 +535,31 @@ void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
   ReaderSource<decltype(memReader)> src(memReader);
 
   auto const version = ReadPrimitiveFromSource<uint8_t>(src);
-  CHECK_EQUAL(version, kLatestValuesVersion, ("Unsupported version of traffic keys."));
+  CHECK(version == kLatestValuesVersion || version == kDeltaValuesVersion,
+        ("Unsupported version of traffic values:", version));
 
   auto const n = ReadVarUint<uint32_t>(src);
+
+  if (version == kDeltaValuesVersion)
+  {
+    if (result.size() != n)
+      MYTHROW(Reader::Exception, ("Traffic values delta for", n, "values, there are", result.size()));
+
+    auto const numChanges = ReadVarUint<uint32_t>(src);
+    BitReader<decltype(src)> bitReader(src);
+    size_t index = 0;
+    for (uint32_t i = 0; i < numChanges; ++i)
+    {
+      index += static_cast<size_t>(coding::GammaCoder::Decode(bitReader) - 1);
+      if (index >= result.size())
+        MYTHROW(Reader::Exception, ("Wrong index of changed traffic value:", index));
+      result[index] = static_cast<SpeedGroup>(bitReader.Read(3));
+    }
+
+    ASSERT_EQUAL(src.Size(), 0, ());
+    return;
+  }
+
   result.resize(n);
   BitReader<decltype(src)> bitReader(src);
   for (size_t i = 0; i < static_cast<size_t>(n); ++i)
@@ -427,7 +606,7 @@ bool TrafficInfo::ReceiveTrafficKeys()
                 "Version:", info->GetVersion()));
     return false;
   }
-  m_keys.swap(keys);
+  m_segmentsIndex = make_shared<SegmentsIndex>(keys);
   return true;
 }
 
@@ -449,6 +628,8 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   platform::HttpClient request(url);
   request.LoadHeaders(true);
   request.SetRawHeader("If-None-Match", etag);
+  if (!values.empty())
+    request.SetRawHeader(kDeltaBaseHeader, etag);
 
   if (!request.RunHttpRequest() || request.ErrorCode() != 200)
     return ProcessFailure(request, version);
@@ -477,23 +658,21 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
 
 bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
 {
-  m_coloring.clear();
+  m_coloring = make_shared<PackedColoring>();
+  m_values.reset();
 
-  if (m_keys.size() != values.size())
+  auto const keysCount = m_segmentsIndex->GetSlotsCount();
+  if (keysCount != values.size())
   {
     LOG(LWARNING,
         ("The number of received traffic values does not correspond to the number of keys:",
-         m_keys.size(), "keys", values.size(), "values."));
+         keysCount, "keys", values.size(), "values."));
     m_availability = Availability::NoData;
     return false;
   }
 
-  for (size_t i = 0; i < m_keys.size(); ++i)
-  {
-    if (values[i] != SpeedGroup::Unknown)
-      m_coloring.emplace(m_keys[i], values[i]);
-  }
-
+  m_coloring = make_shared<PackedColoring>(m_segmentsIndex, values);
+  m_values = make_shared<vector<SpeedGroup>>(values);
   return true;
 }
 
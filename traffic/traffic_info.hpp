@@ -6,6 +6,8 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace platform
@@ -22,6 +24,8 @@ class TrafficInfo
 public:
   static uint8_t const kLatestKeysVersion;
   static uint8_t const kLatestValuesVersion;
+  // Version of the values which are the changes of the previously received values.
+  static uint8_t const kDeltaValuesVersion;
 
   enum class Availability
   {
@@ -71,13 +75,85 @@ public:
     uint8_t m_dir : 1;
   };
 
-  // todo(@m) unordered_map?
+  // Sparse coloring, it's used to build the traffic data and in tests.
   using Coloring = std::map<RoadSegmentId, SpeedGroup>;
 
+  // Slots for all segments of all road features of an mwm. Segments of a feature occupy
+  // consecutive slots in the order of the traffic keys (by segment index, then by direction),
+  // so the slot of a segment is found by a binary search of its feature only.
+  // The index is built once per mwm and is shared between the traffic updates.
+  class SegmentsIndex
+  {
+  public:
+    SegmentsIndex() = default;
+    // |keys| must be sorted.
+    explicit SegmentsIndex(std::vector<RoadSegmentId> const & keys);
+
+    // Returns false if there is no slot for |id|.
+    bool GetSlot(RoadSegmentId const & id, uint32_t & slot) const;
+    // For the traffic keys of an mwm it's equal to the number of the keys.
+    uint32_t GetSlotsCount() const { return m_slotsCount; }
+    size_t GetMemorySize() const { return m_features.capacity() * sizeof(Feature); }
+
+  private:
+    struct Feature
+    {
+      uint32_t m_fid = 0;
+      uint32_t m_firstSlot = 0;
+      uint16_t m_segmentsCount = 0;
+      uint8_t m_dirsCount = 0;
+    };
+
+    // Sorted by fid.
+    std::vector<Feature> m_features;
+    uint32_t m_slotsCount = 0;
+  };
+
+  // Speed groups of the road segments of an mwm packed by 4 bits per slot of a SegmentsIndex.
+  // Lookup doesn't allocate and touches two small arrays only, so it's cheap enough for
+  // the routing edge estimation.
+  class PackedColoring
+  {
+  public:
+    PackedColoring() = default;
+    // |values| are in the order of the slots of |index|.
+    PackedColoring(std::shared_ptr<SegmentsIndex const> index, std::vector<SpeedGroup> const & values);
+    explicit PackedColoring(Coloring const & coloring);
+
+    // Returns SpeedGroup::Unknown if there is no information about the segment.
+    SpeedGroup Get(RoadSegmentId const & id) const;
+
+    bool IsEmpty() const { return m_knownCount == 0; }
+    // Number of the segments with known speed group.
+    size_t GetKnownCount() const { return m_knownCount; }
+    // Memory of the values only, the index is shared.
+    size_t GetMemorySize() const { return m_values.capacity(); }
+
+    // Colorings are equal if they share the index and have the same values, so the colorings
+    // of the subsequent updates of an mwm may be compared.
+    bool operator==(PackedColoring const & rhs) const
+    {
+      return m_index == rhs.m_index && m_values == rhs.m_values;
+    }
+
+  private:
+    void Init(std::shared_ptr<SegmentsIndex const> index);
+    void Set(uint32_t slot, SpeedGroup group);
+
+    std::shared_ptr<SegmentsIndex const> m_index;
+    std::vector<uint8_t> m_values;
+    size_t m_knownCount = 0;
+  };
+
   TrafficInfo() = default;
 
   TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion);
 
+  // Creates an info for the next update of the traffic of |prev|'s mwm. The keys and the values
+  // of |prev| are reused, so the keys aren't read again and the server may send the changes
+  // of the values only. The coloring is not copied.
+  TrafficInfo(TrafficInfo const & prev, int64_t currentDataVersion);
+
   static TrafficInfo BuildForTesting(Coloring && coloring);
   void SetTrafficKeysForTesting(std::vector<RoadSegmentId> const & keys);
 
@@ -94,7 +170,10 @@ public:
   SpeedGroup GetSpeedGroup(RoadSegmentId const & id) const;
 
   MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
-  Coloring const & GetColoring() const { return m_coloring; }
+  PackedColoring const & GetColoring() const { return *m_coloring; }
+  // The coloring is immutable, so it's shared by all its users instead of copying.
+  std::shared_ptr<PackedColoring const> const & GetSharedColoring() const { return m_coloring; }
+  bool HasValues() const { return m_values != nullptr; }
   Availability GetAvailability() const { return m_availability; }
 
   // Extracts RoadSegmentIds from mwm and stores them in a sorted order.
@@ -116,6 +195,13 @@ public:
 
   static void SerializeTrafficValues(std::vector<SpeedGroup> const & values, std::vector<uint8_t> & result);
 
+  // Serializes the changes from |prevValues| to |values|. Both vectors are in the order of the keys.
+  static void SerializeTrafficValuesDelta(std::vector<SpeedGroup> const & prevValues,
+                                          std::vector<SpeedGroup> const & values,
+                                          std::vector<uint8_t> & result);
+
+  // Deserializes both full values and changes of values. In the latter case |result| must
+  // contain the values which the changes are made for.
   static void DeserializeTrafficValues(std::vector<uint8_t> const & data, std::vector<SpeedGroup> & result);
 
 private:
@@ -134,6 +220,7 @@ private:
   bool ReceiveTrafficKeys();
 
   // Tries to read the values of the Coloring map from server into |values|.
+  // When |values| contains the values of |etag| the server may send the changes only.
   // Returns result of communicating with server as ServerDataStatus.
   // Otherwise, returns false and does not change m_coloring.
   ServerDataStatus ReceiveTrafficValues(std::string & etag, std::vector<SpeedGroup> & values);
@@ -144,13 +231,16 @@ private:
   ServerDataStatus ProcessFailure(platform::HttpClient const & request, int64_t const mwmVersion);
 
   // The mapping from feature segments to speed groups (see speed_groups.hpp).
-  Coloring m_coloring;
+  std::shared_ptr<PackedColoring const> m_coloring = std::make_shared<PackedColoring>();
 
-  // The keys of the coloring map. The values are downloaded periodically
+  // The index of the keys of the coloring. The values are downloaded periodically
   // and combined with the keys to form m_coloring.
   // *NOTE* The values must be received in the exact same order that the
   // keys are saved in.
-  std::vector<RoadSegmentId> m_keys;
+  std::shared_ptr<SegmentsIndex const> m_segmentsIndex = std::make_shared<SegmentsIndex>();
+
+  // The last received values in the order of the keys, nullptr if there are no values yet.
+  std::shared_ptr<std::vector<SpeedGroup> const> m_values;
 
   MwmSet::MwmId m_mwmId;
   Availability m_availability = Availability::Unknown;
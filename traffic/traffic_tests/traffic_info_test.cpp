@@ -145,4 +145,79 @@ UNIT_TEST(TrafficInfo_UpdateTrafficData)
   for (size_t i = 0; i < keys.size(); ++i)
     TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
 }
+
+UNIT_TEST(TrafficInfo_PackedColoring)
+{
+  using RoadSegmentId = TrafficInfo::RoadSegmentId;
+
+  // Feature 3 is one-way, feature 7 is two-way.
+  vector<RoadSegmentId> const keys = {
+      RoadSegmentId(3, 0, 0), RoadSegmentId(3, 1, 0), RoadSegmentId(3, 2, 0),
+      RoadSegmentId(7, 0, 0), RoadSegmentId(7, 0, 1), RoadSegmentId(7, 1, 0), RoadSegmentId(7, 1, 1),
+  };
+  vector<SpeedGroup> const values = {
+      SpeedGroup::G0, SpeedGroup::Unknown, SpeedGroup::G5,
+      SpeedGroup::TempBlock, SpeedGroup::G1, SpeedGroup::G2, SpeedGroup::Unknown,
+  };
+
+  auto const index = make_shared<TrafficInfo::SegmentsIndex>(keys);
+  TEST_EQUAL(index->GetSlotsCount(), keys.size(), ());
+
+  TrafficInfo::PackedColoring const coloring(index, values);
+  TEST_EQUAL(coloring.GetKnownCount(), 5, ());
+  for (size_t i = 0; i < keys.size(); ++i)
+    TEST_EQUAL(coloring.Get(keys[i]), values[i], (keys[i]));
+
+  TEST_EQUAL(coloring.Get(RoadSegmentId(3, 0, 1)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(RoadSegmentId(3, 3, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(RoadSegmentId(5, 0, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(RoadSegmentId(8, 0, 0)), SpeedGroup::Unknown, ());
+
+  // Sparse coloring.
+  TrafficInfo::PackedColoring const sparse(TrafficInfo::Coloring{
+      {RoadSegmentId(1, 2, 1), SpeedGroup::G3}, {RoadSegmentId(4, 0, 0), SpeedGroup::G4}});
+  TEST_EQUAL(sparse.GetKnownCount(), 2, ());
+  TEST_EQUAL(sparse.Get(RoadSegmentId(1, 2, 1)), SpeedGroup::G3, ());
+  TEST_EQUAL(sparse.Get(RoadSegmentId(1, 2, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(sparse.Get(RoadSegmentId(4, 0, 0)), SpeedGroup::G4, ());
+  TEST(TrafficInfo::PackedColoring().IsEmpty(), ());
+
+  TEST(TrafficInfo::PackedColoring(index, values) == coloring, ());
+  auto changedValues = values;
+  changedValues[1] = SpeedGroup::G4;
+  TEST(!(TrafficInfo::PackedColoring(index, changedValues) == coloring), ());
+  auto const anotherIndex = make_shared<TrafficInfo::SegmentsIndex>(keys);
+  TEST(!(TrafficInfo::PackedColoring(anotherIndex, values) == coloring), ());
+}
+
+UNIT_TEST(TrafficInfo_ValuesDelta)
+{
+  vector<SpeedGroup> const prevValues = {
+      SpeedGroup::G0, SpeedGroup::G1, SpeedGroup::Unknown, SpeedGroup::G3, SpeedGroup::G5,
+      SpeedGroup::TempBlock, SpeedGroup::G2,
+  };
+
+  vector<SpeedGroup> const values = {
+      SpeedGroup::G1, SpeedGroup::G1, SpeedGroup::Unknown, SpeedGroup::G3, SpeedGroup::G4,
+      SpeedGroup::TempBlock, SpeedGroup::Unknown,
+  };
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeTrafficValuesDelta(prevValues, values, buf);
+
+  // The delta is applied to the previous values.
+  vector<SpeedGroup> deserializedValues = prevValues;
+  TrafficInfo::DeserializeTrafficValues(buf, deserializedValues);
+  TEST_EQUAL(values, deserializedValues, ());
+
+  // The delta is not applicable to the values of other keys.
+  deserializedValues.resize(3);
+  TEST_ANY_THROW(TrafficInfo::DeserializeTrafficValues(buf, deserializedValues), ());
+
+  // Full values replace any previous ones.
+  buf.clear();
+  TrafficInfo::SerializeTrafficValues(values, buf);
+  TrafficInfo::DeserializeTrafficValues(buf, deserializedValues);
+  TEST_EQUAL(values, deserializedValues, ());
+}
 }  // namespace traffic
@@ -0,0 +1,289 @@
+#include "transit/experimental/transit_raptor.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace transit
+{
+namespace experimental
+{
+bool TransitRaptor::Leg::operator==(Leg const & rhs) const
+{
+  return m_lineId == rhs.m_lineId && m_stop1Id == rhs.m_stop1Id && m_stop2Id == rhs.m_stop2Id &&
+         m_departure == rhs.m_departure && m_arrival == rhs.m_arrival;
+}
+
+TransitRaptor::TransitRaptor(TransitData const & data)
+  : TransitRaptor(data.GetStops(), data.GetLines(), data.GetEdges())
+{
+}
+
+TransitRaptor::TransitRaptor(std::vector<Stop> const & stops, std::vector<Line> const & lines,
+                             std::vector<Edge> const & edges)
+{
+  m_stopIds.reserve(stops.size());
+  for (auto const & stop : stops)
+    m_stopIds.push_back(stop.GetId());
+  base::SortUnique(m_stopIds);
+
+  std::unordered_map<EdgeId, EdgeWeight, EdgeIdHasher> lineEdges;
+  std::vector<std::pair<uint32_t, Footpath>> footpaths;
+  for (auto const & edge : edges)
+  {
+    if (!edge.IsTransfer())
+    {
+      lineEdges.emplace(EdgeId(edge.GetStop1Id(), edge.GetStop2Id(), edge.GetLineId()),
+                        edge.GetWeight());
+      continue;
+    }
+
+    auto const stop1 = GetStopIndex(edge.GetStop1Id());
+    auto const stop2 = GetStopIndex(edge.GetStop2Id());
+    if (stop1 != kInvalidIndex && stop2 != kInvalidIndex)
+      footpaths.emplace_back(stop1, Footpath{stop2, edge.GetWeight()});
+  }
+
+  std::vector<std::vector<LineStop>> stopLines(m_stopIds.size());
+  m_lineStopsBegin.push_back(0);
+  for (auto const & line : lines)
+  {
+    auto const & stopIds = line.GetStopIds();
+    std::vector<uint32_t> lineStops;
+    std::vector<uint32_t> lineTimes;
+    uint32_t time = 0;
+    for (size_t i = 0; i < stopIds.size(); ++i)
+    {
+      if (i != 0)
+      {
+        auto const it = lineEdges.find(EdgeId(stopIds[i - 1], stopIds[i], line.GetId()));
+        if (it == lineEdges.cend())
+          break;
+        time += it->second;
+      }
+
+      auto const stop = GetStopIndex(stopIds[i]);
+      if (stop == kInvalidIndex)
+        break;
+
+      lineStops.push_back(stop);
+      lineTimes.push_back(time);
+    }
+
+    if (lineStops.size() < 2 || lineStops.size() != stopIds.size())
+    {
+      LOG(LWARNING, ("Line", line.GetId(), "with unknown stops or edges is skipped."));
+      continue;
+    }
+
+    auto const lineIndex = static_cast<uint32_t>(m_lineIds.size());
+    for (uint32_t pos = 0; pos < lineStops.size(); ++pos)
+      stopLines[lineStops[pos]].push_back({lineIndex, pos});
+
+    m_lineStops.insert(m_lineStops.end(), lineStops.begin(), lineStops.end());
+    m_lineTimes.insert(m_lineTimes.end(), lineTimes.begin(), lineTimes.end());
+    m_lineStopsBegin.push_back(static_cast<uint32_t>(m_lineStops.size()));
+    m_lineIds.push_back(line.GetId());
+    m_schedules.push_back(line.GetSchedule());
+  }
+
+  m_stopLinesBegin.reserve(m_stopIds.size() + 1);
+  m_stopLinesBegin.push_back(0);
+  for (auto const & lineStopsOfStop : stopLines)
+  {
+    m_stopLines.insert(m_stopLines.end(), lineStopsOfStop.begin(), lineStopsOfStop.end());
+    m_stopLinesBegin.push_back(static_cast<uint32_t>(m_stopLines.size()));
+  }
+
+  std::stable_sort(footpaths.begin(), footpaths.end(),
+                   [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+  m_stopFootpathsBegin.reserve(m_stopIds.size() + 1);
+  m_stopFootpathsBegin.push_back(0);
+  m_stopFootpaths.reserve(footpaths.size());
+  size_t i = 0;
+  for (uint32_t stop = 0; stop < m_stopIds.size(); ++stop)
+  {
+    for (; i < footpaths.size() && footpaths[i].first == stop; ++i)
+      m_stopFootpaths.push_back(footpaths[i].second);
+    m_stopFootpathsBegin.push_back(static_cast<uint32_t>(m_stopFootpaths.size()));
+  }
+}
+
+bool TransitRaptor::FindJourney(TransitId fromStopId, TransitId toStopId, time_t departure,
+                                std::vector<Leg> & legs, size_t maxLines) const
+{
+  legs.clear();
+
+  auto const from = GetStopIndex(fromStopId);
+  auto const to = GetStopIndex(toStopId);
+  if (from == kInvalidIndex || to == kInvalidIndex)
+    return false;
+
+  size_t const stopsCount = m_stopIds.size();
+  time_t constexpr kInfinity = std::numeric_limits<time_t>::max();
+
+  // |rounds[k]| keeps labels of the stops which are improved with k lines.
+  std::vector<std::vector<Label>> rounds(1, std::vector<Label>(stopsCount));
+  std::vector<time_t> best(stopsCount, kInfinity);
+  std::vector<bool> isMarked(stopsCount, false);
+  std::vector<uint32_t> marked;
+
+  auto const improve = [&](std::vector<Label> & labels, uint32_t stop, Label const & label) {
+    labels[stop] = label;
+    best[stop] = label.m_arrival;
+    if (!isMarked[stop])
+    {
+      isMarked[stop] = true;
+      marked.push_back(stop);
+    }
+  };
+
+  // Transfers are relaxed from the stops which are improved with lines only, so there are
+  // no sequences of transfers.
+  auto const relaxFootpaths = [&](std::vector<Label> & labels) {
+    size_t const count = marked.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t const stop = marked[i];
+      time_t const arrival = labels[stop].m_arrival;
+      for (uint32_t j = m_stopFootpathsBegin[stop]; j < m_stopFootpathsBegin[stop + 1]; ++j)
+      {
+        auto const & footpath = m_stopFootpaths[j];
+        time_t const footpathArrival = arrival + footpath.m_weight;
+        if (footpathArrival < std::min(best[footpath.m_stop], best[to]))
+          improve(labels, footpath.m_stop, {footpathArrival, arrival, stop, kInvalidIndex});
+      }
+    }
+  };
+
+  improve(rounds[0], from, {departure, departure, kInvalidIndex, kInvalidIndex});
+  relaxFootpaths(rounds[0]);
+
+  // The first position of a marked stop in a line, the line is scanned starting with it.
+  std::vector<uint32_t> firstPos(m_lineIds.size(), kInvalidIndex);
+  std::vector<uint32_t> queue;
+  for (size_t k = 1; k <= maxLines && !marked.empty(); ++k)
+  {
+    for (auto const stop : marked)
+    {
+      isMarked[stop] = false;
+      for (uint32_t i = m_stopLinesBegin[stop]; i < m_stopLinesBegin[stop + 1]; ++i)
+      {
+        auto const & lineStop = m_stopLines[i];
+        if (firstPos[lineStop.m_line] == kInvalidIndex)
+          queue.push_back(lineStop.m_line);
+        firstPos[lineStop.m_line] = std::min(firstPos[lineStop.m_line], lineStop.m_pos);
+      }
+    }
+    marked.clear();
+
+    rounds.emplace_back(stopsCount);
+    auto const & prev = rounds[k - 1];
+    auto & labels = rounds[k];
+
+    for (auto const line : queue)
+    {
+      bool onTrip = false;
+      // Departure of the current trip from the first stop of the line.
+      time_t tripStart = 0;
+      time_t boardingTime = 0;
+      uint32_t boardingStop = kInvalidIndex;
+
+      for (uint32_t i = m_lineStopsBegin[line] + firstPos[line]; i < m_lineStopsBegin[line + 1];
+           ++i)
+      {
+        uint32_t const stop = m_lineStops[i];
+        time_t const tripTime = tripStart + m_lineTimes[i];
+        if (onTrip && tripTime < std::min(best[stop], best[to]))
+          improve(labels, stop, {tripTime, boardingTime, boardingStop, line});
+
+        // Checks if an earlier trip may be boarded at the stop.
+        time_t const prevArrival = prev[stop].m_arrival;
+        if (prevArrival == kInfinity || (onTrip && prevArrival >= tripTime))
+          continue;
+
+        time_t start = 0;
+        if (!GetTripStart(line, prevArrival - m_lineTimes[i], start))
+          continue;
+
+        if (!onTrip || start < tripStart)
+        {
+          onTrip = true;
+          tripStart = start;
+          boardingTime = start + m_lineTimes[i];
+          boardingStop = stop;
+        }
+      }
+
+      firstPos[line] = kInvalidIndex;
+    }
+    queue.clear();
+
+    relaxFootpaths(labels);
+  }
+
+  if (best[to] == kInfinity)
+    return false;
+
+  size_t k = 0;
+  while (rounds[k][to].m_arrival != best[to])
+    ++k;
+
+  uint32_t stop = to;
+  while (stop != from || k != 0)
+  {
+    auto const & label = rounds[k][stop];
+    CHECK_NOT_EQUAL(label.m_parentStop, kInvalidIndex, ());
+
+    Leg leg;
+    leg.m_lineId = label.m_line == kInvalidIndex ? kInvalidTransitId : m_lineIds[label.m_line];
+    leg.m_stop1Id = m_stopIds[label.m_parentStop];
+    leg.m_stop2Id = m_stopIds[stop];
+    leg.m_departure = label.m_departure;
+    leg.m_arrival = label.m_arrival;
+    legs.push_back(leg);
+
+    if (label.m_line != kInvalidIndex)
+      --k;
+    stop = label.m_parentStop;
+  }
+
+  std::reverse(legs.begin(), legs.end());
+  return true;
+}
+
+uint32_t TransitRaptor::GetStopIndex(TransitId stopId) const
+{
+  auto const it = std::lower_bound(m_stopIds.cbegin(), m_stopIds.cend(), stopId);
+  if (it == m_stopIds.cend() || *it != stopId)
+    return kInvalidIndex;
+  return static_cast<uint32_t>(std::distance(m_stopIds.cbegin(), it));
+}
+
+bool TransitRaptor::GetTripStart(uint32_t line, time_t time, time_t & tripStart) const
+{
+  auto const & schedule = m_schedules[line];
+  if (schedule.GetServiceIntervals().empty() && schedule.GetServiceExceptions().empty())
+  {
+    tripStart = time + schedule.GetFrequency();
+    return true;
+  }
+
+  return schedule.GetNextDeparture(time, tripStart);
+}
+
+std::string DebugPrint(TransitRaptor::Leg const & leg)
+{
+  std::ostringstream out;
+  out << "Leg [ line: " << leg.m_lineId << ", stop1: " << leg.m_stop1Id
+      << ", stop2: " << leg.m_stop2Id << ", departure: " << leg.m_departure
+      << ", arrival: " << leg.m_arrival << " ]";
+  return out.str();
+}
+}  // namespace experimental
+}  // namespace transit
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "transit/experimental/transit_data.hpp"
+#include "transit/experimental/transit_types_experimental.hpp"
+#include "transit/transit_entities.hpp"
+#include "transit/transit_schedule.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace transit
+{
+namespace experimental
+{
+/// \brief Earliest arrival search between stops for a departure time. It's the round based
+/// algorithm (RAPTOR): round k finds the best arrivals with k lines. Lines are scanned
+/// sequentially over compact arrays of stops and travel times, line schedules are used to
+/// get the trip which may be boarded at a stop.
+/// \note Trips are taken from the line frequencies: a trip departs from the first stop of the
+/// line each headway seconds starting with the beginning of a frequency interval. Lines without
+/// service days are treated as in the static graph: a vehicle comes in a headway at most.
+class TransitRaptor
+{
+public:
+  static size_t constexpr kMaxLinesDefault = 5;
+
+  struct Leg
+  {
+    bool operator==(Leg const & rhs) const;
+
+    // kInvalidTransitId for a transfer between stops.
+    TransitId m_lineId = kInvalidTransitId;
+    TransitId m_stop1Id = kInvalidTransitId;
+    TransitId m_stop2Id = kInvalidTransitId;
+    time_t m_departure = 0;
+    time_t m_arrival = 0;
+  };
+
+  explicit TransitRaptor(TransitData const & data);
+  TransitRaptor(std::vector<Stop> const & stops, std::vector<Line> const & lines,
+                std::vector<Edge> const & edges);
+
+  /// \brief Finds the earliest arrival to |toStopId| when leaving |fromStopId| at |departure|.
+  /// Journeys with the same arrival and fewer lines are preferred.
+  /// \returns false if |toStopId| can't be reached with at most |maxLines| lines.
+  bool FindJourney(TransitId fromStopId, TransitId toStopId, time_t departure,
+                   std::vector<Leg> & legs, size_t maxLines = kMaxLinesDefault) const;
+
+private:
+  static uint32_t constexpr kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  struct LineStop
+  {
+    uint32_t m_line = 0;
+    // Index of the stop in the line.
+    uint32_t m_pos = 0;
+  };
+
+  struct Footpath
+  {
+    uint32_t m_stop = 0;
+    EdgeWeight m_weight = 0;
+  };
+
+  struct Label
+  {
+    time_t m_arrival = std::numeric_limits<time_t>::max();
+    time_t m_departure = 0;
+    uint32_t m_parentStop = kInvalidIndex;
+    // kInvalidIndex for a transfer or the start stop.
+    uint32_t m_line = kInvalidIndex;
+  };
+
+  uint32_t GetStopIndex(TransitId stopId) const;
+  bool GetTripStart(uint32_t line, time_t time, time_t & tripStart) const;
+
+  // Sorted ids of the stops, stops are referenced by the indexes in it.
+  std::vector<TransitId> m_stopIds;
+
+  // Stops of the line |l| are in [m_lineStopsBegin[l], m_lineStopsBegin[l + 1]) of
+  // |m_lineStops|, |m_lineTimes| are travel times in seconds from the first stop of the line.
+  std::vector<uint32_t> m_lineStopsBegin;
+  std::vector<uint32_t> m_lineStops;
+  std::vector<uint32_t> m_lineTimes;
+  std::vector<TransitId> m_lineIds;
+  std::vector<Schedule> m_schedules;
+
+  // Lines and transfers of the stop |s| are in [m_stopLinesBegin[s], m_stopLinesBegin[s + 1])
+  // of |m_stopLines| and in [m_stopFootpathsBegin[s], m_stopFootpathsBegin[s + 1]) of
+  // |m_stopFootpaths|.
+  std::vector<uint32_t> m_stopLinesBegin;
+  std::vector<LineStop> m_stopLines;
+  std::vector<uint32_t> m_stopFootpathsBegin;
+  std::vector<Footpath> m_stopFootpaths;
+};
+
+std::string DebugPrint(TransitRaptor::Leg const & leg);
+}  // namespace experimental
+}  // namespace transit
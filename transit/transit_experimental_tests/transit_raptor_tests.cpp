@@ -0,0 +1,142 @@
+#include "testing/testing.hpp"
+
+#include "transit/experimental/transit_raptor.hpp"
+#include "transit/experimental/transit_types_experimental.hpp"
+
+#include <ctime>
+#include <vector>
+
+#include "3party/just_gtfs/just_gtfs.h"
+
+namespace transit
+{
+namespace experimental
+{
+namespace
+{
+TransitId constexpr kStopA = 1;
+TransitId constexpr kStopB = 2;
+TransitId constexpr kStopC = 3;
+TransitId constexpr kStopD = 4;
+
+TransitId constexpr kLineAC = 10;
+TransitId constexpr kLineBD = 20;
+
+// Local time of 10.04.2020.
+time_t GetTime(int hour, int minute)
+{
+  std::tm tm = {};
+  tm.tm_year = 2020 - 1900;
+  tm.tm_mon = 3;
+  tm.tm_mday = 10;
+  tm.tm_hour = hour;
+  tm.tm_min = minute;
+  tm.tm_isdst = -1;
+  return std::mktime(&tm);
+}
+
+Schedule GetDailySchedule(std::string const & startTime, std::string const & endTime,
+                          Frequency headwayS)
+{
+  auto const available = gtfs::CalendarAvailability::Available;
+  gtfs::CalendarItem calendarItem;
+  calendarItem.start_date = gtfs::Date("20200101");
+  calendarItem.end_date = gtfs::Date("20201231");
+  calendarItem.monday = calendarItem.tuesday = calendarItem.wednesday = available;
+  calendarItem.thursday = calendarItem.friday = calendarItem.saturday = available;
+  calendarItem.sunday = available;
+
+  gtfs::Frequency frequency;
+  frequency.start_time = gtfs::Time(startTime);
+  frequency.end_time = gtfs::Time(endTime);
+  frequency.headway_secs = headwayS;
+
+  Schedule schedule;
+  schedule.AddDatesInterval(calendarItem, gtfs::Frequencies{frequency});
+  return schedule;
+}
+
+TransitRaptor MakeTestRaptor()
+{
+  std::vector<Stop> const stops = {Stop(kStopA), Stop(kStopB), Stop(kStopC), Stop(kStopD)};
+
+  std::vector<Line> const lines = {
+      Line(kLineAC, 100 /* routeId */, ShapeLink(), "A-C" /* title */,
+           IdList{kStopA, kStopB, kStopC}, GetDailySchedule("08:00:00", "10:00:00", 600)),
+      Line(kLineBD, 100 /* routeId */, ShapeLink(), "B-D" /* title */, IdList{kStopB, kStopD},
+           GetDailySchedule("08:00:00", "10:00:00", 300))};
+
+  std::vector<Edge> const edges = {
+      Edge(kStopA, kStopB, 300 /* weight */, kLineAC, false /* transfer */, ShapeLink()),
+      Edge(kStopB, kStopC, 300 /* weight */, kLineAC, false /* transfer */, ShapeLink()),
+      Edge(kStopB, kStopD, 300 /* weight */, kLineBD, false /* transfer */, ShapeLink()),
+      Edge(kStopC, kStopD, 120 /* weight */, kInvalidTransitId, true /* transfer */,
+           ShapeLink())};
+
+  return TransitRaptor(stops, lines, edges);
+}
+
+TransitRaptor::Leg MakeLeg(TransitId lineId, TransitId stop1Id, TransitId stop2Id,
+                           time_t departure, time_t arrival)
+{
+  TransitRaptor::Leg leg;
+  leg.m_lineId = lineId;
+  leg.m_stop1Id = stop1Id;
+  leg.m_stop2Id = stop2Id;
+  leg.m_departure = departure;
+  leg.m_arrival = arrival;
+  return leg;
+}
+}  // namespace
+
+UNIT_TEST(TransitRaptor_ChangeOfLines)
+{
+  auto const raptor = MakeTestRaptor();
+
+  // The trip of A-C departs at 08:10, B-D departs from B each 5 minutes.
+  std::vector<TransitRaptor::Leg> legs;
+  TEST(raptor.FindJourney(kStopA, kStopD, GetTime(8, 3), legs), ());
+
+  std::vector<TransitRaptor::Leg> const expected = {
+      MakeLeg(kLineAC, kStopA, kStopB, GetTime(8, 10), GetTime(8, 15)),
+      MakeLeg(kLineBD, kStopB, kStopD, GetTime(8, 15), GetTime(8, 20))};
+  TEST_EQUAL(legs, expected, ());
+
+  // With a single line D is reached by the transfer from C.
+  TEST(raptor.FindJourney(kStopA, kStopD, GetTime(8, 3), legs, 1 /* maxLines */), ());
+  TEST_EQUAL(legs.size(), 2, ());
+  TEST_EQUAL(legs.back(), MakeLeg(kInvalidTransitId, kStopC, kStopD, GetTime(8, 20),
+                                  GetTime(8, 22)), ());
+}
+
+UNIT_TEST(TransitRaptor_ServiceHours)
+{
+  auto const raptor = MakeTestRaptor();
+
+  // The last trip of A-C departs at 10:00 when B-D doesn't run.
+  std::vector<TransitRaptor::Leg> legs;
+  TEST(raptor.FindJourney(kStopA, kStopD, GetTime(9, 58), legs), ());
+
+  std::vector<TransitRaptor::Leg> const expected = {
+      MakeLeg(kLineAC, kStopA, kStopC, GetTime(10, 0), GetTime(10, 10)),
+      MakeLeg(kInvalidTransitId, kStopC, kStopD, GetTime(10, 10), GetTime(10, 12))};
+  TEST_EQUAL(legs, expected, ());
+
+  // The first trip of the next day is taken.
+  TEST(raptor.FindJourney(kStopA, kStopC, GetTime(10, 1), legs), ());
+  TEST_EQUAL(legs.size(), 1, ());
+  TEST_EQUAL(legs[0].m_departure, GetTime(8, 0) + 24 * 60 * 60, ());
+}
+
+UNIT_TEST(TransitRaptor_Unreachable)
+{
+  auto const raptor = MakeTestRaptor();
+
+  std::vector<TransitRaptor::Leg> legs;
+  TEST(!raptor.FindJourney(kStopD, kStopA, GetTime(8, 0), legs), ());
+  TEST(legs.empty(), ());
+
+  TEST(!raptor.FindJourney(kStopA, 42 /* unknown stop */, GetTime(8, 0), legs), ());
+}
+}  // namespace experimental
+}  // namespace transit
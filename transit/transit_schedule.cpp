@@ -12,6 +12,8 @@ uint32_t constexpr kMask4bits = 0xf;
 uint32_t constexpr kMask5bits = 0x1f;
 uint32_t constexpr kMask6bits = 0x3F;
 
+time_t constexpr kSecondsInDay = 24 * 60 * 60;
+
 std::tm ToCalendarTime(time_t const & ts)
 {
   std::tm tm;
@@ -77,6 +79,11 @@ DateTimeRelation GetTimesRelation(::transit::Time const & time1, ::transit::Time
   return DateTimeRelation::Equal;
 }
 
+uint32_t GetSecondsSinceDayStart(::transit::Time const & time)
+{
+  return time.m_hour * 3600 + time.m_minute * 60 + time.m_second;
+}
+
 ::transit::Date GetDate(std::tm const & tm)
 {
   return ::transit::Date(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
@@ -310,6 +317,38 @@ std::map<TimeInterval, Frequency> const & FrequencyIntervals::GetFrequencies() c
   return m_intervals;
 }
 
+bool FrequencyIntervals::GetNextDeparture(uint32_t seconds, uint32_t & departure) const
+{
+  bool found = false;
+  for (auto const & [interval, freq] : m_intervals)
+  {
+    if (freq == kDefaultFrequency)
+      continue;
+
+    auto const & [startTime, endTime] = interval.Extract();
+    uint32_t const start = GetSecondsSinceDayStart(startTime);
+    uint32_t const end = GetSecondsSinceDayStart(endTime);
+    if (seconds > end)
+      continue;
+
+    uint32_t candidate = start;
+    if (seconds > start)
+      candidate += (seconds - start + freq - 1) / freq * freq;
+
+    if (candidate > end)
+      continue;
+
+    // Intervals may overlap so the earliest departure of all of them is taken.
+    if (!found || candidate < departure)
+    {
+      departure = candidate;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
 // Schedule ----------------------------------------------------------------------------------------
 bool Schedule::operator==(Schedule const & rhs) const
 {
@@ -395,6 +434,59 @@ Frequency Schedule::GetFrequency(time_t const & time) const
   return m_defaultFrequency;
 }
 
+FrequencyIntervals const * Schedule::GetFrequencyIntervals(time_t const & time) const
+{
+  auto const & [date, wdIndex] = GetDateAndWeekIndex(time);
+
+  for (auto const & [dateException, freqInts] : m_serviceExceptions)
+  {
+    Status const status = dateException.GetExceptionStatus(date);
+    if (status == Status::Open)
+      return &freqInts;
+    if (status == Status::Closed)
+      return nullptr;
+  }
+
+  for (auto const & [datesInterval, freqInts] : m_serviceIntervals)
+  {
+    if (datesInterval.GetStatusInInterval(date, wdIndex) == Status::Open)
+      return &freqInts;
+  }
+
+  return nullptr;
+}
+
+bool Schedule::GetNextDeparture(time_t const & time, time_t & departure) const
+{
+  std::tm const tm = ToCalendarTime(time);
+  time_t const dayStart = time - (tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
+
+  bool found = false;
+  for (time_t day = -1; day <= 1; ++day)
+  {
+    time_t const serviceDayStart = dayStart + day * kSecondsInDay;
+    // Noon is used to get the service day, so it's not shifted by daylight saving time changes.
+    auto const * intervals = GetFrequencyIntervals(serviceDayStart + kSecondsInDay / 2);
+    if (!intervals)
+      continue;
+
+    uint32_t const seconds =
+        time > serviceDayStart ? static_cast<uint32_t>(time - serviceDayStart) : 0;
+    uint32_t secondsDeparture = 0;
+    if (!intervals->GetNextDeparture(seconds, secondsDeparture))
+      continue;
+
+    time_t const candidate = serviceDayStart + secondsDeparture;
+    if (!found || candidate < departure)
+    {
+      departure = candidate;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
 std::pair<Date, uint8_t> Schedule::GetDateAndWeekIndex(time_t const & time) const
 {
   std::tm const tm = ToCalendarTime(time);
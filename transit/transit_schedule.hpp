@@ -203,6 +203,11 @@ public:
   Frequency GetFrequency(Time const & time) const;
   std::map<TimeInterval, Frequency> const & GetFrequencies() const;
 
+  // Trips depart each headway seconds starting with the beginning of an interval. Gets the
+  // first departure at |seconds| (seconds since the start of the service day) or later.
+  // Returns false if there is no such departure.
+  bool GetNextDeparture(uint32_t seconds, uint32_t & departure) const;
+
 private:
   DECLARE_SCHEDULE_TYPES_FRIENDS
   DECLARE_VISITOR_AND_DEBUG_PRINT(FrequencyIntervals, visitor(m_intervals, "m_intervals"))
@@ -231,6 +236,13 @@ public:
   Frequency GetFrequency(time_t const & time) const;
   Frequency GetFrequency() const { return m_defaultFrequency; }
 
+  // Returns frequency intervals of the service day of |time| or nullptr if the service is
+  // closed on that day.
+  FrequencyIntervals const * GetFrequencyIntervals(time_t const & time) const;
+  // Gets the first departure of a trip at |time| or later. Trips of the previous service day
+  // which depart after midnight and trips of the next service day are taken into account too.
+  bool GetNextDeparture(time_t const & time, time_t & departure) const;
+
   DatesIntervals const & GetServiceIntervals() const;
   DatesExceptions const & GetServiceExceptions() const;
 
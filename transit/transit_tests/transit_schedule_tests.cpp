@@ -183,6 +183,34 @@ UNIT_TEST(TransitSchedule_FrequencyIntervals)
   TEST_EQUAL(intervals.GetFrequency(Time(22, 50, 10)), kDefaultFrequency, ());
 }
 
+UNIT_TEST(TransitSchedule_FrequencyIntervals_NextDeparture)
+{
+  gtfs::Frequencies const frequencies{GetFrequency("14:40:00", "15:55:30", 600),
+                                      GetFrequency("21:10:20", "22:45:40", 300)};
+
+  FrequencyIntervals const intervals(frequencies);
+
+  auto const getSeconds = [](Time const & time) {
+    return time.m_hour * 3600 + time.m_minute * 60 + time.m_second;
+  };
+
+  uint32_t departure = 0;
+  TEST(intervals.GetNextDeparture(getSeconds(Time(13, 15, 30)), departure), ());
+  TEST_EQUAL(departure, getSeconds(Time(14, 40, 0)), ());
+
+  TEST(intervals.GetNextDeparture(getSeconds(Time(14, 40, 0)), departure), ());
+  TEST_EQUAL(departure, getSeconds(Time(14, 40, 0)), ());
+
+  TEST(intervals.GetNextDeparture(getSeconds(Time(14, 41, 0)), departure), ());
+  TEST_EQUAL(departure, getSeconds(Time(14, 50, 0)), ());
+
+  // The next departure of the first interval is after its end.
+  TEST(intervals.GetNextDeparture(getSeconds(Time(15, 50, 1)), departure), ());
+  TEST_EQUAL(departure, getSeconds(Time(21, 10, 20)), ());
+
+  TEST(!intervals.GetNextDeparture(getSeconds(Time(22, 45, 41)), departure), ());
+}
+
 UNIT_TEST(TransitSchedule_Schedule_DatesInterval_Status)
 {
   gtfs::CalendarItem calendarItem1;
@@ -58,6 +58,7 @@ std::string ColorPicker::GetNearestColor(std::string const & rgb)
   if (rgb.empty())
     return kDefaultColor;
 
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto [it, inserted] = m_colorsToNames.emplace(rgb, kDefaultColor);
   if (!inserted)
     return it->second;
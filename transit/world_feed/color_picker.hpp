@@ -3,11 +3,13 @@
 #include "drape_frontend/color_constants.hpp"
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 namespace transit
 {
+// The class is thread-safe.
 class ColorPicker
 {
 public:
@@ -16,6 +18,7 @@ public:
   std::string GetNearestColor(std::string const & rgb);
 
 private:
+  std::mutex m_mutex;
   std::unordered_map<std::string, std::string> m_colorsToNames;
   std::map<std::string, dp::Color> m_drapeClearColors;
 };
@@ -3,6 +3,7 @@
 #include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
 #include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
@@ -96,6 +97,9 @@ void FillProjections(std::vector<m2::PointD> & polyline, size_t startIndex, size
   double distTravelledM = 0.0;
   // Stop can't be further from its projection to line then |maxDistFromStopM|.
   double constexpr maxDistFromStopM = 1000;
+  // Segments which don't intersect the rect are too far from the stop, so there is no need to
+  // project it on them. The rect is twice bigger because of the mercator scale change.
+  m2::RectD const stopRect = mercator::RectByCenterXYAndSizeInMeters(point, 2 * maxDistFromStopM);
 
   size_t const from = direction == Direction::Forward ? startIndex : endIndex;
 
@@ -117,6 +121,9 @@ void FillProjections(std::vector<m2::PointD> & polyline, size_t startIndex, size
     if (i != from)
       distTravelledM += mercator::DistanceOnEarth(polyline[prev], polyline[current]);
 
+    if (!stopRect.IsIntersect(m2::RectD(polyline[current], polyline[next])))
+      continue;
+
     auto proj = GetProjection(polyline, current, direction,
                               ProjectStopOnTrack(point, polyline[current], polyline[next]));
     proj.m_distFromEnding =
@@ -9,8 +9,16 @@
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gflags/gflags.h>
 
 DEFINE_string(
@@ -25,6 +33,7 @@ DEFINE_string(path_json, "", "Output directory for dumping json files");
 DEFINE_string(path_resources, "", "OMaps resources directory");
 DEFINE_string(start_feed, "", "Optional. Feed directory from which the process continues");
 DEFINE_string(stop_feed, "", "Optional. Feed directory on which to stop the process");
+DEFINE_uint64(threads_count, 0, "Optional. Threads count for feeds conversion, all cores if 0");
 
 // Finds subdirectories with feeds.
 Platform::FilesList GetGtfsFeedsInDirectory(std::string const & path)
@@ -163,8 +172,68 @@ FeedStatus ReadFeed(gtfs::Feed & feed)
   return FeedStatus::OK;
 }
 
+// Statistics of the feeds conversion shared between threads.
+struct ConversionStats
+{
+  std::mutex m_mutex;
+  std::vector<std::string> m_invalidFeeds;
+  size_t m_feedsWithNoShapesCount = 0;
+  size_t m_feedsNotDumpedCount = 0;
+  size_t m_feedsDumped = 0;
+  // The first saved feed overwrites the jsons of the previous run.
+  bool m_overwrite = true;
+};
+
+void ConvertFeed(std::string feedPath, transit::IdGenerator & generator,
+                 transit::IdGenerator & generatorEdges, transit::ColorPicker & colorPicker,
+                 feature::CountriesFilesAffiliation & mwmMatcher, ConversionStats & stats)
+{
+  base::Timer feedTimer;
+
+  ExtendPath(feedPath);
+  LOG(LINFO, ("Handling feed", feedPath));
+
+  gtfs::Feed feed(feedPath);
+
+  if (auto const res = ReadFeed(feed); res != FeedStatus::OK)
+  {
+    std::lock_guard<std::mutex> lock(stats.m_mutex);
+    if (res == FeedStatus::NO_SHAPES)
+      ++stats.m_feedsWithNoShapesCount;
+    else
+      stats.m_invalidFeeds.push_back(feedPath);
+    return;
+  }
+
+  transit::WorldFeed globalFeed(generator, generatorEdges, colorPicker, mwmMatcher);
+
+  if (!globalFeed.SetFeed(std::move(feed)))
+  {
+    LOG(LINFO, ("Error transforming feed for json representation."));
+    std::lock_guard<std::mutex> lock(stats.m_mutex);
+    ++stats.m_feedsNotDumpedCount;
+    return;
+  }
+
+  // Feeds are appended to the same region jsons, so they are saved one by one.
+  std::lock_guard<std::mutex> lock(stats.m_mutex);
+  bool const saved = globalFeed.Save(FLAGS_path_json, stats.m_overwrite);
+  if (saved)
+  {
+    ++stats.m_feedsDumped;
+    stats.m_overwrite = false;
+  }
+  else
+  {
+    ++stats.m_feedsNotDumpedCount;
+  }
+
+  LOG(LINFO, ("Merged:", saved ? "yes" : "no", "time", feedTimer.ElapsedSeconds(), "s"));
+}
+
 // Reads GTFS feeds from directories in |FLAGS_path_gtfs_feeds|. Converts each feed to the WorldFeed
 // object and saves to the |FLAGS_path_json| path in the new transit line-by-line json format.
+// Feeds are converted in parallel with |FLAGS_threads_count| threads.
 bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & generatorEdges,
                   transit::ColorPicker & colorPicker,
                   feature::CountriesFilesAffiliation & mwmMatcher)
@@ -177,75 +246,51 @@ bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & gener
     return false;
   }
 
-  std::vector<std::string> invalidFeeds;
-
-  size_t feedsWithNoShapesCount = 0;
-  size_t feedsNotDumpedCount = 0;
-  size_t feedsDumped = 0;
-  size_t feedsTotal = gtfsFeeds.size();
+  std::vector<std::string> feedsToConvert;
   bool pass = true;
 
-  for (size_t i = 0; i < gtfsFeeds.size(); ++i)
+  for (auto const & feedPath : gtfsFeeds)
   {
-    base::Timer feedTimer;
-    auto feedPath = gtfsFeeds[i];
-
     if (SkipFeed(feedPath, pass))
     {
-      ++feedsTotal;
       LOG(LINFO, ("Skipped", feedPath));
       continue;
     }
 
-    bool stop = StopOnFeed(feedPath);
-    if (stop)
-      feedsTotal -= (gtfsFeeds.size() - i - 1);
-
-    ExtendPath(feedPath);
-    LOG(LINFO, ("Handling feed", feedPath));
+    feedsToConvert.push_back(feedPath);
 
-    gtfs::Feed feed(feedPath);
-
-    if (auto const res = ReadFeed(feed); res != FeedStatus::OK)
-    {
-      if (res == FeedStatus::NO_SHAPES)
-        feedsWithNoShapesCount++;
-      else
-        invalidFeeds.push_back(feedPath);
+    if (StopOnFeed(feedPath))
+      break;
+  }
 
-      if (stop)
-        break;
-      continue;
-    }
+  ConversionStats stats;
+  // Jsons of the previous run are kept when the process continues from |FLAGS_start_feed|.
+  stats.m_overwrite = FLAGS_start_feed.empty();
 
-    transit::WorldFeed globalFeed(generator, generatorEdges, colorPicker, mwmMatcher);
+  size_t const threadsCount =
+      FLAGS_threads_count != 0 ? FLAGS_threads_count : std::thread::hardware_concurrency();
 
-    if (!globalFeed.SetFeed(std::move(feed)))
+  {
+    base::thread_pool::computational::ThreadPool pool(std::max<size_t>(threadsCount, 1));
+    std::vector<std::future<void>> results;
+    results.reserve(feedsToConvert.size());
+    for (auto const & feedPath : feedsToConvert)
     {
-      LOG(LINFO, ("Error transforming feed for json representation."));
-      ++feedsNotDumpedCount;
-      if (stop)
-        break;
-      continue;
+      results.emplace_back(pool.Submit([&, feedPath]() {
+        ConvertFeed(feedPath, generator, generatorEdges, colorPicker, mwmMatcher, stats);
+      }));
     }
 
-    bool const saved = globalFeed.Save(FLAGS_path_json, i == 0 /* overwrite */);
-    if (saved)
-      ++feedsDumped;
-    else
-      ++feedsNotDumpedCount;
-
-    LOG(LINFO, ("Merged:", saved ? "yes" : "no", "time", feedTimer.ElapsedSeconds(), "s"));
-
-    if (stop)
-      break;
+    for (auto & result : results)
+      result.get();
   }
 
-  LOG(LINFO, ("Corrupted feeds paths:", invalidFeeds));
-  LOG(LINFO, ("Corrupted feeds:", invalidFeeds.size(), "/", feedsTotal));
-  LOG(LINFO, ("Feeds with no shapes:", feedsWithNoShapesCount, "/", feedsTotal));
-  LOG(LINFO, ("Feeds parsed but not dumped:", feedsNotDumpedCount, "/", feedsTotal));
-  LOG(LINFO, ("Total dumped feeds:", feedsDumped, "/", feedsTotal));
+  size_t const feedsTotal = feedsToConvert.size();
+  LOG(LINFO, ("Corrupted feeds paths:", stats.m_invalidFeeds));
+  LOG(LINFO, ("Corrupted feeds:", stats.m_invalidFeeds.size(), "/", feedsTotal));
+  LOG(LINFO, ("Feeds with no shapes:", stats.m_feedsWithNoShapesCount, "/", feedsTotal));
+  LOG(LINFO, ("Feeds parsed but not dumped:", stats.m_feedsNotDumpedCount, "/", feedsTotal));
+  LOG(LINFO, ("Total dumped feeds:", stats.m_feedsDumped, "/", feedsTotal));
 
   return true;
 }
@@ -274,6 +274,7 @@ namespace transit
 {
 // Static fields.
 std::unordered_set<std::string> WorldFeed::m_agencyHashes;
+std::mutex WorldFeed::m_agencyHashesMutex;
 
 EdgeTransferId::EdgeTransferId(TransitId fromStopId, TransitId toStopId)
   : m_fromStopId(fromStopId), m_toStopId(toStopId)
@@ -343,10 +344,23 @@ IdGenerator::IdGenerator(std::string const & idMappingPath) : m_idMappingPath(id
   LOG(LINFO, ("Loaded", m_hashToId.size(), "hash-to-id mappings. Current free id:", m_curId));
 }
 
+IdGenerator & IdGenerator::operator=(IdGenerator && rhs)
+{
+  if (this == &rhs)
+    return *this;
+
+  std::scoped_lock lock(m_mutex, rhs.m_mutex);
+  m_hashToId = std::move(rhs.m_hashToId);
+  m_curId = rhs.m_curId;
+  m_idMappingPath = std::move(rhs.m_idMappingPath);
+  return *this;
+}
+
 TransitId IdGenerator::MakeId(const std::string & hash)
 {
   CHECK(!hash.empty(), ("Empty hash cannot be added to the mapping."));
 
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto [it, inserted] = m_hashToId.emplace(hash, 0);
   if (!inserted)
     return it->second;
@@ -358,6 +372,7 @@ TransitId IdGenerator::MakeId(const std::string & hash)
 
 void IdGenerator::Save()
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   LOG(LINFO, ("Started saving", m_hashToId.size(), "mappings to", m_idMappingPath));
 
   std::ofstream mappingFile;
@@ -432,7 +447,13 @@ bool WorldFeed::FillNetworks()
     if (m_feed.get_agencies().size() == 1)
       m_gtfsIdToHash[FieldIdx::AgencyIdx].emplace("", agencyHash);
 
-    if (!m_agencyHashes.insert(agencyHash).second)
+    bool isNewAgency = false;
+    {
+      std::lock_guard<std::mutex> lock(m_agencyHashesMutex);
+      isNewAgency = m_agencyHashes.insert(agencyHash).second;
+    }
+
+    if (!isNewAgency)
     {
       LOG(LINFO, ("Agency hash copy from other feed:", agencyHash, "Skipped."));
       m_agencySkipList.insert(agencyHash);
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <fstream>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -27,16 +28,20 @@ namespace transit
 {
 static std::string const kDelimiter = "_";
 // Generates globally unique TransitIds mapped to the GTFS entities hashes.
+// The class is thread-safe.
 class IdGenerator
 {
 public:
   IdGenerator() = default;
   explicit IdGenerator(std::string const & idMappingPath);
+  IdGenerator & operator=(IdGenerator && rhs);
+
   void Save();
 
   TransitId MakeId(std::string const & hash);
 
 private:
+  std::mutex m_mutex;
   std::unordered_map<std::string, TransitId> m_hashToId;
   TransitId m_curId = 0;
   std::string m_idMappingPath;
@@ -407,6 +412,7 @@ private:
 
   // Unique hashes of all agencies handled by WorldFeed.
   static std::unordered_set<std::string> m_agencyHashes;
+  static std::mutex m_agencyHashesMutex;
   // Count of corrupted stops sequences which could not be projected to the shape polyline.
   static size_t m_badStopSeqCount;
   // Agencies which are already handled by WorldFeed and should be copied to the resulting jsons.